@@ -0,0 +1,283 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "async_prediction_service.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <grpcpp/server_context.h>
+#include <spdlog/spdlog.h>
+
+#include "batchingscheduler.hpp"
+#include "compression.hpp"
+#include "cpuaffinity.hpp"
+#include "modelinstance.hpp"
+#include "modelinstanceunloadguard.hpp"
+#include "modelmanager.hpp"
+#include "pipeline.hpp"
+#include "prediction_service_utils.hpp"
+#include "requestarena.hpp"
+#include "requestdeadline.hpp"
+#include "requestlogging.hpp"
+#include "requesttiming.hpp"
+#include "samplingprofiler.hpp"
+#include "sequencemanager.hpp"
+#include "status.hpp"
+#include "tenantscheduling.hpp"
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+namespace {
+
+// call data waiting for next RPC holds the first block, it is kept small for small requests
+const size_t CALL_ARENA_START_BLOCK_SIZE = 16 * 1024;
+
+google::protobuf::ArenaOptions createCallArenaOptions() {
+    google::protobuf::ArenaOptions options;
+    options.start_block_size = CALL_ARENA_START_BLOCK_SIZE;
+    options.max_block_size = REQUEST_ARENA_MAX_BLOCK_SIZE;
+    return options;
+}
+
+/**
+ * @brief State of a single Predict RPC, used as completion queue tag
+ */
+class PredictCallData {
+public:
+    PredictCallData(AsyncPredictionServiceImpl& service, grpc::ServerCompletionQueue& completionQueue,
+        tensorflow::serving::ThreadPoolExecutor& blockingExecutor, tensorflow::serving::ThreadPoolExecutor& pipelineExecutor,
+        PipelinesInProgress& pipelinesInProgress) :
+        service(service),
+        completionQueue(completionQueue),
+        blockingExecutor(blockingExecutor),
+        pipelineExecutor(pipelineExecutor),
+        pipelinesInProgress(pipelinesInProgress),
+        arena(createCallArenaOptions()),
+        request(*google::protobuf::Arena::CreateMessage<PredictRequest>(&arena)),
+        response(*google::protobuf::Arena::CreateMessage<PredictResponse>(&arena)),
+        responder(&context) {
+        service.RequestPredict(&context, &request, &responder, &completionQueue, &completionQueue, this);
+    }
+
+    void proceed(bool ok) {
+        if (state == State::FINISHING || !ok) {
+            // RPC finished or completion queue is shutting down
+            delete this;
+            return;
+        }
+        // accept next RPC before processing this one
+        new PredictCallData(service, completionQueue, blockingExecutor, pipelineExecutor, pipelinesInProgress);
+        state = State::FINISHING;
+        process();
+    }
+
+private:
+    enum class State {
+        WAITING_FOR_REQUEST,
+        FINISHING
+    };
+
+    void process() {
+        SPDLOG_DEBUG("Processing async gRPC request for model: {}; version: {}",
+            request.model_spec().name(),
+            request.model_spec().version().value());
+        // cancellation of asynchronous call is known only from completion queue notification, deadline is checked alone
+        deadline = RequestDeadline::fromGrpcContext(context, false);
+        auto deadlineStatus = deadline.check();
+        if (!deadlineStatus.ok()) {
+            finish(deadlineStatus);
+            return;
+        }
+        auto priorityStatus = getRequestPriority(context, priority);
+        if (!priorityStatus.ok()) {
+            finish(priorityStatus);
+            return;
+        }
+        tenant = getRequestTenant(context);
+        auto tenantStatus = Tenants::getInstance().admit(tenant);
+        if (!tenantStatus.ok()) {
+            finish(tenantStatus);
+            return;
+        }
+        ModelManager& manager = ModelManager::getInstance();
+        std::shared_ptr<ModelInstance> modelInstance;
+        std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
+        auto status = getModelInstance(manager, request.model_spec().name(), request.model_spec().version().value(), modelInstance, modelInstanceUnloadGuard,
+            getContinuedSequenceId(request));
+        if (status == StatusCode::MODEL_NAME_MISSING) {
+            OVMS_REQUEST_DEBUG("Requested model: {} does not exist. Searching for pipeline with that name...", request.model_spec().name());
+            executePipeline();
+            return;
+        }
+        if (!status.ok()) {
+            OVMS_REQUEST_DEBUG("Getting modelInstance failed. {}", status.string());
+            finish(status);
+            return;
+        }
+        startTiming();
+        // requests merged by batching scheduler, padded to shape buckets, hedged, of sequences or split into micro-batches are inferred synchronously
+        if ((modelInstance->getBatchingScheduler() != nullptr && BatchingScheduler::isRequestBatchable(&request)) || modelInstance->hasShapeBuckets() ||
+            modelInstance->isSplitToMicroBatches(&request) || modelInstance->getHedgingPolicy() != nullptr || modelInstance->getSequenceManager() != nullptr) {
+            auto guard = std::make_shared<std::unique_ptr<ModelInstanceUnloadGuard>>(std::move(modelInstanceUnloadGuard));
+            blockingExecutor.Schedule([this, modelInstance, guard]() {
+                finish(inference(*modelInstance, &request, &response, *guard, timing.get(), &deadline, priority, tenant));
+            });
+            return;
+        }
+        // completion queue thread only starts inference on idle infer request, waiting is left to blocking executor
+        status = inferenceAsync(modelInstance, &request, &response, modelInstanceUnloadGuard,
+            [this](const Status& status) { finish(status); }, timing.get(), &deadline, priority, tenant,
+            [this](std::function<void()> task) { blockingExecutor.Schedule(std::move(task)); });
+        if (!status.ok()) {
+            finish(status);
+        }
+    }
+
+    void executePipeline() {
+        auto status = getPipeline(ModelManager::getInstance(), pipeline, &request, &response);
+        if (!status.ok()) {
+            OVMS_REQUEST_DEBUG("Getting pipeline failed. {}", status.string());
+            finish(status);
+            return;
+        }
+        startTiming();
+        // pipeline is destroyed together with this call data, after response is sent
+        pipelinesInProgress.add();
+        pipeline->executeAsync(
+            pipelineExecutor, [this, &inProgress = pipelinesInProgress](const Status& status) {
+                // this may be deleted as soon as response is sent
+                finish(status);
+                inProgress.remove();
+            },
+            timing.get(), &deadline);
+    }
+
+    void startTiming() {
+        if (context.client_metadata().count(RequestTiming::REQUEST_HEADER) > 0) {
+            timing = std::make_unique<RequestTiming>();
+        }
+    }
+
+    void finish(const Status& status) {
+        if (timing) {
+            context.AddTrailingMetadata(RequestTiming::RESPONSE_HEADER, timing->serialize());
+        }
+        if (status.ok()) {
+            setGrpcResponseCompression(context, response.ByteSizeLong());
+        }
+        responder.Finish(response, status.grpc(), this);
+    }
+
+    AsyncPredictionServiceImpl& service;
+    grpc::ServerCompletionQueue& completionQueue;
+    tensorflow::serving::ThreadPoolExecutor& blockingExecutor;
+    tensorflow::serving::ThreadPoolExecutor& pipelineExecutor;
+    PipelinesInProgress& pipelinesInProgress;
+    grpc::ServerContext context;
+    // fields of request and response are allocated in blocks of the arena and released with this call data
+    google::protobuf::Arena arena;
+    PredictRequest& request;
+    PredictResponse& response;
+    grpc::ServerAsyncResponseWriter<PredictResponse> responder;
+    std::unique_ptr<Pipeline> pipeline;
+    // set only if client requested timing of the request
+    std::unique_ptr<RequestTiming> timing;
+    RequestDeadline deadline;
+    RequestPriority priority = RequestPriority::HIGH;
+    std::string tenant;
+    State state = State::WAITING_FOR_REQUEST;
+};
+
+}  // namespace
+
+AsyncPredictServer::AsyncPredictServer(AsyncPredictionServiceImpl& service, uint completionQueuesCount, uint blockingExecutorThreads, uint pipelineExecutorThreads,
+    uint pollingThreadsPerQueue, bool numaPinning) :
+    service(service),
+    completionQueuesCount(completionQueuesCount),
+    pollingThreadsPerQueue(std::max<uint>(1, pollingThreadsPerQueue)),
+    numaPinning(numaPinning),
+    blockingExecutor(std::make_unique<tensorflow::serving::ThreadPoolExecutor>(tensorflow::Env::Default(), "grpcblockingpredict", blockingExecutorThreads)),
+    pipelineExecutor(std::make_unique<tensorflow::serving::ThreadPoolExecutor>(tensorflow::Env::Default(), "grpcpipelines", pipelineExecutorThreads)) {}
+
+AsyncPredictServer::~AsyncPredictServer() {
+    shutdown();
+}
+
+void AsyncPredictServer::registerCompletionQueues(grpc::ServerBuilder& builder) {
+    for (uint i = 0; i < completionQueuesCount; ++i) {
+        completionQueues.emplace_back(builder.AddCompletionQueue());
+    }
+}
+
+void AsyncPredictServer::start() {
+    std::vector<std::vector<int>> numaNodesCpus;
+    if (numaPinning) {
+        numaNodesCpus = getNumaNodesCpus();
+    }
+    spdlog::info("Starting {} async gRPC completion queues with {} polling threads each, pinned to {} NUMA nodes",
+        completionQueues.size(), pollingThreadsPerQueue, numaNodesCpus.size());
+    for (size_t i = 0; i < completionQueues.size(); ++i) {
+        auto& completionQueue = *completionQueues[i];
+        new PredictCallData(service, completionQueue, *blockingExecutor, *pipelineExecutor, pipelinesInProgress);
+        std::vector<int> cpus;
+        if (!numaNodesCpus.empty()) {
+            cpus = numaNodesCpus[i % numaNodesCpus.size()];
+        }
+        for (uint thread = 0; thread < pollingThreadsPerQueue; ++thread) {
+            pollingThreads.emplace_back([this, &completionQueue, i, cpus]() {
+                setCurrentThreadName("grpc_cq_" + std::to_string(i));
+                if (!cpus.empty() && !pinCurrentThread(cpus)) {
+                    spdlog::warn("Pinning polling thread of gRPC completion queue {} failed", i);
+                }
+                pollCompletionQueue(completionQueue);
+            });
+        }
+    }
+    started = true;
+}
+
+void AsyncPredictServer::pollCompletionQueue(grpc::ServerCompletionQueue& completionQueue) {
+    void* tag;
+    bool ok;
+    while (completionQueue.Next(&tag, &ok)) {
+        static_cast<PredictCallData*>(tag)->proceed(ok);
+    }
+}
+
+void AsyncPredictServer::shutdown() {
+    if (!started) {
+        return;
+    }
+    // finish blocking requests and pipelines while completion queues still accept results
+    blockingExecutor.reset();
+    pipelinesInProgress.waitForAll();
+    pipelineExecutor.reset();
+    for (auto& completionQueue : completionQueues) {
+        completionQueue->Shutdown();
+    }
+    for (auto& thread : pollingThreads) {
+        thread.join();
+    }
+    pollingThreads.clear();
+    started = false;
+}
+
+}  // namespace ovms
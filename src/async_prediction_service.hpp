@@ -0,0 +1,115 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/server_builder.h>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#include "tensorflow_serving/util/threadpool_executor.h"
+
+#include "prediction_service.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Prediction service with Predict served through completion queues, GetModelMetadata stays synchronous
+ */
+using AsyncPredictionServiceImpl = tensorflow::serving::PredictionService::WithAsyncMethod_Predict<PredictionServiceImpl>;
+
+/**
+ * @brief Counts pipelines executed asynchronously, their nodes can schedule work until they complete
+ */
+class PipelinesInProgress {
+public:
+    void add() {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++count;
+    }
+
+    void remove() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (--count == 0) {
+            allFinished.notify_all();
+        }
+    }
+
+    void waitForAll() {
+        std::unique_lock<std::mutex> lock(mtx);
+        allFinished.wait(lock, [this]() { return count == 0; });
+    }
+
+private:
+    std::mutex mtx;
+    std::condition_variable allFinished;
+    uint count = 0;
+};
+
+/**
+ * @brief Drives asynchronous Predict RPCs.
+ *
+ * Each completion queue is polled by its own threads. Single model requests are deserialized on polling thread
+ * and finished from the inference completion callback, so threads are not held during inference.
+ * Pipelines are processed as tasks of a shared pipeline executor whenever any of their nodes finishes.
+ * Requests merged by batching scheduler block until results are ready, so these are executed
+ * on a separate thread pool.
+ */
+class AsyncPredictServer {
+public:
+    /**
+     * @param pollingThreadsPerQueue threads calling Next on each completion queue
+     * @param numaPinning pins polling threads of consecutive completion queues to CPUs of consecutive NUMA nodes
+     */
+    AsyncPredictServer(AsyncPredictionServiceImpl& service, uint completionQueuesCount, uint blockingExecutorThreads, uint pipelineExecutorThreads,
+        uint pollingThreadsPerQueue = 1, bool numaPinning = false);
+    ~AsyncPredictServer();
+
+    /**
+     * @brief Adds completion queues to the builder, must be called before server is built
+     */
+    void registerCompletionQueues(grpc::ServerBuilder& builder);
+
+    /**
+     * @brief Starts polling threads, must be called after server is started
+     */
+    void start();
+
+    /**
+     * @brief Shuts down completion queues and joins polling threads, must be called after server shutdown
+     */
+    void shutdown();
+
+private:
+    void pollCompletionQueue(grpc::ServerCompletionQueue& completionQueue);
+
+    AsyncPredictionServiceImpl& service;
+    const uint completionQueuesCount;
+    const uint pollingThreadsPerQueue;
+    const bool numaPinning;
+    std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> completionQueues;
+    std::vector<std::thread> pollingThreads;
+    std::unique_ptr<tensorflow::serving::ThreadPoolExecutor> blockingExecutor;
+    std::unique_ptr<tensorflow::serving::ThreadPoolExecutor> pipelineExecutor;
+    PipelinesInProgress pipelinesInProgress;
+    bool started = false;
+};
+
+}  // namespace ovms
@@ -0,0 +1,177 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "autotuning.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+const char* TUNING_RESULT_FILE_NAME = "ovms_tuning.json";
+
+std::vector<TuningCandidate> generateTuningCandidates(uint32_t cpusCount) {
+    std::vector<TuningCandidate> candidates;
+    const uint32_t maxStreams = std::max<uint32_t>(1, cpusCount);
+    for (uint32_t streams = 1; streams <= maxStreams; streams *= 2) {
+        candidates.push_back({streams, streams});
+        candidates.push_back({streams, 2 * streams});
+    }
+    return candidates;
+}
+
+std::optional<TuningCandidate> chooseTuningCandidate(const std::vector<TuningMeasurement>& measurements, uint32_t latencySloMilliseconds) {
+    const TuningMeasurement* best = nullptr;
+    for (const auto& measurement : measurements) {
+        if (latencySloMilliseconds > 0 && measurement.averageLatencyMilliseconds > latencySloMilliseconds) {
+            continue;
+        }
+        if (best == nullptr || measurement.inferencesPerSecond > best->inferencesPerSecond) {
+            best = &measurement;
+        }
+    }
+    if (best == nullptr) {
+        // no candidate meets the SLO, the fastest one misses it the least
+        for (const auto& measurement : measurements) {
+            if (best == nullptr || measurement.averageLatencyMilliseconds < best->averageLatencyMilliseconds) {
+                best = &measurement;
+            }
+        }
+    }
+    if (best == nullptr) {
+        return std::nullopt;
+    }
+    return best->candidate;
+}
+
+Status measureInferenceThroughput(std::vector<InferenceEngine::InferRequest>& inferRequests, uint32_t nireq,
+    std::chrono::milliseconds duration, TuningMeasurement& measurement) {
+    nireq = std::min<uint32_t>(nireq, inferRequests.size());
+    if (nireq == 0) {
+        return StatusCode::INVALID_NIREQ;
+    }
+    using Clock = std::chrono::steady_clock;
+    std::vector<Clock::time_point> started(nireq);
+    uint64_t completed = 0;
+    Clock::duration totalLatency(0);
+    const auto start = Clock::now();
+    const auto end = start + duration;
+    try {
+        for (uint32_t i = 0; i < nireq; ++i) {
+            started[i] = Clock::now();
+            inferRequests[i].StartAsync();
+        }
+        // requests complete in about the order they were started, waiting in that order keeps all of them busy
+        bool running = true;
+        while (running) {
+            for (uint32_t i = 0; i < nireq; ++i) {
+                if (inferRequests[i].Wait(InferenceEngine::IInferRequest::RESULT_READY) != InferenceEngine::StatusCode::OK) {
+                    return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+                }
+                const auto now = Clock::now();
+                ++completed;
+                totalLatency += now - started[i];
+                if (now >= end) {
+                    running = false;
+                    continue;
+                }
+                started[i] = now;
+                inferRequests[i].StartAsync();
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        spdlog::error("Inference during auto-tuning failed: {}", e.what());
+        return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+    }
+    const double elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    measurement.inferencesPerSecond = completed / elapsedSeconds;
+    measurement.averageLatencyMilliseconds = std::chrono::duration<double, std::milli>(totalLatency).count() / completed;
+    return StatusCode::OK;
+}
+
+std::optional<TuningCandidate> loadTuningResult(const std::string& versionDirectory, const std::string& description) {
+    std::ifstream file(std::filesystem::path(versionDirectory) / TUNING_RESULT_FILE_NAME);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    rapidjson::Document document;
+    if (document.Parse(content.str().c_str()).HasParseError() || !document.IsObject()) {
+        spdlog::warn("Ignored malformed auto-tuning result in: {}", versionDirectory);
+        return std::nullopt;
+    }
+    const auto descriptionIt = document.FindMember("description");
+    const auto streamsIt = document.FindMember("streams");
+    const auto nireqIt = document.FindMember("nireq");
+    if (descriptionIt == document.MemberEnd() || !descriptionIt->value.IsString() ||
+        streamsIt == document.MemberEnd() || !streamsIt->value.IsUint() ||
+        nireqIt == document.MemberEnd() || !nireqIt->value.IsUint()) {
+        spdlog::warn("Ignored malformed auto-tuning result in: {}", versionDirectory);
+        return std::nullopt;
+    }
+    if (description != descriptionIt->value.GetString()) {
+        spdlog::info("Auto-tuning result in: {} was measured on different setup, tuning again", versionDirectory);
+        return std::nullopt;
+    }
+    TuningCandidate candidate{streamsIt->value.GetUint(), nireqIt->value.GetUint()};
+    if (candidate.streams == 0 || candidate.nireq == 0) {
+        return std::nullopt;
+    }
+    return candidate;
+}
+
+bool saveTuningResult(const std::string& versionDirectory, const std::string& description, const TuningCandidate& candidate) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("description");
+    writer.String(description.c_str());
+    writer.Key("streams");
+    writer.Uint(candidate.streams);
+    writer.Key("nireq");
+    writer.Uint(candidate.nireq);
+    writer.EndObject();
+
+    const auto path = std::filesystem::path(versionDirectory) / TUNING_RESULT_FILE_NAME;
+    // written aside and renamed, so concurrent loads never read partial file
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        file << buffer.GetString();
+        if (!file.good()) {
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporaryPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace ovms
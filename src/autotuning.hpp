@@ -0,0 +1,88 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief CPU streams and number of infer requests measured by auto-tuning
+ */
+struct TuningCandidate {
+    uint32_t streams = 0;
+    uint32_t nireq = 0;
+
+    bool operator==(const TuningCandidate& rhs) const { return streams == rhs.streams && nireq == rhs.nireq; }
+};
+
+/**
+ * @brief Throughput and latency of inferences executed with tuning candidate
+ */
+struct TuningMeasurement {
+    TuningCandidate candidate;
+    double inferencesPerSecond = 0;
+    double averageLatencyMilliseconds = 0;
+};
+
+/**
+ * @brief Name of the file saved in model version directory with auto-tuning result
+ */
+extern const char* TUNING_RESULT_FILE_NAME;
+
+/**
+ * @brief Lists candidates measured for a model: powers of two streams up to CPUs count, each with one and two infer requests per stream
+ */
+std::vector<TuningCandidate> generateTuningCandidates(uint32_t cpusCount);
+
+/**
+ * @brief Picks measurement of highest throughput within latency SLO, lowest latency if none meets it
+ *
+ * @param latencySloMilliseconds 0 means no latency limit
+ */
+std::optional<TuningCandidate> chooseTuningCandidate(const std::vector<TuningMeasurement>& measurements, uint32_t latencySloMilliseconds);
+
+/**
+ * @brief Measures first nireq of infer requests started again as soon as they complete, for given time
+ *
+ * Input blobs of the requests have to be set by caller.
+ */
+Status measureInferenceThroughput(std::vector<InferenceEngine::InferRequest>& inferRequests, uint32_t nireq,
+    std::chrono::milliseconds duration, TuningMeasurement& measurement);
+
+/**
+ * @brief Reads auto-tuning result saved in version directory if it was tuned as described
+ *
+ * @param description identifies inference engine, device, input shapes and CPUs the result was measured on
+ */
+std::optional<TuningCandidate> loadTuningResult(const std::string& versionDirectory, const std::string& description);
+
+/**
+ * @brief Saves auto-tuning result to version directory, replacing result tuned earlier
+ *
+ * @return false if file cannot be written, e.g. in read-only model repository
+ */
+bool saveTuningResult(const std::string& versionDirectory, const std::string& description, const TuningCandidate& candidate);
+
+}  // namespace ovms
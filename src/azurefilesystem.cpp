@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "stringutils.hpp"
@@ -87,8 +88,31 @@ AzureFileSystem::AzureFileSystem() :
 
 AzureFileSystem::~AzureFileSystem() { SPDLOG_TRACE("AzureFileSystem dtor"); }
 
+const ObjectListing* AzureFileSystem::getListing(const std::string& path) {
+    if (!listingAttempted_) {
+        listingAttempted_ = true;
+        if (path.rfind(AZURE_URL_BLOB_PREFIX, 0) != 0) {
+            return nullptr;
+        }
+        auto factory = std::make_shared<ovms::AzureStorageFactory>();
+        auto azureStorageObj = factory.get()->getNewAzureStorageObject(path, account_);
+        files_list_t objects;
+        if (azureStorageObj->checkPath(path) != StatusCode::OK || azureStorageObj->listObjectsRecursively(&objects) != StatusCode::OK) {
+            SPDLOG_WARN("AS: Unable to list objects under {}, paths will be queried one by one", path);
+            return nullptr;
+        }
+        listing_ = std::make_unique<ObjectListing>(path, std::move(objects));
+        SPDLOG_DEBUG("AS: Listed {} objects under {}", listing_->size(), path);
+    }
+    return (listing_ && listing_->covers(path)) ? listing_.get() : nullptr;
+}
+
 StatusCode AzureFileSystem::fileExists(const std::string& path, bool* exists) {
     *exists = false;
+    if (auto listing = getListing(path)) {
+        *exists = listing->exists(path);
+        return StatusCode::OK;
+    }
 
     auto factory = std::make_shared<ovms::AzureStorageFactory>();
     auto azureStorageObj = factory.get()->getNewAzureStorageObject(path, account_);
@@ -107,6 +131,10 @@ StatusCode AzureFileSystem::fileExists(const std::string& path, bool* exists) {
 StatusCode AzureFileSystem::isDirectory(const std::string& path,
     bool* is_directory) {
     *is_directory = false;
+    if (auto listing = getListing(path)) {
+        *is_directory = listing->isDirectory(path);
+        return StatusCode::OK;
+    }
 
     auto factory = std::make_shared<ovms::AzureStorageFactory>();
     auto azureStorageObj = factory.get()->getNewAzureStorageObject(path, account_);
@@ -142,6 +170,10 @@ StatusCode AzureFileSystem::fileModificationTime(const std::string& path,
 StatusCode
 AzureFileSystem::getDirectoryContents(const std::string& path,
     std::set<std::string>* contents) {
+    if (auto listing = getListing(path)) {
+        listing->getDirectoryContents(path, contents);
+        return StatusCode::OK;
+    }
 
     auto factory = std::make_shared<ovms::AzureStorageFactory>();
     auto azureStorageObj = factory.get()->getNewAzureStorageObject(path, account_);
@@ -159,6 +191,10 @@ AzureFileSystem::getDirectoryContents(const std::string& path,
 
 StatusCode AzureFileSystem::getDirectorySubdirs(const std::string& path,
     std::set<std::string>* subdirs) {
+    if (auto listing = getListing(path)) {
+        listing->getDirectorySubdirs(path, subdirs);
+        return StatusCode::OK;
+    }
 
     auto factory = std::make_shared<ovms::AzureStorageFactory>();
     auto azureStorageObj = factory.get()->getNewAzureStorageObject(path, account_);
@@ -176,6 +212,10 @@ StatusCode AzureFileSystem::getDirectorySubdirs(const std::string& path,
 
 StatusCode AzureFileSystem::getDirectoryFiles(const std::string& path,
     std::set<std::string>* files) {
+    if (auto listing = getListing(path)) {
+        listing->getDirectoryFiles(path, files);
+        return StatusCode::OK;
+    }
 
     auto factory = std::make_shared<ovms::AzureStorageFactory>();
     auto azureStorageObj = factory.get()->getNewAzureStorageObject(path, account_);
@@ -17,12 +17,14 @@
 
 #define _TURN_OFF_PLATFORM_STRING
 
+#include <memory>
 #include <regex>
 #include <string>
 #include <vector>
 
 #include "azurestorage.hpp"
 #include "filesystem.hpp"
+#include "objectlisting.hpp"
 #include "status.hpp"
 
 namespace ovms {
@@ -156,11 +158,28 @@ private:
     StatusCode downloadFileFolderTo(const std::string& path,
         const std::string& local_path);
 
+    /**
+   * @brief Lists blobs under the first queried path recursively, later queries under it are answered from the listing
+   *
+   * File shares cannot be listed recursively, their paths are always queried remotely.
+   *
+   * @param path
+   * @return listing covering the path or nullptr if path has to be queried remotely
+   */
+    const ObjectListing* getListing(const std::string& path);
+
     /**
    * @brief
    *
    */
     as::cloud_storage_account account_;
+
+    /**
+   * @brief Listing of model base path, filesystem is created for single scan of model versions so it is not refreshed
+   *
+   */
+    std::unique_ptr<ObjectListing> listing_;
+    bool listingAttempted_ = false;
 };
 
 }  // namespace ovms
@@ -15,9 +15,18 @@
 //*****************************************************************************
 #include "azurestorage.hpp"
 
-#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <cpprest/containerstream.h>
 
 #include "azurefilesystem.hpp"
+#include "cloudfilecache.hpp"
 
 namespace ovms {
 
@@ -61,6 +70,15 @@ bool AzureStorageAdapter::isAbsolutePath(const std::string& path) {
     return !path.empty() && (path[0] == '/');
 }
 
+const uint AzureStorageBlob::LISTING_TIMEOUT_SECONDS = 30;
+uint AzureStorageBlob::downloadParallelism = 8;
+uint64_t AzureStorageBlob::downloadChunkSize = 8 * 1024 * 1024;
+
+void AzureStorageBlob::setDownloadOptions(uint parallelism, uint64_t chunkSize) {
+    downloadParallelism = std::max<uint>(parallelism, 1);
+    downloadChunkSize = std::max<uint64_t>(chunkSize, 1);
+}
+
 AzureStorageBlob::AzureStorageBlob(const std::string& path, as::cloud_storage_account account) {
     account_ = account;
     as_blob_client_ = account_.create_cloud_blob_client();
@@ -445,14 +463,12 @@ StatusCode AzureStorageBlob::downloadFile(const std::string& local_path) {
                 return status;
         }
 
-        as_blob_ = as_container_.get_blob_reference(blockpath_);
-        if (!as_blob_.exists()) {
-            SPDLOG_WARN("AS: block blob does not exist: {} -> {}", fullPath_, blockpath_);
-            return StatusCode::AS_FILE_NOT_FOUND;
+        std::vector<DownloadPart> parts;
+        auto status = prepareDownloadParts(blockpath_, fullUri_, local_path, parts);
+        if (status != StatusCode::OK) {
+            return status;
         }
-
-        as_blob_.download_to_file(local_path);
-        return StatusCode::OK;
+        return downloadParts(parts);
     } catch (const as::storage_exception& e) {
         SPDLOG_ERROR("Unable to access path: {}", e.what());
         as::request_result result = e.result();
@@ -528,29 +544,96 @@ StatusCode AzureStorageBlob::downloadFileFolderTo(const std::string& local_path)
             }
         }
 
+        // files share the pool of download threads, large files are split into ranges
+        std::vector<DownloadPart> parts;
         for (auto&& f : files) {
             std::string remote_file_path = joinPath({fullUri_, f});
             std::string local_file_path = joinPath({local_path, f});
+            std::string blob_name = blockpath_.empty() ? f : joinPath({blockpath_, f});
             SPDLOG_TRACE("Processing file {} from {} -> {}", f, remote_file_path,
                 local_file_path);
 
-            auto factory = std::make_shared<ovms::AzureStorageFactory>();
-            auto azureFiledirStorageObj = factory.get()->getNewAzureStorageObject(remote_file_path, account_);
-            status = azureFiledirStorageObj->checkPath(remote_file_path);
+            status = prepareDownloadParts(blob_name, remote_file_path, local_file_path, parts);
             if (status != StatusCode::OK) {
-                SPDLOG_ERROR("Unable to download directory from {} to {}",
-                    remote_file_path, local_file_path);
-                return status;
-            }
-
-            auto download_status =
-                azureFiledirStorageObj->downloadFile(local_file_path);
-            if (download_status != StatusCode::OK) {
                 SPDLOG_ERROR("Unable to save file from {} to {}", remote_file_path,
                     local_file_path);
-                return download_status;
+                return status;
             }
         }
+        status = downloadParts(parts);
+        if (status != StatusCode::OK) {
+            SPDLOG_ERROR("Unable to download files from {} to {}", fullUri_, local_path);
+            return status;
+        }
+        return StatusCode::OK;
+    } catch (const as::storage_exception& e) {
+        SPDLOG_ERROR("Unable to access path: {}", e.what());
+        as::request_result result = e.result();
+        as::storage_extended_error extended_error = result.extended_error();
+        if (!extended_error.message().empty()) {
+            SPDLOG_ERROR("Unable to access path: {}", extended_error.message());
+        }
+    } catch (const std::exception& e) {
+        SPDLOG_ERROR("Unable to access path: {}", e.what());
+    }
+
+    return StatusCode::AS_FILE_NOT_FOUND;
+}
+
+StatusCode AzureStorageBlob::prepareDownloadParts(const std::string& blobName, const std::string& remoteUri, const std::string& localPath, std::vector<DownloadPart>& parts) {
+    as::cloud_blob blob = as_container_.get_blob_reference(blobName);
+    if (!blob.exists()) {
+        SPDLOG_WARN("AS: block blob does not exist: {} -> {}", remoteUri, blobName);
+        return StatusCode::AS_FILE_NOT_FOUND;
+    }
+    blob.download_attributes();
+    const std::string etag = blob.properties().etag();
+    if (CloudFileCache::getInstance().fetch(remoteUri, etag, localPath)) {
+        return StatusCode::OK;
+    }
+    const uint64_t size = blob.properties().size();
+    if (size <= downloadChunkSize || downloadParallelism <= 1) {
+        parts.push_back({blobName, remoteUri, localPath, 0, size, false, etag});
+        return StatusCode::OK;
+    }
+    // ranges are written in place, so file gets its final size up front
+    std::error_code ec;
+    { std::ofstream file(localPath, std::ios::binary | std::ios::trunc); }
+    std::filesystem::resize_file(localPath, size, ec);
+    if (ec) {
+        SPDLOG_ERROR("Failed to create local file: {} {}", localPath, ec.message());
+        return StatusCode::AS_FILE_NOT_FOUND;
+    }
+    for (uint64_t offset = 0; offset < size; offset += downloadChunkSize) {
+        parts.push_back({blobName, remoteUri, localPath, offset, std::min(downloadChunkSize, size - offset), true, etag});
+    }
+    return StatusCode::OK;
+}
+
+StatusCode AzureStorageBlob::downloadPart(const DownloadPart& part) {
+    try {
+        as::cloud_blob blob = as_container_.get_blob_reference(part.blobName);
+        // ranges of blob replaced during download would mix its contents, service rejects them with 412 instead
+        const auto condition = as::access_condition::generate_if_match_condition(part.etag);
+        if (!part.ranged) {
+            blob.download_to_file(part.localPath, condition, as::blob_request_options(), as::operation_context());
+            return StatusCode::OK;
+        }
+        concurrency::streams::container_buffer<std::vector<uint8_t>> buffer;
+        concurrency::streams::ostream output_stream(buffer);
+        blob.download_range_to_stream(output_stream, part.offset, part.size, condition, as::blob_request_options(), as::operation_context());
+        const auto& data = buffer.collection();
+        if (data.size() != part.size) {
+            SPDLOG_ERROR("AS: received {} bytes of {} at offset {} of {}", data.size(), part.size, part.offset, part.remoteUri);
+            return StatusCode::AS_FILE_NOT_FOUND;
+        }
+        std::fstream file(part.localPath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(part.offset);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!file.good()) {
+            SPDLOG_ERROR("Failed to write local file: {}", part.localPath);
+            return StatusCode::AS_FILE_NOT_FOUND;
+        }
         return StatusCode::OK;
     } catch (const as::storage_exception& e) {
         SPDLOG_ERROR("Unable to access path: {}", e.what());
@@ -566,6 +649,45 @@ StatusCode AzureStorageBlob::downloadFileFolderTo(const std::string& local_path)
     return StatusCode::AS_FILE_NOT_FOUND;
 }
 
+StatusCode AzureStorageBlob::downloadParts(const std::vector<DownloadPart>& parts) {
+    // threads reuse connections of the container client instead of opening client per file
+    const size_t threadsCount = std::min<size_t>(downloadParallelism, parts.size());
+    std::atomic<size_t> nextPart{0};
+    std::mutex resultMtx;
+    StatusCode result = StatusCode::OK;
+    auto download = [this, &parts, &nextPart, &resultMtx, &result]() {
+        for (size_t i = nextPart++; i < parts.size(); i = nextPart++) {
+            auto status = downloadPart(parts[i]);
+            if (status != StatusCode::OK) {
+                std::lock_guard<std::mutex> lock(resultMtx);
+                result = status;
+                // remaining parts are skipped
+                nextPart = parts.size();
+            }
+        }
+    };
+    if (threadsCount <= 1) {
+        download();
+    } else {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadsCount; ++i) {
+            threads.emplace_back(download);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    if (result != StatusCode::OK) {
+        return result;
+    }
+    for (const auto& part : parts) {
+        if (part.offset == 0) {
+            CloudFileCache::getInstance().store(part.remoteUri, part.etag, part.localPath);
+        }
+    }
+    return result;
+}
+
 std::string AzureStorageBlob::getNameFromPath(std::string& path) {
     int name_start = path.find_last_of("/");
     int name_end = path.length();
@@ -579,6 +701,50 @@ std::string AzureStorageBlob::getNameFromPath(std::string& path) {
     return path.substr(name_start, name_end - name_start);
 }
 
+StatusCode AzureStorageBlob::listObjectsRecursively(files_list_t* objects) {
+    try {
+        if (!isPathValidationOk_) {
+            auto status = checkPath(fullUri_);
+            if (status != StatusCode::OK)
+                return status;
+        }
+
+        // flat listing returns blobs of all subdirectories in a few requests
+        // hanging listing would delay checks of all models, so it is bounded including retries
+        as::blob_request_options options;
+        options.set_maximum_execution_time(std::chrono::seconds(LISTING_TIMEOUT_SECONDS));
+        as::continuation_token token;
+        do {
+            as::list_blob_item_segment result = as_container_.list_blobs_segmented(blockpath_, true,
+                as::blob_listing_details::none, 0, token, options, as::operation_context());
+            for (auto& item : result.results()) {
+                if (!item.is_blob()) {
+                    continue;
+                }
+                // prefix matches also siblings sharing the name beginning
+                std::string name = item.as_blob().name();
+                if (blockpath_.empty() || name == blockpath_ || name.rfind(blockpath_ + "/", 0) == 0) {
+                    objects->insert(AzureFileSystem::AZURE_URL_BLOB_PREFIX + container_ + "/" + name);
+                }
+            }
+            token = result.continuation_token();
+        } while (!token.empty());
+
+        return StatusCode::OK;
+    } catch (const as::storage_exception& e) {
+        SPDLOG_ERROR("Unable to access path: {}", e.what());
+        as::request_result result = e.result();
+        as::storage_extended_error extended_error = result.extended_error();
+        if (!extended_error.message().empty()) {
+            SPDLOG_ERROR("Unable to access path: {}", extended_error.message());
+        }
+    } catch (const std::exception& e) {
+        SPDLOG_ERROR("Unable to access path: {}", e.what());
+    }
+
+    return StatusCode::AS_FILE_NOT_FOUND;
+}
+
 StatusCode AzureStorageBlob::parseFilePath(const std::string& path) {
     // az://share/blockpath/file
     // az://share/blockpath
@@ -1097,7 +1263,14 @@ StatusCode AzureStorageFile::downloadFile(const std::string& local_path) {
             return StatusCode::AS_FILE_NOT_FOUND;
         }
 
+        auto& cache = CloudFileCache::getInstance();
+        as_file1_.download_attributes();
+        const std::string etag = as_file1_.properties().etag();
+        if (cache.fetch(fullUri_, etag, local_path)) {
+            return StatusCode::OK;
+        }
         as_file1_.download_to_file(local_path);
+        cache.store(fullUri_, etag, local_path);
         return StatusCode::OK;
     } catch (const as::storage_exception& e) {
         SPDLOG_ERROR("Unable to access path: {}", e.what());
@@ -51,6 +51,13 @@ public:
     virtual StatusCode downloadFileFolderTo(const std::string& local_path) = 0;
     virtual StatusCode checkPath(const std::string& path) = 0;
 
+    /**
+     * @brief Lists full paths of all objects under the path, including objects in its subdirectories
+     */
+    virtual StatusCode listObjectsRecursively(files_list_t* objects) {
+        return StatusCode::AS_INCORRECT_REQUESTED_OBJECT_TYPE;
+    }
+
     std::string joinPath(std::initializer_list<std::string> segments);
     StatusCode CreateLocalDir(const std::string& path);
     bool isAbsolutePath(const std::string& path);
@@ -88,7 +95,47 @@ public:
 
     StatusCode downloadFileFolderTo(const std::string& local_path) override;
 
+    StatusCode listObjectsRecursively(files_list_t* objects) override;
+
+    /**
+     * @brief Sets number of concurrent ranged requests and size of ranges used to download blobs
+     *
+     * Blobs not larger than chunk size are downloaded with single request.
+     */
+    static void setDownloadOptions(uint parallelism, uint64_t chunkSize);
+
+    /**
+     * @brief Time limit of recursive listing including its retries
+     */
+    static const uint LISTING_TIMEOUT_SECONDS;
+
 private:
+    struct DownloadPart {
+        std::string blobName;
+        std::string remoteUri;
+        std::string localPath;
+        uint64_t offset;
+        uint64_t size;
+        bool ranged;
+        std::string etag;
+    };
+
+    /**
+     * @brief Splits blob into download parts and preallocates local file, nothing is added for blobs found in cache
+     */
+    StatusCode prepareDownloadParts(const std::string& blobName, const std::string& remoteUri, const std::string& localPath, std::vector<DownloadPart>& parts);
+
+    /**
+     * @brief Downloads parts of all blobs on pool of parallelism threads sharing container client
+     */
+    StatusCode downloadParts(const std::vector<DownloadPart>& parts);
+
+    StatusCode downloadPart(const DownloadPart& part);
+
+    static uint downloadParallelism;
+
+    static uint64_t downloadChunkSize;
+
     std::string getLastPathPart(const std::string& path);
 
     StatusCode parseFilePath(const std::string& path) override;
@@ -0,0 +1,320 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "batchingscheduler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "executinstreamidguard.hpp"
+#include "imagedecoding.hpp"
+#include "modelinstance.hpp"
+#include "ov_utils.hpp"
+#include "prediction_service_utils.hpp"
+#include "serialization.hpp"
+#include "shapebuckets.hpp"
+#include "sharedmemory.hpp"
+#include "tensorconversion.hpp"
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+namespace {
+
+void copyTensorProtoToBatchSlice(const tensorflow::TensorProto& requestInput, char* destination, size_t sliceByteSize) {
+    // FP16 and U16 values are padded to 4 bytes in the proto unless packed in tensor_content, see deserialization.hpp
+    const bool padded = requestInput.tensor_content().empty();
+    if (padded && requestInput.dtype() == tensorflow::DataType::DT_HALF) {
+        narrowToUint16(requestInput.half_val().data(), reinterpret_cast<uint16_t*>(destination), static_cast<size_t>(requestInput.half_val_size()));
+    } else if (padded && requestInput.dtype() == tensorflow::DataType::DT_UINT16) {
+        narrowToUint16(requestInput.int_val().data(), reinterpret_cast<uint16_t*>(destination), static_cast<size_t>(requestInput.int_val_size()));
+    } else {
+        std::memcpy(destination, requestInput.tensor_content().data(), std::min(sliceByteSize, requestInput.tensor_content().size()));
+    }
+}
+
+InferenceEngine::Blob::Ptr copyBlobBatchSlice(const InferenceEngine::Blob::Ptr& blob, size_t index, size_t batchSize) {
+    // node results outlive the batch, infer request is reused by next batch right away
+    const auto& tensorDesc = blob->getTensorDesc();
+    auto dims = tensorDesc.getDims();
+    dims[0] = 1;
+    auto slice = blobAllocate(InferenceEngine::TensorDesc(tensorDesc.getPrecision(), dims, tensorDesc.getLayout()));
+    const size_t sliceByteSize = blob->byteSize() / batchSize;
+    std::memcpy(slice->buffer().as<char*>(), blob->cbuffer().as<const char*>() + index * sliceByteSize, sliceByteSize);
+    return slice;
+}
+
+}  // namespace
+
+bool BatchingScheduler::isRequestBatchable(const PredictRequest* request) {
+    if (request->inputs_size() == 0) {
+        return false;
+    }
+    for (const auto& pair : request->inputs()) {
+        const auto& shape = pair.second.tensor_shape();
+        // inputs in shared memory are inferred in place
+        if (shape.dim_size() == 0 || shape.dim(0).size() != 1 || isSharedMemoryInput(pair.second) || isImageInput(pair.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchingScheduler::areBlobsBatchable(const BlobMap& inputs) {
+    if (inputs.size() == 0) {
+        return false;
+    }
+    for (const auto& pair : inputs) {
+        const auto& dims = pair.second->getTensorDesc().getDims();
+        if (dims.size() == 0 || dims[0] != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BatchingScheduler::~BatchingScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    batchClosed.notify_all();
+    if (deadlineThread.joinable()) {
+        deadlineThread.join();
+    }
+}
+
+OVInferRequestsQueue& BatchingScheduler::getInferRequestsQueue() {
+    return bucket != nullptr ? *bucket->inferRequestsQueue : modelInstance.getInferRequestsQueue();
+}
+
+const tensor_map_t& BatchingScheduler::getInputsInfo() const {
+    return bucket != nullptr ? bucket->inputsInfo : modelInstance.getInputsInfo();
+}
+
+const tensor_map_t& BatchingScheduler::getOutputsInfo() const {
+    return bucket != nullptr ? bucket->outputsInfo : modelInstance.getOutputsInfo();
+}
+
+std::shared_ptr<BatchingScheduler::Batch> BatchingScheduler::getOpenBatch() {
+    if (!currentBatch) {
+        currentBatch = std::make_shared<Batch>();
+        currentBatch->slots.reserve(maxBatchSize);
+        currentBatch->deadline = std::chrono::steady_clock::now() + timeout;
+    }
+    return currentBatch;
+}
+
+Status BatchingScheduler::schedule(const PredictRequest* request, PredictResponse* response) {
+    std::shared_ptr<Batch> batch;
+    std::future<Status> result;
+    size_t slotIndex;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        batch = getOpenBatch();
+        slotIndex = batch->slots.size();
+        batch->slots.push_back(BatchSlot{request, response, std::promise<Status>()});
+        result = batch->slots.back().result.get_future();
+
+        if (batch->slots.size() == maxBatchSize) {
+            // request completing the batch executes it right away
+            batch->closed = true;
+            currentBatch.reset();
+            lock.unlock();
+            batchClosed.notify_all();
+            executeAndNotify(*batch);
+        } else if (slotIndex == 0) {
+            // first request of the batch waits for other requests up to the deadline
+            batchClosed.wait_until(lock, batch->deadline, [&batch]() { return batch->closed; });
+            if (!batch->closed) {
+                batch->closed = true;
+                currentBatch.reset();
+                lock.unlock();
+                executeAndNotify(*batch);
+            }
+        }
+    }
+    return result.get();
+}
+
+void BatchingScheduler::scheduleNode(BlobMap inputs, NodeSlotCallback onCompleted) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto batch = getOpenBatch();
+    const size_t slotIndex = batch->slots.size();
+    auto& slot = batch->slots.emplace_back();
+    slot.inputs = std::move(inputs);
+    slot.onNodeCompleted = std::move(onCompleted);
+
+    if (batch->slots.size() == maxBatchSize) {
+        // node completing the batch executes it right away
+        batch->closed = true;
+        currentBatch.reset();
+        lock.unlock();
+        batchClosed.notify_all();
+        executeAndNotify(*batch);
+    } else if (slotIndex == 0) {
+        batch->closedByDeadlineThread = true;
+        if (!deadlineThread.joinable()) {
+            deadlineThread = std::thread(&BatchingScheduler::closeBatchesAtDeadline, this);
+        }
+        lock.unlock();
+        batchClosed.notify_all();
+    }
+}
+
+void BatchingScheduler::closeBatchesAtDeadline() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!stopping) {
+        if (!currentBatch || !currentBatch->closedByDeadlineThread) {
+            batchClosed.wait(lock, [this]() { return stopping || (currentBatch && currentBatch->closedByDeadlineThread); });
+            continue;
+        }
+        auto batch = currentBatch;
+        batchClosed.wait_until(lock, batch->deadline, [this, &batch]() { return batch->closed || stopping; });
+        if (!batch->closed) {
+            // when stopping, pending nodes still get their results
+            batch->closed = true;
+            currentBatch.reset();
+            lock.unlock();
+            executeAndNotify(*batch);
+            lock.lock();
+        }
+    }
+}
+
+void BatchingScheduler::executeAndNotify(Batch& batch) {
+    SPDLOG_DEBUG("Model:{} version:{} executing batch of {} requests", modelInstance.getName(), modelInstance.getVersion(), batch.slots.size());
+    auto status = execute(batch);
+    for (auto& slot : batch.slots) {
+        if (slot.isNodeSlot()) {
+            // node slot results are not valid if batch failed
+            if (!status.ok()) {
+                slot.outputs.clear();
+            }
+            slot.onNodeCompleted(status, std::move(slot.outputs));
+        } else {
+            slot.result.set_value(status);
+        }
+    }
+}
+
+Status BatchingScheduler::execute(Batch& batch) {
+    OVInferRequestsQueue& inferRequestsQueue = getInferRequestsQueue();
+    ExecutingStreamIdGuard executingStreamIdGuard(inferRequestsQueue);
+    int executingInferId = executingStreamIdGuard.getId();
+    InferenceEngine::InferRequest& inferRequest = inferRequestsQueue.getInferRequest(executingInferId);
+
+    auto status = prepareInputs(batch, inferRequest, inferRequestsQueue.getPreallocatedInputBlobs(executingInferId));
+    if (!status.ok())
+        return status;
+    status = performInference(inferRequestsQueue, executingInferId, inferRequest);
+    if (!status.ok())
+        return status;
+    modelInstance.recordPerfCounters(inferRequest);
+    return splitOutputs(batch, inferRequest);
+}
+
+Status BatchingScheduler::prepareInputs(Batch& batch, InferenceEngine::InferRequest& inferRequest, const InferenceEngine::BlobMap& preallocatedBlobs) {
+    try {
+        for (const auto& pair : getInputsInfo()) {
+            const auto& name = pair.first;
+            auto& tensorInfo = pair.second;
+            auto blobItr = preallocatedBlobs.find(tensorInfo->getName());
+            if (blobItr == preallocatedBlobs.end()) {
+                SPDLOG_ERROR("Failed to deserialize batched request. Missing preallocated blob for input: {}", tensorInfo->getName());
+                return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
+            }
+            auto& blob = blobItr->second;
+            char* buffer = blob->buffer().as<char*>();
+            const size_t sliceByteSize = blob->byteSize() / maxBatchSize;
+            for (size_t i = 0; i < batch.slots.size(); i++) {
+                auto status = copyInputToBatchSlice(batch.slots[i], name, buffer + i * sliceByteSize, sliceByteSize);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+            // unused part of the batch is zeroed, its results are discarded
+            std::memset(buffer + batch.slots.size() * sliceByteSize, 0, (maxBatchSize - batch.slots.size()) * sliceByteSize);
+            // pipeline nodes may have left their own blobs on the infer request
+            if (inferRequest.GetBlob(tensorInfo->getName()) != blob) {
+                inferRequest.SetBlob(tensorInfo->getName(), blob);
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        Status status = StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+        SPDLOG_ERROR("{}: {}", status.string(), e.what());
+        return status;
+    } catch (std::logic_error& e) {
+        Status status = StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+        SPDLOG_ERROR("{}: {}", status.string(), e.what());
+        return status;
+    }
+    return StatusCode::OK;
+}
+
+Status BatchingScheduler::copyInputToBatchSlice(const BatchSlot& slot, const std::string& name, char* destination, size_t sliceByteSize) {
+    if (slot.isNodeSlot()) {
+        auto inputItr = slot.inputs.find(name);
+        if (inputItr == slot.inputs.end() || inputItr->second->byteSize() != sliceByteSize) {
+            SPDLOG_ERROR("Failed to prepare batched node inputs. Missing input or invalid size of input: {}", name);
+            return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
+        }
+        std::memcpy(destination, inputItr->second->cbuffer().as<const char*>(), sliceByteSize);
+        return StatusCode::OK;
+    }
+    auto requestInputItr = slot.request->inputs().find(name);
+    if (requestInputItr == slot.request->inputs().end()) {
+        SPDLOG_ERROR("Failed to deserialize batched request. Validation of request failed");
+        return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
+    }
+    copyTensorProtoToBatchSlice(requestInputItr->second, destination, sliceByteSize);
+    return StatusCode::OK;
+}
+
+Status BatchingScheduler::splitOutputs(Batch& batch, InferenceEngine::InferRequest& inferRequest) {
+    for (const auto& pair : getOutputsInfo()) {
+        auto networkOutput = pair.second;
+        InferenceEngine::Blob::Ptr blob;
+        try {
+            blob = inferRequest.GetBlob(networkOutput->getName());
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_ERROR("{}: {}", status.string(), e.what());
+            return status;
+        }
+        for (size_t i = 0; i < batch.slots.size(); i++) {
+            auto& slot = batch.slots[i];
+            if (slot.isNodeSlot()) {
+                slot.outputs.emplace(networkOutput->getName(), copyBlobBatchSlice(blob, i, maxBatchSize));
+                continue;
+            }
+            auto& tensorProto = (*slot.response->mutable_outputs())[networkOutput->getMappedName()];
+            auto status = serializeBlobBatchSliceToTensorProto(tensorProto, networkOutput, blob, i);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
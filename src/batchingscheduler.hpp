@@ -0,0 +1,144 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "node.hpp"
+#include "ovinferrequestsqueue.hpp"
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+class ModelInstance;
+struct ShapeBucket;
+
+/**
+ * @brief Gathers concurrent batch size 1 predict requests of a single model instance
+ * and executes them as one inference on a network loaded with max batch size.
+ *
+ * The first request of a batch waits up to timeout for the batch to fill up and then
+ * executes it; the request which fills the batch executes it right away. Other requests
+ * only wait for their part of the results.
+ *
+ * Pipeline nodes of concurrent pipeline executions are merged into the same batches. Nodes do not
+ * wait for results, batch started by a node is executed at timeout by scheduler thread.
+ *
+ * Scheduler of a shape bucket merges requests padded to that bucket and runs them on its network.
+ */
+class BatchingScheduler {
+public:
+    /**
+     * @brief Receives result of node slot, outputs are keyed by network output names
+     */
+    using NodeSlotCallback = std::function<void(const Status& status, BlobMap&& outputs)>;
+
+    /**
+     * @param bucket shape bucket whose network runs the batches, nullptr for network of model instance
+     */
+    BatchingScheduler(ModelInstance& modelInstance, size_t maxBatchSize, std::chrono::microseconds timeout, const ShapeBucket* bucket = nullptr) :
+        modelInstance(modelInstance),
+        maxBatchSize(maxBatchSize),
+        timeout(timeout),
+        bucket(bucket) {}
+
+    ~BatchingScheduler();
+
+    /**
+     * @brief Checks if request can be merged with other requests by the scheduler
+     */
+    static bool isRequestBatchable(const tensorflow::serving::PredictRequest* request);
+
+    /**
+     * @brief Schedules the request for batched execution and blocks until response is ready
+     */
+    Status schedule(const tensorflow::serving::PredictRequest* request, tensorflow::serving::PredictResponse* response);
+
+    /**
+     * @brief Checks if inputs of pipeline node can be merged with other requests by the scheduler
+     */
+    static bool areBlobsBatchable(const BlobMap& inputs);
+
+    /**
+     * @brief Schedules inputs of pipeline node for batched execution and returns right away
+     *
+     * Inputs are keyed by model input names, onCompleted is invoked on thread executing the batch.
+     */
+    void scheduleNode(BlobMap inputs, NodeSlotCallback onCompleted);
+
+    size_t getMaxBatchSize() const { return maxBatchSize; }
+
+private:
+    struct BatchSlot {
+        // predict request slot
+        const tensorflow::serving::PredictRequest* request = nullptr;
+        tensorflow::serving::PredictResponse* response = nullptr;
+        std::promise<Status> result;
+
+        // pipeline node slot
+        BlobMap inputs;
+        BlobMap outputs;
+        NodeSlotCallback onNodeCompleted;
+
+        bool isNodeSlot() const { return request == nullptr; }
+    };
+
+    struct Batch {
+        std::vector<BatchSlot> slots;
+        std::chrono::steady_clock::time_point deadline;
+        bool closed = false;
+        // batch started by a node is closed at deadline by scheduler thread
+        bool closedByDeadlineThread = false;
+    };
+
+    OVInferRequestsQueue& getInferRequestsQueue();
+    const tensor_map_t& getInputsInfo() const;
+    const tensor_map_t& getOutputsInfo() const;
+
+    std::shared_ptr<Batch> getOpenBatch();
+    void closeBatchesAtDeadline();
+
+    Status execute(Batch& batch);
+    Status prepareInputs(Batch& batch, InferenceEngine::InferRequest& inferRequest, const InferenceEngine::BlobMap& preallocatedBlobs);
+    Status copyInputToBatchSlice(const BatchSlot& slot, const std::string& name, char* destination, size_t sliceByteSize);
+    Status splitOutputs(Batch& batch, InferenceEngine::InferRequest& inferRequest);
+    void executeAndNotify(Batch& batch);
+
+    ModelInstance& modelInstance;
+    const size_t maxBatchSize;
+    const std::chrono::microseconds timeout;
+    const ShapeBucket* const bucket;
+
+    std::mutex mtx;
+    std::condition_variable batchClosed;
+    std::shared_ptr<Batch> currentBatch;
+    std::thread deadlineThread;
+    bool stopping = false;
+};
+
+}  // namespace ovms
@@ -0,0 +1,730 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "batchjobs.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <spdlog/spdlog.h>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "modelinstance.hpp"
+#include "modelinstanceunloadguard.hpp"
+#include "modelmanager.hpp"
+#include "pipeline.hpp"
+#include "prediction_service_utils.hpp"
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+namespace {
+
+const char NPY_MAGIC[] = "\x93NUMPY";
+const size_t NPY_MAGIC_SIZE = 6;
+const char* const NPY_EXTENSION = ".npy";
+// used when concurrency of a pipeline job is not set, pipelines do not expose their streams
+const uint32_t DEFAULT_PIPELINE_CONCURRENCY = 4;
+
+struct NpyType {
+    const char* descr;
+    tensorflow::DataType dtype;
+    size_t size;
+};
+
+const NpyType NPY_TYPES[] = {
+    {"<f4", tensorflow::DataType::DT_FLOAT, 4},
+    {"<f8", tensorflow::DataType::DT_DOUBLE, 8},
+    {"<f2", tensorflow::DataType::DT_HALF, 2},
+    {"|u1", tensorflow::DataType::DT_UINT8, 1},
+    {"|i1", tensorflow::DataType::DT_INT8, 1},
+    {"<u2", tensorflow::DataType::DT_UINT16, 2},
+    {"<i2", tensorflow::DataType::DT_INT16, 2},
+    {"<i4", tensorflow::DataType::DT_INT32, 4},
+    {"<i8", tensorflow::DataType::DT_INT64, 8},
+    {"|b1", tensorflow::DataType::DT_BOOL, 1},
+};
+
+const NpyType* findNpyType(const std::string& descr) {
+    for (const auto& type : NPY_TYPES) {
+        if (descr == type.descr) {
+            return &type;
+        }
+    }
+    return nullptr;
+}
+
+const NpyType* findNpyType(tensorflow::DataType dtype) {
+    for (const auto& type : NPY_TYPES) {
+        if (dtype == type.dtype) {
+            return &type;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Finds value of the key in header dictionary, up to the comma or closing brace outside of parentheses
+ */
+bool findHeaderValue(const std::string& header, const std::string& key, std::string& value) {
+    auto position = header.find("'" + key + "'");
+    if (position == std::string::npos) {
+        return false;
+    }
+    position = header.find(':', position);
+    if (position == std::string::npos) {
+        return false;
+    }
+    int depth = 0;
+    size_t end = position + 1;
+    for (; end < header.size(); ++end) {
+        char c = header[end];
+        if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (depth == 0 && (c == ',' || c == '}')) {
+            break;
+        }
+    }
+    value = header.substr(position + 1, end - position - 1);
+    value.erase(0, value.find_first_not_of(" \t"));
+    value.erase(value.find_last_not_of(" \t") + 1);
+    return true;
+}
+
+bool parseNpyShape(const std::string& value, std::vector<int64_t>& shape) {
+    if (value.size() < 2 || value.front() != '(' || value.back() != ')') {
+        return false;
+    }
+    std::stringstream stream(value.substr(1, value.size() - 2));
+    std::string dimension;
+    while (std::getline(stream, dimension, ',')) {
+        dimension.erase(0, dimension.find_first_not_of(" \t"));
+        dimension.erase(dimension.find_last_not_of(" \t") + 1);
+        if (dimension.empty()) {
+            // trailing comma of single dimension tuple
+            continue;
+        }
+        if (dimension.size() > 18 || dimension.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        shape.push_back(std::stoll(dimension));
+    }
+    return true;
+}
+
+/**
+ * @brief Strips directories and .npy extension, returns false if the file is not .npy file
+ */
+bool getNpyStem(const std::string& path, std::string& stem) {
+    auto name = path.substr(path.find_last_of('/') + 1);
+    const size_t extensionSize = std::strlen(NPY_EXTENSION);
+    if (name.size() <= extensionSize || name.compare(name.size() - extensionSize, extensionSize, NPY_EXTENSION) != 0) {
+        return false;
+    }
+    stem = name.substr(0, name.size() - extensionSize);
+    return true;
+}
+
+/**
+ * @brief Replaces characters of tensor names which cannot be used in file names
+ */
+std::string toFileName(const std::string& name) {
+    std::string fileName = name;
+    std::replace_if(
+        fileName.begin(), fileName.end(), [](char c) { return c == '/' || c == '\\' || c == ':'; }, '_');
+    if (fileName.empty() || fileName == "." || fileName == "..") {
+        fileName = "_" + fileName;
+    }
+    return fileName;
+}
+
+bool isRelativeSubpath(const std::string& path) {
+    if (path.empty() || path[0] == '/') {
+        return false;
+    }
+    std::stringstream stream(path);
+    std::string component;
+    while (std::getline(stream, component, '/')) {
+        if (component == "..") {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream output(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output) {
+        return Status(StatusCode::BATCH_JOB_OUTPUT_ERROR, "Cannot open " + path);
+    }
+    output.write(contents.data(), contents.size());
+    output.close();
+    if (!output) {
+        return Status(StatusCode::BATCH_JOB_OUTPUT_ERROR, "Cannot write " + path);
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace
+
+Status parseNpy(const std::string& contents, tensorflow::TensorProto& tensor) {
+    if (contents.size() < NPY_MAGIC_SIZE + 4 || contents.compare(0, NPY_MAGIC_SIZE, NPY_MAGIC, NPY_MAGIC_SIZE) != 0) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Missing .npy magic string");
+    }
+    const uint8_t majorVersion = static_cast<uint8_t>(contents[NPY_MAGIC_SIZE]);
+    size_t headerOffset = 0;
+    size_t headerSize = 0;
+    if (majorVersion == 1) {
+        headerOffset = NPY_MAGIC_SIZE + 4;
+        headerSize = static_cast<uint8_t>(contents[8]) | (static_cast<uint8_t>(contents[9]) << 8);
+    } else if (majorVersion == 2 || majorVersion == 3) {
+        headerOffset = NPY_MAGIC_SIZE + 6;
+        if (contents.size() < headerOffset) {
+            return Status(StatusCode::NPY_FILE_INVALID, "Truncated header");
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            headerSize |= static_cast<size_t>(static_cast<uint8_t>(contents[8 + i])) << (8 * i);
+        }
+    } else {
+        return Status(StatusCode::NPY_FILE_INVALID, "Unsupported .npy version");
+    }
+    if (contents.size() < headerOffset + headerSize) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Truncated header");
+    }
+    const std::string header = contents.substr(headerOffset, headerSize);
+    std::string descr, fortranOrder, shapeValue;
+    if (!findHeaderValue(header, "descr", descr) || !findHeaderValue(header, "fortran_order", fortranOrder) ||
+        !findHeaderValue(header, "shape", shapeValue)) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Header misses descr, fortran_order or shape");
+    }
+    if (fortranOrder != "False") {
+        return Status(StatusCode::NPY_FILE_INVALID, "Only C ordered arrays are supported");
+    }
+    if (descr.size() < 2 || descr.front() != '\'' || descr.back() != '\'') {
+        return Status(StatusCode::NPY_FILE_INVALID, "Invalid descr");
+    }
+    descr = descr.substr(1, descr.size() - 2);
+    if (descr.size() == 3 && descr[0] == '=') {
+        descr[0] = '<';
+    }
+    const NpyType* type = findNpyType(descr);
+    if (type == nullptr) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Unsupported dtype " + descr);
+    }
+    std::vector<int64_t> shape;
+    if (!parseNpyShape(shapeValue, shape)) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Invalid shape");
+    }
+    size_t elementsCount = 1;
+    for (auto dimension : shape) {
+        if (dimension != 0 && elementsCount > std::numeric_limits<size_t>::max() / type->size / dimension) {
+            return Status(StatusCode::NPY_FILE_INVALID, "Shape is too large");
+        }
+        elementsCount *= dimension;
+    }
+    const size_t dataOffset = headerOffset + headerSize;
+    if (contents.size() - dataOffset != elementsCount * type->size) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Data size does not match shape");
+    }
+    tensor.Clear();
+    tensor.set_dtype(type->dtype);
+    for (auto dimension : shape) {
+        tensor.mutable_tensor_shape()->add_dim()->set_size(dimension);
+    }
+    tensor.mutable_tensor_content()->assign(contents, dataOffset, std::string::npos);
+    return StatusCode::OK;
+}
+
+Status serializeNpy(const tensorflow::TensorProto& tensor, std::string& contents) {
+    const NpyType* type = findNpyType(tensor.dtype());
+    if (type == nullptr) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Unsupported dtype " + tensorflow::DataType_Name(tensor.dtype()));
+    }
+    size_t elementsCount = 1;
+    std::stringstream shape;
+    shape << "(";
+    for (int i = 0; i < tensor.tensor_shape().dim_size(); ++i) {
+        auto dimension = tensor.tensor_shape().dim(i).size();
+        elementsCount *= dimension;
+        shape << dimension << (tensor.tensor_shape().dim_size() == 1 ? "," : "") << (i + 1 < tensor.tensor_shape().dim_size() ? ", " : "");
+    }
+    shape << ")";
+    if (tensor.tensor_content().size() != elementsCount * type->size) {
+        return Status(StatusCode::NPY_FILE_INVALID, "Tensor content does not match shape");
+    }
+    std::string header = std::string("{'descr': '") + type->descr + "', 'fortran_order': False, 'shape': " + shape.str() + ", }";
+    // data is aligned to 64 bytes, header ends with a newline
+    const size_t prefixSize = NPY_MAGIC_SIZE + 4;
+    header.append(63 - (prefixSize + header.size()) % 64, ' ');
+    header.push_back('\n');
+    contents.clear();
+    contents.reserve(prefixSize + header.size() + tensor.tensor_content().size());
+    contents.append(NPY_MAGIC, NPY_MAGIC_SIZE);
+    contents.push_back('\x01');
+    contents.push_back('\x00');
+    contents.push_back(static_cast<char>(header.size() & 0xff));
+    contents.push_back(static_cast<char>((header.size() >> 8) & 0xff));
+    contents.append(header);
+    contents.append(tensor.tensor_content());
+    return StatusCode::OK;
+}
+
+const char* toString(BatchJobState state) {
+    switch (state) {
+    case BatchJobState::PENDING:
+        return "PENDING";
+    case BatchJobState::RUNNING:
+        return "RUNNING";
+    case BatchJobState::SUCCEEDED:
+        return "SUCCEEDED";
+    case BatchJobState::FAILED:
+        return "FAILED";
+    case BatchJobState::CANCELLED:
+        return "CANCELLED";
+    }
+    return "UNKNOWN";
+}
+
+Status parseBatchJobSpec(const std::string& body, BatchJobSpec& spec) {
+    rapidjson::Document doc;
+    if (doc.Parse(body.c_str()).HasParseError() || !doc.IsObject()) {
+        return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
+    }
+    auto modelName = doc.FindMember("model_name");
+    auto modelVersion = doc.FindMember("model_version");
+    auto input = doc.FindMember("input");
+    auto output = doc.FindMember("output");
+    auto concurrency = doc.FindMember("concurrency");
+    if (modelName == doc.MemberEnd() || !modelName->value.IsString() ||
+        input == doc.MemberEnd() || !input->value.IsString() ||
+        output == doc.MemberEnd() || !output->value.IsString() ||
+        (modelVersion != doc.MemberEnd() && !modelVersion->value.IsInt64()) ||
+        (concurrency != doc.MemberEnd() && !concurrency->value.IsUint())) {
+        return Status(StatusCode::BATCH_JOB_INVALID, "Expected string model_name, input and output, optional integer model_version and concurrency");
+    }
+    spec.servableName = modelName->value.GetString();
+    spec.version = modelVersion != doc.MemberEnd() ? modelVersion->value.GetInt64() : 0;
+    spec.inputPath = input->value.GetString();
+    spec.outputPath = output->value.GetString();
+    spec.concurrency = concurrency != doc.MemberEnd() ? concurrency->value.GetUint() : 0;
+    if (spec.servableName.empty() || spec.inputPath.empty() || spec.version < 0) {
+        return Status(StatusCode::BATCH_JOB_INVALID, "Empty model_name or input, or negative model_version");
+    }
+    if (!isRelativeSubpath(spec.outputPath)) {
+        return Status(StatusCode::BATCH_JOB_INVALID, "Output must be a relative path without .. components");
+    }
+    return StatusCode::OK;
+}
+
+Status BatchJob::listSamples(std::vector<std::string>& samples, bool& singleFile) const {
+    auto fs = getFilesystem(spec.inputPath);
+    files_list_t files;
+    files_list_t subdirs;
+    auto status = fs->getDirectoryFiles(spec.inputPath, &files);
+    if (status != StatusCode::OK) {
+        return Status(status, "Cannot list input " + spec.inputPath);
+    }
+    status = fs->getDirectorySubdirs(spec.inputPath, &subdirs);
+    if (status != StatusCode::OK) {
+        return Status(status, "Cannot list input " + spec.inputPath);
+    }
+    for (const auto& file : files) {
+        std::string stem;
+        if (getNpyStem(file, stem)) {
+            samples.push_back(stem);
+        }
+    }
+    if (!samples.empty() && !subdirs.empty()) {
+        return Status(StatusCode::BATCH_JOB_INVALID, "Input mixes .npy files and sample directories");
+    }
+    singleFile = !samples.empty();
+    if (!singleFile) {
+        samples.assign(subdirs.begin(), subdirs.end());
+    }
+    std::sort(samples.begin(), samples.end());
+    return StatusCode::OK;
+}
+
+Status BatchJob::getSingleInputName(ModelManager& manager, std::string& inputName) const {
+    tensor_map_t inputsInfo;
+    if (pipeline) {
+        auto status = manager.getPipelineFactory().getInputsInfo(spec.servableName, inputsInfo, manager);
+        if (!status.ok()) {
+            return status;
+        }
+    } else {
+        std::shared_ptr<ModelInstance> modelInstance;
+        std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+        auto status = getModelInstance(manager, spec.servableName, spec.version, modelInstance, unloadGuard);
+        if (!status.ok()) {
+            return status;
+        }
+        inputsInfo = modelInstance->getInputsInfo();
+    }
+    if (inputsInfo.size() != 1) {
+        return Status(StatusCode::BATCH_JOB_INVALID, "Samples in .npy files require servable with a single input, use sample directories");
+    }
+    inputName = inputsInfo.begin()->first;
+    return StatusCode::OK;
+}
+
+Status BatchJob::inferSample(ModelManager& manager, const std::string& sample, bool singleFile, const std::string& singleInputName) const {
+    PredictRequest request;
+    PredictResponse response;
+    request.mutable_model_spec()->set_name(spec.servableName);
+    if (spec.version != 0) {
+        request.mutable_model_spec()->mutable_version()->set_value(spec.version);
+    }
+    auto fs = getFilesystem(spec.inputPath);
+    std::map<std::string, std::string> inputFiles;
+    if (singleFile) {
+        inputFiles.emplace(singleInputName, joinPath({spec.inputPath, sample + NPY_EXTENSION}));
+    } else {
+        files_list_t files;
+        const std::string sampleDirectory = joinPath({spec.inputPath, sample});
+        auto status = fs->getDirectoryFiles(sampleDirectory, &files);
+        if (status != StatusCode::OK) {
+            return status;
+        }
+        for (const auto& file : files) {
+            std::string inputName;
+            if (getNpyStem(file, inputName)) {
+                inputFiles.emplace(inputName, joinPath({sampleDirectory, inputName + NPY_EXTENSION}));
+            }
+        }
+        if (inputFiles.empty()) {
+            return Status(StatusCode::BATCH_JOB_INVALID, "Sample directory has no .npy files");
+        }
+    }
+    std::string contents;
+    for (const auto& [inputName, path] : inputFiles) {
+        auto status = fs->readTextFile(path, &contents);
+        if (status != StatusCode::OK) {
+            return Status(status, "Cannot read " + path);
+        }
+        Status parseStatus = parseNpy(contents, (*request.mutable_inputs())[inputName]);
+        if (!parseStatus.ok()) {
+            return parseStatus;
+        }
+    }
+
+    Status status;
+    if (pipeline) {
+        std::unique_ptr<Pipeline> pipelinePtr;
+        status = getPipeline(manager, pipelinePtr, &request, &response);
+        if (status.ok()) {
+            status = pipelinePtr->execute();
+        }
+    } else {
+        std::shared_ptr<ModelInstance> modelInstance;
+        std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+        status = getModelInstance(manager, spec.servableName, spec.version, modelInstance, unloadGuard);
+        if (status.ok()) {
+            status = inference(*modelInstance, &request, &response, unloadGuard, nullptr, nullptr, RequestPriority::LOW);
+        }
+    }
+    if (!status.ok()) {
+        return status;
+    }
+
+    const std::string sampleOutputDirectory = joinPath({outputDirectory, sample});
+    std::error_code error;
+    std::filesystem::create_directories(sampleOutputDirectory, error);
+    if (error) {
+        return Status(StatusCode::BATCH_JOB_OUTPUT_ERROR, "Cannot create " + sampleOutputDirectory + ": " + error.message());
+    }
+    for (const auto& [outputName, tensor] : response.outputs()) {
+        status = serializeNpy(tensor, contents);
+        if (!status.ok()) {
+            return status;
+        }
+        status = writeFile(joinPath({sampleOutputDirectory, toFileName(outputName) + NPY_EXTENSION}), contents);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return StatusCode::OK;
+}
+
+void BatchJob::recordError(const std::string& sample, const Status& status) {
+    std::lock_guard<std::mutex> lock(errorsMtx);
+    if (sample.empty()) {
+        jobError = status.string();
+    } else if (sampleErrors.size() < MAX_SAMPLE_ERRORS) {
+        sampleErrors.emplace_back(sample, status.string());
+    }
+}
+
+void BatchJob::run(ModelManager& manager) {
+    if (cancelled) {
+        state = BatchJobState::CANCELLED;
+        return;
+    }
+    state = BatchJobState::RUNNING;
+    std::vector<std::string> samples;
+    bool singleFile = false;
+    std::string singleInputName;
+    auto status = listSamples(samples, singleFile);
+    if (status.ok() && singleFile) {
+        status = getSingleInputName(manager, singleInputName);
+    }
+    uint32_t concurrency = spec.concurrency;
+    if (status.ok() && concurrency == 0) {
+        concurrency = DEFAULT_PIPELINE_CONCURRENCY;
+        if (!pipeline) {
+            std::shared_ptr<ModelInstance> modelInstance;
+            std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+            status = getModelInstance(manager, spec.servableName, spec.version, modelInstance, unloadGuard);
+            if (status.ok()) {
+                concurrency = std::max(1, modelInstance->getInferRequestsQueue().getStreamsLength());
+            }
+        }
+    } else if (status.ok()) {
+        // requests above streams only wait in the queue, ahead of interactive requests of other models
+        uint32_t maxConcurrency = MAX_CONCURRENCY;
+        if (!pipeline) {
+            std::shared_ptr<ModelInstance> modelInstance;
+            std::unique_ptr<ModelInstanceUnloadGuard> unloadGuard;
+            status = getModelInstance(manager, spec.servableName, spec.version, modelInstance, unloadGuard);
+            if (status.ok()) {
+                maxConcurrency = std::max(1, modelInstance->getInferRequestsQueue().getStreamsLength());
+            }
+        }
+        if (concurrency > maxConcurrency) {
+            SPDLOG_INFO("Batch job {} concurrency {} limited to {}", id, concurrency, maxConcurrency);
+            concurrency = maxConcurrency;
+        }
+    }
+    if (!status.ok()) {
+        SPDLOG_ERROR("Batch job {} failed: {}", id, status.string());
+        recordError("", status);
+        state = BatchJobState::FAILED;
+        return;
+    }
+    samplesCount = samples.size();
+    SPDLOG_INFO("Batch job {} infers {} samples of {} with {} concurrent requests", id, samples.size(), spec.servableName, concurrency);
+
+    std::atomic<size_t> nextSample = 0;
+    auto worker = [&]() {
+        for (size_t i = nextSample++; i < samples.size() && !cancelled; i = nextSample++) {
+            auto sampleStatus = inferSample(manager, samples[i], singleFile, singleInputName);
+            if (sampleStatus.ok()) {
+                ++processedCount;
+            } else {
+                SPDLOG_DEBUG("Batch job {} sample {} failed: {}", id, samples[i], sampleStatus.string());
+                ++failedCount;
+                recordError(samples[i], sampleStatus);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    const size_t workersCount = std::min<size_t>(concurrency, samples.size());
+    for (size_t i = 1; i < workersCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    if (cancelled) {
+        state = BatchJobState::CANCELLED;
+    } else if (!samples.empty() && failedCount == samples.size()) {
+        state = BatchJobState::FAILED;
+    } else {
+        state = BatchJobState::SUCCEEDED;
+    }
+    SPDLOG_INFO("Batch job {} {}: {} samples processed, {} failed", id, toString(state), processedCount.load(), failedCount.load());
+}
+
+std::string BatchJob::toJson() const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("id");
+    writer.Uint64(id);
+    writer.Key("state");
+    writer.String(toString(state));
+    writer.Key("model_name");
+    writer.String(spec.servableName.c_str());
+    writer.Key("model_version");
+    writer.Int64(spec.version);
+    writer.Key("input");
+    writer.String(spec.inputPath.c_str());
+    writer.Key("output");
+    writer.String(spec.outputPath.c_str());
+    writer.Key("samples");
+    writer.Uint64(samplesCount);
+    writer.Key("processed");
+    writer.Uint64(processedCount);
+    writer.Key("failed");
+    writer.Uint64(failedCount);
+    std::lock_guard<std::mutex> lock(errorsMtx);
+    if (!jobError.empty()) {
+        writer.Key("error");
+        writer.String(jobError.c_str());
+    }
+    writer.Key("errors");
+    writer.StartArray();
+    for (const auto& [sample, error] : sampleErrors) {
+        writer.StartObject();
+        writer.Key("sample");
+        writer.String(sample.c_str());
+        writer.Key("error");
+        writer.String(error.c_str());
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+Status BatchJobs::configure(const std::string& outputRoot) {
+    if (!outputRoot.empty() && isCloudPath(outputRoot)) {
+        SPDLOG_ERROR("Batch jobs output path must be a local directory: {}", outputRoot);
+        return StatusCode::PATH_INVALID;
+    }
+    this->outputRoot = outputRoot;
+    return StatusCode::OK;
+}
+
+void BatchJobs::dropFinishedJobs() {
+    size_t finishedCount = std::count_if(jobs.begin(), jobs.end(), [](const auto& job) { return job.second->isFinished(); });
+    for (auto it = jobs.begin(); it != jobs.end() && finishedCount > MAX_FINISHED_JOBS;) {
+        auto thread = threads.find(it->first);
+        // thread finishing its job waits for the lock held here, it is dropped later
+        if (!it->second->isFinished() || (thread != threads.end() && finishedThreads.count(it->first) == 0)) {
+            ++it;
+            continue;
+        }
+        if (thread != threads.end()) {
+            thread->second.join();
+            threads.erase(thread);
+            finishedThreads.erase(it->first);
+        }
+        it = jobs.erase(it);
+        --finishedCount;
+    }
+}
+
+Status BatchJobs::submit(const std::string& body, ModelManager& manager, std::string& response) {
+    if (!isEnabled()) {
+        return StatusCode::BATCH_JOBS_DISABLED;
+    }
+    BatchJobSpec spec;
+    auto status = parseBatchJobSpec(body, spec);
+    if (!status.ok()) {
+        return status;
+    }
+    const bool pipeline = manager.pipelineDefinitionExists(spec.servableName);
+    if (!pipeline && manager.findModelByName(spec.servableName) == nullptr) {
+        return StatusCode::MODEL_NAME_MISSING;
+    }
+    if (pipeline && spec.version != 0) {
+        return Status(StatusCode::BATCH_JOB_INVALID, "Pipelines are not versioned");
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    dropFinishedJobs();
+    const uint64_t id = nextId++;
+    auto job = std::make_shared<BatchJob>(id, spec, joinPath({outputRoot, spec.outputPath}), pipeline);
+    jobs.emplace(id, job);
+    pendingJobs.emplace_back(job, &manager);
+    startPendingJobs();
+    SPDLOG_INFO("Submitted batch job {} of {} reading {} into {}", id, spec.servableName, spec.inputPath, spec.outputPath);
+    response = job->toJson();
+    return StatusCode::OK;
+}
+
+void BatchJobs::startPendingJobs() {
+    while (!joining && runningJobs < MAX_RUNNING_JOBS && !pendingJobs.empty()) {
+        auto [job, manager] = pendingJobs.front();
+        pendingJobs.pop_front();
+        ++runningJobs;
+        threads.emplace(job->getId(), std::thread([this, job = job, manager = manager]() {
+            job->run(*manager);
+            std::lock_guard<std::mutex> lock(mtx);
+            --runningJobs;
+            finishedThreads.insert(job->getId());
+            startPendingJobs();
+        }));
+    }
+}
+
+Status BatchJobs::getStatus(uint64_t id, std::string& response) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = jobs.find(id);
+    if (it == jobs.end()) {
+        return StatusCode::BATCH_JOB_MISSING;
+    }
+    response = it->second->toJson();
+    return StatusCode::OK;
+}
+
+std::string BatchJobs::list() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::string response = "[";
+    for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+        response += (it == jobs.begin() ? "" : ", ") + it->second->toJson();
+    }
+    response += "]";
+    return response;
+}
+
+Status BatchJobs::cancel(uint64_t id, std::string& response) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = jobs.find(id);
+    if (it == jobs.end()) {
+        return StatusCode::BATCH_JOB_MISSING;
+    }
+    it->second->cancel();
+    SPDLOG_INFO("Cancelled batch job {}", id);
+    response = it->second->toJson();
+    return StatusCode::OK;
+}
+
+void BatchJobs::join() {
+    std::map<uint64_t, std::thread> running;
+    decltype(pendingJobs) pending;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        joining = true;
+        for (auto& [id, job] : jobs) {
+            job->cancel();
+        }
+        running.swap(threads);
+        pending.swap(pendingJobs);
+    }
+    // cancelled jobs which did not start are only marked as cancelled
+    for (auto& [job, manager] : pending) {
+        job->run(*manager);
+    }
+    for (auto& [id, thread] : running) {
+        thread.join();
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,220 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "model_version_policy.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+class ModelManager;
+
+/**
+ * @brief Parses NumPy .npy file into tensor with tensor_content, only C ordered arrays of numeric dtypes are accepted
+ */
+Status parseNpy(const std::string& contents, tensorflow::TensorProto& tensor);
+
+/**
+ * @brief Serializes tensor with tensor_content into NumPy .npy file of version 1.0
+ */
+Status serializeNpy(const tensorflow::TensorProto& tensor, std::string& contents);
+
+enum class BatchJobState {
+    PENDING,
+    RUNNING,
+    SUCCEEDED,
+    FAILED,
+    CANCELLED
+};
+
+const char* toString(BatchJobState state);
+
+/**
+ * @brief Parameters of batch inference job as submitted over REST API
+ */
+struct BatchJobSpec {
+    /**
+     * @brief Name of model or pipeline
+     */
+    std::string servableName;
+
+    /**
+     * @brief Model version, 0 for the default version, must be 0 for pipelines
+     */
+    model_version_t version = 0;
+
+    /**
+     * @brief Directory of samples in any storage supported for models
+     */
+    std::string inputPath;
+
+    /**
+     * @brief Local directory of results, relative to the configured output root
+     */
+    std::string outputPath;
+
+    /**
+     * @brief Number of samples inferred at once, 0 for the number of model streams
+     *
+     * Limited to streams of models and to MAX_CONCURRENCY for pipelines.
+     */
+    uint32_t concurrency = 0;
+};
+
+/**
+ * @brief Parses JSON body of job submission, with model_name, optional model_version, input, output and optional concurrency
+ */
+Status parseBatchJobSpec(const std::string& body, BatchJobSpec& spec);
+
+/**
+ * @brief Offline inference of a directory of samples, each sample is inferred by a single request
+ *
+ * A sample is either <sample>.npy file holding the only input of the servable or <sample>/ directory holding
+ * <input name>.npy file of each input. Outputs are written to <output>/<sample>/<output name>.npy as soon as the sample is inferred.
+ */
+class BatchJob {
+public:
+    static const size_t MAX_SAMPLE_ERRORS = 10;
+    static const uint32_t MAX_CONCURRENCY = 32;
+
+    /**
+     * @param pipeline true if the servable is a pipeline, a model otherwise
+     */
+    BatchJob(uint64_t id, const BatchJobSpec& spec, const std::string& outputDirectory, bool pipeline) :
+        id(id),
+        spec(spec),
+        outputDirectory(outputDirectory),
+        pipeline(pipeline) {}
+
+    uint64_t getId() const { return id; }
+
+    BatchJobState getState() const { return state; }
+
+    bool isFinished() const {
+        auto current = state.load();
+        return current != BatchJobState::PENDING && current != BatchJobState::RUNNING;
+    }
+
+    /**
+     * @brief Lists samples and infers them with concurrent workers, returns when the job is finished
+     */
+    void run(ModelManager& manager);
+
+    /**
+     * @brief Stops the job after samples being inferred are finished
+     */
+    void cancel() { cancelled = true; }
+
+    std::string toJson() const;
+
+private:
+    Status listSamples(std::vector<std::string>& samples, bool& singleFile) const;
+    Status getSingleInputName(ModelManager& manager, std::string& inputName) const;
+    Status inferSample(ModelManager& manager, const std::string& sample, bool singleFile, const std::string& singleInputName) const;
+    void recordError(const std::string& sample, const Status& status);
+
+    const uint64_t id;
+    const BatchJobSpec spec;
+    const std::string outputDirectory;
+    const bool pipeline;
+
+    std::atomic<BatchJobState> state = BatchJobState::PENDING;
+    std::atomic<bool> cancelled = false;
+    std::atomic<uint64_t> samplesCount = 0;
+    std::atomic<uint64_t> processedCount = 0;
+    std::atomic<uint64_t> failedCount = 0;
+
+    mutable std::mutex errorsMtx;
+    std::string jobError;
+    std::vector<std::pair<std::string, std::string>> sampleErrors;
+};
+
+/**
+ * @brief Batch inference jobs submitted over REST API, run in background threads
+ *
+ * Jobs are disabled until the output root is configured. At most MAX_RUNNING_JOBS run at once, later jobs wait
+ * in submission order. Finished jobs are kept for status requests, the oldest are dropped when MAX_FINISHED_JOBS is exceeded.
+ */
+class BatchJobs {
+public:
+    static BatchJobs& getInstance() {
+        static BatchJobs instance;
+        return instance;
+    }
+
+    static const size_t MAX_FINISHED_JOBS = 100;
+    static const size_t MAX_RUNNING_JOBS = 2;
+
+    /**
+     * @brief Sets local directory under which outputs of jobs are written, empty path disables jobs
+     */
+    Status configure(const std::string& outputRoot);
+
+    bool isEnabled() const { return !outputRoot.empty(); }
+
+    /**
+     * @brief Validates the job, starts it and responds with its status
+     */
+    Status submit(const std::string& body, ModelManager& manager, std::string& response);
+
+    Status getStatus(uint64_t id, std::string& response) const;
+
+    std::string list() const;
+
+    Status cancel(uint64_t id, std::string& response);
+
+    /**
+     * @brief Cancels all jobs and waits for them, called on server shutdown
+     */
+    void join();
+
+private:
+    BatchJobs() = default;
+
+    void dropFinishedJobs();
+
+    /**
+     * @brief Starts pending jobs while fewer than MAX_RUNNING_JOBS run, called with mtx locked
+     */
+    void startPendingJobs();
+
+    std::string outputRoot;
+    mutable std::mutex mtx;
+    uint64_t nextId = 1;
+    std::map<uint64_t, std::shared_ptr<BatchJob>> jobs;
+    std::map<uint64_t, std::thread> threads;
+    std::deque<std::pair<std::shared_ptr<BatchJob>, ModelManager*>> pendingJobs;
+    size_t runningJobs = 0;
+    // threads which finished their jobs and do not need mtx anymore, these can be joined with mtx locked
+    std::set<uint64_t> finishedThreads;
+    bool joining = false;
+};
+
+}  // namespace ovms
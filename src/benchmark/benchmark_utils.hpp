@@ -0,0 +1,123 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inference_engine.hpp>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "../tensorinfo.hpp"
+
+namespace ovms {
+namespace benchmarks {
+
+const std::string DUMMY_MODEL_PATH = "src/test/dummy/0/dummy.xml";
+constexpr const char* DUMMY_MODEL_INPUT_NAME = "b";
+constexpr const char* DUMMY_MODEL_OUTPUT_NAME = "a";
+
+const std::vector<InferenceEngine::Precision> PRECISIONS{
+    InferenceEngine::Precision::FP32,
+    InferenceEngine::Precision::I32,
+    InferenceEngine::Precision::U8};
+
+/**
+ * @brief Numbers of tensor elements, from tiny tensors to a 224x224x3 image
+ */
+const std::vector<int64_t> TENSOR_SIZES{10, 1000, 224 * 224 * 3};
+
+/**
+ * @brief Registers benchmark for every combination of precision index and tensor size
+ */
+inline void precisionsAndSizes(::benchmark::internal::Benchmark* benchmark) {
+    for (size_t precision = 0; precision < PRECISIONS.size(); ++precision) {
+        for (auto size : TENSOR_SIZES) {
+            benchmark->Args({static_cast<int64_t>(precision), size});
+        }
+    }
+}
+
+inline void sizes(::benchmark::internal::Benchmark* benchmark) {
+    for (auto size : TENSOR_SIZES) {
+        benchmark->Arg(size);
+    }
+}
+
+/**
+ * @brief Dummy model reshaped to 1 x size, compiled for CPU
+ */
+class DummyNetwork {
+public:
+    explicit DummyNetwork(size_t size) {
+        auto network = core.ReadNetwork(DUMMY_MODEL_PATH);
+        network.reshape({{DUMMY_MODEL_INPUT_NAME, {1, size}}});
+        executableNetwork = core.LoadNetwork(network, "CPU");
+        inputs[DUMMY_MODEL_INPUT_NAME] = std::make_shared<TensorInfo>(DUMMY_MODEL_INPUT_NAME,
+            InferenceEngine::Precision::FP32, shape_t{1, size}, InferenceEngine::Layout::NC);
+        outputs[DUMMY_MODEL_OUTPUT_NAME] = std::make_shared<TensorInfo>(DUMMY_MODEL_OUTPUT_NAME,
+            InferenceEngine::Precision::FP32, shape_t{1, size}, InferenceEngine::Layout::NC);
+    }
+
+    InferenceEngine::ExecutableNetwork& getExecutableNetwork() { return executableNetwork; }
+    const tensor_map_t& getInputs() const { return inputs; }
+    const tensor_map_t& getOutputs() const { return outputs; }
+
+private:
+    InferenceEngine::Core core;
+    InferenceEngine::ExecutableNetwork executableNetwork;
+    tensor_map_t inputs;
+    tensor_map_t outputs;
+};
+
+/**
+ * @brief Fills tensor proto of 1 x size shape with tensor_content of given precision
+ */
+inline void prepareTensorProto(tensorflow::TensorProto& proto, InferenceEngine::Precision precision, size_t size) {
+    proto.set_dtype(TensorInfo::getPrecisionAsDataType(precision));
+    proto.mutable_tensor_shape()->add_dim()->set_size(1);
+    proto.mutable_tensor_shape()->add_dim()->set_size(size);
+    proto.mutable_tensor_content()->assign(size * precision.size(), '\1');
+}
+
+inline InferenceEngine::Blob::Ptr createBlob(InferenceEngine::Precision precision, size_t size) {
+    const InferenceEngine::TensorDesc desc(precision, {1, size}, InferenceEngine::Layout::NC);
+    InferenceEngine::Blob::Ptr blob;
+    switch (precision) {
+    case InferenceEngine::Precision::I32:
+        blob = InferenceEngine::make_shared_blob<int32_t>(desc);
+        break;
+    case InferenceEngine::Precision::U8:
+        blob = InferenceEngine::make_shared_blob<uint8_t>(desc);
+        break;
+    default:
+        blob = InferenceEngine::make_shared_blob<float>(desc);
+    }
+    blob->allocate();
+    return blob;
+}
+
+inline tensorflow::serving::PredictRequest preparePredictRequest(InferenceEngine::Precision precision, size_t size) {
+    tensorflow::serving::PredictRequest request;
+    prepareTensorProto((*request.mutable_inputs())[DUMMY_MODEL_INPUT_NAME], precision, size);
+    return request;
+}
+
+}  // namespace benchmarks
+}  // namespace ovms
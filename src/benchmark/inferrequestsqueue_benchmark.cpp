@@ -0,0 +1,50 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "../ovinferrequestsqueue.hpp"
+#include "benchmark_utils.hpp"
+
+using namespace ovms;
+using namespace ovms::benchmarks;
+
+namespace {
+// shared by benchmark threads, created by the first thread
+std::unique_ptr<DummyNetwork> network;
+std::unique_ptr<OVInferRequestsQueue> queue;
+}  // namespace
+
+/**
+ * Acquires and releases infer requests of a pool with as many requests as there are threads,
+ * so threads contend on the queue without waiting for each other.
+ */
+static void BM_InferRequestsQueueAcquireRelease(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        network = std::make_unique<DummyNetwork>(10);
+        queue = std::make_unique<OVInferRequestsQueue>(network->getExecutableNetwork(), state.threads);
+    }
+    for (auto _ : state) {
+        int streamId = queue->getIdleStream();
+        queue->returnStream(streamId);
+    }
+    if (state.thread_index == 0) {
+        queue.reset();
+        network.reset();
+    }
+}
+BENCHMARK(BM_InferRequestsQueueAcquireRelease)->ThreadRange(1, 16)->UseRealTime();
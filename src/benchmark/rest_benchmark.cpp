@@ -0,0 +1,97 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "../rest_parser.hpp"
+#include "../rest_utils.hpp"
+#include "benchmark_utils.hpp"
+
+using namespace ovms;
+using namespace ovms::benchmarks;
+
+namespace {
+std::string prepareJsonValues(size_t size) {
+    std::string values = "[";
+    for (size_t i = 0; i < size; ++i) {
+        values += i == 0 ? "1.5" : ", 1.5";
+    }
+    return values + "]";
+}
+
+tensor_map_t prepareInputs(size_t size) {
+    tensor_map_t inputs;
+    inputs[DUMMY_MODEL_INPUT_NAME] = std::make_shared<TensorInfo>(DUMMY_MODEL_INPUT_NAME,
+        InferenceEngine::Precision::FP32, shape_t{1, size}, InferenceEngine::Layout::NC);
+    return inputs;
+}
+
+void parse(benchmark::State& state, const std::string& json) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto inputs = prepareInputs(size);
+    for (auto _ : state) {
+        RestParser parser(inputs);
+        auto status = parser.parse(json.c_str());
+        if (!status.ok()) {
+            state.SkipWithError(status.string().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(parser.getProto());
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+void makeJson(benchmark::State& state, Order order) {
+    const auto precision = PRECISIONS[state.range(0)];
+    const auto size = static_cast<size_t>(state.range(1));
+    tensorflow::serving::PredictResponse response;
+    prepareTensorProto((*response.mutable_outputs())[DUMMY_MODEL_OUTPUT_NAME], precision, size);
+    std::string json;
+    for (auto _ : state) {
+        auto status = makeJsonFromPredictResponse(response, &json, order);
+        if (!status.ok()) {
+            state.SkipWithError(status.string().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * json.size());
+    state.SetLabel(precision.name());
+}
+}  // namespace
+
+static void BM_RestParserRowOrder(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    parse(state, R"({"instances": [)" + prepareJsonValues(size) + "]}");
+}
+BENCHMARK(BM_RestParserRowOrder)->Apply(sizes);
+
+static void BM_RestParserColumnOrder(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    parse(state, R"({"inputs": {")" + std::string(DUMMY_MODEL_INPUT_NAME) + R"(": [)" + prepareJsonValues(size) + "]}}");
+}
+BENCHMARK(BM_RestParserColumnOrder)->Apply(sizes);
+
+static void BM_MakeJsonFromPredictResponseRowOrder(benchmark::State& state) {
+    makeJson(state, Order::ROW);
+}
+BENCHMARK(BM_MakeJsonFromPredictResponseRowOrder)->Apply(precisionsAndSizes);
+
+static void BM_MakeJsonFromPredictResponseColumnOrder(benchmark::State& state) {
+    makeJson(state, Order::COLUMN);
+}
+BENCHMARK(BM_MakeJsonFromPredictResponseColumnOrder)->Apply(precisionsAndSizes);
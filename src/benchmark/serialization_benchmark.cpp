@@ -0,0 +1,104 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <inference_engine.hpp>
+
+#include "../deserialization.hpp"
+#include "../ov_utils.hpp"
+#include "../ovinferrequestsqueue.hpp"
+#include "../serialization.hpp"
+#include "benchmark_utils.hpp"
+
+using namespace ovms;
+using namespace ovms::benchmarks;
+
+static void BM_DeserializeTensorProtoToPreallocatedBlob(benchmark::State& state) {
+    const auto precision = PRECISIONS[state.range(0)];
+    const auto size = static_cast<size_t>(state.range(1));
+    tensorflow::TensorProto proto;
+    prepareTensorProto(proto, precision, size);
+    auto tensorInfo = std::make_shared<TensorInfo>(DUMMY_MODEL_INPUT_NAME, precision, shape_t{1, size}, InferenceEngine::Layout::NC);
+    auto blob = createBlob(precision, size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PreallocatedBlobTensorProtoDeserializator::deserializeTensorProto(proto, tensorInfo, blob));
+    }
+    state.SetBytesProcessed(state.iterations() * proto.tensor_content().size());
+    state.SetLabel(precision.name());
+}
+BENCHMARK(BM_DeserializeTensorProtoToPreallocatedBlob)->Apply(precisionsAndSizes);
+
+static void BM_DeserializeTensorProtoToWrappingBlob(benchmark::State& state) {
+    const auto precision = PRECISIONS[state.range(0)];
+    const auto size = static_cast<size_t>(state.range(1));
+    tensorflow::TensorProto proto;
+    prepareTensorProto(proto, precision, size);
+    auto tensorInfo = std::make_shared<TensorInfo>(DUMMY_MODEL_INPUT_NAME, precision, shape_t{1, size}, InferenceEngine::Layout::NC);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ConcreteTensorProtoDeserializator::deserializeTensorProto(proto, tensorInfo));
+    }
+    state.SetBytesProcessed(state.iterations() * proto.tensor_content().size());
+    state.SetLabel(precision.name());
+}
+BENCHMARK(BM_DeserializeTensorProtoToWrappingBlob)->Apply(precisionsAndSizes);
+
+static void BM_DeserializePredictRequest(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    DummyNetwork network(size);
+    OVInferRequestsQueue queue(network.getExecutableNetwork(), 1);
+    auto& inferRequest = queue.getInferRequest(0);
+    const auto request = preparePredictRequest(InferenceEngine::Precision::FP32, size);
+    for (auto _ : state) {
+        auto status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(request, network.getInputs(), inferRequest,
+            queue.getPreallocatedInputBlobs(0));
+        if (!status.ok()) {
+            state.SkipWithError(status.string().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * size * sizeof(float));
+}
+BENCHMARK(BM_DeserializePredictRequest)->Apply(sizes);
+
+static void BM_SerializePredictResponse(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    DummyNetwork network(size);
+    auto inferRequest = network.getExecutableNetwork().CreateInferRequest();
+    inferRequest.Infer();
+    tensorflow::serving::PredictResponse response;
+    for (auto _ : state) {
+        auto status = serializePredictResponse(inferRequest, network.getOutputs(), &response);
+        if (!status.ok()) {
+            state.SkipWithError(status.string().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * size * sizeof(float));
+}
+BENCHMARK(BM_SerializePredictResponse)->Apply(sizes);
+
+static void BM_BlobClone(benchmark::State& state) {
+    const auto precision = PRECISIONS[state.range(0)];
+    const auto size = static_cast<size_t>(state.range(1));
+    auto blob = createBlob(precision, size);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blobClone(blob));
+    }
+    state.SetBytesProcessed(state.iterations() * blob->byteSize());
+    state.SetLabel(precision.name());
+}
+BENCHMARK(BM_BlobClone)->Apply(precisionsAndSizes);
@@ -0,0 +1,150 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "blobconversion.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "ov_utils.hpp"
+#include "tensorconversion.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+namespace {
+
+template <typename Source, typename Target>
+void convertElements(const Source* source, Target* destination, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        destination[i] = static_cast<Target>(source[i]);
+    }
+}
+
+template <typename Target>
+void convertTo(const InferenceEngine::Blob& source, Target* destination) {
+    const size_t count = source.size();
+    const void* data = source.cbuffer().as<const void*>();
+    switch (source.getTensorDesc().getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        convertElements(static_cast<const float*>(data), destination, count);
+        break;
+    case InferenceEngine::Precision::FP16: {
+        auto values = static_cast<const uint16_t*>(data);
+        for (size_t i = 0; i < count; ++i) {
+            destination[i] = static_cast<Target>(halfToFloat(values[i]));
+        }
+        break;
+    }
+    case InferenceEngine::Precision::U8:
+        convertElements(static_cast<const uint8_t*>(data), destination, count);
+        break;
+    case InferenceEngine::Precision::I8:
+        convertElements(static_cast<const int8_t*>(data), destination, count);
+        break;
+    case InferenceEngine::Precision::U16:
+        convertElements(static_cast<const uint16_t*>(data), destination, count);
+        break;
+    case InferenceEngine::Precision::I16:
+        convertElements(static_cast<const int16_t*>(data), destination, count);
+        break;
+    case InferenceEngine::Precision::I32:
+        convertElements(static_cast<const int32_t*>(data), destination, count);
+        break;
+    default:
+        break;
+    }
+}
+
+}  // namespace
+
+bool isBlobConversionSupported(InferenceEngine::Precision source, InferenceEngine::Precision target) {
+    using InferenceEngine::Precision;
+    switch (target) {
+    case Precision::FP32:
+        // 32 and 64 bit integers lose precision above 2^24
+        return source == Precision::FP16 || source == Precision::U8 || source == Precision::I8 || source == Precision::U16 ||
+               source == Precision::I16;
+    case Precision::FP16:
+        return source == Precision::U8 || source == Precision::I8;
+    case Precision::I16:
+        return source == Precision::U8 || source == Precision::I8;
+    case Precision::I32:
+        return source == Precision::U8 || source == Precision::I8 || source == Precision::U16 || source == Precision::I16;
+    case Precision::I64:
+        return source == Precision::U8 || source == Precision::I8 || source == Precision::U16 || source == Precision::I16 ||
+               source == Precision::I32;
+    default:
+        return false;
+    }
+}
+
+Status convertBlobPrecision(const InferenceEngine::Blob::Ptr& source, InferenceEngine::Precision target, InferenceEngine::Blob::Ptr& converted) {
+    const auto& sourceDesc = source->getTensorDesc();
+    if (!isBlobConversionSupported(sourceDesc.getPrecision(), target)) {
+        std::stringstream ss;
+        ss << "Expected: " << TensorInfo::getPrecisionAsString(target)
+           << "; Actual: " << TensorInfo::getPrecisionAsString(sourceDesc.getPrecision());
+        return Status(StatusCode::INVALID_PRECISION, ss.str());
+    }
+    converted = blobAllocate(InferenceEngine::TensorDesc(target, sourceDesc.getDims(), sourceDesc.getLayout()));
+    void* destination = converted->buffer().as<void*>();
+    switch (target) {
+    case InferenceEngine::Precision::FP32:
+        convertTo(*source, static_cast<float*>(destination));
+        break;
+    case InferenceEngine::Precision::FP16: {
+        // 8 bit integers are exact in half precision
+        std::vector<float> values(source->size());
+        convertTo(*source, values.data());
+        floatToHalf(values.data(), static_cast<uint16_t*>(destination), values.size());
+        break;
+    }
+    case InferenceEngine::Precision::I16:
+        convertTo(*source, static_cast<int16_t*>(destination));
+        break;
+    case InferenceEngine::Precision::I32:
+        convertTo(*source, static_cast<int32_t*>(destination));
+        break;
+    case InferenceEngine::Precision::I64:
+        convertTo(*source, static_cast<int64_t*>(destination));
+        break;
+    default:
+        return StatusCode::INVALID_PRECISION;
+    }
+    return StatusCode::OK;
+}
+
+Status BlobConversionCache::convert(const InferenceEngine::Blob::Ptr& source, InferenceEngine::Precision target, InferenceEngine::Blob::Ptr& converted) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const auto& entry : entries) {
+        if (entry.source == source && entry.target == target) {
+            SPDLOG_DEBUG("Reusing blob converted to precision {}", TensorInfo::getPrecisionAsString(target));
+            converted = entry.converted;
+            return StatusCode::OK;
+        }
+    }
+    auto status = convertBlobPrecision(source, target, converted);
+    if (!status.ok()) {
+        return status;
+    }
+    entries.push_back({source, target, converted});
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
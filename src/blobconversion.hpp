@@ -0,0 +1,70 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Checks if values of source precision are represented exactly in target precision
+ *
+ * FP16 and integers up to 16 bits convert to FP32, 8 bit integers to FP16 and integers widen to larger integers.
+ * Conversions which may change values, like FP32 to FP16 or I32 to FP32, are not supported.
+ */
+bool isBlobConversionSupported(InferenceEngine::Precision source, InferenceEngine::Precision target);
+
+/**
+ * @brief Copies blob into blob of target precision allocated from TensorBufferPool
+ *
+ * @return INVALID_PRECISION if conversion is not supported
+ */
+Status convertBlobPrecision(const InferenceEngine::Blob::Ptr& source, InferenceEngine::Precision target, InferenceEngine::Blob::Ptr& converted);
+
+/**
+ * @brief Blobs converted to precisions of model inputs during a single pipeline execution
+ *
+ * Pipeline input consumed by several nodes is passed to all of them as the same blob,
+ * each pair of source blob and target precision is converted once and the result is shared by all consumers.
+ * Source blobs are kept alive, so their addresses identify them until the execution finishes.
+ */
+class BlobConversionCache {
+public:
+    Status convert(const InferenceEngine::Blob::Ptr& source, InferenceEngine::Precision target, InferenceEngine::Blob::Ptr& converted);
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return entries.size();
+    }
+
+private:
+    struct Entry {
+        InferenceEngine::Blob::Ptr source;
+        InferenceEngine::Precision target;
+        InferenceEngine::Blob::Ptr converted;
+    };
+
+    mutable std::mutex mtx;
+    // few inputs are converted per execution
+    std::vector<Entry> entries;
+};
+
+}  // namespace ovms
@@ -0,0 +1,187 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cloudfilecache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <spdlog/spdlog.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "hash.hpp"
+
+namespace ovms {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const std::string CACHED_FILE_EXTENSION = ".cached";
+
+/**
+ * @brief Clones file sharing its data blocks, supported by copy-on-write filesystems like XFS or Btrfs
+ */
+bool reflinkFile(const std::string& source, const std::string& destination) {
+    int sourceFd = open(source.c_str(), O_RDONLY);
+    if (sourceFd < 0) {
+        return false;
+    }
+    int destinationFd = open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    const bool cloned = destinationFd >= 0 && ioctl(destinationFd, FICLONE, sourceFd) == 0;
+    if (destinationFd >= 0) {
+        close(destinationFd);
+    }
+    close(sourceFd);
+    if (!cloned) {
+        unlink(destination.c_str());
+    }
+    return cloned;
+}
+
+/**
+ * @brief Creates independent copy of file, cloned without data I/O where filesystem supports it
+ */
+void cloneOrCopyFile(const std::string& source, const std::string& destination, std::error_code& ec) {
+    if (reflinkFile(source, destination)) {
+        ec.clear();
+        return;
+    }
+    fs::copy_file(source, destination, fs::copy_options::overwrite_existing, ec);
+}
+
+}  // namespace
+
+Status CloudFileCache::configure(const std::string& directory, uint64_t sizeLimit) {
+    this->directory.clear();
+    this->sizeLimit = sizeLimit;
+    if (directory.empty()) {
+        return StatusCode::OK;
+    }
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec || !fs::is_directory(directory)) {
+        spdlog::error("Cannot use cloud model files cache directory: {}", directory);
+        return StatusCode::PATH_INVALID;
+    }
+    this->directory = directory;
+    spdlog::info("Model files downloaded from cloud storage are cached in: {}", directory);
+    return StatusCode::OK;
+}
+
+std::string CloudFileCache::getCachedPath(const std::string& remotePath, const std::string& objectVersion) const {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    fnv1a(hash, remotePath.data(), remotePath.size());
+    // separator keeps different splits of the same string from colliding
+    fnv1a(hash, "\n", 1);
+    fnv1a(hash, objectVersion.data(), objectVersion.size());
+    std::stringstream path;
+    path << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << hash << CACHED_FILE_EXTENSION;
+    return path.str();
+}
+
+bool CloudFileCache::fetch(const std::string& remotePath, const std::string& objectVersion, const std::string& localPath) {
+    if (!isEnabled() || objectVersion.empty()) {
+        return false;
+    }
+    const auto cachedPath = getCachedPath(remotePath, objectVersion);
+    std::error_code ec;
+    if (!fs::exists(cachedPath, ec)) {
+        return false;
+    }
+    fs::remove(localPath, ec);
+    fs::create_hard_link(cachedPath, localPath, ec);
+    if (ec) {
+        // cache directory may be on a different filesystem or one not supporting hard links
+        ec.clear();
+        cloneOrCopyFile(cachedPath, localPath, ec);
+        if (ec) {
+            spdlog::warn("Cannot use cached file of: {} {}", remotePath, ec.message());
+            return false;
+        }
+    }
+    // modification time of cached file marks its last use
+    fs::last_write_time(cachedPath, fs::file_time_type::clock::now(), ec);
+    spdlog::debug("Using cached file of: {}", remotePath);
+    return true;
+}
+
+void CloudFileCache::store(const std::string& remotePath, const std::string& objectVersion, const std::string& localPath) {
+    if (!isEnabled() || objectVersion.empty()) {
+        return;
+    }
+    static std::atomic<uint64_t> storedFiles{0};
+    const auto cachedPath = getCachedPath(remotePath, objectVersion);
+    // file is copied under temporary name, so concurrent fetches never see partial content
+    // cached file gets its own inode, modification time of a cached file marks its own last use
+    const auto temporaryPath = cachedPath + ".tmp" + std::to_string(storedFiles++);
+    std::error_code ec;
+    cloneOrCopyFile(localPath, temporaryPath, ec);
+    if (!ec) {
+        fs::rename(temporaryPath, cachedPath, ec);
+    }
+    if (ec) {
+        spdlog::warn("Cannot cache file of: {} {}", remotePath, ec.message());
+        fs::remove(temporaryPath, ec);
+        return;
+    }
+    evict();
+}
+
+void CloudFileCache::evict() {
+    if (sizeLimit == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<std::pair<fs::file_time_type, fs::path>> files;
+    uint64_t totalSize = 0;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(directory, ec)) {
+        if (entry.path().extension() != CACHED_FILE_EXTENSION) {
+            continue;
+        }
+        const auto size = entry.file_size(ec);
+        const auto lastUse = entry.last_write_time(ec);
+        if (ec) {
+            continue;
+        }
+        totalSize += size;
+        files.emplace_back(lastUse, entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto& [lastUse, path] : files) {
+        if (totalSize <= sizeLimit) {
+            break;
+        }
+        const auto size = fs::file_size(path, ec);
+        if (ec) {
+            continue;
+        }
+        if (fs::remove(path, ec)) {
+            spdlog::debug("Removed least recently used file from cloud model files cache: {}", path.string());
+            totalSize -= size;
+        }
+    }
+}
+
+}  // namespace ovms
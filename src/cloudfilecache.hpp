@@ -0,0 +1,72 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Persistent on-disk cache of model files downloaded from cloud storage
+ *
+ * Files are keyed by object path and its version reported by storage, e.g. S3 ETag or GCS generation,
+ * so unchanged files are reused across model versions and server restarts. When cache exceeds its size limit,
+ * least recently used files are removed. Cache is disabled until directory is configured.
+ */
+class CloudFileCache {
+public:
+    static CloudFileCache& getInstance() {
+        static CloudFileCache instance;
+        return instance;
+    }
+
+    /**
+     * @brief Sets cache directory and creates it if needed, empty directory disables the cache
+     *
+     * @param sizeLimit in bytes, 0 means no limit
+     */
+    Status configure(const std::string& directory, uint64_t sizeLimit);
+
+    bool isEnabled() const { return !directory.empty(); }
+
+    /**
+     * @brief Places cached file at local path, cached file is linked if possible and copied otherwise
+     *
+     * @return true if file of this object version was cached
+     */
+    bool fetch(const std::string& remotePath, const std::string& objectVersion, const std::string& localPath);
+
+    /**
+     * @brief Adds downloaded file to the cache and evicts least recently used files above size limit
+     */
+    void store(const std::string& remotePath, const std::string& objectVersion, const std::string& localPath);
+
+private:
+    CloudFileCache() = default;
+
+    std::string getCachedPath(const std::string& remotePath, const std::string& objectVersion) const;
+    void evict();
+
+    std::string directory;
+    uint64_t sizeLimit = 0;
+    std::mutex mtx;
+};
+
+}  // namespace ovms
@@ -0,0 +1,101 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ovms {
+
+/**
+ * @brief Tensor dimensions stored in place up to INLINE_DIMS, so that shapes kept in flat per-model arrays do not point to the heap
+ *
+ * Dimensions are int64_t as in TensorShapeProto, shapes with more dimensions fall back to a heap buffer.
+ */
+class CompactShape {
+public:
+    static constexpr size_t INLINE_DIMS = 8;
+
+    CompactShape() = default;
+
+    template <typename Dims>
+    explicit CompactShape(const Dims& dims) {
+        for (auto dim : dims) {
+            push_back(static_cast<int64_t>(dim));
+        }
+    }
+
+    void push_back(int64_t dim) {
+        if (count < INLINE_DIMS) {
+            inlineDims[count++] = dim;
+            return;
+        }
+        if (count == INLINE_DIMS) {
+            heapDims.assign(inlineDims.begin(), inlineDims.end());
+        }
+        heapDims.push_back(dim);
+        ++count;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    const int64_t* data() const {
+        return count <= INLINE_DIMS ? inlineDims.data() : heapDims.data();
+    }
+
+    int64_t operator[](size_t index) const {
+        return data()[index];
+    }
+
+    const int64_t* begin() const {
+        return data();
+    }
+
+    const int64_t* end() const {
+        return data() + count;
+    }
+
+    bool operator==(const CompactShape& other) const {
+        if (count != other.count) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if ((*this)[i] != other[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const CompactShape& other) const {
+        return !(*this == other);
+    }
+
+private:
+    std::array<int64_t, INLINE_DIMS> inlineDims{};
+    std::vector<int64_t> heapDims;
+    size_t count = 0;
+};
+
+}  // namespace ovms
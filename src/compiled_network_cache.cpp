@@ -0,0 +1,96 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "compiled_network_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+
+#include "hash.hpp"
+#include "serversnapshot.hpp"
+
+namespace ovms {
+
+namespace {
+
+bool hashFile(uint64_t& hash, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+    std::vector<char> buffer(1 << 20);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        fnv1a(hash, buffer.data(), file.gcount());
+    }
+    return file.eof();
+}
+
+}  // namespace
+
+Status CompiledNetworkCache::configure(const std::string& directory) {
+    this->directory.clear();
+    if (directory.empty()) {
+        return StatusCode::OK;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec || !std::filesystem::is_directory(directory)) {
+        spdlog::error("Cannot use compiled model cache directory: {}", directory);
+        return StatusCode::PATH_INVALID;
+    }
+    this->directory = directory;
+    spdlog::info("Compiled models are cached in: {}", directory);
+    return StatusCode::OK;
+}
+
+bool CompiledNetworkCache::hashModelFiles(const std::vector<std::string>& modelFiles, uint64_t& hash) {
+    auto& snapshot = ServerSnapshot::getInstance();
+    for (const auto& modelFile : modelFiles) {
+        const uint64_t seed = hash;
+        if (auto restored = snapshot.findFileHash(modelFile, seed)) {
+            hash = *restored;
+            continue;
+        }
+        if (!hashFile(hash, modelFile)) {
+            spdlog::warn("Cannot read model file: {} to compute its hash", modelFile);
+            return false;
+        }
+        snapshot.recordFileHash(modelFile, seed, hash);
+    }
+    return true;
+}
+
+std::string CompiledNetworkCache::getBlobPath(const std::vector<std::string>& modelFiles, const std::string& compilationDescription) const {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    if (!hashModelFiles(modelFiles, hash)) {
+        return std::string();
+    }
+    return getBlobPath(hash, compilationDescription);
+}
+
+std::string CompiledNetworkCache::getBlobPath(uint64_t modelFilesHash, const std::string& compilationDescription) const {
+    uint64_t hash = modelFilesHash;
+    fnv1a(hash, compilationDescription.data(), compilationDescription.size());
+    std::stringstream path;
+    path << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << hash << ".blob";
+    return path.str();
+}
+
+}  // namespace ovms
@@ -0,0 +1,71 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief On-disk cache of exported executable networks, so these are imported instead of compiled on later loads
+ *
+ * Blobs are keyed by content of model files and description of the compilation, e.g. device, plugin config
+ * and network inputs. Cache is disabled until directory is configured.
+ */
+class CompiledNetworkCache {
+public:
+    static CompiledNetworkCache& getInstance() {
+        static CompiledNetworkCache instance;
+        return instance;
+    }
+
+    /**
+     * @brief Sets cache directory and creates it if needed, empty directory disables the cache
+     */
+    Status configure(const std::string& directory);
+
+    bool isEnabled() const { return !directory.empty(); }
+
+    /**
+     * @brief Builds path of the blob compiled from model files as described
+     *
+     * @return blob path or empty string if model files cannot be read
+     */
+    std::string getBlobPath(const std::vector<std::string>& modelFiles, const std::string& compilationDescription) const;
+
+    /**
+     * @brief Builds path of the blob compiled as described from model files of given content hash
+     */
+    std::string getBlobPath(uint64_t modelFilesHash, const std::string& compilationDescription) const;
+
+    /**
+     * @brief Hashes content of model files, hash should start from FNV_OFFSET_BASIS
+     *
+     * @return false if any of the files cannot be read
+     */
+    static bool hashModelFiles(const std::vector<std::string>& modelFiles, uint64_t& hash);
+
+private:
+    CompiledNetworkCache() = default;
+
+    std::string directory;
+};
+
+}  // namespace ovms
@@ -0,0 +1,149 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "compression.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace ovms {
+
+std::atomic<size_t> ResponseCompression::threshold{0};
+
+namespace {
+// gzip wrapper instead of raw zlib stream
+const int GZIP_WINDOW_BITS = 15 + 16;
+// favours speed, responses are compressed on request threads
+const int GZIP_LEVEL = Z_BEST_SPEED;
+const size_t CHUNK_SIZE = 64 * 1024;
+
+std::string_view trimmed(std::string_view value) {
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front()))) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+bool isZeroQuality(std::string_view parameters) {
+    // parameters like ";q=0" or ";q=0.000"
+    while (!parameters.empty()) {
+        parameters.remove_prefix(1);
+        auto end = parameters.find(';');
+        auto parameter = trimmed(parameters.substr(0, end));
+        if (parameter.size() > 2 && (parameter[0] == 'q' || parameter[0] == 'Q') && parameter[1] == '=') {
+            auto value = parameter.substr(2);
+            return std::all_of(value.begin(), value.end(), [](char c) { return c == '0' || c == '.'; });
+        }
+        parameters = end == std::string_view::npos ? std::string_view() : parameters.substr(end);
+    }
+    return false;
+}
+}  // namespace
+
+bool acceptsEncoding(std::string_view acceptEncoding, std::string_view encoding) {
+    while (!acceptEncoding.empty()) {
+        auto end = acceptEncoding.find(',');
+        auto item = acceptEncoding.substr(0, end);
+        auto parametersStart = item.find(';');
+        auto name = trimmed(item.substr(0, parametersStart));
+        if (equalsIgnoreCase(name, encoding) || name == "*") {
+            return parametersStart == std::string_view::npos || !isZeroQuality(item.substr(parametersStart));
+        }
+        acceptEncoding = end == std::string_view::npos ? std::string_view() : acceptEncoding.substr(end + 1);
+    }
+    return false;
+}
+
+bool ResponseCompression::shouldCompress(size_t responseSize, std::string_view acceptEncoding) {
+    const size_t minimumSize = threshold;
+    return minimumSize > 0 && responseSize >= minimumSize && acceptsEncoding(acceptEncoding, "gzip");
+}
+
+void setGrpcResponseCompression(grpc::ServerContext& context, size_t responseSize) {
+    if (ResponseCompression::getThreshold() == 0 || responseSize < ResponseCompression::getThreshold()) {
+        return;
+    }
+    // header may be consumed by gRPC core, every gRPC client library accepts gzip by default
+    std::string_view acceptEncoding = "gzip";
+    auto header = context.client_metadata().find("grpc-accept-encoding");
+    if (header != context.client_metadata().end()) {
+        acceptEncoding = std::string_view(header->second.data(), header->second.size());
+    }
+    if (ResponseCompression::shouldCompress(responseSize, acceptEncoding)) {
+        context.set_compression_algorithm(GRPC_COMPRESS_GZIP);
+    }
+}
+
+Status gzipCompress(std::string_view input, std::string& output) {
+    z_stream stream{};
+    if (deflateInit2(&stream, GZIP_LEVEL, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return StatusCode::COMPRESSION_ERROR;
+    }
+    output.resize(deflateBound(&stream, input.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = input.size();
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = output.size();
+    const int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        output.clear();
+        return StatusCode::COMPRESSION_ERROR;
+    }
+    output.resize(stream.total_out);
+    return StatusCode::OK;
+}
+
+Status gzipDecompress(std::string_view input, std::string& output, size_t maxSize) {
+    z_stream stream{};
+    if (inflateInit2(&stream, GZIP_WINDOW_BITS) != Z_OK) {
+        return StatusCode::COMPRESSION_ERROR;
+    }
+    output.clear();
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = input.size();
+    int result = Z_OK;
+    while (result == Z_OK) {
+        if (output.size() >= maxSize) {
+            break;
+        }
+        const size_t written = output.size();
+        output.resize(std::min(maxSize, written + std::max(CHUNK_SIZE, input.size() * 2)));
+        stream.next_out = reinterpret_cast<Bytef*>(output.data() + written);
+        stream.avail_out = output.size() - written;
+        result = inflate(&stream, Z_NO_FLUSH);
+        output.resize(stream.total_out);
+    }
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        output.clear();
+        return StatusCode::COMPRESSION_ERROR;
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
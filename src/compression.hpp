@@ -0,0 +1,79 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <string_view>
+
+#include <grpcpp/server_context.h>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Decides which responses are compressed, configured once at startup
+ *
+ * Responses are compressed only for clients accepting gzip and only above threshold, so small responses
+ * do not pay CPU cost of compression. Threshold 0 disables compression.
+ */
+class ResponseCompression {
+public:
+    static void setThreshold(size_t bytes) {
+        threshold = bytes;
+    }
+
+    static size_t getThreshold() {
+        return threshold;
+    }
+
+    /**
+     * @brief Checks if response should be compressed for client accepting the encodings
+     *
+     * @param acceptEncoding value of Accept-Encoding or grpc-accept-encoding header, e.g. "gzip, deflate;q=0.5"
+     */
+    static bool shouldCompress(size_t responseSize, std::string_view acceptEncoding);
+
+private:
+    static std::atomic<size_t> threshold;
+};
+
+/**
+ * @brief Enables gzip compression of gRPC response if ResponseCompression accepts it, must be called before response is sent
+ */
+void setGrpcResponseCompression(grpc::ServerContext& context, size_t responseSize);
+
+/**
+ * @brief Checks if encoding is listed in Accept-Encoding header value and not excluded with q=0
+ */
+bool acceptsEncoding(std::string_view acceptEncoding, std::string_view encoding);
+
+Status gzipCompress(std::string_view input, std::string& output);
+
+/**
+ * @brief Decompresses gzip stream, fails with COMPRESSION_ERROR if result would exceed maxSize
+ */
+Status gzipDecompress(std::string_view input, std::string& output, size_t maxSize);
+
+/**
+ * @brief Checks for gzip magic bytes
+ */
+inline bool isGzip(std::string_view input) {
+    return input.size() >= 2 && static_cast<unsigned char>(input[0]) == 0x1f && static_cast<unsigned char>(input[1]) == 0x8b;
+}
+
+}  // namespace ovms
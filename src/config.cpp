@@ -42,31 +42,150 @@ Config& Config::parse(int argc, char** argv) {
                 "gRPC server port",
                 cxxopts::value<uint64_t>()->default_value("9178"),
                 "PORT")
+            ("grpc_uds_path",
+                "optional path of Unix domain socket the gRPC server listens on in addition to the port, for clients on the same host",
+                cxxopts::value<std::string>(), "GRPC_UDS_PATH")
+            ("allow_shared_memory",
+                "allow clients on the same host to register shared memory regions over REST API and reference inputs written there in gRPC Predict requests",
+                cxxopts::value<bool>()->default_value("false"),
+                "ALLOW_SHARED_MEMORY")
             ("rest_port",
                 "REST server port, the REST server will not be started if rest_port is blank or set to 0",
                 cxxopts::value<uint64_t>()->default_value("0"),
                 "REST_PORT")
             ("grpc_workers",
-                "number of gRPC servers. Default 1. Increase for multi client, high throughput scenarios",
+                "number of completion queues of the gRPC server. Default 1. Increase for multi client, high throughput scenarios",
                 cxxopts::value<uint>()->default_value("1"),
                 "GRPC_WORKERS")
+            ("grpc_polling_threads",
+                "number of threads polling each gRPC completion queue. Default 0 uses 1 thread with grpc_async and gRPC managed pool of threads otherwise",
+                cxxopts::value<uint>()->default_value("0"),
+                "GRPC_POLLING_THREADS")
+            ("grpc_numa_pinning",
+                "pin polling threads of consecutive gRPC completion queues to CPUs of consecutive NUMA nodes, requires grpc_async",
+                cxxopts::value<bool>()->default_value("false"),
+                "GRPC_NUMA_PINNING")
+            ("grpc_async",
+                "use asynchronous gRPC Predict handling, predict RPCs are completed from inference callbacks",
+                cxxopts::value<bool>()->default_value("false"),
+                "GRPC_ASYNC")
+            ("grpc_stream_max_in_flight",
+                "number of requests of a single PredictStream stream inferred concurrently",
+                cxxopts::value<uint>()->default_value("4"),
+                "GRPC_STREAM_MAX_IN_FLIGHT")
             ("rest_workers",
                 "number of workers in REST server - has no effect if rest_port is not set",
                 cxxopts::value<uint>()->default_value(DEFAULT_REST_WORKERS_STRING.c_str()),
                 "REST_WORKERS")
+            ("rest_inline_dispatch",
+                "REST requests processed on the HTTP event loop thread instead of REST workers - one of none, light (health, metrics, model status and metadata), all (also predictions)",
+                cxxopts::value<std::string>()->default_value("none"),
+                "REST_INLINE_DISPATCH")
+            ("rest_keep_alive_timeout_seconds",
+                "Time after which idle REST connections are closed. Default 0 keeps the HTTP server default",
+                cxxopts::value<uint>()->default_value("0"),
+                "SECONDS")
             ("log_level",
                 "serving log level - one of DEBUG, INFO, ERROR",
                 cxxopts::value<std::string>()->default_value("INFO"), "LOG_LEVEL")
             ("log_path",
                 "optional path to the log file",
                 cxxopts::value<std::string>(), "LOG_PATH")
+            ("log_queue_size",
+                "Number of log messages queued for background writing, oldest messages are dropped when the queue is full. Zero writes messages synchronously.",
+                cxxopts::value<uint>()->default_value("8192"),
+                "LOG_QUEUE_SIZE")
+            ("log_request_sampling",
+                "Per request debug messages are logged for one of every LOG_REQUEST_SAMPLING requests.",
+                cxxopts::value<uint>()->default_value("1"),
+                "LOG_REQUEST_SAMPLING")
+            ("compression_threshold_bytes",
+                "REST and gRPC responses larger than this are gzip compressed for clients accepting it. Default is 0 - compression disabled.",
+                cxxopts::value<uint>()->default_value("0"),
+                "COMPRESSION_THRESHOLD_BYTES")
             ("grpc_channel_arguments",
                 "A comma separated list of arguments to be passed to the grpc server. (e.g. grpc.max_connection_age_ms=2000)",
                 cxxopts::value<std::string>(), "GRPC_CHANNEL_ARGUMENTS")
             ("file_system_poll_wait_seconds",
                 "Time interval between config and model versions changes detection. Default is 1. Zero or negative value disables changes monitoring.",
                 cxxopts::value<uint>()->default_value("1"),
-                "SECONDS");
+                "SECONDS")
+            ("cloud_file_system_poll_wait_seconds",
+                "Time interval between model versions changes detection for models in cloud storage. Default is 60.",
+                cxxopts::value<uint>()->default_value("60"),
+                "SECONDS")
+            ("compiled_model_cache_dir",
+                "Optional directory where compiled models are saved, so these are imported instead of compiled when loaded again",
+                cxxopts::value<std::string>(), "COMPILED_MODEL_CACHE_DIR")
+            ("batch_jobs_output_path",
+                "Optional local directory under which batch inference jobs submitted over REST API write their results, jobs are disabled when it is not set",
+                cxxopts::value<std::string>(), "BATCH_JOBS_OUTPUT_PATH")
+            ("server_snapshot_path",
+                "Optional file where state of loaded models is saved on shutdown and restored on start, so restart skips listing cloud storage, hashing model files and auto-tuning",
+                cxxopts::value<std::string>(), "SERVER_SNAPSHOT_PATH")
+            ("share_identical_models",
+                "Share compiled networks between model versions and models with identical model files and configuration",
+                cxxopts::value<bool>()->default_value("false"),
+                "SHARE_IDENTICAL_MODELS")
+            ("stream_cloud_models",
+                "Read model files from cloud storage straight into memory instead of downloading them to local temporary directory",
+                cxxopts::value<bool>()->default_value("false"),
+                "STREAM_CLOUD_MODELS")
+            ("cloud_model_cache_dir",
+                "Optional directory where model files downloaded from cloud storage are cached, unchanged files are reused across versions and restarts",
+                cxxopts::value<std::string>(), "CLOUD_MODEL_CACHE_DIR")
+            ("cloud_model_cache_size_mb",
+                "Size limit of cloud_model_cache_dir, least recently used files are removed above it. Default is 10240. Zero means no limit.",
+                cxxopts::value<uint64_t>()->default_value("10240"),
+                "MEGABYTES")
+            ("azure_download_parallelism",
+                "Number of concurrent requests downloading model files from Azure Blob Storage. Default is 8.",
+                cxxopts::value<uint>()->default_value("8"),
+                "AZURE_DOWNLOAD_PARALLELISM")
+            ("azure_download_chunk_size_mb",
+                "Size of ranges in which model files larger than it are downloaded from Azure Blob Storage. Default is 8.",
+                cxxopts::value<uint>()->default_value("8"),
+                "MEGABYTES")
+            ("on_demand_models_memory_budget_mb",
+                "Memory budget of model versions loaded on demand, estimated with size of their model files. Least recently used versions are unloaded to fit it. Default is 0, no limit.",
+                cxxopts::value<uint64_t>()->default_value("0"),
+                "MEGABYTES")
+            ("tensor_buffer_pool_size_mb",
+                "Memory of idle tensor buffers kept for reuse by copied and converted blobs, instead of freeing them. Default is 256, 0 disables pooling.",
+                cxxopts::value<uint64_t>()->default_value("256"),
+                "MEGABYTES")
+            ("cpu_streams_budget",
+                "Number of CPU inference streams split between all models by their cpu_streams_weight, so models together do not oversubscribe CPUs. Default is 0, each model sizes its streams for all CPUs.",
+                cxxopts::value<uint>()->default_value("0"),
+                "CPU_STREAMS_BUDGET")
+            ("tenant_limits",
+                "A comma separated list of tenant=rate[:burst[:weight]] limits of tenants identified with ovms-tenant request header, tenant named default applies to others. (e.g. default=50,batch=10:20:1,web=0:1:4)",
+                cxxopts::value<std::string>(), "TENANT_LIMITS")
+            ("isolation_groups",
+                "A semicolon separated list of group=cpulist CPU sets reserved for models assigned to the group with isolation_group in config, other models run on remaining CPUs. (e.g. realtime=0-3;batch=4-7)",
+                cxxopts::value<std::string>(), "ISOLATION_GROUPS")
+            ("peers",
+                "A comma separated list of gRPC addresses of other server instances, requests for models not served by this instance are forwarded to the least loaded peer serving them (e.g. ovms-1:9000,ovms-2:9000)",
+                cxxopts::value<std::string>(), "PEERS")
+            ("peer_poll_interval_ms",
+                "Interval in milliseconds of polling peers for models they serve and their load. Default is 1000.",
+                cxxopts::value<uint>()->default_value("1000"),
+                "PEER_POLL_INTERVAL_MS")
+            ("drain_timeout_seconds",
+                "Time in seconds the server given SIGTERM reports not ready and waits for requests in progress before it exits. Default is 0, server exits without waiting.",
+                cxxopts::value<uint>()->default_value("0"),
+                "DRAIN_TIMEOUT_SECONDS")
+            ("enable_profiling",
+                "Expose GET /v1/profile on REST port, sampling call stacks of all server threads for the requested number of seconds",
+                cxxopts::value<bool>()->default_value("false"),
+                "ENABLE_PROFILING")
+            ("pipeline_trace_path",
+                "Optional path to the file where timelines of pipeline nodes are saved in Chrome trace format",
+                cxxopts::value<std::string>(), "PIPELINE_TRACE_PATH")
+            ("pipeline_trace_sampling_rate",
+                "Fraction of pipeline executions traced to pipeline_trace_path, in range [0, 1]. Default is 0.01.",
+                cxxopts::value<float>()->default_value("0.01"),
+                "RATE");
         options->add_options("multi model")
             ("config_path",
                 "absolute path to json configuration file",
@@ -149,6 +268,31 @@ void Config::validate() {
         exit(EX_USAGE);
     }
 
+    if (result->count("grpc_polling_threads") && (this->grpcPollingThreads() > AVAILABLE_CORES)) {
+        std::cerr << "grpc_polling_threads count should be from 0 to CPU core count : " << AVAILABLE_CORES << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (result->count("grpc_stream_max_in_flight") && (this->grpcStreamMaxInFlight() < 1)) {
+        std::cerr << "grpc_stream_max_in_flight should be at least 1" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (result->count("peer_poll_interval_ms") && (this->peerPollIntervalMs() < 1)) {
+        std::cerr << "peer_poll_interval_ms should be at least 1" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (this->grpcNumaPinning() && !this->grpcAsync()) {
+        std::cerr << "grpc_numa_pinning requires grpc_async, threads of synchronous gRPC server are managed by gRPC" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (this->restInlineDispatch() != "none" && this->restInlineDispatch() != "light" && this->restInlineDispatch() != "all") {
+        std::cerr << "rest_inline_dispatch should be one of none, light, all" << std::endl;
+        exit(EX_USAGE);
+    }
+
     // check rest_workers value
     if (result->count("rest_workers") && ((this->restWorkers() > MAX_REST_WORKERS) || (this->restWorkers() < 1))) {
         std::cerr << "rest_workers count should be from 1 to " << MAX_REST_WORKERS << std::endl;
@@ -170,6 +314,21 @@ void Config::validate() {
         exit(EX_USAGE);
     }
 
+    if (result->count("pipeline_trace_sampling_rate") && ((this->pipelineTraceSamplingRate() > 1) || (this->pipelineTraceSamplingRate() < 0))) {
+        std::cerr << "pipeline_trace_sampling_rate should be in range from 0 to 1" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (result->count("azure_download_parallelism") && (this->azureDownloadParallelism() < 1)) {
+        std::cerr << "azure_download_parallelism should be at least 1" << std::endl;
+        exit(EX_USAGE);
+    }
+
+    if (result->count("azure_download_chunk_size_mb") && (this->azureDownloadChunkSizeMb() < 1)) {
+        std::cerr << "azure_download_chunk_size_mb should be at least 1" << std::endl;
+        exit(EX_USAGE);
+    }
+
     // port and rest_port cannot be the same
     if (this->port() == this->restPort()) {
         std::cerr << "port and rest_port cannot have the same values" << std::endl;
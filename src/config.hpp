@@ -116,6 +116,42 @@ public:
         return result->operator[]("grpc_workers").as<uint>();
     }
 
+    /**
+         * @brief Gets the number of threads polling each gRPC completion queue, 0 for default
+         * 
+         * @return uint
+         */
+    uint grpcPollingThreads() {
+        return result->operator[]("grpc_polling_threads").as<uint>();
+    }
+
+    /**
+         * @brief Checks if gRPC polling threads should be pinned to NUMA nodes
+         * 
+         * @return bool
+         */
+    bool grpcNumaPinning() {
+        return result->operator[]("grpc_numa_pinning").as<bool>();
+    }
+
+    /**
+         * @brief Checks if asynchronous gRPC Predict handling is requested
+         * 
+         * @return bool
+         */
+    bool grpcAsync() {
+        return result->operator[]("grpc_async").as<bool>();
+    }
+
+    /**
+         * @brief Gets the number of requests of a single Predict stream inferred concurrently
+         * 
+         * @return uint
+         */
+    uint grpcStreamMaxInFlight() {
+        return result->operator[]("grpc_stream_max_in_flight").as<uint>();
+    }
+
     /**
          * @brief Gets the rest workers count
          * 
@@ -125,6 +161,24 @@ public:
         return result->operator[]("rest_workers").as<uint>();
     }
 
+    /**
+     * @brief Gets the REST requests processed on HTTP event loop thread
+     * 
+     * @return const std::string& none, light or all
+     */
+    const std::string& restInlineDispatch() {
+        return result->operator[]("rest_inline_dispatch").as<std::string>();
+    }
+
+    /**
+     * @brief Gets the idle timeout of REST connections, 0 keeps HTTP server default
+     * 
+     * @return uint
+     */
+    uint restKeepAliveTimeoutSeconds() {
+        return result->operator[]("rest_keep_alive_timeout_seconds").as<uint>();
+    }
+
     /**
          * @brief Get the model name
          * 
@@ -236,6 +290,33 @@ public:
         return empty;
     }
 
+    /**
+     * @brief Get the number of log messages queued for background writing, 0 for synchronous logging
+     *
+     * @return uint
+     */
+    uint logQueueSize() {
+        return result->operator[]("log_queue_size").as<uint>();
+    }
+
+    /**
+     * @brief Get the period of per request debug messages sampling
+     *
+     * @return uint
+     */
+    uint logRequestSampling() {
+        return result->operator[]("log_request_sampling").as<uint>();
+    }
+
+    /**
+     * @brief Gets the minimal size of responses which are compressed, 0 disables compression
+     *
+     * @return uint
+     */
+    uint compressionThresholdBytes() {
+        return result->operator[]("compression_threshold_bytes").as<uint>();
+    }
+
     /**
         * @brief Get the plugin config
         *
@@ -255,5 +336,230 @@ public:
     uint filesystemPollWaitSeconds() {
         return result->operator[]("file_system_poll_wait_seconds").as<uint>();
     }
+
+    /**
+     * @brief Get the cloud storage poll wait time in seconds
+     *
+     * @return uint
+     */
+    uint cloudFilesystemPollWaitSeconds() {
+        return result->operator[]("cloud_file_system_poll_wait_seconds").as<uint>();
+    }
+
+    /**
+     * @brief Get the path of Unix domain socket of gRPC server
+     *
+     * @return const std::string& empty if gRPC server listens only on the port
+     */
+    const std::string& grpcUdsPath() {
+        if (result->count("grpc_uds_path"))
+            return result->operator[]("grpc_uds_path").as<std::string>();
+        return empty;
+    }
+
+    /**
+     * @brief Checks if clients can register shared memory regions
+     *
+     * @return bool
+     */
+    bool allowSharedMemory() {
+        return result->operator[]("allow_shared_memory").as<bool>();
+    }
+
+    /**
+     * @brief Get the directory of compiled models cache
+     *
+     * @return const std::string&
+     */
+    const std::string& compiledModelCacheDir() {
+        if (result->count("compiled_model_cache_dir"))
+            return result->operator[]("compiled_model_cache_dir").as<std::string>();
+        return empty;
+    }
+
+    /**
+     * @brief Get the local directory of batch jobs results
+     *
+     * @return const std::string&
+     */
+    const std::string& batchJobsOutputPath() {
+        if (result->count("batch_jobs_output_path"))
+            return result->operator[]("batch_jobs_output_path").as<std::string>();
+        return empty;
+    }
+
+    /**
+     * @brief Get the path of server snapshot file
+     *
+     * @return const std::string&
+     */
+    const std::string& serverSnapshotPath() {
+        if (result->count("server_snapshot_path"))
+            return result->operator[]("server_snapshot_path").as<std::string>();
+        return empty;
+    }
+
+    /**
+     * @brief Checks if compiled networks are shared by models with identical model files
+     *
+     * @return bool
+     */
+    bool shareIdenticalModels() {
+        return result->operator[]("share_identical_models").as<bool>();
+    }
+
+    /**
+     * @brief Checks if sampling profiler endpoint is exposed on REST port
+     *
+     * @return bool
+     */
+    bool enableProfiling() {
+        return result->operator[]("enable_profiling").as<bool>();
+    }
+
+    /**
+     * @brief Checks if model files in cloud storage are read into memory without local copy
+     *
+     * @return bool
+     */
+    bool streamCloudModels() {
+        return result->operator[]("stream_cloud_models").as<bool>();
+    }
+
+    /**
+     * @brief Get the directory of cloud model files cache
+     *
+     * @return const std::string&
+     */
+    const std::string& cloudModelCacheDir() {
+        if (result->count("cloud_model_cache_dir"))
+            return result->operator[]("cloud_model_cache_dir").as<std::string>();
+        return empty;
+    }
+
+    /**
+     * @brief Get the size limit of cloud model files cache in megabytes
+     *
+     * @return uint64_t
+     */
+    uint64_t cloudModelCacheSizeMb() {
+        return result->operator[]("cloud_model_cache_size_mb").as<uint64_t>();
+    }
+
+    /**
+     * @brief Get the number of concurrent Azure Blob Storage download requests
+     *
+     * @return uint
+     */
+    uint azureDownloadParallelism() {
+        return result->operator[]("azure_download_parallelism").as<uint>();
+    }
+
+    /**
+     * @brief Get the size of Azure Blob Storage download ranges in megabytes
+     *
+     * @return uint
+     */
+    uint azureDownloadChunkSizeMb() {
+        return result->operator[]("azure_download_chunk_size_mb").as<uint>();
+    }
+
+    /**
+     * @brief Get the memory budget of models loaded on demand in megabytes
+     *
+     * @return uint64_t
+     */
+    uint64_t onDemandModelsMemoryBudgetMb() {
+        return result->operator[]("on_demand_models_memory_budget_mb").as<uint64_t>();
+    }
+
+    /**
+     * @brief Get the memory limit of idle pooled tensor buffers in megabytes
+     *
+     * @return uint64_t
+     */
+    uint64_t tensorBufferPoolSizeMb() {
+        return result->operator[]("tensor_buffer_pool_size_mb").as<uint64_t>();
+    }
+
+    /**
+     * @brief Get the number of CPU streams split between models, 0 if not limited
+     *
+     * @return uint
+     */
+    uint cpuStreamsBudget() {
+        return result->operator[]("cpu_streams_budget").as<uint>();
+    }
+
+    /**
+         * @brief Get the tenant limits
+         * 
+         * @return const std::string& 
+         */
+    const std::string& tenantLimits() {
+        if (result->count("tenant_limits"))
+            return result->operator[]("tenant_limits").as<std::string>();
+        return empty;
+    }
+
+    /**
+         * @brief Get the CPU sets of isolation groups
+         * 
+         * @return const std::string& 
+         */
+    const std::string& isolationGroups() {
+        if (result->count("isolation_groups"))
+            return result->operator[]("isolation_groups").as<std::string>();
+        return empty;
+    }
+
+    /**
+         * @brief Get the gRPC addresses of peers
+         * 
+         * @return const std::string& 
+         */
+    const std::string& peers() {
+        if (result->count("peers"))
+            return result->operator[]("peers").as<std::string>();
+        return empty;
+    }
+
+    /**
+         * @brief Get the interval of polling peers in milliseconds
+         * 
+         * @return uint 
+         */
+    uint peerPollIntervalMs() {
+        return result->operator[]("peer_poll_interval_ms").as<uint>();
+    }
+
+    /**
+         * @brief Get the time of draining requests on SIGTERM in seconds
+         * 
+         * @return uint 
+         */
+    uint drainTimeoutSeconds() {
+        return result->operator[]("drain_timeout_seconds").as<uint>();
+    }
+
+    /**
+     * @brief Get the path of pipeline trace file
+     *
+     * @return const std::string&
+     */
+    const std::string& pipelineTracePath() {
+        if (result->count("pipeline_trace_path"))
+            return result->operator[]("pipeline_trace_path").as<std::string>();
+        return empty;
+    }
+
+    /**
+     * @brief Get the fraction of traced pipeline executions
+     *
+     * @return float
+     */
+    float pipelineTraceSamplingRate() {
+        return result->operator[]("pipeline_trace_sampling_rate").as<float>();
+    }
 };
 }  // namespace ovms
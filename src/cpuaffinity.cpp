@@ -0,0 +1,120 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cpuaffinity.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "stringutils.hpp"
+
+namespace ovms {
+
+namespace {
+// keeps malformed ranges from allocating huge lists, matches default kernel NR_CPUS limit
+const uint32_t MAX_CPU_ID = 8191;
+
+bool readNumaNodeCpus(uint32_t node, std::vector<int>& cpus) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+    if (!file.is_open() || !std::getline(file, list)) {
+        return false;
+    }
+    cpus = parseCpuList(list);
+    return true;
+}
+}  // namespace
+
+std::vector<int> parseCpuList(const std::string& list) {
+    std::set<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        trim(range);
+        if (range.empty()) {
+            continue;
+        }
+        const auto dash = range.find('-');
+        auto first = stou32(range.substr(0, dash));
+        auto last = dash == std::string::npos ? first : stou32(range.substr(dash + 1));
+        if (!first || !last || first.value() > last.value() || last.value() > MAX_CPU_ID) {
+            return {};
+        }
+        for (auto cpu = first.value(); cpu <= last.value(); ++cpu) {
+            cpus.insert(cpu);
+        }
+    }
+    return std::vector<int>(cpus.begin(), cpus.end());
+}
+
+std::vector<std::vector<int>> getNumaNodesCpus() {
+    std::vector<std::vector<int>> nodes;
+    std::vector<int> nodeCpus;
+    for (uint32_t node = 0; readNumaNodeCpus(node, nodeCpus); ++node) {
+        if (!nodeCpus.empty()) {
+            nodes.push_back(std::move(nodeCpus));
+        }
+    }
+    if (nodes.empty()) {
+        std::vector<int> cpus(std::max<unsigned>(1, std::thread::hardware_concurrency()));
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            cpus[i] = i;
+        }
+        nodes.push_back(std::move(cpus));
+    }
+    return nodes;
+}
+
+std::vector<int> getNumaNodeCpus(uint32_t node) {
+    std::vector<int> cpus;
+    readNumaNodeCpus(node, cpus);
+    return cpus;
+}
+
+bool pinCurrentThread(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+ScopedThreadAffinity::ScopedThreadAffinity(const std::vector<int>& cpus) {
+    if (!cpus.empty() && pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) == 0) {
+        pinned = pinCurrentThread(cpus);
+    }
+}
+
+ScopedThreadAffinity::~ScopedThreadAffinity() {
+    if (pinned) {
+        pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+    }
+}
+
+}  // namespace ovms
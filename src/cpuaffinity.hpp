@@ -0,0 +1,74 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <sched.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ovms {
+
+/**
+ * @brief Parses list of CPUs in kernel cpulist format, e.g. "0-3,8-11"
+ *
+ * @return CPU ids in ascending order, empty if the list is malformed
+ */
+std::vector<int> parseCpuList(const std::string& list);
+
+/**
+ * @brief Reads CPUs of NUMA nodes from sysfs
+ *
+ * @return CPUs of each node, single node with all CPUs when NUMA topology is not exposed
+ */
+std::vector<std::vector<int>> getNumaNodesCpus();
+
+/**
+ * @brief Reads CPUs of a single NUMA node from sysfs
+ *
+ * @return CPUs of the node, empty if the node does not exist or has no CPUs
+ */
+std::vector<int> getNumaNodeCpus(uint32_t node);
+
+/**
+ * @brief Restricts calling thread to the CPUs
+ *
+ * @return false if affinity could not be set
+ */
+bool pinCurrentThread(const std::vector<int>& cpus);
+
+/**
+ * @brief Restricts calling thread to the CPUs until destroyed, then restores previous affinity
+ *
+ * Threads started meanwhile inherit the restricted affinity. Empty CPU list leaves affinity unchanged.
+ */
+class ScopedThreadAffinity {
+public:
+    explicit ScopedThreadAffinity(const std::vector<int>& cpus);
+    ~ScopedThreadAffinity();
+
+    ScopedThreadAffinity(const ScopedThreadAffinity&) = delete;
+    ScopedThreadAffinity& operator=(const ScopedThreadAffinity&) = delete;
+
+    bool isPinned() const { return pinned; }
+
+private:
+    cpu_set_t previous;
+    bool pinned = false;
+};
+
+}  // namespace ovms
@@ -0,0 +1,88 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cpustreamsbudget.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "modelconfig.hpp"
+
+namespace ovms {
+
+void CpuStreamsBudget::configure(uint32_t streams, uint32_t cpusCount) {
+    this->streams = streams;
+    this->threadsPerStream = streams > 0 ? std::max<uint32_t>(1, cpusCount / streams) : 1;
+    if (streams > 0) {
+        spdlog::info("CPU streams budget: {} streams with {} threads each", streams, threadsPerStream);
+    }
+}
+
+std::vector<uint32_t> CpuStreamsBudget::split(const std::vector<uint32_t>& weights) const {
+    std::vector<uint32_t> shares(weights.size(), 1);
+    if (weights.size() >= streams) {
+        return shares;
+    }
+    const uint64_t totalWeight = std::accumulate(weights.begin(), weights.end(), uint64_t(0));
+    if (totalWeight == 0) {
+        return shares;
+    }
+    const uint64_t distributed = streams - weights.size();
+    uint64_t assigned = 0;
+    std::vector<std::pair<uint64_t, size_t>> remainders;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const uint64_t scaled = distributed * weights[i];
+        shares[i] += scaled / totalWeight;
+        assigned += scaled / totalWeight;
+        remainders.emplace_back(scaled % totalWeight, i);
+    }
+    // stable order gives leftover of equal remainders to models listed first
+    std::stable_sort(remainders.begin(), remainders.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+    for (size_t i = 0; assigned < distributed; ++i, ++assigned) {
+        ++shares[remainders[i].second];
+    }
+    return shares;
+}
+
+void CpuStreamsBudget::assignShares(std::vector<ModelConfig>& configs) const {
+    std::vector<size_t> entitled;
+    std::vector<uint32_t> weights;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        configs[i].setCpuStreamsShare(0);
+        if (!isEnabled() || !configs[i].isDeviceUsed("CPU") || configs[i].getPluginConfig().count("CPU_THROUGHPUT_STREAMS")) {
+            continue;
+        }
+        entitled.push_back(i);
+        weights.push_back(configs[i].getCpuStreamsWeight());
+    }
+    if (entitled.empty()) {
+        return;
+    }
+    if (entitled.size() > streams) {
+        spdlog::warn("CPU streams budget of {} streams is smaller than number of models using it: {}, each gets one stream", streams, entitled.size());
+    }
+    const auto shares = split(weights);
+    for (size_t i = 0; i < entitled.size(); ++i) {
+        auto& config = configs[entitled[i]];
+        config.setCpuStreamsShare(shares[i]);
+        spdlog::debug("Model:{} gets {} of {} budgeted CPU streams", config.getName(), shares[i], streams);
+    }
+}
+
+}  // namespace ovms
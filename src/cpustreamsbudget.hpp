@@ -0,0 +1,68 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ovms {
+
+class ModelConfig;
+
+/**
+ * @brief Server wide number of CPU inference streams split between models, so streams of all models together do not oversubscribe CPUs
+ *
+ * Every model running on CPU without CPU_THROUGHPUT_STREAMS in its plugin config gets a share proportional to its weight.
+ * Shares are assigned again whenever models config is loaded, models with changed share are reloaded.
+ */
+class CpuStreamsBudget {
+public:
+    static CpuStreamsBudget& getInstance() {
+        static CpuStreamsBudget instance;
+        return instance;
+    }
+
+    /**
+     * @brief Sets number of CPU streams of all models, 0 disables the budget
+     *
+     * @param cpusCount CPUs shared by the streams, threads of each stream are a part of these
+     */
+    void configure(uint32_t streams, uint32_t cpusCount);
+
+    bool isEnabled() const { return streams > 0; }
+
+    /**
+     * @brief Splits the budget proportionally to weights, every weight gets at least one stream
+     *
+     * Streams left after rounding down go to the largest remainders. More weights than streams give one stream to each.
+     */
+    std::vector<uint32_t> split(const std::vector<uint32_t>& weights) const;
+
+    /**
+     * @brief Sets CPU streams share of every model entitled to it, share of other models is 0
+     */
+    void assignShares(std::vector<ModelConfig>& configs) const;
+
+    uint32_t getThreadsPerStream() const { return threadsPerStream; }
+
+private:
+    CpuStreamsBudget() = default;
+
+    uint32_t streams = 0;
+    uint32_t threadsPerStream = 1;
+};
+
+}  // namespace ovms
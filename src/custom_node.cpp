@@ -0,0 +1,195 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "custom_node.hpp"
+
+#include <functional>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "ov_utils.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+CustomNode::CustomNode(const std::string& nodeName, std::shared_ptr<CustomNodeLibrary> library,
+    const std::unordered_map<std::string, std::string>& parameters,
+    const std::unordered_map<std::string, std::string>& nodeOutputNameAlias) :
+    Node(nodeName),
+    library(std::move(library)),
+    parameters(parameters),
+    nodeOutputNameAlias(nodeOutputNameAlias) {
+    for (const auto& pair : this->parameters) {
+        libraryParameters.push_back(CustomNodeParam{pair.first.c_str(), pair.second.c_str()});
+    }
+}
+
+CustomNodeTensorPrecision CustomNode::toCustomNodeTensorPrecision(InferenceEngine::Precision precision) {
+    switch (precision) {
+    case InferenceEngine::Precision::FP32:
+        return CUSTOM_NODE_TENSOR_PRECISION_FP32;
+    case InferenceEngine::Precision::FP16:
+        return CUSTOM_NODE_TENSOR_PRECISION_FP16;
+    case InferenceEngine::Precision::I64:
+        return CUSTOM_NODE_TENSOR_PRECISION_I64;
+    case InferenceEngine::Precision::I32:
+        return CUSTOM_NODE_TENSOR_PRECISION_I32;
+    case InferenceEngine::Precision::I16:
+        return CUSTOM_NODE_TENSOR_PRECISION_I16;
+    case InferenceEngine::Precision::U16:
+        return CUSTOM_NODE_TENSOR_PRECISION_U16;
+    case InferenceEngine::Precision::I8:
+        return CUSTOM_NODE_TENSOR_PRECISION_I8;
+    case InferenceEngine::Precision::U8:
+        return CUSTOM_NODE_TENSOR_PRECISION_U8;
+    default:
+        return CUSTOM_NODE_TENSOR_PRECISION_UNSPECIFIED;
+    }
+}
+
+InferenceEngine::Precision CustomNode::toInferenceEnginePrecision(CustomNodeTensorPrecision precision) {
+    switch (precision) {
+    case CUSTOM_NODE_TENSOR_PRECISION_FP32:
+        return InferenceEngine::Precision::FP32;
+    case CUSTOM_NODE_TENSOR_PRECISION_FP16:
+        return InferenceEngine::Precision::FP16;
+    case CUSTOM_NODE_TENSOR_PRECISION_I64:
+        return InferenceEngine::Precision::I64;
+    case CUSTOM_NODE_TENSOR_PRECISION_I32:
+        return InferenceEngine::Precision::I32;
+    case CUSTOM_NODE_TENSOR_PRECISION_I16:
+        return InferenceEngine::Precision::I16;
+    case CUSTOM_NODE_TENSOR_PRECISION_U16:
+        return InferenceEngine::Precision::U16;
+    case CUSTOM_NODE_TENSOR_PRECISION_I8:
+        return InferenceEngine::Precision::I8;
+    case CUSTOM_NODE_TENSOR_PRECISION_U8:
+        return InferenceEngine::Precision::U8;
+    default:
+        return InferenceEngine::Precision::UNSPECIFIED;
+    }
+}
+
+Status CustomNode::execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) {
+    auto status = executeLibrary();
+    // After execution inputs are not needed anymore, outputs do not refer to them
+    this->inputBlobs.clear();
+    notifyEndQueue.push(*this);
+    return status;
+}
+
+Status CustomNode::executeLibrary() {
+    std::vector<CustomNodeTensor> inputs;
+    std::vector<std::vector<uint64_t>> inputsDims;
+    inputs.reserve(this->inputBlobs.size());
+    inputsDims.reserve(this->inputBlobs.size());
+    for (const auto& pair : this->inputBlobs) {
+        const auto& blob = pair.second;
+        const auto& tensorDesc = blob->getTensorDesc();
+        auto precision = toCustomNodeTensorPrecision(tensorDesc.getPrecision());
+        if (precision == CUSTOM_NODE_TENSOR_PRECISION_UNSPECIFIED) {
+            std::stringstream ss;
+            ss << "Node: " << getName() << " input: " << pair.first << " has unsupported precision: " << TensorInfo::getPrecisionAsString(tensorDesc.getPrecision());
+            const std::string details = ss.str();
+            SPDLOG_DEBUG(details);
+            return Status(StatusCode::INVALID_PRECISION, details);
+        }
+        const auto& dims = inputsDims.emplace_back(tensorDesc.getDims().begin(), tensorDesc.getDims().end());
+        inputs.push_back(CustomNodeTensor{
+            pair.first.c_str(),
+            blob->buffer().as<uint8_t*>(),
+            blob->byteSize(),
+            const_cast<uint64_t*>(dims.data()),
+            dims.size(),
+            precision});
+    }
+
+    struct CustomNodeTensor* outputs = nullptr;
+    int outputsCount = 0;
+    SPDLOG_DEBUG("[Node: {}] Executing custom node library: {}", getName(), library->getPath());
+    int result = library->execute(inputs.data(), static_cast<int>(inputs.size()), &outputs, &outputsCount,
+        libraryParameters.data(), static_cast<int>(libraryParameters.size()));
+    if (result != 0) {
+        SPDLOG_DEBUG("[Node: {}] Custom node library: {} execution failed with: {}", getName(), library->getPath(), result);
+        return StatusCode::NODE_LIBRARY_EXECUTION_FAILED;
+    }
+    return takeOverOutputs(outputs, outputsCount);
+}
+
+Status CustomNode::takeOverOutputs(struct CustomNodeTensor* outputs, int outputsCount) {
+    Status status = StatusCode::OK;
+    // Every output buffer is taken over even if some output is invalid, so nothing leaks
+    for (int i = 0; i < outputsCount; i++) {
+        auto& output = outputs[i];
+        // library stays loaded as long as any of its buffers is used
+        std::shared_ptr<void> memoryOwner(output.data, [library = this->library](void* data) { library->releaseBuffer(data); });
+        InferenceEngine::SizeVector dims(output.dims, output.dims + output.dimsCount);
+        library->releaseBuffer(output.dims);
+        if (!status.ok()) {
+            continue;
+        }
+        if (output.name == nullptr) {
+            status = Status(StatusCode::NODE_LIBRARY_OUTPUTS_INVALID, "Node: " + getName() + " library returned output without name");
+            SPDLOG_DEBUG(status.string());
+            continue;
+        }
+        const std::string name = output.name;
+        const auto precision = toInferenceEnginePrecision(output.precision);
+        InferenceEngine::TensorDesc tensorDesc(precision, dims, InferenceEngine::TensorDesc::getLayoutByDims(dims));
+        InferenceEngine::Blob::Ptr blob;
+        if (precision != InferenceEngine::Precision::UNSPECIFIED &&
+            std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<size_t>()) * precision.size() == output.dataBytes) {
+            blob = blobOnExternalMemory(tensorDesc, output.data, std::move(memoryOwner));
+        }
+        if (blob == nullptr) {
+            std::stringstream ss;
+            ss << "Node: " << getName() << " library output: " << name << " has unsupported precision or data size: " << output.dataBytes
+               << " does not match shape: " << TensorInfo::shapeToString(dims);
+            const std::string details = ss.str();
+            SPDLOG_DEBUG(details);
+            status = Status(StatusCode::NODE_LIBRARY_OUTPUTS_INVALID, details);
+            continue;
+        }
+        this->resultBlobs[name] = std::move(blob);
+    }
+    library->releaseBuffer(outputs);
+    if (!status.ok()) {
+        this->resultBlobs.clear();
+    }
+    return status;
+}
+
+Status CustomNode::fetchResults(BlobMap& outputs) {
+    // Fill outputs map with library results. Fetch only those that are required in following nodes
+    for (const auto& output_name : this->getRequiredOutputs()) {
+        const auto& libraryOutputName = nodeOutputNameAlias.count(output_name) == 1 ? nodeOutputNameAlias.at(output_name) : output_name;
+        auto it = this->resultBlobs.find(libraryOutputName);
+        if (it == this->resultBlobs.end()) {
+            std::stringstream ss;
+            ss << "Node: " << getName() << " library did not return output: " << libraryOutputName;
+            const std::string details = ss.str();
+            SPDLOG_DEBUG(details);
+            return Status(StatusCode::NODE_LIBRARY_OUTPUTS_INVALID, details);
+        }
+        outputs.emplace(output_name, it->second);
+    }
+    this->resultBlobs.clear();
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,65 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "custom_node_library.hpp"
+#include "node.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Node executing custom node library on pipeline thread, meant for cheap pre and post processing
+ *
+ * Input blobs are passed to the library without copying. Library outputs are wrapped in blobs
+ * which return the memory to the library when no following node uses them.
+ */
+class CustomNode : public Node {
+    std::shared_ptr<CustomNodeLibrary> library;
+    const std::unordered_map<std::string, std::string> parameters;
+    const std::unordered_map<std::string, std::string> nodeOutputNameAlias;
+    // points to strings kept in parameters
+    std::vector<CustomNodeParam> libraryParameters;
+
+    // Results of execution waiting to be fetched
+    BlobMap resultBlobs;
+
+public:
+    CustomNode(const std::string& nodeName, std::shared_ptr<CustomNodeLibrary> library,
+        const std::unordered_map<std::string, std::string>& parameters = {},
+        const std::unordered_map<std::string, std::string>& nodeOutputNameAlias = {});
+
+    Status execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) override;
+
+    Status fetchResults(BlobMap& outputs) override;
+
+    void release() override {
+        this->resultBlobs.clear();
+    }
+
+    static CustomNodeTensorPrecision toCustomNodeTensorPrecision(InferenceEngine::Precision precision);
+    static InferenceEngine::Precision toInferenceEnginePrecision(CustomNodeTensorPrecision precision);
+
+private:
+    Status executeLibrary();
+    Status takeOverOutputs(struct CustomNodeTensor* outputs, int outputsCount);
+};
+
+}  // namespace ovms
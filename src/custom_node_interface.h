@@ -0,0 +1,71 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief C interface implemented by custom node libraries used in pipelines
+ *
+ * Library exports execute and releaseBuffer functions. Input tensors are owned by the model server
+ * and valid only during execute call. Output tensors, their data and dims, and the outputs array
+ * are allocated by the library and returned to it with releaseBuffer once the server does not use them.
+ * Output names are copied by the server before the outputs array is released.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    CUSTOM_NODE_TENSOR_PRECISION_UNSPECIFIED,
+    CUSTOM_NODE_TENSOR_PRECISION_FP32,
+    CUSTOM_NODE_TENSOR_PRECISION_FP16,
+    CUSTOM_NODE_TENSOR_PRECISION_I64,
+    CUSTOM_NODE_TENSOR_PRECISION_I32,
+    CUSTOM_NODE_TENSOR_PRECISION_I16,
+    CUSTOM_NODE_TENSOR_PRECISION_U16,
+    CUSTOM_NODE_TENSOR_PRECISION_I8,
+    CUSTOM_NODE_TENSOR_PRECISION_U8,
+} CustomNodeTensorPrecision;
+
+struct CustomNodeTensor {
+    const char* name;
+    uint8_t* data;
+    uint64_t dataBytes;
+    uint64_t* dims;
+    uint64_t dimsCount;
+    CustomNodeTensorPrecision precision;
+};
+
+struct CustomNodeParam {
+    const char* key;
+    const char* value;
+};
+
+/**
+ * @brief Processes inputs and allocates outputs, returns 0 on success
+ */
+int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount);
+
+/**
+ * @brief Frees memory allocated by execute, returns 0 on success
+ */
+int releaseBuffer(void* ptr);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,47 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "custom_node_library.hpp"
+
+#include <dlfcn.h>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+CustomNodeLibrary::~CustomNodeLibrary() {
+    SPDLOG_DEBUG("Unloading custom node library: {}", path);
+    dlclose(handle);
+}
+
+Status CustomNodeLibrary::load(const std::string& path, std::shared_ptr<CustomNodeLibrary>& library) {
+    void* handle = dlopen(path.c_str(), RTLD_LAZY | RTLD_LOCAL);
+    if (handle == nullptr) {
+        SPDLOG_ERROR("Failed to load custom node library: {}; error: {}", path, dlerror());
+        return StatusCode::NODE_LIBRARY_LOAD_FAILED;
+    }
+    auto executeFunction = reinterpret_cast<execute_fn>(dlsym(handle, "execute"));
+    auto releaseFunction = reinterpret_cast<release_fn>(dlsym(handle, "releaseBuffer"));
+    if (executeFunction == nullptr || releaseFunction == nullptr) {
+        SPDLOG_ERROR("Custom node library: {} does not export execute and releaseBuffer functions", path);
+        dlclose(handle);
+        return StatusCode::NODE_LIBRARY_LOAD_FAILED;
+    }
+    SPDLOG_INFO("Loaded custom node library: {}", path);
+    library.reset(new CustomNodeLibrary(path, handle, executeFunction, releaseFunction));
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
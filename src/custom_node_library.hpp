@@ -0,0 +1,65 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "custom_node_interface.h"
+#include "status.hpp"
+
+namespace ovms {
+
+typedef int (*execute_fn)(const struct CustomNodeTensor*, int, struct CustomNodeTensor**, int*, const struct CustomNodeParam*, int);
+typedef int (*release_fn)(void*);
+
+/**
+ * @brief Shared library implementing custom node interface, unloaded when last user releases it
+ */
+class CustomNodeLibrary {
+    const std::string path;
+    void* handle;
+    const execute_fn executeFunction;
+    const release_fn releaseFunction;
+
+    CustomNodeLibrary(const std::string& path, void* handle, execute_fn executeFunction, release_fn releaseFunction) :
+        path(path),
+        handle(handle),
+        executeFunction(executeFunction),
+        releaseFunction(releaseFunction) {}
+
+public:
+    CustomNodeLibrary(const CustomNodeLibrary&) = delete;
+    CustomNodeLibrary& operator=(const CustomNodeLibrary&) = delete;
+    ~CustomNodeLibrary();
+
+    /**
+     * @brief Loads library and resolves execute and releaseBuffer functions
+     */
+    static Status load(const std::string& path, std::shared_ptr<CustomNodeLibrary>& library);
+
+    int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount) const {
+        return executeFunction(inputs, inputsCount, outputs, outputsCount, params, paramsCount);
+    }
+
+    int releaseBuffer(void* ptr) const {
+        return releaseFunction(ptr);
+    }
+
+    const std::string& getPath() const { return path; }
+};
+
+}  // namespace ovms
@@ -0,0 +1,106 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "deserialization.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ovms {
+
+namespace {
+
+template <typename T>
+InferenceEngine::Blob::Ptr blobOnContent(const tensorflow::TensorProto& requestInput, const TensorInfo& tensorInfo) {
+    return InferenceEngine::make_shared_blob<T>(
+        tensorInfo.getTensorDesc(),
+        const_cast<T*>(reinterpret_cast<const T*>(requestInput.tensor_content().data())));
+}
+
+// Needs conversion due to zero padding for each value:
+// https://github.com/tensorflow/tensorflow/blob/v2.2.0/tensorflow/core/framework/tensor.proto#L45
+InferenceEngine::Blob::Ptr blobOnHalfValues(const tensorflow::TensorProto& requestInput, const TensorInfo& tensorInfo) {
+    auto blob = InferenceEngine::make_shared_blob<uint16_t>(tensorInfo.getTensorDesc(), getTensorBufferAllocator());
+    blob->allocate();
+    narrowToUint16(requestInput.half_val().data(), blob->buffer().as<uint16_t*>(), static_cast<size_t>(requestInput.half_val_size()));
+    return blob;
+}
+
+// https://github.com/tensorflow/tensorflow/blob/v2.2.0/tensorflow/core/framework/tensor.proto#L55
+InferenceEngine::Blob::Ptr blobOnIntValues(const tensorflow::TensorProto& requestInput, const TensorInfo& tensorInfo) {
+    auto blob = InferenceEngine::make_shared_blob<uint16_t>(tensorInfo.getTensorDesc(), getTensorBufferAllocator());
+    blob->allocate();
+    narrowToUint16(requestInput.int_val().data(), blob->buffer().as<uint16_t*>(), static_cast<size_t>(requestInput.int_val_size()));
+    return blob;
+}
+
+void copyContent(const tensorflow::TensorProto& requestInput, InferenceEngine::Blob& blob) {
+    std::memcpy(blob.buffer().as<char*>(),
+        requestInput.tensor_content().data(),
+        std::min(blob.byteSize(), requestInput.tensor_content().size()));
+}
+
+void copyHalfValues(const tensorflow::TensorProto& requestInput, InferenceEngine::Blob& blob) {
+    auto size = std::min(static_cast<size_t>(requestInput.half_val_size()), blob.size());
+    narrowToUint16(requestInput.half_val().data(), blob.buffer().as<uint16_t*>(), size);
+}
+
+void copyIntValues(const tensorflow::TensorProto& requestInput, InferenceEngine::Blob& blob) {
+    auto size = std::min(static_cast<size_t>(requestInput.int_val_size()), blob.size());
+    narrowToUint16(requestInput.int_val().data(), blob.buffer().as<uint16_t*>(), size);
+}
+
+template <typename T>
+TensorDeserializers contentDeserializers() {
+    return {blobOnContent<T>, blobOnContent<T>, copyContent, copyContent};
+}
+
+}  // namespace
+
+TensorDeserializers getTensorDeserializers(InferenceEngine::Precision precision) {
+    switch (precision) {
+    case InferenceEngine::Precision::FP32:
+        return contentDeserializers<float>();
+    case InferenceEngine::Precision::FP16:
+        // packed values in tensor_content are sent by KServe API clients
+        return {blobOnContent<int16_t>, blobOnHalfValues, copyContent, copyHalfValues};
+    case InferenceEngine::Precision::U8:
+        return contentDeserializers<uint8_t>();
+    case InferenceEngine::Precision::I8:
+        return contentDeserializers<int8_t>();
+    case InferenceEngine::Precision::U16:
+        return {blobOnContent<uint16_t>, blobOnIntValues, copyContent, copyIntValues};
+    case InferenceEngine::Precision::I16:
+        return contentDeserializers<int16_t>();
+    case InferenceEngine::Precision::I32:
+        return contentDeserializers<int32_t>();
+    case InferenceEngine::Precision::I64:
+        return contentDeserializers<int64_t>();
+    case InferenceEngine::Precision::U64:
+        return contentDeserializers<uint64_t>();
+    case InferenceEngine::Precision::BOOL:
+        // tensor_content holds one byte per DT_BOOL value, same as plugin storage
+        return contentDeserializers<uint8_t>();
+
+    case InferenceEngine::Precision::MIXED:
+    case InferenceEngine::Precision::Q78:
+    case InferenceEngine::Precision::BIN:
+    case InferenceEngine::Precision::CUSTOM:
+    default:
+        return {};
+    }
+}
+
+}  // namespace ovms
@@ -15,6 +15,8 @@
 //*****************************************************************************
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -24,73 +26,79 @@
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 
+#include "imagedecoding.hpp"
+#include "ov_utils.hpp"
+#include "sharedmemory.hpp"
 #include "status.hpp"
+#include "tensorconversion.hpp"
 #include "tensorinfo.hpp"
 
 namespace ovms {
 
-template <typename T>
-InferenceEngine::Blob::Ptr makeBlob(const tensorflow::TensorProto& requestInput,
-    const std::shared_ptr<TensorInfo>& tensorInfo) {
-    return InferenceEngine::make_shared_blob<T>(
-        tensorInfo->getTensorDesc(),
-        const_cast<T*>(reinterpret_cast<const T*>(requestInput.tensor_content().data())));
-}
-
+/**
+ * @brief Creates input blob with deserializer resolved for tensor precision at model load
+ */
 class ConcreteTensorProtoDeserializator {
 public:
     static InferenceEngine::Blob::Ptr deserializeTensorProto(
         const tensorflow::TensorProto& requestInput,
         const std::shared_ptr<TensorInfo>& tensorInfo) {
-        switch (tensorInfo->getPrecision()) {
-        case InferenceEngine::Precision::FP32:
-            return makeBlob<float>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::FP16: {
-            // Needs conversion due to zero padding for each value:
-            // https://github.com/tensorflow/tensorflow/blob/v2.2.0/tensorflow/core/framework/tensor.proto#L45
-            auto blob = InferenceEngine::make_shared_blob<uint16_t>(tensorInfo->getTensorDesc());
-            blob->allocate();
-            uint16_t* ptr = blob->buffer().as<uint16_t*>();
-            auto size = static_cast<size_t>(requestInput.half_val_size());
-            for (size_t i = 0; i < size; i++) {
-                ptr[i] = requestInput.half_val(i);
-            }
-            return blob;
-        }
-        case InferenceEngine::Precision::U8:
-            return makeBlob<uint8_t>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::I8:
-            return makeBlob<int8_t>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::U16: {
-            // Needs conversion due to zero padding for each value:
-            // https://github.com/tensorflow/tensorflow/blob/v2.2.0/tensorflow/core/framework/tensor.proto#L55
-            auto blob = InferenceEngine::make_shared_blob<uint16_t>(tensorInfo->getTensorDesc());
-            blob->allocate();
-            uint16_t* ptr = blob->buffer().as<uint16_t*>();
-            auto size = static_cast<size_t>(requestInput.int_val_size());
-            for (size_t i = 0; i < size; i++) {
-                ptr[i] = requestInput.int_val(i);
-            }
-            return blob;
-        }
-        case InferenceEngine::Precision::I16:
-            return makeBlob<int16_t>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::I32:
-            return makeBlob<int32_t>(requestInput, tensorInfo);
-
-        case InferenceEngine::Precision::I64:
+        const auto& deserializers = tensorInfo->getDeserializers();
+        auto deserialize = requestInput.tensor_content().empty() ? deserializers.fromValues : deserializers.fromContent;
+        return deserialize != nullptr ? deserialize(requestInput, *tensorInfo) : nullptr;
+    }
+};
 
-        case InferenceEngine::Precision::MIXED:
-        case InferenceEngine::Precision::Q78:
-        case InferenceEngine::Precision::BIN:
-        case InferenceEngine::Precision::BOOL:
-        case InferenceEngine::Precision::CUSTOM:
-        default:
-            return nullptr;
+/**
+ * @brief Writes request input into blob already allocated by the plugin for infer request,
+ * so that no memory is allocated and blob does not have to be set on infer request again.
+ */
+class PreallocatedBlobTensorProtoDeserializator {
+public:
+    static Status deserializeTensorProto(
+        const tensorflow::TensorProto& requestInput,
+        const std::shared_ptr<TensorInfo>& tensorInfo,
+        const InferenceEngine::Blob::Ptr& blob) {
+        if (isImageInput(requestInput)) {
+            return decodeImages(requestInput, blob);
         }
+        const auto& deserializers = tensorInfo->getDeserializers();
+        auto deserialize = requestInput.tensor_content().empty() ? deserializers.copyValues : deserializers.copyContent;
+        if (deserialize == nullptr) {
+            return StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION;
+        }
+        deserialize(requestInput, *blob);
+        return StatusCode::OK;
     }
 };
 
+/**
+ * @brief Sets blob on memory of shared memory region referenced by request input, region stays mapped while blob exists
+ */
+inline Status setSharedMemoryInputBlob(
+    const tensorflow::TensorProto& requestInput,
+    const std::shared_ptr<TensorInfo>& tensorInfo,
+    InferenceEngine::InferRequest& inferRequest) {
+    const auto& tensorDesc = tensorInfo->getTensorDesc();
+    size_t byteSize = tensorDesc.getPrecision().size();
+    for (const auto dim : tensorDesc.getDims()) {
+        byteSize *= dim;
+    }
+    std::shared_ptr<const SharedMemoryRegion> region;
+    const char* data = nullptr;
+    auto status = getSharedMemoryInput(requestInput, byteSize, region, data);
+    if (!status.ok()) {
+        return status;
+    }
+    // plugins do not write into input blobs, mapping is read only
+    auto blob = blobOnExternalMemory(tensorDesc, const_cast<char*>(data), std::const_pointer_cast<SharedMemoryRegion>(region));
+    if (blob == nullptr) {
+        return StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION;
+    }
+    inferRequest.SetBlob(tensorInfo->getName(), blob);
+    return StatusCode::OK;
+}
+
 template <class TensorProtoDeserializator>
 InferenceEngine::Blob::Ptr deserializeTensorProto(
     const tensorflow::TensorProto& requestInput,
@@ -113,6 +121,16 @@ Status deserializePredictRequest(
                 return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
             }
             auto& requestInput = requestInputItr->second;
+            if (isImageInput(requestInput)) {
+                auto blob = blobAllocate(tensorInfo->getTensorDesc());
+                auto status = decodeImages(requestInput, blob);
+                if (!status.ok()) {
+                    SPDLOG_DEBUG(status.string());
+                    return status;
+                }
+                inferRequest.SetBlob(tensorInfo->getName(), blob);
+                continue;
+            }
 
             InferenceEngine::Blob::Ptr blob =
                 deserializeTensorProto<TensorProtoDeserializator>(
@@ -140,4 +158,64 @@ Status deserializePredictRequest(
 
     return StatusCode::OK;
 }
+
+/**
+ * @brief Deserializes request into input blobs owned by infer request.
+ *
+ * Blobs are set back on infer request only if it holds different ones, e.g. set by pipeline node
+ * or by previous request with input in shared memory.
+ */
+template <class TensorProtoDeserializator>
+Status deserializePredictRequest(
+    const tensorflow::serving::PredictRequest& request,
+    const tensor_map_t& inputMap,
+    InferenceEngine::InferRequest& inferRequest,
+    const InferenceEngine::BlobMap& preallocatedBlobs) {
+    try {
+        for (const auto& pair : inputMap) {
+            const auto& name = pair.first;
+            auto tensorInfo = pair.second;
+            auto requestInputItr = request.inputs().find(name);
+            if (requestInputItr == request.inputs().end()) {
+                SPDLOG_ERROR("Failed to deserialize request. Validation of request failed");
+                return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
+            }
+            auto blobItr = preallocatedBlobs.find(tensorInfo->getName());
+            if (blobItr == preallocatedBlobs.end()) {
+                SPDLOG_ERROR("Failed to deserialize request. Missing preallocated blob for input: {}", tensorInfo->getName());
+                return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
+            }
+            if (isSharedMemoryInput(requestInputItr->second)) {
+                auto status = setSharedMemoryInputBlob(requestInputItr->second, tensorInfo, inferRequest);
+                if (!status.ok()) {
+                    SPDLOG_DEBUG(status.string());
+                    return status;
+                }
+                continue;
+            }
+            auto& blob = blobItr->second;
+            auto status = TensorProtoDeserializator::deserializeTensorProto(requestInputItr->second, tensorInfo, blob);
+            if (!status.ok()) {
+                SPDLOG_ERROR(status.string());
+                return status;
+            }
+            if (inferRequest.GetBlob(tensorInfo->getName()) != blob) {
+                inferRequest.SetBlob(tensorInfo->getName(), blob);
+            }
+        }
+        // OV implementation the InferenceEngineException is not
+        // a base class for all other exceptions thrown from OV.
+        // OV can throw exceptions derived from std::logic_error.
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        Status status = StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+        SPDLOG_ERROR("{}: {}", status.string(), e.what());
+        return status;
+    } catch (std::logic_error& e) {
+        Status status = StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+        SPDLOG_ERROR("{}: {}", status.string(), e.what());
+        return status;
+    }
+
+    return StatusCode::OK;
+}
 }  // namespace ovms
@@ -15,12 +15,15 @@
 //*****************************************************************************
 #include "dl_node.hpp"
 
+#include <chrono>
 #include <map>
 #include <utility>
 
 #include <inference_engine.hpp>
 #include <spdlog/spdlog.h>
 
+#include "batchingscheduler.hpp"
+#include "blobconversion.hpp"
 #include "modelmanager.hpp"
 #include "ov_utils.hpp"
 #include "ovinferrequestsqueue.hpp"
@@ -28,25 +31,35 @@
 
 namespace ovms {
 
-const uint WAIT_FOR_STREAM_ID_TIMEOUT_MICROSECONDS = 1;
-
 Status DLNode::execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) {
     Status status;
-    if (this->nodeStreamIdGuard == nullptr) {
+    if (this->model == nullptr) {
         status = requestExecuteRequiredResources();
         if (!status.ok()) {
             notifyEndQueue.push(*this);
             return status;
         }
+        this->outputsCached = findCachedOutputs();
+        if (this->outputsCached) {
+            notifyEndQueue.push(*this);
+            return StatusCode::OK;
+        }
+        this->executedByScheduler = isBatchedByScheduler();
+        if (this->executedByScheduler) {
+            scheduleBatchedInference(notifyEndQueue);
+            return StatusCode::OK;
+        }
+        this->nodeStreamIdGuard = std::make_unique<NodeStreamIdGuard>(this->model->selectInferRequestsQueue(this->device));
     }
-    auto streamId = this->nodeStreamIdGuard->tryGetId(WAIT_FOR_STREAM_ID_TIMEOUT_MICROSECONDS);
+    // returned stream wakes up pipeline to retry execution of this node
+    auto streamId = this->nodeStreamIdGuard->tryGetId([&notifyEndQueue]() { notifyEndQueue.wakeUp(); });
     if (!streamId) {
         SPDLOG_DEBUG("[Node: {}] Could not acquire stream Id right away", getName());
         return StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET;
     }
-    auto& inferRequestsQueue = this->model->getInferRequestsQueue();
+    auto& inferRequestsQueue = this->nodeStreamIdGuard->getInferRequestsQueue();
     auto& inferRequest = inferRequestsQueue.getInferRequest(streamId.value());
-    status = setInputsForInference(inferRequest);
+    status = setInputsForInference(inferRequest, inferRequestsQueue, streamId.value());
     if (!status.ok()) {
         notifyEndQueue.push(*this);
         return status;
@@ -77,23 +90,80 @@ Status DLNode::requestExecuteRequiredResources() {
     if (!status.ok()) {
         return status;
     }
-    auto& inferRequestsQueue = this->model->getInferRequestsQueue();
-    this->nodeStreamIdGuard = std::make_unique<NodeStreamIdGuard>(inferRequestsQueue);
     return status;
 }
 
-Status DLNode::setInputsForInference(InferenceEngine::InferRequest& infer_request) {
+bool DLNode::findCachedOutputs() {
+    this->outputCache = this->model->getNodeOutputCache();
+    if (this->outputCache == nullptr) {
+        return false;
+    }
+    this->outputCacheKey = NodeOutputCache::computeKey(this->inputBlobs, this->model->getVersion());
+    auto outputs = this->outputCache->get(this->outputCacheKey);
+    if (outputs == nullptr) {
+        return false;
+    }
+    // entry put by a node requiring other outputs of the model is not used
+    for (const auto& output_name : this->getRequiredOutputs()) {
+        std::string realModelOutputName;
+        if (!getRealOutputName(output_name, &realModelOutputName).ok() || outputs->count(realModelOutputName) == 0) {
+            return false;
+        }
+    }
+    SPDLOG_DEBUG("[Node: {}] Outputs of model: {} found in node output cache", getName(), modelName);
+    this->cachedOutputs = std::move(outputs);
+    this->inputBlobs.clear();
+    return true;
+}
+
+bool DLNode::isBatchedByScheduler() const {
+    // scheduler runs batches on target device network
+    if (!this->device.empty() && this->device != this->model->getModelConfig().getTargetDevice()) {
+        return false;
+    }
+    return this->model->getBatchingScheduler() != nullptr && BatchingScheduler::areBlobsBatchable(this->inputBlobs);
+}
+
+void DLNode::scheduleBatchedInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) {
+    BlobMap inputs;
+    for (const auto& kv : this->inputBlobs) {
+        inputs.emplace(kv.first, kv.second);
+    }
+    // After inputs are handed to the scheduler, these are not needed by the node
+    this->inputBlobs.clear();
+    SPDLOG_DEBUG("[Node: {}] Scheduling batched inference of model: {}", getName(), modelName);
+    this->model->getBatchingScheduler()->scheduleNode(std::move(inputs), [this, &notifyEndQueue](const Status& status, BlobMap&& outputs) {
+        SPDLOG_DEBUG("Batched inference completed for node name: {}", this->getName());
+        this->batchedStatus = status;
+        this->batchedOutputs = std::move(outputs);
+        notifyEndQueue.push(*this);
+    });
+}
+
+Status DLNode::setInputsForInference(InferenceEngine::InferRequest& infer_request, const OVInferRequestsQueue& inferRequestsQueue, int streamId) {
     Status status = StatusCode::OK;
     try {
         // Prepare inference request, fill with input blobs
-        for (const auto& kv : this->inputBlobs) {
+        for (auto& kv : this->inputBlobs) {
             std::string realModelInputName;
             if (!getRealInputName(kv.first, &realModelInputName).ok()) {
                 SPDLOG_ERROR("DLNode::fetchResults (Node name {}); cannot find real model input name for alias: {}", getName(), kv.first);
                 return StatusCode::INTERNAL_ERROR;
             }
+            // device memory of other context is not accessible by the network
+            if (isRemoteBlob(kv.second) && kv.second->as<InferenceEngine::RemoteBlob>()->getContext() != inferRequestsQueue.getRemoteContext()) {
+                kv.second = blobToHost(kv.second);
+                if (kv.second == nullptr) {
+                    SPDLOG_ERROR("[Node: {}] Cannot copy input {} from device memory", getName(), kv.first);
+                    return StatusCode::INTERNAL_ERROR;
+                }
+            }
             infer_request.SetBlob(realModelInputName, kv.second);
         }
+        // outputs stay in device memory for following nodes, host blobs are restored when results are fetched
+        for (const auto& pair : inferRequestsQueue.getRemoteOutputBlobs(streamId)) {
+            infer_request.SetBlob(pair.first, pair.second);
+        }
         // OV implementation the InferenceEngineException is not
         // a base class for all other exceptions thrown from OV.
         // OV can throw exceptions derived from std::logic_error.
@@ -113,8 +183,12 @@ Status DLNode::setInputsForInference(InferenceEngine::InferRequest& infer_reques
 Status DLNode::executeInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue, InferenceEngine::InferRequest& infer_request) {
     try {
         SPDLOG_DEBUG("Setting completion callback for node name: {}", this->getName());
-        infer_request.SetCompletionCallback([this, &notifyEndQueue, &infer_request]() {
+        // latency of node inferences counts into load estimate used to select device replica, like for predict requests
+        auto& inferRequestsQueue = this->nodeStreamIdGuard->getInferRequestsQueue();
+        const auto start = std::chrono::steady_clock::now();
+        infer_request.SetCompletionCallback([this, &notifyEndQueue, &infer_request, &inferRequestsQueue, start]() {
             SPDLOG_DEBUG("Completion callback received for node name: {}", this->getName());
+            inferRequestsQueue.recordInferenceLatency(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
             // After inference is completed, input blobs are not needed anymore
             this->inputBlobs.clear();
             notifyEndQueue.push(*this);
@@ -144,6 +218,12 @@ Status DLNode::fetchResults(BlobMap& outputs) {
         spdlog::debug("[Node: {}] Fetching results failed due to earlier execution failure", getName());
         return StatusCode::UNKNOWN_ERROR;
     }
+    if (this->cachedOutputs != nullptr) {
+        return fetchCachedResults(outputs);
+    }
+    if (this->executedByScheduler) {
+        return fetchBatchedResults(outputs);
+    }
 
     // Get infer request corresponding to this node model
     auto streamId = this->nodeStreamIdGuard->tryGetId();
@@ -151,56 +231,154 @@ Status DLNode::fetchResults(BlobMap& outputs) {
         spdlog::debug("[Node: {}] Fetching results failed - node had stream Id never assigned", getName());
         return StatusCode::UNKNOWN_ERROR;
     }
-    auto& infer_request = this->model->getInferRequestsQueue().getInferRequest(streamId.value());
+    auto& inferRequestsQueue = this->nodeStreamIdGuard->getInferRequestsQueue();
+    auto& infer_request = inferRequestsQueue.getInferRequest(streamId.value());
     // Wait for blob results
     spdlog::debug("[Node: {}] Waiting for infer request with streamId:{} to finish", getName(), streamId.value());
     auto ov_status = infer_request.Wait(InferenceEngine::IInferRequest::RESULT_READY);
     spdlog::debug("[Node: {}] Infer request with streamId:{} finished", getName(), streamId.value());
     this->inputBlobs.clear();
+    // infer request used outside of pipelines must not write outputs into device memory
+    const auto& remoteOutputBlobs = inferRequestsQueue.getRemoteOutputBlobs(streamId.value());
+    Status status = StatusCode::OK;
+    if (!remoteOutputBlobs.empty()) {
+        status = restorePreallocatedBlobs(infer_request, inferRequestsQueue.getPreallocatedOutputBlobs(streamId.value()));
+        if (!status.ok()) {
+            return status;
+        }
+    }
     if (ov_status != InferenceEngine::StatusCode::OK) {
-        Status status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+        status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
         spdlog::debug("[Node: {}] Async infer failed: {}; OV StatusCode: {}", getName(), status.string(), ov_status);
         return status;
     }
+    this->model->recordPerfCounters(infer_request);
+    status = restorePreallocatedBlobs(infer_request, inferRequestsQueue.getPreallocatedInputBlobs(streamId.value()));
+    if (!status.ok()) {
+        return status;
+    }
+
+    // Outputs put into node output cache are copied, so the stream is returned right away
+    if (this->outputCache != nullptr) {
+        return fetchResultsIntoCache(outputs, infer_request, remoteOutputBlobs);
+    }
 
+    // Output blobs are handed to following nodes without copying. Every handed blob shares ownership of
+    // resources of this node, so the stream stays reserved until all consumers drop the blobs.
+    auto outputsOwner = std::make_shared<BorrowedOutputsOwner>();
     // Fill outputs map with result blobs. Fetch only those that are required in following nodes.
-    for (const auto& node : this->next) {
-        for (const auto& pair : node.get().getMappingByDependency(*this)) {
-            const auto& output_name = pair.first;
-            if (outputs.count(output_name) == 1) {
-                continue;
+    for (const auto& output_name : this->getRequiredOutputs()) {
+        try {
+            std::string realModelOutputName;
+            if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
+                SPDLOG_ERROR("[Node: {}] Cannot find real model output name for alias: {}", getName(), output_name);
+                return StatusCode::INTERNAL_ERROR;
             }
+            SPDLOG_DEBUG("[Node: {}] Getting blob from model:{}, inferRequestStreamId:{}, blobName:{}",
+                getName(), modelName, streamId.value(), realModelOutputName);
+            const auto blob = getOutputBlob(infer_request, remoteOutputBlobs, realModelOutputName);
+            outputsOwner->blobs.push_back(blob);
+            outputs.emplace(std::make_pair(output_name, InferenceEngine::Blob::Ptr(outputsOwner, blob.get())));
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_DEBUG("[Node: {}] Error during getting blob {}; exception message: {}", getName(), status.string(), e.what());
+            return status;
+        }
+        spdlog::debug("[Node: {}]: Blob with name {} has been prepared", getName(), output_name);
+    }
+    // After results are fetched, model and inference request are needed only by consumers of output blobs
+    outputsOwner->model = std::move(this->model);
+    outputsOwner->modelUnloadGuard = std::move(this->modelUnloadGuard);
+    outputsOwner->nodeStreamIdGuard = std::move(this->nodeStreamIdGuard);
+    this->release();
+    return StatusCode::OK;
+}
 
-            try {
-                std::string realModelOutputName;
-                if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
-                    SPDLOG_ERROR("[Node: {}] Cannot find real model output name for alias: {}", getName(), output_name);
-                    return StatusCode::INTERNAL_ERROR;
-                }
-                SPDLOG_DEBUG("[Node: {}] Getting blob from model:{}, inferRequestStreamId:{}, blobName:{}",
-                    getName(), modelName, streamId.value(), realModelOutputName);
-                const auto blob = infer_request.GetBlob(realModelOutputName);
-                SPDLOG_DEBUG("[Node: {}] Creating copy of blob from model:{}, inferRequestStreamId:{}, blobName:{}",
-                    getName(), modelName, streamId.value(), realModelOutputName);
-                const auto copiedBlob = blobClone(blob);
-                if (copiedBlob == nullptr) {
-                    SPDLOG_ERROR("[Node: {}] Cannot copy blob - buffer sizes mismatch", getName());
-                    return StatusCode::INTERNAL_ERROR;
-                }
-                outputs.emplace(std::make_pair(output_name, std::move(copiedBlob)));
-            } catch (const InferenceEngine::details::InferenceEngineException& e) {
-                Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
-                SPDLOG_DEBUG("[Node: {}] Error during getting blob {}; exception message: {}", getName(), status.string(), e.what());
-                return status;
+InferenceEngine::Blob::Ptr DLNode::getOutputBlob(InferenceEngine::InferRequest& infer_request, const InferenceEngine::BlobMap& remoteOutputBlobs, const std::string& name) {
+    auto it = remoteOutputBlobs.find(name);
+    return it != remoteOutputBlobs.end() ? it->second : infer_request.GetBlob(name);
+}
+
+Status DLNode::fetchResultsIntoCache(BlobMap& outputs, InferenceEngine::InferRequest& infer_request, const InferenceEngine::BlobMap& remoteOutputBlobs) {
+    auto cachedBlobs = std::make_shared<cached_blobs_t>();
+    for (const auto& output_name : this->getRequiredOutputs()) {
+        try {
+            std::string realModelOutputName;
+            if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
+                SPDLOG_ERROR("[Node: {}] Cannot find real model output name for alias: {}", getName(), output_name);
+                return StatusCode::INTERNAL_ERROR;
+            }
+            auto copiedBlob = blobClone(getOutputBlob(infer_request, remoteOutputBlobs, realModelOutputName));
+            if (copiedBlob == nullptr) {
+                SPDLOG_ERROR("[Node: {}] Cannot copy blob {} to node output cache", getName(), realModelOutputName);
+                return StatusCode::INTERNAL_ERROR;
             }
-            spdlog::debug("[Node: {}]: Blob with name {} has been prepared", getName(), output_name);
+            outputs.emplace(output_name, copiedBlob);
+            cachedBlobs->emplace(realModelOutputName, std::move(copiedBlob));
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_DEBUG("[Node: {}] Error during getting blob {}; exception message: {}", getName(), status.string(), e.what());
+            return status;
+        }
+    }
+    this->outputCache->put(this->outputCacheKey, std::move(cachedBlobs));
+    this->outputsCached = true;
+    this->release();
+    return StatusCode::OK;
+}
+
+Status DLNode::fetchCachedResults(BlobMap& outputs) {
+    for (const auto& output_name : this->getRequiredOutputs()) {
+        std::string realModelOutputName;
+        if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
+            SPDLOG_ERROR("[Node: {}] Cannot find real model output name for alias: {}", getName(), output_name);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        outputs.emplace(output_name, this->cachedOutputs->at(realModelOutputName));
+    }
+    this->release();
+    return StatusCode::OK;
+}
+
+Status DLNode::fetchBatchedResults(BlobMap& outputs) {
+    if (!this->batchedStatus.ok()) {
+        spdlog::debug("[Node: {}] Batched inference failed: {}", getName(), this->batchedStatus.string());
+        return this->batchedStatus;
+    }
+    // Fill outputs map with batch slices of results. Fetch only those that are required in following nodes.
+    for (const auto& output_name : this->getRequiredOutputs()) {
+        std::string realModelOutputName;
+        if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
+            SPDLOG_ERROR("[Node: {}] Cannot find real model output name for alias: {}", getName(), output_name);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        auto it = this->batchedOutputs.find(realModelOutputName);
+        if (it == this->batchedOutputs.end()) {
+            SPDLOG_ERROR("[Node: {}] Batched inference did not return output: {}", getName(), realModelOutputName);
+            return StatusCode::INTERNAL_ERROR;
         }
+        outputs.emplace(output_name, it->second);
     }
-    // After results are fetched, model and inference request are not needed anymore
     this->release();
     return StatusCode::OK;
 }
 
+Status DLNode::restorePreallocatedBlobs(InferenceEngine::InferRequest& infer_request, const InferenceEngine::BlobMap& preallocatedBlobs) {
+    // Input blobs set from previous nodes and output blobs in device memory would otherwise stay referenced by the infer request
+    try {
+        for (const auto& pair : preallocatedBlobs) {
+            if (infer_request.GetBlob(pair.first) != pair.second) {
+                infer_request.SetBlob(pair.first, pair.second);
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        Status status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+        spdlog::debug("[Node: {}] {}; exception message: {}", getName(), status.string(), e.what());
+        return status;
+    }
+    return StatusCode::OK;
+}
+
 Status DLNode::validate(const InferenceEngine::Blob::Ptr& blob, const TensorInfo& info) {
     if (info.getPrecision() != blob->getTensorDesc().getPrecision()) {
         std::stringstream ss;
@@ -248,7 +426,7 @@ Status DLNode::prepareInputsAndModelForInference() {
 
     // Validate each blob against its OV tensor info
     const auto& inputsInfo = this->model->getInputsInfo();
-    for (const auto& kv : this->inputBlobs) {
+    for (auto& kv : this->inputBlobs) {
         const auto& name = kv.first;
         auto& blob = kv.second;
 
@@ -265,14 +443,35 @@ Status DLNode::prepareInputsAndModelForInference() {
             continue;
         }
 
-        // If precision is incorrect, perform conversion
+        // If precision is incorrect, perform conversion if no value changes, shared by nodes consuming the same blob
         if (status == StatusCode::INVALID_PRECISION) {
-            return status;
+            if (!isBlobConversionSupported(blob->getTensorDesc().getPrecision(), inputInfo.getPrecision())) {
+                return status;
+            }
+            InferenceEngine::Blob::Ptr converted;
+            Status conversionStatus;
+            if (this->conversionCache != nullptr) {
+                conversionStatus = this->conversionCache->convert(blob, inputInfo.getPrecision(), converted);
+            } else {
+                conversionStatus = convertBlobPrecision(blob, inputInfo.getPrecision(), converted);
+            }
+            if (!conversionStatus.ok()) {
+                return conversionStatus;
+            }
+            SPDLOG_DEBUG("[Node: {}] Converted input {} to precision {}", getName(), name, inputInfo.getPrecisionAsString());
+            blob = converted;
+            status = validate(blob, inputInfo);
+            if (status.ok()) {
+                continue;
+            }
         }
 
         // If batch size is incorrect, perform network batch size change if allowed (shape mode=auto or batch size=auto)
         if (status == StatusCode::INVALID_BATCH_SIZE) {
-            if (this->model->getModelConfig().getBatchingMode() == Mode::AUTO) {
+            if (isBatchedByScheduler()) {
+                // batch size 1 inputs are merged into network batch by the scheduler
+                continue;
+            } else if (this->model->getModelConfig().getBatchingMode() == Mode::AUTO) {
                 requestedBatchSize = blob->getTensorDesc().getDims()[0];
             } else if (this->model->getModelConfig().isShapeAuto(name)) {
                 requestedReshapes[name] = blob->getTensorDesc().getDims();
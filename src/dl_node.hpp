@@ -19,37 +19,64 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "executinstreamidguard.hpp"
 #include "model_version_policy.hpp"  // for model_version_t typename
 #include "modelinstance.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "node.hpp"
+#include "nodeoutputcache.hpp"
 #include "nodestreamidguard.hpp"
 
 namespace ovms {
 
 class ModelManager;
 
+/**
+ * @brief Keeps model and reserved stream of a DLNode alive while its output blobs are used by following nodes
+ */
+struct BorrowedOutputsOwner {
+    std::shared_ptr<ModelInstance> model;
+    std::unique_ptr<ModelInstanceUnloadGuard> modelUnloadGuard;
+    std::unique_ptr<NodeStreamIdGuard> nodeStreamIdGuard;
+    std::vector<InferenceEngine::Blob::Ptr> blobs;
+};
+
 class DLNode : public Node {
     std::string modelName;
     std::optional<model_version_t> modelVersion;
     ModelManager& modelManager;
     const std::unordered_map<std::string, std::string> nodeOutputNameAlias;
+    // network of the model compiled for this device runs the node, any device of the model if empty
+    const std::string device;
 
     std::shared_ptr<ModelInstance> model;
     std::unique_ptr<NodeStreamIdGuard> nodeStreamIdGuard;
     std::unique_ptr<ModelInstanceUnloadGuard> modelUnloadGuard;
 
+    // Inference merged with other requests by batching scheduler of the model, no stream is reserved by the node
+    bool executedByScheduler = false;
+    Status batchedStatus;
+    BlobMap batchedOutputs;
+
+    // Outputs shared with node output cache of the model, no stream is reserved by the node
+    bool outputsCached = false;
+    std::shared_ptr<NodeOutputCache> outputCache;
+    uint64_t outputCacheKey = 0;
+    std::shared_ptr<const cached_blobs_t> cachedOutputs;
+
 public:
     DLNode(const std::string& nodeName, const std::string& modelName, std::optional<model_version_t> modelVersion,
         ModelManager& modelManager,
-        std::unordered_map<std::string, std::string> nodeOutputNameAlias = {}) :
+        std::unordered_map<std::string, std::string> nodeOutputNameAlias = {},
+        const std::string& device = "") :
         Node(nodeName),
         modelName(modelName),
         modelVersion(modelVersion),
         modelManager(modelManager),
-        nodeOutputNameAlias(nodeOutputNameAlias) {
+        nodeOutputNameAlias(nodeOutputNameAlias),
+        device(device) {
     }
 
     Status execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) override;
@@ -74,8 +101,15 @@ public:
         return this->nodeStreamIdGuard->tryDisarm(microseconds);
     }
 
+    bool outputsReserveStream() const override { return !executedByScheduler && !outputsCached; }
+
+    bool acceptsRemoteInputs() const override { return true; }
+
     void release() override {
         SPDLOG_DEBUG("Releasing resources for node {}", getName());
+        this->batchedOutputs.clear();
+        this->outputCache.reset();
+        this->cachedOutputs.reset();
         this->nodeStreamIdGuard.reset();
         this->model.reset();
         this->modelUnloadGuard.reset();
@@ -100,8 +134,16 @@ private:
     }
 
     Status requestExecuteRequiredResources();
-    Status setInputsForInference(InferenceEngine::InferRequest& infer_request);
+    Status setInputsForInference(InferenceEngine::InferRequest& infer_request, const OVInferRequestsQueue& inferRequestsQueue, int streamId);
+    Status restorePreallocatedBlobs(InferenceEngine::InferRequest& infer_request, const InferenceEngine::BlobMap& preallocatedBlobs);
+    static InferenceEngine::Blob::Ptr getOutputBlob(InferenceEngine::InferRequest& infer_request, const InferenceEngine::BlobMap& remoteOutputBlobs, const std::string& name);
     Status executeInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue, InferenceEngine::InferRequest& infer_request);
+    bool isBatchedByScheduler() const;
+    void scheduleBatchedInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue);
+    Status fetchBatchedResults(BlobMap& outputs);
+    bool findCachedOutputs();
+    Status fetchResultsIntoCache(BlobMap& outputs, InferenceEngine::InferRequest& infer_request, const InferenceEngine::BlobMap& remoteOutputBlobs);
+    Status fetchCachedResults(BlobMap& outputs);
 };
 
 }  // namespace ovms
@@ -23,36 +23,44 @@
 
 #include "tensorflow/core/framework/tensor.h"
 
+#include "ov_utils.hpp"
+
 namespace ovms {
 
+namespace {
+
+template <typename T>
+InferenceEngine::Blob::Ptr blobOnContent(const InferenceEngine::TensorDesc& description, const std::string& content) {
+    // large misaligned content is copied once instead of being wrapped
+    if (contentRequiresRealignment(content)) {
+        return blobRealignedFromContent(description, content);
+    }
+    return InferenceEngine::make_shared_blob<T>(description, const_cast<T*>(reinterpret_cast<const T*>(content.data())));
+}
+
+}  // namespace
+
 Status EntryNode::fetchResults(BlobMap& outputs) {
     // Fill outputs map with tensorflow predict request inputs. Fetch only those that are required in following nodes
-    for (const auto& node : this->next) {
-        for (const auto& pair : node.get().getMappingByDependency(*this)) {
-            const auto& output_name = pair.first;
-            if (outputs.count(output_name) == 1) {
-                continue;
-            }
-
-            if (request->inputs().count(output_name) == 0) {
-                std::stringstream ss;
-                ss << "Required input: " << output_name;
-                const std::string details = ss.str();
-                spdlog::debug("[Node: {}] Missing input with specific name", getName(), details);
-                return Status(StatusCode::INVALID_MISSING_INPUT, details);
-            }
-            const auto& tensor_proto = request->inputs().at(output_name);
-            InferenceEngine::Blob::Ptr blob;
-            spdlog::debug("[Node: {}] Deserializing input:{}", getName(), output_name);
-            auto status = deserialize(tensor_proto, blob);
-            if (!status.ok()) {
-                return status;
-            }
-
-            outputs[output_name] = blob;
-
-            spdlog::debug("[Node: {}]: blob with name {} has been prepared", getName(), output_name);
+    for (const auto& output_name : this->getRequiredOutputs()) {
+        if (request->inputs().count(output_name) == 0) {
+            std::stringstream ss;
+            ss << "Required input: " << output_name;
+            const std::string details = ss.str();
+            spdlog::debug("[Node: {}] Missing input with specific name", getName(), details);
+            return Status(StatusCode::INVALID_MISSING_INPUT, details);
+        }
+        const auto& tensor_proto = request->inputs().at(output_name);
+        InferenceEngine::Blob::Ptr blob;
+        spdlog::debug("[Node: {}] Deserializing input:{}", getName(), output_name);
+        auto status = deserialize(tensor_proto, blob);
+        if (!status.ok()) {
+            return status;
         }
+
+        outputs[output_name] = blob;
+
+        spdlog::debug("[Node: {}]: blob with name {} has been prepared", getName(), output_name);
     }
 
     return StatusCode::OK;
@@ -91,27 +99,45 @@ Status EntryNode::deserialize(const tensorflow::TensorProto& proto, InferenceEng
         switch (proto.dtype()) {
         case tensorflow::DataType::DT_FLOAT:
             description.setPrecision(InferenceEngine::Precision::FP32);
-            blob = InferenceEngine::make_shared_blob<float>(description, (float*)proto.tensor_content().data());
+            blob = blobOnContent<float>(description, proto.tensor_content());
             break;
         case tensorflow::DataType::DT_UINT8:
             description.setPrecision(InferenceEngine::Precision::U8);
-            blob = InferenceEngine::make_shared_blob<uint8_t>(description, (uint8_t*)proto.tensor_content().data());
+            blob = blobOnContent<uint8_t>(description, proto.tensor_content());
             break;
         case tensorflow::DataType::DT_INT8:
             description.setPrecision(InferenceEngine::Precision::I8);
-            blob = InferenceEngine::make_shared_blob<int8_t>(description, (int8_t*)proto.tensor_content().data());
+            blob = blobOnContent<int8_t>(description, proto.tensor_content());
             break;
         case tensorflow::DataType::DT_INT16:
             description.setPrecision(InferenceEngine::Precision::I16);
-            blob = InferenceEngine::make_shared_blob<int16_t>(description, (int16_t*)proto.tensor_content().data());
+            blob = blobOnContent<int16_t>(description, proto.tensor_content());
             break;
         case tensorflow::DataType::DT_INT32:
             description.setPrecision(InferenceEngine::Precision::I32);
-            blob = InferenceEngine::make_shared_blob<int32_t>(description, (int32_t*)proto.tensor_content().data());
+            blob = blobOnContent<int32_t>(description, proto.tensor_content());
+            break;
+        case tensorflow::DataType::DT_INT64:
+            description.setPrecision(InferenceEngine::Precision::I64);
+            blob = blobOnContent<int64_t>(description, proto.tensor_content());
+            break;
+        case tensorflow::DataType::DT_UINT64:
+            description.setPrecision(InferenceEngine::Precision::U64);
+            blob = blobOnContent<uint64_t>(description, proto.tensor_content());
+            break;
+        case tensorflow::DataType::DT_BOOL:
+            description.setPrecision(InferenceEngine::Precision::BOOL);
+            blob = blobOnContent<uint8_t>(description, proto.tensor_content());
             break;
         case tensorflow::DataType::DT_HALF:
+            // values packed in tensor_content, not padded as in half_val
+            description.setPrecision(InferenceEngine::Precision::FP16);
+            blob = blobOnContent<uint16_t>(description, proto.tensor_content());
+            break;
         case tensorflow::DataType::DT_UINT16:
-        case tensorflow::DataType::DT_INT64:
+            description.setPrecision(InferenceEngine::Precision::U16);
+            blob = blobOnContent<uint16_t>(description, proto.tensor_content());
+            break;
         default: {
             std::stringstream ss;
             ss << "Actual: " << TensorInfo::getDataTypeAsString(proto.dtype());
@@ -31,6 +31,8 @@ public:
         Node("request"),
         request(request) {}
 
+    void setRequest(const tensorflow::serving::PredictRequest* request) { this->request = request; }
+
     Status execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) override {
         notifyEndQueue.push(*this);
         return StatusCode::OK;
@@ -21,7 +21,10 @@ namespace ovms {
 struct ExecutingStreamIdGuard {
     ExecutingStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue) :
         inferRequestsQueue_(inferRequestsQueue),
-        id_(inferRequestsQueue_.getIdleStream().get()) {}
+        id_(inferRequestsQueue_.getIdleStream()) {}
+    ExecutingStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue, int acquiredId) :
+        inferRequestsQueue_(inferRequestsQueue),
+        id_(acquiredId) {}
     ~ExecutingStreamIdGuard() {
         inferRequestsQueue_.returnStream(id_);
     }
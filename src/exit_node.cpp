@@ -25,20 +25,46 @@
 namespace ovms {
 
 Status ExitNode::fetchResults(BlobMap&) {
-    // Serialize results to proto
+    // Serialize results to proto, outputs of dependencies which finished earlier are already serialized
     for (const auto& kv : this->inputBlobs) {
-        const auto& output_name = kv.first;
-        auto& blob = kv.second;
-        spdlog::debug("[Node: {}] Serializing response from pipeline. Output name:{}", getName(), output_name);
-        auto& proto = (*this->response->mutable_outputs())[output_name];
-        auto status = serialize(blob, proto);
+        auto status = serializeOutput(kv.first, kv.second);
         if (!status.ok()) {
             return status;
         }
+    }
+    // Blobs received from DLNodes keep their streams reserved
+    this->inputBlobs.clear();
+
+    return StatusCode::OK;
+}
 
-        spdlog::debug("[Node: {}] Serialized blob to proto: blob name {}", getName(), output_name);
+Status ExitNode::copyInputsFrom(const Node& dependency) {
+    if (!dependency.outputsReserveStream()) {
+        return StatusCode::OK;
     }
+    for (const auto& pair : this->getMappingByDependency(dependency)) {
+        auto it = this->inputBlobs.find(pair.second);
+        if (it == this->inputBlobs.end()) {
+            continue;
+        }
+        auto status = serializeOutput(it->first, it->second);
+        if (!status.ok()) {
+            return status;
+        }
+        // dropping the blob returns stream of the dependency
+        this->inputBlobs.erase(it);
+    }
+    return StatusCode::OK;
+}
 
+Status ExitNode::serializeOutput(const std::string& outputName, const InferenceEngine::Blob::Ptr& blob) {
+    spdlog::debug("[Node: {}] Serializing response from pipeline. Output name:{}", getName(), outputName);
+    auto& proto = (*this->response->mutable_outputs())[outputName];
+    auto status = serialize(blob, proto);
+    if (!status.ok()) {
+        return status;
+    }
+    spdlog::debug("[Node: {}] Serialized blob to proto: blob name {}", getName(), outputName);
     return StatusCode::OK;
 }
 
@@ -65,14 +91,21 @@ Status ExitNode::serialize(const InferenceEngine::Blob::Ptr& blob, tensorflow::T
     case InferenceEngine::Precision::I8:
         proto.set_dtype(tensorflow::DataTypeToEnum<int8_t>::value);
         break;
+    // 2 byte values packed in tensor_content, as read by TensorFlow tensor_util, not padded to 4 bytes
     case InferenceEngine::Precision::U16:
-        proto.set_dtype(tensorflow::DataTypeToEnum<uint32_t>::value);  // 2 byte padding [v1, v0, 0, 0, u1, u0, 0, 0, ...]
+        proto.set_dtype(tensorflow::DataTypeToEnum<uint16_t>::value);
         break;
     case InferenceEngine::Precision::FP16:
-        proto.set_dtype(tensorflow::DataTypeToEnum<float>::value);  // 2 byte padding [v1, v0, 0, 0, u1, u0, 0, 0, ...]
+        proto.set_dtype(tensorflow::DataType::DT_HALF);
         break;
     case InferenceEngine::Precision::I64:
-        proto.set_dtype(tensorflow::DataTypeToEnum<int32_t>::value);  // Manually tested that OV I64 = TF int32_t
+        proto.set_dtype(tensorflow::DataTypeToEnum<int64_t>::value);
+        break;
+    case InferenceEngine::Precision::U64:
+        proto.set_dtype(tensorflow::DataTypeToEnum<uint64_t>::value);
+        break;
+    case InferenceEngine::Precision::BOOL:
+        proto.set_dtype(tensorflow::DataTypeToEnum<bool>::value);
         break;
     default:
         std::stringstream ss;
@@ -84,7 +117,7 @@ Status ExitNode::serialize(const InferenceEngine::Blob::Ptr& blob, tensorflow::T
     }
 
     // Set content
-    proto.mutable_tensor_content()->assign((char*)blob->buffer(), blob->byteSize());
+    proto.mutable_tensor_content()->assign(blob->cbuffer().as<const char*>(), blob->byteSize());
 
     return StatusCode::OK;
 }
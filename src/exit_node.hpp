@@ -33,6 +33,8 @@ public:
         response(response) {
     }
 
+    void setResponse(tensorflow::serving::PredictResponse* response) { this->response = response; }
+
     // Exit node does not have execute logic.
     // It serializes its received input blobs to proto in ::fetchResults
     Status execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) override {
@@ -42,12 +44,25 @@ public:
 
     Status fetchResults(BlobMap& outputs) override;
 
+    /**
+     * @brief Serializes inputs received from dependency right away instead of copying them
+     *
+     * Response is filled from buffers of dependency outputs, so these are copied only once.
+     */
+    Status copyInputsFrom(const Node& dependency) override;
+
+    // Response holds outputs of branches which were not skipped
+    bool runsWithSkippedDependencies() const override { return true; }
+
     // Exit nodes have no dependants
     void addDependant(Node& node) override {
         throw std::logic_error("This node cannot have dependant");
     }
 
     Status serialize(const InferenceEngine::Blob::Ptr& blob, tensorflow::TensorProto& proto);
+
+private:
+    Status serializeOutput(const std::string& outputName, const InferenceEngine::Blob::Ptr& blob);
 };
 
 }  // namespace ovms
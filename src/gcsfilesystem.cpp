@@ -25,14 +25,19 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "gcsfilesystem.hpp"
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <spdlog/spdlog.h>
 
+#include "cloudfilecache.hpp"
 #include "stringutils.hpp"
 
 namespace ovms {
@@ -61,6 +66,9 @@ StatusCode GCSFileSystem::parsePath(const std::string& path,
 
 namespace {
 
+// failing requests are retried for a bounded time, so unreachable storage does not delay checks of other models
+const std::chrono::seconds RETRY_TIME_LIMIT{30};
+
 google::cloud::storage::ClientOptions createDefaultOrAnonymousClientOptions() {
     if (std::getenv("GOOGLE_APPLICATION_CREDENTIALS") == nullptr) {
         auto credentials =
@@ -86,7 +94,7 @@ google::cloud::storage::ClientOptions createDefaultOrAnonymousClientOptions() {
 }  // namespace
 
 GCSFileSystem::GCSFileSystem() :
-    client_{createDefaultOrAnonymousClientOptions()} {
+    client_{createDefaultOrAnonymousClientOptions(), gcs::LimitedTimeRetryPolicy(RETRY_TIME_LIMIT)} {
     SPDLOG_TRACE("GCSFileSystem default ctor");
 }
 
@@ -97,8 +105,41 @@ GCSFileSystem::GCSFileSystem(const gcs::v1::ClientOptions& options) :
 
 GCSFileSystem::~GCSFileSystem() { SPDLOG_TRACE("GCSFileSystem dtor"); }
 
+const ObjectListing* GCSFileSystem::getListing(const std::string& path) {
+    if (!listingAttempted_) {
+        listingAttempted_ = true;
+        std::string bucket, object;
+        if (this->parsePath(path, &bucket, &object) != StatusCode::OK) {
+            return nullptr;
+        }
+        while (!object.empty() && object.back() == '/') {
+            object.pop_back();
+        }
+        std::set<std::string> objects;
+        for (auto&& meta : client_.ListObjects(bucket, gcs::Prefix(object))) {
+            if (!meta) {
+                SPDLOG_WARN("GCS: Unable to list objects under {}, paths will be queried one by one. Error: {}", path,
+                    meta.status().message());
+                return nullptr;
+            }
+            // prefix matches also siblings sharing the name beginning
+            const auto& name = meta->name();
+            if (object.empty() || name == object || name.rfind(object + "/", 0) == 0) {
+                objects.insert(GCS_URL_PREFIX + bucket + "/" + name);
+            }
+        }
+        listing_ = std::make_unique<ObjectListing>(GCS_URL_PREFIX + bucket + "/" + object, std::move(objects));
+        SPDLOG_DEBUG("GCS: Listed {} objects under {}", listing_->size(), path);
+    }
+    return (listing_ && listing_->covers(path)) ? listing_.get() : nullptr;
+}
+
 StatusCode GCSFileSystem::fileExists(const std::string& path, bool* exists) {
     *exists = false;
+    if (auto listing = getListing(path)) {
+        *exists = listing->exists(path);
+        return StatusCode::OK;
+    }
     std::string bucket, object;
 
     auto status = this->parsePath(path, &bucket, &object);
@@ -141,6 +182,10 @@ StatusCode GCSFileSystem::isDirectory(const std::string& path,
         *is_directory = true;
         return StatusCode::OK;
     }
+    if (auto listing = getListing(path)) {
+        *is_directory = listing->isDirectory(path);
+        return StatusCode::OK;
+    }
     for (auto&& meta :
         client_.ListObjects(bucket, gcs::Prefix(appendSlash(object)))) {
         if (meta) {
@@ -155,6 +200,10 @@ StatusCode
 GCSFileSystem::getDirectoryContents(const std::string& path,
     std::set<std::string>* contents) {
     SPDLOG_TRACE("GCS: getting directory contents {}", path);
+    if (auto listing = getListing(path)) {
+        listing->getDirectoryContents(path, contents);
+        return StatusCode::OK;
+    }
     std::string bucket, directory_path, full_directory;
     auto status = this->parsePath(path, &bucket, &directory_path);
     if (status != StatusCode::OK) {
@@ -188,6 +237,10 @@ GCSFileSystem::getDirectoryContents(const std::string& path,
 StatusCode GCSFileSystem::getDirectorySubdirs(const std::string& path,
     std::set<std::string>* subdirs) {
     SPDLOG_TRACE("GCS: listing directory subdirs: {}", path);
+    if (auto listing = getListing(path)) {
+        listing->getDirectorySubdirs(path, subdirs);
+        return StatusCode::OK;
+    }
     auto status = this->getDirectoryContents(path, subdirs);
     if (status != StatusCode::OK) {
         SPDLOG_WARN("GCS: Unable to list directory subdir content {} -> {}", path,
@@ -215,6 +268,10 @@ StatusCode GCSFileSystem::getDirectorySubdirs(const std::string& path,
 StatusCode GCSFileSystem::getDirectoryFiles(const std::string& path,
     std::set<std::string>* files) {
     SPDLOG_TRACE("GCS: listing directory: {}", path);
+    if (auto listing = getListing(path)) {
+        listing->getDirectoryFiles(path, files);
+        return StatusCode::OK;
+    }
     auto status = this->getDirectoryContents(path, files);
     if (status != StatusCode::OK) {
         SPDLOG_WARN("GCS: Unable to list directory content {} -> {}", path,
@@ -261,20 +318,32 @@ StatusCode GCSFileSystem::readTextFile(const std::string& path,
         SPDLOG_WARN("GCS: Downloading file has failed: ", path);
         return StatusCode::GCS_FILE_INVALID;
     }
-    std::string data = "";
-    char c = 0;
-    while (stream.get(c)) {
-        data += c;
-    }
-    *contents = data;
+    // model weights are read this way when streaming models, so the whole buffer is consumed at once
+    contents->assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
     SPDLOG_TRACE("GCS: File {} has been downloaded (bytes={})", path,
-        data.size());
+        contents->size());
     return StatusCode::OK;
 }
 
 StatusCode GCSFileSystem::downloadFile(const std::string& remote_path,
     const std::string& local_path) {
     SPDLOG_TRACE("GCS: Saving file {} to {}", remote_path, local_path);
+    // object generation changes whenever its content is replaced
+    std::string generation;
+    auto& cache = CloudFileCache::getInstance();
+    if (cache.isEnabled()) {
+        std::string bucket, object;
+        if (this->parsePath(remote_path, &bucket, &object) == StatusCode::OK) {
+            google::cloud::StatusOr<gcs::ObjectMetadata> object_metadata =
+                client_.GetObjectMetadata(bucket, object);
+            if (object_metadata) {
+                generation = std::to_string(object_metadata->generation());
+            }
+        }
+        if (cache.fetch(remote_path, generation, local_path)) {
+            return StatusCode::OK;
+        }
+    }
     std::string contents;
     auto read_status = this->readTextFile(remote_path, &contents);
     if (read_status != StatusCode::OK) {
@@ -284,6 +353,7 @@ StatusCode GCSFileSystem::downloadFile(const std::string& remote_path,
     std::ofstream output_file(local_path.c_str(), std::ios::binary);
     output_file << contents;
     output_file.close();
+    cache.store(remote_path, generation, local_path);
     return StatusCode::OK;
 }
 
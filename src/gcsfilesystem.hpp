@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <memory>
 #include <regex>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "google/cloud/storage/client.h"
 
 #include "filesystem.hpp"
+#include "objectlisting.hpp"
 #include "status.hpp"
 
 namespace ovms {
@@ -155,11 +157,26 @@ private:
     StatusCode downloadFile(const std::string& remote_path,
         const std::string& local_path);
 
+    /**
+    * @brief Lists objects under the first queried path recursively, later queries under it are answered from the listing
+    *
+    * @param path
+    * @return listing covering the path or nullptr if path has to be queried remotely
+    */
+    const ObjectListing* getListing(const std::string& path);
+
     /**
     * @brief
     *
     */
     google::cloud::storage::Client client_;
+
+    /**
+    * @brief Listing of model base path, filesystem is created for single scan of model versions so it is not refreshed
+    *
+    */
+    std::unique_ptr<ObjectListing> listing_;
+    bool listingAttempted_ = false;
 };
 
 }  // namespace ovms
@@ -17,14 +17,17 @@
 
 #include <google/protobuf/util/json_util.h>
 
+#include "postprocessing.hpp"
+#include "requestlogging.hpp"
+
 using google::protobuf::util::JsonPrintOptions;
 using google::protobuf::util::MessageToJsonString;
 
 namespace ovms {
 
-Status GetModelMetadataImpl::getModelStatus(
+Status GetModelMetadataImpl::getAvailableInstance(
     const tensorflow::serving::GetModelMetadataRequest* request,
-    tensorflow::serving::GetModelMetadataResponse* response) {
+    std::shared_ptr<ModelInstance>& instance) {
     auto status = validate(request);
     if (!status.ok()) {
         return status;
@@ -36,24 +39,23 @@ Status GetModelMetadataImpl::getModelStatus(
 
     auto model = manager.findModelByName(name);
     if (model == nullptr) {
-        SPDLOG_INFO("model {} is  missing", name);
+        OVMS_REQUEST_DEBUG("model {} is  missing", name);
         return StatusCode::MODEL_NAME_MISSING;
     }
 
-    std::shared_ptr<ModelInstance> instance = nullptr;
     if (request->model_spec().has_version()) {
         ovms::model_version_t version = request->model_spec().version().value();
         SPDLOG_DEBUG("requested: name {}; version {}", name, version);
         instance = model->getModelInstanceByVersion(version);
         if (instance == nullptr) {
-            SPDLOG_INFO("model {}; version {} is missing", name, version);
+            OVMS_REQUEST_DEBUG("model {}; version {} is missing", name, version);
             return StatusCode::MODEL_VERSION_MISSING;
         }
     } else {
         SPDLOG_DEBUG("requested: name {}; default version", name);
         instance = model->getDefaultModelInstance();
         if (instance == nullptr) {
-            SPDLOG_INFO("model {}; default version is missing", name);
+            OVMS_REQUEST_DEBUG("model {}; default version is missing", name);
             return StatusCode::MODEL_VERSION_MISSING;
         }
     }
@@ -61,9 +63,45 @@ Status GetModelMetadataImpl::getModelStatus(
     if (ModelVersionState::AVAILABLE != instance->getStatus().getState()) {
         return StatusCode::MODEL_MISSING;
     }
+    return StatusCode::OK;
+}
 
-    buildResponse(instance, response);
+Status GetModelMetadataImpl::getModelStatus(
+    const tensorflow::serving::GetModelMetadataRequest* request,
+    tensorflow::serving::GetModelMetadataResponse* response) {
+    std::shared_ptr<ModelInstance> instance;
+    auto status = getAvailableInstance(request, instance);
+    if (!status.ok()) {
+        return status;
+    }
+    // inputs info is not read, it is rebuilt while version reloads
+    auto metadata = instance->getMetadataCache();
+    if (!metadata) {
+        OVMS_REQUEST_DEBUG("model {} is reloading", request->model_spec().name());
+        return StatusCode::MODEL_MISSING;
+    }
+    // signature is packed in Any already, copy does not walk inputs info
+    *response = metadata->response;
+    return StatusCode::OK;
+}
 
+Status GetModelMetadataImpl::getModelStatusJson(
+    const tensorflow::serving::GetModelMetadataRequest* request,
+    std::string* json) {
+    std::shared_ptr<ModelInstance> instance;
+    auto status = getAvailableInstance(request, instance);
+    if (!status.ok()) {
+        return status;
+    }
+    auto metadata = instance->getMetadataCache();
+    if (!metadata) {
+        OVMS_REQUEST_DEBUG("model {} is reloading", request->model_spec().name());
+        return StatusCode::MODEL_MISSING;
+    }
+    if (metadata->json.empty()) {
+        return StatusCode::JSON_SERIALIZATION_ERROR;
+    }
+    *json = metadata->json;
     return StatusCode::OK;
 }
 
@@ -105,21 +143,86 @@ void GetModelMetadataImpl::convert(
     }
 }
 
+void GetModelMetadataImpl::applyPostprocessing(
+    const postprocessing_map_t& postprocessing,
+    proto_signature_map_t* outputs) {
+    for (const auto& [name, info] : postprocessing) {
+        auto it = outputs->find(name);
+        if (it == outputs->end() || it->second.tensor_shape().dim_size() == 0) {
+            continue;
+        }
+        auto& scores = it->second;
+        auto* shape = scores.mutable_tensor_shape();
+        shape->mutable_dim(shape->dim_size() - 1)->set_size(info.topK);
+        const std::string indicesName = name + POSTPROCESSING_INDICES_SUFFIX;
+        auto& indices = (*outputs)[indicesName];
+        indices.set_name(indicesName);
+        indices.set_dtype(tensorflow::DataType::DT_INT32);
+        // scores reference may be invalidated by insertion of indices
+        *indices.mutable_tensor_shape() = outputs->at(name).tensor_shape();
+    }
+}
+
+void GetModelMetadataImpl::applyOutputPrecision(
+    const std::string& outputPrecision,
+    const precisions_map_t& outputPrecisions,
+    proto_signature_map_t* outputs) {
+    for (auto& [name, output] : *outputs) {
+        const std::string* precision = &outputPrecision;
+        if (outputPrecision.empty()) {
+            auto it = outputPrecisions.find(name);
+            if (it == outputPrecisions.end()) {
+                continue;
+            }
+            precision = &it->second;
+        }
+        if (output.dtype() != tensorflow::DataType::DT_FLOAT) {
+            continue;
+        }
+        if (*precision == "FP16") {
+            output.set_dtype(tensorflow::DataType::DT_HALF);
+        } else if (*precision == "BF16") {
+            output.set_dtype(tensorflow::DataType::DT_BFLOAT16);
+        }
+    }
+}
+
 void GetModelMetadataImpl::buildResponse(
     std::shared_ptr<ModelInstance> instance,
     tensorflow::serving::GetModelMetadataResponse* response) {
+    buildResponse(*instance, response);
+}
+
+void GetModelMetadataImpl::buildResponse(
+    const ModelInstance& instance,
+    tensorflow::serving::GetModelMetadataResponse* response) {
 
     response->Clear();
-    response->mutable_model_spec()->set_name(instance->getName());
-    response->mutable_model_spec()->mutable_version()->set_value(instance->getVersion());
+    response->mutable_model_spec()->set_name(instance.getName());
+    response->mutable_model_spec()->mutable_version()->set_value(instance.getVersion());
 
     tensorflow::serving::SignatureDefMap def;
-    convert(instance->getInputsInfo(), ((*def.mutable_signature_def())["serving_default"]).mutable_inputs());
-    convert(instance->getOutputsInfo(), ((*def.mutable_signature_def())["serving_default"]).mutable_outputs());
+    convert(instance.getInputsInfo(), ((*def.mutable_signature_def())["serving_default"]).mutable_inputs());
+    convert(instance.getOutputsInfo(), ((*def.mutable_signature_def())["serving_default"]).mutable_outputs());
+    // outputs as sent in responses, after postprocessing and precision conversion
+    const auto& config = instance.getModelConfig();
+    auto* outputs = ((*def.mutable_signature_def())["serving_default"]).mutable_outputs();
+    applyPostprocessing(config.getPostprocessing(), outputs);
+    applyOutputPrecision(config.getOutputPrecision(), config.getOutputPrecisions(), outputs);
 
     (*response->mutable_metadata())["signature_def"].PackFrom(def);
 }
 
+std::shared_ptr<const ModelMetadataCache> GetModelMetadataImpl::buildMetadataCache(const ModelInstance& instance) {
+    auto metadata = std::make_shared<ModelMetadataCache>();
+    buildResponse(instance, &metadata->response);
+    // gRPC response is served even if JSON for REST API could not be built
+    if (!serializeResponse2Json(&metadata->response, &metadata->json).ok()) {
+        metadata->json.clear();
+    }
+    return metadata;
+}
+
 Status GetModelMetadataImpl::createGrpcRequest(std::string model_name, std::optional<int64_t> model_version, tensorflow::serving::GetModelMetadataRequest* request) {
     request->mutable_model_spec()->set_name(model_name);
     if (model_version.has_value()) {
@@ -28,6 +28,16 @@ namespace ovms {
 
 using proto_signature_map_t = google::protobuf::Map<std::string, tensorflow::TensorInfo>;
 
+/**
+ * @brief Metadata response of a model version and its JSON for REST API, built once when the version is loaded
+ *
+ * JSON is empty if response could not be serialized.
+ */
+struct ModelMetadataCache {
+    tensorflow::serving::GetModelMetadataResponse response;
+    std::string json;
+};
+
 class GetModelMetadataImpl {
 public:
     static Status validate(
@@ -37,15 +47,53 @@ public:
         const tensor_map_t& from,
         proto_signature_map_t* to);
 
+    /**
+     * @brief Reports outputs as served after postprocessing, top K scores in the last dimension and their indices output
+     */
+    static void applyPostprocessing(
+        const postprocessing_map_t& postprocessing,
+        proto_signature_map_t* outputs);
+
+    /**
+     * @brief Reports FP32 outputs converted to response precision as DT_HALF or DT_BFLOAT16
+     */
+    static void applyOutputPrecision(
+        const std::string& outputPrecision,
+        const precisions_map_t& outputPrecisions,
+        proto_signature_map_t* outputs);
+
     static void buildResponse(
         std::shared_ptr<ModelInstance> instance,
         tensorflow::serving::GetModelMetadataResponse* response);
 
+    static void buildResponse(
+        const ModelInstance& instance,
+        tensorflow::serving::GetModelMetadataResponse* response);
+
+    /**
+     * @brief Builds metadata response and its JSON of loaded model version
+     *
+     * @return metadata or nullptr if JSON serialization failed, then responses are built on each request
+     */
+    static std::shared_ptr<const ModelMetadataCache> buildMetadataCache(const ModelInstance& instance);
+
     static Status getModelStatus(
         const tensorflow::serving::GetModelMetadataRequest* request,
         tensorflow::serving::GetModelMetadataResponse* response);
+
+    /**
+     * @brief Gets metadata response serialized to JSON, served from metadata built when model was loaded
+     */
+    static Status getModelStatusJson(
+        const tensorflow::serving::GetModelMetadataRequest* request,
+        std::string* json);
     static Status createGrpcRequest(std::string model_name, std::optional<int64_t> model_version, tensorflow::serving::GetModelMetadataRequest* request);
     static Status serializeResponse2Json(const tensorflow::serving::GetModelMetadataResponse* response, std::string* output);
+
+private:
+    static Status getAvailableInstance(
+        const tensorflow::serving::GetModelMetadataRequest* request,
+        std::shared_ptr<ModelInstance>& instance);
 };
 
 }  // namespace ovms
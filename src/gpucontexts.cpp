@@ -0,0 +1,92 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "gpucontexts.hpp"
+
+#include <cctype>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+bool GpuContexts::isGpuDevice(const std::string& device) {
+    const std::string prefix = "GPU";
+    if (device.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    if (device.size() == prefix.size()) {
+        return true;
+    }
+    if (device[prefix.size()] != '.' || device.size() == prefix.size() + 1) {
+        return false;
+    }
+    for (size_t i = prefix.size() + 1; i < device.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(device[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+InferenceEngine::RemoteContext::Ptr GpuContexts::get(const std::string& device) {
+    if (!isGpuDevice(device)) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = contexts.find(device);
+    if (it != contexts.end()) {
+        return it->second;
+    }
+    try {
+        if (!engine) {
+            engine = std::make_unique<InferenceEngine::Core>();
+        }
+        auto context = engine->GetDefaultContext(device);
+        contexts.emplace(device, context);
+        spdlog::info("Created shared context of device: {}", device);
+        return context;
+    } catch (std::exception& e) {
+        spdlog::error("Cannot create shared context of device: {}; error: {}", device, e.what());
+        return nullptr;
+    }
+}
+
+InferenceEngine::Core& GpuContexts::getContextsCore(const InferenceEngine::RemoteContext::Ptr& context) {
+    InferenceEngine::Core* core = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        core = engine.get();
+    }
+    if (core == nullptr || context == nullptr) {
+        throw std::logic_error("No shared GPU context created");
+    }
+    // Core is not released once created, compilation does not hold the lock
+    return *core;
+}
+
+InferenceEngine::ExecutableNetwork GpuContexts::loadNetwork(const InferenceEngine::CNNNetwork& network,
+    const InferenceEngine::RemoteContext::Ptr& context,
+    const std::map<std::string, std::string>& pluginConfig) {
+    return getContextsCore(context).LoadNetwork(network, context, pluginConfig);
+}
+
+InferenceEngine::ExecutableNetwork GpuContexts::importNetwork(std::istream& blob,
+    const InferenceEngine::RemoteContext::Ptr& context,
+    const std::map<std::string, std::string>& pluginConfig) {
+    return getContextsCore(context).ImportNetwork(blob, context, pluginConfig);
+}
+
+}  // namespace ovms
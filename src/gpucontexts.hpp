@@ -0,0 +1,80 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <inference_engine.hpp>
+
+namespace ovms {
+
+/**
+ * @brief Remote contexts of GPU devices shared by models loaded with shared GPU context
+ *
+ * Networks compiled in one context use the same device memory, so blobs produced by one model are inputs
+ * of another without copying them through host memory.
+ */
+class GpuContexts {
+public:
+    static GpuContexts& getInstance() {
+        static GpuContexts instance;
+        return instance;
+    }
+
+    /**
+     * @brief Checks if device name targets single GPU, e.g. "GPU" or "GPU.1"
+     */
+    static bool isGpuDevice(const std::string& device);
+
+    /**
+     * @brief Gets context of the device, created on first use
+     *
+     * @return context or nullptr if device is not GPU or plugin cannot create context
+     */
+    InferenceEngine::RemoteContext::Ptr get(const std::string& device);
+
+    /**
+     * @brief Compiles network in context returned by get, with the Core that created the context
+     *
+     * Contexts belong to the plugin of the Core creating them, networks of models loaded by their own Core are not compiled in them.
+     */
+    InferenceEngine::ExecutableNetwork loadNetwork(const InferenceEngine::CNNNetwork& network,
+        const InferenceEngine::RemoteContext::Ptr& context,
+        const std::map<std::string, std::string>& pluginConfig);
+
+    /**
+     * @brief Imports network exported from context returned by get, with the Core that created the context
+     */
+    InferenceEngine::ExecutableNetwork importNetwork(std::istream& blob,
+        const InferenceEngine::RemoteContext::Ptr& context,
+        const std::map<std::string, std::string>& pluginConfig);
+
+private:
+    GpuContexts() = default;
+
+    InferenceEngine::Core& getContextsCore(const InferenceEngine::RemoteContext::Ptr& context);
+
+    std::mutex mtx;
+    // plugin owning the contexts and compiling networks in them, networks of models keep their contexts alive
+    std::unique_ptr<InferenceEngine::Core> engine;
+    std::map<std::string, InferenceEngine::RemoteContext::Ptr> contexts;
+};
+
+}  // namespace ovms
@@ -0,0 +1,116 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ovms {
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/**
+ * @brief Updates 64 bit FNV-1a hash with data, hash should start from FNV_OFFSET_BASIS
+ */
+inline void fnv1a(uint64_t& hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+}
+
+namespace xxhash64_detail {
+const uint64_t PRIME1 = 11400714785074694791ULL;
+const uint64_t PRIME2 = 14029467366897019727ULL;
+const uint64_t PRIME3 = 1609587929392839161ULL;
+const uint64_t PRIME4 = 9650029242287828579ULL;
+const uint64_t PRIME5 = 2870177450012600261ULL;
+
+inline uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t read64(const char* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32_t read32(const char* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64_t mixRound(uint64_t acc, uint64_t input) {
+    return rotl(acc + input * PRIME2, 31) * PRIME1;
+}
+
+inline uint64_t mergeRound(uint64_t acc, uint64_t value) {
+    return (acc ^ mixRound(0, value)) * PRIME1 + PRIME4;
+}
+}  // namespace xxhash64_detail
+
+/**
+ * @brief 64 bit xxHash (XXH64) of data, reads 8 bytes at a time so it is suited for tensor contents
+ *
+ * Hash of several buffers is computed by passing hash of the previous one as seed of the next.
+ */
+inline uint64_t xxhash64(const char* data, size_t size, uint64_t seed = 0) {
+    using namespace xxhash64_detail;
+    const char* end = data + size;
+    uint64_t hash;
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        for (; data + 32 <= end; data += 32) {
+            v1 = mixRound(v1, read64(data));
+            v2 = mixRound(v2, read64(data + 8));
+            v3 = mixRound(v3, read64(data + 16));
+            v4 = mixRound(v4, read64(data + 24));
+        }
+        hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = seed + PRIME5;
+    }
+    hash += static_cast<uint64_t>(size);
+    for (; data + 8 <= end; data += 8) {
+        hash = rotl(hash ^ mixRound(0, read64(data)), 27) * PRIME1 + PRIME4;
+    }
+    if (data + 4 <= end) {
+        hash = rotl(hash ^ (static_cast<uint64_t>(read32(data)) * PRIME1), 23) * PRIME2 + PRIME3;
+        data += 4;
+    }
+    for (; data < end; ++data) {
+        hash = rotl(hash ^ (static_cast<unsigned char>(*data) * PRIME5), 11) * PRIME1;
+    }
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+}  // namespace ovms
@@ -0,0 +1,113 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "hedging.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+HedgingPolicy::~HedgingPolicy() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMtx);
+        stopping = true;
+    }
+    attemptPending.notify_all();
+    if (releaseThread.joinable()) {
+        releaseThread.join();
+    }
+}
+
+void HedgingPolicy::recordLatency(std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> lock(latencyMtx);
+    if (latencies.size() < HEDGING_LATENCY_WINDOW) {
+        latencies.push_back(latency.count());
+    } else {
+        latencies[nextLatency] = latency.count();
+        nextLatency = (nextLatency + 1) % HEDGING_LATENCY_WINDOW;
+    }
+    if (latencies.size() < HEDGING_MIN_SAMPLES || ++recordedSinceRecompute < HEDGING_RECOMPUTE_INTERVAL) {
+        return;
+    }
+    recordedSinceRecompute = 0;
+    std::vector<int64_t> sorted(latencies);
+    const size_t rank = std::min(sorted.size() - 1, sorted.size() * percentile / 100);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    hedgeDelayMicroseconds.store(sorted[rank], std::memory_order_relaxed);
+}
+
+std::optional<std::chrono::microseconds> HedgingPolicy::getHedgeDelay() const {
+    const int64_t delay = hedgeDelayMicroseconds.load(std::memory_order_relaxed);
+    if (delay < 0) {
+        return std::nullopt;
+    }
+    return std::chrono::microseconds(delay);
+}
+
+void HedgingPolicy::recordRequest() {
+    std::lock_guard<std::mutex> lock(budgetMtx);
+    budget = std::min<uint64_t>(HEDGING_BUDGET_BURST * 100, budget + budgetPercent);
+}
+
+bool HedgingPolicy::tryStartHedge() {
+    std::lock_guard<std::mutex> lock(budgetMtx);
+    if (budget < 100) {
+        return false;
+    }
+    budget -= 100;
+    return true;
+}
+
+void HedgingPolicy::releaseWhenCompleted(PendingAttempt attempt) {
+    std::lock_guard<std::mutex> lock(pendingMtx);
+    if (!releaseThread.joinable()) {
+        releaseThread = std::thread([this]() { releasePendingAttempts(); });
+    }
+    pendingAttempts.push_back(std::move(attempt));
+    attemptPending.notify_one();
+}
+
+void HedgingPolicy::releasePendingAttempts() {
+    std::unique_lock<std::mutex> lock(pendingMtx);
+    while (true) {
+        attemptPending.wait(lock, [this]() { return stopping || !pendingAttempts.empty(); });
+        if (pendingAttempts.empty()) {
+            return;
+        }
+        auto attempt = std::move(pendingAttempts.front());
+        pendingAttempts.pop_front();
+        lock.unlock();
+        auto sts = InferenceEngine::StatusCode::GENERAL_ERROR;
+        try {
+            sts = attempt.inferRequest->Wait(InferenceEngine::IInferRequest::RESULT_READY);
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            SPDLOG_DEBUG("Abandoned hedged inference failed: {}", e.what());
+        }
+        if (sts == InferenceEngine::StatusCode::OK && attempt.inferRequestsQueue != nullptr) {
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - attempt.started);
+            attempt.inferRequestsQueue->recordInferenceLatency(latency);
+            recordLatency(latency);
+        }
+        attempt.executingStreamIdGuard.reset();
+        attempt.fairShareSlotGuard.reset();
+        attempt.modelUnloadGuard.reset();
+        lock.lock();
+    }
+}
+
+}  // namespace ovms
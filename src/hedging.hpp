@@ -0,0 +1,123 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "executinstreamidguard.hpp"
+#include "modelinstanceunloadguard.hpp"
+#include "tenantscheduling.hpp"
+
+namespace ovms {
+
+const size_t HEDGING_LATENCY_WINDOW = 1024;
+// hedge delay is not known before this many inferences are measured
+const size_t HEDGING_MIN_SAMPLES = 100;
+const size_t HEDGING_RECOMPUTE_INTERVAL = 32;
+// hedges which may be started in a row after a quiet period
+const uint32_t HEDGING_BUDGET_BURST = 10;
+
+/**
+ * @brief Decides when a predict request of a model version is sent to a second infer request
+ *
+ * Request which has not finished after the configured percentile of recent inference latencies is hedged
+ * if the budget allows, every request earns budgetPercent / 100 of a hedge, so hedges cannot more than double the load.
+ * Started inferences cannot be cancelled, the losing one runs to completion and its infer request is returned by
+ * a helper thread.
+ */
+class HedgingPolicy {
+public:
+    /**
+     * @brief Infer request abandoned by finished predict request, returned to its queue once its inference completes
+     */
+    struct PendingAttempt {
+        InferenceEngine::InferRequest* inferRequest = nullptr;
+        std::unique_ptr<ExecutingStreamIdGuard> executingStreamIdGuard;
+        // model version is not unloaded while abandoned inference runs
+        std::unique_ptr<ModelInstanceUnloadGuard> modelUnloadGuard;
+        // slot of tenant fair share is taken until abandoned inference completes, null if tenants are not scheduled
+        std::unique_ptr<FairShareSlotGuard> fairShareSlotGuard;
+        // latency of completed abandoned inference is recorded in its queue and policy, slow attempts are not left out
+        OVInferRequestsQueue* inferRequestsQueue = nullptr;
+        std::chrono::steady_clock::time_point started;
+    };
+
+    HedgingPolicy(uint32_t percentile, uint32_t budgetPercent) :
+        percentile(percentile),
+        budgetPercent(budgetPercent) {}
+
+    ~HedgingPolicy();
+
+    void recordLatency(std::chrono::microseconds latency);
+
+    /**
+     * @brief Get time after which running inference is hedged
+     *
+     * @return delay or nullopt until enough inferences are measured
+     */
+    std::optional<std::chrono::microseconds> getHedgeDelay() const;
+
+    /**
+     * @brief Adds budget earned by a predict request
+     */
+    void recordRequest();
+
+    /**
+     * @brief Spends budget of one hedge
+     *
+     * @return false if budget is exhausted
+     */
+    bool tryStartHedge();
+
+    /**
+     * @brief Returns infer request of the attempt after its inference completes
+     */
+    void releaseWhenCompleted(PendingAttempt attempt);
+
+private:
+    void releasePendingAttempts();
+
+    const uint32_t percentile;
+    const uint32_t budgetPercent;
+
+    mutable std::mutex latencyMtx;
+    std::vector<int64_t> latencies;
+    size_t nextLatency = 0;
+    size_t recordedSinceRecompute = 0;
+    std::atomic<int64_t> hedgeDelayMicroseconds{-1};
+
+    std::mutex budgetMtx;
+    // in percents of a hedge
+    uint64_t budget = 0;
+
+    std::mutex pendingMtx;
+    std::condition_variable attemptPending;
+    std::deque<PendingAttempt> pendingAttempts;
+    std::thread releaseThread;
+    bool stopping = false;
+};
+
+}  // namespace ovms
@@ -15,22 +15,41 @@
 //*****************************************************************************
 #include "http_rest_api_handler.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include <rapidjson/document.h>
 #include <spdlog/spdlog.h>
 
+#include "batchjobs.hpp"
 #include "get_model_metadata_impl.hpp"
+#include "metrics.hpp"
 #include "model_service.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "prediction_service_utils.hpp"
+#include "requestarena.hpp"
+#include "requestdeadline.hpp"
+#include "requestlogging.hpp"
+#include "requesttiming.hpp"
+#include "rest_batch.hpp"
+#include "rest_binary_parser.hpp"
 #include "rest_parser.hpp"
 #include "rest_utils.hpp"
+#include "samplingprofiler.hpp"
+#include "sequencemanager.hpp"
+#include "sharedmemory.hpp"
+#include "tenantscheduling.hpp"
 
-#define DEBUG
 #include "timer.hpp"
 
 using tensorflow::serving::PredictRequest;
@@ -38,50 +57,138 @@ using tensorflow::serving::PredictResponse;
 
 namespace ovms {
 
-const std::string HttpRestApiHandler::kPathRegexExp = R"((.?)\/v1\/models\/.*)";
-const std::string HttpRestApiHandler::predictionRegexExp =
-    R"((.?)\/v1\/models\/([^\/:]+)(?:(?:\/versions\/(\d+))|(?:\/labels\/(\w+)))?:(classify|regress|predict))";
-const std::string HttpRestApiHandler::modelstatusRegexExp =
-    R"((.?)\/v1\/models(?:\/([^\/:]+))?(?:(?:\/versions\/(\d+))|(?:\/labels\/(\w+)))?(?:\/(metadata))?)";
+namespace {
+
+/**
+ * @brief Parses request body into proto allocated on the arena
+ *
+ * @param jsonParser parser of JSON body, constructed with the same arena
+ * @param requestProto set to parsed proto owned by the arena
+ */
+Status parsePredictRequestBody(const std::string& request, const std::optional<size_t>& binaryHeaderLength, RestParser& jsonParser, google::protobuf::Arena* arena,
+    PredictRequest*& requestProto, Order& requestOrder, RequestTiming* timing) {
+    enum : size_t { PARSE, TIMER_END };
+    Timer<TIMER_END> timer;
+    timer.start(PARSE);
+    if (binaryHeaderLength.has_value()) {
+        RestBinaryParser binaryParser(arena);
+        auto status = binaryParser.parse(request, binaryHeaderLength.value());
+        if (!status.ok()) {
+            return status;
+        }
+        requestProto = &binaryParser.getProto();
+        requestOrder = binaryParser.getOrder();
+    } else {
+        auto status = jsonParser.parse(request.c_str());
+        if (!status.ok()) {
+            return status;
+        }
+        requestProto = &jsonParser.getProto();
+        requestOrder = jsonParser.getOrder();
+    }
+    timer.stop(PARSE);
+    static Histogram& duration = MetricsRegistry::getInstance().histogram("ovms_rest_predict_stage_duration_seconds",
+        "Duration of REST predict request stages", {{"stage", "parse"}}, MetricsRegistry::LATENCY_BUCKETS_SECONDS);
+    duration.observe(timer.elapsedSeconds(PARSE));
+    if (timing != nullptr) {
+        timing->add("parse", timer.elapsed<std::chrono::milliseconds>(PARSE));
+    }
+    OVMS_REQUEST_DEBUG("{} request parsing time: {} ms", binaryHeaderLength.has_value() ? "Binary" : "JSON", timer.elapsed<std::chrono::milliseconds>(PARSE));
+    return StatusCode::OK;
+}
+
+/**
+ * @brief Parses query string of profiling requests, parameters are initialized with defaults of accepted names
+ */
+Status parseProfilingQuery(const std::string& query, std::map<std::string, uint>& parameters) {
+    std::stringstream stream(query);
+    std::string parameter;
+    while (std::getline(stream, parameter, '&')) {
+        auto separator = parameter.find('=');
+        if (separator == std::string::npos) {
+            return StatusCode::PROFILER_INVALID_PARAMETERS;
+        }
+        auto it = parameters.find(parameter.substr(0, separator));
+        auto value = parameter.substr(separator + 1);
+        if (it == parameters.end() || value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos) {
+            return StatusCode::PROFILER_INVALID_PARAMETERS;
+        }
+        it->second = static_cast<uint>(std::stoul(value));
+    }
+    return StatusCode::OK;
+}
+
+// at most this many threads, the calling one included, process requests of one batch
+const size_t MAX_BATCH_PREDICT_THREADS = 16;
+
+/**
+ * @brief Requests of batch predict, shared with scheduled tasks which may start after the batch is completed
+ */
+struct BatchPredictState {
+    std::vector<BatchPredictItem> items;
+    std::vector<Status> statuses;
+    std::vector<std::string> responses;
+    std::atomic<size_t> next{0};
+    std::mutex mtx;
+    std::condition_variable completed;
+    size_t completedCount = 0;
+};
+
+}  // namespace
 
 Status HttpRestApiHandler::validateUrlAndMethod(
     const std::string_view http_method,
-    const std::string& request_path,
-    std::smatch* sm) {
+    const RestRouteMatch& match) {
 
     if (http_method != "POST" && http_method != "GET") {
         return StatusCode::REST_UNSUPPORTED_METHOD;
     }
-
-    if (!std::regex_match(request_path, *sm, sanityRegex)) {
-        return StatusCode::REST_INVALID_URL;
-    }
-
+    const bool statusRoute = match.route == RestRoute::MODEL_STATUS || match.route == RestRoute::MODEL_METADATA;
     if (http_method == "POST") {
-        if (std::regex_match(request_path, *sm, predictionRegex)) {
+        if (match.route == RestRoute::PREDICT) {
             return StatusCode::OK;
-        } else if (std::regex_match(request_path, *sm, modelstatusRegex)) {
+        } else if (statusRoute) {
             return StatusCode::REST_UNSUPPORTED_METHOD;
         }
     } else if (http_method == "GET") {
-        if (std::regex_match(request_path, *sm, modelstatusRegex)) {
+        if (statusRoute) {
             return StatusCode::OK;
-        } else if (std::regex_match(request_path, *sm, predictionRegex)) {
+        } else if (match.route == RestRoute::PREDICT) {
             return StatusCode::REST_UNSUPPORTED_METHOD;
         }
     }
     return StatusCode::REST_INVALID_URL;
 }
 
-Status HttpRestApiHandler::parseModelVersion(std::string& model_version_str, std::optional<int64_t>& model_version) {
-    if (!model_version_str.empty()) {
-        try {
-            model_version = std::atol(model_version_str.c_str());
-        } catch (std::exception& e) {
-            spdlog::error("Couldn't parse model version {}", model_version_str);
+Status HttpRestApiHandler::parseModelVersion(const std::string_view model_version_str, std::optional<int64_t>& model_version) {
+    if (model_version_str.empty()) {
+        return StatusCode::OK;
+    }
+    int64_t version = 0;
+    for (char c : model_version_str) {
+        if (c < '0' || c > '9' || version > (std::numeric_limits<int64_t>::max() - (c - '0')) / 10) {
+            spdlog::error("Couldn't parse model version {}", std::string(model_version_str));
             return StatusCode::REST_COULD_NOT_PARSE_VERSION;
         }
+        version = version * 10 + (c - '0');
     }
+    model_version = version;
+    return StatusCode::OK;
+}
+
+Status HttpRestApiHandler::parseInferenceHeaderContentLength(const std::string_view value, std::optional<size_t>& binaryHeaderLength) {
+    size_t length = 0;
+    if (value.empty() || value.size() > 19) {
+        return StatusCode::REST_BINARY_HEADER_INVALID;
+    }
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            spdlog::error("Couldn't parse {} header value {}", RestBinaryParser::INFERENCE_HEADER_CONTENT_LENGTH, std::string(value));
+            return StatusCode::REST_BINARY_HEADER_INVALID;
+        }
+        length = length * 10 + (c - '0');
+    }
+    binaryHeaderLength = length;
     return StatusCode::OK;
 }
 
@@ -94,7 +201,8 @@ Status HttpRestApiHandler::dispatchToProcessor(
     if (request_components.http_method == "POST") {
         if (request_components.processing_method == "predict") {
             return processPredictRequest(request_components.model_name, request_components.model_version,
-                request_components.model_version_label, request_body, response);
+                request_components.model_version_label, request_body, response, request_components.inference_header_content_length,
+                request_components.timing, request_components.deadline, request_components.priority, request_components.tenant);
         } else {
             spdlog::error("Requested REST resource {} not found", std::string(request_path));
             return StatusCode::REST_NOT_FOUND;
@@ -116,11 +224,63 @@ Status HttpRestApiHandler::processRequest(
     const std::string_view request_path,
     const std::string& request_body,
     std::vector<std::pair<std::string, std::string>>* headers,
-    std::string* response) {
-
-    std::smatch sm;
-    std::string request_path_str(request_path);
-    auto status = validateUrlAndMethod(http_method, request_path_str, &sm);
+    std::string* response,
+    const std::optional<std::string_view>& inferenceHeaderContentLength,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant) {
+
+    RestRouteMatch match;
+    matchRestRoute(request_path, match);
+    if (http_method == "GET" && match.route == RestRoute::HEALTH) {
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "application/json"});
+        return processHealthRequest(std::string(match.probe), response);
+    }
+    if (http_method == "GET" && match.route == RestRoute::METRICS) {
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "text/plain; version=0.0.4"});
+        return processMetricsRequest(response);
+    }
+    if (profilingEnabled && http_method == "GET" && match.route == RestRoute::PROFILE) {
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "text/plain"});
+        return processProfileRequest(std::string(match.query), response);
+    }
+    if (profilingEnabled && http_method == "GET" && match.route == RestRoute::PERF_COUNTERS) {
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "application/json"});
+        std::optional<int64_t> modelVersion;
+        auto status = parseModelVersion(match.modelVersion.value_or(""), modelVersion);
+        if (!status.ok()) {
+            return status;
+        }
+        return processPerfCountersRequest(std::string(match.modelName), modelVersion, std::string(match.query), response);
+    }
+    if (http_method == "POST" && match.route == RestRoute::BATCH_PREDICT) {
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "application/json"});
+        return processBatchPredictRequest(request_body, response, deadline, priority, tenant);
+    }
+    if (match.route == RestRoute::SHARED_MEMORY) {
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "application/json"});
+        return processSharedMemoryRequest(http_method, std::string(match.regionName), match.regionAction, request_body, response);
+    }
+    if (match.route == RestRoute::JOBS) {
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "application/json"});
+        return processJobsRequest(http_method, match.jobId, match.jobAction, request_body, response);
+    }
+    auto status = validateUrlAndMethod(http_method, match);
     if (!status.ok()) {
         return status;
     }
@@ -131,21 +291,26 @@ Status HttpRestApiHandler::processRequest(
 
     HttpRequestComponents requestComponents;
     requestComponents.http_method = http_method;
-
-    requestComponents.model_name = sm[2];
-    std::string model_version_str = sm[3];
-    std::string model_version_label_str = sm[4];
-    if (requestComponents.http_method == "POST")
-        requestComponents.processing_method = sm[5];
-    else
-        requestComponents.model_subresource = sm[5];
-
-    status = parseModelVersion(model_version_str, requestComponents.model_version);
+    requestComponents.timing = timing;
+    requestComponents.deadline = deadline;
+    requestComponents.priority = priority;
+    requestComponents.tenant = tenant;
+
+    requestComponents.model_name = std::string(match.modelName);
+    if (match.route == RestRoute::PREDICT)
+        requestComponents.processing_method = std::string(match.processingMethod);
+    else if (match.route == RestRoute::MODEL_METADATA)
+        requestComponents.model_subresource = "metadata";
+
+    status = parseModelVersion(match.modelVersion.value_or(""), requestComponents.model_version);
     if (!status.ok())
         return status;
 
-    if (!model_version_label_str.empty()) {
-        requestComponents.model_version_label = model_version_label_str;
+    requestComponents.model_version_label = match.modelVersionLabel;
+    if (inferenceHeaderContentLength.has_value()) {
+        status = parseInferenceHeaderContentLength(inferenceHeaderContentLength.value(), requestComponents.inference_header_content_length);
+        if (!status.ok())
+            return status;
     }
     return dispatchToProcessor(request_path, request_body, response, requestComponents);
 }
@@ -155,48 +320,103 @@ Status HttpRestApiHandler::processPredictRequest(
     const std::optional<int64_t>& modelVersion,
     const std::optional<std::string_view>& modelVersionLabel,
     const std::string& request,
-    std::string* response) {
+    std::string* response,
+    const std::optional<size_t>& binaryHeaderLength,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant) {
     // model_version_label currently is not in use
 
-    Timer timer;
-    timer.start("total");
-    using std::chrono::microseconds;
+    enum : size_t { TOTAL, TIMER_END };
+    Timer<TIMER_END> timer;
+    timer.start(TOTAL);
+    static Histogram& duration = MetricsRegistry::getInstance().histogram("ovms_predict_duration_seconds",
+        "Duration of successful predict requests", {{"api", "rest"}}, MetricsRegistry::LATENCY_BUCKETS_SECONDS);
 
-    spdlog::debug("Processing REST request for model: {}; version: {}",
+    OVMS_REQUEST_DEBUG("Processing REST request for model: {}; version: {}",
         modelName, modelVersion.value_or(0));
 
+    Status status = Tenants::getInstance().admit(tenant);
+    if (!status.ok())
+        return status;
     ModelManager& modelManager = ModelManager::getInstance();
     Order requestOrder;
-    tensorflow::serving::PredictResponse responseProto;
-    Status status;
+    // request and response protos are released together once response is written
+    RequestArena arena;
+    auto& responseProto = *google::protobuf::Arena::CreateMessage<tensorflow::serving::PredictResponse>(arena.get());
 
     if (modelManager.modelExists(modelName)) {
-        SPDLOG_INFO("Found model with name: {}. Searching for requested version...", modelName);
-        status = processSingleModelRequest(modelName, modelVersion, request, requestOrder, responseProto);
+        OVMS_REQUEST_DEBUG("Found model with name: {}. Searching for requested version...", modelName);
+        status = processSingleModelRequest(modelName, modelVersion, request, binaryHeaderLength, requestOrder, responseProto, timing, deadline, priority, tenant);
     } else if (modelManager.pipelineDefinitionExists(modelName)) {
-        SPDLOG_INFO("Found pipeline with name: {}", modelName);
-        status = processPipelineRequest(modelName, request, requestOrder, responseProto);
+        OVMS_REQUEST_DEBUG("Found pipeline with name: {}", modelName);
+        status = processPipelineRequest(modelName, request, binaryHeaderLength, requestOrder, responseProto, timing, deadline);
     } else {
-        SPDLOG_INFO("Model or pipeline matching request parameters not found - name: {}, version: {}", modelName, modelVersion.value_or(0));
+        OVMS_REQUEST_DEBUG("Model or pipeline matching request parameters not found - name: {}, version: {}", modelName, modelVersion.value_or(0));
         status = StatusCode::MODEL_NAME_MISSING;
     }
     if (!status.ok())
         return status;
 
-    status = makeJsonFromPredictResponse(responseProto, response, requestOrder);
+    status = makeJsonFromPredictResponse(responseProto, response, requestOrder, timing);
     if (!status.ok())
         return status;
 
-    timer.stop("total");
-    spdlog::debug("Total REST request processing time: {} ms", timer.elapsed<std::chrono::microseconds>("total") / 1000);
+    timer.stop(TOTAL);
+    duration.observe(timer.elapsedSeconds(TOTAL));
+    OVMS_REQUEST_DEBUG("Total REST request processing time: {} ms", timer.elapsed<std::chrono::milliseconds>(TOTAL));
+    return StatusCode::OK;
+}
+
+Status HttpRestApiHandler::processBatchPredictRequest(const std::string& request, std::string* response, const RequestDeadline* deadline,
+    RequestPriority priority, const std::string& tenant) {
+    std::vector<BatchPredictItem> items;
+    auto status = parseBatchPredictRequest(request, items);
+    if (!status.ok()) {
+        return status;
+    }
+    OVMS_REQUEST_DEBUG("Processing REST batch of {} predict requests", items.size());
+    auto state = std::make_shared<BatchPredictState>();
+    state->items = std::move(items);
+    state->statuses.resize(state->items.size());
+    state->responses.resize(state->items.size());
+    // deadline is read only while the calling thread waits for taken requests, tasks starting later find no requests left
+    auto processItems = [this, state, deadline, priority, tenant]() {
+        for (size_t i = state->next++; i < state->items.size(); i = state->next++) {
+            const auto& item = state->items[i];
+            state->statuses[i] = processPredictRequest(item.modelName, item.modelVersion, std::nullopt, item.body, &state->responses[i], std::nullopt, nullptr,
+                deadline, priority, tenant);
+            std::lock_guard<std::mutex> lock(state->mtx);
+            if (++state->completedCount == state->items.size()) {
+                state->completed.notify_one();
+            }
+        }
+    };
+    if (scheduler) {
+        for (size_t i = 1; i < std::min(state->items.size(), MAX_BATCH_PREDICT_THREADS); ++i) {
+            scheduler(processItems);
+        }
+    }
+    // calling thread takes requests as well, so batch completes even if server threads are all busy
+    processItems();
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->completed.wait(lock, [&state]() { return state->completedCount == state->items.size(); });
+    lock.unlock();
+    writeBatchPredictResponse(state->statuses, state->responses, *response);
     return StatusCode::OK;
 }
 
 Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelName,
     const std::optional<int64_t>& modelVersion,
     const std::string& request,
+    const std::optional<size_t>& binaryHeaderLength,
     Order& requestOrder,
-    tensorflow::serving::PredictResponse& responseProto) {
+    tensorflow::serving::PredictResponse& responseProto,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant) {
 
     std::shared_ptr<ModelInstance> modelInstance;
     std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
@@ -208,54 +428,59 @@ Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelNam
         modelInstanceUnloadGuard);
 
     if (!status.ok()) {
-        SPDLOG_INFO("Requested model instance - name: {}, version: {} - does not exist.", modelName, modelVersion.value_or(0));
+        OVMS_REQUEST_DEBUG("Requested model instance - name: {}, version: {} - does not exist.", modelName, modelVersion.value_or(0));
         return status;
     }
-    Timer timer;
-    timer.start("parse");
-    RestParser requestParser(modelInstance->getInputsInfo());
-    status = requestParser.parse(request.c_str());
+    google::protobuf::Arena* arena = responseProto.GetArena();
+    RestParser requestParser(modelInstance->getInputsInfo(), arena);
+    PredictRequest* requestProto = nullptr;
+    status = parsePredictRequestBody(request, binaryHeaderLength, requestParser, arena, requestProto, requestOrder, timing);
     if (!status.ok()) {
         return status;
     }
-    requestOrder = requestParser.getOrder();
-    timer.stop("parse");
-    spdlog::debug("JSON request parsing time: {} ms", timer.elapsed<std::chrono::microseconds>("parse") / 1000);
-
-    tensorflow::serving::PredictRequest& requestProto = requestParser.getProto();
-    requestProto.mutable_model_spec()->set_name(modelName);
+    requestProto->mutable_model_spec()->set_name(modelName);
     if (modelVersion.has_value()) {
-        requestProto.mutable_model_spec()->mutable_version()->set_value(modelVersion.value());
+        requestProto->mutable_model_spec()->mutable_version()->set_value(modelVersion.value());
+    }
+    const uint64_t sequenceId = modelVersion.has_value() ? 0 : getContinuedSequenceId(*requestProto);
+    if (sequenceId != 0) {
+        // body is parsed with inputs of routed version, sequence continues on the version it was started on
+        std::shared_ptr<ModelInstance> sequenceInstance;
+        std::unique_ptr<ModelInstanceUnloadGuard> sequenceInstanceUnloadGuard;
+        status = getModelInstance(ModelManager::getInstance(), modelName, 0, sequenceInstance, sequenceInstanceUnloadGuard, sequenceId);
+        if (!status.ok()) {
+            return status;
+        }
+        modelInstanceUnloadGuard = std::move(sequenceInstanceUnloadGuard);
+        modelInstance = std::move(sequenceInstance);
     }
-    status = inference(*modelInstance, &requestProto, &responseProto, modelInstanceUnloadGuard);
+    status = inference(*modelInstance, requestProto, &responseProto, modelInstanceUnloadGuard, timing, deadline, priority, tenant);
     return status;
 }
 
 Status HttpRestApiHandler::processPipelineRequest(const std::string& modelName,
     const std::string& request,
+    const std::optional<size_t>& binaryHeaderLength,
     Order& requestOrder,
-    tensorflow::serving::PredictResponse& responseProto) {
+    tensorflow::serving::PredictResponse& responseProto,
+    RequestTiming* timing,
+    const RequestDeadline* deadline) {
 
     std::unique_ptr<Pipeline> pipelinePtr;
 
-    Timer timer;
-    timer.start("parse");
-    RestParser requestParser;
-    auto status = requestParser.parse(request.c_str());
+    google::protobuf::Arena* arena = responseProto.GetArena();
+    RestParser requestParser(arena);
+    PredictRequest* requestProto = nullptr;
+    auto status = parsePredictRequestBody(request, binaryHeaderLength, requestParser, arena, requestProto, requestOrder, timing);
     if (!status.ok()) {
         return status;
     }
-    requestOrder = requestParser.getOrder();
-    timer.stop("parse");
-    spdlog::debug("JSON request parsing time: {} ms", timer.elapsed<std::chrono::microseconds>("parse") / 1000);
-
-    tensorflow::serving::PredictRequest& requestProto = requestParser.getProto();
-    requestProto.mutable_model_spec()->set_name(modelName);
-    status = getPipeline(ModelManager::getInstance(), pipelinePtr, &requestProto, &responseProto);
+    requestProto->mutable_model_spec()->set_name(modelName);
+    status = getPipeline(ModelManager::getInstance(), pipelinePtr, requestProto, &responseProto);
     if (!status.ok()) {
         return status;
     }
-    status = pipelinePtr->execute();
+    status = pipelinePtr->execute(timing, deadline);
     return status;
 }
 
@@ -266,22 +491,13 @@ Status HttpRestApiHandler::processModelMetadataRequest(
     std::string* response) {
     // model_version_label currently is not in use
     tensorflow::serving::GetModelMetadataRequest grpc_request;
-    tensorflow::serving::GetModelMetadataResponse grpc_response;
     Status status;
     std::string modelName(model_name);
     status = GetModelMetadataImpl::createGrpcRequest(modelName, model_version, &grpc_request);
     if (!status.ok()) {
         return status;
     }
-    status = GetModelMetadataImpl::getModelStatus(&grpc_request, &grpc_response);
-    if (!status.ok()) {
-        return status;
-    }
-    status = GetModelMetadataImpl::serializeResponse2Json(&grpc_response, response);
-    if (!status.ok()) {
-        return status;
-    }
-    return StatusCode::OK;
+    return GetModelMetadataImpl::getModelStatusJson(&grpc_request, response);
 }
 
 Status HttpRestApiHandler::processModelStatusRequest(
@@ -290,7 +506,7 @@ Status HttpRestApiHandler::processModelStatusRequest(
     const std::optional<std::string_view>& model_version_label,
     std::string* response) {
     // model_version_label currently is not in use
-    spdlog::debug("Processing model status request");
+    OVMS_REQUEST_DEBUG("Processing model status request");
     tensorflow::serving::GetModelStatusRequest grpc_request;
     tensorflow::serving::GetModelStatusResponse grpc_response;
     Status status;
@@ -310,4 +526,116 @@ Status HttpRestApiHandler::processModelStatusRequest(
     return StatusCode::OK;
 }
 
+Status HttpRestApiHandler::processHealthRequest(const std::string& probe, std::string* response) {
+    if (probe == "live") {
+        *response = "{\"status\": \"alive\"}";
+        return StatusCode::OK;
+    }
+    const auto& loadProgress = ModelManager::getInstance().getLoadProgress();
+    *response = loadProgress.toJson();
+    if (!loadProgress.isReady()) {
+        return StatusCode::SERVER_NOT_READY;
+    }
+    return StatusCode::OK;
+}
+
+Status HttpRestApiHandler::processMetricsRequest(std::string* response) {
+    *response = MetricsRegistry::getInstance().serialize();
+    return StatusCode::OK;
+}
+
+Status HttpRestApiHandler::processProfileRequest(const std::string& query, std::string* response) {
+    std::map<std::string, uint> parameters{{"seconds", 30}, {"frequency", SamplingProfiler::DEFAULT_FREQUENCY}};
+    auto status = parseProfilingQuery(query, parameters);
+    if (!status.ok()) {
+        return status;
+    }
+    SPDLOG_INFO("Profiling server threads for {} seconds at {} Hz", parameters["seconds"], parameters["frequency"]);
+    return SamplingProfiler::getInstance().profile(std::chrono::seconds(parameters["seconds"]), parameters["frequency"], *response);
+}
+
+Status HttpRestApiHandler::processSharedMemoryRequest(const std::string_view http_method, const std::string& regionName,
+    const std::string_view action, const std::string& request_body, std::string* response) {
+    auto& registry = SharedMemoryRegistry::getInstance();
+    if (http_method == "GET" && regionName.empty()) {
+        *response = registry.toJson();
+        return StatusCode::OK;
+    }
+    if (http_method != "POST" || regionName.empty()) {
+        return StatusCode::REST_UNSUPPORTED_METHOD;
+    }
+    if (action == "unregister") {
+        *response = "{}";
+        return registry.unregisterRegion(regionName);
+    }
+    rapidjson::Document body;
+    if (body.Parse(request_body.c_str()).HasParseError() || !body.IsObject()) {
+        return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
+    }
+    auto key = body.FindMember("key");
+    auto byteSize = body.FindMember("byte_size");
+    auto offset = body.FindMember("offset");
+    if (key == body.MemberEnd() || !key->value.IsString() ||
+        byteSize == body.MemberEnd() || !byteSize->value.IsUint64() ||
+        (offset != body.MemberEnd() && !offset->value.IsUint64())) {
+        return Status(StatusCode::SHARED_MEMORY_REGION_INVALID, "Expected string key, integer byte_size and optional integer offset");
+    }
+    auto status = registry.registerRegion(regionName, key->value.GetString(), offset != body.MemberEnd() ? offset->value.GetUint64() : 0,
+        byteSize->value.GetUint64());
+    if (status.ok()) {
+        *response = "{}";
+    }
+    return status;
+}
+
+Status HttpRestApiHandler::processJobsRequest(const std::string_view http_method, const std::string_view jobId,
+    const std::string_view action, const std::string& request_body, std::string* response) {
+    auto& jobs = BatchJobs::getInstance();
+    if (!jobs.isEnabled()) {
+        return StatusCode::BATCH_JOBS_DISABLED;
+    }
+    if (jobId.empty()) {
+        if (http_method == "GET") {
+            *response = jobs.list();
+            return StatusCode::OK;
+        }
+        if (http_method == "POST") {
+            return jobs.submit(request_body, ModelManager::getInstance(), *response);
+        }
+        return StatusCode::REST_UNSUPPORTED_METHOD;
+    }
+    if (jobId.size() > 18) {
+        return StatusCode::BATCH_JOB_MISSING;
+    }
+    const uint64_t id = std::stoull(std::string(jobId));
+    if (http_method == "GET" && action.empty()) {
+        return jobs.getStatus(id, *response);
+    }
+    if (http_method == "POST" && action == "cancel") {
+        return jobs.cancel(id, *response);
+    }
+    return StatusCode::REST_UNSUPPORTED_METHOD;
+}
+
+Status HttpRestApiHandler::processPerfCountersRequest(const std::string& modelName, const std::optional<int64_t>& modelVersion,
+    const std::string& query, std::string* response) {
+    std::map<std::string, uint> parameters{{"inferences", 100}, {"timeout_seconds", 60}};
+    auto status = parseProfilingQuery(query, parameters);
+    if (!status.ok()) {
+        return status;
+    }
+    auto model = ModelManager::getInstance().findModelByName(modelName);
+    if (model == nullptr) {
+        return StatusCode::MODEL_NAME_MISSING;
+    }
+    // unload guard is not held, collection may reload the version
+    auto modelInstance = modelVersion.has_value() ? model->getModelInstanceByVersion(modelVersion.value()) : model->getDefaultModelInstance();
+    if (modelInstance == nullptr) {
+        return StatusCode::MODEL_VERSION_MISSING;
+    }
+    SPDLOG_INFO("Collecting performance counters of {} inferences of model:{} version:{}",
+        parameters["inferences"], modelName, modelInstance->getVersion());
+    return modelInstance->collectPerfCounters(parameters["inferences"], std::chrono::seconds(parameters["timeout_seconds"]), *response);
+}
+
 }  // namespace ovms
@@ -15,18 +15,25 @@
 //*****************************************************************************
 #pragma once
 
-#include <regex>
+#include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 
+#include "ovinferrequestsqueue.hpp"
 #include "rest_parser.hpp"
+#include "rest_router.hpp"
 #include "status.hpp"
 
 namespace ovms {
 
+class RequestDeadline;
+class RequestTiming;
+
 struct HttpRequestComponents {
     std::string_view http_method;
     std::string model_name;
@@ -34,31 +41,46 @@ struct HttpRequestComponents {
     std::optional<std::string_view> model_version_label;
     std::string processing_method;
     std::string model_subresource;
+    std::optional<size_t> inference_header_content_length;
+    // set only if client requested timing of the request
+    RequestTiming* timing = nullptr;
+    // set only if client sent request timeout
+    const RequestDeadline* deadline = nullptr;
+    RequestPriority priority = RequestPriority::HIGH;
+    // empty if client did not send tenant header
+    std::string tenant;
 };
 
+/**
+ * @brief Schedules task on threads of REST server
+ */
+using rest_task_scheduler_t = std::function<void(std::function<void()>)>;
+
 class HttpRestApiHandler {
 public:
-    static const std::string kPathRegexExp;
-    static const std::string predictionRegexExp;
-    static const std::string modelstatusRegexExp;
-
     /**
      * @brief Construct a new HttpRest Api Handler
      * 
      * @param timeout_in_ms 
+     * @param profilingEnabled exposes sampling profiler endpoint
+     * @param scheduler runs requests of batch predict on REST server threads, requests are processed by calling thread only if it is empty
      */
-    HttpRestApiHandler(int timeout_in_ms) :
-        sanityRegex(kPathRegexExp),
-        predictionRegex(predictionRegexExp),
-        modelstatusRegex(modelstatusRegexExp),
-        timeout_in_ms(timeout_in_ms) {}
+    HttpRestApiHandler(int timeout_in_ms, bool profilingEnabled = false, rest_task_scheduler_t scheduler = nullptr) :
+        timeout_in_ms(timeout_in_ms),
+        profilingEnabled(profilingEnabled),
+        scheduler(std::move(scheduler)) {}
 
-    Status validateUrlAndMethod(
+    /**
+     * @brief Checks if matched route is a model route served with the method
+     */
+    static Status validateUrlAndMethod(
         const std::string_view http_method,
-        const std::string& request_path,
-        std::smatch* sm);
+        const RestRouteMatch& match);
 
-    Status parseModelVersion(std::string& model_version_str, std::optional<int64_t>& model_version);
+    /**
+     * @brief Parses version digits of model path, leaves version empty if there are none
+     */
+    static Status parseModelVersion(const std::string_view model_version_str, std::optional<int64_t>& model_version);
 
     Status dispatchToProcessor(
         const std::string_view request_path,
@@ -74,6 +96,11 @@ public:
      * @param request_body 
      * @param headers 
      * @param resposnse 
+     * @param inferenceHeaderContentLength value of Inference-Header-Content-Length header, present for binary requests
+     * @param timing receives durations of predict request stages, null if client did not request them
+     * @param deadline predictions are dropped once it passes, null if client did not send timeout
+     * @param priority priority class of predictions waiting for infer request
+     * @param tenant limits of the tenant apply to predictions
      *
      * @return StatusCode 
      */
@@ -82,7 +109,12 @@ public:
         const std::string_view request_path,
         const std::string& request_body,
         std::vector<std::pair<std::string, std::string>>* headers,
-        std::string* response);
+        std::string* response,
+        const std::optional<std::string_view>& inferenceHeaderContentLength = std::nullopt,
+        RequestTiming* timing = nullptr,
+        const RequestDeadline* deadline = nullptr,
+        RequestPriority priority = RequestPriority::HIGH,
+        const std::string& tenant = std::string());
 
     /**
      * @brief Process predict request
@@ -92,6 +124,11 @@ public:
      * @param modelVersionLabel 
      * @param request 
      * @param response 
+     * @param binaryHeaderLength size of JSON header of binary request, empty for JSON request
+     * @param timing receives durations of request stages, null if client did not request them
+     * @param deadline null if request has none
+     * @param priority applies to single model requests
+     * @param tenant request counts against its rate limit, fair share applies to single model requests
      *
      * @return StatusCode 
      */
@@ -100,20 +137,54 @@ public:
         const std::optional<int64_t>& modelVersion,
         const std::optional<std::string_view>& modelVersionLabel,
         const std::string& request,
-        std::string* response);
+        std::string* response,
+        const std::optional<size_t>& binaryHeaderLength = std::nullopt,
+        RequestTiming* timing = nullptr,
+        const RequestDeadline* deadline = nullptr,
+        RequestPriority priority = RequestPriority::HIGH,
+        const std::string& tenant = std::string());
+
+    /**
+     * @brief Process batch predict request, runs independent predict requests concurrently
+     *
+     * Fails only if the batch cannot be parsed, errors of single requests are reported in their responses.
+     *
+     * @param request JSON body with requests array, see parseBatchPredictRequest
+     * @param response
+     * @param deadline shared by all requests of the batch, null if there is none
+     * @param priority shared by all requests of the batch
+     * @param tenant every request of the batch counts against its rate limit
+     *
+     * @return StatusCode
+     */
+    Status processBatchPredictRequest(const std::string& request, std::string* response, const RequestDeadline* deadline = nullptr,
+        RequestPriority priority = RequestPriority::HIGH, const std::string& tenant = std::string());
 
     Status processSingleModelRequest(
         const std::string& modelName,
         const std::optional<int64_t>& modelVersion,
         const std::string& request,
+        const std::optional<size_t>& binaryHeaderLength,
         Order& requestOrder,
-        tensorflow::serving::PredictResponse& responseProto);
+        tensorflow::serving::PredictResponse& responseProto,
+        RequestTiming* timing = nullptr,
+        const RequestDeadline* deadline = nullptr,
+        RequestPriority priority = RequestPriority::HIGH,
+        const std::string& tenant = std::string());
 
     Status processPipelineRequest(
         const std::string& modelName,
         const std::string& request,
+        const std::optional<size_t>& binaryHeaderLength,
         Order& requestOrder,
-        tensorflow::serving::PredictResponse& responseProto);
+        tensorflow::serving::PredictResponse& responseProto,
+        RequestTiming* timing = nullptr,
+        const RequestDeadline* deadline = nullptr);
+
+    /**
+     * @brief Parses inference header length of binary request
+     */
+    static Status parseInferenceHeaderContentLength(const std::string_view value, std::optional<size_t>& binaryHeaderLength);
 
     /**
      * @brief Process Model Metadata request
@@ -146,12 +217,82 @@ public:
         const std::optional<std::string_view>& model_version_label,
         std::string* response);
 
-private:
-    const std::regex sanityRegex;
-    const std::regex predictionRegex;
-    const std::regex modelstatusRegex;
+    /**
+     * @brief Process liveness or readiness probe
+     *
+     * Readiness response reports load progress of models and fails with SERVER_NOT_READY until startup load completes.
+     *
+     * @param probe live or ready
+     * @param response
+     * @return StatusCode
+     */
+    Status processHealthRequest(const std::string& probe, std::string* response);
+
+    /**
+     * @brief Process metrics request, serializes server metrics in Prometheus text format
+     *
+     * @param response
+     * @return StatusCode
+     */
+    Status processMetricsRequest(std::string* response);
+
+    /**
+     * @brief Process profile request, samples stacks of server threads and returns them in collapsed format
+     *
+     * Blocks for the requested number of seconds.
+     *
+     * @param query query string with optional seconds and frequency parameters
+     * @param response
+     * @return StatusCode
+     */
+    Status processProfileRequest(const std::string& query, std::string* response);
+
+    /**
+     * @brief Process performance counters request, aggregates per layer counters of the next inferences of model version
+     *
+     * Blocks until the requested number of inferences is collected or timeout passes.
+     *
+     * @param modelName
+     * @param modelVersion default version if empty
+     * @param query query string with optional inferences and timeout_seconds parameters
+     * @param response
+     * @return StatusCode
+     */
+    Status processPerfCountersRequest(const std::string& modelName, const std::optional<int64_t>& modelVersion,
+        const std::string& query, std::string* response);
+
+    /**
+     * @brief Process shared memory request, lists, registers or unregisters regions
+     *
+     * Register request body is a JSON object with key of POSIX shared memory object, byte_size and optional offset of the region.
+     *
+     * @param http_method
+     * @param regionName empty when listing regions
+     * @param action register or unregister
+     * @param request_body
+     * @param response
+     * @return StatusCode
+     */
+    Status processSharedMemoryRequest(const std::string_view http_method, const std::string& regionName,
+        const std::string_view action, const std::string& request_body, std::string* response);
 
+    /**
+     * @brief Process batch inference job request, submits, lists, reports or cancels jobs
+     *
+     * @param http_method
+     * @param jobId empty when listing or submitting jobs
+     * @param action cancel or empty
+     * @param request_body
+     * @param response
+     * @return StatusCode
+     */
+    Status processJobsRequest(const std::string_view http_method, const std::string_view jobId,
+        const std::string_view action, const std::string& request_body, std::string* response);
+
+private:
     int timeout_in_ms;
+    bool profilingEnabled;
+    rest_task_scheduler_t scheduler;
 };
 
 }  // namespace ovms
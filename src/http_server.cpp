@@ -15,9 +15,11 @@
 //*****************************************************************************
 #include "http_server.hpp"
 
+#include <cstdlib>
 #include <memory>
-#include <regex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -28,19 +30,46 @@
 #include "tensorflow_serving/util/net_http/server/public/server_request_interface.h"
 #include "tensorflow_serving/util/threadpool_executor.h"
 
+#include "compression.hpp"
 #include "http_rest_api_handler.hpp"
+#include "prediction_service_utils.hpp"
+#include "requestdeadline.hpp"
+#include "requestlogging.hpp"
+#include "requesttiming.hpp"
+#include "rest_binary_parser.hpp"
+#include "rest_router.hpp"
+#include "samplingprofiler.hpp"
 #include "status.hpp"
+#include "stringutils.hpp"
+#include "tenantscheduling.hpp"
 
 namespace ovms {
 
 namespace net_http = tensorflow::serving::net_http;
 
+namespace {
+// set by dispatcher on event loop thread, the server schedules handler of the same request right after dispatch
+thread_local bool runNextHandlerInline = false;
+}  // namespace
+
 class RequestExecutor final : public net_http::EventExecutor {
 public:
     explicit RequestExecutor(int num_threads) :
         executor_(tensorflow::Env::Default(), "httprestserver", num_threads) {}
 
-    void Schedule(std::function<void()> fn) override { executor_.Schedule(fn); }
+    void Schedule(std::function<void()> fn) override {
+        if (runNextHandlerInline) {
+            runNextHandlerInline = false;
+            fn();
+            return;
+        }
+        executor_.Schedule([fn = std::move(fn)]() {
+            // named once per thread, so profiles tell REST workers apart
+            thread_local const bool named = (setCurrentThreadName("rest_worker"), true);
+            (void)named;
+            fn();
+        });
+    }
 
 private:
     tensorflow::serving::ThreadPoolExecutor executor_;
@@ -48,38 +77,128 @@ private:
 
 class RestApiRequestDispatcher {
 public:
-    RestApiRequestDispatcher(int timeout_in_ms) :
-        regex_(HttpRestApiHandler::kPathRegexExp) {
-        handler_ = std::make_unique<HttpRestApiHandler>(timeout_in_ms);
+    RestApiRequestDispatcher(int timeout_in_ms, bool profilingEnabled, RestInlineDispatch inlineDispatch, RequestExecutor* executor) :
+        inlineDispatch_(inlineDispatch) {
+        // executor is owned by the server, which outlives the dispatcher registered in it
+        handler_ = std::make_unique<HttpRestApiHandler>(timeout_in_ms, profilingEnabled, [executor](std::function<void()> task) {
+            executor->Schedule(std::move(task));
+        });
     }
 
     net_http::RequestHandler dispatch(net_http::ServerRequestInterface* req) {
+        runNextHandlerInline = isProcessedInline(req);
         return [this](net_http::ServerRequestInterface* req) {
             this->processRequest(req);
         };
     }
 
 private:
-    void processRequest(net_http::ServerRequestInterface* req) {
-        spdlog::info("REST request {}", req->uri_path());
-        std::string body;
+    bool isProcessedInline(net_http::ServerRequestInterface* req) const {
+        if (inlineDispatch_ == RestInlineDispatch::NONE) {
+            return false;
+        }
+        RestRouteMatch match;
+        matchRestRoute(req->uri_path(), match);
+        switch (match.route) {
+        case RestRoute::HEALTH:
+        case RestRoute::METRICS:
+        case RestRoute::MODEL_STATUS:
+        case RestRoute::MODEL_METADATA:
+            return req->http_method() == "GET";
+        case RestRoute::PREDICT:
+            return inlineDispatch_ == RestInlineDispatch::ALL;
+        default:
+            // profiling, perf counters and shared memory registration may take long or block
+            return false;
+        }
+    }
+
+    static void readRequestBody(net_http::ServerRequestInterface* req, std::string& body) {
+        // sized up front, so chunks of large payloads are appended without reallocations
+        auto contentLength = stou32(std::string(req->GetRequestHeader("Content-Length")));
+        if (contentLength && contentLength.value() <= MAX_PREALLOCATED_BODY_SIZE) {
+            body.reserve(contentLength.value());
+        }
         int64_t num_bytes = 0;
         auto request_chunk = req->ReadRequestBytes(&num_bytes);
         while (request_chunk != nullptr) {
-            body.append(std::string_view(request_chunk.get(), num_bytes));
+            body.append(request_chunk.get(), num_bytes);
             request_chunk = req->ReadRequestBytes(&num_bytes);
         }
+    }
+
+    static Status decompressRequestBody(net_http::ServerRequestInterface* req, std::string& body) {
+        // bodies already inflated by the HTTP server no longer start with gzip magic bytes
+        auto contentEncoding = req->GetRequestHeader("Content-Encoding");
+        if (!acceptsEncoding(std::string_view(contentEncoding.data(), contentEncoding.size()), "gzip") || !isGzip(body)) {
+            return StatusCode::OK;
+        }
+        std::string decompressed;
+        auto status = gzipDecompress(body, decompressed, MAX_DECOMPRESSED_BODY_SIZE);
+        if (status.ok()) {
+            body = std::move(decompressed);
+        }
+        return status;
+    }
+
+    static void compressResponse(net_http::ServerRequestInterface* req, std::string& output, std::vector<std::pair<std::string, std::string>>& headers) {
+        auto acceptEncoding = req->GetRequestHeader("Accept-Encoding");
+        if (!ResponseCompression::shouldCompress(output.size(), std::string_view(acceptEncoding.data(), acceptEncoding.size()))) {
+            return;
+        }
+        std::string compressed;
+        if (!gzipCompress(output, compressed).ok()) {
+            spdlog::warn("Compressing REST response failed, sending it uncompressed");
+            return;
+        }
+        output = std::move(compressed);
+        headers.push_back({"Content-Encoding", "gzip"});
+        headers.push_back({"Vary", "Accept-Encoding"});
+    }
+
+    void processRequest(net_http::ServerRequestInterface* req) {
+        std::string body;
+        readRequestBody(req, body);
+        auto status = decompressRequestBody(req, body);
 
         std::vector<std::pair<std::string, std::string>> headers;
         std::string output;
-        spdlog::info("Processing HTTP request: {} {} body: {} bytes",
+        OVMS_REQUEST_DEBUG("Processing HTTP request: {} {} body: {} bytes",
             req->http_method(),
             req->uri_path(),
             body.size());
-        const auto status = handler_->processRequest(req->http_method(), req->uri_path(), body, &headers, &output);
+        std::optional<std::string_view> inferenceHeaderContentLength;
+        auto inferenceHeaderContentLengthValue = req->GetRequestHeader(RestBinaryParser::INFERENCE_HEADER_CONTENT_LENGTH);
+        if (!inferenceHeaderContentLengthValue.empty()) {
+            inferenceHeaderContentLength = std::string_view(inferenceHeaderContentLengthValue.data(), inferenceHeaderContentLengthValue.size());
+        }
+        std::unique_ptr<RequestTiming> timing;
+        if (!req->GetRequestHeader(RequestTiming::REQUEST_HEADER).empty()) {
+            timing = std::make_unique<RequestTiming>();
+        }
+        std::optional<RequestDeadline> deadline;
+        auto timeoutHeaderValue = req->GetRequestHeader(RequestDeadline::REQUEST_HEADER);
+        if (status.ok() && !timeoutHeaderValue.empty()) {
+            deadline.emplace();
+            status = RequestDeadline::fromTimeoutHeader(std::string_view(timeoutHeaderValue.data(), timeoutHeaderValue.size()), deadline.value());
+        }
+        RequestPriority priority = RequestPriority::HIGH;
+        auto priorityHeaderValue = req->GetRequestHeader(REQUEST_PRIORITY_HEADER);
+        if (status.ok() && !priorityHeaderValue.empty()) {
+            status = parseRequestPriority(std::string_view(priorityHeaderValue.data(), priorityHeaderValue.size()), priority);
+        }
+        auto tenantHeaderValue = req->GetRequestHeader(REQUEST_TENANT_HEADER);
+        if (status.ok()) {
+            status = handler_->processRequest(req->http_method(), req->uri_path(), body, &headers, &output, inferenceHeaderContentLength, timing.get(),
+                deadline ? &deadline.value() : nullptr, priority, std::string(tenantHeaderValue.data(), tenantHeaderValue.size()));
+        }
+        if (timing) {
+            headers.push_back({RequestTiming::RESPONSE_HEADER, timing->serialize()});
+        }
         if (!status.ok() && output.empty()) {
             output.append("{\"error\": \"" + status.string() + "\"}");
         }
+        compressResponse(req, output, headers);
         const auto http_status = status.http();
         for (const auto& kv : headers) {
             req->OverwriteResponseHeader(kv.first, kv.second);
@@ -94,14 +213,38 @@ private:
         req->ReplyWithStatus(http_status);
     }
 
-    const std::regex regex_;
+    // Content-Length is not trusted above gRPC message size limit, body grows by chunks then
+    static const uint32_t MAX_PREALLOCATED_BODY_SIZE = 1024 * 1024 * 1024;
+    static const size_t MAX_DECOMPRESSED_BODY_SIZE = 1024 * 1024 * 1024;
+
+    const RestInlineDispatch inlineDispatch_;
     std::unique_ptr<HttpRestApiHandler> handler_;
 };
 
-std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms) {
+std::optional<RestInlineDispatch> parseRestInlineDispatch(const std::string& value) {
+    if (value == "none") {
+        return RestInlineDispatch::NONE;
+    }
+    if (value == "light") {
+        return RestInlineDispatch::LIGHT;
+    }
+    if (value == "all") {
+        return RestInlineDispatch::ALL;
+    }
+    return std::nullopt;
+}
+
+std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms, bool profilingEnabled,
+    RestInlineDispatch inlineDispatch, uint keepAliveTimeoutSeconds) {
+    if (keepAliveTimeoutSeconds > 0) {
+        // read by patched HTTP server when it is initialized
+        setenv(KEEP_ALIVE_TIMEOUT_ENV, std::to_string(keepAliveTimeoutSeconds).c_str(), 1);
+    }
     auto options = std::make_unique<net_http::ServerOptions>();
     options->AddPort(static_cast<uint32_t>(port));
-    options->SetExecutor(std::make_unique<RequestExecutor>(num_threads));
+    auto executor = std::make_unique<RequestExecutor>(num_threads);
+    RequestExecutor* requestExecutor = executor.get();
+    options->SetExecutor(std::move(executor));
 
     auto server = net_http::CreateEvHTTPServer(std::move(options));
     if (server == nullptr) {
@@ -110,7 +253,7 @@ std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads,
     }
 
     std::shared_ptr<RestApiRequestDispatcher> dispatcher =
-        std::make_shared<RestApiRequestDispatcher>(timeout_in_ms);
+        std::make_shared<RestApiRequestDispatcher>(timeout_in_ms, profilingEnabled, inlineDispatch, requestExecutor);
 
     net_http::RequestHandlerOptions handler_options;
     server->RegisterRequestDispatcher(
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "tensorflow_serving/util/net_http/server/public/httpserver_interface.h"
 
@@ -23,15 +25,36 @@ namespace ovms {
 
 using http_server = tensorflow::serving::net_http::HTTPServerInterface;
 
+/**
+ * @brief REST requests processed on HTTP event loop thread, skipping the hand-off to REST workers
+ */
+enum class RestInlineDispatch {
+    NONE,
+    LIGHT, /*!< health, metrics, model status and metadata */
+    ALL    /*!< light requests and predictions */
+};
+
+// environment variable read by patched HTTP server, it has no option for connection timeout
+constexpr const char* KEEP_ALIVE_TIMEOUT_ENV = "OVMS_REST_KEEP_ALIVE_TIMEOUT_SECONDS";
+
+/**
+ * @brief Parses rest_inline_dispatch parameter value
+ */
+std::optional<RestInlineDispatch> parseRestInlineDispatch(const std::string& value);
+
 /**
  * @brief Creates a and starts Http Server
  * 
  * @param port 
  * @param num_threads 
  * @param timeout_in_m
+ * @param profilingEnabled exposes sampling profiler endpoint
+ * @param inlineDispatch requests processed on event loop thread
+ * @param keepAliveTimeoutSeconds idle connections timeout, 0 keeps HTTP server default
  *  
  * @return std::unique_ptr<http_server> 
  */
-std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms);
+std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms, bool profilingEnabled = false,
+    RestInlineDispatch inlineDispatch = RestInlineDispatch::NONE, uint keepAliveTimeoutSeconds = 0);
 
 }  // namespace ovms
@@ -0,0 +1,138 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "imagedecoding.hpp"
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <spdlog/spdlog.h>
+
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+namespace {
+
+bool isImageTensorDesc(const InferenceEngine::TensorDesc& desc) {
+    const auto& dims = desc.getDims();
+    return dims.size() == 4 &&
+           (dims[1] == 1 || dims[1] == 3) &&
+           (desc.getLayout() == InferenceEngine::Layout::NCHW || desc.getLayout() == InferenceEngine::Layout::NHWC) &&
+           (desc.getPrecision() == InferenceEngine::Precision::U8 || desc.getPrecision() == InferenceEngine::Precision::FP32);
+}
+
+Status decodeImage(const std::string& encoded, const InferenceEngine::TensorDesc& desc, char* destination) {
+    const auto& dims = desc.getDims();
+    const int channels = static_cast<int>(dims[1]);
+    const int height = static_cast<int>(dims[2]);
+    const int width = static_cast<int>(dims[3]);
+    const int depth = desc.getPrecision() == InferenceEngine::Precision::FP32 ? CV_32F : CV_8U;
+
+    cv::Mat image;
+    try {
+        cv::Mat source(1, static_cast<int>(encoded.size()), CV_8UC1, const_cast<char*>(encoded.data()));
+        image = cv::imdecode(source, channels == 1 ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR);
+    } catch (const cv::Exception& e) {
+        spdlog::debug("Exception thrown while decoding image: {}", e.what());
+        return StatusCode::IMAGE_PARSING_FAILED;
+    }
+    if (image.empty()) {
+        return StatusCode::IMAGE_PARSING_FAILED;
+    }
+    if (image.cols != width || image.rows != height) {
+        cv::Mat resized;
+        cv::resize(image, resized, cv::Size(width, height), 0, 0, cv::INTER_LINEAR);
+        image = resized;
+    }
+
+    if (desc.getLayout() == InferenceEngine::Layout::NHWC || channels == 1) {
+        // interleaved channels are the memory layout of the blob, mats reference blob memory and are written in place
+        cv::Mat interleaved(height, width, CV_MAKETYPE(depth, channels), destination);
+        image.convertTo(interleaved, depth);
+        return StatusCode::OK;
+    }
+    const size_t planeSize = static_cast<size_t>(height) * width * CV_ELEM_SIZE(depth);
+    std::vector<cv::Mat> planes;
+    for (int c = 0; c < channels; ++c) {
+        planes.emplace_back(height, width, depth, destination + c * planeSize);
+    }
+    if (depth != CV_8U) {
+        cv::Mat converted;
+        image.convertTo(converted, depth);
+        image = converted;
+    }
+    cv::split(image, planes);
+    return StatusCode::OK;
+}
+
+}  // namespace
+
+Status validateImageInput(const TensorInfo& networkInput, const tensorflow::TensorProto& requestInput) {
+    if (!isImageTensorDesc(networkInput.getTensorDesc())) {
+        return StatusCode::UNSUPPORTED_IMAGE_INPUT;
+    }
+    const auto& shape = requestInput.tensor_shape();
+    if (shape.dim_size() != 1) {
+        std::stringstream ss;
+        ss << "Expected: 1; Actual: " << shape.dim_size();
+        return Status(StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, ss.str());
+    }
+    const size_t batchSize = networkInput.getShape()[0];
+    if (shape.dim(0).size() < 0 || static_cast<size_t>(shape.dim(0).size()) != batchSize) {
+        std::stringstream ss;
+        ss << "Expected: " << batchSize << "; Actual: " << shape.dim(0).size();
+        return Status(StatusCode::INVALID_BATCH_SIZE, ss.str());
+    }
+    if (requestInput.string_val_size() < 0 || static_cast<size_t>(requestInput.string_val_size()) != batchSize) {
+        std::stringstream ss;
+        ss << "Expected: " << batchSize << "; Actual: " << requestInput.string_val_size();
+        return Status(StatusCode::INVALID_VALUE_COUNT, ss.str());
+    }
+    return StatusCode::OK;
+}
+
+Status decodeImages(const tensorflow::TensorProto& requestInput, const InferenceEngine::Blob::Ptr& blob) {
+    // plugin may allocate blob in a different layout than the network input, blob memory is what counts
+    const auto& desc = blob->getTensorDesc();
+    if (!isImageTensorDesc(desc)) {
+        return StatusCode::UNSUPPORTED_IMAGE_INPUT;
+    }
+    const size_t batchSize = desc.getDims()[0];
+    if (requestInput.string_val_size() < 0 || static_cast<size_t>(requestInput.string_val_size()) != batchSize) {
+        return StatusCode::INVALID_VALUE_COUNT;
+    }
+    const size_t imageByteSize = blob->byteSize() / batchSize;
+    char* data = blob->buffer().as<char*>();
+    std::vector<StatusCode> statuses(batchSize, StatusCode::OK);
+    cv::parallel_for_(cv::Range(0, static_cast<int>(batchSize)), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; ++i) {
+            statuses[i] = decodeImage(requestInput.string_val(i), desc, data + i * imageByteSize).getCode();
+        }
+    });
+    for (const auto code : statuses) {
+        if (code != StatusCode::OK) {
+            return code;
+        }
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,51 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <inference_engine.hpp>
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "status.hpp"
+
+namespace ovms {
+
+class TensorInfo;
+
+/**
+ * @brief Input sent as DT_STRING with one encoded JPEG or PNG image per batch element in string_val
+ */
+inline bool isImageInput(const tensorflow::TensorProto& requestInput) {
+    return requestInput.dtype() == tensorflow::DataType::DT_STRING;
+}
+
+/**
+ * @brief Checks that network input takes images and that request carries one image per batch element
+ *
+ * Network input must have 4 dimensions N, C, H, W with 1 or 3 channels, NCHW or NHWC layout and U8 or FP32 precision.
+ * Request shape must be [N], images are not validated before decoding.
+ */
+Status validateImageInput(const TensorInfo& networkInput, const tensorflow::TensorProto& requestInput);
+
+/**
+ * @brief Decodes images of request input straight into the blob, resizing them to its height and width
+ *
+ * Images of a batch are decoded in parallel. Color images keep BGR channel order of OpenCV,
+ * which is the order expected by models converted from Caffe and most OpenVINO models.
+ */
+Status decodeImages(const tensorflow::TensorProto& requestInput, const InferenceEngine::Blob::Ptr& blob);
+
+}  // namespace ovms
@@ -0,0 +1,120 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "instrumentedfilesystem.hpp"
+
+#include <chrono>
+#include <utility>
+
+namespace ovms {
+
+InstrumentedFileSystem::InstrumentedFileSystem(std::shared_ptr<FileSystem> fileSystem, const std::string& backend) :
+    fileSystem(std::move(fileSystem)),
+    remote(backend != "local"),
+    exists(createOperationMetrics(backend, "exists")),
+    directory(createOperationMetrics(backend, "is_directory")),
+    list(createOperationMetrics(backend, "list")),
+    read(createOperationMetrics(backend, "read")),
+    download(createOperationMetrics(backend, "download")),
+    remove(createOperationMetrics(backend, "delete")),
+    downloadedBytes(MetricsRegistry::getInstance().counter("ovms_storage_downloaded_bytes_total",
+        "Bytes read or downloaded from remote model storage", {{"backend", backend}})) {}
+
+InstrumentedFileSystem::OperationMetrics InstrumentedFileSystem::createOperationMetrics(const std::string& backend, const std::string& operation) {
+    auto& registry = MetricsRegistry::getInstance();
+    const metric_labels_t labels{{"backend", backend}, {"operation", operation}};
+    return {
+        registry.counter("ovms_storage_requests_total", "Calls of model storage operations", labels),
+        registry.counter("ovms_storage_errors_total", "Calls of model storage operations which failed", labels),
+        registry.histogram("ovms_storage_request_duration_seconds", "Duration of model storage operations", labels,
+            MetricsRegistry::LATENCY_BUCKETS_SECONDS)};
+}
+
+Counter& InstrumentedFileSystem::getRetriesCounter(const std::string& backend) {
+    return MetricsRegistry::getInstance().counter("ovms_storage_retries_total", "Retries of requests to model storage", {{"backend", backend}});
+}
+
+template <typename Call>
+StatusCode InstrumentedFileSystem::measure(OperationMetrics& metrics, Call call) {
+    const auto start = std::chrono::steady_clock::now();
+    const StatusCode status = call();
+    metrics.duration.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    metrics.requests.increment();
+    if (status != StatusCode::OK) {
+        metrics.errors.increment();
+    }
+    return status;
+}
+
+uint64_t InstrumentedFileSystem::getLocalSize(const std::string& path) {
+    uint64_t size = 0;
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(path, ec)) {
+        if (entry.is_regular_file(ec)) {
+            size += entry.file_size(ec);
+        }
+    }
+    return size;
+}
+
+StatusCode InstrumentedFileSystem::fileExists(const std::string& path, bool* exists) {
+    return measure(this->exists, [&]() { return fileSystem->fileExists(path, exists); });
+}
+
+StatusCode InstrumentedFileSystem::isDirectory(const std::string& path, bool* is_dir) {
+    return measure(directory, [&]() { return fileSystem->isDirectory(path, is_dir); });
+}
+
+StatusCode InstrumentedFileSystem::getDirectoryContents(const std::string& path, files_list_t* contents) {
+    return measure(list, [&]() { return fileSystem->getDirectoryContents(path, contents); });
+}
+
+StatusCode InstrumentedFileSystem::getDirectorySubdirs(const std::string& path, files_list_t* subdirs) {
+    return measure(list, [&]() { return fileSystem->getDirectorySubdirs(path, subdirs); });
+}
+
+StatusCode InstrumentedFileSystem::getDirectoryFiles(const std::string& path, files_list_t* files) {
+    return measure(list, [&]() { return fileSystem->getDirectoryFiles(path, files); });
+}
+
+StatusCode InstrumentedFileSystem::readTextFile(const std::string& path, std::string* contents) {
+    auto status = measure(read, [&]() { return fileSystem->readTextFile(path, contents); });
+    if (status == StatusCode::OK && remote) {
+        downloadedBytes.increment(contents->size());
+    }
+    return status;
+}
+
+StatusCode InstrumentedFileSystem::downloadFileFolder(const std::string& path, const std::string& local_path) {
+    auto status = measure(download, [&]() { return fileSystem->downloadFileFolder(path, local_path); });
+    if (status == StatusCode::OK && remote) {
+        downloadedBytes.increment(getLocalSize(local_path));
+    }
+    return status;
+}
+
+StatusCode InstrumentedFileSystem::downloadModelVersions(const std::string& path, std::string* local_path, const std::vector<model_version_t>& versions) {
+    auto status = measure(download, [&]() { return fileSystem->downloadModelVersions(path, local_path, versions); });
+    if (status == StatusCode::OK && remote) {
+        downloadedBytes.increment(getLocalSize(*local_path));
+    }
+    return status;
+}
+
+StatusCode InstrumentedFileSystem::deleteFileFolder(const std::string& path) {
+    return measure(remove, [&]() { return fileSystem->deleteFileFolder(path); });
+}
+
+}  // namespace ovms
@@ -0,0 +1,81 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "filesystem.hpp"
+#include "metrics.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Measures calls of wrapped file system, so storage bottlenecks can be told apart from compilation
+ *
+ * Requests, errors and latency are counted per backend and operation, downloaded bytes per backend.
+ */
+class InstrumentedFileSystem : public FileSystem {
+public:
+    InstrumentedFileSystem(std::shared_ptr<FileSystem> fileSystem, const std::string& backend);
+
+    StatusCode fileExists(const std::string& path, bool* exists) override;
+    StatusCode isDirectory(const std::string& path, bool* is_dir) override;
+    StatusCode getDirectoryContents(const std::string& path, files_list_t* contents) override;
+    StatusCode getDirectorySubdirs(const std::string& path, files_list_t* subdirs) override;
+    StatusCode getDirectoryFiles(const std::string& path, files_list_t* files) override;
+    StatusCode readTextFile(const std::string& path, std::string* contents) override;
+    StatusCode downloadFileFolder(const std::string& path, const std::string& local_path) override;
+    StatusCode downloadModelVersions(const std::string& path, std::string* local_path, const std::vector<model_version_t>& versions) override;
+    StatusCode deleteFileFolder(const std::string& path) override;
+
+    /**
+     * @brief Counts retries of requests to backend storage, reported by clients supporting it
+     */
+    static Counter& getRetriesCounter(const std::string& backend);
+
+private:
+    struct OperationMetrics {
+        Counter& requests;
+        Counter& errors;
+        Histogram& duration;
+    };
+
+    static OperationMetrics createOperationMetrics(const std::string& backend, const std::string& operation);
+
+    template <typename Call>
+    StatusCode measure(OperationMetrics& metrics, Call call);
+
+    /**
+     * @brief Sums sizes of files under local path
+     */
+    static uint64_t getLocalSize(const std::string& path);
+
+    std::shared_ptr<FileSystem> fileSystem;
+    // local file system serves models in place, there is nothing downloaded
+    const bool remote;
+    OperationMetrics exists;
+    OperationMetrics directory;
+    OperationMetrics list;
+    OperationMetrics read;
+    OperationMetrics download;
+    OperationMetrics remove;
+    Counter& downloadedBytes;
+};
+
+}  // namespace ovms
@@ -0,0 +1,120 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "isolationgroups.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+#include <spdlog/spdlog.h>
+
+#include "cpuaffinity.hpp"
+#include "stringutils.hpp"
+
+namespace ovms {
+
+Status IsolationGroups::configure(const std::string& groupsList) {
+    std::set<int> cpus;
+    for (const auto& nodeCpus : getNumaNodesCpus()) {
+        cpus.insert(nodeCpus.begin(), nodeCpus.end());
+    }
+    return configure(groupsList, std::vector<int>(cpus.begin(), cpus.end()));
+}
+
+Status IsolationGroups::configure(const std::string& groupsList, const std::vector<int>& hostCpus) {
+    std::lock_guard<std::mutex> lock(mtx);
+    groups.clear();
+    this->hostCpus.clear();
+    if (groupsList.empty()) {
+        return StatusCode::OK;
+    }
+    std::map<std::string, std::vector<int>> parsedGroups;
+    std::set<int> reserved;
+    const std::set<int> available(hostCpus.begin(), hostCpus.end());
+    for (const auto& entry : tokenize(groupsList, ';')) {
+        auto keyValue = tokenize(entry, '=');
+        if (keyValue.size() != 2 || keyValue[0].empty()) {
+            spdlog::error("Isolation group entry {} should be in group=cpulist format", entry);
+            return StatusCode::ISOLATION_GROUPS_CONFIG_INVALID;
+        }
+        if (parsedGroups.count(keyValue[0])) {
+            spdlog::error("Isolation group {} is defined more than once", keyValue[0]);
+            return StatusCode::ISOLATION_GROUPS_CONFIG_INVALID;
+        }
+        auto cpus = parseCpuList(keyValue[1]);
+        if (cpus.empty()) {
+            spdlog::error("Isolation group {} has malformed CPU list {}", keyValue[0], keyValue[1]);
+            return StatusCode::ISOLATION_GROUPS_CONFIG_INVALID;
+        }
+        for (const auto cpu : cpus) {
+            if (!available.count(cpu)) {
+                spdlog::error("Isolation group {} CPU {} is not available on the host", keyValue[0], cpu);
+                return StatusCode::ISOLATION_GROUPS_CONFIG_INVALID;
+            }
+            if (!reserved.insert(cpu).second) {
+                spdlog::error("Isolation group {} CPU {} is already reserved by another group", keyValue[0], cpu);
+                return StatusCode::ISOLATION_GROUPS_CONFIG_INVALID;
+            }
+        }
+        parsedGroups[keyValue[0]] = std::move(cpus);
+    }
+    if (reserved.size() == available.size()) {
+        spdlog::error("Isolation groups reserve all {} CPUs, none is left for models without group", available.size());
+        return StatusCode::ISOLATION_GROUPS_CONFIG_INVALID;
+    }
+    for (const auto& [name, cpus] : parsedGroups) {
+        spdlog::info("Isolation group {} reserves {} CPUs", name, cpus.size());
+    }
+    groups = std::move(parsedGroups);
+    this->hostCpus = hostCpus;
+    return StatusCode::OK;
+}
+
+bool IsolationGroups::isEnabled() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return !groups.empty();
+}
+
+std::vector<int> IsolationGroups::getGroupCpus(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = groups.find(name);
+    return it != groups.end() ? it->second : std::vector<int>();
+}
+
+std::vector<int> IsolationGroups::excludeReservedCpus(const std::vector<int>& cpus) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<int> result;
+    std::copy_if(cpus.begin(), cpus.end(), std::back_inserter(result), [this](int cpu) {
+        return std::none_of(groups.begin(), groups.end(), [cpu](const auto& group) {
+            return std::binary_search(group.second.begin(), group.second.end(), cpu);
+        });
+    });
+    return result;
+}
+
+std::vector<int> IsolationGroups::getUngroupedCpus() const {
+    if (!isEnabled()) {
+        return {};
+    }
+    std::vector<int> cpus;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        cpus = hostCpus;
+    }
+    return excludeReservedCpus(cpus);
+}
+
+}  // namespace ovms
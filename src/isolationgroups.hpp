@@ -0,0 +1,78 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Named sets of CPUs reserved for inference of models assigned to them
+ *
+ * Models in a group run their own CPU streams only on the group CPUs, sized to them, and models without group
+ * run on the CPUs left, so latency critical models do not compete for cores with others.
+ * Groups are disabled until configured.
+ */
+class IsolationGroups {
+public:
+    static IsolationGroups& getInstance() {
+        static IsolationGroups instance;
+        return instance;
+    }
+
+    /**
+     * @brief Parses semicolon separated list of group=cpulist entries, e.g. "realtime=0-3;batch=4-7"
+     *
+     * Groups must not share CPUs and have to leave at least one CPU for models without group.
+     */
+    Status configure(const std::string& groupsList);
+
+    /**
+     * @brief Parses groups list using given CPUs as the CPUs of the host
+     */
+    Status configure(const std::string& groupsList, const std::vector<int>& hostCpus);
+
+    bool isEnabled() const;
+
+    /**
+     * @brief Gets CPUs of the group, empty if the group is not configured
+     */
+    std::vector<int> getGroupCpus(const std::string& name) const;
+
+    /**
+     * @brief Removes CPUs reserved for groups from the CPUs
+     */
+    std::vector<int> excludeReservedCpus(const std::vector<int>& cpus) const;
+
+    /**
+     * @brief Gets CPUs of the host not reserved for any group, empty if groups are disabled
+     */
+    std::vector<int> getUngroupedCpus() const;
+
+private:
+    IsolationGroups() = default;
+
+    mutable std::mutex mtx;
+    std::map<std::string, std::vector<int>> groups;
+    std::vector<int> hostCpus;
+};
+
+}  // namespace ovms
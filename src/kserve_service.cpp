@@ -0,0 +1,328 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "kserve_service.hpp"
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "get_model_metadata_impl.hpp"
+#include "model.hpp"
+#include "modelinstance.hpp"
+#include "modelmanager.hpp"
+#include "modelversionstatus.hpp"
+#include "prediction_service.hpp"
+#include "requestlogging.hpp"
+#include "tensorinfo.hpp"
+
+using tensorflow::DataType;
+using tensorflow::TensorProto;
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+namespace {
+
+const std::map<std::string, DataType> KSERVE_DATATYPES{
+    {"BOOL", DataType::DT_BOOL},
+    {"UINT8", DataType::DT_UINT8},
+    {"UINT16", DataType::DT_UINT16},
+    {"UINT32", DataType::DT_UINT32},
+    {"UINT64", DataType::DT_UINT64},
+    {"INT8", DataType::DT_INT8},
+    {"INT16", DataType::DT_INT16},
+    {"INT32", DataType::DT_INT32},
+    {"INT64", DataType::DT_INT64},
+    {"FP16", DataType::DT_HALF},
+    {"FP32", DataType::DT_FLOAT},
+    {"FP64", DataType::DT_DOUBLE},
+    {"BF16", DataType::DT_BFLOAT16},
+};
+
+/**
+ * @brief Parses KServe model version, empty version selects the default one and is returned as 0
+ */
+Status parseKServeVersion(const std::string& versionString, model_version_t& version) {
+    version = 0;
+    for (char c : versionString) {
+        if (c < '0' || c > '9' || version > (std::numeric_limits<model_version_t>::max() - (c - '0')) / 10) {
+            return Status(StatusCode::KSERVE_VERSION_INVALID, versionString);
+        }
+        version = version * 10 + (c - '0');
+    }
+    return StatusCode::OK;
+}
+
+template <typename T, typename V>
+void packContents(const google::protobuf::RepeatedField<V>& values, std::string& content) {
+    content.resize(values.size() * sizeof(T));
+    T* destination = reinterpret_cast<T*>(content.data());
+    for (int i = 0; i < values.size(); i++) {
+        destination[i] = static_cast<T>(values.Get(i));
+    }
+}
+
+/**
+ * @brief Packs typed contents of input into tensor_content, used by clients not sending raw input contents
+ */
+Status packContents(const inference::ModelInferRequest::InferInputTensor& input, DataType dataType, std::string& content) {
+    const auto& contents = input.contents();
+    switch (dataType) {
+    case DataType::DT_BOOL:
+        packContents<uint8_t>(contents.bool_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_INT8:
+        packContents<int8_t>(contents.int_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_INT16:
+        packContents<int16_t>(contents.int_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_INT32:
+        packContents<int32_t>(contents.int_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_INT64:
+        packContents<int64_t>(contents.int64_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_UINT8:
+        packContents<uint8_t>(contents.uint_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_UINT16:
+        packContents<uint16_t>(contents.uint_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_UINT32:
+        packContents<uint32_t>(contents.uint_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_UINT64:
+        packContents<uint64_t>(contents.uint64_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_FLOAT:
+        packContents<float>(contents.fp32_contents(), content);
+        return StatusCode::OK;
+    case DataType::DT_DOUBLE:
+        packContents<double>(contents.fp64_contents(), content);
+        return StatusCode::OK;
+    default:
+        // KServe has no typed contents of 2 byte floats
+        return Status(StatusCode::KSERVE_INPUT_CONTENTS_INVALID, "Input: " + input.name() + " of datatype " + input.datatype() + " requires raw_input_contents");
+    }
+}
+
+Status addOutput(const std::string& name, TensorProto& proto, inference::ModelInferResponse& response) {
+    const auto datatype = toKServeDatatype(proto.dtype());
+    if (datatype.empty()) {
+        return Status(StatusCode::OV_UNSUPPORTED_SERIALIZATION_PRECISION, "Output: " + name);
+    }
+    auto* output = response.add_outputs();
+    output->set_name(name);
+    output->set_datatype(datatype);
+    for (const auto& dim : proto.tensor_shape().dim()) {
+        output->add_shape(dim.size());
+    }
+    response.add_raw_output_contents()->swap(*proto.mutable_tensor_content());
+    return StatusCode::OK;
+}
+
+void addTensorsMetadata(const proto_signature_map_t& tensors,
+    google::protobuf::RepeatedPtrField<inference::ModelMetadataResponse::TensorMetadata>& metadata) {
+    for (const auto& [name, tensor] : tensors) {
+        auto* tensorMetadata = metadata.Add();
+        tensorMetadata->set_name(name);
+        tensorMetadata->set_datatype(toKServeDatatype(tensor.dtype()));
+        for (const auto& dim : tensor.tensor_shape().dim()) {
+            tensorMetadata->add_shape(dim.size());
+        }
+    }
+}
+
+}  // namespace
+
+DataType fromKServeDatatype(const std::string& datatype) {
+    auto it = KSERVE_DATATYPES.find(datatype);
+    return it != KSERVE_DATATYPES.end() ? it->second : DataType::DT_INVALID;
+}
+
+std::string toKServeDatatype(DataType dataType) {
+    for (const auto& [datatype, mapped] : KSERVE_DATATYPES) {
+        if (mapped == dataType) {
+            return datatype;
+        }
+    }
+    return std::string();
+}
+
+Status convertKServeRequest(inference::ModelInferRequest& request, PredictRequest& predictRequest) {
+    predictRequest.mutable_model_spec()->set_name(request.model_name());
+    model_version_t version = 0;
+    auto status = parseKServeVersion(request.model_version(), version);
+    if (!status.ok()) {
+        return status;
+    }
+    if (version != 0) {
+        predictRequest.mutable_model_spec()->mutable_version()->set_value(version);
+    }
+    const bool raw = request.raw_input_contents_size() > 0;
+    if (raw && request.raw_input_contents_size() != request.inputs_size()) {
+        return Status(StatusCode::KSERVE_INPUT_CONTENTS_INVALID,
+            "Expected: " + std::to_string(request.inputs_size()) + " raw input contents; Actual: " + std::to_string(request.raw_input_contents_size()));
+    }
+    for (int i = 0; i < request.inputs_size(); i++) {
+        const auto& input = request.inputs(i);
+        const auto dataType = fromKServeDatatype(input.datatype());
+        if (dataType == DataType::DT_INVALID) {
+            return Status(StatusCode::KSERVE_DATATYPE_UNSUPPORTED, "Input: " + input.name() + "; datatype: " + input.datatype());
+        }
+        auto& proto = (*predictRequest.mutable_inputs())[input.name()];
+        proto.set_dtype(dataType);
+        for (auto dim : input.shape()) {
+            proto.mutable_tensor_shape()->add_dim()->set_size(dim);
+        }
+        if (raw) {
+            proto.mutable_tensor_content()->swap(*request.mutable_raw_input_contents(i));
+            continue;
+        }
+        status = packContents(input, dataType, *proto.mutable_tensor_content());
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    for (const auto& output : request.outputs()) {
+        predictRequest.add_output_filter(output.name());
+    }
+    return StatusCode::OK;
+}
+
+Status convertPredictResponse(const inference::ModelInferRequest& request, PredictResponse& predictResponse, inference::ModelInferResponse& response) {
+    response.set_model_name(request.model_name());
+    response.set_model_version(request.model_version());
+    response.set_id(request.id());
+    auto& outputs = *predictResponse.mutable_outputs();
+    if (request.outputs_size() == 0) {
+        for (auto& [name, proto] : outputs) {
+            auto status = addOutput(name, proto, response);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        return StatusCode::OK;
+    }
+    for (const auto& requestedOutput : request.outputs()) {
+        auto it = outputs.find(requestedOutput.name());
+        if (it == outputs.end()) {
+            return Status(StatusCode::INVALID_MISSING_OUTPUT, "Output: " + requestedOutput.name());
+        }
+        auto status = addOutput(it->first, it->second, response);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return StatusCode::OK;
+}
+
+KServeInferenceServiceImpl::KServeInferenceServiceImpl(ModelManager& manager, PredictionServiceImpl& predictionService) :
+    manager(manager),
+    predictionService(predictionService) {}
+
+grpc::Status KServeInferenceServiceImpl::ServerLive(grpc::ServerContext* context, const inference::ServerLiveRequest* request, inference::ServerLiveResponse* response) {
+    response->set_live(true);
+    return grpc::Status::OK;
+}
+
+grpc::Status KServeInferenceServiceImpl::ServerReady(grpc::ServerContext* context, const inference::ServerReadyRequest* request, inference::ServerReadyResponse* response) {
+    response->set_ready(manager.getLoadProgress().isReady());
+    return grpc::Status::OK;
+}
+
+grpc::Status KServeInferenceServiceImpl::ModelReady(grpc::ServerContext* context, const inference::ModelReadyRequest* request, inference::ModelReadyResponse* response) {
+    model_version_t version = 0;
+    auto status = parseKServeVersion(request->version(), version);
+    if (!status.ok()) {
+        return status.grpc();
+    }
+    auto model = manager.findModelByName(request->name());
+    if (model == nullptr) {
+        if (version == 0 && manager.pipelineDefinitionExists(request->name())) {
+            response->set_ready(true);
+            return grpc::Status::OK;
+        }
+        return Status(StatusCode::MODEL_NAME_MISSING).grpc();
+    }
+    auto instance = version != 0 ? model->getModelInstanceByVersion(version) : model->getDefaultModelInstance();
+    if (instance == nullptr) {
+        return Status(StatusCode::MODEL_VERSION_MISSING).grpc();
+    }
+    response->set_ready(instance->getStatus().getState() == ModelVersionState::AVAILABLE);
+    return grpc::Status::OK;
+}
+
+grpc::Status KServeInferenceServiceImpl::ServerMetadata(grpc::ServerContext* context, const inference::ServerMetadataRequest* request, inference::ServerMetadataResponse* response) {
+    response->set_name("OpenVINO Model Server");
+    return grpc::Status::OK;
+}
+
+grpc::Status KServeInferenceServiceImpl::ModelMetadata(grpc::ServerContext* context, const inference::ModelMetadataRequest* request, inference::ModelMetadataResponse* response) {
+    model_version_t version = 0;
+    auto status = parseKServeVersion(request->version(), version);
+    if (!status.ok()) {
+        return status.grpc();
+    }
+    auto model = manager.findModelByName(request->name());
+    if (model == nullptr) {
+        return Status(StatusCode::MODEL_NAME_MISSING).grpc();
+    }
+    auto instance = version != 0 ? model->getModelInstanceByVersion(version) : model->getDefaultModelInstance();
+    if (instance == nullptr || instance->getStatus().getState() != ModelVersionState::AVAILABLE) {
+        return Status(StatusCode::MODEL_VERSION_MISSING).grpc();
+    }
+    // served from metadata published at load, inputs info is rebuilt while version reloads
+    auto metadata = instance->getMetadataCache();
+    if (!metadata) {
+        OVMS_REQUEST_DEBUG("model {}; version {} is reloading", request->name(), instance->getVersion());
+        return Status(StatusCode::MODEL_VERSION_MISSING).grpc();
+    }
+    tensorflow::serving::SignatureDefMap signatures;
+    metadata->response.metadata().at("signature_def").UnpackTo(&signatures);
+    const auto& signature = signatures.signature_def().at("serving_default");
+    response->set_name(model->getName());
+    // version resolved for the request, the one described by inputs and outputs
+    response->add_versions(std::to_string(metadata->response.model_spec().version().value()));
+    response->set_platform("OpenVINO");
+    addTensorsMetadata(signature.inputs(), *response->mutable_inputs());
+    addTensorsMetadata(signature.outputs(), *response->mutable_outputs());
+    return grpc::Status::OK;
+}
+
+grpc::Status KServeInferenceServiceImpl::ModelInfer(grpc::ServerContext* context, const inference::ModelInferRequest* request, inference::ModelInferResponse* response) {
+    OVMS_REQUEST_DEBUG("Processing KServe gRPC request for model: {}; version: {}", request->model_name(), request->model_version());
+    PredictRequest predictRequest;
+    // synchronous handler owns the request and does not read it after the call, so raw contents are moved instead of copied
+    auto status = convertKServeRequest(const_cast<inference::ModelInferRequest&>(*request), predictRequest);
+    if (!status.ok()) {
+        OVMS_REQUEST_DEBUG("Invalid KServe request: {}", status.string());
+        return status.grpc();
+    }
+    PredictResponse predictResponse;
+    auto grpcStatus = predictionService.Predict(context, &predictRequest, &predictResponse);
+    if (!grpcStatus.ok()) {
+        return grpcStatus;
+    }
+    return convertPredictResponse(*request, predictResponse, *response).grpc();
+}
+
+}  // namespace ovms
@@ -0,0 +1,79 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <string>
+
+#include <grpcpp/server_context.h>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "src/grpc_predict_v2.grpc.pb.h"
+#include "status.hpp"
+
+namespace ovms {
+
+class ModelManager;
+class PredictionServiceImpl;
+
+/**
+ * @brief Maps KServe datatype, such as FP16 or INT64, to data type of tensor proto, DT_INVALID if not supported
+ */
+tensorflow::DataType fromKServeDatatype(const std::string& datatype);
+
+/**
+ * @brief Maps data type of tensor proto to KServe datatype, empty if not supported
+ */
+std::string toKServeDatatype(tensorflow::DataType dataType);
+
+/**
+ * @brief Converts KServe request to Predict request, raw input contents are moved into tensor_content without a copy
+ *
+ * FP16 and U16 values stay packed in tensor_content, deserialization creates blobs on them as on other precisions.
+ */
+Status convertKServeRequest(inference::ModelInferRequest& request, tensorflow::serving::PredictRequest& predictRequest);
+
+/**
+ * @brief Converts Predict response to KServe response, outputs are moved to raw output contents
+ *
+ * Outputs are returned in order requested, all outputs if the request lists none.
+ */
+Status convertPredictResponse(const inference::ModelInferRequest& request, tensorflow::serving::PredictResponse& predictResponse, inference::ModelInferResponse& response);
+
+/**
+ * @brief KServe v2 gRPC inference protocol, defined in grpc_predict_v2.proto
+ *
+ * Inference requests are converted to Predict requests and served by PredictionServiceImpl, so request timeouts,
+ * priorities, tenants, pipelines and peers apply the same way as to TensorFlow Serving API.
+ */
+class KServeInferenceServiceImpl final : public inference::GRPCInferenceService::Service {
+public:
+    KServeInferenceServiceImpl(ModelManager& manager, PredictionServiceImpl& predictionService);
+
+    grpc::Status ServerLive(grpc::ServerContext* context, const inference::ServerLiveRequest* request, inference::ServerLiveResponse* response) override;
+    grpc::Status ServerReady(grpc::ServerContext* context, const inference::ServerReadyRequest* request, inference::ServerReadyResponse* response) override;
+    grpc::Status ModelReady(grpc::ServerContext* context, const inference::ModelReadyRequest* request, inference::ModelReadyResponse* response) override;
+    grpc::Status ServerMetadata(grpc::ServerContext* context, const inference::ServerMetadataRequest* request, inference::ServerMetadataResponse* response) override;
+    grpc::Status ModelMetadata(grpc::ServerContext* context, const inference::ModelMetadataRequest* request, inference::ModelMetadataResponse* response) override;
+    grpc::Status ModelInfer(grpc::ServerContext* context, const inference::ModelInferRequest* request, inference::ModelInferResponse* response) override;
+
+private:
+    ModelManager& manager;
+    PredictionServiceImpl& predictionService;
+};
+
+}  // namespace ovms
@@ -0,0 +1,152 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "grpcloadclient.hpp"
+
+#include <utility>
+
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow_serving/apis/get_model_metadata.pb.h"
+
+namespace ovms {
+namespace loadgen {
+
+GrpcLoadClient::GrpcLoadClient(const std::string& address, std::vector<tensorflow::serving::PredictRequest> requests,
+    std::chrono::milliseconds timeout, size_t channelsCount, size_t completionThreadsCount) :
+    requests(std::move(requests)),
+    timeout(timeout) {
+    for (size_t i = 0; i < channelsCount; ++i) {
+        stubs.push_back(tensorflow::serving::PredictionService::NewStub(createChannel(address)));
+    }
+    for (size_t i = 0; i < completionThreadsCount; ++i) {
+        completionThreads.emplace_back(&GrpcLoadClient::pollCompletionQueue, this);
+    }
+}
+
+GrpcLoadClient::~GrpcLoadClient() {
+    completionQueue.Shutdown();
+    for (auto& thread : completionThreads) {
+        thread.join();
+    }
+}
+
+std::shared_ptr<grpc::Channel> GrpcLoadClient::createChannel(const std::string& address) {
+    grpc::ChannelArguments arguments;
+    // channels do not share connection
+    arguments.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    arguments.SetMaxReceiveMessageSize(-1);
+    arguments.SetMaxSendMessageSize(-1);
+    return grpc::CreateCustomChannel(address, grpc::InsecureChannelCredentials(), arguments);
+}
+
+void GrpcLoadClient::send(size_t target, Callback onCompleted) {
+    auto call = new Call();
+    call->onCompleted = std::move(onCompleted);
+    call->context.set_deadline(std::chrono::system_clock::now() + timeout);
+    auto& stub = stubs[nextStub];
+    nextStub = (nextStub + 1) % stubs.size();
+    call->reader = stub->AsyncPredict(&call->context, requests[target], &completionQueue);
+    call->reader->Finish(&call->response, &call->status, call);
+}
+
+void GrpcLoadClient::pollCompletionQueue() {
+    void* tag;
+    bool ok;
+    while (completionQueue.Next(&tag, &ok)) {
+        std::unique_ptr<Call> call(static_cast<Call*>(tag));
+        call->onCompleted(call->status.ok() ? "" : "grpc " + toString(call->status.error_code()));
+    }
+}
+
+std::string GrpcLoadClient::toString(grpc::StatusCode code) {
+    switch (code) {
+    case grpc::StatusCode::OK:
+        return "OK";
+    case grpc::StatusCode::CANCELLED:
+        return "CANCELLED";
+    case grpc::StatusCode::INVALID_ARGUMENT:
+        return "INVALID_ARGUMENT";
+    case grpc::StatusCode::DEADLINE_EXCEEDED:
+        return "DEADLINE_EXCEEDED";
+    case grpc::StatusCode::NOT_FOUND:
+        return "NOT_FOUND";
+    case grpc::StatusCode::RESOURCE_EXHAUSTED:
+        return "RESOURCE_EXHAUSTED";
+    case grpc::StatusCode::FAILED_PRECONDITION:
+        return "FAILED_PRECONDITION";
+    case grpc::StatusCode::UNIMPLEMENTED:
+        return "UNIMPLEMENTED";
+    case grpc::StatusCode::INTERNAL:
+        return "INTERNAL";
+    case grpc::StatusCode::UNAVAILABLE:
+        return "UNAVAILABLE";
+    default:
+        return "code " + std::to_string(static_cast<int>(code));
+    }
+}
+
+std::string GrpcLoadClient::prepareRequest(const std::string& address, const std::string& name, int64_t version,
+    tensorflow::serving::PredictRequest& request) {
+    auto stub = tensorflow::serving::PredictionService::NewStub(createChannel(address));
+    tensorflow::serving::GetModelMetadataRequest metadataRequest;
+    metadataRequest.mutable_model_spec()->set_name(name);
+    if (version != 0) {
+        metadataRequest.mutable_model_spec()->mutable_version()->set_value(version);
+    }
+    metadataRequest.add_metadata_field("signature_def");
+    tensorflow::serving::GetModelMetadataResponse metadataResponse;
+    grpc::ClientContext context;
+    auto status = stub->GetModelMetadata(&context, metadataRequest, &metadataResponse);
+    if (!status.ok()) {
+        return "Getting metadata of " + name + " failed: " + status.error_message();
+    }
+    tensorflow::serving::SignatureDefMap signatures;
+    auto metadata = metadataResponse.metadata().find("signature_def");
+    if (metadata == metadataResponse.metadata().end() || !metadata->second.UnpackTo(&signatures)) {
+        return "Metadata of " + name + " has no signature";
+    }
+    auto signature = signatures.signature_def().find("serving_default");
+    if (signature == signatures.signature_def().end()) {
+        return "Metadata of " + name + " has no serving_default signature";
+    }
+
+    request.Clear();
+    request.mutable_model_spec()->set_name(name);
+    if (version != 0) {
+        request.mutable_model_spec()->mutable_version()->set_value(version);
+    }
+    for (const auto& [inputName, info] : signature->second.inputs()) {
+        auto& input = (*request.mutable_inputs())[inputName];
+        input.set_dtype(info.dtype());
+        size_t elements = 1;
+        for (const auto& dim : info.tensor_shape().dim()) {
+            const int64_t size = dim.size() > 0 ? dim.size() : 1;
+            input.mutable_tensor_shape()->add_dim()->set_size(size);
+            elements *= size;
+        }
+        // server reads these precisions from repeated fields
+        if (info.dtype() == tensorflow::DataType::DT_HALF) {
+            input.mutable_half_val()->Resize(elements, 0);
+        } else if (info.dtype() == tensorflow::DataType::DT_UINT16) {
+            input.mutable_int_val()->Resize(elements, 0);
+        } else {
+            input.mutable_tensor_content()->assign(elements * tensorflow::DataTypeSize(info.dtype()), '\0');
+        }
+    }
+    return "";
+}
+
+}  // namespace loadgen
+}  // namespace ovms
@@ -0,0 +1,78 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpcpp/grpcpp.h>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "loadgenerator.hpp"
+
+namespace ovms {
+namespace loadgen {
+
+/**
+ * @brief Sends predict requests through asynchronous gRPC stubs, responses are collected by completion queue threads
+ *
+ * Requests are spread over several channels, each with its own connection, so a single HTTP/2 connection
+ * does not limit the load.
+ */
+class GrpcLoadClient : public LoadClient {
+public:
+    GrpcLoadClient(const std::string& address, std::vector<tensorflow::serving::PredictRequest> requests,
+        std::chrono::milliseconds timeout, size_t channelsCount, size_t completionThreads);
+    ~GrpcLoadClient() override;
+
+    void send(size_t target, Callback onCompleted) override;
+
+    /**
+     * @brief Prepares request with inputs of model or pipeline read from its metadata, dynamic dimensions are set to 1
+     *
+     * @return empty string on success, error otherwise
+     */
+    static std::string prepareRequest(const std::string& address, const std::string& name, int64_t version,
+        tensorflow::serving::PredictRequest& request);
+
+private:
+    struct Call {
+        grpc::ClientContext context;
+        tensorflow::serving::PredictResponse response;
+        grpc::Status status;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<tensorflow::serving::PredictResponse>> reader;
+        Callback onCompleted;
+    };
+
+    static std::shared_ptr<grpc::Channel> createChannel(const std::string& address);
+    static std::string toString(grpc::StatusCode code);
+    void pollCompletionQueue();
+
+    const std::vector<tensorflow::serving::PredictRequest> requests;
+    const std::chrono::milliseconds timeout;
+    std::vector<std::unique_ptr<tensorflow::serving::PredictionService::Stub>> stubs;
+    size_t nextStub = 0;
+    grpc::CompletionQueue completionQueue;
+    std::vector<std::thread> completionThreads;
+};
+
+}  // namespace loadgen
+}  // namespace ovms
@@ -0,0 +1,155 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "latencyhistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace ovms {
+namespace loadgen {
+
+LatencyHistogram::LatencyHistogram(uint64_t highestTrackableValue) :
+    highestTrackableValue(highestTrackableValue),
+    counts(getIndex(highestTrackableValue) + 1, 0) {}
+
+size_t LatencyHistogram::getIndex(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return value;
+    }
+    // bucket doubles the range of the previous one, values in it are kept with the shift of its index
+    const uint32_t highestBit = 63 - __builtin_clzll(value);
+    const uint32_t shift = highestBit - SUB_BUCKET_BITS + 1;
+    const uint64_t subBucket = value >> shift;
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF_COUNT + (subBucket - SUB_BUCKET_HALF_COUNT);
+}
+
+uint64_t LatencyHistogram::getLowestEquivalentValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const uint64_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF_COUNT + 1;
+    const uint64_t subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF_COUNT + SUB_BUCKET_HALF_COUNT;
+    return subBucket << shift;
+}
+
+uint64_t LatencyHistogram::getHighestEquivalentValue(size_t index) {
+    return getLowestEquivalentValue(index + 1) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    value = std::min(value, highestTrackableValue);
+    ++counts[getIndex(value)];
+    ++totalCount;
+    min = std::min(min, value);
+    max = std::max(max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < other.counts.size(); ++i) {
+        if (other.counts[i] == 0) {
+            continue;
+        }
+        // histograms with lower trackable values are merged without loss
+        const size_t index = std::min(i, counts.size() - 1);
+        counts[index] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    min = std::min(min, other.min);
+    max = std::max(max, std::min(other.max, highestTrackableValue));
+}
+
+double LatencyHistogram::getMean() const {
+    if (totalCount == 0) {
+        return 0;
+    }
+    double sum = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i] != 0) {
+            sum += counts[i] * static_cast<double>(getLowestEquivalentValue(i) + getHighestEquivalentValue(i)) / 2;
+        }
+    }
+    return sum / totalCount;
+}
+
+double LatencyHistogram::getStdDeviation() const {
+    if (totalCount == 0) {
+        return 0;
+    }
+    const double mean = getMean();
+    double squares = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (counts[i] != 0) {
+            const double deviation = static_cast<double>(getLowestEquivalentValue(i) + getHighestEquivalentValue(i)) / 2 - mean;
+            squares += counts[i] * deviation * deviation;
+        }
+    }
+    return std::sqrt(squares / totalCount);
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (totalCount == 0) {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    const uint64_t countAtPercentile = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100 * totalCount)));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        cumulative += counts[i];
+        if (cumulative >= countAtPercentile) {
+            return std::min(getHighestEquivalentValue(i), max);
+        }
+    }
+    return max;
+}
+
+uint64_t LatencyHistogram::getCountAtOrBelow(uint64_t value) const {
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < counts.size() && getLowestEquivalentValue(i) <= value; ++i) {
+        cumulative += counts[i];
+    }
+    return cumulative;
+}
+
+void LatencyHistogram::writePercentileDistribution(std::ostream& out, double valueScale) const {
+    out << std::fixed;
+    out << std::setw(12) << "Value" << " " << std::setw(14) << "Percentile" << " " << std::setw(10) << "TotalCount"
+        << " " << std::setw(14) << "1/(1-Percentile)" << "\n\n";
+    double percentile = 0;
+    while (totalCount > 0) {
+        const uint64_t value = getValueAtPercentile(percentile);
+        const uint64_t count = getCountAtOrBelow(value);
+        out << std::setprecision(3) << std::setw(12) << value / valueScale << " "
+            << std::setprecision(12) << std::setw(14) << (count == totalCount ? 1.0 : percentile / 100) << " "
+            << std::setw(10) << count;
+        if (count == totalCount) {
+            out << "\n";
+            break;
+        }
+        out << " " << std::setprecision(2) << std::setw(14) << 1 / (1 - percentile / 100) << "\n";
+        // percentiles are reported more densely towards the tail, every half of remaining distance has the same number of ticks
+        const double halfDistance = std::pow(2, std::floor(std::log2(100 / (100 - percentile))) + 1);
+        percentile += 100 / (PERCENTILE_TICKS_PER_HALF_DISTANCE * halfDistance);
+    }
+    out << std::setprecision(3)
+        << "#[Mean    = " << std::setw(12) << getMean() / valueScale << ", StdDeviation   = " << std::setw(12) << getStdDeviation() / valueScale << "]\n"
+        << "#[Max     = " << std::setw(12) << getMax() / valueScale << ", Total count    = " << std::setw(12) << totalCount << "]\n"
+        << "#[Buckets = " << std::setw(12) << (counts.size() - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF_COUNT + 1
+        << ", SubBuckets     = " << std::setw(12) << SUB_BUCKET_COUNT << "]\n";
+}
+
+}  // namespace loadgen
+}  // namespace ovms
@@ -0,0 +1,86 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ovms {
+namespace loadgen {
+
+/**
+ * @brief High dynamic range histogram of latencies in microseconds
+ *
+ * Values are counted in log-linear buckets, every bucket is split into sub-buckets, so recorded values
+ * keep 3 significant digits in the whole range. Percentile distribution is written in HdrHistogram
+ * text format, so it can be plotted with HdrHistogram tools.
+ */
+class LatencyHistogram {
+public:
+    explicit LatencyHistogram(uint64_t highestTrackableValue = DEFAULT_HIGHEST_TRACKABLE_VALUE);
+
+    /**
+     * @brief Records value, values above highest trackable value are counted as the highest one
+     */
+    void record(uint64_t value);
+
+    void merge(const LatencyHistogram& other);
+
+    uint64_t getCount() const { return totalCount; }
+    uint64_t getMin() const { return totalCount == 0 ? 0 : min; }
+    uint64_t getMax() const { return max; }
+    double getMean() const;
+    double getStdDeviation() const;
+
+    /**
+     * @brief Gets the highest value, which is equivalent to the value below which the percentile of recorded values lies
+     *
+     * @param percentile from 0 to 100
+     */
+    uint64_t getValueAtPercentile(double percentile) const;
+
+    /**
+     * @brief Writes percentile distribution in HdrHistogram text format
+     *
+     * @param valueScale divides values, e.g. 1000 to output milliseconds
+     */
+    void writePercentileDistribution(std::ostream& out, double valueScale) const;
+
+    // 1 hour
+    static const uint64_t DEFAULT_HIGHEST_TRACKABLE_VALUE = 3'600'000'000;
+
+private:
+    // 2048 sub-buckets keep 3 significant digits of values
+    static const uint32_t SUB_BUCKET_BITS = 11;
+    static const uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const uint64_t SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2;
+    static const uint32_t PERCENTILE_TICKS_PER_HALF_DISTANCE = 5;
+
+    static size_t getIndex(uint64_t value);
+    static uint64_t getLowestEquivalentValue(size_t index);
+    static uint64_t getHighestEquivalentValue(size_t index);
+    uint64_t getCountAtOrBelow(uint64_t value) const;
+
+    const uint64_t highestTrackableValue;
+    std::vector<uint64_t> counts;
+    uint64_t totalCount = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+};
+
+}  // namespace loadgen
+}  // namespace ovms
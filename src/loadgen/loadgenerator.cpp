@@ -0,0 +1,209 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "loadgenerator.hpp"
+
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace ovms {
+namespace loadgen {
+
+namespace {
+// sleeping is less precise than that, remaining time is waited actively
+const std::chrono::microseconds SPIN_THRESHOLD{200};
+
+using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+void writeTargetJson(JsonWriter& writer, const TargetReport& report, double seconds) {
+    const auto& latency = report.latency;
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(report.name.c_str());
+    writer.Key("sent");
+    writer.Uint64(report.sent);
+    writer.Key("succeeded");
+    writer.Uint64(report.succeeded);
+    writer.Key("dropped");
+    writer.Uint64(report.dropped);
+    writer.Key("throughput");
+    writer.Double(seconds > 0 ? report.succeeded / seconds : 0);
+    writer.Key("latency_ms");
+    writer.StartObject();
+    for (const auto& [key, percentile] : {std::make_pair("p50", 50.0), std::make_pair("p90", 90.0), std::make_pair("p99", 99.0), std::make_pair("p999", 99.9)}) {
+        writer.Key(key);
+        writer.Double(latency.getValueAtPercentile(percentile) / 1000.0);
+    }
+    writer.Key("max");
+    writer.Double(latency.getMax() / 1000.0);
+    writer.Key("mean");
+    writer.Double(latency.getMean() / 1000.0);
+    writer.EndObject();
+    writer.Key("errors");
+    writer.StartObject();
+    for (const auto& [error, count] : report.errors) {
+        writer.Key(error.c_str());
+        writer.Uint64(count);
+    }
+    writer.EndObject();
+    writer.EndObject();
+}
+
+void waitUntil(std::chrono::steady_clock::time_point time) {
+    if (time - std::chrono::steady_clock::now() > SPIN_THRESHOLD) {
+        std::this_thread::sleep_until(time - SPIN_THRESHOLD);
+    }
+    while (std::chrono::steady_clock::now() < time) {
+    }
+}
+}  // namespace
+
+LoadGenerator::LoadGenerator(LoadClient& client, const std::vector<std::string>& targets, const LoadOptions& options) :
+    client(client),
+    options(options) {
+    for (const auto& name : targets) {
+        reports.emplace_back();
+        reports.back().name = name;
+    }
+}
+
+void LoadGenerator::run() {
+    using std::chrono::steady_clock;
+    std::mt19937_64 generator(options.seed);
+    std::exponential_distribution<double> poissonInterval(options.rate);
+    const std::chrono::duration<double> constantInterval(1 / options.rate);
+
+    const auto start = steady_clock::now();
+    const auto end = start + options.duration;
+    auto scheduled = start;
+    for (uint64_t i = 0; scheduled < end; ++i) {
+        waitUntil(scheduled);
+        const size_t target = i % reports.size();
+        bool drop = false;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++reports[target].sent;
+            drop = outstanding >= options.maxOutstanding;
+            if (drop) {
+                ++reports[target].dropped;
+            } else {
+                ++outstanding;
+            }
+        }
+        if (!drop) {
+            client.send(target, [this, target, scheduled](const std::string& error) {
+                onCompleted(target, scheduled, error);
+            });
+        }
+        const std::chrono::duration<double> interval = options.arrival == Arrival::POISSON
+                                                           ? std::chrono::duration<double>(poissonInterval(generator))
+                                                           : constantInterval;
+        scheduled += std::chrono::duration_cast<steady_clock::duration>(interval);
+    }
+    std::unique_lock<std::mutex> lock(mtx);
+    allCompleted.wait(lock, [this]() { return outstanding == 0; });
+    elapsed = steady_clock::now() - start;
+}
+
+void LoadGenerator::onCompleted(size_t target, std::chrono::steady_clock::time_point scheduled, const std::string& error) {
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - scheduled);
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& report = reports[target];
+    if (error.empty()) {
+        ++report.succeeded;
+        report.latency.record(latency.count());
+    } else {
+        ++report.errors[error];
+    }
+    if (--outstanding == 0) {
+        allCompleted.notify_all();
+    }
+}
+
+TargetReport LoadGenerator::getTotalReport() const {
+    TargetReport total;
+    total.name = "total";
+    for (const auto& report : reports) {
+        total.sent += report.sent;
+        total.succeeded += report.succeeded;
+        total.dropped += report.dropped;
+        for (const auto& [error, count] : report.errors) {
+            total.errors[error] += count;
+        }
+        total.latency.merge(report.latency);
+    }
+    return total;
+}
+
+void LoadGenerator::printTargetReport(std::ostream& out, const TargetReport& report, double seconds) {
+    const auto& latency = report.latency;
+    out << report.name << "\n"
+        << std::fixed << std::setprecision(1)
+        << "  sent: " << report.sent << ", succeeded: " << report.succeeded << ", dropped: " << report.dropped
+        << ", throughput: " << report.succeeded / seconds << " requests/s\n"
+        << std::setprecision(3)
+        << "  latency [ms] p50: " << latency.getValueAtPercentile(50) / 1000.0
+        << ", p90: " << latency.getValueAtPercentile(90) / 1000.0
+        << ", p99: " << latency.getValueAtPercentile(99) / 1000.0
+        << ", p999: " << latency.getValueAtPercentile(99.9) / 1000.0
+        << ", max: " << latency.getMax() / 1000.0
+        << ", mean: " << latency.getMean() / 1000.0 << "\n";
+    for (const auto& [error, count] : report.errors) {
+        out << "  error " << error << ": " << count << "\n";
+    }
+}
+
+void LoadGenerator::printReport(std::ostream& out) const {
+    const double seconds = elapsed.count();
+    if (reports.size() > 1) {
+        for (const auto& report : reports) {
+            printTargetReport(out, report, seconds);
+        }
+    }
+    printTargetReport(out, getTotalReport(), seconds);
+}
+
+void LoadGenerator::writeJsonReport(std::ostream& out) const {
+    const double seconds = elapsed.count();
+    rapidjson::StringBuffer buffer;
+    JsonWriter writer(buffer);
+    writer.StartObject();
+    writer.Key("rate");
+    writer.Double(options.rate);
+    writer.Key("duration_s");
+    writer.Uint64(options.duration.count());
+    writer.Key("arrival");
+    writer.String(options.arrival == Arrival::POISSON ? "poisson" : "constant");
+    writer.Key("elapsed_s");
+    writer.Double(seconds);
+    writer.Key("targets");
+    writer.StartArray();
+    for (const auto& report : reports) {
+        writeTargetJson(writer, report, seconds);
+    }
+    writer.EndArray();
+    writer.Key("total");
+    writeTargetJson(writer, getTotalReport(), seconds);
+    writer.EndObject();
+    out << buffer.GetString() << "\n";
+}
+
+}  // namespace loadgen
+}  // namespace ovms
@@ -0,0 +1,121 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "latencyhistogram.hpp"
+
+namespace ovms {
+namespace loadgen {
+
+/**
+ * @brief Sends prepared requests to models or pipelines, called from a single thread
+ */
+class LoadClient {
+public:
+    /**
+     * @brief Receives empty error on success, otherwise error category reported separately, e.g. "grpc UNAVAILABLE"
+     */
+    using Callback = std::function<void(const std::string& error)>;
+
+    virtual ~LoadClient() = default;
+
+    /**
+     * @brief Sends request of target asynchronously, onCompleted may be called on any thread
+     */
+    virtual void send(size_t target, Callback onCompleted) = 0;
+};
+
+enum class Arrival {
+    CONSTANT,
+    POISSON
+};
+
+struct LoadOptions {
+    // requests per second of all targets together
+    double rate = 100;
+    std::chrono::seconds duration{60};
+    Arrival arrival = Arrival::CONSTANT;
+    // requests above the limit are not sent and reported as dropped
+    size_t maxOutstanding = 10000;
+    uint64_t seed = 0;
+};
+
+struct TargetReport {
+    std::string name;
+    uint64_t sent = 0;
+    uint64_t succeeded = 0;
+    uint64_t dropped = 0;
+    std::map<std::string, uint64_t> errors;
+    LatencyHistogram latency;
+};
+
+/**
+ * @brief Generates open-loop load, requests are sent at scheduled times regardless of responses
+ *
+ * Latency is measured from the scheduled send time, so delays of the generator or the server are not hidden
+ * by postponing subsequent requests (coordinated omission). Targets are requested in turns.
+ */
+class LoadGenerator {
+public:
+    LoadGenerator(LoadClient& client, const std::vector<std::string>& targets, const LoadOptions& options);
+
+    /**
+     * @brief Sends requests for the configured duration and waits for all responses
+     */
+    void run();
+
+    const std::vector<TargetReport>& getReports() const { return reports; }
+
+    /**
+     * @brief Merges reports of all targets
+     */
+    TargetReport getTotalReport() const;
+
+    std::chrono::duration<double> getElapsed() const { return elapsed; }
+
+    void printReport(std::ostream& out) const;
+
+    /**
+     * @brief Writes load options, report of every target and total report as JSON, latencies in milliseconds
+     */
+    void writeJsonReport(std::ostream& out) const;
+
+private:
+    void onCompleted(size_t target, std::chrono::steady_clock::time_point scheduled, const std::string& error);
+    static void printTargetReport(std::ostream& out, const TargetReport& report, double seconds);
+
+    LoadClient& client;
+    const LoadOptions options;
+    std::vector<TargetReport> reports;
+    std::chrono::duration<double> elapsed{0};
+
+    std::mutex mtx;
+    std::condition_variable allCompleted;
+    size_t outstanding = 0;
+};
+
+}  // namespace loadgen
+}  // namespace ovms
@@ -0,0 +1,141 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cxxopts.hpp>
+
+#include "grpcloadclient.hpp"
+#include "loadgenerator.hpp"
+#include "restloadclient.hpp"
+#include "targets.hpp"
+
+using namespace ovms::loadgen;
+
+int main(int argc, char** argv) {
+    cxxopts::Options options(argv[0], "OpenVINO Model Server open-loop load generator");
+    // clang-format off
+    options.add_options()
+        ("help", "show this help message and exit")
+        ("grpc_address", "gRPC address of the server, model metadata is always read over gRPC",
+            cxxopts::value<std::string>()->default_value("localhost:9178"), "GRPC_ADDRESS")
+        ("rest_address", "REST address of the server",
+            cxxopts::value<std::string>()->default_value("localhost:5000"), "REST_ADDRESS")
+        ("protocol", "protocol of predict requests - grpc or rest",
+            cxxopts::value<std::string>()->default_value("grpc"), "PROTOCOL")
+        ("config_path", "server configuration file, all its models and pipelines are requested in turns",
+            cxxopts::value<std::string>(), "CONFIG_PATH")
+        ("model_name", "name of requested model, used when config_path is not set",
+            cxxopts::value<std::string>(), "MODEL_NAME")
+        ("model_version", "version of requested model, default version when 0",
+            cxxopts::value<int64_t>()->default_value("0"), "MODEL_VERSION")
+        ("rate", "requests per second of all models and pipelines together",
+            cxxopts::value<double>()->default_value("100"), "RATE")
+        ("duration", "seconds of sending requests",
+            cxxopts::value<uint>()->default_value("60"), "DURATION")
+        ("arrival", "distribution of request arrivals - constant or poisson",
+            cxxopts::value<std::string>()->default_value("constant"), "ARRIVAL")
+        ("timeout_ms", "deadline of a single request",
+            cxxopts::value<uint>()->default_value("10000"), "TIMEOUT_MS")
+        ("max_outstanding", "requests waiting for responses above which next requests are dropped",
+            cxxopts::value<size_t>()->default_value("10000"), "MAX_OUTSTANDING")
+        ("grpc_channels", "number of gRPC connections",
+            cxxopts::value<size_t>()->default_value("4"), "GRPC_CHANNELS")
+        ("grpc_completion_threads", "number of threads receiving gRPC responses",
+            cxxopts::value<size_t>()->default_value("2"), "GRPC_COMPLETION_THREADS")
+        ("histogram_output", "file for percentile distribution of all latencies in milliseconds in HdrHistogram format",
+            cxxopts::value<std::string>(), "HISTOGRAM_OUTPUT")
+        ("json_output", "file for report of options, every target and total in JSON format, latencies in milliseconds",
+            cxxopts::value<std::string>(), "JSON_OUTPUT");
+    // clang-format on
+
+    std::unique_ptr<cxxopts::ParseResult> result;
+    try {
+        result = std::make_unique<cxxopts::ParseResult>(options.parse(argc, argv));
+    } catch (const cxxopts::OptionException& e) {
+        std::cerr << "error parsing options: " << e.what() << std::endl;
+        return 1;
+    }
+    if (result->count("help") || (!result->count("config_path") && !result->count("model_name"))) {
+        std::cout << options.help() << std::endl;
+        return result->count("help") ? 0 : 1;
+    }
+
+    LoadOptions loadOptions;
+    loadOptions.rate = (*result)["rate"].as<double>();
+    loadOptions.duration = std::chrono::seconds((*result)["duration"].as<uint>());
+    loadOptions.maxOutstanding = (*result)["max_outstanding"].as<size_t>();
+    const auto arrival = (*result)["arrival"].as<std::string>();
+    const auto protocol = (*result)["protocol"].as<std::string>();
+    if (loadOptions.rate <= 0 || (arrival != "constant" && arrival != "poisson") || (protocol != "grpc" && protocol != "rest")) {
+        std::cerr << "rate must be positive, arrival constant or poisson and protocol grpc or rest" << std::endl;
+        return 1;
+    }
+    loadOptions.arrival = arrival == "poisson" ? Arrival::POISSON : Arrival::CONSTANT;
+
+    std::vector<Target> targets;
+    if (result->count("config_path")) {
+        auto error = readTargets((*result)["config_path"].as<std::string>(), targets);
+        if (!error.empty()) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    } else {
+        Target target;
+        target.name = (*result)["model_name"].as<std::string>();
+        target.version = (*result)["model_version"].as<int64_t>();
+        targets.push_back(target);
+    }
+
+    const auto grpcAddress = (*result)["grpc_address"].as<std::string>();
+    std::vector<tensorflow::serving::PredictRequest> requests(targets.size());
+    std::vector<std::string> names;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        auto error = prepareRequest(grpcAddress, targets[i], requests[i]);
+        if (!error.empty()) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        names.push_back(targets[i].name);
+    }
+
+    const std::chrono::milliseconds timeout((*result)["timeout_ms"].as<uint>());
+    std::unique_ptr<LoadClient> client;
+    if (protocol == "grpc") {
+        client = std::make_unique<GrpcLoadClient>(grpcAddress, requests, timeout,
+            (*result)["grpc_channels"].as<size_t>(), (*result)["grpc_completion_threads"].as<size_t>());
+    } else {
+        client = std::make_unique<RestLoadClient>((*result)["rest_address"].as<std::string>(), requests, timeout);
+    }
+
+    std::cout << "Sending " << loadOptions.rate << " requests/s over " << protocol << " for " << loadOptions.duration.count() << " s" << std::endl;
+    LoadGenerator generator(*client, names, loadOptions);
+    generator.run();
+    generator.printReport(std::cout);
+
+    if (result->count("histogram_output")) {
+        std::ofstream out((*result)["histogram_output"].as<std::string>());
+        generator.getTotalReport().latency.writePercentileDistribution(out, 1000);
+    }
+    if (result->count("json_output")) {
+        std::ofstream out((*result)["json_output"].as<std::string>());
+        generator.writeJsonReport(out);
+    }
+    return 0;
+}
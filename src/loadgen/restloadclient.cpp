@@ -0,0 +1,89 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "restloadclient.hpp"
+
+#include <utility>
+
+namespace ovms {
+namespace loadgen {
+
+namespace {
+void writeValues(std::string& json, const tensorflow::TensorShapeProto& shape, int dimension) {
+    json += "[";
+    for (int64_t i = 0; i < shape.dim(dimension).size(); ++i) {
+        if (i > 0) {
+            json += ",";
+        }
+        if (dimension + 1 < shape.dim_size()) {
+            writeValues(json, shape, dimension + 1);
+        } else {
+            json += "0";
+        }
+    }
+    json += "]";
+}
+}  // namespace
+
+RestLoadClient::RestLoadClient(const std::string& address, const std::vector<tensorflow::serving::PredictRequest>& requests,
+    std::chrono::milliseconds timeout) {
+    web::http::client::http_client_config config;
+    config.set_timeout(timeout);
+    client = std::make_unique<web::http::client::http_client>("http://" + address, config);
+    for (const auto& request : requests) {
+        std::string path = "/v1/models/" + request.model_spec().name();
+        if (request.model_spec().has_version()) {
+            path += "/versions/" + std::to_string(request.model_spec().version().value());
+        }
+        targets.push_back({path + ":predict", toJson(request)});
+    }
+}
+
+std::string RestLoadClient::toJson(const tensorflow::serving::PredictRequest& request) {
+    std::string json = "{\"inputs\": {";
+    bool first = true;
+    for (const auto& [name, input] : request.inputs()) {
+        if (!first) {
+            json += ", ";
+        }
+        first = false;
+        json += "\"" + name + "\": ";
+        if (input.tensor_shape().dim_size() == 0) {
+            json += "0";
+        } else {
+            writeValues(json, input.tensor_shape(), 0);
+        }
+    }
+    return json + "}}";
+}
+
+void RestLoadClient::send(size_t target, Callback onCompleted) {
+    client->request(web::http::methods::POST, targets[target].path, targets[target].body, "application/json")
+        .then([](web::http::http_response response) {
+            // response is complete once its body is received
+            return response.content_ready();
+        })
+        .then([onCompleted = std::move(onCompleted)](pplx::task<web::http::http_response> task) {
+            try {
+                const auto code = task.get().status_code();
+                onCompleted(code == web::http::status_codes::OK ? "" : "http " + std::to_string(code));
+            } catch (const std::exception& e) {
+                onCompleted(std::string("transport ") + e.what());
+            }
+        });
+}
+
+}  // namespace loadgen
+}  // namespace ovms
@@ -0,0 +1,58 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cpprest/http_client.h>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "loadgenerator.hpp"
+
+namespace ovms {
+namespace loadgen {
+
+/**
+ * @brief Sends predict requests in JSON column format to REST API, responses are handled by cpprest threads
+ */
+class RestLoadClient : public LoadClient {
+public:
+    RestLoadClient(const std::string& address, const std::vector<tensorflow::serving::PredictRequest>& requests,
+        std::chrono::milliseconds timeout);
+
+    void send(size_t target, Callback onCompleted) override;
+
+    /**
+     * @brief Writes inputs of request as JSON body of REST predict request in column format
+     */
+    static std::string toJson(const tensorflow::serving::PredictRequest& request);
+
+private:
+    struct Target {
+        std::string path;
+        std::string body;
+    };
+
+    std::unique_ptr<web::http::client::http_client> client;
+    std::vector<Target> targets;
+};
+
+}  // namespace loadgen
+}  // namespace ovms
@@ -0,0 +1,125 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "targets.hpp"
+
+#include <fstream>
+
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+
+#include "grpcloadclient.hpp"
+
+namespace ovms {
+namespace loadgen {
+
+namespace {
+const char* const PIPELINE_REQUEST_NODE_NAME = "request";
+
+void readPipelineInputs(const rapidjson::Value& pipeline, Target& target) {
+    const auto nodes = pipeline.FindMember("nodes");
+    if (nodes == pipeline.MemberEnd() || !nodes->value.IsArray()) {
+        return;
+    }
+    for (const auto& node : nodes->value.GetArray()) {
+        const auto modelName = node.FindMember("model_name");
+        const auto inputs = node.FindMember("inputs");
+        if (modelName == node.MemberEnd() || !modelName->value.IsString() || inputs == node.MemberEnd() || !inputs->value.IsArray()) {
+            continue;
+        }
+        for (const auto& input : inputs->value.GetArray()) {
+            if (!input.IsObject()) {
+                continue;
+            }
+            for (const auto& mapping : input.GetObject()) {
+                const auto& source = mapping.value;
+                if (!source.IsObject() || !source.HasMember("node_name") || !source["node_name"].IsString() ||
+                    !source.HasMember("data_item") || !source["data_item"].IsString() ||
+                    std::string(source["node_name"].GetString()) != PIPELINE_REQUEST_NODE_NAME) {
+                    continue;
+                }
+                target.pipelineInputs.emplace(source["data_item"].GetString(),
+                    std::make_pair(modelName->value.GetString(), mapping.name.GetString()));
+            }
+        }
+    }
+}
+}  // namespace
+
+std::string readTargets(const std::string& configPath, std::vector<Target>& targets) {
+    std::ifstream ifs(configPath);
+    if (!ifs.good()) {
+        return "Cannot open configuration file " + configPath;
+    }
+    rapidjson::Document config;
+    rapidjson::IStreamWrapper isw(ifs);
+    if (config.ParseStream(isw).HasParseError() || !config.IsObject()) {
+        return "Configuration file " + configPath + " is not valid JSON";
+    }
+    const auto models = config.FindMember("model_config_list");
+    if (models != config.MemberEnd() && models->value.IsArray()) {
+        for (const auto& model : models->value.GetArray()) {
+            if (model.IsObject() && model.HasMember("config") && model["config"].IsObject() &&
+                model["config"].HasMember("name") && model["config"]["name"].IsString()) {
+                Target target;
+                target.name = model["config"]["name"].GetString();
+                targets.push_back(target);
+            }
+        }
+    }
+    const auto pipelines = config.FindMember("pipeline_config_list");
+    if (pipelines != config.MemberEnd() && pipelines->value.IsArray()) {
+        for (const auto& pipeline : pipelines->value.GetArray()) {
+            if (pipeline.IsObject() && pipeline.HasMember("name") && pipeline["name"].IsString()) {
+                Target target;
+                target.name = pipeline["name"].GetString();
+                target.pipeline = true;
+                readPipelineInputs(pipeline, target);
+                targets.push_back(target);
+            }
+        }
+    }
+    if (targets.empty()) {
+        return "Configuration file " + configPath + " has no models or pipelines";
+    }
+    return "";
+}
+
+std::string prepareRequest(const std::string& grpcAddress, const Target& target, tensorflow::serving::PredictRequest& request) {
+    if (!target.pipeline) {
+        return GrpcLoadClient::prepareRequest(grpcAddress, target.name, target.version, request);
+    }
+    if (target.pipelineInputs.empty()) {
+        return "Inputs of pipeline " + target.name + " are not connected to any model";
+    }
+    request.Clear();
+    request.mutable_model_spec()->set_name(target.name);
+    for (const auto& [pipelineInput, modelInput] : target.pipelineInputs) {
+        tensorflow::serving::PredictRequest modelRequest;
+        auto error = GrpcLoadClient::prepareRequest(grpcAddress, modelInput.first, 0, modelRequest);
+        if (!error.empty()) {
+            return error;
+        }
+        auto input = modelRequest.inputs().find(modelInput.second);
+        if (input == modelRequest.inputs().end()) {
+            return "Model " + modelInput.first + " has no input " + modelInput.second + " used by pipeline " + target.name;
+        }
+        (*request.mutable_inputs())[pipelineInput] = input->second;
+    }
+    return "";
+}
+
+}  // namespace loadgen
+}  // namespace ovms
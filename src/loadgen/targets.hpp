@@ -0,0 +1,57 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+namespace ovms {
+namespace loadgen {
+
+/**
+ * @brief Model or pipeline requested by load generator
+ */
+struct Target {
+    std::string name;
+    int64_t version = 0;
+    bool pipeline = false;
+    // pipeline input name -> model name and its input fed directly by the pipeline input
+    std::map<std::string, std::pair<std::string, std::string>> pipelineInputs;
+};
+
+/**
+ * @brief Reads models and pipelines from server configuration file
+ *
+ * @return empty string on success, error otherwise
+ */
+std::string readTargets(const std::string& configPath, std::vector<Target>& targets);
+
+/**
+ * @brief Prepares predict request of target, shapes and precisions of inputs are read from model metadata over gRPC
+ *
+ * Pipelines have no metadata, so their inputs take shapes of model inputs they are connected to.
+ *
+ * @return empty string on success, error otherwise
+ */
+std::string prepareRequest(const std::string& grpcAddress, const Target& target, tensorflow::serving::PredictRequest& request);
+
+}  // namespace loadgen
+}  // namespace ovms
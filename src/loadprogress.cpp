@@ -0,0 +1,133 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "loadprogress.hpp"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace ovms {
+
+void LoadProgress::markPending(const std::string& modelName) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& progress = models[modelName];
+    progress.state = ModelLoadState::PENDING;
+    progress.started = std::chrono::steady_clock::now();
+}
+
+void LoadProgress::markFinished(const std::string& modelName, bool loaded) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = models.find(modelName);
+    if (it == models.end()) {
+        return;
+    }
+    it->second.state = loaded ? ModelLoadState::LOADED : ModelLoadState::FAILED;
+    it->second.loadTimeMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - it->second.started)
+                                          .count();
+}
+
+void LoadProgress::remove(const std::string& modelName) {
+    std::lock_guard<std::mutex> lock(mtx);
+    models.erase(modelName);
+}
+
+void LoadProgress::markStartupCompleted() {
+    std::lock_guard<std::mutex> lock(mtx);
+    startupCompleted = true;
+}
+
+void LoadProgress::markDraining() {
+    std::lock_guard<std::mutex> lock(mtx);
+    draining = true;
+}
+
+bool LoadProgress::isReady() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return startupCompleted && !draining;
+}
+
+bool LoadProgress::isDraining() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return draining;
+}
+
+size_t LoadProgress::count(ModelLoadState state) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t result = 0;
+    for (const auto& [name, progress] : models) {
+        if (progress.state == state) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+std::map<std::string, LoadProgress::ModelLoadProgress> LoadProgress::getModelsProgress() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return models;
+}
+
+const char* LoadProgress::toString(ModelLoadState state) {
+    switch (state) {
+    case ModelLoadState::PENDING:
+        return "PENDING";
+    case ModelLoadState::LOADED:
+        return "LOADED";
+    case ModelLoadState::FAILED:
+        return "FAILED";
+    }
+    return "UNKNOWN";
+}
+
+std::string LoadProgress::toJson() const {
+    bool ready = isReady();
+    auto progress = getModelsProgress();
+    std::map<ModelLoadState, size_t> counts;
+    for (const auto& [name, modelProgress] : progress) {
+        ++counts[modelProgress.state];
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("ready");
+    writer.Bool(ready);
+    writer.Key("draining");
+    writer.Bool(isDraining());
+    writer.Key("models_pending");
+    writer.Uint64(counts[ModelLoadState::PENDING]);
+    writer.Key("models_loaded");
+    writer.Uint64(counts[ModelLoadState::LOADED]);
+    writer.Key("models_failed");
+    writer.Uint64(counts[ModelLoadState::FAILED]);
+    writer.Key("models");
+    writer.StartArray();
+    for (const auto& [name, modelProgress] : progress) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(name.c_str());
+        writer.Key("state");
+        writer.String(toString(modelProgress.state));
+        writer.Key("load_time_ms");
+        writer.Uint64(modelProgress.loadTimeMilliseconds);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+}  // namespace ovms
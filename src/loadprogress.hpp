@@ -0,0 +1,74 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Load progress of models served from config, reported by health endpoints
+ *
+ * Each model is pending from the moment its config is applied until all of its versions are loaded or loading fails.
+ * Server becomes ready after startup load completes, models failing later do not change readiness.
+ * Draining server is not ready again, so load balancers stop sending requests to it before it exits.
+ */
+class LoadProgress {
+public:
+    enum class ModelLoadState {
+        PENDING,
+        LOADED,
+        FAILED
+    };
+
+    struct ModelLoadProgress {
+        ModelLoadState state = ModelLoadState::PENDING;
+        std::chrono::steady_clock::time_point started;
+        // duration of last finished load, 0 until the first load finishes
+        uint64_t loadTimeMilliseconds = 0;
+    };
+
+    void markPending(const std::string& modelName);
+    void markFinished(const std::string& modelName, bool loaded);
+    void remove(const std::string& modelName);
+
+    void markStartupCompleted();
+    void markDraining();
+    bool isReady() const;
+    bool isDraining() const;
+
+    size_t count(ModelLoadState state) const;
+    std::map<std::string, ModelLoadProgress> getModelsProgress() const;
+
+    /**
+     * @brief Serializes readiness, number of models in each state and per model load time to JSON
+     */
+    std::string toJson() const;
+
+    static const char* toString(ModelLoadState state);
+
+private:
+    mutable std::mutex mtx;
+    std::map<std::string, ModelLoadProgress> models;
+    bool startupCompleted = false;
+    bool draining = false;
+};
+
+}  // namespace ovms
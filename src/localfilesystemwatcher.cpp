@@ -0,0 +1,112 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "localfilesystemwatcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+
+#include <poll.h>
+#include <spdlog/spdlog.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace ovms {
+
+static const uint32_t WATCHED_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+LocalFileSystemWatcher::LocalFileSystemWatcher() :
+    fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+    if (fd < 0) {
+        spdlog::warn("Could not initialize inotify, errno: {}", errno);
+    }
+}
+
+LocalFileSystemWatcher::~LocalFileSystemWatcher() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+std::string LocalFileSystemWatcher::normalize(const std::string& path) {
+    auto normalized = std::filesystem::path(path).lexically_normal().string();
+    while (normalized.size() > 1 && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+bool LocalFileSystemWatcher::watchDirectory(const std::string& path) {
+    if (!isAvailable()) {
+        return false;
+    }
+    auto normalized = normalize(path);
+    if (watchedPaths.count(normalized)) {
+        return true;
+    }
+    int wd = inotify_add_watch(fd, normalized.c_str(), WATCHED_EVENTS);
+    if (wd < 0) {
+        SPDLOG_DEBUG("Could not watch directory: {}, errno: {}", normalized, errno);
+        return false;
+    }
+    watchedDirectories[wd] = normalized;
+    watchedPaths.insert(normalized);
+    return true;
+}
+
+void LocalFileSystemWatcher::readEvents(std::set<std::string>& changedDirectories) {
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char* ptr = buffer; ptr < buffer + length;) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+            auto it = watchedDirectories.find(event->wd);
+            if (it == watchedDirectories.end()) {
+                continue;
+            }
+            changedDirectories.insert(it->second);
+            if (event->mask & IN_IGNORED) {
+                // directory was removed, it has to be watched again if it is recreated
+                watchedPaths.erase(it->second);
+                watchedDirectories.erase(it);
+            }
+        }
+    }
+}
+
+std::set<std::string> LocalFileSystemWatcher::waitForChanges(const std::chrono::milliseconds timeout) {
+    std::set<std::string> changedDirectories;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    struct pollfd pfd = {fd, POLLIN, 0};
+    // events are collected until timeout, so a series of changes like copying of model files is handled once
+    for (auto now = std::chrono::steady_clock::now(); now < deadline; now = std::chrono::steady_clock::now()) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        int ready = poll(&pfd, 1, std::max<int64_t>(1, remaining.count()));
+        if (ready > 0) {
+            readEvents(changedDirectories);
+        } else if (ready < 0 && errno != EINTR) {
+            SPDLOG_DEBUG("Polling inotify events failed, errno: {}", errno);
+            std::this_thread::sleep_for(remaining);
+            break;
+        }
+    }
+    return changedDirectories;
+}
+
+}  // namespace ovms
@@ -0,0 +1,73 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Notifies about changes in local directories using inotify
+ *
+ * Directories are not watched recursively, every directory of interest has to be added.
+ * Watches of removed directories are dropped automatically.
+ */
+class LocalFileSystemWatcher {
+public:
+    LocalFileSystemWatcher();
+    ~LocalFileSystemWatcher();
+
+    LocalFileSystemWatcher(const LocalFileSystemWatcher&) = delete;
+    LocalFileSystemWatcher& operator=(const LocalFileSystemWatcher&) = delete;
+
+    /**
+     * @brief Checks if inotify instance could be created
+     */
+    bool isAvailable() const {
+        return fd >= 0;
+    }
+
+    /**
+     * @brief Starts watching directory for created, removed, moved and modified entries, no-op if it is watched already
+     *
+     * @return false if directory cannot be watched
+     */
+    bool watchDirectory(const std::string& path);
+
+    /**
+     * @brief Collects changes until timeout passes
+     *
+     * @return normalized paths of watched directories with changed entries
+     */
+    std::set<std::string> waitForChanges(const std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Normalizes path, so paths of the same directory can be compared
+     */
+    static std::string normalize(const std::string& path);
+
+private:
+    void readEvents(std::set<std::string>& changedDirectories);
+
+    int fd;
+    std::map<int, std::string> watchedDirectories;
+    std::set<std::string> watchedPaths;
+};
+
+}  // namespace ovms
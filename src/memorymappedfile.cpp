@@ -0,0 +1,54 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "memorymappedfile.hpp"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ovms {
+
+std::shared_ptr<MemoryMappedFile> MemoryMappedFile::map(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        SPDLOG_DEBUG("Could not open file: {} for mapping, errno: {}", path, errno);
+        return nullptr;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    const size_t length = fileStat.st_size;
+    void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    // mapping stays valid after descriptor is closed
+    close(fd);
+    if (address == MAP_FAILED) {
+        SPDLOG_DEBUG("Could not map file: {}, errno: {}", path, errno);
+        return nullptr;
+    }
+    return std::shared_ptr<MemoryMappedFile>(new MemoryMappedFile(address, length));
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    munmap(address, length);
+}
+
+}  // namespace ovms
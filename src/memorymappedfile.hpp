@@ -0,0 +1,60 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Read only mapping of a whole file, pages are shared with page cache and other processes mapping the file
+ *
+ * Mapped file must not be modified in place, accesses to truncated pages fault. Removing the file is safe, mapping keeps it alive.
+ */
+class MemoryMappedFile {
+public:
+    /**
+     * @brief Maps the file
+     *
+     * @return nullptr if file cannot be mapped, e.g. it does not exist or is empty
+     */
+    static std::shared_ptr<MemoryMappedFile> map(const std::string& path);
+
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    const void* data() const {
+        return address;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+private:
+    MemoryMappedFile(void* address, size_t length) :
+        address(address),
+        length(length) {}
+
+    void* address;
+    const size_t length;
+};
+
+}  // namespace ovms
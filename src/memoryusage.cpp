@@ -0,0 +1,46 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "memoryusage.hpp"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace ovms {
+
+uint64_t parseResidentPages(const std::string& statm) {
+    // size resident shared text lib data dt, in pages
+    std::istringstream stream(statm);
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (!(stream >> size >> resident)) {
+        return 0;
+    }
+    return resident;
+}
+
+uint64_t getResidentMemoryBytes() {
+    std::ifstream file("/proc/self/statm");
+    std::string statm;
+    if (!std::getline(file, statm)) {
+        return 0;
+    }
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    return pageSize > 0 ? parseResidentPages(statm) * static_cast<uint64_t>(pageSize) : 0;
+}
+
+}  // namespace ovms
@@ -0,0 +1,33 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Resident set size of the server process in bytes, 0 if it cannot be read
+ */
+uint64_t getResidentMemoryBytes();
+
+/**
+ * @brief Parses resident pages from content of /proc/self/statm, 0 if content is malformed
+ */
+uint64_t parseResidentPages(const std::string& statm);
+
+}  // namespace ovms
@@ -0,0 +1,217 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace ovms {
+
+namespace {
+
+template <typename T>
+void writeSample(std::ostream& out, const std::string& name, const std::string& labels, T value) {
+    out << name;
+    if (!labels.empty()) {
+        out << "{" << labels << "}";
+    }
+    out << " " << value << "\n";
+}
+
+std::string appendLabel(const std::string& labels, const std::string& label) {
+    return labels.empty() ? label : labels + "," + label;
+}
+
+}  // namespace
+
+const std::vector<double> MetricsRegistry::LATENCY_BUCKETS_SECONDS{
+    0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 60};
+
+void Counter::serialize(std::ostream& out, const std::string& name, const std::string& labels) const {
+    writeSample(out, name, labels, get());
+}
+
+void Gauge::serialize(std::ostream& out, const std::string& name, const std::string& labels) const {
+    writeSample(out, name, labels, get());
+}
+
+void UsageGauge::serialize(std::ostream& out, const std::string& name, const std::string& labels) const {
+    writeSample(out, name, labels, get());
+}
+
+Histogram::Histogram(std::vector<double> bounds) :
+    bounds(std::move(bounds)) {
+    for (auto& shard : shards) {
+        shard.buckets = std::make_unique<std::atomic<uint64_t>[]>(this->bounds.size() + 1);
+        for (size_t i = 0; i <= this->bounds.size(); ++i) {
+            shard.buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t Histogram::getThreadShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARDS_COUNT;
+    return shard;
+}
+
+void Histogram::observe(double value) {
+    const size_t bucket = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+    auto& shard = shards[getThreadShard()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    // shard is updated by few threads, so the loop is rarely repeated
+    double current = shard.sum.load(std::memory_order_relaxed);
+    while (!shard.sum.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t Histogram::getBucketCount(size_t bucket) const {
+    uint64_t total = 0;
+    for (const auto& shard : shards) {
+        total += shard.buckets[bucket].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t Histogram::getCount() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards) {
+        total += shard.count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+double Histogram::getSum() const {
+    double total = 0;
+    for (const auto& shard : shards) {
+        total += shard.sum.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Histogram::serialize(std::ostream& out, const std::string& name, const std::string& labels) const {
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        cumulative += getBucketCount(i);
+        std::stringstream le;
+        le << "le=\"" << bounds[i] << "\"";
+        writeSample(out, name + "_bucket", appendLabel(labels, le.str()), cumulative);
+    }
+    cumulative += getBucketCount(bounds.size());
+    writeSample(out, name + "_bucket", appendLabel(labels, "le=\"+Inf\""), cumulative);
+    writeSample(out, name + "_sum", labels, getSum());
+    writeSample(out, name + "_count", labels, getCount());
+}
+
+MetricsRegistry::Family& MetricsRegistry::getFamily(const std::string& name, const std::string& help, MetricType type) {
+    auto it = families.find(name);
+    if (it == families.end()) {
+        it = families.emplace(name, Family{help, type, {}}).first;
+    } else if (it->second.type != type) {
+        throw std::logic_error("Metric " + name + " is already registered as " + toString(it->second.type));
+    }
+    return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const metric_labels_t& labels) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& metric = getFamily(name, help, MetricType::COUNTER).metrics[serializeLabels(labels)];
+    if (!metric) {
+        metric = std::make_unique<Counter>();
+    }
+    return static_cast<Counter&>(*metric);
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const metric_labels_t& labels) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& metric = getFamily(name, help, MetricType::GAUGE).metrics[serializeLabels(labels)];
+    if (!metric) {
+        metric = std::make_unique<Gauge>();
+    }
+    return static_cast<Gauge&>(*metric);
+}
+
+UsageGauge& MetricsRegistry::usageGauge(const std::string& name, const std::string& help, const metric_labels_t& labels) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& metric = getFamily(name, help, MetricType::USAGE_GAUGE).metrics[serializeLabels(labels)];
+    if (!metric) {
+        metric = std::make_unique<UsageGauge>();
+    }
+    return static_cast<UsageGauge&>(*metric);
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const metric_labels_t& labels, const std::vector<double>& bounds) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& metric = getFamily(name, help, MetricType::HISTOGRAM).metrics[serializeLabels(labels)];
+    if (!metric) {
+        metric = std::make_unique<Histogram>(bounds);
+    }
+    return static_cast<Histogram&>(*metric);
+}
+
+std::string MetricsRegistry::serialize() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::stringstream out;
+    out << std::setprecision(10);
+    for (const auto& [name, family] : families) {
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << toString(family.type) << "\n";
+        for (const auto& [labels, metric] : family.metrics) {
+            metric->serialize(out, name, labels);
+        }
+    }
+    return out.str();
+}
+
+std::string MetricsRegistry::serializeLabels(const metric_labels_t& labels) {
+    std::string serialized;
+    for (const auto& [name, value] : labels) {
+        if (!serialized.empty()) {
+            serialized += ",";
+        }
+        serialized += name + "=\"";
+        for (char c : value) {
+            if (c == '\\' || c == '"') {
+                serialized += '\\';
+                serialized += c;
+            } else if (c == '\n') {
+                serialized += "\\n";
+            } else {
+                serialized += c;
+            }
+        }
+        serialized += "\"";
+    }
+    return serialized;
+}
+
+const char* MetricsRegistry::toString(MetricType type) {
+    switch (type) {
+    case MetricType::COUNTER:
+        return "counter";
+    case MetricType::GAUGE:
+    case MetricType::USAGE_GAUGE:
+        return "gauge";
+    case MetricType::HISTOGRAM:
+        return "histogram";
+    }
+    return "untyped";
+}
+
+}  // namespace ovms
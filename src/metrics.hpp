@@ -0,0 +1,194 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "shardedcounter.hpp"
+
+namespace ovms {
+
+using metric_labels_t = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Metric value updated without locks, serialized in Prometheus text format
+ */
+class Metric {
+public:
+    virtual ~Metric() = default;
+
+    virtual void serialize(std::ostream& out, const std::string& name, const std::string& labels) const = 0;
+};
+
+class Counter : public Metric {
+public:
+    void increment(uint64_t value = 1) { count.fetch_add(value, std::memory_order_relaxed); }
+
+    uint64_t get() const { return count.load(std::memory_order_relaxed); }
+
+    void serialize(std::ostream& out, const std::string& name, const std::string& labels) const override;
+
+private:
+    std::atomic<uint64_t> count{0};
+};
+
+class Gauge : public Metric {
+public:
+    void set(double value) { this->value.store(value, std::memory_order_relaxed); }
+
+    void increment(double delta = 1) {
+        double current = value.load(std::memory_order_relaxed);
+        while (!value.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        }
+    }
+
+    void decrement(double delta = 1) { increment(-delta); }
+
+    double get() const { return value.load(std::memory_order_relaxed); }
+
+    void serialize(std::ostream& out, const std::string& name, const std::string& labels) const override;
+
+private:
+    std::atomic<double> value{0};
+};
+
+/**
+ * @brief Gauge of resources in use, taken and returned by many threads at high rate
+ *
+ * Threads update separate shards of the count, summed when gauge is read.
+ */
+class UsageGauge : public Metric {
+public:
+    void increment() { count.increment(); }
+
+    void decrement() { count.decrement(); }
+
+    uint64_t get() const { return count.get(); }
+
+    void serialize(std::ostream& out, const std::string& name, const std::string& labels) const override;
+
+private:
+    ShardedCounter count;
+};
+
+/**
+ * @brief Counts observed values in buckets defined by ascending upper bounds, last bucket has no upper bound
+ *
+ * Threads update separate shards, so concurrent inferences do not contend on the same cache lines.
+ * Shards are summed when histogram is read.
+ */
+class Histogram : public Metric {
+public:
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    const std::vector<double>& getBounds() const { return bounds; }
+
+    /**
+     * @brief Counts values in the bucket only, bucket at position of bounds size counts values above all bounds
+     */
+    uint64_t getBucketCount(size_t bucket) const;
+
+    uint64_t getCount() const;
+
+    double getSum() const;
+
+    void serialize(std::ostream& out, const std::string& name, const std::string& labels) const override;
+
+    static constexpr size_t SHARDS_COUNT = 8;
+
+private:
+    struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+        std::atomic<uint64_t> count{0};
+        std::atomic<double> sum{0};
+    };
+
+    static size_t getThreadShard();
+
+    const std::vector<double> bounds;
+    std::array<Shard, SHARDS_COUNT> shards;
+};
+
+/**
+ * @brief Registry of server metrics exposed by metrics endpoint
+ *
+ * Metrics are identified by name and labels, registering the same metric again returns the existing one.
+ * Returned references stay valid for the lifetime of the server, so callers on hot paths keep them
+ * instead of looking metrics up for every update.
+ */
+class MetricsRegistry {
+public:
+    static MetricsRegistry& getInstance() {
+        static MetricsRegistry instance;
+        return instance;
+    }
+
+    Counter& counter(const std::string& name, const std::string& help, const metric_labels_t& labels = {});
+
+    Gauge& gauge(const std::string& name, const std::string& help, const metric_labels_t& labels = {});
+
+    UsageGauge& usageGauge(const std::string& name, const std::string& help, const metric_labels_t& labels = {});
+
+    Histogram& histogram(const std::string& name, const std::string& help, const metric_labels_t& labels, const std::vector<double>& bounds);
+
+    /**
+     * @brief Serializes all metrics in Prometheus text exposition format
+     */
+    std::string serialize() const;
+
+    /**
+     * @brief Upper bounds in seconds of histograms measuring latency, from 100 us to 1 min
+     */
+    static const std::vector<double> LATENCY_BUCKETS_SECONDS;
+
+private:
+    MetricsRegistry() = default;
+
+    enum class MetricType {
+        COUNTER,
+        GAUGE,
+        USAGE_GAUGE,
+        HISTOGRAM
+    };
+
+    struct Family {
+        std::string help;
+        MetricType type;
+        // keyed by serialized labels
+        std::map<std::string, std::unique_ptr<Metric>> metrics;
+    };
+
+    Family& getFamily(const std::string& name, const std::string& help, MetricType type);
+
+    static std::string serializeLabels(const metric_labels_t& labels);
+    static const char* toString(MetricType type);
+
+    mutable std::mutex mtx;
+    std::map<std::string, Family> families;
+};
+
+}  // namespace ovms
@@ -0,0 +1,109 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "microbatching.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "sharedmemory.hpp"
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+bool splitRequestToMicroBatches(const PredictRequest& request, size_t microBatchSize, std::vector<PredictRequest>& microBatches) {
+    if (request.inputs_size() == 0 || microBatchSize == 0) {
+        return false;
+    }
+    const auto& firstShape = request.inputs().begin()->second.tensor_shape();
+    if (firstShape.dim_size() == 0 || firstShape.dim(0).size() <= 0) {
+        return false;
+    }
+    const size_t batchSize = static_cast<size_t>(firstShape.dim(0).size());
+    if (batchSize <= microBatchSize) {
+        return false;
+    }
+    for (const auto& pair : request.inputs()) {
+        const auto& input = pair.second;
+        if (input.tensor_shape().dim_size() == 0 || static_cast<size_t>(input.tensor_shape().dim(0).size()) != batchSize ||
+            input.tensor_content().empty() || isSharedMemoryInput(input) || input.tensor_content().size() % batchSize != 0) {
+            return false;
+        }
+    }
+
+    const size_t microBatchesCount = (batchSize + microBatchSize - 1) / microBatchSize;
+    microBatches.clear();
+    microBatches.resize(microBatchesCount);
+    for (size_t i = 0; i < microBatchesCount; ++i) {
+        auto& microBatch = microBatches[i];
+        *microBatch.mutable_model_spec() = request.model_spec();
+        *microBatch.mutable_output_filter() = request.output_filter();
+        const size_t first = i * microBatchSize;
+        const size_t count = std::min(microBatchSize, batchSize - first);
+        for (const auto& pair : request.inputs()) {
+            const auto& input = pair.second;
+            const size_t rowSize = input.tensor_content().size() / batchSize;
+            auto& microBatchInput = (*microBatch.mutable_inputs())[pair.first];
+            microBatchInput.set_dtype(input.dtype());
+            *microBatchInput.mutable_tensor_shape() = input.tensor_shape();
+            microBatchInput.mutable_tensor_shape()->mutable_dim(0)->set_size(microBatchSize);
+            auto* content = microBatchInput.mutable_tensor_content();
+            content->reserve(microBatchSize * rowSize);
+            content->assign(input.tensor_content(), first * rowSize, count * rowSize);
+            content->resize(microBatchSize * rowSize, '\0');
+        }
+    }
+    return true;
+}
+
+Status mergeMicroBatchResponses(std::vector<PredictResponse>& microBatchResponses, size_t batchSize, PredictResponse& response) {
+    if (microBatchResponses.empty()) {
+        return StatusCode::INTERNAL_ERROR;
+    }
+    for (auto& pair : *microBatchResponses.front().mutable_outputs()) {
+        const auto& name = pair.first;
+        const auto& firstOutput = pair.second;
+        if (firstOutput.tensor_shape().dim_size() == 0 || firstOutput.tensor_shape().dim(0).size() <= 0) {
+            SPDLOG_DEBUG("Output {} of micro-batch has no batch dimension", name);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        const size_t microBatchSize = static_cast<size_t>(firstOutput.tensor_shape().dim(0).size());
+        const size_t rowSize = firstOutput.tensor_content().size() / microBatchSize;
+        auto& output = (*response.mutable_outputs())[name];
+        output.set_dtype(firstOutput.dtype());
+        *output.mutable_tensor_shape() = firstOutput.tensor_shape();
+        auto* content = output.mutable_tensor_content();
+        content->clear();
+        content->reserve(batchSize * rowSize);
+        for (auto& microBatchResponse : microBatchResponses) {
+            auto it = microBatchResponse.outputs().find(name);
+            if (it == microBatchResponse.outputs().end() || it->second.tensor_content().size() != microBatchSize * rowSize) {
+                SPDLOG_DEBUG("Output {} differs between micro-batches", name);
+                return StatusCode::INTERNAL_ERROR;
+            }
+            content->append(it->second.tensor_content());
+        }
+        // last micro-batch holds padding
+        content->resize(batchSize * rowSize);
+        output.mutable_tensor_shape()->mutable_dim(0)->set_size(batchSize);
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,40 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <vector>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Splits request along batch dimension into micro-batches of microBatchSize, the last one is padded with zeros
+ *
+ * @return false if inputs differ in batch size, batch size does not exceed microBatchSize or inputs are not sent as tensor content
+ */
+bool splitRequestToMicroBatches(const tensorflow::serving::PredictRequest& request, size_t microBatchSize,
+    std::vector<tensorflow::serving::PredictRequest>& microBatches);
+
+/**
+ * @brief Concatenates outputs of micro-batch responses along batch dimension and crops the padding of the last micro-batch
+ */
+Status mergeMicroBatchResponses(std::vector<tensorflow::serving::PredictResponse>& microBatchResponses, size_t batchSize,
+    tensorflow::serving::PredictResponse& response);
+
+}  // namespace ovms
@@ -20,13 +20,11 @@
 #include <utility>
 
 namespace ovms {
-const std::map<model_version_t, const ModelInstance&> Model::getModelVersionsMapCopy() const {
-    std::shared_lock lock(modelVersionsMtx);
-    std::map<model_version_t, const ModelInstance&> modelInstancesMapCopy;
-    for (auto& [modelVersion, modelInstancePtr] : modelVersions) {
-        modelInstancesMapCopy.insert({modelVersion, *modelInstancePtr});
-    }
-    return std::move(modelInstancesMapCopy);
+const std::map<model_version_t, std::shared_ptr<const ModelInstance>> Model::getModelVersionsMapCopy() const {
+    // read from published snapshot, status requests must not wait for versions being added
+    return modelVersionsSnapshot.read([](const auto& versions) {
+        return std::map<model_version_t, std::shared_ptr<const ModelInstance>>(versions.begin(), versions.end());
+    });
 }
 
 const std::map<model_version_t, std::shared_ptr<ModelInstance>>& Model::getModelVersions() const {
@@ -43,6 +41,16 @@ void Model::updateDefaultVersion() {
         }
     }
     defaultVersion = newDefaultVersion;
+    std::shared_lock lock(modelVersionsMtx);
+    version_weights_t availableWeights;
+    for (const auto& [version, weight] : versionWeights) {
+        auto it = modelVersions.find(version);
+        if (it != modelVersions.end() && ModelVersionState::AVAILABLE == it->second->getStatus().getState()) {
+            availableWeights.emplace(version, weight);
+        }
+    }
+    lock.unlock();
+    versionSelector.publish(WeightedVersionSelector(availableWeights));
     if (newDefaultVersion) {
         SPDLOG_INFO("Updated default version for model:{}, to:{}", getName(), newDefaultVersion);
     } else {
@@ -51,14 +59,59 @@ void Model::updateDefaultVersion() {
 }
 
 const std::shared_ptr<ModelInstance> Model::getDefaultModelInstance() const {
-    std::shared_lock lock(modelVersionsMtx);
-    auto defaultVersion = getDefaultVersion();
-    const auto modelInstanceIt = modelVersions.find(defaultVersion);
+    return getModelInstanceByVersion(getDefaultVersion());
+}
+
+const std::shared_ptr<ModelInstance> Model::getRoutedModelInstance(uint64_t sequenceId) const {
+    if (sequenceId != 0) {
+        auto instance = getSequenceModelInstance(sequenceId);
+        if (instance) {
+            return instance;
+        }
+    }
+    auto isAvailable = [this](model_version_t version) {
+        auto instance = getModelInstanceByVersion(version);
+        return instance && ModelVersionState::AVAILABLE == instance->getStatus().getState();
+    };
+    auto version = versionSelector.read([](const auto& selector) {
+        return selector.select();
+    });
+    if (version != 0 && !isAvailable(version)) {
+        // reloading or retired after selector was built, weights are normalized over versions still available
+        version = versionSelector.read([&isAvailable](const auto& selector) {
+            return selector.selectFiltered(isAvailable);
+        });
+    }
+    auto instance = version != 0 ? getModelInstanceByVersion(version) : nullptr;
+    if (!instance) {
+        return getDefaultModelInstance();
+    }
+    instance->getMetrics().weightedRoutes.increment();
+    return instance;
+}
 
-    if (modelVersions.end() == modelInstanceIt) {
+std::shared_ptr<ModelInstance> Model::getSequenceModelInstance(uint64_t sequenceId) const {
+    return modelVersionsSnapshot.read([sequenceId](const auto& versions) -> std::shared_ptr<ModelInstance> {
+        for (const auto& [version, instance] : versions) {
+            auto sequenceManager = instance->getSequenceManager();
+            if (sequenceManager != nullptr && sequenceManager->hasSequence(sequenceId) &&
+                ModelVersionState::AVAILABLE == instance->getStatus().getState()) {
+                return instance;
+            }
+        }
         return nullptr;
+    });
+}
+
+void Model::setVersionWeights(const version_weights_t& weights) {
+    std::unique_lock lock(modelVersionsMtx);
+    if (versionWeights == weights) {
+        return;
     }
-    return modelInstanceIt->second;
+    versionWeights = weights;
+    lock.unlock();
+    spdlog::info("Model: {} requests without version are routed by {} version weights", getName(), weights.size());
+    updateDefaultVersion();
 }
 
 std::shared_ptr<ovms::ModelInstance> Model::modelInstanceFactory() {
@@ -75,6 +128,7 @@ Status Model::addVersion(const ModelConfig& config) {
     const auto& version = config.getVersion();
     std::unique_lock lock(modelVersionsMtx);
     modelVersions[version] = std::move(modelInstance);
+    modelVersionsSnapshot.publish(modelVersions);
     lock.unlock();
     updateDefaultVersion();
     return StatusCode::OK;
@@ -145,16 +199,25 @@ Status Model::reloadVersions(std::shared_ptr<model_versions_t> versionsToReload,
             result = StatusCode::UNKNOWN_ERROR;
             continue;
         }
-        status = modelVersion->reloadModel(config);
+        // replacement is loaded side by side, requests are served by current instance until it is published
+        std::shared_ptr<ModelInstance> replacement = modelInstanceFactory();
+        status = replacement->loadModel(config);
         if (!status.ok()) {
             spdlog::error("Error occurred while loading model: {}; version: {}; error: {}",
                 getName(),
                 version,
                 status.string());
             result = status;
-            continue;
         }
+        std::unique_lock lock(modelVersionsMtx);
+        modelVersions[version] = replacement;
+        modelVersionsSnapshot.publish(modelVersions);
+        lock.unlock();
         updateDefaultVersion();
+        if (!modelVersion->getStatus().willEndUnloaded()) {
+            // waits for requests holding unload guards of replaced instance
+            modelVersion->unloadModel();
+        }
     }
     return result;
 }
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <shared_mutex>
@@ -23,6 +24,8 @@
 #include <vector>
 
 #include "modelinstance.hpp"
+#include "readsnapshot.hpp"
+#include "versionrouting.hpp"
 
 namespace ovms {
 /**
@@ -35,11 +38,31 @@ private:
      */
     mutable std::shared_mutex modelVersionsMtx;
 
+    /**
+     * @brief Copy of modelVersions published on each change, read by request lookups without locking modelVersionsMtx
+     */
+    ReadSnapshot<std::map<model_version_t, std::shared_ptr<ModelInstance>>> modelVersionsSnapshot;
+
+    /**
+     * @brief Weights of versions from config, protected by modelVersionsMtx
+     */
+    version_weights_t versionWeights;
+
+    /**
+     * @brief Selector of available weighted versions, rebuilt with default version
+     */
+    ReadSnapshot<WeightedVersionSelector> versionSelector;
+
     /**
          * @brief Update default version
          */
     void updateDefaultVersion();
 
+    /**
+         * @brief Finds available version of stateful model holding sequence
+         */
+    std::shared_ptr<ModelInstance> getSequenceModelInstance(uint64_t sequenceId) const;
+
 protected:
     /**
          * @brief Model name
@@ -121,11 +144,11 @@ public:
     const std::map<model_version_t, std::shared_ptr<ModelInstance>>& getModelVersions() const;
 
     /**
-     * @brief Gets model versions instances
+     * @brief Gets model versions instances, instances stay valid even if these are replaced by reload
      *
      * @return model versions instances
      */
-    const std::map<model_version_t, const ModelInstance&> getModelVersionsMapCopy() const;
+    const std::map<model_version_t, std::shared_ptr<const ModelInstance>> getModelVersionsMapCopy() const;
 
     /**
          * @brief Finds ModelInstance with specific version
@@ -135,11 +158,32 @@ public:
          * @return specific model version
          */
     const std::shared_ptr<ModelInstance> getModelInstanceByVersion(const model_version_t& version) const {
-        std::shared_lock lock(modelVersionsMtx);
-        auto it = modelVersions.find(version);
-        return it != modelVersions.end() ? it->second : nullptr;
+        return modelVersionsSnapshot.read([&version](const auto& versions) -> std::shared_ptr<ModelInstance> {
+            auto it = versions.find(version);
+            return it != versions.end() ? it->second : nullptr;
+        });
     }
 
+    /**
+         * @brief Gets ModelInstance serving request without version, picked by version weights if these are configured
+         *
+         * Versions which are not available are skipped and weights of the others are normalized. Falls back
+         * to default version if none of the weighted versions is available. Requests continuing a sequence of
+         * stateful model are pinned to the version the sequence was started on.
+         *
+         * @param sequenceId id of sequence continued by request, 0 if request does not continue a sequence
+         *
+         * @return ModelInstance
+         */
+    const std::shared_ptr<ModelInstance> getRoutedModelInstance(uint64_t sequenceId = 0) const;
+
+    /**
+         * @brief Sets weights of versions serving requests without version
+         *
+         * @param weights versions weights, empty routes requests to default version
+         */
+    void setVersionWeights(const version_weights_t& weights);
+
     /**
          * @brief Adds new versions of ModelInstance
          *
@@ -166,6 +210,9 @@ public:
     /**
          * @brief Reloads versions of Model
          *
+         * New instance of every version is loaded while current one keeps serving requests. It is published
+         * in place of current instance, which is unloaded after requests holding its unload guards finish.
+         *
          * @param config model configuration
          *
          * @return status
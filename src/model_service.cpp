@@ -27,6 +27,7 @@
 #include "tensorflow_serving/apis/model_service.pb.h"
 
 #include "modelmanager.hpp"
+#include "requestlogging.hpp"
 #include "status.hpp"
 
 using google::protobuf::util::JsonPrintOptions;
@@ -35,13 +36,15 @@ using google::protobuf::util::MessageToJsonString;
 namespace ovms {
 
 void addStatusToResponse(tensorflow::serving::GetModelStatusResponse* response, model_version_t version, const ModelVersionStatus& model_version_status) {
-    SPDLOG_DEBUG("add_status_to_response version={} status={}", version, model_version_status.getStateString());
+    // state and error code are read at once, version may be reloading meanwhile
+    const auto snapshot = model_version_status.getSnapshot();
+    SPDLOG_DEBUG("add_status_to_response version={} status={}", version, snapshot.getStateString());
     auto status_to_fill = response->add_model_version_status();
-    status_to_fill->set_state(static_cast<tensorflow::serving::ModelVersionStatus_State>(static_cast<int>(model_version_status.getState())));
+    status_to_fill->set_state(static_cast<tensorflow::serving::ModelVersionStatus_State>(static_cast<int>(snapshot.state)));
     status_to_fill->set_version(version);
     status_to_fill->clear_status();
-    status_to_fill->mutable_status()->set_error_code(static_cast<tensorflow::error::Code>(static_cast<int>(model_version_status.getErrorCode())));
-    status_to_fill->mutable_status()->set_error_message(model_version_status.getErrorMsg());
+    status_to_fill->mutable_status()->set_error_code(static_cast<tensorflow::error::Code>(static_cast<int>(snapshot.errorCode)));
+    status_to_fill->mutable_status()->set_error_message(snapshot.getErrorMsg());
 }
 
 ::grpc::Status ModelServiceImpl::GetModelStatus(
@@ -82,7 +85,7 @@ Status GetModelStatusImpl::getModelStatus(const tensorflow::serving::GetModelSta
     std::string requested_model_name = request->model_spec().name();
     auto model_ptr = ModelManager::getInstance().findModelByName(requested_model_name);
     if (!model_ptr) {
-        SPDLOG_INFO("requested model {} was not found", requested_model_name);
+        OVMS_REQUEST_DEBUG("requested model {} was not found", requested_model_name);
         return StatusCode::MODEL_NAME_MISSING;
     }
 
@@ -91,19 +94,15 @@ Status GetModelStatusImpl::getModelStatus(const tensorflow::serving::GetModelSta
         // return details only for a specific version of requested model; NOT_FOUND otherwise. If requested_version == 0, default is returned.
         std::shared_ptr<ModelInstance> model_instance = model_ptr->getModelInstanceByVersion(requested_version);
         if (!model_instance) {
-            SPDLOG_INFO("requested model {} in version {} was not found.", requested_model_name, requested_version);
+            OVMS_REQUEST_DEBUG("requested model {} in version {} was not found.", requested_model_name, requested_version);
             return StatusCode::MODEL_VERSION_MISSING;
         }
-        const auto& status = model_instance->getStatus();
-        SPDLOG_DEBUG("adding model {} - {} :: {} to response", requested_model_name, requested_version, status.getStateString());
-        addStatusToResponse(response, requested_version, status);
+        addStatusToResponse(response, requested_version, model_instance->getStatus());
     } else {
         // return status details of all versions of a requested model.
         auto modelVersionsInstances = model_ptr->getModelVersionsMapCopy();
         for (const auto& [modelVersion, modelInstance] : modelVersionsInstances) {
-            const auto& status = modelInstance.getStatus();
-            SPDLOG_DEBUG("adding model {} - {} :: {} to response", requested_model_name, modelVersion, status.getStateString());
-            addStatusToResponse(response, modelVersion, status);
+            addStatusToResponse(response, modelVersion, modelInstance->getStatus());
         }
     }
     SPDLOG_DEBUG("model_service: response: {}", response->DebugString());
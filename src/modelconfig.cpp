@@ -54,6 +54,88 @@ bool ModelConfig::isReloadRequired(const ModelConfig& rhs) const {
         spdlog::debug("ModelConfig {} reload required due to nireq mismatch", this->name);
         return true;
     }
+    if (this->maxBatchSize != rhs.maxBatchSize || this->batchTimeoutMicroseconds != rhs.batchTimeoutMicroseconds) {
+        spdlog::debug("ModelConfig {} reload required due to dynamic batching mismatch", this->name);
+        return true;
+    }
+    if (this->maxQueueSize != rhs.maxQueueSize || this->maxQueueTimeMicroseconds != rhs.maxQueueTimeMicroseconds ||
+        this->reservedHighPriorityStreams != rhs.reservedHighPriorityStreams || this->maxLowPriorityQueueSize != rhs.maxLowPriorityQueueSize) {
+        spdlog::debug("ModelConfig {} reload required due to admission control mismatch", this->name);
+        return true;
+    }
+    if (this->warmupIterations != rhs.warmupIterations) {
+        spdlog::debug("ModelConfig {} reload required due to warm-up iterations mismatch", this->name);
+        return true;
+    }
+    if (this->loadOnDemand != rhs.loadOnDemand || this->idleUnloadSeconds != rhs.idleUnloadSeconds) {
+        spdlog::debug("ModelConfig {} reload required due to load on demand mismatch", this->name);
+        return true;
+    }
+    if (this->numaNode != rhs.numaNode) {
+        spdlog::debug("ModelConfig {} reload required due to NUMA node mismatch", this->name);
+        return true;
+    }
+    if (this->isolationGroup != rhs.isolationGroup) {
+        spdlog::debug("ModelConfig {} reload required due to isolation group mismatch", this->name);
+        return true;
+    }
+    if (this->replicaDevices != rhs.replicaDevices) {
+        spdlog::debug("ModelConfig {} reload required due to replica devices mismatch", this->name);
+        return true;
+    }
+    if (this->cpuStreamsShare != rhs.cpuStreamsShare) {
+        spdlog::debug("ModelConfig {} reload required due to CPU streams share mismatch", this->name);
+        return true;
+    }
+    if (this->autoTune != rhs.autoTune || this->autoTuneLatencySloMilliseconds != rhs.autoTuneLatencySloMilliseconds ||
+        this->autoTuneMeasurementMilliseconds != rhs.autoTuneMeasurementMilliseconds) {
+        spdlog::debug("ModelConfig {} reload required due to auto-tuning mismatch", this->name);
+        return true;
+    }
+    if (this->shapeBuckets != rhs.shapeBuckets || this->shapeBucketDimension != rhs.shapeBucketDimension) {
+        spdlog::debug("ModelConfig {} reload required due to shape buckets mismatch", this->name);
+        return true;
+    }
+    if (this->microBatching != rhs.microBatching) {
+        spdlog::debug("ModelConfig {} reload required due to micro-batching mismatch", this->name);
+        return true;
+    }
+    if (this->overlapRequestProcessing != rhs.overlapRequestProcessing) {
+        spdlog::debug("ModelConfig {} reload required due to request processing overlap mismatch", this->name);
+        return true;
+    }
+    if (this->requestCoalescing != rhs.requestCoalescing) {
+        spdlog::debug("ModelConfig {} reload required due to request coalescing mismatch", this->name);
+        return true;
+    }
+    if (this->sharedGpuContext != rhs.sharedGpuContext) {
+        spdlog::debug("ModelConfig {} reload required due to shared GPU context mismatch", this->name);
+        return true;
+    }
+    if (this->responseCacheSizeMegabytes != rhs.responseCacheSizeMegabytes || this->responseCacheTtlSeconds != rhs.responseCacheTtlSeconds) {
+        spdlog::debug("ModelConfig {} reload required due to response cache mismatch", this->name);
+        return true;
+    }
+    if (this->nodeOutputCacheSizeMegabytes != rhs.nodeOutputCacheSizeMegabytes || this->nodeOutputCacheTtlMilliseconds != rhs.nodeOutputCacheTtlMilliseconds) {
+        spdlog::debug("ModelConfig {} reload required due to node output cache mismatch", this->name);
+        return true;
+    }
+    if (this->hedging != rhs.hedging || this->hedgingPercentile != rhs.hedgingPercentile || this->hedgingBudgetPercent != rhs.hedgingBudgetPercent) {
+        spdlog::debug("ModelConfig {} reload required due to hedging mismatch", this->name);
+        return true;
+    }
+    if (this->stateful != rhs.stateful || this->sequenceTimeoutSeconds != rhs.sequenceTimeoutSeconds || this->maxSequenceNumber != rhs.maxSequenceNumber) {
+        spdlog::debug("ModelConfig {} reload required due to stateful mismatch", this->name);
+        return true;
+    }
+    if (this->preprocessing != rhs.preprocessing) {
+        spdlog::debug("ModelConfig {} reload required due to preprocessing mismatch", this->name);
+        return true;
+    }
+    if (this->postprocessing != rhs.postprocessing) {
+        spdlog::debug("ModelConfig {} reload required due to postprocessing mismatch", this->name);
+        return true;
+    }
     if (this->pluginConfig != rhs.pluginConfig) {
         spdlog::debug("ModelConfig {} reload required due to plugin config mismatch", this->name);
         return true;
@@ -66,6 +148,18 @@ bool ModelConfig::isReloadRequired(const ModelConfig& rhs) const {
         spdlog::debug("ModelConfig {} reload required due to named layout mismatch", this->name);
         return true;
     }
+    if (this->precision != rhs.precision) {
+        spdlog::debug("ModelConfig {} reload required due to no named precision mismatch", this->name);
+        return true;
+    }
+    if (this->precisions != rhs.precisions) {
+        spdlog::debug("ModelConfig {} reload required due to named precision mismatch", this->name);
+        return true;
+    }
+    if (this->outputPrecision != rhs.outputPrecision || this->outputPrecisions != rhs.outputPrecisions) {
+        spdlog::debug("ModelConfig {} reload required due to output precision mismatch", this->name);
+        return true;
+    }
     if (!isShapeConfigurationEqual(rhs)) {
         spdlog::debug("ModelConfig {} reload required due to shape configuration mismatch", this->name);
         return true;
@@ -369,12 +463,182 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
         }
     }
 
+    if (v.HasMember("precision")) {
+        if (v["precision"].IsString()) {
+            this->setPrecision(v["precision"].GetString());
+        } else {
+            for (auto& s : v["precision"].GetObject()) {
+                this->addPrecision(s.name.GetString(), s.value.GetString());
+            }
+        }
+    }
+
+    if (v.HasMember("output_precision")) {
+        if (v["output_precision"].IsString()) {
+            this->setOutputPrecision(v["output_precision"].GetString());
+        } else {
+            for (auto& s : v["output_precision"].GetObject()) {
+                this->addOutputPrecision(s.name.GetString(), s.value.GetString());
+            }
+        }
+    }
+
     if (v.HasMember("plugin_config")) {
         if (!parsePluginConfig(v["plugin_config"]).ok()) {
             SPDLOG_ERROR("Couldn't parse plugin config");
         }
     }
 
+    if (v.HasMember("dynamic_batching")) {
+        const auto& dynamicBatching = v["dynamic_batching"];
+        this->setMaxBatchSize(dynamicBatching["max_batch_size"].GetUint64());
+        if (dynamicBatching.HasMember("timeout_us"))
+            this->setBatchTimeoutMicroseconds(dynamicBatching["timeout_us"].GetUint64());
+    }
+
+    if (v.HasMember("warmup_iterations"))
+        this->setWarmupIterations(v["warmup_iterations"].GetUint64());
+
+    if (v.HasMember("load_on_demand"))
+        this->setLoadOnDemand(v["load_on_demand"].GetBool());
+    if (v.HasMember("idle_unload_seconds"))
+        this->setIdleUnloadSeconds(v["idle_unload_seconds"].GetUint64());
+    if (v.HasMember("numa_node"))
+        this->setNumaNode(v["numa_node"].GetUint());
+    if (v.HasMember("isolation_group"))
+        this->setIsolationGroup(v["isolation_group"].GetString());
+    if (v.HasMember("replica_devices")) {
+        std::vector<std::string> replicaDevices;
+        for (auto& device : v["replica_devices"].GetArray()) {
+            replicaDevices.emplace_back(device.GetString());
+        }
+        this->setReplicaDevices(replicaDevices);
+    }
+    if (v.HasMember("version_weights")) {
+        version_weights_t versionWeights;
+        for (auto& weight : v["version_weights"].GetObject()) {
+            auto version = stou32(weight.name.GetString());
+            if (!version || version.value() == 0 || !weight.value.IsUint()) {
+                SPDLOG_ERROR("Model: {} version weights should map positive versions to weights", this->getName());
+                return StatusCode::MODEL_VERSION_WEIGHTS_WRONG_FORMAT;
+            }
+            versionWeights[version.value()] = weight.value.GetUint();
+        }
+        this->setVersionWeights(versionWeights);
+    }
+    if (v.HasMember("cpu_streams_weight"))
+        this->setCpuStreamsWeight(v["cpu_streams_weight"].GetUint());
+    if (v.HasMember("auto_tune")) {
+        const auto& autoTune = v["auto_tune"];
+        this->setAutoTune(true);
+        if (autoTune.HasMember("latency_slo_ms"))
+            this->setAutoTuneLatencySloMilliseconds(autoTune["latency_slo_ms"].GetUint());
+        if (autoTune.HasMember("measurement_ms"))
+            this->setAutoTuneMeasurementMilliseconds(autoTune["measurement_ms"].GetUint());
+    }
+    if (v.HasMember("shape_buckets")) {
+        const auto& shapeBuckets = v["shape_buckets"];
+        std::vector<size_t> sizes;
+        for (auto& size : shapeBuckets["sizes"].GetArray()) {
+            sizes.push_back(size.GetUint64());
+        }
+        this->setShapeBuckets(sizes);
+        if (shapeBuckets.HasMember("dimension"))
+            this->setShapeBucketDimension(shapeBuckets["dimension"].GetUint64());
+    }
+    if (v.HasMember("micro_batching"))
+        this->setMicroBatching(v["micro_batching"].GetBool());
+    if (v.HasMember("overlap_request_processing"))
+        this->setOverlapRequestProcessing(v["overlap_request_processing"].GetBool());
+    if (v.HasMember("request_coalescing"))
+        this->setRequestCoalescing(v["request_coalescing"].GetBool());
+    if (v.HasMember("shared_gpu_context"))
+        this->setSharedGpuContext(v["shared_gpu_context"].GetBool());
+    if (v.HasMember("response_cache")) {
+        const auto& responseCache = v["response_cache"];
+        this->setResponseCacheSizeMegabytes(responseCache["size_mb"].GetUint64());
+        if (responseCache.HasMember("ttl_seconds"))
+            this->setResponseCacheTtlSeconds(responseCache["ttl_seconds"].GetUint());
+    }
+    if (v.HasMember("node_output_cache")) {
+        const auto& nodeOutputCache = v["node_output_cache"];
+        this->setNodeOutputCacheSizeMegabytes(nodeOutputCache["size_mb"].GetUint64());
+        if (nodeOutputCache.HasMember("ttl_ms"))
+            this->setNodeOutputCacheTtlMilliseconds(nodeOutputCache["ttl_ms"].GetUint());
+    }
+    if (v.HasMember("hedging")) {
+        const auto& hedging = v["hedging"];
+        this->setHedging(true);
+        if (hedging.HasMember("percentile"))
+            this->setHedgingPercentile(hedging["percentile"].GetUint());
+        if (hedging.HasMember("budget_percent"))
+            this->setHedgingBudgetPercent(hedging["budget_percent"].GetUint());
+    }
+    if (v.HasMember("storage_polling")) {
+        const auto& storagePolling = v["storage_polling"];
+        if (storagePolling.HasMember("interval_seconds"))
+            this->setStoragePollIntervalSeconds(storagePolling["interval_seconds"].GetUint());
+        if (storagePolling.HasMember("max_interval_seconds"))
+            this->setStoragePollMaxIntervalSeconds(storagePolling["max_interval_seconds"].GetUint());
+    }
+    if (v.HasMember("stateful")) {
+        const auto& stateful = v["stateful"];
+        this->setStateful(true);
+        if (stateful.HasMember("timeout_seconds"))
+            this->setSequenceTimeoutSeconds(stateful["timeout_seconds"].GetUint());
+        if (stateful.HasMember("max_sequence_number"))
+            this->setMaxSequenceNumber(stateful["max_sequence_number"].GetUint());
+    }
+    if (v.HasMember("preprocessing")) {
+        for (auto& input : v["preprocessing"].GetObject()) {
+            InputPreprocessingInfo preprocessing;
+            if (input.value.HasMember("resize"))
+                preprocessing.resize = input.value["resize"].GetString();
+            if (input.value.HasMember("source_shape")) {
+                for (const auto& dim : input.value["source_shape"].GetArray())
+                    preprocessing.sourceShape.push_back(dim.GetUint64());
+            }
+            if (input.value.HasMember("color_format"))
+                preprocessing.colorFormat = input.value["color_format"].GetString();
+            if (input.value.HasMember("mean")) {
+                for (const auto& value : input.value["mean"].GetArray())
+                    preprocessing.mean.push_back(value.GetFloat());
+            }
+            if (input.value.HasMember("scale")) {
+                const auto& scale = input.value["scale"];
+                if (scale.IsArray()) {
+                    for (const auto& value : scale.GetArray())
+                        preprocessing.scale.push_back(value.GetFloat());
+                } else {
+                    preprocessing.scale.push_back(scale.GetFloat());
+                }
+            }
+            this->addPreprocessing(input.name.GetString(), preprocessing);
+        }
+    }
+    if (v.HasMember("postprocessing")) {
+        for (auto& output : v["postprocessing"].GetObject()) {
+            OutputPostprocessingInfo postprocessing;
+            if (output.value.HasMember("top_k"))
+                postprocessing.topK = output.value["top_k"].GetUint();
+            if (output.value.HasMember("min_score"))
+                postprocessing.minScore = output.value["min_score"].GetFloat();
+            this->addPostprocessing(output.name.GetString(), postprocessing);
+        }
+    }
+
+    if (v.HasMember("admission_control")) {
+        const auto& admissionControl = v["admission_control"];
+        if (admissionControl.HasMember("max_queue_size"))
+            this->setMaxQueueSize(admissionControl["max_queue_size"].GetUint64());
+        if (admissionControl.HasMember("max_queue_time_us"))
+            this->setMaxQueueTimeMicroseconds(admissionControl["max_queue_time_us"].GetUint64());
+        if (admissionControl.HasMember("reserved_high_priority_streams"))
+            this->setReservedHighPriorityStreams(admissionControl["reserved_high_priority_streams"].GetUint64());
+        if (admissionControl.HasMember("max_low_priority_queue_size"))
+            this->setMaxLowPriorityQueueSize(admissionControl["max_low_priority_queue_size"].GetUint64());
+    }
+
     if (v.HasMember("model_version_policy")) {
         rapidjson::StringBuffer buffer;
         buffer.Clear();
@@ -397,6 +661,16 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
         setBatchingMode(FIXED);
         setBatchSize(0);
     }
+    if (isDynamicBatchingEnabled()) {
+        if (shapeSet) {
+            spdlog::warn("Both shape and dynamic batching have been defined. Dynamic batching will be disabled.");
+            setMaxBatchSize(0);
+        } else if (getBatchingMode() != FIXED || getBatchSize() != 0) {
+            spdlog::warn("Both batch size and dynamic batching have been defined. Batch size parameter will be ignored.");
+            setBatchingMode(FIXED);
+            setBatchSize(0);
+        }
+    }
     return StatusCode::OK;
 }
 
@@ -15,18 +15,22 @@
 //*****************************************************************************
 #pragma once
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <rapidjson/document.h>
 
 #include "model_version_policy.hpp"
 #include "status.hpp"
+#include "versionrouting.hpp"
 
 namespace ovms {
 
@@ -47,13 +51,76 @@ struct ShapeInfo {
     }
 };
 
+/**
+ * @brief Reduction of output scores to the best classes, computed on the server instead of sending all scores
+ */
+struct OutputPostprocessingInfo {
+    uint32_t topK = 1;
+    float minScore = -std::numeric_limits<float>::infinity();
+
+    bool operator==(const OutputPostprocessingInfo& rhs) const {
+        return this->topK == rhs.topK && this->minScore == rhs.minScore;
+    }
+
+    bool operator!=(const OutputPostprocessingInfo& rhs) const {
+        return !(*this == rhs);
+    }
+};
+
+/**
+ * @brief Preprocessing of input fused by plugin into inference, so that clients send frames as captured
+ */
+struct InputPreprocessingInfo {
+    /**
+     * @brief Resize algorithm, "bilinear" or "area", empty if frames are not resized
+     */
+    std::string resize;
+    /**
+     * @brief Shape of frames sent by clients, resized by plugin to network input shape
+     */
+    shape_t sourceShape;
+    /**
+     * @brief Color format of frames sent by clients, "RGB" or "BGR", empty if it is color format of network
+     */
+    std::string colorFormat;
+    /**
+     * @brief Values subtracted from each channel, then divided by scale
+     */
+    std::vector<float> mean;
+    /**
+     * @brief Scale of each channel, or one scale of all channels
+     */
+    std::vector<float> scale;
+
+    bool operator==(const InputPreprocessingInfo& rhs) const {
+        return this->resize == rhs.resize && this->sourceShape == rhs.sourceShape && this->colorFormat == rhs.colorFormat &&
+               this->mean == rhs.mean && this->scale == rhs.scale;
+    }
+
+    bool operator!=(const InputPreprocessingInfo& rhs) const {
+        return !(*this == rhs);
+    }
+};
+
 using shapes_map_t = std::unordered_map<std::string, ShapeInfo>;
+using preprocessing_map_t = std::unordered_map<std::string, InputPreprocessingInfo>;
+using postprocessing_map_t = std::unordered_map<std::string, OutputPostprocessingInfo>;
 using layouts_map_t = std::unordered_map<std::string, std::string>;
+using precisions_map_t = std::unordered_map<std::string, std::string>;
 using mapping_config_t = std::unordered_map<std::string, std::string>;
 using plugin_config_t = std::map<std::string, std::string>;
 
 const std::string ANONYMOUS_INPUT_NAME = "ANONYMOUS_INPUT_NAME";
 const std::string MAPPING_CONFIG_JSON = "mapping_config.json";
+const uint64_t DEFAULT_BATCH_TIMEOUT_MICROSECONDS = 1000;
+const int64_t NO_NUMA_NODE = -1;
+const uint32_t DEFAULT_AUTO_TUNE_MEASUREMENT_MILLISECONDS = 500;
+const size_t DEFAULT_SHAPE_BUCKET_DIMENSION = 1;
+const uint32_t DEFAULT_NODE_OUTPUT_CACHE_TTL_MILLISECONDS = 1000;
+const uint32_t DEFAULT_HEDGING_PERCENTILE = 95;
+const uint32_t DEFAULT_HEDGING_BUDGET_PERCENT = 5;
+const uint32_t DEFAULT_SEQUENCE_TIMEOUT_SECONDS = 60;
+const uint32_t DEFAULT_MAX_SEQUENCE_NUMBER = 500;
 
 /**
      * @brief This class represents model configuration
@@ -105,6 +172,196 @@ private:
          */
     plugin_config_t pluginConfig;
 
+    /**
+         * @brief Maximum number of batch-1 requests gathered into one inference by the batching scheduler, 0 disables dynamic batching
+         */
+    size_t maxBatchSize;
+
+    /**
+         * @brief Time the batching scheduler waits for a batch to fill up, in microseconds
+         */
+    uint64_t batchTimeoutMicroseconds;
+
+    /**
+         * @brief Maximum number of requests waiting for idle infer request, 0 means no limit
+         */
+    size_t maxQueueSize;
+
+    /**
+         * @brief Maximum time a request waits for idle infer request, in microseconds, 0 means no limit
+         */
+    uint64_t maxQueueTimeMicroseconds;
+
+    /**
+         * @brief Number of infer requests low priority requests leave idle for high priority ones
+         */
+    size_t reservedHighPriorityStreams;
+
+    /**
+         * @brief Maximum number of low priority requests waiting for idle infer request, 0 means no limit
+         */
+    size_t maxLowPriorityQueueSize;
+
+    /**
+         * @brief Number of synthetic inferences executed on every infer request before model version becomes available
+         */
+    uint64_t warmupIterations;
+
+    /**
+         * @brief Model versions are compiled on first request instead of when these are loaded
+         */
+    bool loadOnDemand;
+
+    /**
+         * @brief Time after which version loaded on demand is unloaded if it receives no requests, in seconds, 0 means never
+         */
+    uint64_t idleUnloadSeconds;
+
+    /**
+         * @brief NUMA node whose CPUs run inference streams of the model, NO_NUMA_NODE if not bound
+         */
+    int64_t numaNode;
+
+    /**
+         * @brief Isolation group whose reserved CPUs run inference of the model, empty if the model is not in any group
+         */
+    std::string isolationGroup;
+
+    /**
+         * @brief Additional devices each running own replica of the model, requests go to least loaded replica
+         */
+    std::vector<std::string> replicaDevices;
+
+    /**
+         * @brief Weights of versions serving requests without version, empty routes these to the highest version
+         */
+    version_weights_t versionWeights;
+
+    /**
+         * @brief Weight of the model in split of CPU streams budget
+         */
+    uint32_t cpuStreamsWeight;
+
+    /**
+         * @brief CPU streams assigned to the model from CPU streams budget, 0 if the budget does not apply
+         */
+    uint32_t cpuStreamsShare;
+
+    /**
+         * @brief Measure CPU streams and nireq settings when the model is loaded and use the best one
+         */
+    bool autoTune;
+
+    /**
+         * @brief Highest average latency of settings chosen by auto-tuning in milliseconds, 0 means no limit
+         */
+    uint32_t autoTuneLatencySloMilliseconds;
+
+    /**
+         * @brief Time each setting is measured by auto-tuning in milliseconds
+         */
+    uint32_t autoTuneMeasurementMilliseconds;
+
+    /**
+         * @brief Ascending sizes of shape buckets compiled ahead of time, requests are padded to the nearest one
+         */
+    std::vector<size_t> shapeBuckets;
+
+    /**
+         * @brief Dimension of inputs padded to shape bucket size
+         */
+    size_t shapeBucketDimension;
+
+    /**
+         * @brief Splits requests with batch size above network batch size into micro-batches of network batch size
+         */
+    bool microBatching;
+
+    /**
+         * @brief Keeps spare infer requests so that deserialization and serialization of requests overlap with inference
+         */
+    bool overlapRequestProcessing;
+
+    /**
+         * @brief Serves identical concurrent requests with a single inference
+         */
+    bool requestCoalescing;
+
+    /**
+         * @brief Compiles network on GPU in context shared with other models, pipeline nodes pass outputs in device memory
+         */
+    bool sharedGpuContext;
+
+    /**
+         * @brief Memory limit of cached responses in megabytes, responses are not cached if 0
+         */
+    size_t responseCacheSizeMegabytes;
+
+    /**
+         * @brief Lifetime of cached responses in seconds, responses stay until evicted if 0
+         */
+    uint32_t responseCacheTtlSeconds;
+
+    /**
+         * @brief Memory limit of cached outputs of pipeline nodes running the model in megabytes, outputs are not cached if 0
+         */
+    size_t nodeOutputCacheSizeMegabytes;
+
+    /**
+         * @brief Lifetime of cached outputs of pipeline nodes in milliseconds
+         */
+    uint32_t nodeOutputCacheTtlMilliseconds;
+
+    /**
+         * @brief Sends a second copy of requests not finished within the hedging percentile of inference latencies
+         */
+    bool hedging;
+
+    /**
+         * @brief Percentile of recent inference latencies after which a request is hedged
+         */
+    uint32_t hedgingPercentile;
+
+    /**
+         * @brief Hedged requests limit in percents of all requests
+         */
+    uint32_t hedgingBudgetPercent;
+
+    /**
+         * @brief Base interval of version listing of the model in cloud storage in seconds, cloud_file_system_poll_wait_seconds if 0
+         */
+    uint32_t storagePollIntervalSeconds;
+
+    /**
+         * @brief Limit of the listing interval growing while versions do not change in seconds, 4 times the base interval if 0
+         */
+    uint32_t storagePollMaxIntervalSeconds;
+
+    /**
+         * @brief Keeps memory state of the network between requests of the same sequence
+         */
+    bool stateful;
+
+    /**
+         * @brief Idle time in seconds after which sequence and its memory state are dropped
+         */
+    uint32_t sequenceTimeoutSeconds;
+
+    /**
+         * @brief Limit of sequences kept at the same time
+         */
+    uint32_t maxSequenceNumber;
+
+    /**
+         * @brief Inputs preprocessed by plugin, keyed by network input name
+         */
+    preprocessing_map_t preprocessing;
+
+    /**
+         * @brief Outputs reduced to top K scores and their indices, keyed by output name in response
+         */
+    postprocessing_map_t postprocessing;
+
     /**
          * @brief Layout for single input
          */
@@ -120,6 +377,26 @@ private:
          */
     layouts_map_t layouts;
 
+    /**
+         * @brief Precision accepted for all inputs, converted to network precision by plugin
+         */
+    std::string precision;
+
+    /**
+         * @brief Map of precisions accepted for named inputs
+         */
+    precisions_map_t precisions;
+
+    /**
+         * @brief Precision of FP32 outputs sent in gRPC responses
+         */
+    std::string outputPrecision;
+
+    /**
+         * @brief Map of precisions of named outputs sent in gRPC responses
+         */
+    precisions_map_t outputPrecisions;
+
     /**
          * @brief Model version
          */
@@ -174,9 +451,51 @@ public:
         modelVersionPolicy(ModelVersionPolicy::getDefaultVersionPolicy()),
         nireq(nireq),
         pluginConfig({}),
+        maxBatchSize(0),
+        batchTimeoutMicroseconds(DEFAULT_BATCH_TIMEOUT_MICROSECONDS),
+        maxQueueSize(0),
+        maxQueueTimeMicroseconds(0),
+        reservedHighPriorityStreams(0),
+        maxLowPriorityQueueSize(0),
+        warmupIterations(0),
+        loadOnDemand(false),
+        idleUnloadSeconds(0),
+        numaNode(NO_NUMA_NODE),
+        isolationGroup(""),
+        replicaDevices({}),
+        versionWeights({}),
+        cpuStreamsWeight(1),
+        cpuStreamsShare(0),
+        autoTune(false),
+        autoTuneLatencySloMilliseconds(0),
+        autoTuneMeasurementMilliseconds(DEFAULT_AUTO_TUNE_MEASUREMENT_MILLISECONDS),
+        shapeBuckets({}),
+        shapeBucketDimension(DEFAULT_SHAPE_BUCKET_DIMENSION),
+        microBatching(false),
+        overlapRequestProcessing(false),
+        requestCoalescing(false),
+        sharedGpuContext(false),
+        responseCacheSizeMegabytes(0),
+        responseCacheTtlSeconds(0),
+        nodeOutputCacheSizeMegabytes(0),
+        nodeOutputCacheTtlMilliseconds(DEFAULT_NODE_OUTPUT_CACHE_TTL_MILLISECONDS),
+        hedging(false),
+        hedgingPercentile(DEFAULT_HEDGING_PERCENTILE),
+        hedgingBudgetPercent(DEFAULT_HEDGING_BUDGET_PERCENT),
+        storagePollIntervalSeconds(0),
+        storagePollMaxIntervalSeconds(0),
+        stateful(false),
+        sequenceTimeoutSeconds(DEFAULT_SEQUENCE_TIMEOUT_SECONDS),
+        maxSequenceNumber(DEFAULT_MAX_SEQUENCE_NUMBER),
+        preprocessing({}),
+        postprocessing({}),
         layout(""),
         shapes({}),
         layouts({}),
+        precision(""),
+        precisions({}),
+        outputPrecision(""),
+        outputPrecisions({}),
         version(version),
         mappingInputs({}),
         mappingOutputs({}) {
@@ -369,7 +688,7 @@ public:
          * 
          * @return std::shared_ptr<ModelVersionPolicy>
          */
-    std::shared_ptr<ModelVersionPolicy> getModelVersionPolicy() {
+    std::shared_ptr<ModelVersionPolicy> getModelVersionPolicy() const {
         return this->modelVersionPolicy;
     }
 
@@ -428,156 +747,871 @@ public:
     }
 
     /**
-         * @brief Parses json node for plugin config keys and values
+         * @brief Get the maximum batch size for dynamic batching
          * 
-         * @param json node representing plugin_config
-         * 
-         * @return status
+         * @return size_t 
          */
-    Status parsePluginConfig(const rapidjson::Value& node);
+    size_t getMaxBatchSize() const {
+        return this->maxBatchSize;
+    }
 
     /**
-         * @brief Parses string for plugin config keys and values
-         * 
-         * @param string representing plugin_config
+         * @brief Set the maximum batch size for dynamic batching
          * 
-         * @return status
+         * @param maxBatchSize 
          */
-    Status parsePluginConfig(std::string command) {
-        rapidjson::Document node;
-        if (command.empty()) {
-            return StatusCode::OK;
-        }
-        if (node.Parse(command.c_str()).HasParseError()) {
-            return StatusCode::PLUGIN_CONFIG_WRONG_FORMAT;
-        }
-
-        return parsePluginConfig(node);
+    void setMaxBatchSize(size_t maxBatchSize) {
+        this->maxBatchSize = maxBatchSize;
     }
 
     /**
-         * @brief Parses value from json and extracts shapes info
-         * 
-         * @param rapidjson::Value& node
+         * @brief Get the dynamic batching timeout
          * 
-         * @return status
+         * @return uint64_t 
          */
-    Status parseShapeParameter(const rapidjson::Value& node);
+    uint64_t getBatchTimeoutMicroseconds() const {
+        return this->batchTimeoutMicroseconds;
+    }
 
     /**
-         * @brief Parses value from string and extracts shapes info
+         * @brief Set the dynamic batching timeout
          * 
-         * @param string
-         * 
-         * @return status
+         * @param batchTimeoutMicroseconds 
          */
-    Status parseShapeParameter(const std::string& command);
+    void setBatchTimeoutMicroseconds(uint64_t batchTimeoutMicroseconds) {
+        this->batchTimeoutMicroseconds = batchTimeoutMicroseconds;
+    }
 
     /**
-         * @brief Returns true if any input shape specified in shapes map is in AUTO mode
+         * @brief Checks if server side batching of single requests is requested
          * 
          * @return bool
          */
-    bool anyShapeSetToAuto() const {
-        for (auto& it : getShapes()) {
-            auto shapeInfo = it.second;
-            if (shapeInfo.shapeMode == AUTO)
-                return true;
-        }
-        return false;
+    bool isDynamicBatchingEnabled() const {
+        return this->maxBatchSize > 1;
     }
 
     /**
-         * @brief Get the shapes
+         * @brief Get the maximum number of queued requests
          * 
-         * @return const shapes_map_t& 
+         * @return size_t 
          */
-    const shapes_map_t& getShapes() const {
-        return this->shapes;
+    size_t getMaxQueueSize() const {
+        return this->maxQueueSize;
     }
 
     /**
-         * @brief Set the shapes
+         * @brief Set the maximum number of queued requests
          * 
-         * @param shapes 
+         * @param maxQueueSize 
          */
-    void setShapes(const shapes_map_t& shapes) {
-        this->shapes = shapes;
+    void setMaxQueueSize(size_t maxQueueSize) {
+        this->maxQueueSize = maxQueueSize;
     }
 
     /**
-        * @brief Returns true if shape with certain name is in AUTO mode
+         * @brief Get the maximum request queueing time
          * 
-         * @return bool
+         * @return uint64_t 
          */
-    bool isShapeAuto(const std::string& name) const {
-        auto it = getShapes().find(name);
-        if (it == getShapes().end()) {
-            it = getShapes().find(ANONYMOUS_INPUT_NAME);
-        }
-        if (it == getShapes().end()) {
-            return false;
-        }
-        return it->second.shapeMode == Mode::AUTO;
-    }
-
-    bool isShapeAnonymous() const {
-        return getShapes().size() == 1 && getShapes().begin()->first == ANONYMOUS_INPUT_NAME;
-    }
-
-    bool isShapeAnonymousFixed() const {
-        return isShapeAnonymous() && !isShapeAuto(ANONYMOUS_INPUT_NAME);
+    uint64_t getMaxQueueTimeMicroseconds() const {
+        return this->maxQueueTimeMicroseconds;
     }
 
     /**
-         * @brief Sets the shape from the string representation
-         *
-         * @param shape
-         * @param str
-         * @return Status
+         * @brief Set the maximum request queueing time
+         * 
+         * @param maxQueueTimeMicroseconds 
          */
-    static Status parseShape(ShapeInfo& shapeInfo, const std::string& str);
+    void setMaxQueueTimeMicroseconds(uint64_t maxQueueTimeMicroseconds) {
+        this->maxQueueTimeMicroseconds = maxQueueTimeMicroseconds;
+    }
 
     /**
-         * @brief Add a single named shape
+         * @brief Get the number of infer requests reserved for high priority requests
          * 
-         * @param name 
-         * @param shape 
+         * @return size_t 
          */
-    void addShape(const std::string& name, const ShapeInfo& shapeInfo) {
-        this->shapes[name] = shapeInfo;
+    size_t getReservedHighPriorityStreams() const {
+        return this->reservedHighPriorityStreams;
     }
 
-    void removeShape(const std::string& name) {
-        this->shapes.erase(name);
+    /**
+         * @brief Set the number of infer requests reserved for high priority requests
+         * 
+         * @param reservedHighPriorityStreams 
+         */
+    void setReservedHighPriorityStreams(size_t reservedHighPriorityStreams) {
+        this->reservedHighPriorityStreams = reservedHighPriorityStreams;
     }
 
     /**
-         * @brief Get the layouts
+         * @brief Get the maximum number of queued low priority requests
          * 
-         * @return const std::string& 
+         * @return size_t 
          */
-    const std::string& getLayout() const {
-        return this->layout;
+    size_t getMaxLowPriorityQueueSize() const {
+        return this->maxLowPriorityQueueSize;
     }
 
     /**
-         * @brief Set the layout
+         * @brief Set the maximum number of queued low priority requests
          * 
-         * @param layout
+         * @param maxLowPriorityQueueSize 
          */
-    void setLayout(const std::string& layout) {
-        this->layout = layout;
-        this->layouts.clear();
+    void setMaxLowPriorityQueueSize(size_t maxLowPriorityQueueSize) {
+        this->maxLowPriorityQueueSize = maxLowPriorityQueueSize;
     }
 
     /**
-         * @brief Get the layouts
+         * @brief Get the number of warm-up inferences per infer request
          * 
-         * @return const layouts_map_t& 
+         * @return uint64_t 
          */
-    const layouts_map_t& getLayouts() const {
-        return this->layouts;
+    uint64_t getWarmupIterations() const {
+        return this->warmupIterations;
+    }
+
+    /**
+         * @brief Set the number of warm-up inferences per infer request
+         * 
+         * @param warmupIterations 
+         */
+    void setWarmupIterations(uint64_t warmupIterations) {
+        this->warmupIterations = warmupIterations;
+    }
+
+    /**
+         * @brief Checks if model versions are compiled on first request
+         * 
+         * @return bool
+         */
+    bool isLoadOnDemand() const {
+        return this->loadOnDemand;
+    }
+
+    /**
+         * @brief Set compiling model versions on first request
+         * 
+         * @param loadOnDemand 
+         */
+    void setLoadOnDemand(bool loadOnDemand) {
+        this->loadOnDemand = loadOnDemand;
+    }
+
+    /**
+         * @brief Get the idle time after which version loaded on demand is unloaded
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getIdleUnloadSeconds() const {
+        return this->idleUnloadSeconds;
+    }
+
+    /**
+         * @brief Set the idle time after which version loaded on demand is unloaded
+         * 
+         * @param idleUnloadSeconds 
+         */
+    void setIdleUnloadSeconds(uint64_t idleUnloadSeconds) {
+        this->idleUnloadSeconds = idleUnloadSeconds;
+    }
+
+    /**
+         * @brief Get the NUMA node the model is bound to
+         * 
+         * @return int64_t NUMA node id or NO_NUMA_NODE
+         */
+    int64_t getNumaNode() const {
+        return this->numaNode;
+    }
+
+    /**
+         * @brief Bind the model to NUMA node
+         * 
+         * @param numaNode NUMA node id or NO_NUMA_NODE
+         */
+    void setNumaNode(int64_t numaNode) {
+        this->numaNode = numaNode;
+    }
+
+    /**
+         * @brief Get the isolation group the model is assigned to
+         * 
+         * @return const std::string& group name, empty if the model is not in any group
+         */
+    const std::string& getIsolationGroup() const {
+        return this->isolationGroup;
+    }
+
+    /**
+         * @brief Assign the model to isolation group
+         * 
+         * @param isolationGroup group name, empty removes the model from its group
+         */
+    void setIsolationGroup(const std::string& isolationGroup) {
+        this->isolationGroup = isolationGroup;
+    }
+
+    /**
+         * @brief Get the devices running additional replicas of the model
+         * 
+         * @return const std::vector<std::string>& 
+         */
+    const std::vector<std::string>& getReplicaDevices() const {
+        return this->replicaDevices;
+    }
+
+    /**
+         * @brief Set the devices running additional replicas of the model
+         * 
+         * @param replicaDevices 
+         */
+    void setReplicaDevices(const std::vector<std::string>& replicaDevices) {
+        this->replicaDevices = replicaDevices;
+    }
+
+    /**
+         * @brief Get the weights of versions serving requests without version
+         * 
+         * @return const version_weights_t& 
+         */
+    const version_weights_t& getVersionWeights() const {
+        return this->versionWeights;
+    }
+
+    /**
+         * @brief Set the weights of versions serving requests without version
+         * 
+         * @param versionWeights 
+         */
+    void setVersionWeights(const version_weights_t& versionWeights) {
+        this->versionWeights = versionWeights;
+    }
+
+    /**
+         * @brief Get the weight of the model in split of CPU streams budget
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getCpuStreamsWeight() const {
+        return this->cpuStreamsWeight;
+    }
+
+    /**
+         * @brief Set the weight of the model in split of CPU streams budget
+         * 
+         * @param cpuStreamsWeight 
+         */
+    void setCpuStreamsWeight(uint32_t cpuStreamsWeight) {
+        this->cpuStreamsWeight = cpuStreamsWeight;
+    }
+
+    /**
+         * @brief Get the CPU streams assigned to the model from CPU streams budget
+         * 
+         * @return uint32_t 0 if the budget does not apply
+         */
+    uint32_t getCpuStreamsShare() const {
+        return this->cpuStreamsShare;
+    }
+
+    /**
+         * @brief Set the CPU streams assigned to the model from CPU streams budget
+         * 
+         * @param cpuStreamsShare 
+         */
+    void setCpuStreamsShare(uint32_t cpuStreamsShare) {
+        this->cpuStreamsShare = cpuStreamsShare;
+    }
+
+    /**
+         * @brief Checks if CPU streams and nireq are chosen by auto-tuning
+         * 
+         * @return bool 
+         */
+    bool isAutoTuneEnabled() const {
+        return this->autoTune;
+    }
+
+    /**
+         * @brief Enable auto-tuning of CPU streams and nireq
+         * 
+         * @param autoTune 
+         */
+    void setAutoTune(bool autoTune) {
+        this->autoTune = autoTune;
+    }
+
+    /**
+         * @brief Get the latency limit of settings chosen by auto-tuning
+         * 
+         * @return uint32_t milliseconds, 0 means no limit
+         */
+    uint32_t getAutoTuneLatencySloMilliseconds() const {
+        return this->autoTuneLatencySloMilliseconds;
+    }
+
+    /**
+         * @brief Set the latency limit of settings chosen by auto-tuning
+         * 
+         * @param autoTuneLatencySloMilliseconds 
+         */
+    void setAutoTuneLatencySloMilliseconds(uint32_t autoTuneLatencySloMilliseconds) {
+        this->autoTuneLatencySloMilliseconds = autoTuneLatencySloMilliseconds;
+    }
+
+    /**
+         * @brief Get the time each setting is measured by auto-tuning
+         * 
+         * @return uint32_t milliseconds
+         */
+    uint32_t getAutoTuneMeasurementMilliseconds() const {
+        return this->autoTuneMeasurementMilliseconds;
+    }
+
+    /**
+         * @brief Set the time each setting is measured by auto-tuning
+         * 
+         * @param autoTuneMeasurementMilliseconds 
+         */
+    void setAutoTuneMeasurementMilliseconds(uint32_t autoTuneMeasurementMilliseconds) {
+        this->autoTuneMeasurementMilliseconds = autoTuneMeasurementMilliseconds;
+    }
+
+    /**
+         * @brief Get the sizes of shape buckets
+         * 
+         * @return const std::vector<size_t>& ascending sizes, empty if shape buckets are not used
+         */
+    const std::vector<size_t>& getShapeBuckets() const {
+        return this->shapeBuckets;
+    }
+
+    /**
+         * @brief Set the sizes of shape buckets, these are sorted and deduplicated
+         * 
+         * @param shapeBuckets 
+         */
+    void setShapeBuckets(std::vector<size_t> shapeBuckets) {
+        std::sort(shapeBuckets.begin(), shapeBuckets.end());
+        shapeBuckets.erase(std::unique(shapeBuckets.begin(), shapeBuckets.end()), shapeBuckets.end());
+        this->shapeBuckets = std::move(shapeBuckets);
+    }
+
+    /**
+         * @brief Get the dimension of inputs padded to shape bucket size
+         * 
+         * @return size_t 
+         */
+    size_t getShapeBucketDimension() const {
+        return this->shapeBucketDimension;
+    }
+
+    /**
+         * @brief Set the dimension of inputs padded to shape bucket size
+         * 
+         * @param shapeBucketDimension 
+         */
+    void setShapeBucketDimension(size_t shapeBucketDimension) {
+        this->shapeBucketDimension = shapeBucketDimension;
+    }
+
+    /**
+         * @brief Checks if requests above network batch size are split into micro-batches
+         * 
+         * @return bool
+         */
+    bool isMicroBatchingEnabled() const {
+        return this->microBatching;
+    }
+
+    /**
+         * @brief Set splitting of requests above network batch size into micro-batches
+         * 
+         * @param microBatching 
+         */
+    void setMicroBatching(bool microBatching) {
+        this->microBatching = microBatching;
+    }
+
+    /**
+         * @brief Checks if deserialization and serialization of requests overlap with inference
+         * 
+         * @return bool
+         */
+    bool isOverlapRequestProcessingEnabled() const {
+        return this->overlapRequestProcessing;
+    }
+
+    /**
+         * @brief Set overlapping of deserialization and serialization of requests with inference
+         * 
+         * @param overlapRequestProcessing 
+         */
+    void setOverlapRequestProcessing(bool overlapRequestProcessing) {
+        this->overlapRequestProcessing = overlapRequestProcessing;
+    }
+
+    /**
+         * @brief Checks if identical concurrent requests are served with a single inference
+         * 
+         * @return bool
+         */
+    bool isRequestCoalescingEnabled() const {
+        return this->requestCoalescing;
+    }
+
+    /**
+         * @brief Set coalescing of identical concurrent requests
+         * 
+         * @param requestCoalescing 
+         */
+    void setRequestCoalescing(bool requestCoalescing) {
+        this->requestCoalescing = requestCoalescing;
+    }
+
+    /**
+         * @brief Checks if network is compiled in GPU context shared with other models
+         * 
+         * @return bool
+         */
+    bool isGpuContextShared() const {
+        return this->sharedGpuContext;
+    }
+
+    /**
+         * @brief Set compilation of network in GPU context shared with other models
+         * 
+         * @param sharedGpuContext 
+         */
+    void setSharedGpuContext(bool sharedGpuContext) {
+        this->sharedGpuContext = sharedGpuContext;
+    }
+
+    /**
+         * @brief Checks if responses of the model are cached
+         * 
+         * @return bool
+         */
+    bool isResponseCacheEnabled() const {
+        return this->responseCacheSizeMegabytes > 0;
+    }
+
+    /**
+         * @brief Get the memory limit of cached responses in megabytes
+         * 
+         * @return size_t 
+         */
+    size_t getResponseCacheSizeMegabytes() const {
+        return this->responseCacheSizeMegabytes;
+    }
+
+    /**
+         * @brief Set the memory limit of cached responses in megabytes
+         * 
+         * @param responseCacheSizeMegabytes 
+         */
+    void setResponseCacheSizeMegabytes(size_t responseCacheSizeMegabytes) {
+        this->responseCacheSizeMegabytes = responseCacheSizeMegabytes;
+    }
+
+    /**
+         * @brief Get the lifetime of cached responses in seconds
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getResponseCacheTtlSeconds() const {
+        return this->responseCacheTtlSeconds;
+    }
+
+    /**
+         * @brief Set the lifetime of cached responses in seconds
+         * 
+         * @param responseCacheTtlSeconds 
+         */
+    void setResponseCacheTtlSeconds(uint32_t responseCacheTtlSeconds) {
+        this->responseCacheTtlSeconds = responseCacheTtlSeconds;
+    }
+
+    /**
+         * @brief Checks if outputs of pipeline nodes running the model are cached
+         * 
+         * @return bool
+         */
+    bool isNodeOutputCacheEnabled() const {
+        return this->nodeOutputCacheSizeMegabytes > 0;
+    }
+
+    /**
+         * @brief Get the memory limit of cached node outputs in megabytes
+         * 
+         * @return size_t 
+         */
+    size_t getNodeOutputCacheSizeMegabytes() const {
+        return this->nodeOutputCacheSizeMegabytes;
+    }
+
+    /**
+         * @brief Set the memory limit of cached node outputs in megabytes
+         * 
+         * @param nodeOutputCacheSizeMegabytes 
+         */
+    void setNodeOutputCacheSizeMegabytes(size_t nodeOutputCacheSizeMegabytes) {
+        this->nodeOutputCacheSizeMegabytes = nodeOutputCacheSizeMegabytes;
+    }
+
+    /**
+         * @brief Get the lifetime of cached node outputs in milliseconds
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getNodeOutputCacheTtlMilliseconds() const {
+        return this->nodeOutputCacheTtlMilliseconds;
+    }
+
+    /**
+         * @brief Set the lifetime of cached node outputs in milliseconds
+         * 
+         * @param nodeOutputCacheTtlMilliseconds 
+         */
+    void setNodeOutputCacheTtlMilliseconds(uint32_t nodeOutputCacheTtlMilliseconds) {
+        this->nodeOutputCacheTtlMilliseconds = nodeOutputCacheTtlMilliseconds;
+    }
+
+    /**
+         * @brief Checks if slow requests of the model are hedged
+         * 
+         * @return bool
+         */
+    bool isHedgingEnabled() const {
+        return this->hedging;
+    }
+
+    /**
+         * @brief Set hedging of slow requests
+         * 
+         * @param hedging 
+         */
+    void setHedging(bool hedging) {
+        this->hedging = hedging;
+    }
+
+    /**
+         * @brief Get the percentile of inference latencies after which a request is hedged
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getHedgingPercentile() const {
+        return this->hedgingPercentile;
+    }
+
+    /**
+         * @brief Set the percentile of inference latencies after which a request is hedged
+         * 
+         * @param hedgingPercentile 
+         */
+    void setHedgingPercentile(uint32_t hedgingPercentile) {
+        this->hedgingPercentile = hedgingPercentile;
+    }
+
+    /**
+         * @brief Get the hedged requests limit in percents of all requests
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getHedgingBudgetPercent() const {
+        return this->hedgingBudgetPercent;
+    }
+
+    /**
+         * @brief Set the hedged requests limit in percents of all requests
+         * 
+         * @param hedgingBudgetPercent 
+         */
+    void setHedgingBudgetPercent(uint32_t hedgingBudgetPercent) {
+        this->hedgingBudgetPercent = hedgingBudgetPercent;
+    }
+
+    /**
+         * @brief Get the base interval of version listing in cloud storage in seconds
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getStoragePollIntervalSeconds() const {
+        return this->storagePollIntervalSeconds;
+    }
+
+    /**
+         * @brief Set the base interval of version listing in cloud storage in seconds
+         * 
+         * @param storagePollIntervalSeconds 
+         */
+    void setStoragePollIntervalSeconds(uint32_t storagePollIntervalSeconds) {
+        this->storagePollIntervalSeconds = storagePollIntervalSeconds;
+    }
+
+    /**
+         * @brief Get the maximal interval of version listing in cloud storage in seconds
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getStoragePollMaxIntervalSeconds() const {
+        return this->storagePollMaxIntervalSeconds;
+    }
+
+    /**
+         * @brief Set the maximal interval of version listing in cloud storage in seconds
+         * 
+         * @param storagePollMaxIntervalSeconds 
+         */
+    void setStoragePollMaxIntervalSeconds(uint32_t storagePollMaxIntervalSeconds) {
+        this->storagePollMaxIntervalSeconds = storagePollMaxIntervalSeconds;
+    }
+
+    /**
+         * @brief Checks if memory state of the network is kept for sequences of requests
+         * 
+         * @return bool
+         */
+    bool isStateful() const {
+        return this->stateful;
+    }
+
+    /**
+         * @brief Set keeping memory state for sequences of requests
+         * 
+         * @param stateful 
+         */
+    void setStateful(bool stateful) {
+        this->stateful = stateful;
+    }
+
+    /**
+         * @brief Get the idle time in seconds after which sequence is dropped
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getSequenceTimeoutSeconds() const {
+        return this->sequenceTimeoutSeconds;
+    }
+
+    /**
+         * @brief Set the idle time in seconds after which sequence is dropped
+         * 
+         * @param sequenceTimeoutSeconds 
+         */
+    void setSequenceTimeoutSeconds(uint32_t sequenceTimeoutSeconds) {
+        this->sequenceTimeoutSeconds = sequenceTimeoutSeconds;
+    }
+
+    /**
+         * @brief Get the limit of sequences kept at the same time
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getMaxSequenceNumber() const {
+        return this->maxSequenceNumber;
+    }
+
+    /**
+         * @brief Set the limit of sequences kept at the same time
+         * 
+         * @param maxSequenceNumber 
+         */
+    void setMaxSequenceNumber(uint32_t maxSequenceNumber) {
+        this->maxSequenceNumber = maxSequenceNumber;
+    }
+
+    /**
+         * @brief Get the preprocessing of inputs
+         * 
+         * @return const preprocessing_map_t& 
+         */
+    const preprocessing_map_t& getPreprocessing() const {
+        return this->preprocessing;
+    }
+
+    /**
+         * @brief Set the preprocessing of input
+         * 
+         * @param inputName name of network input
+         * @param preprocessing 
+         */
+    void addPreprocessing(const std::string& inputName, const InputPreprocessingInfo& preprocessing) {
+        this->preprocessing[inputName] = preprocessing;
+    }
+
+    /**
+         * @brief Get the postprocessing of outputs
+         * 
+         * @return const postprocessing_map_t& 
+         */
+    const postprocessing_map_t& getPostprocessing() const {
+        return this->postprocessing;
+    }
+
+    /**
+         * @brief Set the postprocessing of output
+         * 
+         * @param outputName name of output in response
+         * @param postprocessing 
+         */
+    void addPostprocessing(const std::string& outputName, const OutputPostprocessingInfo& postprocessing) {
+        this->postprocessing[outputName] = postprocessing;
+    }
+
+    /**
+         * @brief Parses json node for plugin config keys and values
+         * 
+         * @param json node representing plugin_config
+         * 
+         * @return status
+         */
+    Status parsePluginConfig(const rapidjson::Value& node);
+
+    /**
+         * @brief Parses string for plugin config keys and values
+         * 
+         * @param string representing plugin_config
+         * 
+         * @return status
+         */
+    Status parsePluginConfig(std::string command) {
+        rapidjson::Document node;
+        if (command.empty()) {
+            return StatusCode::OK;
+        }
+        if (node.Parse(command.c_str()).HasParseError()) {
+            return StatusCode::PLUGIN_CONFIG_WRONG_FORMAT;
+        }
+
+        return parsePluginConfig(node);
+    }
+
+    /**
+         * @brief Parses value from json and extracts shapes info
+         * 
+         * @param rapidjson::Value& node
+         * 
+         * @return status
+         */
+    Status parseShapeParameter(const rapidjson::Value& node);
+
+    /**
+         * @brief Parses value from string and extracts shapes info
+         * 
+         * @param string
+         * 
+         * @return status
+         */
+    Status parseShapeParameter(const std::string& command);
+
+    /**
+         * @brief Returns true if any input shape specified in shapes map is in AUTO mode
+         * 
+         * @return bool
+         */
+    bool anyShapeSetToAuto() const {
+        for (auto& it : getShapes()) {
+            auto shapeInfo = it.second;
+            if (shapeInfo.shapeMode == AUTO)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+         * @brief Get the shapes
+         * 
+         * @return const shapes_map_t& 
+         */
+    const shapes_map_t& getShapes() const {
+        return this->shapes;
+    }
+
+    /**
+         * @brief Set the shapes
+         * 
+         * @param shapes 
+         */
+    void setShapes(const shapes_map_t& shapes) {
+        this->shapes = shapes;
+    }
+
+    /**
+        * @brief Returns true if shape with certain name is in AUTO mode
+         * 
+         * @return bool
+         */
+    bool isShapeAuto(const std::string& name) const {
+        auto it = getShapes().find(name);
+        if (it == getShapes().end()) {
+            it = getShapes().find(ANONYMOUS_INPUT_NAME);
+        }
+        if (it == getShapes().end()) {
+            return false;
+        }
+        return it->second.shapeMode == Mode::AUTO;
+    }
+
+    bool isShapeAnonymous() const {
+        return getShapes().size() == 1 && getShapes().begin()->first == ANONYMOUS_INPUT_NAME;
+    }
+
+    bool isShapeAnonymousFixed() const {
+        return isShapeAnonymous() && !isShapeAuto(ANONYMOUS_INPUT_NAME);
+    }
+
+    /**
+         * @brief Sets the shape from the string representation
+         *
+         * @param shape
+         * @param str
+         * @return Status
+         */
+    static Status parseShape(ShapeInfo& shapeInfo, const std::string& str);
+
+    /**
+         * @brief Add a single named shape
+         * 
+         * @param name 
+         * @param shape 
+         */
+    void addShape(const std::string& name, const ShapeInfo& shapeInfo) {
+        this->shapes[name] = shapeInfo;
+    }
+
+    void removeShape(const std::string& name) {
+        this->shapes.erase(name);
+    }
+
+    /**
+         * @brief Get the layouts
+         * 
+         * @return const std::string& 
+         */
+    const std::string& getLayout() const {
+        return this->layout;
+    }
+
+    /**
+         * @brief Set the layout
+         * 
+         * @param layout
+         */
+    void setLayout(const std::string& layout) {
+        this->layout = layout;
+        this->layouts.clear();
+    }
+
+    /**
+         * @brief Get the layouts
+         * 
+         * @return const layouts_map_t& 
+         */
+    const layouts_map_t& getLayouts() const {
+        return this->layouts;
     }
 
     /**
@@ -601,6 +1635,94 @@ public:
         this->layout = "";
     }
 
+    /**
+         * @brief Get the precision of all inputs
+         * 
+         * @return const std::string& 
+         */
+    const std::string& getPrecision() const {
+        return this->precision;
+    }
+
+    /**
+         * @brief Set the precision of all inputs
+         * 
+         * @param precision
+         */
+    void setPrecision(const std::string& precision) {
+        this->precision = precision;
+        this->precisions.clear();
+    }
+
+    /**
+         * @brief Get the precisions of named inputs
+         * 
+         * @return const precisions_map_t& 
+         */
+    const precisions_map_t& getPrecisions() const {
+        return this->precisions;
+    }
+
+    /**
+         * @brief Set the precisions of named inputs
+         * 
+         * @param precisions 
+         */
+    void setPrecisions(const precisions_map_t& precisions) {
+        this->precisions = precisions;
+        this->precision = "";
+    }
+
+    /**
+         * @brief Add a named precision
+         * 
+         * @param name 
+         * @param precision 
+         */
+    void addPrecision(const std::string& name, const std::string& precision) {
+        this->precisions[name] = precision;
+        this->precision = "";
+    }
+
+    /**
+         * @brief Get the gRPC response precision of all FP32 outputs
+         * 
+         * @return const std::string& 
+         */
+    const std::string& getOutputPrecision() const {
+        return this->outputPrecision;
+    }
+
+    /**
+         * @brief Set the gRPC response precision of all FP32 outputs
+         * 
+         * @param outputPrecision
+         */
+    void setOutputPrecision(const std::string& outputPrecision) {
+        this->outputPrecision = outputPrecision;
+        this->outputPrecisions.clear();
+    }
+
+    /**
+         * @brief Get the gRPC response precisions of named outputs
+         * 
+         * @return const precisions_map_t& 
+         */
+    const precisions_map_t& getOutputPrecisions() const {
+        return this->outputPrecisions;
+    }
+
+    /**
+         * @brief Add a gRPC response precision of named output
+         * 
+         * @param name 
+         * @param outputPrecision 
+         */
+    void addOutputPrecision(const std::string& name, const std::string& outputPrecision) {
+        this->outputPrecisions[name] = outputPrecision;
+        this->outputPrecision = "";
+    }
+
     /**
          * @brief Get the version
          * 
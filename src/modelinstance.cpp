@@ -16,9 +16,14 @@
 #include "modelinstance.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
@@ -27,7 +32,27 @@
 #include <spdlog/spdlog.h>
 #include <sys/types.h>
 
+#include "compiled_network_cache.hpp"
 #include "config.hpp"
+#include "cpuaffinity.hpp"
+#include "cpustreamsbudget.hpp"
+#include "get_model_metadata_impl.hpp"
+#include "gpucontexts.hpp"
+#include "hash.hpp"
+#include "imagedecoding.hpp"
+#include "isolationgroups.hpp"
+#include "memorymappedfile.hpp"
+#include "memoryusage.hpp"
+#include "metrics.hpp"
+#include "modelmanager.hpp"
+#include "ondemandmodels.hpp"
+#include "ov_utils.hpp"
+#include "perfcounters.hpp"
+#include "postprocessing.hpp"
+#include "preprocessing.hpp"
+#include "serversnapshot.hpp"
+#include "sharedmemory.hpp"
+#include "sharednetworks.hpp"
 #include "stringutils.hpp"
 
 using namespace InferenceEngine;
@@ -43,6 +68,12 @@ const int DEFAULT_OV_STREAMS = std::thread::hardware_concurrency() / 4;
 
 const uint UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS = 10;
 
+const size_t MAX_CACHED_COMPILED_NETWORKS = 3;
+
+const char* PERF_COUNT_KEY = "PERF_COUNT";
+const size_t MAX_PERF_COUNTERS_INFERENCES = 100000;
+const std::chrono::milliseconds MAX_PERF_COUNTERS_TIMEOUT = std::chrono::minutes(10);
+
 Status ModelInstance::loadInputTensors(const ModelConfig& config, const DynamicModelParameter& parameter) {
     if (config.isShapeAnonymousFixed() && network->getInputsInfo().size() > 1) {
         Status status = StatusCode::ANONYMOUS_FIXED_SHAPE_NOT_ALLOWED;
@@ -63,6 +94,16 @@ Status ModelInstance::loadInputTensors(const ModelConfig& config, const DynamicM
             return StatusCode::CONFIG_SHAPE_IS_NOT_IN_NETWORK;
         }
     }
+    for (const auto& precision : config.getPrecisions()) {
+        if (networkInputs.count(precision.first) == 0) {
+            spdlog::error("Config precision - {} not found in network", precision.first);
+            return StatusCode::CONFIG_PRECISION_IS_NOT_IN_NETWORK;
+        }
+    }
+    auto status = applyPreprocessing(config.getPreprocessing(), networkInputs);
+    if (!status.ok()) {
+        return status;
+    }
     for (const auto& pair : networkInputs) {
         const auto& name = pair.first;
         auto input = pair.second;
@@ -82,6 +123,22 @@ Status ModelInstance::loadInputTensors(const ModelConfig& config, const DynamicM
         }
         input->setLayout(layout);
 
+        // Plugin converts input of other precision to precision of the network, e.g. U8 images to FP32
+        const std::string* configPrecision = nullptr;
+        if (config.getPrecision().size()) {
+            configPrecision = &config.getPrecision();
+        } else if (config.getPrecisions().count(name)) {
+            configPrecision = &config.getPrecisions().at(name);
+        }
+        if (configPrecision != nullptr) {
+            precision = TensorInfo::getPrecisionFromString(*configPrecision);
+            if (precision == InferenceEngine::Precision::UNSPECIFIED) {
+                spdlog::error("Config precision - {} of input {} is not supported", *configPrecision, name);
+                return StatusCode::INVALID_PRECISION;
+            }
+            input->setPrecision(precision);
+        }
+
         if (config.getBatchSize() > 0 || parameter.isBatchSizeRequested()) {
             // leave shape untouched
         } else if (config.isShapeAuto(name) && parameter.isShapeRequested(name)) {
@@ -100,6 +157,11 @@ Status ModelInstance::loadInputTensors(const ModelConfig& config, const DynamicM
         }
 
         auto mappingName = config.getMappingInputByKey(name);
+        // clients send frames of source shape, plugin resizes them to network shape
+        auto preprocessing = config.getPreprocessing().find(name);
+        if (preprocessing != config.getPreprocessing().end() && !preprocessing->second.resize.empty()) {
+            shape = preprocessing->second.sourceShape;
+        }
         auto tensor = std::make_shared<TensorInfo>(name, mappingName, precision, shape, layout);
         std::string precision_str = tensor->getPrecisionAsString();
         this->inputsInfo[tensor->getMappedName()] = std::move(tensor);
@@ -185,7 +247,7 @@ std::string ModelInstance::findModelFilePathWithExtension(const std::string& ext
     return findFilePathWithExtension(path, extension);
 }
 
-uint ModelInstance::getNumOfParallelInferRequestsUnbounded(const ModelConfig& modelConfig) {
+uint ModelInstance::getNumOfParallelInferRequestsUnbounded(const ModelConfig& modelConfig, InferenceEngine::ExecutableNetwork* network) {
     uint numberOfParallelInferRequests = 0;
     if (modelConfig.getNireq() > 0) {
         return modelConfig.getNireq();
@@ -197,16 +259,21 @@ uint ModelInstance::getNumOfParallelInferRequestsUnbounded(const ModelConfig& mo
     }
     std::string key = METRIC_KEY(OPTIMAL_NUMBER_OF_INFER_REQUESTS);
     try {
-        numberOfParallelInferRequests = execNetwork->GetMetric(key).as<unsigned int>();
+        numberOfParallelInferRequests = (network != nullptr ? network : execNetwork.get())->GetMetric(key).as<unsigned int>();
     } catch (const details::InferenceEngineException& ex) {
         spdlog::info("Failed to query OPTIMAL_NUMBER_OF_INFER_REQUESTS with error {}. Using 1 nireq.", ex.what());
         numberOfParallelInferRequests = 1u;
     }
+    if (modelConfig.isOverlapRequestProcessingEnabled()) {
+        // while plugin streams run one set of infer requests, request threads deserialize into
+        // and serialize from the other set, plugin queues started requests until a stream is free
+        numberOfParallelInferRequests *= 2;
+    }
     return numberOfParallelInferRequests;
 }
 
-uint ModelInstance::getNumOfParallelInferRequests(const ModelConfig& modelConfig) {
-    uint nireq = getNumOfParallelInferRequestsUnbounded(modelConfig);
+uint ModelInstance::getNumOfParallelInferRequests(const ModelConfig& modelConfig, InferenceEngine::ExecutableNetwork* network) {
+    uint nireq = getNumOfParallelInferRequestsUnbounded(modelConfig, network);
     if (nireq > MAX_NIREQ_COUNT) {
         SPDLOG_ERROR("Invalid nireq because its value was too high:{}. Maximum value:{}", nireq, MAX_NIREQ_COUNT);
         return 0;
@@ -221,8 +288,40 @@ void ModelInstance::loadOVEngine() {
     engine = std::make_unique<InferenceEngine::Core>();
 }
 
+std::unique_ptr<InferenceEngine::CNNNetwork> ModelInstance::readOVCNNNetworkFromStorage(const std::string& modelFile) {
+    auto fs = getFilesystem(modelFile);
+    std::string model;
+    auto weights = std::make_shared<std::string>();
+    auto status = fs->readTextFile(modelFile, &model);
+    if (status == StatusCode::OK) {
+        status = fs->readTextFile(modelFiles[".bin"], weights.get());
+    }
+    if (status != StatusCode::OK) {
+        throw std::runtime_error("Cannot read model files from: " + path + " error: " + Status(status).string());
+    }
+    InferenceEngine::TensorDesc weightsDesc(InferenceEngine::Precision::U8, {weights->size()}, InferenceEngine::Layout::C);
+    auto weightsBlob = blobOnExternalMemory(weightsDesc, weights->data(), weights);
+    SPDLOG_DEBUG("Reading model file:{} with weights of size:{} streamed from storage", modelFile, weights->size());
+    return std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(model, weightsBlob));
+}
+
 std::unique_ptr<InferenceEngine::CNNNetwork> ModelInstance::loadOVCNNNetworkPtr(const std::string& modelFile) {
-    return std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(modelFile));
+    if (isCloudPath(modelFile)) {
+        return readOVCNNNetworkFromStorage(modelFile);
+    }
+    auto weightsFile = modelFiles.find(".bin");
+    auto weights = weightsFile != modelFiles.end() ? MemoryMappedFile::map(weightsFile->second) : nullptr;
+    std::ifstream modelStream(modelFile);
+    if (!weights || !modelStream.good()) {
+        return std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(modelFile));
+    }
+    std::stringstream model;
+    model << modelStream.rdbuf();
+    // network constants refer to mapped weights instead of a heap copy, blob keeps the mapping alive
+    InferenceEngine::TensorDesc weightsDesc(InferenceEngine::Precision::U8, {weights->size()}, InferenceEngine::Layout::C);
+    auto weightsBlob = blobOnExternalMemory(weightsDesc, const_cast<void*>(weights->data()), weights);
+    SPDLOG_DEBUG("Reading model file:{} with memory mapped weights of size:{}", modelFile, weights->size());
+    return std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(model.str(), weightsBlob));
 }
 
 Status ModelInstance::loadOVCNNNetwork() {
@@ -238,11 +337,47 @@ Status ModelInstance::loadOVCNNNetwork() {
 }
 
 void ModelInstance::loadExecutableNetworkPtr(const plugin_config_t& pluginConfig) {
+    if (remoteContext) {
+        execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(GpuContexts::getInstance().loadNetwork(*network, remoteContext, pluginConfig));
+        return;
+    }
     execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(engine->LoadNetwork(*network, targetDevice, pluginConfig));
 }
 
-plugin_config_t ModelInstance::prepareDefaultPluginConfig(const ModelConfig& config) {
+void ModelInstance::prepareRemoteContext(const ModelConfig& config) {
+    remoteContext.reset();
+    if (!config.isGpuContextShared()) {
+        return;
+    }
+    remoteContext = GpuContexts::getInstance().get(targetDevice);
+    if (!remoteContext) {
+        spdlog::warn("Shared GPU context disabled for model {}; version: {}. Target device: {} has no shared context", getName(), getVersion(), targetDevice);
+    }
+}
+
+plugin_config_t ModelInstance::prepareDefaultPluginConfig(const ModelConfig& config, size_t pinnedCpusCount) {
     plugin_config_t pluginConfig = config.getPluginConfig();
+    if (config.isDeviceUsed("CPU") && config.getCpuStreamsShare() > 0) {
+        // share of server wide budget, streams of all models together fit the CPUs
+        if (pluginConfig.count("CPU_THROUGHPUT_STREAMS") == 0) {
+            pluginConfig["CPU_THROUGHPUT_STREAMS"] = std::to_string(config.getCpuStreamsShare());
+        }
+        if (pluginConfig.count("CPU_THREADS_NUM") == 0) {
+            pluginConfig["CPU_THREADS_NUM"] = std::to_string(config.getCpuStreamsShare() * CpuStreamsBudget::getInstance().getThreadsPerStream());
+        }
+    }
+    if (config.isDeviceUsed("CPU") && pinnedCpusCount > 0) {
+        // streams are sized for the node; stream threads inherit affinity of the loading thread instead of being pinned across all cores
+        if (pluginConfig.count("CPU_THROUGHPUT_STREAMS") == 0) {
+            pluginConfig["CPU_THROUGHPUT_STREAMS"] = std::to_string(std::max<size_t>(1, pinnedCpusCount / 4));
+        }
+        if (pluginConfig.count("CPU_THREADS_NUM") == 0) {
+            pluginConfig["CPU_THREADS_NUM"] = std::to_string(pinnedCpusCount);
+        }
+        if (pluginConfig.count("CPU_BIND_THREAD") == 0) {
+            pluginConfig["CPU_BIND_THREAD"] = "NO";
+        }
+    }
     // For CPU and GPU, if user did not specify, calculate CPU_THROUGHPUT_STREAMS automatically
     if (config.isDeviceUsed("CPU")) {
         if (pluginConfig.count("CPU_THROUGHPUT_STREAMS") == 0) {
@@ -257,8 +392,126 @@ plugin_config_t ModelInstance::prepareDefaultPluginConfig(const ModelConfig& con
     return pluginConfig;
 }
 
+std::string ModelInstance::describeCompilation(const ModelConfig& config, const plugin_config_t& pluginConfig) const {
+    std::stringstream description;
+    description << GetInferenceEngineVersion()->buildNumber << ";" << targetDevice << ";";
+    if (!pinnedCpus.empty()) {
+        // networks of models bound to different nodes keep their constants in memory of their nodes,
+        // stream threads of isolation groups run on CPUs of their groups
+        description << "NUMA_NODE=" << config.getNumaNode() << ";ISOLATION_GROUP=" << config.getIsolationGroup() << ";PINNED_CPUS=";
+        for (int cpu : pinnedCpus) {
+            description << cpu << ",";
+        }
+        description << ";";
+    }
+    if (remoteContext) {
+        // networks compiled in other contexts cannot exchange device memory blobs
+        description << "SHARED_GPU_CONTEXT;";
+    }
+    for (const auto& pair : pluginConfig) {
+        description << pair.first << "=" << pair.second << ";";
+    }
+    for (const auto& pair : network->getInputsInfo()) {
+        const auto& desc = pair.second->getTensorDesc();
+        description << pair.first << TensorInfo::shapeToString(desc.getDims()) << desc.getPrecision().name()
+                    << TensorInfo::getStringFromLayout(desc.getLayout()) << ";";
+        // plugin fuses preprocessing into compiled network
+        auto preprocessing = config.getPreprocessing().find(pair.first);
+        if (preprocessing != config.getPreprocessing().end()) {
+            const auto& info = preprocessing->second;
+            description << "PREPROCESSING=" << info.resize << TensorInfo::shapeToString(info.sourceShape) << info.colorFormat;
+            for (float mean : info.mean) {
+                description << ",mean:" << mean;
+            }
+            for (float scale : info.scale) {
+                description << ",scale:" << scale;
+            }
+            description << ";";
+        }
+    }
+    for (const auto& pair : network->getOutputsInfo()) {
+        description << pair.first << pair.second->getPrecision().name() << ";";
+    }
+    return description.str();
+}
+
+bool ModelInstance::importExecutableNetwork(const std::string& blobPath, const plugin_config_t& pluginConfig) {
+    if (!std::filesystem::exists(blobPath)) {
+        return false;
+    }
+    try {
+        if (remoteContext) {
+            std::ifstream blob(blobPath, std::ios::binary);
+            execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(GpuContexts::getInstance().importNetwork(blob, remoteContext, pluginConfig));
+        } else {
+            execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(engine->ImportNetwork(blobPath, targetDevice, pluginConfig));
+        }
+    } catch (std::exception& e) {
+        spdlog::warn("Cannot import compiled model:{} version:{} from: {}; error: {}; model will be compiled",
+            getName(), getVersion(), blobPath, e.what());
+        return false;
+    }
+    spdlog::info("Imported compiled model:{} version:{} from: {}", getName(), getVersion(), blobPath);
+    return true;
+}
+
+void ModelInstance::exportExecutableNetwork(const std::string& blobPath) {
+    // concurrent loads of the same model must not see partially written blob
+    const std::string temporaryPath = blobPath + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    try {
+        execNetwork->Export(temporaryPath);
+        std::filesystem::rename(temporaryPath, blobPath);
+    } catch (std::exception& e) {
+        spdlog::debug("Cannot export compiled model:{} version:{} to: {}; error: {}", getName(), getVersion(), blobPath, e.what());
+        std::error_code ec;
+        std::filesystem::remove(temporaryPath, ec);
+        return;
+    }
+    spdlog::info("Exported compiled model:{} version:{} to: {}", getName(), getVersion(), blobPath);
+}
+
 Status ModelInstance::loadOVExecutableNetwork(const ModelConfig& config) {
-    plugin_config_t pluginConfig = prepareDefaultPluginConfig(config);
+    plugin_config_t pluginConfig = prepareDefaultPluginConfig(config, pinnedCpus.size());
+    if (perfCountEnabled) {
+        pluginConfig[PERF_COUNT_KEY] = "YES";
+    }
+    auto& compiledNetworkCache = CompiledNetworkCache::getInstance();
+    auto& sharedNetworks = SharedNetworks::getInstance();
+    uint64_t modelFilesHash = FNV_OFFSET_BASIS;
+    // blobs and shared networks are keyed by content of local model files
+    if ((!compiledNetworkCache.isEnabled() && !sharedNetworks.isEnabled()) || isCloudPath(path) ||
+        !CompiledNetworkCache::hashModelFiles({modelFiles[".xml"], modelFiles[".bin"]}, modelFilesHash)) {
+        return compileOVExecutableNetwork(config, pluginConfig, std::string());
+    }
+    const auto compilationDescription = describeCompilation(config, pluginConfig);
+    std::string blobPath;
+    if (compiledNetworkCache.isEnabled()) {
+        blobPath = compiledNetworkCache.getBlobPath(modelFilesHash, compilationDescription);
+    }
+    if (!sharedNetworks.isEnabled()) {
+        return compileOVExecutableNetwork(config, pluginConfig, blobPath);
+    }
+    Status status = StatusCode::OK;
+    bool compiled = false;
+    auto network = sharedNetworks.getOrLoad(std::to_string(modelFilesHash) + ";" + compilationDescription, [&]() {
+        compiled = true;
+        status = compileOVExecutableNetwork(config, pluginConfig, blobPath);
+        return status.ok() ? execNetwork : nullptr;
+    });
+    if (!network) {
+        return status;
+    }
+    if (!compiled) {
+        execNetwork = network;
+        spdlog::info("Reused network compiled from identical model files for model:{} version:{}", getName(), getVersion());
+    }
+    return StatusCode::OK;
+}
+
+Status ModelInstance::compileOVExecutableNetwork(const ModelConfig& config, const plugin_config_t& pluginConfig, const std::string& blobPath) {
+    if (!blobPath.empty() && importExecutableNetwork(blobPath, pluginConfig)) {
+        return StatusCode::OK;
+    }
     try {
         loadExecutableNetworkPtr(pluginConfig);
     } catch (std::exception& e) {
@@ -277,11 +530,36 @@ Status ModelInstance::loadOVExecutableNetwork(const ModelConfig& config) {
         const auto value = pair.second;
         spdlog::info("{}: {}", key, value);
     }
+    if (!blobPath.empty()) {
+        exportExecutableNetwork(blobPath);
+    }
+    return StatusCode::OK;
+}
+
+Status ModelInstance::fetchModelFilepathsFromStorage() {
+    auto fs = getFilesystem(path);
+    files_list_t files;
+    if (fs->getDirectoryFiles(path, &files) != StatusCode::OK) {
+        spdlog::error("Missing model directory {}", path);
+        return StatusCode::PATH_INVALID;
+    }
+    for (auto extension : REQUIRED_MODEL_FILES_EXTENSIONS) {
+        auto file = std::find_if(files.begin(), files.end(), [&extension](const std::string& name) { return endsWith(name, extension); });
+        if (file == files.end()) {
+            spdlog::error("Could not find *{} file for model:{} version:{} in path:{}", extension, getName(), getVersion(), path);
+            return StatusCode::FILE_INVALID;
+        }
+        modelFiles[extension] = joinPath({path, *file});
+    }
     return StatusCode::OK;
 }
 
 Status ModelInstance::fetchModelFilepaths() {
     spdlog::debug("Getting model files from path:{}", path);
+    if (isCloudPath(path)) {
+        // model is not downloaded, files are read straight from the storage
+        return fetchModelFilepathsFromStorage();
+    }
     if (!dirExists(path)) {
         spdlog::error("Missing model directory {}", path);
         return StatusCode::PATH_INVALID;
@@ -297,29 +575,677 @@ Status ModelInstance::fetchModelFilepaths() {
     return StatusCode::OK;
 }
 
+void ModelInstance::preallocateResizedInputBlobs(const ModelConfig& config, OVInferRequestsQueue& queue) {
+    for (const auto& [name, tensorInfo] : inputsInfo) {
+        auto preprocessing = config.getPreprocessing().find(tensorInfo->getName());
+        if (preprocessing != config.getPreprocessing().end() && !preprocessing->second.resize.empty()) {
+            queue.preallocateInputBlobs(tensorInfo->getName(), tensorInfo->getTensorDesc());
+        }
+    }
+}
+
 Status ModelInstance::prepareInferenceRequestsQueue(const ModelConfig& config) {
     uint numberOfParallelInferRequests = getNumOfParallelInferRequests(config);
     if (numberOfParallelInferRequests == 0) {
         return Status(StatusCode::INVALID_NIREQ, "Exceeded allowed nireq value");
     }
-    inferRequestsQueue = std::make_unique<OVInferRequestsQueue>(*execNetwork, numberOfParallelInferRequests);
+    auto& queueMetrics = getMetrics().inferRequestsQueue;
+    inferRequestsQueue = std::make_unique<OVInferRequestsQueue>(*execNetwork, numberOfParallelInferRequests,
+        config.getMaxQueueSize(), std::chrono::microseconds(config.getMaxQueueTimeMicroseconds()), &queueMetrics,
+        config.getReservedHighPriorityStreams(), config.getMaxLowPriorityQueueSize());
+    queueMetrics.streams.set(numberOfParallelInferRequests);
+    preallocateResizedInputBlobs(config, *inferRequestsQueue);
+    if (remoteContext) {
+        inferRequestsQueue->allocateRemoteOutputBlobs(remoteContext);
+    }
     spdlog::info("Loaded model {}; version: {}; batch size: {}; No of InferRequests: {}",
         getName(),
         getVersion(),
         getBatchSize(),
         numberOfParallelInferRequests);
+    if (config.getMaxQueueSize() > 0 || config.getMaxQueueTimeMicroseconds() > 0) {
+        spdlog::info("Admission control enabled for model {}; version: {}; max queue size: {}; max queue time: {} us",
+            getName(), getVersion(), config.getMaxQueueSize(), config.getMaxQueueTimeMicroseconds());
+    }
+    if (config.getReservedHighPriorityStreams() > 0 || config.getMaxLowPriorityQueueSize() > 0) {
+        if (config.getReservedHighPriorityStreams() >= numberOfParallelInferRequests) {
+            spdlog::warn("Model {}; version: {} reserves {} of {} infer requests for high priority requests, one is left for low priority",
+                getName(), getVersion(), config.getReservedHighPriorityStreams(), numberOfParallelInferRequests);
+        }
+        spdlog::info("Request priorities enabled for model {}; version: {}; reserved high priority infer requests: {}; max low priority queue size: {}",
+            getName(), getVersion(), config.getReservedHighPriorityStreams(), config.getMaxLowPriorityQueueSize());
+    }
+    prepareBatchingScheduler(config);
+    return StatusCode::OK;
+}
+
+std::string ModelInstance::describeTuning(uint32_t maxStreams) const {
+    std::stringstream description;
+    description << GetInferenceEngineVersion()->buildNumber << ";" << targetDevice << ";" << getNetworkInputShapesKey()
+                << ";cpus:" << std::thread::hardware_concurrency() << ";max_streams:" << maxStreams;
+    return description.str();
+}
+
+Status ModelInstance::applyAutoTuning(const ModelConfig& config, const DynamicModelParameter& parameter, ModelConfig& tunedConfig) {
+    tunedConfig = config;
+    if (parameter.isAnyRequested()) {
+        // tuning on request path would stall requests and replace result tuned for configured shapes
+        if (tuningResult) {
+            auto pluginConfig = config.getPluginConfig();
+            pluginConfig[CPU_THROUGHPUT_STREAMS] = std::to_string(tuningResult->streams);
+            tunedConfig.setPluginConfig(pluginConfig);
+            tunedConfig.setNireq(tuningResult->nireq);
+        }
+        return StatusCode::OK;
+    }
+    tuningResult.reset();
+    if (!config.isAutoTuneEnabled()) {
+        return StatusCode::OK;
+    }
+    if (!config.isDeviceUsed("CPU") || config.getPluginConfig().count(CPU_THROUGHPUT_STREAMS) || config.getNireq() > 0) {
+        spdlog::warn("Auto-tuning of model {}; version: {} skipped, it applies to CPU without {} and nireq configured",
+            getName(), getVersion(), CPU_THROUGHPUT_STREAMS);
+        return StatusCode::OK;
+    }
+    // streams are tuned within CPUs the model is given
+    uint32_t maxStreams = config.getCpuStreamsShare() > 0 ? config.getCpuStreamsShare() : (pinnedCpus.empty() ? std::thread::hardware_concurrency() : pinnedCpus.size());
+    const auto description = describeTuning(maxStreams);
+    // local copies of cloud models are removed after load, their results are kept in server snapshot
+    const bool persistent = !isCloudPath(config.getBasePath());
+    std::optional<TuningCandidate> candidate;
+    if (persistent) {
+        candidate = loadTuningResult(path, description);
+    } else {
+        candidate = ServerSnapshot::getInstance().findTuningResult(getName(), getVersion(), description);
+    }
+    if (candidate) {
+        spdlog::info("Using auto-tuning result saved for model {}; version: {}; streams: {}; nireq: {}",
+            getName(), getVersion(), candidate->streams, candidate->nireq);
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<TuningMeasurement> measurements;
+        auto status = measureTuningCandidates(config, maxStreams, measurements);
+        if (!status.ok()) {
+            return status;
+        }
+        candidate = chooseTuningCandidate(measurements, config.getAutoTuneLatencySloMilliseconds());
+        if (!candidate) {
+            return StatusCode::OK;
+        }
+        spdlog::info("Auto-tuned model {}; version: {} in {} ms; streams: {}; nireq: {}; latency SLO: {} ms",
+            getName(), getVersion(), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+            candidate->streams, candidate->nireq, config.getAutoTuneLatencySloMilliseconds());
+        if (!persistent) {
+            ServerSnapshot::getInstance().recordTuningResult(getName(), getVersion(), description, *candidate);
+        } else if (!saveTuningResult(path, description, *candidate)) {
+            spdlog::warn("Could not save auto-tuning result of model {}; version: {} in: {}", getName(), getVersion(), path);
+        }
+    }
+    tuningResult = candidate;
+    auto pluginConfig = config.getPluginConfig();
+    pluginConfig[CPU_THROUGHPUT_STREAMS] = std::to_string(candidate->streams);
+    tunedConfig.setPluginConfig(pluginConfig);
+    tunedConfig.setNireq(candidate->nireq);
+    return StatusCode::OK;
+}
+
+Status ModelInstance::measureTuningCandidates(const ModelConfig& config, uint32_t maxStreams, std::vector<TuningMeasurement>& measurements) {
+    const auto candidates = generateTuningCandidates(maxStreams);
+    const std::chrono::milliseconds duration(config.getAutoTuneMeasurementMilliseconds());
+    for (size_t first = 0; first < candidates.size();) {
+        const uint32_t streams = candidates[first].streams;
+        size_t last = first;
+        uint32_t maxNireq = 0;
+        while (last < candidates.size() && candidates[last].streams == streams) {
+            maxNireq = std::max(maxNireq, candidates[last].nireq);
+            ++last;
+        }
+        plugin_config_t pluginConfig = prepareDefaultPluginConfig(config, pinnedCpus.size());
+        pluginConfig[CPU_THROUGHPUT_STREAMS] = std::to_string(streams);
+        try {
+            // infer requests are released before the network
+            auto candidateNetwork = engine->LoadNetwork(*network, targetDevice, pluginConfig);
+            std::vector<InferenceEngine::InferRequest> inferRequests;
+            for (uint32_t i = 0; i < maxNireq; ++i) {
+                auto& inferRequest = inferRequests.emplace_back(candidateNetwork.CreateInferRequest());
+                for (const auto& pair : inputsInfo) {
+                    auto blob = inferRequest.GetBlob(pair.second->getName());
+                    std::memset(blob->buffer().as<char*>(), 0, blob->byteSize());
+                }
+            }
+            for (size_t i = first; i < last; ++i) {
+                TuningMeasurement measurement;
+                measurement.candidate = candidates[i];
+                auto status = measureInferenceThroughput(inferRequests, candidates[i].nireq, duration, measurement);
+                if (!status.ok()) {
+                    spdlog::error("Auto-tuning of model {}; version: {} failed: {}", getName(), getVersion(), status.string());
+                    return status;
+                }
+                spdlog::info("Auto-tuning model {}; version: {}; streams: {}; nireq: {}; throughput: {:.1f} inferences/s; average latency: {:.3f} ms",
+                    getName(), getVersion(), streams, candidates[i].nireq, measurement.inferencesPerSecond, measurement.averageLatencyMilliseconds);
+                measurements.push_back(measurement);
+            }
+        } catch (std::exception& e) {
+            Status status = StatusCode::CANNOT_LOAD_NETWORK_INTO_TARGET_DEVICE;
+            spdlog::error("{}; auto-tuning with {} streams failed: {}; model:{}; version:{}", status.string(), streams, e.what(), getName(), getVersion());
+            return status;
+        }
+        first = last;
+    }
+    return StatusCode::OK;
+}
+
+Status ModelInstance::loadDeviceReplicas(const ModelConfig& config) {
+    deviceReplicas.clear();
+    for (const auto& device : config.getReplicaDevices()) {
+        ModelConfig replicaConfig = config;
+        replicaConfig.setTargetDevice(device);
+        plugin_config_t pluginConfig = prepareDefaultPluginConfig(replicaConfig, pinnedCpus.size());
+        if (perfCountEnabled) {
+            pluginConfig[PERF_COUNT_KEY] = "YES";
+        }
+        DeviceReplica replica;
+        replica.device = device;
+        try {
+            if (config.isGpuContextShared()) {
+                replica.remoteContext = GpuContexts::getInstance().get(device);
+            }
+            if (replica.remoteContext) {
+                replica.execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(GpuContexts::getInstance().loadNetwork(*network, replica.remoteContext, pluginConfig));
+            } else {
+                replica.execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(engine->LoadNetwork(*network, device, pluginConfig));
+            }
+        } catch (std::exception& e) {
+            Status status = StatusCode::CANNOT_LOAD_NETWORK_INTO_TARGET_DEVICE;
+            spdlog::error("{}; error: {}; model:{}; version:{}; replica device:{}", status.string(), e.what(), getName(), getVersion(), device);
+            deviceReplicas.clear();
+            return status;
+        }
+        uint numberOfParallelInferRequests = getNumOfParallelInferRequests(replicaConfig, replica.execNetwork.get());
+        if (numberOfParallelInferRequests == 0) {
+            deviceReplicas.clear();
+            return Status(StatusCode::INVALID_NIREQ, "Exceeded allowed nireq value");
+        }
+        // admission limits apply per replica, request waits only in pool it was routed to
+        replica.inferRequestsQueue = std::make_unique<OVInferRequestsQueue>(*replica.execNetwork, numberOfParallelInferRequests,
+            config.getMaxQueueSize(), std::chrono::microseconds(config.getMaxQueueTimeMicroseconds()), nullptr,
+            config.getReservedHighPriorityStreams(), config.getMaxLowPriorityQueueSize());
+        preallocateResizedInputBlobs(config, *replica.inferRequestsQueue);
+        if (replica.remoteContext) {
+            replica.inferRequestsQueue->allocateRemoteOutputBlobs(replica.remoteContext);
+        }
+        spdlog::info("Loaded replica of model {}; version: {}; on device: {}; No of InferRequests: {}",
+            getName(), getVersion(), device, numberOfParallelInferRequests);
+        deviceReplicas.push_back(std::move(replica));
+    }
+    return StatusCode::OK;
+}
+
+Status ModelInstance::loadShapeBuckets(const ModelConfig& config) {
+    shapeBuckets.clear();
+    const size_t dimension = config.getShapeBucketDimension();
+    for (size_t size : config.getShapeBuckets()) {
+        auto bucket = std::make_unique<ShapeBucket>();
+        bucket->size = size;
+        try {
+            // reshaping shares layers with network it was copied from, bucket reads its own
+            auto bucketNetwork = loadOVCNNNetworkPtr(modelFiles[".xml"]);
+            auto shapes = network->getInputShapes();
+            for (auto& pair : shapes) {
+                if (isPaddedToShapeBucket(pair.second, dimension)) {
+                    pair.second[dimension] = size;
+                }
+            }
+            for (const auto& pair : network->getInputsInfo()) {
+                auto& bucketInput = bucketNetwork->getInputsInfo().at(pair.first);
+                bucketInput->setLayout(pair.second->getLayout());
+                bucketInput->setPrecision(pair.second->getPrecision());
+            }
+            bucketNetwork->reshape(shapes);
+            plugin_config_t pluginConfig = prepareDefaultPluginConfig(config, pinnedCpus.size());
+            if (perfCountEnabled) {
+                pluginConfig[PERF_COUNT_KEY] = "YES";
+            }
+            if (remoteContext) {
+                bucket->execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(GpuContexts::getInstance().loadNetwork(*bucketNetwork, remoteContext, pluginConfig));
+            } else {
+                bucket->execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(engine->LoadNetwork(*bucketNetwork, targetDevice, pluginConfig));
+            }
+            for (const auto& pair : inputsInfo) {
+                const auto& input = pair.second;
+                bucket->inputsInfo[pair.first] = std::make_shared<TensorInfo>(input->getName(), pair.first, input->getPrecision(),
+                    shapes.at(input->getName()), input->getLayout());
+            }
+            const auto& bucketOutputs = bucketNetwork->getOutputsInfo();
+            for (const auto& pair : outputsInfo) {
+                const auto& output = pair.second;
+                bucket->outputsInfo[pair.first] = std::make_shared<TensorInfo>(output->getName(), pair.first, output->getPrecision(),
+                    bucketOutputs.at(output->getName())->getDims(), output->getLayout());
+            }
+        } catch (std::exception& e) {
+            Status status = StatusCode::CANNOT_LOAD_NETWORK_INTO_TARGET_DEVICE;
+            spdlog::error("{}; error: {}; model:{}; version:{}; shape bucket:{}", status.string(), e.what(), getName(), getVersion(), size);
+            shapeBuckets.clear();
+            return status;
+        }
+        uint numberOfParallelInferRequests = getNumOfParallelInferRequests(config, bucket->execNetwork.get());
+        if (numberOfParallelInferRequests == 0) {
+            shapeBuckets.clear();
+            return Status(StatusCode::INVALID_NIREQ, "Exceeded allowed nireq value");
+        }
+        bucket->inferRequestsQueue = std::make_unique<OVInferRequestsQueue>(*bucket->execNetwork, numberOfParallelInferRequests,
+            config.getMaxQueueSize(), std::chrono::microseconds(config.getMaxQueueTimeMicroseconds()), nullptr,
+            config.getReservedHighPriorityStreams(), config.getMaxLowPriorityQueueSize());
+        if (remoteContext) {
+            bucket->inferRequestsQueue->allocateRemoteOutputBlobs(remoteContext);
+        }
+        if (batchingScheduler) {
+            bucket->batchingScheduler = std::make_unique<BatchingScheduler>(*this, batchingScheduler->getMaxBatchSize(),
+                std::chrono::microseconds(config.getBatchTimeoutMicroseconds()), bucket.get());
+        }
+        spdlog::info("Loaded shape bucket of model {}; version: {}; size: {} along dimension: {}; No of InferRequests: {}",
+            getName(), getVersion(), size, dimension, numberOfParallelInferRequests);
+        shapeBuckets.push_back(std::move(bucket));
+    }
+    return StatusCode::OK;
+}
+
+ShapeBucket* ModelInstance::selectShapeBucket(const tensorflow::serving::PredictRequest* request, size_t& length) {
+    if (shapeBuckets.empty()) {
+        return nullptr;
+    }
+    const size_t dimension = config.getShapeBucketDimension();
+    // all buckets share inputs padded to them
+    if (!getShapeBucketLength(*request, shapeBuckets.front()->inputsInfo, dimension, length)) {
+        return nullptr;
+    }
+    std::vector<size_t> sizes;
+    for (const auto& bucket : shapeBuckets) {
+        sizes.push_back(bucket->size);
+    }
+    auto index = findShapeBucket(sizes, length);
+    if (!index) {
+        return nullptr;
+    }
+    ShapeBucket* bucket = shapeBuckets[index.value()].get();
+    const bool batchedByScheduler = bucket->batchingScheduler && BatchingScheduler::isRequestBatchable(request);
+    if (request->inputs_size() < 0 || bucket->inputsInfo.size() != static_cast<size_t>(request->inputs_size())) {
+        return nullptr;
+    }
+    for (const auto& pair : bucket->inputsInfo) {
+        auto it = request->inputs().find(pair.first);
+        if (it == request->inputs().end()) {
+            return nullptr;
+        }
+        const auto& shape = pair.second->getShape();
+        const auto& requestShape = it->second.tensor_shape();
+        if (shape.size() != static_cast<size_t>(requestShape.dim_size())) {
+            return nullptr;
+        }
+        for (size_t i = batchedByScheduler ? 1 : 0; i < shape.size(); ++i) {
+            const bool padded = isPaddedToShapeBucket(shape, dimension) && i == dimension;
+            if (!padded && shape[i] != static_cast<size_t>(requestShape.dim(i).size())) {
+                return nullptr;
+            }
+        }
+    }
+    return bucket;
+}
+
+const Status ModelInstance::validateShapeBucketRequest(const tensorflow::serving::PredictRequest* request, const ShapeBucket& bucket) {
+    for (const auto& pair : bucket.inputsInfo) {
+        const auto& requestInput = request->inputs().at(pair.first);
+        auto status = validatePrecision(*pair.second, requestInput);
+        if (!status.ok())
+            return status;
+        status = validateTensorContentSize(*pair.second, requestInput);
+        if (!status.ok())
+            return status;
+    }
+    return StatusCode::OK;
+}
+
+bool ModelInstance::isSplitToMicroBatches(const tensorflow::serving::PredictRequest* request) const {
+    if (!config.isMicroBatchingEnabled() || request->inputs_size() == 0) {
+        return false;
+    }
+    const auto& shape = request->inputs().begin()->second.tensor_shape();
+    return shape.dim_size() > 0 && shape.dim(0).size() > 0 && static_cast<size_t>(shape.dim(0).size()) > getBatchSize();
+}
+
+OVInferRequestsQueue& ModelInstance::selectInferRequestsQueue() {
+    OVInferRequestsQueue* selected = inferRequestsQueue.get();
+    if (deviceReplicas.empty()) {
+        return *selected;
+    }
+    auto selectedEstimate = selected->estimateCompletionTime();
+    auto selectedBusy = selected->getBusyStreamsCount();
+    for (auto& replica : deviceReplicas) {
+        auto estimate = replica.inferRequestsQueue->estimateCompletionTime();
+        // pools not measured yet estimate 0, these are told apart by their load
+        auto busy = replica.inferRequestsQueue->getBusyStreamsCount();
+        if (estimate < selectedEstimate || (estimate == selectedEstimate && busy < selectedBusy)) {
+            selected = replica.inferRequestsQueue.get();
+            selectedEstimate = estimate;
+            selectedBusy = busy;
+        }
+    }
+    return *selected;
+}
+
+OVInferRequestsQueue& ModelInstance::selectInferRequestsQueue(const std::string& device) {
+    if (device.empty()) {
+        return selectInferRequestsQueue();
+    }
+    if (device == config.getTargetDevice()) {
+        return *inferRequestsQueue;
+    }
+    for (auto& replica : deviceReplicas) {
+        if (replica.device == device) {
+            return *replica.inferRequestsQueue;
+        }
+    }
+    SPDLOG_DEBUG("Replica of model {}; version: {} on device {} is not loaded", getName(), getVersion(), device);
+    return selectInferRequestsQueue();
+}
+
+OVInferRequestsQueue& ModelInstance::selectHedgeInferRequestsQueue(const OVInferRequestsQueue& primary) {
+    OVInferRequestsQueue* selected = nullptr;
+    std::chrono::microseconds selectedEstimate;
+    auto consider = [&primary, &selected, &selectedEstimate](OVInferRequestsQueue& queue) {
+        if (&queue == &primary) {
+            return;
+        }
+        auto estimate = queue.estimateCompletionTime();
+        if (selected == nullptr || estimate < selectedEstimate) {
+            selected = &queue;
+            selectedEstimate = estimate;
+        }
+    };
+    consider(*inferRequestsQueue);
+    for (auto& replica : deviceReplicas) {
+        consider(*replica.inferRequestsQueue);
+    }
+    return selected != nullptr ? *selected : *inferRequestsQueue;
+}
+
+bool ModelInstance::runsOnDevice(const std::string& device) const {
+    if (device == config.getTargetDevice()) {
+        return true;
+    }
+    const auto& replicaDevices = config.getReplicaDevices();
+    return std::find(replicaDevices.begin(), replicaDevices.end(), device) != replicaDevices.end();
+}
+
+void ModelInstance::prepareResponseCache(const ModelConfig& config) {
+    responseCache.reset();
+    if (!config.isResponseCacheEnabled()) {
+        return;
+    }
+    if (config.isStateful()) {
+        spdlog::warn("Response cache disabled for model {}; version: {}. Responses of stateful model depend on sequence state", getName(), getVersion());
+        return;
+    }
+    responseCache = std::make_shared<ResponseCache>(config.getResponseCacheSizeMegabytes() * 1024 * 1024,
+        std::chrono::seconds(config.getResponseCacheTtlSeconds()));
+    spdlog::info("Response cache of model {}; version: {}; size: {} MB; ttl: {} s",
+        getName(), getVersion(), config.getResponseCacheSizeMegabytes(), config.getResponseCacheTtlSeconds());
+}
+
+void ModelInstance::prepareRequestCoalescer(const ModelConfig& config) {
+    requestCoalescer.reset();
+    if (!config.isRequestCoalescingEnabled()) {
+        return;
+    }
+    if (config.isStateful()) {
+        spdlog::warn("Request coalescing disabled for model {}; version: {}. Responses of stateful model depend on sequence state", getName(), getVersion());
+        return;
+    }
+    requestCoalescer = std::make_shared<RequestCoalescer>();
+    spdlog::info("Request coalescing enabled for model {}; version: {}", getName(), getVersion());
+}
+
+void ModelInstance::prepareNodeOutputCache(const ModelConfig& config) {
+    nodeOutputCache.reset();
+    if (!config.isNodeOutputCacheEnabled()) {
+        return;
+    }
+    if (config.isStateful()) {
+        spdlog::warn("Node output cache disabled for model {}; version: {}. Outputs of stateful model depend on sequence state", getName(), getVersion());
+        return;
+    }
+    nodeOutputCache = std::make_shared<NodeOutputCache>(config.getNodeOutputCacheSizeMegabytes() * 1024 * 1024,
+        std::chrono::milliseconds(config.getNodeOutputCacheTtlMilliseconds()));
+    spdlog::info("Node output cache of model {}; version: {}; size: {} MB; ttl: {} ms",
+        getName(), getVersion(), config.getNodeOutputCacheSizeMegabytes(), config.getNodeOutputCacheTtlMilliseconds());
+}
+
+void ModelInstance::prepareHedgingPolicy(const ModelConfig& config) {
+    hedgingPolicy.reset();
+    if (!config.isHedgingEnabled()) {
+        return;
+    }
+    hedgingPolicy = std::make_shared<HedgingPolicy>(config.getHedgingPercentile(), config.getHedgingBudgetPercent());
+    spdlog::info("Hedging requests of model {}; version: {}; percentile: {}; budget: {}%",
+        getName(), getVersion(), config.getHedgingPercentile(), config.getHedgingBudgetPercent());
+}
+
+void ModelInstance::prepareSequenceManager(const ModelConfig& config) {
+    sequenceManager.reset();
+    if (!config.isStateful()) {
+        return;
+    }
+    sequenceManager = std::make_shared<SequenceManager>(config.getMaxSequenceNumber(), std::chrono::seconds(config.getSequenceTimeoutSeconds()));
+    spdlog::info("Stateful model {}; version: {}; max sequence number: {}; sequence timeout: {} s",
+        getName(), getVersion(), config.getMaxSequenceNumber(), config.getSequenceTimeoutSeconds());
+}
+
+void ModelInstance::prepareBatchingScheduler(const ModelConfig& config) {
+    batchingScheduler.reset();
+    if (!config.isDynamicBatchingEnabled()) {
+        return;
+    }
+    // batched requests are split along first dimension of every input and output
+    for (const auto& tensorMap : {std::cref(inputsInfo), std::cref(outputsInfo)}) {
+        for (const auto& pair : tensorMap.get()) {
+            auto& shape = pair.second->getShape();
+            if (shape.size() == 0 || shape[0] != config.getMaxBatchSize()) {
+                spdlog::warn("Dynamic batching disabled for model {}; version: {}. Tensor {} has no batch dimension at position 0",
+                    getName(), getVersion(), pair.first);
+                return;
+            }
+        }
+    }
+    batchingScheduler = std::make_unique<BatchingScheduler>(*this, config.getMaxBatchSize(),
+        std::chrono::microseconds(config.getBatchTimeoutMicroseconds()));
+    spdlog::info("Dynamic batching enabled for model {}; version: {}; max batch size: {}; timeout: {} us",
+        getName(), getVersion(), config.getMaxBatchSize(), config.getBatchTimeoutMicroseconds());
+}
+
+void ModelInstance::prepareFairShareQueue() {
+    fairShareQueue.reset();
+    if (!Tenants::getInstance().isEnabled()) {
+        return;
+    }
+    size_t slots = inferRequestsQueue->getStreamsLength();
+    for (const auto& replica : deviceReplicas) {
+        slots += replica.inferRequestsQueue->getStreamsLength();
+    }
+    fairShareQueue = std::make_unique<FairShareQueue>(slots);
+}
+
+Status ModelInstance::warmUp(const ModelConfig& config) {
+    const auto iterations = config.getWarmupIterations();
+    if (iterations == 0) {
+        return StatusCode::OK;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    try {
+        for (int streamId = 0; streamId < inferRequestsQueue->getStreamsLength(); ++streamId) {
+            auto& inferRequest = inferRequestsQueue->getInferRequest(streamId);
+            const auto& preallocatedBlobs = inferRequestsQueue->getPreallocatedInputBlobs(streamId);
+            for (const auto& pair : inputsInfo) {
+                const auto& name = pair.second->getName();
+                auto& blob = preallocatedBlobs.at(name);
+                std::memset(blob->buffer().as<char*>(), 0, blob->byteSize());
+                inferRequest.SetBlob(name, blob);
+            }
+            for (uint64_t i = 0; i < iterations; ++i) {
+                inferRequest.Infer();
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        spdlog::error("Warm-up of model {}; version: {} failed: {}", getName(), getVersion(), e.what());
+        return Status(StatusCode::NETWORK_NOT_LOADED, "Warm-up inference failed");
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+    spdlog::info("Warmed up model {}; version: {} with {} inferences per infer request in {} ms",
+        getName(), getVersion(), iterations, elapsed.count());
     return StatusCode::OK;
 }
 
 void ModelInstance::configureBatchSize(const ModelConfig& config, const DynamicModelParameter& parameter) {
     if (parameter.isBatchSizeRequested()) {
         network->setBatchSize(parameter.getBatchSize());
+    } else if (config.isDynamicBatchingEnabled()) {
+        network->setBatchSize(config.getMaxBatchSize());
     } else if (config.getBatchSize() > 0) {
         network->setBatchSize(config.getBatchSize());
     }
 }
 
+std::string ModelInstance::getNetworkInputShapesKey() const {
+    std::stringstream key;
+    for (const auto& pair : network->getInputShapes()) {
+        key << pair.first << TensorInfo::shapeToString(pair.second) << ";";
+    }
+    return key.str();
+}
+
+Status ModelInstance::loadOrReuseExecutableNetwork(const ModelConfig& config, const DynamicModelParameter& parameter) {
+    if (parameter.isAnyRequested() && !deviceReplicas.empty()) {
+        spdlog::info("Replicas of model {}; version: {} are not used for requested shapes, target device runs all requests", getName(), getVersion());
+        deviceReplicas.clear();
+    }
+    if (!parameter.isAnyRequested()) {
+        // networks compiled for previous configuration cannot be reused
+        compiledNetworksCache.clear();
+        inputShapesKey.clear();
+        prepareResponseCache(config);
+        prepareRequestCoalescer(config);
+        prepareNodeOutputCache(config);
+        prepareHedgingPolicy(config);
+        prepareSequenceManager(config);
+    } else if (execNetwork) {
+        // keep network compiled for previous shapes, requests may switch back to these
+        compiledNetworksCache.push_front({inputShapesKey, std::move(execNetwork), std::move(inferRequestsQueue)});
+        if (compiledNetworksCache.size() > MAX_CACHED_COMPILED_NETWORKS) {
+            compiledNetworksCache.pop_back();
+        }
+    }
+    const auto requestedKey = getNetworkInputShapesKey();
+    auto it = std::find_if(compiledNetworksCache.begin(), compiledNetworksCache.end(),
+        [&requestedKey](const CompiledNetwork& compiled) { return compiled.inputShapesKey == requestedKey; });
+    if (it != compiledNetworksCache.end()) {
+        execNetwork = std::move(it->execNetwork);
+        inferRequestsQueue = std::move(it->inferRequestsQueue);
+        compiledNetworksCache.erase(it);
+        getMetrics().inferRequestsQueue.streams.set(inferRequestsQueue->getStreamsLength());
+        inputShapesKey = requestedKey;
+        spdlog::info("Reused network compiled earlier for model {}; version: {}; batch size: {}; input shapes: {}",
+            getName(), getVersion(), getBatchSize(), inputShapesKey);
+        prepareBatchingScheduler(config);
+        prepareFairShareQueue();
+        return StatusCode::OK;
+    }
+    // stream threads started by compilation inherit affinity and infer request buffers are first touched on the node
+    ScopedThreadAffinity pinnedAffinity(pinnedCpus);
+    ModelConfig tunedConfig;
+    auto status = applyAutoTuning(config, parameter, tunedConfig);
+    if (!status.ok()) {
+        return status;
+    }
+    status = loadOVExecutableNetwork(tunedConfig);
+    if (!status.ok()) {
+        return status;
+    }
+    status = prepareInferenceRequestsQueue(tunedConfig);
+    if (!status.ok()) {
+        return status;
+    }
+    status = warmUp(tunedConfig);
+    if (!status.ok()) {
+        return status;
+    }
+    if (!parameter.isAnyRequested()) {
+        status = loadDeviceReplicas(config);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    if (!parameter.isAnyRequested()) {
+        status = loadShapeBuckets(tunedConfig);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    prepareFairShareQueue();
+    inputShapesKey = requestedKey;
+    return StatusCode::OK;
+}
+
+Status ModelInstance::preparePinnedCpus(const ModelConfig& config) {
+    pinnedCpus.clear();
+    auto& isolationGroups = IsolationGroups::getInstance();
+    if (!config.getIsolationGroup().empty()) {
+        if (config.getNumaNode() != NO_NUMA_NODE) {
+            spdlog::warn("Model:{} version:{} NUMA node:{} is ignored, model runs on CPUs of its isolation group:{}",
+                getName(), getVersion(), config.getNumaNode(), config.getIsolationGroup());
+        }
+        pinnedCpus = isolationGroups.getGroupCpus(config.getIsolationGroup());
+        if (pinnedCpus.empty()) {
+            Status status = StatusCode::ISOLATION_GROUP_MISSING;
+            spdlog::error("{}; model:{}; version:{}; isolation group:{}", status.string(), getName(), getVersion(), config.getIsolationGroup());
+            return status;
+        }
+        spdlog::info("Model:{} version:{} bound to isolation group:{} with {} CPUs", getName(), getVersion(), config.getIsolationGroup(), pinnedCpus.size());
+        return StatusCode::OK;
+    }
+    if (config.getNumaNode() == NO_NUMA_NODE) {
+        // CPUs reserved for isolation groups are left to their models
+        pinnedCpus = isolationGroups.getUngroupedCpus();
+        return StatusCode::OK;
+    }
+    pinnedCpus = isolationGroups.excludeReservedCpus(getNumaNodeCpus(config.getNumaNode()));
+    if (pinnedCpus.empty()) {
+        Status status = StatusCode::INVALID_NUMA_NODE;
+        spdlog::error("{}; model:{}; version:{}; NUMA node:{}", status.string(), getName(), getVersion(), config.getNumaNode());
+        return status;
+    }
+    spdlog::info("Model:{} version:{} bound to NUMA node:{} with {} CPUs", getName(), getVersion(), config.getNumaNode(), pinnedCpus.size());
+    return StatusCode::OK;
+}
+
+void ModelInstance::recordMemoryUsage(uint64_t residentMemoryBytesBeforeLoad) {
+    const uint64_t residentMemoryBytes = getResidentMemoryBytes();
+    loadResidentMemoryBytes = residentMemoryBytes > residentMemoryBytesBeforeLoad ? residentMemoryBytes - residentMemoryBytesBeforeLoad : 0;
+    uint64_t blobsBytes = inferRequestsQueue ? inferRequestsQueue->getBlobsByteSize() : 0;
+    for (const auto& replica : deviceReplicas) {
+        blobsBytes += replica.inferRequestsQueue->getBlobsByteSize();
+    }
+    for (const auto& bucket : shapeBuckets) {
+        blobsBytes += bucket->inferRequestsQueue->getBlobsByteSize();
+    }
+    inferRequestBlobsBytes = blobsBytes;
+    auto& metrics = getMetrics();
+    metrics.loadResidentMemory.set(static_cast<double>(loadResidentMemoryBytes));
+    metrics.inferRequestBlobsMemory.set(static_cast<double>(inferRequestBlobsBytes));
+    spdlog::info("Model: {}; version: {} memory; resident growth at load: {} MB; infer request blobs: {} MB",
+        getName(), getVersion(), loadResidentMemoryBytes / (1024 * 1024), inferRequestBlobsBytes / (1024 * 1024));
+}
+
 Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicModelParameter& parameter) {
+    const uint64_t residentMemoryBytesBeforeLoad = getResidentMemoryBytes();
     this->path = config.getPath();
     this->targetDevice = config.getTargetDevice();
     this->config = config;
@@ -328,9 +1254,15 @@ Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicMode
         this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
         return status;
     }
+    status = preparePinnedCpus(config);
+    if (!status.ok()) {
+        this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
+        return status;
+    }
     try {
         if (!this->engine)
             loadOVEngine();
+        prepareRemoteContext(config);
 
         status = StatusCode::OK;
         if (!this->network)
@@ -340,6 +1272,9 @@ Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicMode
             return status;
         }
 
+        // validator and metadata of previous inputs must not be used if loading fails
+        requestValidator.clear();
+        std::atomic_store(&metadataCache, std::shared_ptr<const ModelMetadataCache>());
         configureBatchSize(this->config, parameter);
         status = loadInputTensors(this->config, parameter);
         if (!status.ok()) {
@@ -347,21 +1282,28 @@ Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicMode
             return status;
         }
         loadOutputTensors(this->config);
-        status = loadOVExecutableNetwork(this->config);
+        status = validatePostprocessing(this->config.getPostprocessing(), this->outputsInfo);
+        if (status.ok()) {
+            status = validateOutputPrecision(this->config.getOutputPrecisions(), this->outputsInfo);
+        }
         if (!status.ok()) {
             this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
             return status;
         }
-        status = prepareInferenceRequestsQueue(this->config);
+        status = loadOrReuseExecutableNetwork(this->config, parameter);
         if (!status.ok()) {
             this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
             return status;
         }
+        requestValidator.compile(this->inputsInfo);
+        std::atomic_store(&metadataCache, GetModelMetadataImpl::buildMetadataCache(*this));
     } catch (const InferenceEngine::details::InferenceEngineException& e) {
         spdlog::error("exception occurred while loading network: {}", e.what());
         this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
         return StatusCode::NETWORK_NOT_LOADED;
     }
+    networkLoaded = true;
+    recordMemoryUsage(residentMemoryBytesBeforeLoad);
     this->status.setAvailable();
     modelLoadedNotify.notify_all();
     return status;
@@ -380,7 +1322,212 @@ Status ModelInstance::loadModel(const ModelConfig& config) {
     this->status.setLoading();
     this->name = config.getName();
     this->version = config.getVersion();
-    return loadModelImpl(config);
+    this->loadOnDemand = config.isLoadOnDemand();
+    this->idleUnloadSeconds = config.getIdleUnloadSeconds();
+    if (loadOnDemand) {
+        return deferLoading(config);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    auto status = loadModelImpl(config);
+    if (status.ok()) {
+        // reading and compilation time, downloads from cloud storage are measured separately
+        MetricsRegistry::getInstance().gauge("ovms_model_version_load_duration_seconds", "Duration of last load of model version, from reading model files until warm-up is finished",
+                                          {{"name", getName()}, {"version", std::to_string(getVersion())}})
+            .set(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return status;
+}
+
+ModelMetrics& ModelInstance::getMetrics() const {
+    std::call_once(metricsRegistered, [this]() {
+        metrics = std::make_unique<ModelMetrics>(getName(), getVersion());
+    });
+    return *metrics;
+}
+
+Status ModelInstance::deferLoading(const ModelConfig& config) {
+    this->path = config.getPath();
+    this->targetDevice = config.getTargetDevice();
+    this->config = config;
+    auto status = fetchModelFilepaths();
+    if (!status.ok()) {
+        this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
+        return status;
+    }
+    modelFilesSize = 0;
+    for (const auto& [extension, file] : modelFiles) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(file, ec);
+        if (!ec) {
+            modelFilesSize += size;
+        }
+    }
+    spdlog::info("Model: {}, version: {} will be loaded on first request", getName(), getVersion());
+    this->status.setAvailable();
+    modelLoadedNotify.notify_all();
+    return StatusCode::OK;
+}
+
+Status ModelInstance::ensureNetworkLoaded(std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuard) {
+    // unload guard is already held, so checking the flag after it was acquired is enough to prevent eviction
+    if (!loadOnDemand) {
+        return StatusCode::OK;
+    }
+    if (networkLoaded) {
+        markUsed();
+        return StatusCode::OK;
+    }
+    modelInstanceUnloadGuard.reset();
+    std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+    if (getStatus().getState() != ModelVersionState::AVAILABLE) {
+        return StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE;
+    }
+    if (!networkLoaded) {
+        spdlog::info("Loading model: {}, version: {} on demand", getName(), getVersion());
+        OnDemandModels::getInstance().makeRoom(*this, getEstimatedMemoryBytes());
+        ModelConfig onDemandConfig = this->config;
+        auto status = loadModelImpl(onDemandConfig);
+        if (!status.ok()) {
+            // version stays available, so following requests try to load it again
+            releaseNetwork();
+            this->status.setAvailable();
+            return status;
+        }
+        OnDemandModels::getInstance().registerLoaded(*this);
+    }
+    modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
+    markUsed();
+    return StatusCode::OK;
+}
+
+void ModelInstance::markUsed() {
+    // stored at most once per millisecond, concurrent requests mostly share the cache line for reading
+    const int64_t now = getSteadyClockMicroseconds();
+    if (now - lastUsedMicroseconds.load(std::memory_order_relaxed) >= LAST_USED_RESOLUTION_MICROSECONDS) {
+        lastUsedMicroseconds.store(now, std::memory_order_relaxed);
+    }
+}
+
+bool ModelInstance::tryEvict() {
+    std::unique_lock<std::recursive_mutex> loadingLock(loadingMutex, std::try_to_lock);
+    if (!loadingLock.owns_lock() || !loadOnDemand || !networkLoaded) {
+        return false;
+    }
+    // requests acquiring unload guard after the flag is cleared compile network again
+    networkLoaded = false;
+    if (!canUnloadInstance()) {
+        networkLoaded = true;
+        return false;
+    }
+    releaseNetwork();
+    return true;
+}
+
+void ModelInstance::releaseNetwork() {
+    networkLoaded = false;
+    batchingScheduler.reset();
+    fairShareQueue.reset();
+    shapeBuckets.clear();
+    responseCache.reset();
+    requestCoalescer.reset();
+    nodeOutputCache.reset();
+    hedgingPolicy.reset();
+    sequenceManager.reset();
+    deviceReplicas.clear();
+    inferRequestsQueue.reset();
+    getMetrics().inferRequestsQueue.streams.set(0);
+    // last measurement is kept as estimate of the next load, only blobs are released
+    inferRequestBlobsBytes = 0;
+    getMetrics().inferRequestBlobsMemory.set(0);
+    execNetwork.reset();
+    remoteContext.reset();
+    compiledNetworksCache.clear();
+    inputShapesKey.clear();
+    network.reset();
+}
+
+Status ModelInstance::collectPerfCounters(size_t inferencesCount, std::chrono::milliseconds timeout, std::string& json) {
+    if (inferencesCount == 0 || inferencesCount > MAX_PERF_COUNTERS_INFERENCES || timeout > MAX_PERF_COUNTERS_TIMEOUT) {
+        return StatusCode::PROFILER_INVALID_PARAMETERS;
+    }
+    std::unique_lock<std::mutex> collectionLock(perfCountersCollectionMutex, std::try_to_lock);
+    if (!collectionLock.owns_lock()) {
+        return StatusCode::PROFILER_ALREADY_RUNNING;
+    }
+    const auto& pluginConfig = config.getPluginConfig();
+    auto it = pluginConfig.find(PERF_COUNT_KEY);
+    const bool reloadRequired = it == pluginConfig.end() || it->second != "YES";
+    {
+        // config reloads and retirement must not interleave with reloading for profiling
+        std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+        if (getStatus().getState() != ModelVersionState::AVAILABLE) {
+            return StatusCode::MODEL_VERSION_NOT_LOADED_YET;
+        }
+        if (reloadRequired) {
+            spdlog::info("Reloading model:{} version:{} with performance counters enabled", getName(), getVersion());
+            perfCountEnabled = true;
+            auto status = reloadModel(config);
+            if (!status.ok()) {
+                perfCountEnabled = false;
+                recoverFromReloadingError(status);
+                return status;
+            }
+        }
+    }
+
+    auto collector = std::make_shared<PerfCountersCollector>(inferencesCount);
+    {
+        std::lock_guard<std::mutex> lock(perfCountersCollectorMutex);
+        perfCountersCollector = collector;
+        collectingPerfCounters = true;
+    }
+    if (!collector->waitForCompletion(timeout)) {
+        spdlog::info("Collected performance counters of {} out of {} inferences of model:{} version:{} before timeout",
+            collector->getCollectedCount(), inferencesCount, getName(), getVersion());
+    }
+    {
+        std::lock_guard<std::mutex> lock(perfCountersCollectorMutex);
+        collectingPerfCounters = false;
+        perfCountersCollector.reset();
+    }
+    json = collector->toJson();
+
+    if (reloadRequired) {
+        std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+        perfCountEnabled = false;
+        // version retired or reloaded with new config during collection is not loaded with counters anymore
+        if (getStatus().getState() != ModelVersionState::AVAILABLE) {
+            return StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE;
+        }
+        spdlog::info("Reloading model:{} version:{} with performance counters disabled", getName(), getVersion());
+        auto status = reloadModel(config);
+        if (!status.ok()) {
+            recoverFromReloadingError(status);
+        }
+    }
+    return StatusCode::OK;
+}
+
+void ModelInstance::recordPerfCountersToCollector(InferenceEngine::InferRequest& inferRequest) {
+    std::shared_ptr<PerfCountersCollector> collector;
+    {
+        std::lock_guard<std::mutex> lock(perfCountersCollectorMutex);
+        collector = perfCountersCollector;
+    }
+    if (!collector) {
+        return;
+    }
+    try {
+        collector->add(inferRequest.GetPerformanceCounts());
+    } catch (const std::exception& e) {
+        spdlog::debug("Cannot get performance counters of model:{} version:{}; error: {}", getName(), getVersion(), e.what());
+    }
+}
+
+ModelInstance::~ModelInstance() {
+    if (loadOnDemand) {
+        OnDemandModels::getInstance().unregister(*this);
+    }
 }
 
 Status ModelInstance::recoverFromReshapeError() {
@@ -397,6 +1544,7 @@ Status ModelInstance::recoverFromReshapeError() {
         return status;
     }
     this->loadOutputTensors(this->config);
+    requestValidator.compile(this->inputsInfo);
     this->status.setAvailable();
     this->modelLoadedNotify.notify_all();
     return StatusCode::OK;
@@ -407,7 +1555,7 @@ Status ModelInstance::reloadModel(const ModelConfig& config, const DynamicModelP
     this->status.setLoading();
     while (!canUnloadInstance()) {
         SPDLOG_INFO("Waiting to reload model: {} version: {}. Blocked by: {} inferences in progress.",
-            getName(), getVersion(), predictRequestsHandlesCount);
+            getName(), getVersion(), getPredictRequestsHandlesCount());
         std::this_thread::sleep_for(std::chrono::milliseconds(UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS));
     }
     return loadModelImpl(config, parameter);
@@ -465,7 +1613,7 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
     modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
     if (getStatus().getState() == ModelVersionState::AVAILABLE) {
         SPDLOG_DEBUG("Model:{}, version:{} already loaded", getName(), getVersion());
-        return StatusCode::OK;
+        return ensureNetworkLoaded(modelInstanceUnloadGuard);
     }
     SPDLOG_INFO("Model:{} version:{} is still loading", getName(), getVersion());
     modelInstanceUnloadGuard.reset();
@@ -490,7 +1638,7 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
         modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
         if (getStatus().getState() == ModelVersionState::AVAILABLE) {
             SPDLOG_INFO("Succesfully waited for model:{}, version:{}", getName(), getVersion());
-            return StatusCode::OK;
+            return ensureNetworkLoaded(modelInstanceUnloadGuard);
         }
         modelInstanceUnloadGuard.reset();
         if (ModelVersionState::AVAILABLE < getStatus().getState()) {
@@ -514,15 +1662,18 @@ void ModelInstance::unloadModel() {
     this->status.setUnloading();
     while (!canUnloadInstance()) {
         SPDLOG_INFO("Waiting to unload model:{} version:{}. Blocked by:{} inferences in progres.",
-            getName(), getVersion(), predictRequestsHandlesCount);
+            getName(), getVersion(), getPredictRequestsHandlesCount());
         std::this_thread::sleep_for(std::chrono::milliseconds(UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS));
     }
-    inferRequestsQueue.reset();
-    execNetwork.reset();
-    network.reset();
+    if (loadOnDemand) {
+        OnDemandModels::getInstance().unregister(*this);
+    }
+    releaseNetwork();
     engine.reset();
     outputsInfo.clear();
     inputsInfo.clear();
+    requestValidator.clear();
+    std::atomic_store(&metadataCache, std::shared_ptr<const ModelMetadataCache>());
     modelFiles.clear();
     status.setEnd();
 }
@@ -585,12 +1736,12 @@ const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& ne
     int8        data in request.tensor_content
     uint8       data in request.tensor_content
     int16       data in request.tensor_content
-    uint16      request.tensor_content is empty, data located in request.int_val
+    uint16      request.tensor_content is empty, data located in request.int_val, or packed in request.tensor_content
     int32       data in request.tensor_content
     uint32      data in request.tensor_content
     int64       data in request.tensor_content
     uint64      data in request.tensor_content
-    float16     request.tensor_content is empty, data located in request.half_val
+    float16     request.tensor_content is empty, data located in request.half_val, or packed in request.tensor_content
     float32     data in request.tensor_content
     double      data in request.tensor_content
 
@@ -603,8 +1754,19 @@ const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& ne
         expectedValueCount *= requestInput.tensor_shape().dim(i).size();
     }
 
+    if (isSharedMemoryInput(requestInput)) {
+        // values are laid out in network precision, also for containers padding uint16 and float16
+        std::shared_ptr<const SharedMemoryRegion> region;
+        const char* data = nullptr;
+        auto status = getSharedMemoryInput(requestInput, expectedValueCount * networkInput.getPrecision().size(), region, data);
+        if (!status.ok()) {
+            spdlog::debug("[Model:{} version:{}] Invalid shared memory input - {}", getName(), getVersion(), status.string());
+        }
+        return status;
+    }
+
     // Network expects tensor content size or value count
-    if (requestInput.dtype() == tensorflow::DataType::DT_UINT16) {
+    if (requestInput.dtype() == tensorflow::DataType::DT_UINT16 && requestInput.tensor_content().empty()) {
         if (requestInput.int_val_size() < 0 ||
             expectedValueCount != static_cast<size_t>(requestInput.int_val_size())) {
             std::stringstream ss;
@@ -613,7 +1775,7 @@ const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& ne
             spdlog::debug("[Model:{} version:{}] Invalid number of values in tensor proto container - {}", getName(), getVersion(), details);
             return Status(StatusCode::INVALID_VALUE_COUNT, details);
         }
-    } else if (requestInput.dtype() == tensorflow::DataType::DT_HALF) {
+    } else if (requestInput.dtype() == tensorflow::DataType::DT_HALF && requestInput.tensor_content().empty()) {
         if (requestInput.half_val_size() < 0 ||
             expectedValueCount != static_cast<size_t>(requestInput.half_val_size())) {
             std::stringstream ss;
@@ -636,12 +1798,17 @@ const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& ne
 }
 
 const Status ModelInstance::validate(const tensorflow::serving::PredictRequest* request) {
+    // matching requests are accepted without walking inputs info, others are validated below for the reason
+    if (requestValidator.isValid(*request, getBatchSize(), batchingScheduler && BatchingScheduler::isRequestBatchable(request))) {
+        return StatusCode::OK;
+    }
     Status finalStatus = StatusCode::OK;
 
-    // Network and request must have the same amount of inputs
-    if (request->inputs_size() < 0 || getInputsInfo().size() != static_cast<size_t>(request->inputs_size())) {
+    // Network and request must have the same amount of inputs, requests to stateful model may also have sequence inputs
+    const size_t sequenceInputsCount = sequenceManager != nullptr ? countSequenceInputs(*request) : 0;
+    if (request->inputs_size() < 0 || getInputsInfo().size() + sequenceInputsCount != static_cast<size_t>(request->inputs_size())) {
         std::stringstream ss;
-        ss << "Expected: " << getInputsInfo().size() << "; Actual: " << request->inputs_size();
+        ss << "Expected: " << getInputsInfo().size() << "; Actual: " << request->inputs_size() - sequenceInputsCount;
         const std::string details = ss.str();
         spdlog::debug("[Model:{} version:{}] Invalid number of inputs - {}", getName(), getVersion(), details);
         return Status(StatusCode::INVALID_NO_OF_INPUTS, details);
@@ -663,8 +1830,19 @@ const Status ModelInstance::validate(const tensorflow::serving::PredictRequest*
 
         auto& requestInput = it->second;
         Mode batchingMode = getModelConfig().getBatchingMode();
+        // batch size 1 requests are merged by batching scheduler, first dimension is not validated against network
+        const bool batchedByScheduler = batchingScheduler && BatchingScheduler::isRequestBatchable(request);
         Mode shapeMode = getModelConfig().isShapeAuto(name) ? AUTO : FIXED;
 
+        if (isImageInput(requestInput)) {
+            auto status = validateImageInput(*networkInput, requestInput);
+            if (!status.ok()) {
+                spdlog::debug("[Model:{} version:{}] Invalid image input {} - {}", getName(), getVersion(), name, status.string());
+                return status;
+            }
+            continue;
+        }
+
         auto status = validatePrecision(*networkInput, requestInput);
         if (!status.ok())
             return status;
@@ -673,7 +1851,7 @@ const Status ModelInstance::validate(const tensorflow::serving::PredictRequest*
         if (!status.ok())
             return status;
 
-        if (checkBatchSizeMismatch(*networkInput, requestInput)) {
+        if (!batchedByScheduler && checkBatchSizeMismatch(*networkInput, requestInput)) {
             if (batchingMode == AUTO) {
                 finalStatus = StatusCode::BATCHSIZE_CHANGE_REQUIRED;
             } else if (shapeMode != AUTO) {
@@ -685,7 +1863,7 @@ const Status ModelInstance::validate(const tensorflow::serving::PredictRequest*
             }
         }
 
-        if (checkShapeMismatch(*networkInput, requestInput, batchingMode)) {
+        if (checkShapeMismatch(*networkInput, requestInput, batchedByScheduler ? AUTO : batchingMode)) {
             if (shapeMode == AUTO) {
                 finalStatus = StatusCode::RESHAPE_REQUIRED;
             } else {
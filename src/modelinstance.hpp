@@ -15,10 +15,16 @@
 //*****************************************************************************
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -28,15 +34,30 @@
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 
+#include "autotuning.hpp"
+#include "batchingscheduler.hpp"
+#include "hedging.hpp"
 #include "modelconfig.hpp"
 #include "modelinstanceunloadguard.hpp"
+#include "modelmetrics.hpp"
 #include "modelversionstatus.hpp"
+#include "nodeoutputcache.hpp"
 #include "ovinferrequestsqueue.hpp"
+#include "perfcounters.hpp"
+#include "requestcoalescer.hpp"
+#include "requestvalidator.hpp"
+#include "responsecache.hpp"
+#include "sequencemanager.hpp"
+#include "shapebuckets.hpp"
+#include "shardedcounter.hpp"
 #include "status.hpp"
 #include "tensorinfo.hpp"
+#include "tenantscheduling.hpp"
 
 namespace ovms {
 
+struct ModelMetadataCache;
+
 using tensor_map_t = std::map<std::string, std::shared_ptr<TensorInfo>>;
 
 class DynamicModelParameter {
@@ -51,6 +72,7 @@ public:
         batchSize(0),
         shapes(shapes) {}
 
+    bool isAnyRequested() const { return batchSize > 0 || shapes.size() > 0; }
     bool isBatchSizeRequested() const { return batchSize > 0; }
     bool isShapeRequested(const std::string& name) const { return shapes.count(name) && shapes.at(name).size() > 0; }
 
@@ -82,6 +104,11 @@ protected:
          */
     std::shared_ptr<InferenceEngine::ExecutableNetwork> execNetwork;
 
+    /**
+         * @brief GPU context shared with other models the network is compiled in, nullptr if context is not shared
+         */
+    InferenceEngine::RemoteContext::Ptr remoteContext;
+
     /**
          * @brief Model name
          */
@@ -119,6 +146,13 @@ protected:
          */
     virtual std::unique_ptr<InferenceEngine::CNNNetwork> loadOVCNNNetworkPtr(const std::string& modelFile);
 
+    /**
+         * @brief Reads OV CNNNetwork from model files in cloud storage into memory, no local copy is created
+         *
+         * @return CNNNetwork ptr
+         */
+    std::unique_ptr<InferenceEngine::CNNNetwork> readOVCNNNetworkFromStorage(const std::string& modelFile);
+
     /**
          * @brief Load OV Engine
          */
@@ -143,11 +177,118 @@ protected:
          */
     Status loadOVExecutableNetwork(const ModelConfig& config);
 
+    /**
+         * @brief Imports network from blob path if not empty or compiles it, exports compiled network to blob path
+         *
+         * @return Status
+         */
+    Status compileOVExecutableNetwork(const ModelConfig& config, const plugin_config_t& pluginConfig, const std::string& blobPath);
+
+    /**
+         * @brief Describes what compiled network depends on beside model files, identifies cached compiled networks
+         */
+    std::string describeCompilation(const ModelConfig& config, const plugin_config_t& pluginConfig) const;
+
+    /**
+         * @brief Imports compiled network from cache
+         *
+         * @return true if network was imported
+         */
+    bool importExecutableNetwork(const std::string& blobPath, const plugin_config_t& pluginConfig);
+
+    /**
+         * @brief Exports compiled network to cache, devices not supporting export are skipped
+         */
+    void exportExecutableNetwork(const std::string& blobPath);
+
+    /**
+         * @brief Reads CPUs of isolation group or NUMA node configured for the model
+         *
+         * Models without isolation group do not use CPUs reserved for isolation groups.
+         */
+    Status preparePinnedCpus(const ModelConfig& config);
+
     /**
          * @brief Prepares inferenceRequestsQueue
          */
     Status prepareInferenceRequestsQueue(const ModelConfig& config);
 
+    /**
+         * @brief Allocates input blobs of source shape for inputs resized by plugin
+         */
+    void preallocateResizedInputBlobs(const ModelConfig& config, OVInferRequestsQueue& queue);
+
+    /**
+         * @brief Sets CPU streams and nireq in tuned config from saved auto-tuning result or by measuring these
+         *
+         * Tuned config is a copy of config if auto-tuning is disabled or does not apply.
+         * Reloads for shapes requested by clients reuse result of last load and neither measure nor save results.
+         */
+    Status applyAutoTuning(const ModelConfig& config, const DynamicModelParameter& parameter, ModelConfig& tunedConfig);
+
+    /**
+         * @brief Compiles network with every CPU streams candidate and measures each candidate nireq
+         */
+    Status measureTuningCandidates(const ModelConfig& config, uint32_t maxStreams, std::vector<TuningMeasurement>& measurements);
+
+    /**
+         * @brief Describes setup auto-tuning result is valid for
+         */
+    std::string describeTuning(uint32_t maxStreams) const;
+
+    /**
+         * @brief Compiles network for every replica device with its own inferenceRequestsQueue
+         */
+    Status loadDeviceReplicas(const ModelConfig& config);
+
+    /**
+         * @brief Prepares batching scheduler if dynamic batching is enabled and supported by the model
+         */
+    void prepareBatchingScheduler(const ModelConfig& config);
+
+    /**
+         * @brief Creates empty response cache if it is enabled in the config
+         */
+    void prepareResponseCache(const ModelConfig& config);
+    void prepareNodeOutputCache(const ModelConfig& config);
+
+    /**
+         * @brief Creates request coalescer if request coalescing is enabled in the config
+         */
+    void prepareRequestCoalescer(const ModelConfig& config);
+
+    /**
+         * @brief Gets shared context of target device if shared GPU context is enabled in the config
+         */
+    void prepareRemoteContext(const ModelConfig& config);
+
+    /**
+         * @brief Creates hedging policy without measured latencies if hedging is enabled in the config
+         */
+    void prepareHedgingPolicy(const ModelConfig& config);
+
+    /**
+         * @brief Creates sequence manager without sequences if the model is stateful
+         */
+    void prepareSequenceManager(const ModelConfig& config);
+
+    /**
+         * @brief Compiles network with own infer requests queue for every shape bucket of the config
+         */
+    Status loadShapeBuckets(const ModelConfig& config);
+
+    /**
+         * @brief Prepares fair share queue with a slot for every infer request of target device and replicas if tenant limits are configured
+         */
+    void prepareFairShareQueue();
+
+    /**
+         * @brief Runs configured number of inferences with zero filled inputs on every infer request
+         *
+         * Executed before model version becomes available, so first requests do not pay for lazy plugin allocations.
+         */
+    virtual Status warmUp(const ModelConfig& config);
+
     /**
          * @brief Fetch model file paths
          *
@@ -156,16 +297,18 @@ protected:
     Status fetchModelFilepaths();
 
     /**
-         * @brief Find file path with extension in model path
+         * @brief Fetch paths of model files located in cloud storage
          *
-         * @return Returns filename with desired extension if exists otherwise empty string
+         * @return Status
          */
-    std::string findModelFilePathWithExtension(const std::string& extension) const;
+    Status fetchModelFilepathsFromStorage();
 
     /**
-         * @brief Stores required model files extensions to be able to load model
+         * @brief Find file path with extension in model path
+         *
+         * @return Returns filename with desired extension if exists otherwise empty string
          */
-    static constexpr std::array<const char*, 2> REQUIRED_MODEL_FILES_EXTENSIONS{".bin", ".xml"};
+    std::string findModelFilePathWithExtension(const std::string& extension) const;
 
     /**
          * @brief Notifies model instance users who wait for loading
@@ -198,18 +341,203 @@ private:
          */
     std::unique_ptr<OVInferRequestsQueue> inferRequestsQueue;
 
+    /**
+         * @brief Gathers batch size 1 requests into batched inferences, empty if dynamic batching is disabled
+         */
+    std::unique_ptr<BatchingScheduler> batchingScheduler;
+
+    /**
+         * @brief CPUs of isolation group or NUMA node the model is bound to, empty if not bound
+         */
+    std::vector<int> pinnedCpus;
+
+    /**
+         * @brief Metrics of predict requests, registered on first request
+         */
+    mutable std::unique_ptr<ModelMetrics> metrics;
+    mutable std::once_flag metricsRegistered;
+
+    /**
+         * @brief Executable network compiled for specific input shapes together with its inference streams
+         */
+    struct CompiledNetwork {
+        std::string inputShapesKey;
+        std::shared_ptr<InferenceEngine::ExecutableNetwork> execNetwork;
+        std::unique_ptr<OVInferRequestsQueue> inferRequestsQueue;
+    };
+
+    /**
+         * @brief Networks compiled for input shapes used earlier, most recently used first
+         *
+         * Requests switching between shapes in auto mode reuse these instead of compiling network again.
+         */
+    std::list<CompiledNetwork> compiledNetworksCache;
+
+    /**
+         * @brief Network compiled for additional device together with its inference streams
+         */
+    struct DeviceReplica {
+        std::string device;
+        std::shared_ptr<InferenceEngine::ExecutableNetwork> execNetwork;
+        std::unique_ptr<OVInferRequestsQueue> inferRequestsQueue;
+        InferenceEngine::RemoteContext::Ptr remoteContext;
+    };
+
+    /**
+         * @brief Replicas on replica devices of the config, empty if model runs on target device only
+         *
+         * Replicas are compiled for shapes from the config, reload for other shapes leaves only target device network.
+         */
+    std::vector<DeviceReplica> deviceReplicas;
+
+    /**
+         * @brief Orders requests of tenants competing for infer requests, nullptr if tenant limits are not configured
+         */
+    std::unique_ptr<FairShareQueue> fairShareQueue;
+
+    /**
+         * @brief Networks compiled for shape buckets of the config in ascending size, empty if shape buckets are not used
+         *
+         * Buckets are compiled for shapes from the config and kept while model is reshaped for requests longer than all of them.
+         */
+    std::vector<std::unique_ptr<ShapeBucket>> shapeBuckets;
+
+    /**
+         * @brief Responses of repeated requests, nullptr if response cache is not enabled
+         *
+         * Cache is emptied when the version is loaded with a new config or unloaded, reshape keeps it.
+         */
+    std::shared_ptr<ResponseCache> responseCache;
+
+    /**
+         * @brief Outputs of pipeline nodes running the version, nullptr if node output cache is not enabled
+         */
+    std::shared_ptr<NodeOutputCache> nodeOutputCache;
+
+    /**
+         * @brief In-flight inferences of identical requests, nullptr if request coalescing is not enabled
+         */
+    std::shared_ptr<RequestCoalescer> requestCoalescer;
+
+    /**
+         * @brief Sequences and their memory state for stateful model, nullptr otherwise
+         */
+    std::shared_ptr<SequenceManager> sequenceManager;
+
+    /**
+         * @brief Hedge delay, budget and abandoned inferences, nullptr if hedging is not enabled
+         */
+    std::shared_ptr<HedgingPolicy> hedgingPolicy;
+
+    /**
+         * @brief Expected inputs compiled when inputs info is loaded, accepts matching requests in validate
+         */
+    RequestValidator requestValidator;
+
+    /**
+         * @brief Metadata response built when model is loaded, replaced atomically as it is read without loading lock
+         */
+    std::shared_ptr<const ModelMetadataCache> metadataCache;
+
+    /**
+         * @brief Identifies input shapes of currently loaded executable network
+         */
+    std::string inputShapesKey;
+
+    /**
+         * @brief Auto-tuning result of last load for configuration, reused by reloads for requested shapes
+         */
+    std::optional<TuningCandidate> tuningResult;
+
     /**
          * @brief Holds current usage count in predict requests
          * 
-         * Needed for gating model unloading.
+         * Needed for gating model unloading. Sharded, so requests on many cores do not contend on one cache line.
          */
-    std::atomic<uint64_t> predictRequestsHandlesCount = 0;
+    ShardedCounter predictRequestsHandlesCount;
 
     /**
          * @brief Lock to disable concurrent modelinstance load/unload/reload
          */
     std::recursive_mutex loadingMutex;
 
+    /**
+         * @brief Version is compiled on first request and can be evicted afterwards
+         */
+    bool loadOnDemand = false;
+
+    /**
+         * @brief Tells if network is compiled, always true for available versions which are not loaded on demand
+         */
+    std::atomic<bool> networkLoaded = false;
+
+    /**
+         * @brief Time of last request acquiring the version, read by eviction of versions loaded on demand
+         */
+    std::atomic<int64_t> lastUsedMicroseconds = 0;
+
+    static const int64_t LAST_USED_RESOLUTION_MICROSECONDS = 1000;
+
+    /**
+         * @brief Updates time of last request of version loaded on demand
+         */
+    void markUsed();
+
+    uint64_t idleUnloadSeconds = 0;
+
+    /**
+         * @brief Size of model files, estimates memory used by compiled network until it is measured
+         */
+    uint64_t modelFilesSize = 0;
+
+    /**
+         * @brief Growth of server resident memory during last load of the version, approximate if other versions load at the same time
+         */
+    std::atomic<uint64_t> loadResidentMemoryBytes = 0;
+
+    /**
+         * @brief Size of input and output blobs of infer requests of all networks of the version
+         */
+    std::atomic<uint64_t> inferRequestBlobsBytes = 0;
+
+    /**
+         * @brief Measures memory used by version after load, resident memory before load is given
+         */
+    void recordMemoryUsage(uint64_t residentMemoryBytesBeforeLoad);
+
+    /**
+         * @brief Network is compiled with PERF_COUNT while performance counters are collected
+         */
+    std::atomic<bool> perfCountEnabled = false;
+
+    /**
+         * @brief Serializes collections of performance counters
+         */
+    std::mutex perfCountersCollectionMutex;
+
+    std::atomic<bool> collectingPerfCounters = false;
+    std::mutex perfCountersCollectorMutex;
+    std::shared_ptr<PerfCountersCollector> perfCountersCollector;
+
+    void recordPerfCountersToCollector(InferenceEngine::InferRequest& inferRequest);
+
+    /**
+         * @brief Prepares version loaded on demand, network is not read until first request
+         */
+    Status deferLoading(const ModelConfig& config);
+
+    /**
+         * @brief Compiles version loaded on demand unless it is already compiled
+         *
+         * Unload guard is released while waiting for loading lock, so concurrent unloading is not blocked.
+         */
+    Status ensureNetworkLoaded(std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuard);
+
+    /**
+         * @brief Releases compiled network and infer requests
+         */
+    void releaseNetwork();
+
     /**
          * @brief Internal method for loading inputs
          *
@@ -231,6 +559,18 @@ private:
          */
     Status loadModelImpl(const ModelConfig& config, const DynamicModelParameter& parameter = DynamicModelParameter());
 
+    /**
+         * @brief Loads executable network and infer requests queue or takes these from cache of compiled networks
+         *
+         * Currently loaded network is put to the cache if it is replaced by reload requested for other shapes.
+         */
+    Status loadOrReuseExecutableNetwork(const ModelConfig& config, const DynamicModelParameter& parameter);
+
+    /**
+         * @brief Builds key identifying network input shapes
+         */
+    std::string getNetworkInputShapesKey() const;
+
     /**
          * @brief Configures batchsize
          */
@@ -252,8 +592,11 @@ private:
     const Status validateTensorContentSize(const ovms::TensorInfo& networkInput,
         const tensorflow::TensorProto& requestInput);
 
-    uint32_t getNumOfParallelInferRequests(const ModelConfig& config);
-    uint32_t getNumOfParallelInferRequestsUnbounded(const ModelConfig& config);
+    /**
+         * @param network network to query for optimal number of infer requests, execNetwork if null
+         */
+    uint32_t getNumOfParallelInferRequests(const ModelConfig& config, InferenceEngine::ExecutableNetwork* network = nullptr);
+    uint32_t getNumOfParallelInferRequestsUnbounded(const ModelConfig& config, InferenceEngine::ExecutableNetwork* network = nullptr);
 
     /**
          * @brief Reloads model input/output metadata from current state of CNNNetwork
@@ -272,6 +615,11 @@ private:
     Status recoverFromReloadingError(const Status& status);
 
 public:
+    /**
+         * @brief Stores required model files extensions to be able to load model
+         */
+    static constexpr std::array<const char*, 2> REQUIRED_MODEL_FILES_EXTENSIONS{".bin", ".xml"};
+
     /**
          * @brief A default constructor
          */
@@ -280,20 +628,27 @@ public:
     /**
          * @brief Destroy the Model Instance object
          */
-    virtual ~ModelInstance() = default;
+    virtual ~ModelInstance();
 
     /**
          * @brief Increases predict requests usage count
          */
     void increasePredictRequestsHandlesCount() {
-        ++predictRequestsHandlesCount;
+        predictRequestsHandlesCount.increment();
     }
 
     /**
          * @brief Decreases predict requests usage count
          */
     void decreasePredictRequestsHandlesCount() {
-        --predictRequestsHandlesCount;
+        predictRequestsHandlesCount.decrement();
+    }
+
+    /**
+         * @brief Gets number of requests holding the instance with ModelInstanceUnloadGuard
+         */
+    uint64_t getPredictRequestsHandlesCount() const {
+        return predictRequestsHandlesCount.get();
     }
 
     /**
@@ -383,7 +738,7 @@ public:
          * @return bool 
          */
     virtual bool canUnloadInstance() const {
-        return 0 == predictRequestsHandlesCount;
+        return 0 == predictRequestsHandlesCount.get();
     }
 
     /**
@@ -395,12 +750,98 @@ public:
         return *inferRequestsQueue;
     }
 
+    /**
+         * @brief Get OV streams pool expected to complete new request first
+         *
+         * Chooses among target device pool and pools of device replicas, gives target device pool if there are no replicas.
+         * 
+         * @return OVStreamsQueue
+         */
+    OVInferRequestsQueue& selectInferRequestsQueue();
+
+    /**
+         * @brief Get OV streams pool of the network compiled for the device
+         *
+         * Falls back to pool expected to complete new request first if device is empty or its replica is not loaded,
+         * which is the case after reload for shapes other than in the config.
+         *
+         * @return OVStreamsQueue
+         */
+    OVInferRequestsQueue& selectInferRequestsQueue(const std::string& device);
+
+    /**
+         * @brief Get OV streams pool for hedge of request running in the primary pool
+         *
+         * Prefers device replica expected to complete new request first, gives the primary pool if there are no replicas.
+         *
+         * @return OVStreamsQueue
+         */
+    OVInferRequestsQueue& selectHedgeInferRequestsQueue(const OVInferRequestsQueue& primary);
+
+    /**
+         * @brief Checks if device is the target device or one of replica devices of the model
+         */
+    bool runsOnDevice(const std::string& device) const;
+
+    /**
+         * @brief Get number of device replicas running besides network on target device
+         */
+    size_t getDeviceReplicasCount() const {
+        return deviceReplicas.size();
+    }
+
+    /**
+         * @brief Get queue ordering requests of tenants before they wait for infer request
+         *
+         * @return fair share queue or nullptr if tenant limits are not configured
+         */
+    FairShareQueue* getFairShareQueue() const {
+        return fairShareQueue.get();
+    }
+
+    /**
+         * @brief Get batching scheduler
+         * 
+         * @return batching scheduler or nullptr if dynamic batching is not active
+         */
+    BatchingScheduler* getBatchingScheduler() const {
+        return batchingScheduler.get();
+    }
+
+    /**
+         * @brief Get CPUs of isolation group or NUMA node running inference of this version
+         * 
+         * @return CPU ids, empty if the model is not bound to CPUs
+         */
+    const std::vector<int>& getPinnedCpus() const {
+        return pinnedCpus;
+    }
+
+    /**
+         * @brief Get metrics of predict requests served by this version
+         * 
+         * @return ModelMetrics
+         */
+    ModelMetrics& getMetrics() const;
+
+    /**
+         * @brief Get the number of busy and awaited infer requests of this version
+         * 
+         * @return double
+         */
+    double getLoad() const {
+        const auto& queueMetrics = getMetrics().inferRequestsQueue;
+        return queueMetrics.streamsInUse.get() + queueMetrics.waiters.get();
+    }
+
     /**
          * @brief Combines plugin config from user with default config calculated at runtime
          *
+         * @param pinnedCpusCount CPUs the model is bound to, CPU streams are sized for these, 0 if not bound
+         *
          * @return plugin config
          */
-    static plugin_config_t prepareDefaultPluginConfig(const ModelConfig& config);
+    static plugin_config_t prepareDefaultPluginConfig(const ModelConfig& config, size_t pinnedCpusCount = 0);
 
     /**
          * @brief Loads model version, reads CNN network model from files (*.xml and *.bin files) and creates inference engine
@@ -450,6 +891,149 @@ public:
 
     const Status validate(const tensorflow::serving::PredictRequest* request);
 
+    /**
+         * @brief Finds the smallest shape bucket fitting the request
+         *
+         * Request fits a bucket if its inputs padded to buckets have the same length, are not longer than the bucket
+         * and their other dimensions match the bucket network. Batch dimension of requests merged by bucket batching scheduler is not checked.
+         *
+         * @param length receives length of request inputs along shape bucket dimension
+         * @return bucket or nullptr if the request does not fit any, it is then inferred on the model network
+         */
+    ShapeBucket* selectShapeBucket(const tensorflow::serving::PredictRequest* request, size_t& length);
+
+    /**
+         * @brief Validates request padded to shape bucket against bucket network
+         */
+    const Status validateShapeBucketRequest(const tensorflow::serving::PredictRequest* request, const ShapeBucket& bucket);
+
+    bool hasShapeBuckets() const {
+        return !shapeBuckets.empty();
+    }
+
+    /**
+         * @brief Get the cache of responses, shared with completion callbacks of asynchronous inference
+         *
+         * @return cache or nullptr if response cache is not enabled
+         */
+    std::shared_ptr<ResponseCache> getResponseCache() const {
+        return responseCache;
+    }
+
+    /**
+         * @brief Get the cache of outputs of pipeline nodes running the version
+         *
+         * @return cache or nullptr if node output cache is not enabled
+         */
+    std::shared_ptr<NodeOutputCache> getNodeOutputCache() const {
+        return nodeOutputCache;
+    }
+
+    /**
+         * @brief Get the coalescer of identical concurrent requests
+         *
+         * @return coalescer or nullptr if request coalescing is not enabled
+         */
+    std::shared_ptr<RequestCoalescer> getRequestCoalescer() const {
+        return requestCoalescer;
+    }
+
+    /**
+         * @brief Get the sequences of stateful model
+         *
+         * @return sequence manager or nullptr if model is not stateful, requests keep it while reload replaces it
+         */
+    std::shared_ptr<SequenceManager> getSequenceManager() const {
+        return sequenceManager;
+    }
+
+    /**
+         * @brief Get the metadata response built when model was loaded
+         *
+         * @return metadata or nullptr if model is not loaded
+         */
+    std::shared_ptr<const ModelMetadataCache> getMetadataCache() const {
+        return std::atomic_load(&metadataCache);
+    }
+
+    /**
+         * @brief Get the hedging policy of slow requests
+         *
+         * @return policy or nullptr if hedging is not enabled
+         */
+    std::shared_ptr<HedgingPolicy> getHedgingPolicy() const {
+        return hedgingPolicy;
+    }
+
+    /**
+         * @brief Checks if request is split into micro-batches of network batch size
+         *
+         * Requests with batch size above network batch size are split if micro-batching is enabled.
+         */
+    bool isSplitToMicroBatches(const tensorflow::serving::PredictRequest* request) const;
+
+    /**
+         * @brief Unloads compiled network of version loaded on demand if it is not used, next request compiles it again
+         *
+         * @return true if network was unloaded
+         */
+    bool tryEvict();
+
+    uint64_t getModelFilesSize() const {
+        return modelFilesSize;
+    }
+
+    uint64_t getLoadResidentMemoryBytes() const {
+        return loadResidentMemoryBytes;
+    }
+
+    uint64_t getInferRequestBlobsBytes() const {
+        return inferRequestBlobsBytes;
+    }
+
+    /**
+         * @brief Memory used by the version when loaded, as measured at last load, or size of model files if it was not loaded yet
+         */
+    uint64_t getEstimatedMemoryBytes() const {
+        const uint64_t measured = std::max<uint64_t>(loadResidentMemoryBytes, inferRequestBlobsBytes);
+        return measured > 0 ? measured : modelFilesSize;
+    }
+
+    int64_t getLastUsedMicroseconds() const {
+        return lastUsedMicroseconds;
+    }
+
+    uint64_t getIdleUnloadSeconds() const {
+        return idleUnloadSeconds;
+    }
+
+    static int64_t getSteadyClockMicroseconds() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+         * @brief Collects per layer performance counters of the next inferences
+         *
+         * Blocks until inferencesCount inferences are collected or timeout passes. Unless plugin config enables PERF_COUNT,
+         * network is reloaded with it for the collection and reloaded again without it afterwards.
+         *
+         * @param inferencesCount
+         * @param timeout
+         * @param json receives layers aggregated over collected inferences
+         *
+         * @return Status
+         */
+    Status collectPerfCounters(size_t inferencesCount, std::chrono::milliseconds timeout, std::string& json);
+
+    /**
+         * @brief Adds performance counters of finished inference to the collection in progress, if any
+         */
+    void recordPerfCounters(InferenceEngine::InferRequest& inferRequest) {
+        if (collectingPerfCounters.load(std::memory_order_relaxed)) {
+            recordPerfCountersToCollector(inferRequest);
+        }
+    }
+
     static const int WAIT_FOR_MODEL_LOADED_TIMEOUT_MILLISECONDS = 100;
 };
 }  // namespace ovms
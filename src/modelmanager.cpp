@@ -16,11 +16,18 @@
 #include "modelmanager.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <sstream>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -28,27 +35,51 @@
 #include <rapidjson/document.h>
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <spdlog/spdlog.h>
 #include <sys/stat.h>
 
 #include "azurefilesystem.hpp"
 #include "config.hpp"
+#include "cpustreamsbudget.hpp"
+#include "custom_node_library.hpp"
 #include "filesystem.hpp"
 #include "gcsfilesystem.hpp"
+#include "instrumentedfilesystem.hpp"
 #include "localfilesystem.hpp"
+#include "localfilesystemwatcher.hpp"
+#include "metrics.hpp"
+#include "modelinstance.hpp"
+#include "ondemandmodels.hpp"
 #include "pipeline.hpp"
 #include "pipeline_factory.hpp"
 #include "s3filesystem.hpp"
 #include "schema.hpp"
+#include "serversnapshot.hpp"
+#include "stringutils.hpp"
 
 namespace ovms {
 
 static uint watcherIntervalSec = 1;
+static uint cloudWatcherIntervalSec = 60;
+// interval of cloud model listing grows up to this multiple of its base interval when versions do not change
+static const uint DEFAULT_STORAGE_POLL_BACKOFF_FACTOR = 4;
+static bool streamCloudModels = false;
 static bool watcherStarted = false;
 
+// LoadNetwork uses multiple threads itself, a few concurrent loads are enough to hide downloads and single threaded parts
+// at least two, so one long load does not hold back updates of all other models
+static const uint MAX_MODEL_LOADING_THREADS = std::max(2u, std::thread::hardware_concurrency() / 4);
+
+// listing versions of a model is a few remote requests waiting for network, these are fanned out widely
+static const uint MAX_CLOUD_DISCOVERY_THREADS = 32;
+
 Status ModelManager::start() {
     auto& config = ovms::Config::instance();
     watcherIntervalSec = config.filesystemPollWaitSeconds();
+    cloudWatcherIntervalSec = config.cloudFilesystemPollWaitSeconds();
+    streamCloudModels = config.streamCloudModels();
 
     Status status;
     if (config.configPath() != "") {
@@ -62,6 +93,7 @@ Status ModelManager::start() {
         return status;
     }
 
+    loadProgress.markStartupCompleted();
     startWatcher();
     return status;
 }
@@ -113,7 +145,11 @@ Status ModelManager::startFromConfig() {
         modelConfig.setBatchSize(0);
     }
 
-    return reloadModelWithVersions(modelConfig);
+    CpuStreamsBudget::getInstance().assignShares(servedModelConfigs);
+    loadProgress.markPending(modelConfig.getName());
+    status = reloadModelWithVersions(modelConfig);
+    loadProgress.markFinished(modelConfig.getName(), status.ok());
+    return status;
 }
 
 Status ModelManager::startFromFile(const std::string& jsonFilename) {
@@ -168,7 +204,9 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
         nodeName = nodeConfig["name"].GetString();
 
         std::string modelName;
-        modelName = nodeConfig["model_name"].GetString();
+        if (nodeConfig.HasMember("model_name")) {
+            modelName = nodeConfig["model_name"].GetString();
+        }
 
         const std::string nodeKindStr = nodeConfig["type"].GetString();
         auto nodeOutputsItr = nodeConfig.FindMember("outputs");
@@ -190,9 +228,55 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
             SPDLOG_ERROR("There was error while parsing node kind:{}", nodeKindStr);
             return;
         }
-        SPDLOG_INFO("Creating node:{} type:{} model_name:{} modelVersion:{}",
-            nodeName, nodeKindStr, modelName, modelVersion.value_or(0));
-        info.emplace_back(std::move(NodeInfo{nodeKind, nodeName, modelName, modelVersion, nodeOutputNameAlias}));
+        std::optional<size_t> demultiplyCount;
+        if (nodeConfig.HasMember("demultiply_count")) {
+            demultiplyCount = nodeConfig["demultiply_count"].GetUint64();
+        }
+        std::optional<std::string> gatherFromNode;
+        if (nodeConfig.HasMember("gather_from_node")) {
+            gatherFromNode = nodeConfig["gather_from_node"].GetString();
+        }
+        SPDLOG_INFO("Creating node:{} type:{} model_name:{} modelVersion:{} demultiplyCount:{} gatherFromNode:{}",
+            nodeName, nodeKindStr, modelName, modelVersion.value_or(0), demultiplyCount.value_or(0), gatherFromNode.value_or(""));
+        if (nodeKind == NodeKind::DL && modelName.empty()) {
+            SPDLOG_ERROR("Pipeline:{} node:{} does not have model_name", pipelineName, nodeName);
+            return;
+        }
+        NodeInfo nodeInfo{nodeKind, nodeName, modelName, modelVersion, nodeOutputNameAlias, demultiplyCount, gatherFromNode};
+        if (nodeConfig.HasMember("device")) {
+            nodeInfo.device = nodeConfig["device"].GetString();
+        }
+        auto runIfItr = nodeConfig.FindMember("run_if");
+        if (runIfItr != nodeConfig.MemberEnd()) {
+            NodeCondition condition;
+            condition.inputName = runIfItr->value["input"].GetString();
+            if (runIfItr->value.HasMember("min_score")) {
+                condition.minScore = runIfItr->value["min_score"].GetFloat();
+            }
+            if (runIfItr->value.HasMember("min_count")) {
+                condition.minCount = runIfItr->value["min_count"].GetUint64();
+            }
+            SPDLOG_INFO("Node:{} runs only if input:{} has at least {} elements above {}",
+                nodeName, condition.inputName, condition.minCount, condition.minScore ? std::to_string(condition.minScore.value()) : "any score");
+            nodeInfo.condition = std::move(condition);
+        }
+        if (nodeKind == NodeKind::CUSTOM) {
+            if (!nodeConfig.HasMember("library_path")) {
+                SPDLOG_ERROR("Pipeline:{} custom node:{} does not have library_path", pipelineName, nodeName);
+                return;
+            }
+            status = CustomNodeLibrary::load(nodeConfig["library_path"].GetString(), nodeInfo.library);
+            if (!status.ok()) {
+                return;
+            }
+            auto paramsItr = nodeConfig.FindMember("params");
+            if (paramsItr != nodeConfig.MemberEnd()) {
+                for (const auto& param : paramsItr->value.GetObject()) {
+                    nodeInfo.parameters[param.name.GetString()] = param.value.GetString();
+                }
+            }
+        }
+        info.emplace_back(std::move(nodeInfo));
         auto nodeInputItr = nodeConfig.FindMember("inputs");
         processNodeInputs(nodeName, nodeInputItr, connections);
     }
@@ -200,7 +284,11 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
     const std::string nodeName = "response";
     // pipeline outputs are node exit inputs
     processNodeInputs(nodeName, iteratorOutputs, connections);
-    info.emplace_back(std::move(NodeInfo(NodeKind::EXIT, nodeName, "", std::nullopt, {})));
+    std::optional<std::string> gatherFromNode;
+    if (pipelineConfig.HasMember("gather_from_node")) {
+        gatherFromNode = pipelineConfig["gather_from_node"].GetString();
+    }
+    info.emplace_back(std::move(NodeInfo(NodeKind::EXIT, nodeName, "", std::nullopt, {}, std::nullopt, gatherFromNode)));
     auto status = factory.createDefinition(pipelineName, info, connections, manager);
     if (!status.ok()) {
         return;
@@ -208,6 +296,13 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
     pipelinesInConfigFile.insert(pipelineName);
 }
 
+static std::string serializeConfigNode(const rapidjson::Value& node) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    node.Accept(writer);
+    return buffer.GetString();
+}
+
 Status ModelManager::loadPipelinesConfig(rapidjson::Document& configJson) {
     const auto itrp = configJson.FindMember("pipeline_config_list");
     if (itrp == configJson.MemberEnd() || !itrp->value.IsArray()) {
@@ -215,9 +310,21 @@ Status ModelManager::loadPipelinesConfig(rapidjson::Document& configJson) {
         return StatusCode::OK;
     }
     std::set<std::string> pipelinesInConfigFile;
+    std::unordered_map<std::string, std::string> pipelinesConfigs;
     for (const auto& pipelineConfig : itrp->value.GetArray()) {
+        const std::string pipelineName = pipelineConfig["name"].GetString();
+        auto serializedConfig = serializeConfigNode(pipelineConfig);
+        // duplicated definitions are still processed so these are reported
+        bool firstOccurrence = pipelinesConfigs.emplace(pipelineName, serializedConfig).second;
+        auto it = loadedPipelinesConfigs.find(pipelineName);
+        if (firstOccurrence && it != loadedPipelinesConfigs.end() && it->second == serializedConfig && pipelineFactory.definitionExists(pipelineName)) {
+            SPDLOG_DEBUG("Pipeline:{} configuration did not change", pipelineName);
+            pipelinesInConfigFile.insert(pipelineName);
+            continue;
+        }
         processPipelineConfig(configJson, pipelineConfig, pipelinesInConfigFile, pipelineFactory, *this);
     }
+    loadedPipelinesConfigs = std::move(pipelinesConfigs);
     return ovms::StatusCode::OK;
 }
 
@@ -228,6 +335,9 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson) {
         return StatusCode::JSON_INVALID;
     }
     std::set<std::string> modelsInConfigFile;
+    std::unordered_map<std::string, std::string> modelsConfigs;
+    std::vector<ModelConfig> changedModelsConfigs;
+    std::vector<std::string> serializedConfigs;
     servedModelConfigs.clear();
     for (const auto& configs : itr->value.GetArray()) {
         ModelConfig& modelConfig = servedModelConfigs.emplace_back();
@@ -238,13 +348,101 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson) {
             servedModelConfigs.pop_back();
             continue;
         }
-        reloadModelWithVersions(modelConfig);
+        serializedConfigs.push_back(serializeConfigNode(configs["config"]));
+    }
+    // models added or removed change shares of other models, these are reloaded with new share
+    CpuStreamsBudget::getInstance().assignShares(servedModelConfigs);
+    for (size_t i = 0; i < servedModelConfigs.size(); ++i) {
+        const ModelConfig& modelConfig = servedModelConfigs[i];
         modelsInConfigFile.emplace(modelConfig.getName());
+        // model versions changes are detected by watcher, model with unchanged config does not have to be checked
+        auto serializedConfig = serializedConfigs[i] + ";cpu_streams_share:" + std::to_string(modelConfig.getCpuStreamsShare());
+        auto it = loadedModelsConfigs.find(modelConfig.getName());
+        if (it == loadedModelsConfigs.end() || it->second != serializedConfig || modelsConfigs.count(modelConfig.getName())) {
+            changedModelsConfigs.push_back(modelConfig);
+        } else {
+            SPDLOG_DEBUG("Model:{} configuration did not change", modelConfig.getName());
+        }
+        modelsConfigs[modelConfig.getName()] = std::move(serializedConfig);
+    }
+    if (loadModelsInBackground) {
+        // watcher hands changed models to loader threads, a long load does not delay reaction to other changes
+        for (const auto& modelConfig : changedModelsConfigs) {
+            loadProgress.markPending(modelConfig.getName());
+            modelsWithChangedConfig.insert(modelConfig.getName());
+        }
+        // models removed before their load started are not loaded
+        for (auto it = modelsWithChangedConfig.begin(); it != modelsWithChangedConfig.end();) {
+            if (modelsInConfigFile.count(*it)) {
+                ++it;
+            } else {
+                loadProgress.remove(*it);
+                it = modelsWithChangedConfig.erase(it);
+            }
+        }
+    } else {
+        reloadModelsWithVersions(changedModelsConfigs);
     }
     retireModelsRemovedFromConfigFile(modelsInConfigFile);
+    loadedModelsConfigs = std::move(modelsConfigs);
     return ovms::StatusCode::OK;
 }
 
+void ModelManager::reloadModelsWithVersions(std::vector<ModelConfig>& configs) {
+    // configs of the same model are applied in order by single thread, different models are loaded concurrently
+    std::vector<std::vector<std::reference_wrapper<ModelConfig>>> configsByModel;
+    std::unordered_map<std::string, size_t> modelPositions;
+    for (auto& config : configs) {
+        auto it = modelPositions.emplace(config.getName(), configsByModel.size()).first;
+        if (it->second == configsByModel.size()) {
+            configsByModel.emplace_back();
+        }
+        configsByModel[it->second].emplace_back(config);
+    }
+    for (const auto& modelConfigs : configsByModel) {
+        loadProgress.markPending(modelConfigs.front().get().getName());
+    }
+    // every model reports its readiness through its versions status, failed models are rechecked by watcher
+    // each model has its own flag, so threads loading different models do not share any
+    std::vector<char> failed(configsByModel.size(), false);
+    auto reloadModel = [this, &configsByModel, &failed](size_t model) {
+        for (auto& config : configsByModel[model]) {
+            if (!reloadModelWithVersions(config.get()).ok()) {
+                failed[model] = true;
+            }
+        }
+        loadProgress.markFinished(configsByModel[model].front().get().getName(), !failed[model]);
+    };
+    const size_t threadsCount = std::min<size_t>(MAX_MODEL_LOADING_THREADS, configsByModel.size());
+    if (threadsCount <= 1) {
+        for (size_t model = 0; model < configsByModel.size(); ++model) {
+            reloadModel(model);
+        }
+    } else {
+        spdlog::info("Loading {} models with {} threads", configsByModel.size(), threadsCount);
+        std::atomic<size_t> nextModel{0};
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadsCount; ++i) {
+            threads.emplace_back([&configsByModel, &nextModel, &reloadModel]() {
+                for (size_t model = nextModel++; model < configsByModel.size(); model = nextModel++) {
+                    reloadModel(model);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    for (size_t model = 0; model < configsByModel.size(); ++model) {
+        const auto& name = configsByModel[model].front().get().getName();
+        if (failed[model]) {
+            modelsToRecheck.insert(name);
+        } else {
+            modelsToRecheck.erase(name);
+        }
+    }
+}
+
 Status ModelManager::loadConfig(const std::string& jsonFilename) {
     spdlog::info("Loading configuration from {}", jsonFilename);
     std::ifstream ifs(jsonFilename.c_str());
@@ -270,6 +468,13 @@ Status ModelManager::loadConfig(const std::string& jsonFilename) {
         return status;
     }
     status = loadPipelinesConfig(configJson);
+    if (loadModelsInBackground && !modelsWithChangedConfig.empty()) {
+        // pipelines using models which are not loaded yet are created once their loads finish
+        rapidjson::Document pipelinesConfig;
+        pipelinesConfig.CopyFrom(configJson, pipelinesConfig.GetAllocator());
+        pendingPipelinesConfig.Swap(pipelinesConfig);
+        pipelinesWaitForModels = true;
+    }
     return StatusCode::OK;
 }
 
@@ -285,6 +490,7 @@ void ModelManager::retireModelsRemovedFromConfigFile(const std::set<std::string>
         modelsToUnloadAllVersions.begin());
     modelsToUnloadAllVersions.resize(it - modelsToUnloadAllVersions.begin());
     for (auto& modelName : modelsToUnloadAllVersions) {
+        loadProgress.remove(modelName);
         try {
             models.at(modelName)->retireAllVersions();
         } catch (const std::out_of_range& e) {
@@ -293,26 +499,228 @@ void ModelManager::retireModelsRemovedFromConfigFile(const std::set<std::string>
     }
 }
 
+bool isCloudPath(const std::string& basePath) {
+    for (const auto& prefix : {S3FileSystem::S3_URL_PREFIX, GCSFileSystem::GCS_URL_PREFIX,
+             AzureFileSystem::AZURE_URL_FILE_PREFIX, AzureFileSystem::AZURE_URL_BLOB_PREFIX}) {
+        if (basePath.rfind(prefix, 0) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ModelManager::watchLocalPaths(LocalFileSystemWatcher& fsWatcher) {
+    if (!configFilename.empty()) {
+        // config file is replaced rather than modified by many editors, its directory is watched instead
+        fsWatcher.watchDirectory(std::filesystem::path(std::filesystem::absolute(configFilename)).parent_path());
+    }
+    for (const auto& config : servedModelConfigs) {
+        if (isCloudPath(config.getBasePath()) || !fsWatcher.watchDirectory(config.getBasePath())) {
+            continue;
+        }
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(config.getBasePath(), ec)) {
+            if (entry.is_directory(ec)) {
+                fsWatcher.watchDirectory(entry.path());
+            }
+        }
+    }
+}
+
+bool ModelManager::isModelChangeDetected(const ModelConfig& config, const std::set<std::string>& changedDirectories) const {
+    const auto basePath = LocalFileSystemWatcher::normalize(config.getBasePath());
+    for (const auto& directory : changedDirectories) {
+        if (directory == basePath || std::filesystem::path(directory).parent_path() == basePath) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void ModelManager::watcher(std::future<void> exit) {
     SPDLOG_INFO("Started config watcher thread");
+    LocalFileSystemWatcher fsWatcher;
+    if (!fsWatcher.isAvailable()) {
+        spdlog::warn("Changes in local model repository will be detected by polling every {} seconds", watcherIntervalSec);
+    }
     int64_t lastTime;
     struct stat statTime;
     stat(configFilename.c_str(), &statTime);
     lastTime = statTime.st_ctime;
+    // versions restored from server snapshot are verified against the storage on first check
+    cloudPollSchedule.setCheckNewModelsNow(ServerSnapshot::getInstance().hasRestoredModels());
+    loadModelsInBackground = true;
     while (exit.wait_for(std::chrono::milliseconds(1)) == std::future_status::timeout) {
-        std::this_thread::sleep_for(std::chrono::seconds(watcherIntervalSec));
-        stat(configFilename.c_str(), &statTime);
-        if (lastTime != statTime.st_ctime) {
-            lastTime = statTime.st_ctime;
-            loadConfig(configFilename);
+        std::set<std::string> changedDirectories;
+        if (fsWatcher.isAvailable()) {
+            watchLocalPaths(fsWatcher);
+            changedDirectories = fsWatcher.waitForChanges(std::chrono::seconds(watcherIntervalSec));
+        } else {
+            std::this_thread::sleep_for(std::chrono::seconds(watcherIntervalSec));
         }
+        collectModelUpdates(false);
+        const bool pollLocal = !fsWatcher.isAvailable();
+        if (pollLocal || changedDirectories.size() > 0) {
+            stat(configFilename.c_str(), &statTime);
+            if (lastTime != statTime.st_ctime) {
+                lastTime = statTime.st_ctime;
+                // models being updated get their changed config applied once the update in progress finishes
+                loadConfig(configFilename);
+            }
+        }
+        const auto changedCloudModels = findChangedCloudModels();
         for (auto& config : servedModelConfigs) {
-            reloadModelWithVersions(config);
+            const auto& name = config.getName();
+            const bool changeDetected = modelsChangedDuringUpdate.count(name) || modelsWithChangedConfig.count(name) ||
+                                        (isCloudPath(config.getBasePath()) ? changedCloudModels.count(name) > 0 : (pollLocal || isModelChangeDetected(config, changedDirectories)));
+            if (!changeDetected && !modelsToRecheck.count(name)) {
+                continue;
+            }
+            if (modelUpdates.count(name) || modelUpdates.size() >= MAX_MODEL_LOADING_THREADS) {
+                modelsChangedDuringUpdate.insert(name);
+                continue;
+            }
+            modelsChangedDuringUpdate.erase(name);
+            scheduleModelUpdate(config);
         }
+        OnDemandModels::getInstance().evictIdle();
     }
+    collectModelUpdates(true);
+    loadModelsInBackground = false;
     spdlog::info("Exited config watcher thread");
 }
 
+std::set<std::string> ModelManager::findChangedCloudModels() {
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::reference_wrapper<const ModelConfig>> cloudModels;
+    std::set<std::string> servedCloudModels;
+    for (const auto& config : servedModelConfigs) {
+        if (!isCloudPath(config.getBasePath())) {
+            continue;
+        }
+        servedCloudModels.insert(config.getName());
+        const std::chrono::seconds interval(config.getStoragePollIntervalSeconds() ? config.getStoragePollIntervalSeconds() : cloudWatcherIntervalSec);
+        const std::chrono::seconds maxInterval(config.getStoragePollMaxIntervalSeconds() ? config.getStoragePollMaxIntervalSeconds() : interval.count() * DEFAULT_STORAGE_POLL_BACKOFF_FACTOR);
+        if (cloudPollSchedule.isDue(config.getName(), interval, maxInterval, now) && !modelUpdates.count(config.getName()) && !modelsToRecheck.count(config.getName())) {
+            cloudModels.emplace_back(config);
+        }
+    }
+    cloudPollSchedule.retain(servedCloudModels);
+    cloudPollSchedule.setCheckNewModelsNow(false);
+    if (cloudModels.empty()) {
+        return {};
+    }
+    // pass over all models takes about as long as listing of the slowest one
+    std::vector<char> changed(cloudModels.size(), false);
+    std::atomic<size_t> nextModel{0};
+    auto check = [this, &cloudModels, &changed, &nextModel]() {
+        for (size_t model = nextModel++; model < cloudModels.size(); model = nextModel++) {
+            changed[model] = isCloudModelChangeDetected(cloudModels[model].get());
+        }
+    };
+    const size_t threadsCount = std::min<size_t>(MAX_CLOUD_DISCOVERY_THREADS, cloudModels.size());
+    if (threadsCount <= 1) {
+        check();
+    } else {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadsCount; ++i) {
+            threads.emplace_back(check);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    std::set<std::string> changedModels;
+    for (size_t model = 0; model < cloudModels.size(); ++model) {
+        const auto& name = cloudModels[model].get().getName();
+        if (changed[model]) {
+            changedModels.insert(name);
+        }
+        // next check is scheduled from the end of listing, slow storage is not listed more often
+        cloudPollSchedule.reportCheck(name, changed[model], std::chrono::steady_clock::now());
+        SPDLOG_DEBUG("Next check of model {} in cloud storage in about {} ms", name, cloudPollSchedule.getInterval(name).count());
+    }
+    return changedModels;
+}
+
+bool ModelManager::isCloudModelChangeDetected(const ModelConfig& config) {
+    auto model = findModelByName(config.getName());
+    if (!model) {
+        return true;
+    }
+    auto fs = getFilesystem(config.getBasePath());
+    model_versions_t requestedVersions;
+    if (!readAvailableVersions(fs, config.getBasePath(), requestedVersions).ok()) {
+        // error is reported by the update, model is rechecked afterwards
+        return true;
+    }
+    requestedVersions = config.getModelVersionPolicy()->filter(requestedVersions);
+    std::shared_ptr<model_versions_t> versionsToStart;
+    std::shared_ptr<model_versions_t> versionsToReload;
+    std::shared_ptr<model_versions_t> versionsToRetire;
+    getVersionsToChange(config, model->getModelVersions(), requestedVersions, versionsToStart, versionsToReload, versionsToRetire);
+    return !versionsToStart->empty() || !versionsToReload->empty() || !versionsToRetire->empty();
+}
+
+void ModelManager::scheduleModelUpdate(const ModelConfig& config) {
+    // retries of failed models are reported, models failing on regular checks are reported by their first retry
+    // models with changed config are reported pending since the config was applied
+    const bool configChanged = modelsWithChangedConfig.erase(config.getName()) > 0;
+    const bool recheck = modelsToRecheck.count(config.getName()) > 0;
+    if (recheck && !configChanged) {
+        loadProgress.markPending(config.getName());
+    }
+    const bool reportProgress = recheck || configChanged;
+    // new versions are published once loaded and warmed up, old versions are retired afterwards
+    auto loaded = std::async(std::launch::async, [this, config, reportProgress]() mutable {
+        const bool loaded = reloadModelWithVersions(config).ok();
+        if (reportProgress) {
+            loadProgress.markFinished(config.getName(), loaded);
+        }
+        return loaded;
+    });
+    modelUpdates[config.getName()] = ModelUpdate{std::move(loaded), configChanged};
+}
+
+void ModelManager::collectModelUpdates(bool wait) {
+    bool configUpdatesFinished = false;
+    bool configUpdatesInProgress = false;
+    for (auto it = modelUpdates.begin(); it != modelUpdates.end();) {
+        auto& update = it->second;
+        if (!wait && update.loaded.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            configUpdatesInProgress |= update.configChanged;
+            ++it;
+            continue;
+        }
+        configUpdatesFinished |= update.configChanged;
+        const bool loaded = update.loaded.get();
+        const bool served = std::any_of(servedModelConfigs.begin(), servedModelConfigs.end(),
+            [&it](const ModelConfig& config) { return config.getName() == it->first; });
+        if (!served) {
+            // model was removed from config while it was updated, versions added by the update are retired now
+            modelsToRecheck.erase(it->first);
+            loadProgress.remove(it->first);
+            auto model = findModelByName(it->first);
+            if (model) {
+                model->retireAllVersions();
+            }
+        } else if (loaded) {
+            modelsToRecheck.erase(it->first);
+        } else {
+            modelsToRecheck.insert(it->first);
+        }
+        it = modelUpdates.erase(it);
+    }
+    if (pipelinesWaitForModels && configUpdatesFinished) {
+        loadPipelinesConfig(pendingPipelinesConfig);
+    }
+    if (pipelinesWaitForModels && !configUpdatesInProgress && modelsWithChangedConfig.empty()) {
+        pipelinesWaitForModels = false;
+        rapidjson::Document empty;
+        pendingPipelinesConfig.Swap(empty);
+    }
+}
+
 void ModelManager::join() {
     if (watcherStarted) {
         exit.set_value();
@@ -391,26 +799,29 @@ std::shared_ptr<ovms::Model> ModelManager::getModelIfExistCreateElse(const std::
     auto modelIt = models.find(modelName);
     if (models.end() == modelIt) {
         models.insert({modelName, modelFactory(modelName)});
+        modelsSnapshot.publish(models);
     }
     return models[modelName];
 }
 
 std::shared_ptr<FileSystem> getFilesystem(const std::string& basePath) {
     if (basePath.rfind(S3FileSystem::S3_URL_PREFIX, 0) == 0) {
+        static std::mutex awsInitMutex;
+        std::lock_guard<std::mutex> lock(awsInitMutex);
         Aws::SDKOptions options;
         Aws::InitAPI(options);
-        return std::make_shared<S3FileSystem>(options, basePath);
+        return std::make_shared<InstrumentedFileSystem>(std::make_shared<S3FileSystem>(options, basePath), "s3");
     }
     if (basePath.rfind(GCSFileSystem::GCS_URL_PREFIX, 0) == 0) {
-        return std::make_shared<ovms::GCSFileSystem>();
+        return std::make_shared<InstrumentedFileSystem>(std::make_shared<ovms::GCSFileSystem>(), "gcs");
     }
     if (basePath.rfind(AzureFileSystem::AZURE_URL_FILE_PREFIX, 0) == 0) {
-        return std::make_shared<ovms::AzureFileSystem>();
+        return std::make_shared<InstrumentedFileSystem>(std::make_shared<ovms::AzureFileSystem>(), "azure_file");
     }
     if (basePath.rfind(AzureFileSystem::AZURE_URL_BLOB_PREFIX, 0) == 0) {
-        return std::make_shared<ovms::AzureFileSystem>();
+        return std::make_shared<InstrumentedFileSystem>(std::make_shared<ovms::AzureFileSystem>(), "azure_blob");
     }
-    return std::make_shared<LocalFileSystem>();
+    return std::make_shared<InstrumentedFileSystem>(std::make_shared<LocalFileSystem>(), "local");
 }
 
 Status ModelManager::readAvailableVersions(std::shared_ptr<FileSystem>& fs, const std::string& base, model_versions_t& versions) {
@@ -459,21 +870,66 @@ StatusCode downloadModels(std::shared_ptr<FileSystem>& fs, ModelConfig& config,
     }
     std::string localPath;
     spdlog::info("Getting model from {}", config.getBasePath());
+    const auto start = std::chrono::steady_clock::now();
     auto sc = fs->downloadModelVersions(config.getBasePath(), &localPath, *versions);
     if (sc != StatusCode::OK) {
         spdlog::error("Couldn't download model from {}", config.getBasePath());
         return sc;
     }
+    if (isCloudPath(config.getBasePath())) {
+        MetricsRegistry::getInstance().gauge("ovms_model_download_duration_seconds", "Duration of last download of model versions from cloud storage", {{"name", config.getName()}})
+            .set(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
     config.setLocalPath(localPath);
     spdlog::info("Model downloaded to {}", config.getLocalPath());
 
     return StatusCode::OK;
 }
 
+uint64_t ModelManager::getInFlightRequestsCount() const {
+    uint64_t count = Pipeline::getInstancesCount();
+    for (const auto& [name, model] : getModelsSnapshot()) {
+        for (const auto& [version, instance] : model->getModelVersionsMapCopy()) {
+            count += instance->getPredictRequestsHandlesCount();
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Drops new versions without all required model files, so versions still being uploaded are not downloaded and fail to load
+ *
+ * Storage listing reports these versions as changes again, so they are loaded once upload completes.
+ */
+static void removeIncompleteVersions(std::shared_ptr<FileSystem>& fs, const ModelConfig& config, model_versions_t& versions) {
+    auto incomplete = std::remove_if(versions.begin(), versions.end(), [&fs, &config](model_version_t version) {
+        const auto path = joinPath({config.getBasePath(), std::to_string(version)});
+        files_list_t files;
+        if (fs->getDirectoryFiles(path, &files) != StatusCode::OK) {
+            // listing errors are reported by the load
+            return false;
+        }
+        for (auto extension : ModelInstance::REQUIRED_MODEL_FILES_EXTENSIONS) {
+            if (std::none_of(files.begin(), files.end(), [&extension](const std::string& file) { return endsWith(file, extension); })) {
+                spdlog::warn("Model: {} version: {} has no *{} file yet, it is loaded when upload completes", config.getName(), version, extension);
+                return true;
+            }
+        }
+        return false;
+    });
+    versions.erase(incomplete, versions.end());
+}
+
 Status ModelManager::reloadModelWithVersions(ModelConfig& config) {
     auto fs = getFilesystem(config.getBasePath());
     std::vector<model_version_t> requestedVersions;
-    auto status = readAvailableVersions(fs, config.getBasePath(), requestedVersions);
+    Status status = StatusCode::OK;
+    // listing cloud storage on start is skipped for versions loaded before restart
+    const bool restored = isCloudPath(config.getBasePath()) &&
+                          ServerSnapshot::getInstance().takeModelVersions(config.getName(), config.getBasePath(), requestedVersions);
+    if (!restored) {
+        status = readAvailableVersions(fs, config.getBasePath(), requestedVersions);
+    }
     if (!status.ok()) {
         return status;
     }
@@ -484,9 +940,19 @@ Status ModelManager::reloadModelWithVersions(ModelConfig& config) {
     std::shared_ptr<model_versions_t> versionsToRetire;
 
     auto model = getModelIfExistCreateElse(config.getName());
+    model->setVersionWeights(config.getVersionWeights());
     getVersionsToChange(config, model->getModelVersions(), requestedVersions, versionsToStart, versionsToReload, versionsToRetire);
-    downloadModels(fs, config, versionsToStart);
-    downloadModels(fs, config, versionsToReload);
+    if (isCloudPath(config.getBasePath()) && !restored) {
+        // one listing per new version is cheap compared to the download and compilation it can save
+        removeIncompleteVersions(fs, config, *versionsToStart);
+    }
+    if (streamCloudModels && isCloudPath(config.getBasePath())) {
+        // model instances read model files straight from the storage into memory
+        config.setLocalPath(config.getBasePath());
+    } else {
+        downloadModels(fs, config, versionsToStart);
+        downloadModels(fs, config, versionsToReload);
+    }
 
     status = model->addVersions(versionsToStart, config);
     if (!status.ok()) {
@@ -528,9 +994,10 @@ Status ModelManager::reloadModelWithVersions(ModelConfig& config) {
 }
 
 const std::shared_ptr<Model> ModelManager::findModelByName(const std::string& name) const {
-    std::shared_lock lock(modelsMtx);
-    auto it = models.find(name);
-    return it != models.end() ? it->second : nullptr;
+    return modelsSnapshot.read([&name](const auto& models) -> std::shared_ptr<Model> {
+        auto it = models.find(name);
+        return it != models.end() ? it->second : nullptr;
+    });
 }
 
 }  // namespace ovms
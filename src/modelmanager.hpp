@@ -22,18 +22,34 @@
 #include <shared_mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <rapidjson/document.h>
 #include <spdlog/spdlog.h>
 
 #include "filesystem.hpp"
+#include "loadprogress.hpp"
 #include "model.hpp"
 #include "pipeline.hpp"
 #include "pipeline_factory.hpp"
+#include "readsnapshot.hpp"
+#include "storagepollschedule.hpp"
 
 namespace ovms {
 class IVersionReader;
+class LocalFileSystemWatcher;
+
+/**
+ * @brief Creates filesystem serving given path, local filesystem if path has no cloud storage prefix
+ */
+std::shared_ptr<FileSystem> getFilesystem(const std::string& basePath);
+
+/**
+ * @brief Checks if path is located in S3, GCS or Azure storage
+ */
+bool isCloudPath(const std::string& basePath);
+
 /**
  * @brief Model manager is managing the list of model topologies enabled for serving and their versions.
  */
@@ -69,13 +85,49 @@ private:
     Status loadConfig(const std::string& jsonFilename);
 
     Status loadModelsConfig(rapidjson::Document& configJson);
+
+    /**
+     * @brief Loads models on a bounded number of threads, each model is available as soon as its versions are loaded
+     */
+    void reloadModelsWithVersions(std::vector<ModelConfig>& configs);
     Status loadPipelinesConfig(rapidjson::Document& configJson);
 
     /**
      * @brief Watcher thread for monitor changes in config
+     *
+     * Config file and local models are checked when inotify reports changes in their directories,
+     * models in cloud storage are checked at their own longer intervals, backing off while versions do not change.
+     * Watcher only detects changes, downloads and loads of changed models and versions run on loader threads.
      */
     void watcher(std::future<void> exit);
 
+    /**
+     * @brief Adds directories of config file, local models and their versions to watched directories
+     */
+    void watchLocalPaths(LocalFileSystemWatcher& fsWatcher);
+
+    /**
+     * @brief Checks if any of changed directories is base path or version directory of the model
+     */
+    bool isModelChangeDetected(const ModelConfig& config, const std::set<std::string>& changedDirectories) const;
+
+    /**
+     * @brief Lists versions of served models in cloud storage due for a check concurrently and finds models with versions to change
+     *
+     * Models with update in progress or waiting for recheck are skipped, these are updated anyway.
+     */
+    std::set<std::string> findChangedCloudModels();
+
+    /**
+     * @brief Times of next version listing of models in cloud storage
+     */
+    StoragePollSchedule cloudPollSchedule;
+
+    /**
+     * @brief Checks if available versions of the model differ from its served versions, listing errors count as changes
+     */
+    bool isCloudModelChangeDetected(const ModelConfig& config);
+
     /**
      * @brief A JSON configuration filename
      */
@@ -97,6 +149,72 @@ private:
      */
     std::vector<ModelConfig> servedModelConfigs;
 
+    /**
+     * @brief Serialized config file entries of models and pipelines applied by last config reload, unchanged entries are skipped
+     */
+    std::unordered_map<std::string, std::string> loadedModelsConfigs;
+    std::unordered_map<std::string, std::string> loadedPipelinesConfigs;
+
+    /**
+     * @brief Models which failed to load, checked by watcher every interval until they succeed
+     */
+    std::set<std::string> modelsToRecheck;
+
+    /**
+     * @brief Update of model versions running on a loader thread
+     */
+    struct ModelUpdate {
+        std::future<bool> loaded;
+        // started by config reload, pipelines waiting for the model are created once it finishes
+        bool configChanged;
+    };
+
+    /**
+     * @brief Version updates of models detected by watcher, run in background so slow downloads and loads do not delay checks of other models
+     */
+    std::map<std::string, ModelUpdate> modelUpdates;
+
+    /**
+     * @brief Models with config changed by config reload of running server, waiting for a loader thread
+     */
+    std::set<std::string> modelsWithChangedConfig;
+
+    /**
+     * @brief Config reloads of running server only schedule loads of changed models, so the watcher is not blocked by them
+     */
+    bool loadModelsInBackground = false;
+
+    /**
+     * @brief Config of last reload with pipelines created again while models with changed config are loading
+     */
+    rapidjson::Document pendingPipelinesConfig;
+    bool pipelinesWaitForModels = false;
+
+    /**
+     * @brief Models changed while their update was in progress or update threads were busy, checked again by next watcher iteration
+     */
+    std::set<std::string> modelsChangedDuringUpdate;
+
+    /**
+     * @brief Starts update of model versions in background, update works on a copy of model config
+     */
+    void scheduleModelUpdate(const ModelConfig& config);
+
+    /**
+     * @brief Collects results of finished model updates into models to recheck
+     *
+     * Models removed from config while they were updated are retired. Pipelines of the last config reload
+     * are created again after each finished update of model with changed config.
+     *
+     * @param wait waits for updates in progress if true
+     */
+    void collectModelUpdates(bool wait);
+
+    /**
+     * @brief Load state and load time of models, reported by health endpoints
+     */
+    LoadProgress loadProgress;
+
     /**
      * @brief Retires models non existing in config file
      *
@@ -109,6 +227,11 @@ private:
      */
     mutable std::shared_mutex modelsMtx;
 
+    /**
+     * @brief Copy of models published on each change, read by request lookups without locking modelsMtx
+     */
+    ReadSnapshot<std::map<std::string, std::shared_ptr<Model>>> modelsSnapshot;
+
 public:
     /**
      * @brief Gets the instance of ModelManager
@@ -142,6 +265,15 @@ public:
         return models;
     }
 
+    /**
+     * @brief Gets copy of models collection, safe to call while configuration is reloaded
+     * 
+     * @return models collection
+     */
+    std::map<std::string, std::shared_ptr<Model>> getModelsSnapshot() const {
+        return modelsSnapshot.read([](const auto& models) { return models; });
+    }
+
     /**
      * @brief Finds model with specific name
      *
@@ -186,10 +318,30 @@ public:
         return pipelineFactory.create(pipeline, name, request, response, *this);
     }
 
+    const LoadProgress& getLoadProgress() const {
+        return loadProgress;
+    }
+
+    /**
+     * @brief Stops reporting readiness, so load balancers stop sending requests before server exits
+     */
+    void markDraining() {
+        loadProgress.markDraining();
+    }
+
+    /**
+     * @brief Counts requests holding model instances and pipelines not finished yet
+     */
+    uint64_t getInFlightRequestsCount() const;
+
     const bool pipelineDefinitionExists(const std::string& name) const {
         return pipelineFactory.definitionExists(name);
     }
 
+    const PipelineFactory& getPipelineFactory() const {
+        return pipelineFactory;
+    }
+
     /**
      * @brief Starts model manager using provided config file
      * 
@@ -0,0 +1,84 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "modelmetrics.hpp"
+
+namespace ovms {
+
+namespace {
+Histogram& registerStageHistogram(const std::string& stage, const metric_labels_t& labels) {
+    return MetricsRegistry::getInstance().histogram("ovms_request_" + stage + "_duration_seconds",
+        "Duration of " + stage + " stage of predict requests", labels, MetricsRegistry::LATENCY_BUCKETS_SECONDS);
+}
+
+Counter& registerQueueRejections(const std::string& reason, metric_labels_t labels) {
+    labels.emplace_back("reason", reason);
+    return MetricsRegistry::getInstance().counter("ovms_request_queue_rejections_total", "Predict requests rejected by request queue limits", labels);
+}
+}  // namespace
+
+ModelMetrics::ModelMetrics(const std::string& name, model_version_t version) :
+    requests(MetricsRegistry::getInstance().counter("ovms_requests_total", "Predict requests received by model version", createLabels(name, version))),
+    queueWait(registerStageHistogram("queue_wait", createLabels(name, version))),
+    deserialization(registerStageHistogram("deserialization", createLabels(name, version))),
+    inference(registerStageHistogram("inference", createLabels(name, version))),
+    serialization(registerStageHistogram("serialization", createLabels(name, version))),
+    responseCacheHits(MetricsRegistry::getInstance().counter("ovms_response_cache_hits_total", "Predict requests served from response cache", createLabels(name, version))),
+    responseCacheMisses(MetricsRegistry::getInstance().counter("ovms_response_cache_misses_total", "Cacheable predict requests not found in response cache", createLabels(name, version))),
+    coalescedRequests(MetricsRegistry::getInstance().counter("ovms_coalesced_requests_total", "Predict requests answered by in-flight inference of identical request", createLabels(name, version))),
+    hedgedRequests(MetricsRegistry::getInstance().counter("ovms_hedged_requests_total", "Predict requests sent for a second inference after hedge delay", createLabels(name, version))),
+    hedgeWins(MetricsRegistry::getInstance().counter("ovms_hedge_wins_total", "Hedged predict requests answered by the second inference", createLabels(name, version))),
+    weightedRoutes(MetricsRegistry::getInstance().counter("ovms_weighted_routes_total", "Predict requests without version routed to model version by version weights", createLabels(name, version))),
+    loadResidentMemory(MetricsRegistry::getInstance().gauge("ovms_model_version_load_resident_memory_bytes", "Growth of server resident memory during last load of model version", createLabels(name, version))),
+    inferRequestBlobsMemory(MetricsRegistry::getInstance().gauge("ovms_model_version_infer_request_blobs_bytes", "Size of input and output blobs of infer requests of model version", createLabels(name, version))),
+    inferRequestsQueue{
+        MetricsRegistry::getInstance().gauge("ovms_infer_requests", "Infer requests (nireq) of model version", createLabels(name, version)),
+        MetricsRegistry::getInstance().usageGauge("ovms_infer_requests_in_use", "Infer requests of model version executing inference", createLabels(name, version)),
+        MetricsRegistry::getInstance().gauge("ovms_infer_request_waiters", "Requests and pipeline nodes waiting for idle infer request", createLabels(name, version)),
+        MetricsRegistry::getInstance().histogram("ovms_infer_request_acquisition_duration_seconds",
+            "Duration of acquiring idle infer request, including requests and pipeline nodes", createLabels(name, version), MetricsRegistry::LATENCY_BUCKETS_SECONDS),
+        MetricsRegistry::getInstance().gauge("ovms_request_queue_depth", "Predict requests queued for idle infer request of model version", createLabels(name, version)),
+        MetricsRegistry::getInstance().counter("ovms_request_queue_queued_total", "Predict requests which waited in request queue", createLabels(name, version)),
+        registerQueueRejections("full", createLabels(name, version)),
+        registerQueueRejections("timeout", createLabels(name, version)),
+        MetricsRegistry::getInstance().counter("ovms_request_queue_wait_microseconds_total", "Time predict requests waited in request queue", createLabels(name, version))},
+    labels(createLabels(name, version)),
+    errors(std::make_unique<std::atomic<Counter*>[]>(static_cast<size_t>(StatusCode::STATUS_CODE_END))) {
+    for (size_t i = 0; i < static_cast<size_t>(StatusCode::STATUS_CODE_END); ++i) {
+        errors[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+metric_labels_t ModelMetrics::createLabels(const std::string& name, model_version_t version) {
+    return {{"name", name}, {"version", std::to_string(version)}};
+}
+
+void ModelMetrics::countError(const Status& status) {
+    const auto code = static_cast<size_t>(status.getCode());
+    if (code >= static_cast<size_t>(StatusCode::STATUS_CODE_END)) {
+        return;
+    }
+    Counter* counter = errors[code].load(std::memory_order_acquire);
+    if (counter == nullptr) {
+        auto codeLabels = labels;
+        codeLabels.emplace_back("code", std::to_string(code));
+        // registry returns the same counter to threads racing here
+        counter = &MetricsRegistry::getInstance().counter("ovms_request_errors_total", "Failed predict requests by status code", codeLabels);
+        errors[code].store(counter, std::memory_order_release);
+    }
+    counter->increment();
+}
+
+}  // namespace ovms
@@ -0,0 +1,90 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "metrics.hpp"
+#include "model_version_policy.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Utilization of infer requests of a model version, shared by its infer request queues of all network shapes
+ */
+struct InferRequestsQueueMetrics {
+    // nireq of the queue in use
+    Gauge& streams;
+    UsageGauge& streamsInUse;
+    // acquisitions which found no idle infer request and wait for one
+    Gauge& waiters;
+    // all acquisitions, the ones which found idle infer request right away are observed as 0
+    Histogram& acquisition;
+    // predict requests waiting within max_queue_size and max_queue_time limits
+    Gauge& queueDepth;
+    Counter& queuedRequests;
+    Counter& rejectedQueueFull;
+    Counter& rejectedQueueTimeout;
+    Counter& queueWaitMicroseconds;
+};
+
+/**
+ * @brief Metrics of predict requests served by a model version
+ *
+ * Metrics are registered once per model version, so request processing only updates them.
+ */
+class ModelMetrics {
+public:
+    ModelMetrics(const std::string& name, model_version_t version);
+
+    /**
+     * @brief Counts failed request by its status code, counter of each code is registered on its first error
+     */
+    void countError(const Status& status);
+
+    Counter& requests;
+    // waiting for idle infer request within nireq limits
+    Histogram& queueWait;
+    Histogram& deserialization;
+    Histogram& inference;
+    Histogram& serialization;
+    // requests of models with response cache
+    Counter& responseCacheHits;
+    Counter& responseCacheMisses;
+    // requests of models with request coalescing answered by inference of identical request
+    Counter& coalescedRequests;
+    // requests of models with hedging
+    Counter& hedgedRequests;
+    Counter& hedgeWins;
+    // requests without version routed to this version by version weights
+    Counter& weightedRoutes;
+    // measured when version is loaded
+    Gauge& loadResidentMemory;
+    Gauge& inferRequestBlobsMemory;
+
+    InferRequestsQueueMetrics inferRequestsQueue;
+
+private:
+    static metric_labels_t createLabels(const std::string& name, model_version_t version);
+
+    const metric_labels_t labels;
+    std::unique_ptr<std::atomic<Counter*>[]> errors;
+};
+
+}  // namespace ovms
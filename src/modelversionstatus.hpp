@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <unordered_map>
@@ -75,11 +76,30 @@ inline const std::string& ModelVersionStatusErrorCodeToString(ModelVersionStatus
     return errors.at(code);
 }
 
+/**
+ * @brief State and error code of model version read together, as published by the last status change
+ */
+struct ModelVersionStatusSnapshot {
+    ModelVersionState state;
+    ModelVersionStatusErrorCode errorCode;
+
+    const std::string& getStateString() const {
+        return ModelVersionStateToString(this->state);
+    }
+
+    const std::string& getErrorMsg() const {
+        return ModelVersionStatusErrorCodeToString(this->errorCode);
+    }
+};
+
+/**
+ * @brief Status of model version, state is published atomically so that status and metadata reads never
+ * wait for version loading and never see torn state and error code
+ */
 class ModelVersionStatus {
     std::string modelName;
     model_version_t version;
-    ModelVersionState state;
-    ModelVersionStatusErrorCode errorCode;
+    std::atomic<ModelVersionStatusSnapshot> current{ModelVersionStatusSnapshot{ModelVersionState::START, ModelVersionStatusErrorCode::OK}};
 
 public:
     ModelVersionStatus() = default;
@@ -87,25 +107,40 @@ public:
     ModelVersionStatus(const std::string& model_name, model_version_t version, ModelVersionState state = ModelVersionState::START) :
         modelName(model_name),
         version(version),
-        state(state),
-        errorCode(ModelVersionStatusErrorCode::OK) {
+        current(ModelVersionStatusSnapshot{state, ModelVersionStatusErrorCode::OK}) {
         logStatus();
     }
 
+    ModelVersionStatus(const ModelVersionStatus& other) :
+        modelName(other.modelName),
+        version(other.version),
+        current(other.current.load()) {}
+
+    ModelVersionStatus& operator=(const ModelVersionStatus& other) {
+        this->modelName = other.modelName;
+        this->version = other.version;
+        this->current.store(other.current.load());
+        return *this;
+    }
+
+    ModelVersionStatusSnapshot getSnapshot() const {
+        return this->current.load();
+    }
+
     ModelVersionState getState() const {
-        return this->state;
+        return getSnapshot().state;
     }
 
     const std::string& getStateString() const {
-        return ModelVersionStateToString(this->state);
+        return getSnapshot().getStateString();
     }
 
     ModelVersionStatusErrorCode getErrorCode() const {
-        return this->errorCode;
+        return getSnapshot().errorCode;
     }
 
     const std::string& getErrorMsg() const {
-        return ModelVersionStatusErrorCodeToString(this->errorCode);
+        return getSnapshot().getErrorMsg();
     }
 
     /**
@@ -114,44 +149,38 @@ public:
      * @return
      */
     bool willEndUnloaded() const {
-        return ovms::ModelVersionState::UNLOADING <= this->state;
+        return ovms::ModelVersionState::UNLOADING <= getState();
     }
 
     void setLoading(ModelVersionStatusErrorCode error_code = ModelVersionStatusErrorCode::OK) {
-        spdlog::debug("{}: {} - {} (previous state: {}) -> error: {}", __func__, this->modelName, this->version, ModelVersionStateToString(this->state), ModelVersionStatusErrorCodeToString(error_code));
-        state = ModelVersionState::LOADING;
-        errorCode = error_code;
-        logStatus();
+        setState(__func__, ModelVersionState::LOADING, error_code);
     }
 
     void setAvailable(ModelVersionStatusErrorCode error_code = ModelVersionStatusErrorCode::OK) {
-        spdlog::debug("{}: {} - {} (previous state: {}) -> error: {}", __func__, this->modelName, this->version, ModelVersionStateToString(this->state), ModelVersionStatusErrorCodeToString(error_code));
-        state = ModelVersionState::AVAILABLE;
-        errorCode = error_code;
-        logStatus();
+        setState(__func__, ModelVersionState::AVAILABLE, error_code);
     }
 
     void setUnloading(ModelVersionStatusErrorCode error_code = ModelVersionStatusErrorCode::OK) {
-        spdlog::debug("{}: {} - {} (previous state: {}) -> error: {}", __func__, this->modelName, this->version, ModelVersionStateToString(this->state), ModelVersionStatusErrorCodeToString(error_code));
-        state = ModelVersionState::UNLOADING;
-        errorCode = error_code;
-        logStatus();
+        setState(__func__, ModelVersionState::UNLOADING, error_code);
     }
 
     void setEnd(ModelVersionStatusErrorCode error_code = ModelVersionStatusErrorCode::OK) {
-        spdlog::debug("{}: {} - {} (previous state: {}) -> error: {}", __func__, this->modelName, this->version, ModelVersionStateToString(this->state), ModelVersionStatusErrorCodeToString(error_code));
-        state = ModelVersionState::END;
-        errorCode = error_code;
-        logStatus();
+        setState(__func__, ModelVersionState::END, error_code);
     }
 
 private:
+    void setState(const char* transition, ModelVersionState state, ModelVersionStatusErrorCode error_code) {
+        spdlog::debug("{}: {} - {} (previous state: {}) -> error: {}", transition, this->modelName, this->version, getStateString(), ModelVersionStatusErrorCodeToString(error_code));
+        this->current.store(ModelVersionStatusSnapshot{state, error_code});
+        logStatus();
+    }
+
     void logStatus() {
         spdlog::info("STATUS CHANGE: Version {} of model {} status change. New status: ( \"state\": \"{}\", \"error_code\": \"{}\" )",
             this->version,
             this->modelName,
-            ModelVersionStateToString(state),
-            ModelVersionStatusErrorCodeToString(errorCode));
+            getStateString(),
+            getErrorMsg());
     }
 };
 
@@ -17,10 +17,16 @@
 
 #include <algorithm>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 
+#include "ov_utils.hpp"
+#include "requestlogging.hpp"
 #include "status.hpp"
+#include "tensorinfo.hpp"
 
 namespace ovms {
 
@@ -33,6 +39,24 @@ void Node::printNodeConnections(const std::string& nodeName, const std::string&
     SPDLOG_DEBUG(ss.str());
 }
 
+const InputPairs& Node::getMappingByDependency(const Node& dependency) const {
+    // nodes have a few dependencies, comparing addresses is cheaper than hashing names
+    for (size_t i = 0; i < this->previous.size(); ++i) {
+        if (&this->previous[i].get() == &dependency) {
+            return this->blobNamesMapping[i];
+        }
+    }
+    throw std::out_of_range("Node: " + getName() + " does not depend on node: " + dependency.getName());
+}
+
+void Node::addRequiredOutputs(const InputPairs& blobNamesMapping) {
+    for (const auto& pair : blobNamesMapping) {
+        if (std::find(this->requiredOutputs.begin(), this->requiredOutputs.end(), pair.first) == this->requiredOutputs.end()) {
+            this->requiredOutputs.emplace_back(pair.first);
+        }
+    }
+}
+
 Status Node::setInputs(const Node& dependency, BlobMap& inputs) {
     // mapping for dependency - keeps mapping between dependency output name and this node input name
     const auto& mapping_for_dependency = this->getMappingByDependency(dependency);
@@ -45,7 +69,7 @@ Status Node::setInputs(const Node& dependency, BlobMap& inputs) {
         // possibly incorrectly constructed pipeline - required input missing from previous node
         auto it = inputs.find(dependency_output_name);
         if (it == inputs.end()) {
-            SPDLOG_INFO("Node::setInputs: error setting required input for (Node name {}) from (Node name {}): dependency is missing output name {}",
+            OVMS_REQUEST_DEBUG("Node::setInputs: error setting required input for (Node name {}) from (Node name {}): dependency is missing output name {}",
                 getName(),
                 dependency.getName(),
                 dependency_output_name);
@@ -56,11 +80,125 @@ Status Node::setInputs(const Node& dependency, BlobMap& inputs) {
             dependency.getName(),
             current_node_input_name,
             dependency_output_name);
-        this->inputBlobs[current_node_input_name] = it->second;
+        auto blob = it->second;
+        // outputs in device memory are passed as these are only to nodes inferring on the device
+        if (isRemoteBlob(blob) && (this->gatherCount || !this->acceptsRemoteInputs())) {
+            blob = blobToHost(blob);
+            if (blob == nullptr) {
+                SPDLOG_ERROR("Node::setInputs: (Node name {}) cannot copy input {} from device memory", getName(), current_node_input_name);
+                return StatusCode::INTERNAL_ERROR;
+            }
+        }
+        if (this->gatherCount) {
+            auto status = gather(blob, this->inputBlobs[current_node_input_name], current_node_input_name);
+            if (!status.ok()) {
+                return status;
+            }
+        } else {
+            this->inputBlobs[current_node_input_name] = std::move(blob);
+        }
     }
 
     finishedDependenciesCount++;
     return StatusCode::OK;
 }
 
+Status Node::checkSkipped(bool& skipped) const {
+    if (this->dependencySkipped) {
+        skipped = !this->runsWithSkippedDependencies();
+        return StatusCode::OK;
+    }
+    if (!this->condition) {
+        skipped = false;
+        return StatusCode::OK;
+    }
+    const auto& inputName = this->condition->inputName;
+    auto it = this->inputBlobs.find(inputName);
+    if (it == this->inputBlobs.end()) {
+        SPDLOG_ERROR("Node::checkSkipped: (Node name {}) missing input {} of condition", getName(), inputName);
+        return StatusCode::PIPELINE_CONDITION_INVALID;
+    }
+    bool met = false;
+    auto status = evaluateNodeCondition(this->condition.value(), it->second, met);
+    if (!status.ok()) {
+        SPDLOG_DEBUG("Node::checkSkipped: (Node name {}) cannot evaluate condition on input {}: {}", getName(), inputName, status.string());
+        return status;
+    }
+    OVMS_REQUEST_DEBUG("Node::checkSkipped: (Node name {}) condition on input {} is {}met", getName(), inputName, met ? "" : "not ");
+    skipped = !met;
+    return StatusCode::OK;
+}
+
+Status Node::demultiplyOutputs(BlobMap& outputs) const {
+    if (!this->demultiplyCount) {
+        return StatusCode::OK;
+    }
+    const size_t count = this->demultiplyCount.value();
+    for (auto& pair : outputs) {
+        const auto& dims = pair.second->getTensorDesc().getDims();
+        if (dims.size() < 2 || dims[0] != 1 || dims[1] != count) {
+            std::stringstream ss;
+            ss << "Node: " << getName() << " output: " << pair.first << " cannot be demultiplied into " << count
+               << " sub-requests; Expected: (1," << count << ",...); Actual: " << TensorInfo::shapeToString(dims);
+            const std::string details = ss.str();
+            SPDLOG_DEBUG(details);
+            return Status(StatusCode::INVALID_SHAPE, details);
+        }
+        // views share memory of the output, outputs in device memory are copied to host first
+        auto source = blobToHost(pair.second);
+        if (source == nullptr) {
+            SPDLOG_ERROR("Node::demultiplyOutputs: (Node name {}) cannot copy output {} from device memory", getName(), pair.first);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        auto view = blobReshapedView(source, InferenceEngine::SizeVector(dims.begin() + 1, dims.end()));
+        if (view == nullptr) {
+            SPDLOG_ERROR("Node::demultiplyOutputs: (Node name {}) cannot demultiply output {} - unsupported precision", getName(), pair.first);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        pair.second = std::move(view);
+    }
+    return StatusCode::OK;
+}
+
+Status Node::gather(const InferenceEngine::Blob::Ptr& blob, InferenceEngine::Blob::Ptr& gathered, const std::string& inputName) const {
+    const size_t count = this->gatherCount.value();
+    const auto& dims = blob->getTensorDesc().getDims();
+    if (dims.size() == 0 || dims[0] != count) {
+        std::stringstream ss;
+        ss << "Node: " << getName() << " input: " << inputName << " cannot be gathered from " << count
+           << " sub-requests; Expected: (" << count << ",...); Actual: " << TensorInfo::shapeToString(dims);
+        const std::string details = ss.str();
+        SPDLOG_DEBUG(details);
+        return Status(StatusCode::INVALID_SHAPE, details);
+    }
+    InferenceEngine::SizeVector gatheredDims{1};
+    gatheredDims.insert(gatheredDims.end(), dims.begin(), dims.end());
+    gathered = blobReshapedView(blob, gatheredDims);
+    if (gathered == nullptr) {
+        SPDLOG_ERROR("Node::gather: (Node name {}) cannot gather input {} - unsupported precision", getName(), inputName);
+        return StatusCode::INTERNAL_ERROR;
+    }
+    return StatusCode::OK;
+}
+
+Status Node::copyInputsFrom(const Node& dependency) {
+    if (!dependency.outputsReserveStream()) {
+        return StatusCode::OK;
+    }
+    for (const auto& pair : this->getMappingByDependency(dependency)) {
+        auto it = this->inputBlobs.find(pair.second);
+        if (it == this->inputBlobs.end()) {
+            continue;
+        }
+        auto copiedBlob = blobClone(it->second);
+        if (copiedBlob == nullptr) {
+            SPDLOG_ERROR("Node::copyInputsFrom: (Node name {}) cannot copy blob {} - buffer sizes mismatch", getName(), pair.second);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        SPDLOG_DEBUG("Node::copyInputsFrom: (Node name {}) copied input {} received from (Node name {})", getName(), pair.second, dependency.getName());
+        it->second = std::move(copiedBlob);
+    }
+    return StatusCode::OK;
+}
+
 }  // namespace ovms
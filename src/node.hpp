@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -22,6 +23,7 @@
 
 #include <inference_engine.hpp>
 
+#include "nodecondition.hpp"
 #include "status.hpp"
 #include "threadsafequeue.hpp"
 
@@ -31,20 +33,43 @@ using BlobMap = std::unordered_map<std::string, InferenceEngine::Blob::Ptr>;
 using BlobNames = std::vector<std::string>;
 using InputPairs = std::vector<std::pair<std::string, std::string>>;
 
+class BlobConversionCache;
+
 class Node {
 protected:
     std::string nodeName;
 
+    // Position of the node in its pipeline, used to track execution state without name lookups
+    size_t index = 0;
+
     std::vector<std::reference_wrapper<Node>> previous;
     std::vector<std::reference_wrapper<Node>> next;
 
     size_t finishedDependenciesCount = 0;
 
+    // Set if any dependency was skipped during current execution, node cannot receive all its inputs
+    bool dependencySkipped = false;
+
+    // Node runs only if condition on its input is met, otherwise it is skipped with its dependants
+    std::optional<NodeCondition> condition;
+
     // Blobs ready and waiting for execution
     BlobMap inputBlobs;
 
-    // Input/Output name mapping and list of required inputs from previous nodes
-    std::unordered_map<std::string, InputPairs> blobNamesMapping;
+    // Input/Output name mapping of dependencies, indexed as previous so no name lookups are needed per request
+    std::vector<InputPairs> blobNamesMapping;
+
+    // Outputs consumed by dependants, each listed once
+    BlobNames requiredOutputs;
+
+    // Outputs of [1, N, ...] shape are passed to following nodes as a batch of N sub-requests
+    std::optional<size_t> demultiplyCount;
+
+    // Inputs of [N, ...] shape, results of demultiplexed sub-requests, are gathered into [1, N, ...]
+    std::optional<size_t> gatherCount;
+
+    // Inputs converted to other precisions during current pipeline execution, null outside of execution
+    BlobConversionCache* conversionCache = nullptr;
 
 public:
     Node(const std::string& nodeName) :
@@ -55,21 +80,74 @@ public:
 
     const std::string& getName() const { return this->nodeName; }
 
+    size_t getIndex() const { return this->index; }
+    void setIndex(size_t index) { this->index = index; }
+
     virtual Status execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) = 0;
     virtual Status fetchResults(BlobMap& outputs) = 0;
 
     Status setInputs(const Node& dependency, BlobMap& inputs);
 
+    void setDemultiplyCount(size_t count) { this->demultiplyCount = count; }
+    void setGatherCount(size_t count) { this->gatherCount = count; }
+
+    void setConversionCache(BlobConversionCache* cache) { this->conversionCache = cache; }
+
+    void setCondition(const NodeCondition& condition) { this->condition = condition; }
+
+    /**
+     * @brief Counts skipped dependency as finished, it passes no inputs
+     */
+    void setDependencySkipped() {
+        dependencySkipped = true;
+        finishedDependenciesCount++;
+    }
+
+    /**
+     * @brief Decides if ready node is skipped, either because its dependency was skipped or its condition is not met
+     */
+    Status checkSkipped(bool& skipped) const;
+
+    /**
+     * @brief Checks if node runs with inputs of dependencies which were not skipped
+     */
+    virtual bool runsWithSkippedDependencies() const { return false; }
+
+    /**
+     * @brief Drops inputs of node which is not executed
+     */
+    void skip() {
+        inputBlobs.clear();
+        release();
+    }
+
+    /**
+     * @brief Turns fetched outputs into batch of N sub-requests if node is a demultiplexer, no data is copied
+     */
+    Status demultiplyOutputs(BlobMap& outputs) const;
+
+    /**
+     * @brief Replaces inputs received from dependency with own copies
+     *
+     * Blobs of DLNode outputs keep its stream reserved, node which does not execute right away
+     * copies them so the stream is returned.
+     */
+    virtual Status copyInputsFrom(const Node& dependency);
+
     virtual void addDependency(Node& node, const InputPairs& blobNamesMapping) {
         this->previous.emplace_back(node);
-        this->blobNamesMapping[node.getName()] = blobNamesMapping;
+        this->blobNamesMapping.emplace_back(blobNamesMapping);
+        node.addRequiredOutputs(blobNamesMapping);
     }
 
     virtual void addDependant(Node& node) { this->next.emplace_back(node); }
 
-    const InputPairs& getMappingByDependency(const Node& dependency) {
-        return blobNamesMapping.at(dependency.getName());
-    }
+    const InputPairs& getMappingByDependency(const Node& dependency) const;
+
+    /**
+     * @brief Names of outputs consumed by following nodes, results of other outputs do not need to be fetched
+     */
+    const BlobNames& getRequiredOutputs() const { return requiredOutputs; }
     bool isReady() const {
         return finishedDependenciesCount == previous.size();
     }
@@ -77,9 +155,30 @@ public:
         return next;
     }
     virtual void release() {}
+
+    /**
+     * @brief Drops state of previous execution so the node can be reused by next pipeline execution
+     */
+    virtual void reset() {
+        finishedDependenciesCount = 0;
+        dependencySkipped = false;
+        inputBlobs.clear();
+        conversionCache = nullptr;
+        release();
+    }
+    virtual bool outputsReserveStream() const { return false; }
+
+    /**
+     * @brief Checks if node takes inputs in device memory of remote context, other nodes receive their copies in host memory
+     */
+    virtual bool acceptsRemoteInputs() const { return false; }
     virtual bool tryDisarmStreamIdGuard(const uint microseconds = 1) { return true; }
 
     static void printNodeConnections(const std::string& nodeName, const std::string& sourceNode, const InputPairs& pairs);
+
+private:
+    void addRequiredOutputs(const InputPairs& blobNamesMapping);
+    Status gather(const InferenceEngine::Blob::Ptr& blob, InferenceEngine::Blob::Ptr& gathered, const std::string& inputName) const;
 };
 
 }  // namespace ovms
@@ -0,0 +1,90 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "nodecondition.hpp"
+
+#include <cstdint>
+
+#include "ov_utils.hpp"
+#include "tensorconversion.hpp"
+
+namespace ovms {
+
+namespace {
+
+template <typename T, typename ToFloat>
+size_t countAbove(const InferenceEngine::Blob::Ptr& blob, float minScore, size_t minCount, ToFloat toFloat) {
+    const T* data = blob->cbuffer().as<const T*>();
+    const size_t size = blob->size();
+    size_t count = 0;
+    // stops as soon as condition is met, detections are usually sorted by score
+    for (size_t i = 0; i < size && count < minCount; ++i) {
+        if (toFloat(data[i]) > minScore) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+template <typename T>
+size_t countAbove(const InferenceEngine::Blob::Ptr& blob, float minScore, size_t minCount) {
+    return countAbove<T>(blob, minScore, minCount, [](T value) { return static_cast<float>(value); });
+}
+
+}  // namespace
+
+Status evaluateNodeCondition(const NodeCondition& condition, const InferenceEngine::Blob::Ptr& blob, bool& met) {
+    if (!condition.minScore) {
+        met = blob->size() >= condition.minCount;
+        return StatusCode::OK;
+    }
+    // scores in device memory are mapped to host for reading
+    auto hostBlob = blobToHost(blob);
+    if (hostBlob == nullptr) {
+        return StatusCode::INTERNAL_ERROR;
+    }
+    const float minScore = condition.minScore.value();
+    const size_t minCount = condition.minCount;
+    size_t count = 0;
+    switch (hostBlob->getTensorDesc().getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        count = countAbove<float>(hostBlob, minScore, minCount);
+        break;
+    case InferenceEngine::Precision::FP16:
+        count = countAbove<uint16_t>(hostBlob, minScore, minCount, halfToFloat);
+        break;
+    case InferenceEngine::Precision::I32:
+        count = countAbove<int32_t>(hostBlob, minScore, minCount);
+        break;
+    case InferenceEngine::Precision::I16:
+        count = countAbove<int16_t>(hostBlob, minScore, minCount);
+        break;
+    case InferenceEngine::Precision::U16:
+        count = countAbove<uint16_t>(hostBlob, minScore, minCount);
+        break;
+    case InferenceEngine::Precision::I8:
+        count = countAbove<int8_t>(hostBlob, minScore, minCount);
+        break;
+    case InferenceEngine::Precision::U8:
+        count = countAbove<uint8_t>(hostBlob, minScore, minCount);
+        break;
+    default:
+        return StatusCode::PIPELINE_CONDITION_UNSUPPORTED_PRECISION;
+    }
+    met = count >= minCount;
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
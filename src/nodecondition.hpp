@@ -0,0 +1,47 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include <inference_engine.hpp>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Predicate over an input of pipeline node deciding if the node runs
+ *
+ * Node runs if at least minCount elements of the input are greater than minScore,
+ * without minScore all elements are counted so the node runs if input holds at least minCount elements.
+ */
+struct NodeCondition {
+    std::string inputName;
+    std::optional<float> minScore;
+    size_t minCount = 1;
+};
+
+/**
+ * @brief Evaluates condition on the input blob, supports FP32, FP16 and integer precisions
+ *
+ * @return PIPELINE_CONDITION_UNSUPPORTED_PRECISION if blob elements cannot be compared with min score
+ */
+Status evaluateNodeCondition(const NodeCondition& condition, const InferenceEngine::Blob::Ptr& blob, bool& met);
+
+}  // namespace ovms
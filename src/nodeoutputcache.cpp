@@ -0,0 +1,117 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "nodeoutputcache.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "hash.hpp"
+
+namespace ovms {
+
+namespace {
+template <typename T>
+void hashValue(uint64_t& hash, const T& value) {
+    hash = xxhash64(reinterpret_cast<const char*>(&value), sizeof(value), hash);
+}
+
+void hashString(uint64_t& hash, const std::string& value) {
+    hashValue(hash, value.size());
+    hash = xxhash64(value.data(), value.size(), hash);
+}
+}  // namespace
+
+uint64_t NodeOutputCache::computeKey(const cached_blobs_t& inputs, model_version_t version) {
+    // map iteration order is not defined, inputs are hashed in order of names
+    std::vector<const cached_blobs_t::value_type*> sortedInputs;
+    sortedInputs.reserve(inputs.size());
+    for (const auto& pair : inputs) {
+        sortedInputs.push_back(&pair);
+    }
+    std::sort(sortedInputs.begin(), sortedInputs.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+
+    uint64_t hash = 0;
+    hashValue(hash, version);
+    hashValue(hash, sortedInputs.size());
+    for (const auto* pair : sortedInputs) {
+        const auto& blob = pair->second;
+        const auto& desc = blob->getTensorDesc();
+        hashString(hash, pair->first);
+        hashValue(hash, static_cast<int>(desc.getPrecision()));
+        hashValue(hash, desc.getDims().size());
+        for (const auto dim : desc.getDims()) {
+            hashValue(hash, dim);
+        }
+        hashValue(hash, blob->byteSize());
+        hash = xxhash64(blob->cbuffer().as<const char*>(), blob->byteSize(), hash);
+    }
+    return hash;
+}
+
+std::shared_ptr<const cached_blobs_t> NodeOutputCache::get(uint64_t key, std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entriesByKey.find(key);
+    if (it == entriesByKey.end()) {
+        return nullptr;
+    }
+    if (it->second->expiry <= now) {
+        erase(it->second);
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->outputs;
+}
+
+void NodeOutputCache::put(uint64_t key, std::shared_ptr<const cached_blobs_t> outputs, std::chrono::steady_clock::time_point now) {
+    size_t outputsSize = 0;
+    for (const auto& pair : *outputs) {
+        outputsSize += pair.second->byteSize();
+    }
+    if (outputsSize > maxSizeBytes) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    auto existing = entriesByKey.find(key);
+    if (existing != entriesByKey.end()) {
+        erase(existing->second);
+    }
+    while (!entries.empty() && sizeBytes + outputsSize > maxSizeBytes) {
+        erase(std::prev(entries.end()));
+    }
+    entries.push_front({key, std::move(outputs), outputsSize, now + ttl});
+    entriesByKey[key] = entries.begin();
+    sizeBytes += outputsSize;
+}
+
+void NodeOutputCache::erase(std::list<Entry>::iterator it) {
+    sizeBytes -= it->sizeBytes;
+    entriesByKey.erase(it->key);
+    entries.erase(it);
+}
+
+size_t NodeOutputCache::getSizeBytes() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return sizeBytes;
+}
+
+size_t NodeOutputCache::getEntriesCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+}  // namespace ovms
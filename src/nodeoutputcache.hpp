@@ -0,0 +1,90 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <inference_engine.hpp>
+
+#include "model_version_policy.hpp"
+
+namespace ovms {
+
+using cached_blobs_t = std::unordered_map<std::string, InferenceEngine::Blob::Ptr>;
+
+/**
+ * @brief Least recently used outputs of pipeline nodes running a model version, keyed by hash of node inputs
+ *
+ * Pipelines starting with the same model node on the same inputs reuse its outputs within the lifetime of entries.
+ * Cached blobs are copies owned by the cache and are not modified, so they are handed to nodes without copying.
+ */
+class NodeOutputCache {
+public:
+    NodeOutputCache(size_t maxSizeBytes, std::chrono::milliseconds ttl) :
+        maxSizeBytes(maxSizeBytes),
+        ttl(ttl) {}
+
+    /**
+     * @brief Computes cache key from model version and names, precisions, dimensions and contents of input blobs
+     */
+    static uint64_t computeKey(const cached_blobs_t& inputs, model_version_t version);
+
+    /**
+     * @brief Marks entry as recently used
+     *
+     * @return outputs by model output name or nullptr if there is no valid entry for the key
+     */
+    std::shared_ptr<const cached_blobs_t> get(uint64_t key,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief Caches outputs, evicting least recently used entries to stay within size limit
+     *
+     * Outputs larger than the limit are not cached.
+     */
+    void put(uint64_t key, std::shared_ptr<const cached_blobs_t> outputs,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    size_t getSizeBytes() const;
+    size_t getEntriesCount() const;
+
+private:
+    struct Entry {
+        uint64_t key;
+        std::shared_ptr<const cached_blobs_t> outputs;
+        size_t sizeBytes;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    void erase(std::list<Entry>::iterator it);
+
+    const size_t maxSizeBytes;
+    const std::chrono::milliseconds ttl;
+
+    mutable std::mutex mtx;
+    // most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> entriesByKey;
+    size_t sizeBytes = 0;
+};
+
+}  // namespace ovms
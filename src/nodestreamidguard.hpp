@@ -15,8 +15,9 @@
 //*****************************************************************************
 #pragma once
 
-#include <future>
+#include <functional>
 #include <optional>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 
@@ -25,43 +26,66 @@
 namespace ovms {
 struct NodeStreamIdGuard {
     NodeStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue) :
-        inferRequestsQueue_(inferRequestsQueue),
-        futureStreamId(inferRequestsQueue_.getIdleStream()) {}
+        inferRequestsQueue_(inferRequestsQueue) {}
 
     ~NodeStreamIdGuard() {
-        if (!disarmed) {
-            if (!streamId) {
-                SPDLOG_DEBUG("Trying to disarm stream Id that is not needed anymore...");
-                streamId = futureStreamId.get();
-            }
+        removeListener();
+        if (!disarmed && streamId) {
             SPDLOG_DEBUG("Returning streamId:{}", streamId.value());
             inferRequestsQueue_.returnStream(streamId.value());
         }
     }
 
-    std::optional<int> tryGetId(const uint microseconds = 1) {
-        if (!streamId) {
-            if (std::future_status::ready == futureStreamId.wait_for(std::chrono::microseconds(microseconds))) {
-                streamId = futureStreamId.get();
+    /**
+     * @brief Tries to acquire stream without waiting
+     *
+     * @param onStreamReturned if stream is not acquired, invoked whenever any stream of the model is returned
+     * until stream is acquired or guard is disarmed
+     */
+    std::optional<int> tryGetId(std::function<void()> onStreamReturned = nullptr) {
+        if (!streamId && !disarmed) {
+            streamId = inferRequestsQueue_.tryGetIdleStream();
+            if (!streamId && onStreamReturned && !listenerId) {
+                listenerId = inferRequestsQueue_.addStreamReturnedListener(std::move(onStreamReturned));
+                // stream might have been returned before listener was registered
+                streamId = inferRequestsQueue_.tryGetIdleStream();
+            }
+            if (streamId) {
+                removeListener();
             }
         }
         return streamId;
     }
 
     bool tryDisarm(const uint microseconds = 1) {
-        if (std::future_status::ready == futureStreamId.wait_for(std::chrono::microseconds(microseconds))) {
-            streamId = futureStreamId.get();
-            SPDLOG_DEBUG("Returning streamId:", streamId.value());
+        // stream is not reserved until acquired, so there is nothing to wait for
+        removeListener();
+        if (!disarmed && streamId) {
+            SPDLOG_DEBUG("Returning streamId:{}", streamId.value());
             inferRequestsQueue_.returnStream(streamId.value());
-            disarmed = true;
         }
+        disarmed = true;
         return disarmed;
     }
 
+    /**
+     * @brief Pool the stream is acquired from
+     */
+    ovms::OVInferRequestsQueue& getInferRequestsQueue() {
+        return inferRequestsQueue_;
+    }
+
 private:
+    void removeListener() {
+        if (listenerId) {
+            inferRequestsQueue_.removeStreamReturnedListener(listenerId.value());
+            listenerId.reset();
+        }
+    }
+
     ovms::OVInferRequestsQueue& inferRequestsQueue_;
-    std::future<int> futureStreamId;
     std::optional<int> streamId = std::nullopt;
+    std::optional<uint64_t> listenerId = std::nullopt;
     bool disarmed = false;
 };
 }  // namespace ovms
@@ -0,0 +1,83 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "objectlisting.hpp"
+
+#include <utility>
+
+namespace ovms {
+
+ObjectListing::ObjectListing(const std::string& root, std::set<std::string> objects) :
+    root(removeTrailingSlash(root)),
+    objects(std::move(objects)) {}
+
+std::string ObjectListing::removeTrailingSlash(const std::string& path) {
+    auto end = path.find_last_not_of('/');
+    return end == std::string::npos ? std::string() : path.substr(0, end + 1);
+}
+
+bool ObjectListing::covers(const std::string& path) const {
+    const auto normalized = removeTrailingSlash(path);
+    return normalized == root || normalized.rfind(root + "/", 0) == 0;
+}
+
+bool ObjectListing::exists(const std::string& path) const {
+    return objects.count(removeTrailingSlash(path)) > 0 || isDirectory(path);
+}
+
+bool ObjectListing::isDirectory(const std::string& path) const {
+    const auto prefix = removeTrailingSlash(path) + "/";
+    auto it = objects.lower_bound(prefix);
+    return it != objects.end() && it->rfind(prefix, 0) == 0;
+}
+
+void ObjectListing::getDirectoryEntries(const std::string& path, std::set<std::string>* entries, bool includeFiles, bool includeDirectories) const {
+    const auto prefix = removeTrailingSlash(path) + "/";
+    // objects are sorted, so all objects under the directory follow its prefix
+    for (auto it = objects.lower_bound(prefix); it != objects.end() && it->rfind(prefix, 0) == 0; ++it) {
+        const auto relative = it->substr(prefix.size());
+        if (relative.empty()) {
+            // marker of the directory itself
+            continue;
+        }
+        const auto separator = relative.find('/');
+        const bool isDirectoryEntry = separator != std::string::npos;
+        if ((isDirectoryEntry && includeDirectories) || (!isDirectoryEntry && includeFiles)) {
+            entries->insert(relative.substr(0, separator));
+        }
+    }
+}
+
+void ObjectListing::getDirectoryContents(const std::string& path, std::set<std::string>* contents) const {
+    getDirectoryEntries(path, contents, true, true);
+}
+
+void ObjectListing::getDirectorySubdirs(const std::string& path, std::set<std::string>* subdirs) const {
+    getDirectoryEntries(path, subdirs, false, true);
+}
+
+void ObjectListing::getDirectoryFiles(const std::string& path, std::set<std::string>* files) const {
+    std::set<std::string> entries, subdirs;
+    getDirectoryEntries(path, &entries, true, false);
+    // object with the same name as directory is reported as directory only
+    getDirectorySubdirs(path, &subdirs);
+    for (const auto& entry : entries) {
+        if (subdirs.count(entry) == 0) {
+            files->insert(entry);
+        }
+    }
+}
+
+}  // namespace ovms
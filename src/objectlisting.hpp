@@ -0,0 +1,56 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <set>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Recursive listing of objects under a root path of cloud storage, answers directory queries from memory
+ *
+ * Object storage has no directories, path is a directory if any object is located under it. Objects are identified
+ * by full paths including storage prefix and bucket, object names ending with slash mark empty directories.
+ */
+class ObjectListing {
+public:
+    ObjectListing(const std::string& root, std::set<std::string> objects);
+
+    /**
+     * @brief Checks if path is the root or located under it, only such paths can be queried
+     */
+    bool covers(const std::string& path) const;
+
+    bool exists(const std::string& path) const;
+    bool isDirectory(const std::string& path) const;
+
+    void getDirectoryContents(const std::string& path, std::set<std::string>* contents) const;
+    void getDirectorySubdirs(const std::string& path, std::set<std::string>* subdirs) const;
+    void getDirectoryFiles(const std::string& path, std::set<std::string>* files) const;
+
+    size_t size() const { return objects.size(); }
+
+private:
+    static std::string removeTrailingSlash(const std::string& path);
+
+    void getDirectoryEntries(const std::string& path, std::set<std::string>* entries, bool includeFiles, bool includeDirectories) const;
+
+    const std::string root;
+    const std::set<std::string> objects;
+};
+
+}  // namespace ovms
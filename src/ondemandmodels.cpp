@@ -0,0 +1,92 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "ondemandmodels.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <spdlog/spdlog.h>
+
+#include "modelinstance.hpp"
+
+namespace ovms {
+
+void OnDemandModels::setMemoryBudget(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mtx);
+    memoryBudget = bytes;
+}
+
+void OnDemandModels::makeRoom(const ModelInstance& instance, uint64_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (memoryBudget == 0) {
+        return;
+    }
+    uint64_t used = 0;
+    for (const auto* loadedInstance : loaded) {
+        used += loadedInstance->getEstimatedMemoryBytes();
+    }
+    std::vector<ModelInstance*> candidates(loaded);
+    std::sort(candidates.begin(), candidates.end(), [](const ModelInstance* lhs, const ModelInstance* rhs) {
+        return lhs->getLastUsedMicroseconds() < rhs->getLastUsedMicroseconds();
+    });
+    for (auto* candidate : candidates) {
+        if (used + size <= memoryBudget) {
+            break;
+        }
+        // size is taken before eviction, tryEvict clears blob bytes the estimate includes
+        const uint64_t candidateBytes = candidate->getEstimatedMemoryBytes();
+        if (candidate == &instance || !candidate->tryEvict()) {
+            continue;
+        }
+        spdlog::info("Unloaded model: {}; version: {} loaded on demand to fit memory budget", candidate->getName(), candidate->getVersion());
+        used -= candidateBytes;
+        loaded.erase(std::find(loaded.begin(), loaded.end(), candidate));
+    }
+    if (used + size > memoryBudget) {
+        spdlog::warn("Memory budget of models loaded on demand is exceeded by loading model: {}; version: {}", instance.getName(), instance.getVersion());
+    }
+}
+
+void OnDemandModels::registerLoaded(ModelInstance& instance) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (std::find(loaded.begin(), loaded.end(), &instance) == loaded.end()) {
+        loaded.push_back(&instance);
+    }
+}
+
+void OnDemandModels::unregister(const ModelInstance& instance) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loaded.erase(std::remove(loaded.begin(), loaded.end(), &instance), loaded.end());
+}
+
+void OnDemandModels::evictIdle() {
+    std::lock_guard<std::mutex> lock(mtx);
+    const int64_t now = ModelInstance::getSteadyClockMicroseconds();
+    for (auto it = loaded.begin(); it != loaded.end();) {
+        auto* instance = *it;
+        const uint64_t idleUnloadSeconds = instance->getIdleUnloadSeconds();
+        const auto idle = std::chrono::microseconds(now - instance->getLastUsedMicroseconds());
+        if (idleUnloadSeconds == 0 || idle < std::chrono::seconds(idleUnloadSeconds) || !instance->tryEvict()) {
+            ++it;
+            continue;
+        }
+        spdlog::info("Unloaded model: {}; version: {} loaded on demand after {} seconds without requests",
+            instance->getName(), instance->getVersion(), std::chrono::duration_cast<std::chrono::seconds>(idle).count());
+        it = loaded.erase(it);
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,66 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace ovms {
+
+class ModelInstance;
+
+/**
+ * @brief Tracks model versions compiled on demand, so these can be unloaded when idle or when memory budget is exceeded
+ *
+ * Memory used by a version is measured when it is loaded, and estimated with the size of its model files before its first
+ * load. Versions are evicted in least recently used order, versions in use or busy with loading are skipped.
+ */
+class OnDemandModels {
+public:
+    static OnDemandModels& getInstance() {
+        // never destroyed, model instances unregister from it during static destruction
+        static OnDemandModels* instance = new OnDemandModels();
+        return *instance;
+    }
+
+    /**
+     * @brief Sets memory budget of versions loaded on demand in bytes, 0 means no limit
+     */
+    void setMemoryBudget(uint64_t bytes);
+
+    /**
+     * @brief Evicts least recently used versions until version of given size fits into memory budget
+     */
+    void makeRoom(const ModelInstance& instance, uint64_t size);
+
+    void registerLoaded(ModelInstance& instance);
+    void unregister(const ModelInstance& instance);
+
+    /**
+     * @brief Evicts versions which did not receive requests for longer than their idle unload time
+     */
+    void evictIdle();
+
+private:
+    OnDemandModels() = default;
+
+    std::mutex mtx;
+    std::vector<ModelInstance*> loaded;
+    uint64_t memoryBudget = 0;
+};
+
+}  // namespace ovms
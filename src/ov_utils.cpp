@@ -15,13 +15,91 @@
 //*****************************************************************************
 #include "ov_utils.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <numeric>
+#include <utility>
+
+#include "metrics.hpp"
+#include "tensorbufferpool.hpp"
 
 namespace ovms {
 
+static_assert(CONTENT_ALIGNMENT == TensorBufferPool::ALIGNMENT, "realigned content is allocated from the pool");
+
+namespace {
+
+class TensorBufferAllocator : public InferenceEngine::IAllocator {
+public:
+    void* lock(void* handle, InferenceEngine::LockOp) noexcept override {
+        return handle;
+    }
+
+    void unlock(void*) noexcept override {}
+
+    void* alloc(size_t size) noexcept override {
+        return TensorBufferPool::getInstance().allocate(size);
+    }
+
+    bool free(void* handle) noexcept override {
+        TensorBufferPool::getInstance().release(handle);
+        return true;
+    }
+
+    // lifetime is managed by shared pointer
+    void Release() noexcept override {}
+};
+
+template <typename T>
+InferenceEngine::Blob::Ptr makePooledBlob(const InferenceEngine::TensorDesc& tensorDesc) {
+    auto blob = InferenceEngine::make_shared_blob<T>(tensorDesc, getTensorBufferAllocator());
+    blob->allocate();
+    return blob;
+}
+
+}  // namespace
+
+const std::shared_ptr<InferenceEngine::IAllocator>& getTensorBufferAllocator() {
+    // blobs may be released during destruction of other static objects
+    static auto* allocator = new std::shared_ptr<InferenceEngine::IAllocator>(std::make_shared<TensorBufferAllocator>());
+    return *allocator;
+}
+
+InferenceEngine::Blob::Ptr blobAllocate(const InferenceEngine::TensorDesc& tensorDesc) {
+    switch (tensorDesc.getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        return makePooledBlob<float>(tensorDesc);
+    case InferenceEngine::Precision::I32:
+        return makePooledBlob<int32_t>(tensorDesc);
+    case InferenceEngine::Precision::I64:
+        return makePooledBlob<int64_t>(tensorDesc);
+    case InferenceEngine::Precision::U64:
+        return makePooledBlob<uint64_t>(tensorDesc);
+    case InferenceEngine::Precision::FP16:
+    case InferenceEngine::Precision::I16:
+        return makePooledBlob<int16_t>(tensorDesc);
+    case InferenceEngine::Precision::U16:
+        return makePooledBlob<uint16_t>(tensorDesc);
+    case InferenceEngine::Precision::I8:
+        return makePooledBlob<int8_t>(tensorDesc);
+    case InferenceEngine::Precision::U8:
+    case InferenceEngine::Precision::BOOL:
+        return makePooledBlob<uint8_t>(tensorDesc);
+    default: {
+        auto blob = InferenceEngine::Blob::CreateFromData(std::make_shared<InferenceEngine::Data>("", tensorDesc));
+        blob->allocate();
+        return blob;
+    }
+    }
+}
+
 InferenceEngine::Blob::Ptr blobClone(const InferenceEngine::Blob::Ptr sourceBlob) {
-    auto copyBlob = InferenceEngine::Blob::CreateFromData(std::make_shared<InferenceEngine::Data>("", sourceBlob->getTensorDesc()));
-    copyBlob->allocate();
+    if (isRemoteBlob(sourceBlob)) {
+        return blobToHost(sourceBlob);
+    }
+    auto copyBlob = blobAllocate(sourceBlob->getTensorDesc());
     if (copyBlob->byteSize() != sourceBlob->byteSize()) {
         return nullptr;
     }
@@ -29,4 +107,78 @@ InferenceEngine::Blob::Ptr blobClone(const InferenceEngine::Blob::Ptr sourceBlob
     return copyBlob;
 }
 
+bool isRemoteBlob(const InferenceEngine::Blob::Ptr& blob) {
+    return blob != nullptr && blob->is<InferenceEngine::RemoteBlob>();
+}
+
+InferenceEngine::Blob::Ptr blobToHost(const InferenceEngine::Blob::Ptr& blob) {
+    if (!isRemoteBlob(blob)) {
+        return blob;
+    }
+    auto hostBlob = blobAllocate(blob->getTensorDesc());
+    if (hostBlob == nullptr || hostBlob->byteSize() != blob->byteSize()) {
+        return nullptr;
+    }
+    // device memory is mapped to host only while it is read
+    auto mapped = blob->as<InferenceEngine::MemoryBlob>()->rmap();
+    std::memcpy(hostBlob->buffer().as<void*>(), mapped.as<const void*>(), blob->byteSize());
+    return hostBlob;
+}
+
+namespace {
+
+template <typename T>
+InferenceEngine::Blob::Ptr makeBlobOnExternalMemory(const InferenceEngine::TensorDesc& tensorDesc, void* data, std::shared_ptr<void> memoryOwner) {
+    InferenceEngine::Blob::Ptr blob = InferenceEngine::make_shared_blob<T>(tensorDesc, static_cast<T*>(data));
+    // blob does not own its memory, returned pointer keeps memory owner alive together with the blob
+    auto owner = std::make_shared<std::pair<std::shared_ptr<void>, InferenceEngine::Blob::Ptr>>(std::move(memoryOwner), blob);
+    return InferenceEngine::Blob::Ptr(owner, blob.get());
+}
+
+}  // namespace
+
+InferenceEngine::Blob::Ptr blobOnExternalMemory(const InferenceEngine::TensorDesc& tensorDesc, void* data, std::shared_ptr<void> memoryOwner) {
+    switch (tensorDesc.getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        return makeBlobOnExternalMemory<float>(tensorDesc, data, std::move(memoryOwner));
+    case InferenceEngine::Precision::I32:
+        return makeBlobOnExternalMemory<int32_t>(tensorDesc, data, std::move(memoryOwner));
+    case InferenceEngine::Precision::I64:
+        return makeBlobOnExternalMemory<int64_t>(tensorDesc, data, std::move(memoryOwner));
+    case InferenceEngine::Precision::U64:
+        return makeBlobOnExternalMemory<uint64_t>(tensorDesc, data, std::move(memoryOwner));
+    case InferenceEngine::Precision::FP16:
+    case InferenceEngine::Precision::I16:
+        return makeBlobOnExternalMemory<int16_t>(tensorDesc, data, std::move(memoryOwner));
+    case InferenceEngine::Precision::U16:
+        return makeBlobOnExternalMemory<uint16_t>(tensorDesc, data, std::move(memoryOwner));
+    case InferenceEngine::Precision::I8:
+        return makeBlobOnExternalMemory<int8_t>(tensorDesc, data, std::move(memoryOwner));
+    case InferenceEngine::Precision::U8:
+    case InferenceEngine::Precision::BOOL:
+        return makeBlobOnExternalMemory<uint8_t>(tensorDesc, data, std::move(memoryOwner));
+    default:
+        return nullptr;
+    }
+}
+
+InferenceEngine::Blob::Ptr blobRealignedFromContent(const InferenceEngine::TensorDesc& tensorDesc, const std::string& content) {
+    static Counter& realigned = MetricsRegistry::getInstance().counter("ovms_realigned_tensor_contents_total",
+        "Pipeline inputs copied to aligned buffers because their tensor content was misaligned");
+    auto blob = blobAllocate(tensorDesc);
+    std::memcpy(blob->buffer().as<char*>(), content.data(), std::min(blob->byteSize(), content.size()));
+    realigned.increment();
+    return blob;
+}
+
+InferenceEngine::Blob::Ptr blobReshapedView(const InferenceEngine::Blob::Ptr& sourceBlob, const InferenceEngine::SizeVector& dims) {
+    const auto& sourceDims = sourceBlob->getTensorDesc().getDims();
+    if (std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<size_t>()) !=
+        std::accumulate(sourceDims.begin(), sourceDims.end(), size_t(1), std::multiplies<size_t>())) {
+        return nullptr;
+    }
+    InferenceEngine::TensorDesc tensorDesc(sourceBlob->getTensorDesc().getPrecision(), dims, InferenceEngine::TensorDesc::getLayoutByDims(dims));
+    return blobOnExternalMemory(tensorDesc, sourceBlob->buffer().as<void*>(), sourceBlob);
+}
+
 }  // namespace ovms
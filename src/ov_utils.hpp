@@ -15,10 +15,75 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
 #include <inference_engine.hpp>
 
 namespace ovms {
 
+/**
+ * @brief Allocator of blob memory from TensorBufferPool, shared by all pooled blobs
+ */
+const std::shared_ptr<InferenceEngine::IAllocator>& getTensorBufferAllocator();
+
+/**
+ * @brief Creates blob with memory allocated from TensorBufferPool
+ *
+ * Blobs of precisions without typed blob are allocated by default allocator.
+ */
+InferenceEngine::Blob::Ptr blobAllocate(const InferenceEngine::TensorDesc& tensorDesc);
+
 InferenceEngine::Blob::Ptr blobClone(const InferenceEngine::Blob::Ptr sourceBlob);
 
+/**
+ * @brief Tensor content of at least this size at address not aligned to TensorBufferPool::ALIGNMENT is copied, smaller is wrapped as it is
+ */
+const size_t CONTENT_REALIGNMENT_MIN_BYTES = 64 * 1024;
+// same as TensorBufferPool::ALIGNMENT, cache line and AVX-512 vector size
+const size_t CONTENT_ALIGNMENT = 64;
+
+/**
+ * @brief Checks if blob of pipeline entry node should not be created directly on tensor content of request
+ *
+ * Protobuf strings are only 16 byte aligned by malloc. Plugins copy large inputs at misaligned address internally
+ * or read them in unaligned loops, so these are copied to aligned buffer once instead.
+ */
+inline bool contentRequiresRealignment(const std::string& content) {
+    return content.size() >= CONTENT_REALIGNMENT_MIN_BYTES && reinterpret_cast<uintptr_t>(content.data()) % CONTENT_ALIGNMENT != 0;
+}
+
+/**
+ * @brief Copies tensor content to pooled blob, which is aligned to TensorBufferPool::ALIGNMENT
+ */
+InferenceEngine::Blob::Ptr blobRealignedFromContent(const InferenceEngine::TensorDesc& tensorDesc, const std::string& content);
+
+/**
+ * @brief Checks if blob is in device memory of remote context
+ */
+bool isRemoteBlob(const InferenceEngine::Blob::Ptr& blob);
+
+/**
+ * @brief Copies blob in device memory of remote context to host memory, other blobs are returned as these are
+ *
+ * @return nullptr if blob cannot be copied
+ */
+InferenceEngine::Blob::Ptr blobToHost(const InferenceEngine::Blob::Ptr& blob);
+
+/**
+ * @brief Creates blob on memory it does not own, memoryOwner is kept alive as long as the blob is used
+ *
+ * @return nullptr if precision is not supported
+ */
+InferenceEngine::Blob::Ptr blobOnExternalMemory(const InferenceEngine::TensorDesc& tensorDesc, void* data, std::shared_ptr<void> memoryOwner);
+
+/**
+ * @brief Creates blob with different dimensions sharing memory and ownership of source blob
+ *
+ * @return nullptr if element count differs or precision is not supported
+ */
+InferenceEngine::Blob::Ptr blobReshapedView(const InferenceEngine::Blob::Ptr& sourceBlob, const InferenceEngine::SizeVector& dims);
+
 }  // namespace ovms
@@ -16,43 +16,302 @@
 
 #include "ovinferrequestsqueue.hpp"
 
-#include <utility>
-
 namespace ovms {
-std::future<int> OVInferRequestsQueue::getIdleStream() {
-    int value;
-    std::promise<int> idleStreamPromise;
-    std::future<int> idleStreamFuture = idleStreamPromise.get_future();
-    std::unique_lock<std::mutex> lk(front_mut);
-    if (streams[front_idx] < 0) {  // we need to wait for any idle stream to be returned
-        std::unique_lock<std::mutex> queueLock(queue_mutex);
-        promises.push(std::move(idleStreamPromise));
-    } else {  // we can give idle stream right away
-        value = streams[front_idx];
-        streams[front_idx] = -1;  // negative value indicate consumed vector index
-        front_idx = (front_idx + 1) % streams.size();
-        lk.unlock();
-        idleStreamPromise.set_value(value);
-    }
-    return std::move(idleStreamFuture);
+bool OVInferRequestsQueue::tryPop(int& streamId, size_t keepIdle) {
+    // idle stream is claimed first, so low priority requests cannot take streams reserved for high priority
+    size_t idle = idleStreams.load(std::memory_order_relaxed);
+    do {
+        if (idle <= keepIdle) {
+            return false;
+        }
+    } while (!idleStreams.compare_exchange_weak(idle, idle - 1, std::memory_order_acquire, std::memory_order_relaxed));
+    // claimed stream is pushed already, its cell might be behind cells of other producers still writing
+    while (!tryPopCell(streamId)) {
+        std::this_thread::yield();
+    }
+    return true;
 }
 
-void OVInferRequestsQueue::returnStream(int streamID) {
-    std::unique_lock<std::mutex> lk(queue_mutex);
-    if (promises.size()) {
-        std::promise<int> promise = std::move(promises.front());
-        promises.pop();
-        lk.unlock();
-        promise.set_value(streamID);
+bool OVInferRequestsQueue::tryPopCell(int& streamId) {
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[position & (capacity - 1)];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+        if (difference == 0) {
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                streamId = cell.streamId;
+                cell.sequence.store(position + capacity, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;  // no idle stream
+        } else {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void OVInferRequestsQueue::push(int streamId) {
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[position & (capacity - 1)];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.streamId = streamId;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                idleStreams.fetch_add(1, std::memory_order_release);
+                return;
+            }
+        } else {
+            // buffer cannot be full since it holds at most all streams, other producer advanced
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool OVInferRequestsQueue::tryPopAndRecord(int& streamId, size_t keepIdle) {
+    if (!tryPop(streamId, keepIdle)) {
+        return false;
+    }
+    if (metrics != nullptr) {
+        metrics->streamsInUse.increment();
+        metrics->acquisition.observe(0);
+    }
+    return true;
+}
+
+void OVInferRequestsQueue::recordWaitStarted() {
+    if (metrics != nullptr) {
+        metrics->waiters.increment();
+    }
+}
+
+void OVInferRequestsQueue::recordWaitFinished(std::chrono::steady_clock::time_point start, bool acquired) {
+    if (metrics == nullptr) {
         return;
     }
-    std::uint32_t old_back = back_idx.load();
-    while (!back_idx.compare_exchange_weak(
-        old_back,
-        (old_back + 1) % streams.size(),
-        std::memory_order_relaxed)) {
+    metrics->waiters.decrement();
+    if (acquired) {
+        metrics->streamsInUse.increment();
+        metrics->acquisition.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+int OVInferRequestsQueue::getIdleStream() {
+    int streamId;
+    if (tryPopAndRecord(streamId)) {
+        return streamId;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    recordWaitStarted();
+    for (uint i = 1; i < IDLE_STREAM_SPIN_COUNT; ++i) {
+        std::this_thread::yield();
+        if (tryPop(streamId)) {
+            recordWaitFinished(start, true);
+            return streamId;
+        }
+    }
+    std::unique_lock<std::mutex> lk(parkMutex);
+    parkedWaiters.fetch_add(1, std::memory_order_seq_cst);
+    streamReturned.wait(lk, [this, &streamId]() { return tryPop(streamId); });
+    parkedWaiters.fetch_sub(1, std::memory_order_seq_cst);
+    lk.unlock();
+    recordWaitFinished(start, true);
+    return streamId;
+}
+
+std::optional<int> OVInferRequestsQueue::tryGetIdleStream(const std::chrono::microseconds timeout, RequestPriority priority) {
+    return waitForIdleStream(timeout, priority);
+}
+
+std::optional<int> OVInferRequestsQueue::waitForIdleStream(const std::optional<std::chrono::microseconds> timeout, RequestPriority priority) {
+    const size_t keepIdle = priority == RequestPriority::LOW ? reservedHighPriorityStreams : 0;
+    int streamId;
+    if (tryPopAndRecord(streamId, keepIdle)) {
+        return streamId;
+    }
+    if (timeout.has_value() && timeout.value().count() == 0) {
+        return std::nullopt;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    recordWaitStarted();
+    // low priority waiters park separately, so returned stream they cannot take does not miss waiting high priority request
+    auto& waiters = priority == RequestPriority::LOW ? parkedLowPriorityWaiters : parkedWaiters;
+    auto& returned = priority == RequestPriority::LOW ? lowPriorityStreamReturned : streamReturned;
+    std::unique_lock<std::mutex> lk(parkMutex);
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    auto acquire = [this, &streamId, keepIdle]() { return tryPop(streamId, keepIdle); };
+    bool acquired = true;
+    if (timeout.has_value()) {
+        acquired = returned.wait_for(lk, timeout.value(), acquire);
+    } else {
+        returned.wait(lk, acquire);
+    }
+    waiters.fetch_sub(1, std::memory_order_seq_cst);
+    lk.unlock();
+    recordWaitFinished(start, acquired);
+    if (!acquired) {
+        return std::nullopt;
+    }
+    return streamId;
+}
+
+Status OVInferRequestsQueue::getIdleStreamWithinQueueLimits(int& streamId,
+    const std::optional<std::chrono::steady_clock::time_point>& deadline, RequestPriority priority) {
+    const auto start = std::chrono::steady_clock::now();
+    if (deadline.has_value() && start >= deadline.value()) {
+        return StatusCode::DEADLINE_EXCEEDED;
+    }
+    const bool lowPriority = priority == RequestPriority::LOW;
+    if (tryPopAndRecord(streamId, lowPriority ? reservedHighPriorityStreams : 0)) {
+        return StatusCode::OK;
+    }
+    const size_t depth = queueDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (maxQueueSize > 0 && depth > maxQueueSize) {
+        queueDepth.fetch_sub(1, std::memory_order_relaxed);
+        rejectedQueueFull.fetch_add(1, std::memory_order_relaxed);
+        if (metrics != nullptr) {
+            metrics->rejectedQueueFull.increment();
+        }
+        return StatusCode::REQUEST_QUEUE_FULL;
+    }
+    if (lowPriority) {
+        const size_t lowPriorityDepth = lowPriorityQueueDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (maxLowPriorityQueueSize > 0 && lowPriorityDepth > maxLowPriorityQueueSize) {
+            lowPriorityQueueDepth.fetch_sub(1, std::memory_order_relaxed);
+            queueDepth.fetch_sub(1, std::memory_order_relaxed);
+            rejectedQueueFull.fetch_add(1, std::memory_order_relaxed);
+            if (metrics != nullptr) {
+                metrics->rejectedQueueFull.increment();
+            }
+            return StatusCode::REQUEST_QUEUE_FULL;
+        }
+    }
+    if (metrics != nullptr) {
+        metrics->queueDepth.increment();
+    }
+    std::optional<std::chrono::microseconds> waitLimit;
+    if (maxQueueTime.count() > 0) {
+        waitLimit = maxQueueTime;
+    }
+    bool limitedByDeadline = false;
+    if (deadline.has_value()) {
+        // rounded up, so waiting does not end right before the deadline
+        auto untilDeadline = std::chrono::ceil<std::chrono::microseconds>(deadline.value() - start);
+        if (!waitLimit.has_value() || untilDeadline < waitLimit.value()) {
+            waitLimit = untilDeadline;
+            limitedByDeadline = true;
+        }
+    }
+    bool acquired = true;
+    if (waitLimit.has_value() || lowPriority) {
+        auto acquiredStreamId = waitForIdleStream(waitLimit, priority);
+        acquired = acquiredStreamId.has_value();
+        if (acquired) {
+            streamId = acquiredStreamId.value();
+        }
+    } else {
+        streamId = getIdleStream();
+    }
+    if (lowPriority) {
+        lowPriorityQueueDepth.fetch_sub(1, std::memory_order_relaxed);
+    }
+    queueDepth.fetch_sub(1, std::memory_order_relaxed);
+    queuedRequests.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t waitedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    totalQueueWaitMicroseconds.fetch_add(waitedMicroseconds, std::memory_order_relaxed);
+    if (metrics != nullptr) {
+        metrics->queueDepth.decrement();
+        metrics->queuedRequests.increment();
+        metrics->queueWaitMicroseconds.increment(waitedMicroseconds);
+    }
+    if (!acquired) {
+        if (limitedByDeadline) {
+            return StatusCode::DEADLINE_EXCEEDED;
+        }
+        rejectedQueueTimeout.fetch_add(1, std::memory_order_relaxed);
+        if (metrics != nullptr) {
+            metrics->rejectedQueueTimeout.increment();
+        }
+        return StatusCode::REQUEST_QUEUE_TIMEOUT;
+    }
+    return StatusCode::OK;
+}
+
+InferRequestsQueueStatistics OVInferRequestsQueue::getStatistics() const {
+    InferRequestsQueueStatistics statistics;
+    statistics.queueDepth = queueDepth.load(std::memory_order_relaxed);
+    statistics.queuedRequests = queuedRequests.load(std::memory_order_relaxed);
+    statistics.rejectedQueueFull = rejectedQueueFull.load(std::memory_order_relaxed);
+    statistics.rejectedQueueTimeout = rejectedQueueTimeout.load(std::memory_order_relaxed);
+    statistics.totalQueueWaitMicroseconds = totalQueueWaitMicroseconds.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void OVInferRequestsQueue::recordInferenceLatency(std::chrono::microseconds latency) {
+    const uint64_t sample = std::max<int64_t>(1, latency.count());
+    const uint64_t average = averageInferenceLatencyMicroseconds.load(std::memory_order_relaxed);
+    // concurrent updates may drop a sample, estimate tolerates that
+    const uint64_t updated = average == 0 ? sample : average - average / INFERENCE_LATENCY_SMOOTHING + sample / INFERENCE_LATENCY_SMOOTHING;
+    averageInferenceLatencyMicroseconds.store(std::max<uint64_t>(1, updated), std::memory_order_relaxed);
+}
+
+std::chrono::microseconds OVInferRequestsQueue::estimateCompletionTime() const {
+    const size_t streams = inferRequests.size();
+    if (streams == 0) {
+        return std::chrono::microseconds::max();
+    }
+    const size_t idle = std::min(idleStreams.load(std::memory_order_relaxed), streams);
+    const size_t pending = (streams - idle) + queueDepth.load(std::memory_order_relaxed) + 1;
+    const uint64_t average = averageInferenceLatencyMicroseconds.load(std::memory_order_relaxed);
+    return std::chrono::microseconds(average * pending / streams);
+}
+
+size_t OVInferRequestsQueue::getBusyStreamsCount() const {
+    const size_t streams = inferRequests.size();
+    const size_t idle = std::min(idleStreams.load(std::memory_order_relaxed), streams);
+    return (streams - idle) + queueDepth.load(std::memory_order_relaxed);
+}
+
+uint64_t OVInferRequestsQueue::addStreamReturnedListener(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lk(parkMutex);
+    uint64_t listenerId = nextListenerId++;
+    streamReturnedListeners.emplace(listenerId, std::move(callback));
+    listenersCount.fetch_add(1, std::memory_order_seq_cst);
+    return listenerId;
+}
+
+void OVInferRequestsQueue::removeStreamReturnedListener(uint64_t listenerId) {
+    std::lock_guard<std::mutex> lk(parkMutex);
+    if (streamReturnedListeners.erase(listenerId) > 0) {
+        listenersCount.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+void OVInferRequestsQueue::returnStream(int streamID) {
+    if (metrics != nullptr) {
+        metrics->streamsInUse.decrement();
+    }
+    push(streamID);
+    // pairs with increment of parkedWaiters or listenersCount before waiter rechecks the buffer
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool hasListeners = listenersCount.load(std::memory_order_seq_cst) > 0;
+    const bool hasLowPriorityWaiters = parkedLowPriorityWaiters.load(std::memory_order_seq_cst) > 0;
+    if (parkedWaiters.load(std::memory_order_seq_cst) > 0 || hasLowPriorityWaiters || hasListeners) {
+        std::lock_guard<std::mutex> lk(parkMutex);
+        streamReturned.notify_one();
+        // woken low priority waiter parks again if stream is left for high priority
+        if (hasLowPriorityWaiters) {
+            lowPriorityStreamReturned.notify_one();
+        }
+        // invoked under parkMutex so listener cannot be removed while running
+        for (auto& listener : streamReturnedListeners) {
+            listener.second();
+        }
     }
-    streams[old_back] = streamID;
 }
 
 }  // namespace ovms
@@ -15,27 +15,116 @@
 //*****************************************************************************
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <future>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <inference_engine.hpp>
 #include <spdlog/spdlog.h>
 
+#include "modelmetrics.hpp"
+#include "ov_utils.hpp"
+#include "status.hpp"
+
 namespace ovms {
+
+/**
+* @brief Priority class of a predict request waiting for idle stream
+*/
+enum class RequestPriority {
+    HIGH,
+    LOW /*!< cannot take streams reserved for high priority requests */
+};
+
+/**
+* @brief Snapshot of request queue counters of a single model instance
+*/
+struct InferRequestsQueueStatistics {
+    size_t queueDepth = 0;
+    uint64_t queuedRequests = 0;
+    uint64_t rejectedQueueFull = 0;
+    uint64_t rejectedQueueTimeout = 0;
+    uint64_t totalQueueWaitMicroseconds = 0;
+};
+
 /**
-* @brief Class representing circular buffer for managing IE streams
+* @brief Class representing lock-free bounded MPMC pool of idle IE streams
+*
+* Acquisition spins for a bounded number of attempts and then parks on condition variable
+* until any stream is returned. No allocation is done per acquisition.
 */
 class OVInferRequestsQueue {
 public:
     /**
-    * @brief Allocating idle stream for execution
+    * @brief Allocating idle stream for execution, blocks until any stream is idle
+    */
+    int getIdleStream();
+
+    /**
+    * @brief Tries to allocate idle stream for execution waiting at most timeout, low priority leaves reserved streams idle
+    */
+    std::optional<int> tryGetIdleStream(const std::chrono::microseconds timeout = std::chrono::microseconds(0),
+        RequestPriority priority = RequestPriority::HIGH);
+
+    /**
+    * @brief Allocating idle stream for a predict request, applying admission limits
+    *
+    * Requests which find no idle stream are queued. Request is rejected right away when queue already
+    * holds max queue size requests, or when it waits for a stream longer than max queue time.
+    * Request with client deadline does not wait past it. Low priority requests leave reserved streams idle
+    * and are rejected when max low priority queue size of them is already queued.
+    *
+    * @return REQUEST_QUEUE_FULL, REQUEST_QUEUE_TIMEOUT, DEADLINE_EXCEEDED or OK with streamId set
+    */
+    Status getIdleStreamWithinQueueLimits(int& streamId,
+        const std::optional<std::chrono::steady_clock::time_point>& deadline = std::nullopt,
+        RequestPriority priority = RequestPriority::HIGH);
+
+    /**
+    * @brief Registers callback invoked on every stream return until it is removed
+    *
+    * Callback is invoked from thread returning the stream, it should only signal the waiting side.
+    * Caller should retry acquisition after registering, stream might have been returned in between.
+    *
+    * @return listener id used for removal
+    */
+    uint64_t addStreamReturnedListener(std::function<void()> callback);
+
+    /**
+    * @brief Removes listener, callback is not invoked after this call returns
+    */
+    void removeStreamReturnedListener(uint64_t listenerId);
+
+    /**
+    * @brief Gives current values of request queue counters of this queue, also added to metrics of the model version
+    */
+    InferRequestsQueueStatistics getStatistics() const;
+
+    /**
+    * @brief Updates moving average of inference latency used to estimate load of the pool
+    */
+    void recordInferenceLatency(std::chrono::microseconds latency);
+
+    /**
+    * @brief Estimates time to complete request submitted now, from busy streams, queued requests and average latency
+    *
+    * Gives 0 until any latency is recorded, so pool which was not measured yet receives requests.
     */
-    std::future<int> getIdleStream();
+    std::chrono::microseconds estimateCompletionTime() const;
+
+    /**
+    * @brief Gives number of streams running inference and requests waiting for them
+    */
+    size_t getBusyStreamsCount() const;
 
     /**
     * @brief Release stream after execution
@@ -44,14 +133,51 @@ public:
 
     /**
     * @brief Constructor with initialization
+    *
+    * Utilization is reported to metrics if these are not null, metrics must outlive the queue.
+    * Reserved high priority streams are limited to all streams but one, so low priority requests can progress.
     */
-    OVInferRequestsQueue(InferenceEngine::ExecutableNetwork& network, int streamsLength) :
-        streams(streamsLength),
-        front_idx{0},
-        back_idx{0} {
+    OVInferRequestsQueue(InferenceEngine::ExecutableNetwork& network, int streamsLength,
+        size_t maxQueueSize = 0, std::chrono::microseconds maxQueueTime = std::chrono::microseconds(0),
+        InferRequestsQueueMetrics* metrics = nullptr, size_t reservedHighPriorityStreams = 0, size_t maxLowPriorityQueueSize = 0) :
+        maxQueueSize(maxQueueSize),
+        maxQueueTime(maxQueueTime),
+        reservedHighPriorityStreams(std::min<size_t>(reservedHighPriorityStreams, streamsLength > 0 ? streamsLength - 1 : 0)),
+        maxLowPriorityQueueSize(maxLowPriorityQueueSize),
+        metrics(metrics),
+        capacity(roundUpToPowerOfTwo(streamsLength)),
+        cells(std::make_unique<Cell[]>(capacity)),
+        enqueuePosition(0),
+        dequeuePosition(0),
+        idleStreams(0),
+        parkedWaiters(0),
+        parkedLowPriorityWaiters(0),
+        listenersCount(0),
+        queueDepth(0),
+        lowPriorityQueueDepth(0),
+        queuedRequests(0),
+        rejectedQueueFull(0),
+        rejectedQueueTimeout(0),
+        totalQueueWaitMicroseconds(0),
+        averageInferenceLatencyMicroseconds(0) {
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
         for (int i = 0; i < streamsLength; ++i) {
-            streams[i] = i;
             inferRequests.push_back(network.CreateInferRequest());
+            InferenceEngine::BlobMap blobs;
+            for (const auto& input : network.GetInputsInfo()) {
+                blobs[input.first] = inferRequests.back().GetBlob(input.first);
+                blobsByteSize += blobs[input.first]->byteSize();
+            }
+            InferenceEngine::BlobMap outputBlobs;
+            for (const auto& output : network.GetOutputsInfo()) {
+                outputBlobs[output.first] = inferRequests.back().GetBlob(output.first);
+                blobsByteSize += outputBlobs[output.first]->byteSize();
+            }
+            preallocatedInputBlobs.push_back(std::move(blobs));
+            preallocatedOutputBlobs.push_back(std::move(outputBlobs));
+            push(i);
         }
     }
 
@@ -62,31 +188,216 @@ public:
         return inferRequests[streamID];
     }
 
+    /**
+     * @brief Give input blobs allocated by the plugin when InferRequest was created
+     */
+    const InferenceEngine::BlobMap& getPreallocatedInputBlobs(int streamID) const {
+        return preallocatedInputBlobs[streamID];
+    }
+
+    /**
+     * @brief Replaces input blobs allocated by the plugin with blobs of other shape, e.g. of frames resized by plugin
+     */
+    void preallocateInputBlobs(const std::string& name, const InferenceEngine::TensorDesc& tensorDesc) {
+        for (size_t i = 0; i < inferRequests.size(); ++i) {
+            auto blob = blobAllocate(tensorDesc);
+            inferRequests[i].SetBlob(name, blob);
+            blobsByteSize = blobsByteSize - preallocatedInputBlobs[i][name]->byteSize() + blob->byteSize();
+            preallocatedInputBlobs[i][name] = std::move(blob);
+        }
+    }
+
+    /**
+     * @brief Give output blobs allocated by the plugin when InferRequest was created
+     */
+    const InferenceEngine::BlobMap& getPreallocatedOutputBlobs(int streamID) const {
+        return preallocatedOutputBlobs[streamID];
+    }
+
+    /**
+     * @brief Allocates output blobs of every infer request in device memory of the context of its network
+     *
+     * Blobs are not set on infer requests, pipeline nodes set them for inference so that following nodes
+     * on the same device read outputs without copying them to host.
+     */
+    void allocateRemoteOutputBlobs(const InferenceEngine::RemoteContext::Ptr& context) {
+        remoteContext = context;
+        remoteOutputBlobs.clear();
+        for (const auto& outputBlobs : preallocatedOutputBlobs) {
+            InferenceEngine::BlobMap blobs;
+            for (const auto& pair : outputBlobs) {
+                auto blob = context->CreateBlob(pair.second->getTensorDesc());
+                blob->allocate();
+                blobs[pair.first] = std::move(blob);
+            }
+            remoteOutputBlobs.push_back(std::move(blobs));
+        }
+    }
+
+    /**
+     * @brief Give output blobs in device memory, empty if remote output blobs are not allocated
+     */
+    const InferenceEngine::BlobMap& getRemoteOutputBlobs(int streamID) const {
+        static const InferenceEngine::BlobMap empty;
+        return remoteOutputBlobs.empty() ? empty : remoteOutputBlobs[streamID];
+    }
+
+    /**
+     * @brief Context of remote output blobs, nullptr if these are not allocated
+     */
+    const InferenceEngine::RemoteContext::Ptr& getRemoteContext() const {
+        return remoteContext;
+    }
+
+    /**
+     * @brief Size of input and output blobs of all infer requests in the pool
+     */
+    size_t getBlobsByteSize() const {
+        return blobsByteSize;
+    }
+
+    /**
+     * @brief Number of infer requests in the pool
+     */
+    int getStreamsLength() const {
+        return inferRequests.size();
+    }
+
+    /**
+     * @brief Number of attempts of lock-free acquisition before waiting thread is parked
+     */
+    static const uint IDLE_STREAM_SPIN_COUNT = 64;
+
 protected:
     /**
-    * @brief Vector representing circular buffer for infer queue
+    * @brief Single slot of the ring buffer, sequence number tells if slot is ready for push or pop
     */
-    std::vector<int> streams;
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        int streamId;
+    };
 
     /**
-    * @brief Index of the front of the idle streams list
+    * @brief Pops idle stream if more than keepIdle streams are idle
     */
-    std::uint32_t front_idx;
+    bool tryPop(int& streamId, size_t keepIdle = 0);
+    bool tryPopCell(int& streamId);
+    void push(int streamId);
 
     /**
-    * @brief Index of the back of the idle streams list
+    * @brief Pops idle stream and reports acquisition without waiting to metrics
     */
-    std::atomic<std::uint32_t> back_idx;
+    bool tryPopAndRecord(int& streamId, size_t keepIdle = 0);
 
     /**
-    * @brief Vector representing OV streams and used for notification about completed inference operations
+    * @brief Waits at most timeout for idle stream available to priority class, indefinitely without timeout
     */
-    std::mutex front_mut;
-    std::mutex queue_mutex;
+    std::optional<int> waitForIdleStream(const std::optional<std::chrono::microseconds> timeout, RequestPriority priority);
+    void recordWaitStarted();
+    void recordWaitFinished(std::chrono::steady_clock::time_point start, bool acquired);
+
+    static size_t roundUpToPowerOfTwo(int value) {
+        size_t result = 1;
+        while (result < static_cast<size_t>(value)) {
+            result <<= 1;
+        }
+        return result;
+    }
+
     /**
-     * 
+    * @brief Max number of requests waiting for idle stream, 0 means no limit
+    */
+    const size_t maxQueueSize;
+
+    /**
+    * @brief Max time request waits for idle stream, 0 means no limit
+    */
+    const std::chrono::microseconds maxQueueTime;
+
+    /**
+    * @brief Number of idle streams low priority requests cannot take
+    */
+    const size_t reservedHighPriorityStreams;
+
+    /**
+    * @brief Max number of low priority requests waiting for idle stream, 0 means no limit
+    */
+    const size_t maxLowPriorityQueueSize;
+
+    InferRequestsQueueMetrics* const metrics;
+
+    /**
+    * @brief Ring buffer size, never smaller than number of streams so push cannot fail
+    */
+    const size_t capacity;
+
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(64) std::atomic<size_t> enqueuePosition;
+    alignas(64) std::atomic<size_t> dequeuePosition;
+
+    /**
+    * @brief Number of pushed streams not claimed by any pop
+    */
+    alignas(64) std::atomic<size_t> idleStreams;
+
+    /**
+    * @brief Number of threads parked waiting for idle stream
+    */
+    alignas(64) std::atomic<uint32_t> parkedWaiters;
+    std::atomic<uint32_t> parkedLowPriorityWaiters;
+    std::mutex parkMutex;
+    std::condition_variable streamReturned;
+    std::condition_variable lowPriorityStreamReturned;
+
+    /**
+    * @brief Callbacks notified about returned streams, guarded by parkMutex
+    */
+    std::map<uint64_t, std::function<void()>> streamReturnedListeners;
+    uint64_t nextListenerId = 0;
+    std::atomic<uint32_t> listenersCount;
+
+    /**
+    * @brief Request queue counters, updated only by requests which had to wait for a stream
+    */
+    alignas(64) std::atomic<size_t> queueDepth;
+    std::atomic<size_t> lowPriorityQueueDepth;
+    std::atomic<uint64_t> queuedRequests;
+    std::atomic<uint64_t> rejectedQueueFull;
+    std::atomic<uint64_t> rejectedQueueTimeout;
+    std::atomic<uint64_t> totalQueueWaitMicroseconds;
+
+    /**
+    * @brief Exponential moving average of inference latency, 0 until first inference is recorded
+    */
+    std::atomic<uint64_t> averageInferenceLatencyMicroseconds;
+
+    /**
+    * @brief Weight of previous average is 1 - 1 / INFERENCE_LATENCY_SMOOTHING
+    */
+    static const uint64_t INFERENCE_LATENCY_SMOOTHING = 8;
+
+    /**
+     * @brief OV infer requests indexed by stream id
      */
     std::vector<InferenceEngine::InferRequest> inferRequests;
-    std::queue<std::promise<int>> promises;
+
+    /**
+     * @brief Input blobs owned by infer requests, indexed by stream id
+     */
+    std::vector<InferenceEngine::BlobMap> preallocatedInputBlobs;
+
+    /**
+     * @brief Output blobs owned by infer requests, indexed by stream id
+     */
+    std::vector<InferenceEngine::BlobMap> preallocatedOutputBlobs;
+
+    /**
+     * @brief Output blobs in device memory of remote context, indexed by stream id, not counted in host blobs size
+     */
+    std::vector<InferenceEngine::BlobMap> remoteOutputBlobs;
+    InferenceEngine::RemoteContext::Ptr remoteContext;
+
+    size_t blobsByteSize = 0;
 };
 }  // namespace ovms
@@ -0,0 +1,265 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "peerrouting.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <grpcpp/create_channel.h>
+#include <grpcpp/impl/codegen/client_unary_call.h>
+#include <grpcpp/impl/codegen/method_handler.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <spdlog/spdlog.h>
+
+#include "model.hpp"
+#include "modelinstance.hpp"
+#include "modelmanager.hpp"
+#include "prediction_service_utils.hpp"
+#include "requestlogging.hpp"
+#include "stringutils.hpp"
+#include "tenantscheduling.hpp"
+
+using google::protobuf::Empty;
+using google::protobuf::Struct;
+using google::protobuf::Value;
+using tensorflow::serving::PredictionService;
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+const std::string PEER_FORWARDED_HEADER = "ovms-forwarded";
+
+served_models_t collectServedModels(ModelManager& manager) {
+    served_models_t served;
+    for (const auto& [name, model] : manager.getModelsSnapshot()) {
+        ServedModel servedModel;
+        for (const auto& [version, instance] : model->getModelVersionsMapCopy()) {
+            if (instance->getStatus().getState() != ModelVersionState::AVAILABLE) {
+                continue;
+            }
+            servedModel.versions.insert(version);
+            servedModel.load += instance->getLoad();
+        }
+        if (!servedModel.versions.empty()) {
+            served.emplace(name, std::move(servedModel));
+        }
+    }
+    return served;
+}
+
+void serializeServedModels(const served_models_t& models, Struct& message) {
+    auto& modelsFields = *(*message.mutable_fields())["models"].mutable_struct_value()->mutable_fields();
+    for (const auto& [name, model] : models) {
+        auto& modelFields = *modelsFields[name].mutable_struct_value()->mutable_fields();
+        auto& versions = *modelFields["versions"].mutable_list_value();
+        for (const auto version : model.versions) {
+            versions.add_values()->set_number_value(static_cast<double>(version));
+        }
+        modelFields["load"].set_number_value(model.load);
+    }
+}
+
+Status deserializeServedModels(const Struct& message, served_models_t& models) {
+    models.clear();
+    auto modelsIt = message.fields().find("models");
+    if (modelsIt == message.fields().end() || !modelsIt->second.has_struct_value()) {
+        return StatusCode::JSON_INVALID;
+    }
+    for (const auto& [name, modelValue] : modelsIt->second.struct_value().fields()) {
+        if (!modelValue.has_struct_value()) {
+            return StatusCode::JSON_INVALID;
+        }
+        const auto& fields = modelValue.struct_value().fields();
+        auto versionsIt = fields.find("versions");
+        if (versionsIt == fields.end() || !versionsIt->second.has_list_value()) {
+            return StatusCode::JSON_INVALID;
+        }
+        ServedModel model;
+        for (const auto& version : versionsIt->second.list_value().values()) {
+            if (version.kind_case() != Value::kNumberValue || version.number_value() < 1) {
+                return StatusCode::JSON_INVALID;
+            }
+            model.versions.insert(static_cast<model_version_t>(version.number_value()));
+        }
+        auto loadIt = fields.find("load");
+        if (loadIt != fields.end() && loadIt->second.kind_case() == Value::kNumberValue) {
+            model.load = loadIt->second.number_value();
+        }
+        models.emplace(name, std::move(model));
+    }
+    return StatusCode::OK;
+}
+
+const char* PeerServiceImpl::GET_SERVED_MODELS_METHOD = "/ovms.PeerService/GetServedModels";
+
+PeerServiceImpl::PeerServiceImpl(ModelManager& manager) :
+    manager(manager) {
+    AddMethod(new grpc::internal::RpcServiceMethod(
+        GET_SERVED_MODELS_METHOD,
+        grpc::internal::RpcMethod::NORMAL_RPC,
+        new grpc::internal::RpcMethodHandler<PeerServiceImpl, Empty, Struct>(
+            [](PeerServiceImpl* service, grpc::ServerContext* context, const Empty* request, Struct* response) {
+                return service->GetServedModels(context, request, response);
+            },
+            this)));
+}
+
+grpc::Status PeerServiceImpl::GetServedModels(grpc::ServerContext* context, const Empty* request, Struct* response) {
+    serializeServedModels(collectServedModels(manager), *response);
+    return grpc::Status::OK;
+}
+
+PeerTable::PeerTable(size_t peersCount) :
+    forwarded(std::make_unique<std::atomic<uint32_t>[]>(peersCount)),
+    peersCount(peersCount),
+    lastModels(peersCount) {
+    for (size_t i = 0; i < peersCount; i++) {
+        forwarded[i].store(0, std::memory_order_relaxed);
+    }
+    peersModels.publish(lastModels);
+}
+
+void PeerTable::update(size_t peer, served_models_t models) {
+    std::lock_guard<std::mutex> lock(updateMtx);
+    lastModels[peer] = std::move(models);
+    peersModels.publish(lastModels);
+}
+
+std::optional<size_t> PeerTable::select(const std::string& name, model_version_t version) const {
+    return peersModels.read([this, &name, version](const auto& peers) -> std::optional<size_t> {
+        std::optional<size_t> selected;
+        double selectedLoad = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < peers.size(); i++) {
+            auto it = peers[i].find(name);
+            if (it == peers[i].end() || (version != 0 && it->second.versions.count(version) == 0)) {
+                continue;
+            }
+            const double load = it->second.load + forwarded[i].load(std::memory_order_relaxed);
+            if (load < selectedLoad) {
+                selected = i;
+                selectedLoad = load;
+            }
+        }
+        return selected;
+    });
+}
+
+bool PeerTable::serves(const std::string& name) const {
+    return peersModels.read([&name](const auto& peers) {
+        return std::any_of(peers.begin(), peers.end(), [&name](const auto& models) { return models.count(name) > 0; });
+    });
+}
+
+void PeerTable::startForwarding(size_t peer) {
+    forwarded[peer].fetch_add(1, std::memory_order_relaxed);
+}
+
+void PeerTable::finishForwarding(size_t peer) {
+    forwarded[peer].fetch_sub(1, std::memory_order_relaxed);
+}
+
+Status PeerRouter::configure(const std::string& peersList, std::chrono::milliseconds pollInterval) {
+    join();
+    peers.clear();
+    table.reset();
+    if (peersList.empty()) {
+        return StatusCode::OK;
+    }
+    for (const auto& address : tokenize(peersList, ',')) {
+        if (address.empty() || address.find(':') == std::string::npos) {
+            spdlog::error("Invalid peer address: {}, expected host:port", address);
+            return StatusCode::PEER_CONFIG_INVALID;
+        }
+        Peer peer;
+        peer.address = address;
+        peer.channel = grpc::CreateChannel(address, grpc::InsecureChannelCredentials());
+        peer.stub = PredictionService::NewStub(peer.channel);
+        peers.push_back(std::move(peer));
+    }
+    this->pollInterval = std::max(pollInterval, std::chrono::milliseconds(1));
+    table = std::make_unique<PeerTable>(peers.size());
+    exitPoller = false;
+    poller = std::thread(&PeerRouter::pollPeers, this);
+    spdlog::info("Forwarding requests for models not served locally to {} peers, polled every {} ms", peers.size(), this->pollInterval.count());
+    return StatusCode::OK;
+}
+
+void PeerRouter::pollPeers() {
+    const grpc::internal::RpcMethod method(PeerServiceImpl::GET_SERVED_MODELS_METHOD, grpc::internal::RpcMethod::NORMAL_RPC);
+    std::unique_lock<std::mutex> lock(pollerMtx);
+    while (!exitPoller) {
+        lock.unlock();
+        for (size_t i = 0; i < peers.size(); i++) {
+            grpc::ClientContext context;
+            context.set_deadline(std::chrono::system_clock::now() + pollInterval);
+            Empty request;
+            Struct response;
+            auto status = grpc::internal::BlockingUnaryCall(peers[i].channel.get(), method, &context, request, &response);
+            served_models_t models;
+            if (!status.ok()) {
+                SPDLOG_DEBUG("Peer {} did not advertise its models: {}", peers[i].address, status.error_message());
+            } else if (!deserializeServedModels(response, models).ok()) {
+                spdlog::warn("Peer {} advertised invalid models", peers[i].address);
+                models.clear();
+            }
+            table->update(i, std::move(models));
+        }
+        lock.lock();
+        pollerCv.wait_for(lock, pollInterval, [this]() { return exitPoller; });
+    }
+}
+
+Status PeerRouter::forward(const grpc::ServerContext& serverContext, const PredictRequest& request, PredictResponse& response, grpc::Status& peerStatus) {
+    if (serverContext.client_metadata().count(PEER_FORWARDED_HEADER) > 0) {
+        return StatusCode::MODEL_NAME_MISSING;
+    }
+    const auto& name = request.model_spec().name();
+    auto peer = table->select(name, request.model_spec().version().value());
+    if (!peer) {
+        return table->serves(name) ? StatusCode::MODEL_VERSION_MISSING : StatusCode::MODEL_NAME_MISSING;
+    }
+    grpc::ClientContext context;
+    if (serverContext.deadline() != std::chrono::system_clock::time_point::max()) {
+        context.set_deadline(serverContext.deadline());
+    }
+    for (const auto& header : {REQUEST_PRIORITY_HEADER, REQUEST_TENANT_HEADER}) {
+        auto it = serverContext.client_metadata().find(header);
+        if (it != serverContext.client_metadata().end()) {
+            context.AddMetadata(header, std::string(it->second.data(), it->second.size()));
+        }
+    }
+    context.AddMetadata(PEER_FORWARDED_HEADER, "1");
+    OVMS_REQUEST_DEBUG("Forwarding request for model: {}; version: {} to peer {}", name, request.model_spec().version().value(), peers[*peer].address);
+    table->startForwarding(*peer);
+    peerStatus = peers[*peer].stub->Predict(&context, request, &response);
+    table->finishForwarding(*peer);
+    return StatusCode::OK;
+}
+
+void PeerRouter::join() {
+    {
+        std::lock_guard<std::mutex> lock(pollerMtx);
+        exitPoller = true;
+    }
+    pollerCv.notify_all();
+    if (poller.joinable()) {
+        poller.join();
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,183 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <google/protobuf/empty.pb.h>
+#include <google/protobuf/struct.pb.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/server_context.h>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "model_version_policy.hpp"
+#include "readsnapshot.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+class ModelManager;
+
+/**
+ * @brief Request metadata set on requests forwarded to a peer, these are never forwarded again
+ */
+extern const std::string PEER_FORWARDED_HEADER;
+
+/**
+ * @brief Available versions and load of a model served by an instance
+ *
+ * Load is the number of busy and awaited inference requests of all its versions.
+ */
+struct ServedModel {
+    std::set<model_version_t> versions;
+    double load = 0;
+};
+
+using served_models_t = std::map<std::string, ServedModel>;
+
+/**
+ * @brief Collects models with available versions loaded by this instance
+ */
+served_models_t collectServedModels(ModelManager& manager);
+
+/**
+ * @brief Writes served models as {"models": {"name": {"versions": [1, 2], "load": 3}}}
+ */
+void serializeServedModels(const served_models_t& models, google::protobuf::Struct& message);
+
+Status deserializeServedModels(const google::protobuf::Struct& message, served_models_t& models);
+
+/**
+ * @brief Advertises models served by the instance to its peers, defined in peer_service.proto
+ */
+class PeerServiceImpl final : public grpc::Service {
+public:
+    static const char* GET_SERVED_MODELS_METHOD;
+
+    explicit PeerServiceImpl(ModelManager& manager);
+
+    grpc::Status GetServedModels(grpc::ServerContext* context, const google::protobuf::Empty* request, google::protobuf::Struct* response);
+
+private:
+    ModelManager& manager;
+};
+
+/**
+ * @brief Models served by peers, as last advertised, with requests forwarded to them and not answered yet
+ */
+class PeerTable {
+public:
+    explicit PeerTable(size_t peersCount);
+
+    /**
+     * @brief Replaces models advertised by the peer, empty when the peer does not answer
+     */
+    void update(size_t peer, served_models_t models);
+
+    /**
+     * @brief Selects least loaded peer serving the version, version 0 selects peers serving any version
+     *
+     * Load of a peer is its advertised load of the model increased by requests forwarded to it since.
+     */
+    std::optional<size_t> select(const std::string& name, model_version_t version) const;
+
+    /**
+     * @brief Checks if any peer serves the model, in any version
+     */
+    bool serves(const std::string& name) const;
+
+    void startForwarding(size_t peer);
+    void finishForwarding(size_t peer);
+
+private:
+    ReadSnapshot<std::vector<served_models_t>> peersModels;
+    std::unique_ptr<std::atomic<uint32_t>[]> forwarded;
+    const size_t peersCount;
+    std::mutex updateMtx;
+    std::vector<served_models_t> lastModels;
+};
+
+/**
+ * @brief Forwards requests for models not served by this instance to peers which serve them
+ *
+ * Peers are polled for their served models in a background thread, so routing needs no calls on the request path.
+ * Instances can then be given disjoint subsets of models while clients connect to any of them.
+ */
+class PeerRouter {
+public:
+    static PeerRouter& getInstance() {
+        static PeerRouter instance;
+        return instance;
+    }
+
+    /**
+     * @brief Parses comma separated list of gRPC addresses of peers and starts polling them
+     *
+     * Empty list disables forwarding.
+     */
+    Status configure(const std::string& peers, std::chrono::milliseconds pollInterval);
+
+    bool isEnabled() const { return table != nullptr; }
+
+    /**
+     * @brief Forwards request to least loaded peer serving requested model version
+     *
+     * Deadline, priority and tenant of the call are passed to the peer.
+     *
+     * @return OK with status of the peer in peerStatus, or MODEL_NAME_MISSING or MODEL_VERSION_MISSING if none serves it
+     */
+    Status forward(const grpc::ServerContext& context, const tensorflow::serving::PredictRequest& request,
+        tensorflow::serving::PredictResponse& response, grpc::Status& peerStatus);
+
+    /**
+     * @brief Stops polling peers
+     */
+    void join();
+
+private:
+    PeerRouter() = default;
+    ~PeerRouter() { join(); }
+
+    void pollPeers();
+
+    struct Peer {
+        std::string address;
+        std::shared_ptr<grpc::Channel> channel;
+        std::unique_ptr<tensorflow::serving::PredictionService::Stub> stub;
+    };
+    std::vector<Peer> peers;
+    std::unique_ptr<PeerTable> table;
+    std::chrono::milliseconds pollInterval{0};
+
+    std::thread poller;
+    std::mutex pollerMtx;
+    std::condition_variable pollerCv;
+    bool exitPoller = false;
+};
+
+}  // namespace ovms
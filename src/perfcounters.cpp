@@ -0,0 +1,100 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "perfcounters.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace ovms {
+
+void PerfCountersCollector::add(const perf_counters_t& counters) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (collectedCount >= inferencesCount) {
+        return;
+    }
+    for (const auto& [name, info] : counters) {
+        auto& layer = layers[name];
+        if (layer.layerType.empty()) {
+            layer.layerType = info.layer_type;
+            layer.execType = info.exec_type;
+        }
+        if (info.status != InferenceEngine::InferenceEngineProfileInfo::EXECUTED) {
+            continue;
+        }
+        ++layer.executedCount;
+        layer.realTimeMicroseconds += std::max<long long>(0, info.realTime_uSec);
+        layer.cpuTimeMicroseconds += std::max<long long>(0, info.cpu_uSec);
+    }
+    if (++collectedCount == inferencesCount) {
+        collected.notify_all();
+    }
+}
+
+bool PerfCountersCollector::waitForCompletion(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mtx);
+    return collected.wait_for(lock, timeout, [this]() { return collectedCount >= inferencesCount; });
+}
+
+std::string PerfCountersCollector::toJson() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<std::pair<std::string, const LayerStats*>> sorted;
+    sorted.reserve(layers.size());
+    uint64_t totalRealTimeMicroseconds = 0;
+    for (const auto& [name, layer] : layers) {
+        sorted.emplace_back(name, &layer);
+        totalRealTimeMicroseconds += layer.realTimeMicroseconds;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second->realTimeMicroseconds > b.second->realTimeMicroseconds;
+    });
+    const double inferences = std::max<size_t>(1, collectedCount);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("inferences");
+    writer.Uint64(collectedCount);
+    writer.Key("avg_real_time_us");
+    writer.Double(totalRealTimeMicroseconds / inferences);
+    writer.Key("layers");
+    writer.StartArray();
+    for (const auto& [name, layer] : sorted) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(name.c_str());
+        writer.Key("layer_type");
+        writer.String(layer->layerType.c_str());
+        writer.Key("exec_type");
+        writer.String(layer->execType.c_str());
+        writer.Key("executed");
+        writer.Uint64(layer->executedCount);
+        writer.Key("avg_real_time_us");
+        writer.Double(layer->realTimeMicroseconds / inferences);
+        writer.Key("avg_cpu_time_us");
+        writer.Double(layer->cpuTimeMicroseconds / inferences);
+        writer.Key("real_time_share");
+        writer.Double(totalRealTimeMicroseconds > 0 ? double(layer->realTimeMicroseconds) / totalRealTimeMicroseconds : 0.0);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+}  // namespace ovms
@@ -0,0 +1,77 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <inference_engine.hpp>
+
+namespace ovms {
+
+/**
+ * @brief Aggregates per layer performance counters of a fixed number of inferences
+ */
+class PerfCountersCollector {
+public:
+    using perf_counters_t = std::map<std::string, InferenceEngine::InferenceEngineProfileInfo>;
+
+    explicit PerfCountersCollector(size_t inferencesCount) :
+        inferencesCount(inferencesCount) {}
+
+    /**
+     * @brief Adds counters of a single inference, ignored once inferencesCount inferences are collected
+     */
+    void add(const perf_counters_t& counters);
+
+    /**
+     * @brief Blocks until inferencesCount inferences are collected
+     *
+     * @return false on timeout
+     */
+    bool waitForCompletion(std::chrono::milliseconds timeout);
+
+    size_t getCollectedCount() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return collectedCount;
+    }
+
+    /**
+     * @brief Serializes layers sorted by total execution time, times are averaged over collected inferences
+     */
+    std::string toJson() const;
+
+private:
+    struct LayerStats {
+        std::string layerType;
+        std::string execType;
+        uint64_t executedCount = 0;
+        uint64_t realTimeMicroseconds = 0;
+        uint64_t cpuTimeMicroseconds = 0;
+    };
+
+    const size_t inferencesCount;
+    mutable std::mutex mtx;
+    std::condition_variable collected;
+    size_t collectedCount = 0;
+    std::map<std::string, LayerStats> layers;
+};
+
+}  // namespace ovms
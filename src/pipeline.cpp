@@ -16,10 +16,18 @@
 #include "pipeline.hpp"
 
 #include <algorithm>
-#include <map>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "blobconversion.hpp"
+#include "pipeline_tracer.hpp"
+#include "requestdeadline.hpp"
+#include "requestlogging.hpp"
 #include "threadsafequeue.hpp"
 
 namespace ovms {
@@ -36,12 +44,17 @@ void printNodeConnections(const std::string& nodeName, const std::string& source
     SPDLOG_DEBUG(ss.str());
 }
 
-std::map<const std::string, bool> Pipeline::prepareStatusMap() const {
-    std::map<const std::string, bool> nameFlagMap;
-    for (const auto& node : nodes) {
-        nameFlagMap.emplace(std::make_pair(node->getName(), false));
+std::atomic<uint64_t> Pipeline::instancesCount = 0;
+
+Pipeline::~Pipeline() {
+    --instancesCount;
+    if (!recycler) {
+        return;
+    }
+    for (auto& node : nodes) {
+        node->reset();
     }
-    return std::move(nameFlagMap);
+    recycler(std::move(nodes));
 }
 
 void setFailIfNotFailEarlier(ovms::Status& earlierStatusCode, ovms::Status& newFailStatus) {
@@ -50,137 +63,319 @@ void setFailIfNotFailEarlier(ovms::Status& earlierStatusCode, ovms::Status& newF
     }
 }
 
-#define IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE \
-    if (!firstErrorStatus.ok()) {                                                       \
-        if (finishedExecute == startedExecute) {                                        \
-            break;                                                                      \
-        } else {                                                                        \
-            continue;                                                                   \
-        }                                                                               \
-    }
-
-#define CHECK_AND_LOG_ERROR(NODE)                                   \
-    if (!status.ok()) {                                             \
-        setFailIfNotFailEarlier(firstErrorStatus, status);          \
-        SPDLOG_INFO("Executing pipeline:{} node:{} failed with:{}", \
-            getName(), NODE.getName(), status.string());            \
+#define CHECK_AND_LOG_ERROR(NODE)                                          \
+    if (!status.ok()) {                                                    \
+        setFailIfNotFailEarlier(state.firstErrorStatus, status);           \
+        OVMS_REQUEST_DEBUG("Executing pipeline:{} node:{} failed with:{}", \
+            getName(), NODE.getName(), status.string());                   \
     }
 
-Status Pipeline::execute() {
-    SPDLOG_INFO("Started execution of pipeline: {}", getName());
+/**
+ * @brief State of a single pipeline execution shared by all its execution steps
+ */
+struct Pipeline::ExecutionState {
     ThreadSafeQueue<std::reference_wrapper<Node>> finishedNodeQueue;
     ovms::Status firstErrorStatus{ovms::StatusCode::OK};
-    auto startedExecute{prepareStatusMap()};
-    auto finishedExecute{prepareStatusMap()};
-    startedExecute.at(entry.getName()) = true;
-    ovms::Status status = entry.execute(finishedNodeQueue);  // first node will triger first message
+    // indexed by node index
+    std::vector<bool> startedExecute;
+    std::vector<bool> finishedExecute;
+    std::vector<std::reference_wrapper<Node>> nodesWaitingForIdleInferenceStreamId;
+    // inputs shared by several nodes are converted to each precision once
+    BlobConversionCache conversions;
+
+    // used only by asynchronous execution
+    std::atomic<uint32_t> pendingEvents{0};
+    bool completed = false;
+    std::function<void(const Status&)> onCompleted;
+
+    // set only if execution is sampled for tracing or its timing is requested
+    std::unique_ptr<PipelineTrace> trace;
+    bool traceSampled = false;
+    RequestTiming* timing = nullptr;
+    // nodes are not started after client deadline, null if request has none
+    const RequestDeadline* deadline = nullptr;
+
+    void traceNode(const Node& node, NodeTracePoint point) {
+        if (trace) {
+            trace->record(node, point);
+        }
+    }
+
+    void submitTrace() {
+        if (trace) {
+            trace->finish(firstErrorStatus);
+            if (timing != nullptr) {
+                trace->addTimings(*timing);
+            }
+            if (traceSampled) {
+                PipelineTracer::getInstance().submit(*trace);
+            }
+            trace.reset();
+        }
+    }
+};
+
+Status Pipeline::start(ExecutionState& state) {
+    OVMS_REQUEST_DEBUG("Started execution of pipeline: {}", getName());
+    auto deadlineStatus = checkDeadline(state.deadline);
+    if (!deadlineStatus.ok()) {
+        return deadlineStatus;
+    }
+    state.startedExecute.assign(nodes.size(), false);
+    state.finishedExecute.assign(nodes.size(), false);
+    for (auto& node : nodes) {
+        node->setConversionCache(&state.conversions);
+    }
+    state.trace = PipelineTracer::getInstance().startTrace(getName(), nodes.size());
+    state.traceSampled = state.trace != nullptr;
+    if (!state.trace && state.timing != nullptr) {
+        // node timings are taken from the trace, it is not written to trace file
+        state.trace = std::make_unique<PipelineTrace>(getName(), nodes.size());
+    }
+    state.startedExecute[entry.getIndex()] = true;
+    state.traceNode(entry, NodeTracePoint::READY);
+    state.traceNode(entry, NodeTracePoint::STARTED);
+    ovms::Status status = entry.execute(state.finishedNodeQueue);  // first node will triger first message
     if (!status.ok()) {
-        SPDLOG_INFO("Executing pipeline:{} node:{} failed with:{}",
+        OVMS_REQUEST_DEBUG("Executing pipeline:{} node:{} failed with:{}",
             getName(), entry.getName(), status.string());
+        setFailIfNotFailEarlier(state.firstErrorStatus, status);
+        state.submitTrace();
+    }
+    return status;
+}
+
+Status Pipeline::execute(RequestTiming* timing, const RequestDeadline* deadline) {
+    ExecutionState state;
+    state.timing = timing;
+    state.deadline = deadline;
+    auto status = start(state);
+    if (!status.ok()) {
         return status;
     }
-    std::vector<std::reference_wrapper<Node>> nodesWaitingForIdleInferenceStreamId;  // consider replacing with std::vector
-    // even though we can remove with random sequence it is probable that we will remove those in sequence
-    const uint WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS = 500;
-    const uint WAIT_FOR_DEFERRED_NODE_DISARM_TIMEOUT_MICROSECONDS = 500;
-    // process finished nodes and if no one is finished check if any node with deffered execution
-    // has necessary resources already
-    while (true) {
+    // Pipeline thread sleeps until a node finishes inference or a stream is returned to the model
+    // of any deferred node, both wake up finishedNodeQueue. Nodes finished meanwhile are handled in one wake up.
+    std::vector<std::reference_wrapper<Node>> finishedNodes;
+    finishedNodes.reserve(nodes.size());
+    bool finished = false;
+    while (!finished) {
         SPDLOG_DEBUG("Pipeline:{} waiting for message that node finished.", getName());
-        auto optionallyFinishedNode = finishedNodeQueue.tryPull(WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS);
-        if (optionallyFinishedNode) {
-            Node& finishedNode = optionallyFinishedNode.value().get();
-            SPDLOG_DEBUG("Pipeline:{} got message that node:{} finished.", getName(), finishedNode.getName());
-            finishedExecute.at(finishedNode.getName()) = true;
-            if (!firstErrorStatus.ok()) {
-                finishedNode.release();
-            }
-            IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
-            BlobMap finishedNodeOutputBlobMap;
-            SPDLOG_DEBUG("Fetching results of pipeline:{} node:{}", getName(), finishedNode.getName());
-            status = finishedNode.fetchResults(finishedNodeOutputBlobMap);
-            CHECK_AND_LOG_ERROR(finishedNode)
-            IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
-            if (std::all_of(finishedExecute.begin(), finishedExecute.end(), [](auto pair) { return pair.second; })) {
+        finishedNodes.clear();
+        const bool wokenUp = state.finishedNodeQueue.pullAll(finishedNodes);
+        for (auto& finishedNode : finishedNodes) {
+            if (processEvent(state, finishedNode)) {
+                finished = true;
                 break;
             }
-            auto& nextNodesFromFinished = finishedNode.getNextNodes();
-            for (auto& nextNode : nextNodesFromFinished) {
-                SPDLOG_DEBUG("setting pipeline:{} node:{} outputs as inputs for node:{}",
-                    getName(), finishedNode.getName(), nextNode.get().getName());
-                status = nextNode.get().setInputs(finishedNode, finishedNodeOutputBlobMap);
-                CHECK_AND_LOG_ERROR(nextNode.get())
-                if (!firstErrorStatus.ok()) {
-                    break;
-                }
+        }
+        if (!finished && wokenUp) {
+            finished = processEvent(state, std::nullopt);
+        }
+    }
+    state.submitTrace();
+    return state.firstErrorStatus;
+}
+
+void Pipeline::executeAsync(tensorflow::serving::ThreadPoolExecutor& executor, std::function<void(const Status&)> onCompleted, RequestTiming* timing,
+    const RequestDeadline* deadline) {
+    auto state = std::make_shared<ExecutionState>();
+    state->onCompleted = std::move(onCompleted);
+    state->timing = timing;
+    state->deadline = deadline;
+    // Every event schedules processing on the executor unless processing of earlier events is already scheduled,
+    // so events of a single pipeline are processed sequentially on any executor thread
+    ExecutionState* statePtr = state.get();
+    state->finishedNodeQueue.setPushListener([this, statePtr, &executor]() {
+        if (statePtr->pendingEvents.fetch_add(1) == 0) {
+            executor.Schedule([this, statePtr]() { processPendingEvents(*statePtr); });
+        }
+    });
+    // state is owned by the pipeline until execution completes
+    this->asyncExecutionState = state;
+    auto status = start(*state);
+    if (!status.ok()) {
+        state->finishedNodeQueue.setPushListener(nullptr);
+        this->asyncExecutionState.reset();
+        state->onCompleted(status);
+    }
+}
+
+void Pipeline::processPendingEvents(ExecutionState& state) {
+    // pendingEvents counts events pushed, wake ups may be coalesced so pulling may find nothing
+    do {
+        std::optional<std::reference_wrapper<Node>> event;
+        if (!state.completed && state.finishedNodeQueue.tryPullEvent(event)) {
+            if (processEvent(state, event)) {
+                state.completed = true;
+                SPDLOG_DEBUG("Pipeline:{} finished asynchronous execution", getName());
+                // pipeline may be destroyed by completion callback, no members can be used afterwards
+                auto onCompleted = std::move(state.onCompleted);
+                auto keepStateAlive = std::move(this->asyncExecutionState);
+                keepStateAlive->finishedNodeQueue.setPushListener(nullptr);
+                state.submitTrace();
+                onCompleted(state.firstErrorStatus);
+                // no other event can arrive once all nodes finished and deferred nodes are disarmed
+                return;
             }
-            finishedNodeOutputBlobMap.clear();
-            for (auto& nextNode : nextNodesFromFinished) {
-                if (nextNode.get().isReady()) {
-                    SPDLOG_DEBUG("Started execution of pipeline:{} node:{}", getName(), nextNode.get().getName());
-                    startedExecute.at(nextNode.get().getName()) = true;
-                    status = nextNode.get().execute(finishedNodeQueue);
-                    if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
-                        SPDLOG_DEBUG("Node:{} not ready for execution yet", nextNode.get().getName());
-                        nodesWaitingForIdleInferenceStreamId.push_back(nextNode.get());
-                        status = StatusCode::OK;
-                    }
-                    CHECK_AND_LOG_ERROR(nextNode.get())
-                    if (!firstErrorStatus.ok()) {
-                        break;
-                    }
-                }
+        }
+    } while (state.pendingEvents.fetch_sub(1) > 1);
+}
+
+bool Pipeline::processEvent(ExecutionState& state, std::optional<std::reference_wrapper<Node>> finishedNode) {
+    if (finishedNode) {
+        if (processFinishedNode(state, finishedNode.value().get())) {
+            return true;
+        }
+    } else if (state.firstErrorStatus.ok()) {
+        retryDeferredNodes(state);
+    }
+    // If error occurred, disarm stream id guards of all deferred nodes and exit once started nodes finish
+    if (!state.firstErrorStatus.ok()) {
+        if (state.nodesWaitingForIdleInferenceStreamId.size() > 0) {
+            SPDLOG_DEBUG("Disarming stream id guards of {} deferred nodes due to previous error in pipeline", state.nodesWaitingForIdleInferenceStreamId.size());
+            for (auto& node : state.nodesWaitingForIdleInferenceStreamId) {
+                node.get().tryDisarmStreamIdGuard();
+                state.finishedExecute[node.get().getIndex()] = true;
             }
+            state.nodesWaitingForIdleInferenceStreamId.clear();
+        }
+        return state.finishedExecute == state.startedExecute;
+    }
+    return false;
+}
+
+bool Pipeline::processFinishedNode(ExecutionState& state, Node& finishedNode) {
+    SPDLOG_DEBUG("Pipeline:{} got message that node:{} finished.", getName(), finishedNode.getName());
+    state.finishedExecute[finishedNode.getIndex()] = true;
+    state.traceNode(finishedNode, NodeTracePoint::FINISHED);
+    if (!state.firstErrorStatus.ok()) {
+        finishedNode.release();
+        return false;
+    }
+    BlobMap finishedNodeOutputBlobMap;
+    SPDLOG_DEBUG("Fetching results of pipeline:{} node:{}", getName(), finishedNode.getName());
+    auto status = finishedNode.fetchResults(finishedNodeOutputBlobMap);
+    if (status.ok()) {
+        status = finishedNode.demultiplyOutputs(finishedNodeOutputBlobMap);
+    }
+    state.traceNode(finishedNode, NodeTracePoint::FETCHED);
+    CHECK_AND_LOG_ERROR(finishedNode)
+    if (!state.firstErrorStatus.ok()) {
+        return false;
+    }
+    if (std::all_of(state.finishedExecute.begin(), state.finishedExecute.end(), [](bool finished) { return finished; })) {
+        return true;
+    }
+    status = checkDeadline(state.deadline);
+    CHECK_AND_LOG_ERROR(finishedNode)
+    if (!state.firstErrorStatus.ok()) {
+        finishedNode.release();
+        return false;
+    }
+    auto& nextNodesFromFinished = finishedNode.getNextNodes();
+    for (auto& nextNode : nextNodesFromFinished) {
+        SPDLOG_DEBUG("setting pipeline:{} node:{} outputs as inputs for node:{}",
+            getName(), finishedNode.getName(), nextNode.get().getName());
+        status = nextNode.get().setInputs(finishedNode, finishedNodeOutputBlobMap);
+        CHECK_AND_LOG_ERROR(nextNode.get())
+        if (!state.firstErrorStatus.ok()) {
+            break;
+        }
+    }
+    finishedNodeOutputBlobMap.clear();
+    if (!state.firstErrorStatus.ok()) {
+        return false;
+    }
+    for (auto& nextNode : nextNodesFromFinished) {
+        if (nextNode.get().isReady()) {
+            status = startReadyNode(state, nextNode.get(), &finishedNode);
         } else {
-            // If error occurred earlier, disarm stream id guards of all deferred nodes and exit
-            if (!firstErrorStatus.ok()) {
-                SPDLOG_DEBUG("Will try to disarm all stream id guards of all {} deferred nodes due to previous error in pipeline", nodesWaitingForIdleInferenceStreamId.size());
-                // Check if there are deferred nodes in queue to free
-                if (nodesWaitingForIdleInferenceStreamId.size() > 0) {
-                    SPDLOG_DEBUG("Trying to disarm {} remaining deferred nodes...", nodesWaitingForIdleInferenceStreamId.size());
-                    for (auto it = nodesWaitingForIdleInferenceStreamId.begin(); it != nodesWaitingForIdleInferenceStreamId.end();) {
-                        auto& node = (*it).get();
-                        if (node.tryDisarmStreamIdGuard(WAIT_FOR_DEFERRED_NODE_DISARM_TIMEOUT_MICROSECONDS)) {
-                            SPDLOG_DEBUG("Stream id guard disarm of node {} has succeeded", node.getName());
-                            finishedExecute.at(node.getName()) = true;
-                            it = nodesWaitingForIdleInferenceStreamId.erase(it);
-                        } else {
-                            SPDLOG_DEBUG("Cannot disarm stream id guard of node {} yet, will try again later", node.getName());
-                            it++;
-                        }
-                    }
-                    SPDLOG_DEBUG("Disarming iteration completed, remaining deferred nodes count: {}", nodesWaitingForIdleInferenceStreamId.size());
-                }
-                // Check for deferred node queue size again to indicate if all nodes got freed
-                if (nodesWaitingForIdleInferenceStreamId.size() > 0) {
-                    continue;
-                } else {
-                    SPDLOG_DEBUG("Disarming all stream id guards of deferred nodes completed, pipeline will shut down");
-                    IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
-                }
-            }
+            // node waits for other dependencies, stream of finished node is returned in the meantime
+            status = nextNode.get().copyInputsFrom(finishedNode);
+        }
+        CHECK_AND_LOG_ERROR(nextNode.get())
+        if (!state.firstErrorStatus.ok()) {
+            break;
+        }
+    }
+    state.traceNode(finishedNode, NodeTracePoint::INPUTS_PASSED);
+    return false;
+}
 
-            // else scope could be executed always however it seems most reasonable at the time to
-            // free blocked inferRequests from exeuction first rather than free models for reloading
-            for (auto it = nodesWaitingForIdleInferenceStreamId.begin(); it != nodesWaitingForIdleInferenceStreamId.end();) {
-                auto& node = (*it).get();
-                SPDLOG_DEBUG("Trying to trigger node:{} execution", node.getName());
-                status = node.execute(finishedNodeQueue);
-                if (status.ok()) {
-                    SPDLOG_DEBUG("Node:{} ready yet:", node.getName());
-                    it = nodesWaitingForIdleInferenceStreamId.erase(it);
-                    continue;
-                }
-                it++;
-                if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
-                    SPDLOG_DEBUG("Node:{} not ready for execution yet", node.getName());
-                    status = StatusCode::OK;
-                } else {
-                    CHECK_AND_LOG_ERROR(node)
-                }
-            }
+Status Pipeline::startReadyNode(ExecutionState& state, Node& node, const Node* finishedNode) {
+    bool skipped = false;
+    auto status = node.checkSkipped(skipped);
+    if (!status.ok()) {
+        return status;
+    }
+    if (skipped) {
+        return skipNode(state, node);
+    }
+    SPDLOG_DEBUG("Started execution of pipeline:{} node:{}", getName(), node.getName());
+    state.startedExecute[node.getIndex()] = true;
+    state.traceNode(node, NodeTracePoint::READY);
+    status = node.execute(state.finishedNodeQueue);
+    if (status.ok()) {
+        state.traceNode(node, NodeTracePoint::STARTED);
+    } else if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
+        SPDLOG_DEBUG("Node:{} not ready for execution yet", node.getName());
+        state.nodesWaitingForIdleInferenceStreamId.push_back(node);
+        // deferred node must not hold stream of finished node, it might be the one it waits for
+        status = StatusCode::OK;
+        if (finishedNode != nullptr) {
+            status = node.copyInputsFrom(*finishedNode);
+        }
+    }
+    return status;
+}
+
+Status Pipeline::skipNode(ExecutionState& state, Node& node) {
+    OVMS_REQUEST_DEBUG("Pipeline:{} skips node:{}", getName(), node.getName());
+    // skipped node counts as finished, execution completes without waiting for skipped branch
+    state.startedExecute[node.getIndex()] = true;
+    state.finishedExecute[node.getIndex()] = true;
+    node.skip();
+    for (auto& nextNode : node.getNextNodes()) {
+        nextNode.get().setDependencySkipped();
+        if (!nextNode.get().isReady()) {
+            continue;
+        }
+        auto status = startReadyNode(state, nextNode.get(), nullptr);
+        if (!status.ok()) {
+            return status;
         }
     }
-    return firstErrorStatus;
+    return StatusCode::OK;
 }
+
+void Pipeline::retryDeferredNodes(ExecutionState& state) {
+    // woken up by returned stream
+    auto status = checkDeadline(state.deadline);
+    if (!status.ok()) {
+        // deferred nodes are disarmed by the caller
+        setFailIfNotFailEarlier(state.firstErrorStatus, status);
+        return;
+    }
+    auto& deferredNodes = state.nodesWaitingForIdleInferenceStreamId;
+    for (auto it = deferredNodes.begin(); it != deferredNodes.end();) {
+        auto& node = (*it).get();
+        SPDLOG_DEBUG("Trying to trigger node:{} execution", node.getName());
+        status = node.execute(state.finishedNodeQueue);
+        if (status.ok()) {
+            SPDLOG_DEBUG("Node:{} ready yet:", node.getName());
+            state.traceNode(node, NodeTracePoint::STARTED);
+            it = deferredNodes.erase(it);
+            continue;
+        }
+        if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
+            SPDLOG_DEBUG("Node:{} not ready for execution yet", node.getName());
+            it++;
+        } else {
+            // failed node notified finishedNodeQueue itself
+            it = deferredNodes.erase(it);
+            CHECK_AND_LOG_ERROR(node)
+        }
+    }
+}
+
 }  // namespace ovms
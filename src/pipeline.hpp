@@ -15,37 +15,73 @@
 //*****************************************************************************
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "tensorflow_serving/util/threadpool_executor.h"
+
 #include "dl_node.hpp"
 #include "entry_node.hpp"
 #include "exit_node.hpp"
+#include "requesttiming.hpp"
 #include "status.hpp"
 
 namespace ovms {
 
+class RequestDeadline;
+
 void printNodeConnections(const std::string& nodeName, const std::string& sourceNode, const InputPairs& pairs);
 
+/**
+ * @brief Takes over connected nodes of destroyed pipeline, so they can be reused by pipelines created later
+ */
+using NodesRecycler = std::function<void(std::vector<std::unique_ptr<Node>>&& nodes)>;
+
 class Pipeline {
+    struct ExecutionState;
+
     std::vector<std::unique_ptr<Node>> nodes;
     const std::string name;
     EntryNode& entry;
     ExitNode& exit;
+    std::shared_ptr<ExecutionState> asyncExecutionState;
+    NodesRecycler recycler;
+
+    static std::atomic<uint64_t> instancesCount;
 
 public:
     Pipeline(EntryNode& entry, ExitNode& exit, const std::string& name = "default_name") :
         name(name),
         entry(entry),
-        exit(exit) {}
+        exit(exit) {
+        ++instancesCount;
+    }
+
+    ~Pipeline();
+
+    /**
+     * @brief Number of pipelines created for requests and not destroyed yet
+     */
+    static uint64_t getInstancesCount() { return instancesCount; }
 
     void push(std::unique_ptr<Node> node) {
+        node->setIndex(nodes.size());
         nodes.emplace_back(std::move(node));
     }
 
+    /**
+     * @brief Sets recycler receiving reset nodes when pipeline is destroyed instead of destroying them
+     */
+    void setRecycler(NodesRecycler recycler) {
+        this->recycler = std::move(recycler);
+    }
+
     EntryNode& getEntry() const { return this->entry; }
     ExitNode& getExit() const { return this->exit; }
 
@@ -56,13 +92,52 @@ public:
         to.addDependency(from, blobNamesMapping);
     }
 
-    Status execute();
+    /**
+     * @brief Executes pipeline on calling thread, blocks until all started nodes finish
+     *
+     * Pipeline and node durations are added to timing if it is not null.
+     * Nodes are not started once deadline passes if it is not null, started nodes are finished.
+     */
+    Status execute(RequestTiming* timing = nullptr, const RequestDeadline* deadline = nullptr);
+
+    /**
+     * @brief Starts pipeline execution and returns, processing of finished nodes runs as executor tasks
+     *
+     * Events of a single execution are processed sequentially, different pipelines share executor threads.
+     * onCompleted is invoked on executor thread once, pipeline and timing must stay alive until then.
+     * Timings are added before onCompleted is invoked. Deadline must stay alive until onCompleted is invoked as well.
+     */
+    void executeAsync(tensorflow::serving::ThreadPoolExecutor& executor, std::function<void(const Status&)> onCompleted, RequestTiming* timing = nullptr,
+        const RequestDeadline* deadline = nullptr);
+
     const std::string& getName() const {
         return name;
     }
 
 private:
-    std::map<const std::string, bool> prepareStatusMap() const;
+    Status start(ExecutionState& state);
+    void processPendingEvents(ExecutionState& state);
+    /**
+     * @brief Handles finished node or wake up caused by returned stream
+     *
+     * @return true when execution is finished
+     */
+    bool processEvent(ExecutionState& state, std::optional<std::reference_wrapper<Node>> finishedNode);
+    bool processFinishedNode(ExecutionState& state, Node& finishedNode);
+    void retryDeferredNodes(ExecutionState& state);
+
+    /**
+     * @brief Executes node which received all its inputs, or skips it if its condition is not met
+     *
+     * @param finishedNode dependency whose outputs the node received, these are copied if execution is deferred
+     */
+    Status startReadyNode(ExecutionState& state, Node& node, const Node* finishedNode);
+
+    /**
+     * @brief Marks node finished without execution and notifies its dependants, these are skipped in turn
+     * unless they run with skipped dependencies
+     */
+    Status skipNode(ExecutionState& state, Node& node);
 };
 
 }  // namespace ovms
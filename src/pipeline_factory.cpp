@@ -15,7 +15,12 @@
 //*****************************************************************************
 #include "pipeline_factory.hpp"
 
+#include <algorithm>
+#include <set>
+
+#include "custom_node.hpp"
 #include "prediction_service_utils.hpp"
+#include "requestlogging.hpp"
 
 namespace ovms {
 
@@ -24,57 +29,108 @@ Status toNodeKind(const std::string& str, NodeKind& nodeKind) {
         nodeKind = NodeKind::DL;
         return StatusCode::OK;
     }
+    if (str == CUSTOM_NODE_CONFIG_TYPE) {
+        nodeKind = NodeKind::CUSTOM;
+        return StatusCode::OK;
+    }
     SPDLOG_ERROR("Unsupported node type:{}", str);
     return StatusCode::PIPELINE_NODE_WRONG_KIND_CONFIGURATION;
 }
 
-Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
-    const tensorflow::serving::PredictRequest* request,
-    tensorflow::serving::PredictResponse* response,
-    ModelManager& manager) const {
-    std::unordered_map<std::string, std::unique_ptr<Node>> nodes;
+void PipelineDefinition::createNodes(std::vector<std::unique_ptr<Node>>& nodes, ModelManager& manager) const {
+    std::unordered_map<std::string, std::unique_ptr<Node>> nodesByName;
 
-    EntryNode* entry = nullptr;
-    ExitNode* exit = nullptr;
     for (const auto& info : nodeInfos) {
         SPDLOG_DEBUG("Creating pipeline:{}. Adding nodeName:{}, modelName:{}",
-            info.nodeName, info.modelName);
+            pipelineName, info.nodeName, info.modelName);
         switch (info.kind) {
-        case NodeKind::ENTRY: {
-            auto node = std::make_unique<EntryNode>(request);
-            entry = node.get();
-            nodes.insert(std::make_pair(info.nodeName, std::move(node)));
+        case NodeKind::ENTRY:
+            nodesByName.insert(std::make_pair(info.nodeName, std::make_unique<EntryNode>(nullptr)));
             break;
-        }
         case NodeKind::DL:
-            nodes.insert(std::make_pair(info.nodeName, std::move(std::make_unique<DLNode>(info.nodeName,
-                                                           info.modelName,
-                                                           info.modelVersion,
-                                                           manager,
-                                                           info.outputNameAliases))));
+            nodesByName.insert(std::make_pair(info.nodeName, std::move(std::make_unique<DLNode>(info.nodeName,
+                                                                 info.modelName,
+                                                                 info.modelVersion,
+                                                                 manager,
+                                                                 info.outputNameAliases,
+                                                                 info.device))));
             break;
-        case NodeKind::EXIT: {
-            auto node = std::make_unique<ExitNode>(response);
-            exit = node.get();
-            nodes.insert(std::make_pair(info.nodeName, std::move(node)));
+        case NodeKind::CUSTOM:
+            nodesByName.insert(std::make_pair(info.nodeName, std::make_unique<CustomNode>(info.nodeName, info.library, info.parameters, info.outputNameAliases)));
+            break;
+        case NodeKind::EXIT:
+            nodesByName.insert(std::make_pair(info.nodeName, std::make_unique<ExitNode>(nullptr)));
             break;
-        }
         default:
             throw std::invalid_argument("unknown node kind");
         }
     }
+    for (const auto& info : nodeInfos) {
+        auto& node = nodesByName.at(info.nodeName);
+        if (info.demultiplyCount) {
+            node->setDemultiplyCount(info.demultiplyCount.value());
+        }
+        if (info.gatherFromNode) {
+            auto demultiplexer = std::find_if(nodeInfos.begin(), nodeInfos.end(), [&info](const NodeInfo& nodeInfo) {
+                return nodeInfo.nodeName == info.gatherFromNode.value();
+            });
+            node->setGatherCount(demultiplexer->demultiplyCount.value());
+        }
+        if (info.condition) {
+            node->setCondition(info.condition.value());
+        }
+    }
     for (const auto& kv : connections) {
-        const auto& dependantNode = nodes.at(kv.first);
+        const auto& dependantNode = nodesByName.at(kv.first);
         for (const auto& pair : kv.second) {
-            const auto& dependencyNode = nodes.at(pair.first);
+            const auto& dependencyNode = nodesByName.at(pair.first);
             SPDLOG_DEBUG("Connecting from:{}, to:{}", dependencyNode->getName(), dependantNode->getName());
             Pipeline::connect(*dependencyNode, *dependantNode, pair.second);
         }
     }
-    pipeline = std::make_unique<Pipeline>(*entry, *exit, pipelineName);
-    for (auto& kv : nodes) {
-        pipeline->push(std::move(kv.second));
+    nodes.reserve(nodeInfos.size());
+    for (const auto& info : nodeInfos) {
+        nodes.emplace_back(std::move(nodesByName.at(info.nodeName)));
     }
+}
+
+Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
+    const tensorflow::serving::PredictRequest* request,
+    tensorflow::serving::PredictResponse* response,
+    ModelManager& manager) const {
+    std::vector<std::unique_ptr<Node>> nodes;
+    {
+        std::lock_guard<std::mutex> lock(nodesPool->mtx);
+        if (!nodesPool->idleNodes.empty()) {
+            nodes = std::move(nodesPool->idleNodes.back());
+            nodesPool->idleNodes.pop_back();
+        }
+    }
+    if (nodes.empty()) {
+        SPDLOG_DEBUG("No idle nodes of pipeline:{}, creating new ones", pipelineName);
+        createNodes(nodes, manager);
+    }
+    auto& entry = static_cast<EntryNode&>(*nodes[entryIndex]);
+    auto& exit = static_cast<ExitNode&>(*nodes[exitIndex]);
+    entry.setRequest(request);
+    exit.setResponse(response);
+
+    pipeline = std::make_unique<Pipeline>(entry, exit, pipelineName);
+    for (auto& node : nodes) {
+        pipeline->push(std::move(node));
+    }
+    std::weak_ptr<NodesPool> pool = nodesPool;
+    pipeline->setRecycler([pool](std::vector<std::unique_ptr<Node>>&& nodes) {
+        // nodes are destroyed if definition was already destroyed
+        auto nodesPool = pool.lock();
+        if (!nodesPool) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(nodesPool->mtx);
+        if (nodesPool->idleNodes.size() < MAX_IDLE_NODES_SETS) {
+            nodesPool->idleNodes.emplace_back(std::move(nodes));
+        }
+    });
     return StatusCode::OK;
 }
 
@@ -107,9 +163,48 @@ Status PipelineDefinition::validateNode(ModelManager& manager, NodeInfo& node) {
             }
         }
 
+        if (!node.device.empty() && !nodeModelInstance->runsOnDevice(node.device)) {
+            SPDLOG_ERROR("Validation of pipeline({}) definition failed. Node name {} requested device {} which is neither target device nor replica device of model {}",
+                this->pipelineName, node.nodeName, node.device, node.modelName);
+            return StatusCode::PIPELINE_NODE_DEVICE_UNAVAILABLE;
+        }
+
         nodeInputs = nodeModelInstance->getInputsInfo();
     }
 
+    if (node.kind == NodeKind::CUSTOM && node.library == nullptr) {
+        SPDLOG_ERROR("Validation of pipeline({}) definition failed. Custom node: {} has no library loaded", this->pipelineName, node.nodeName);
+        return StatusCode::NODE_LIBRARY_LOAD_FAILED;
+    }
+    if (node.demultiplyCount && (node.kind != NodeKind::DL || node.demultiplyCount.value() == 0)) {
+        SPDLOG_ERROR("Validation of pipeline({}) definition failed. Node: {} demultiply count must be positive and set only for DL model nodes", this->pipelineName, node.nodeName);
+        return StatusCode::PIPELINE_DEMULTIPLY_COUNT_INVALID;
+    }
+    if (node.gatherFromNode) {
+        const auto& gatherFromNodeName = node.gatherFromNode.value();
+        auto demultiplexer = std::find_if(std::begin(nodeInfos), std::end(nodeInfos), [&gatherFromNodeName](const NodeInfo& nodeInfo) {
+            return nodeInfo.nodeName == gatherFromNodeName;
+        });
+        if (demultiplexer == std::end(nodeInfos) || !demultiplexer->demultiplyCount) {
+            SPDLOG_ERROR("Validation of pipeline({}) definition failed. Node: {} gathers from node: {} which is not a demultiplexer", this->pipelineName, node.nodeName, gatherFromNodeName);
+            return StatusCode::PIPELINE_GATHER_FROM_NOT_DEMULTIPLEXER;
+        }
+    }
+
+    if (node.condition) {
+        const auto& conditionInput = node.condition->inputName;
+        const auto& nodeConnections = connections[node.nodeName];
+        bool inputConnected = std::any_of(nodeConnections.begin(), nodeConnections.end(), [&conditionInput](const auto& connection) {
+            return std::any_of(connection.second.begin(), connection.second.end(), [&conditionInput](const auto& pair) {
+                return pair.second == conditionInput;
+            });
+        });
+        if (node.kind == NodeKind::ENTRY || node.kind == NodeKind::EXIT || !inputConnected) {
+            SPDLOG_ERROR("Validation of pipeline({}) definition failed. Node: {} has condition on input: {} which it does not receive from dependencies", this->pipelineName, node.nodeName, conditionInput);
+            return StatusCode::PIPELINE_CONDITION_INVALID;
+        }
+    }
+
     for (auto& connection : connections[node.nodeName]) {
         std::unique_ptr<ModelInstanceUnloadGuard> sourceNodeModelInstanceUnloadGuard;
         const std::string& sourceNodeName = connection.first;
@@ -150,6 +245,14 @@ Status PipelineDefinition::validateNode(ModelManager& manager, NodeInfo& node) {
                     SPDLOG_ERROR("Validation of pipeline({}) definition failed. Missing output: {} of model: {}", this->pipelineName, dependencyOutputName, sourceNodeModelInstance->getName());
                     return StatusCode::INVALID_MISSING_OUTPUT;
                 }
+                if (sourceNodeInfo->demultiplyCount) {
+                    const auto& outputShape = dependencyOutput->second->getShape();
+                    if (outputShape.size() < 2 || outputShape[0] != 1 || outputShape[1] != sourceNodeInfo->demultiplyCount.value()) {
+                        SPDLOG_ERROR("Validation of pipeline({}) definition failed. Output: {} of demultiplexer node: {} has shape: {}, expected: (1,{},...)",
+                            this->pipelineName, dependencyOutputName, sourceNodeName, TensorInfo::shapeToString(outputShape), sourceNodeInfo->demultiplyCount.value());
+                        return StatusCode::PIPELINE_DEMULTIPLEXER_INVALID_OUTPUT_SHAPE;
+                    }
+                }
 
                 if (node.kind != NodeKind::DL) {
                     break;
@@ -166,6 +269,45 @@ Status PipelineDefinition::validateNode(ModelManager& manager, NodeInfo& node) {
     return StatusCode::OK;
 }
 
+Status PipelineDefinition::getInputsInfo(tensor_map_t& inputsInfo, ModelManager& manager) const {
+    const auto& entryName = nodeInfos[entryIndex].nodeName;
+    std::set<std::string> unresolvedInputs;
+    for (const auto& [dependantName, dependencies] : connections) {
+        auto fromEntry = dependencies.find(entryName);
+        if (fromEntry == dependencies.end()) {
+            continue;
+        }
+        auto dependant = std::find_if(nodeInfos.begin(), nodeInfos.end(), [&dependantName = dependantName](const NodeInfo& nodeInfo) {
+            return nodeInfo.nodeName == dependantName;
+        });
+        for (const auto& [pipelineInputName, nodeInputName] : fromEntry->second) {
+            if (dependant == nodeInfos.end() || dependant->kind != NodeKind::DL) {
+                unresolvedInputs.insert(pipelineInputName);
+                continue;
+            }
+            auto instance = manager.findModelInstance(dependant->modelName, dependant->modelVersion.value_or(0));
+            if (instance == nullptr) {
+                SPDLOG_ERROR("Pipeline: {} input: {} is consumed by missing model: {}", pipelineName, pipelineInputName, dependant->modelName);
+                return StatusCode::MODEL_MISSING;
+            }
+            const auto& modelInputs = instance->getInputsInfo();
+            auto modelInput = modelInputs.find(nodeInputName);
+            if (modelInput == modelInputs.end()) {
+                SPDLOG_ERROR("Pipeline: {} input: {} is consumed by missing input: {} of model: {}", pipelineName, pipelineInputName, nodeInputName, dependant->modelName);
+                return StatusCode::INVALID_MISSING_INPUT;
+            }
+            inputsInfo[pipelineInputName] = modelInput->second;
+        }
+    }
+    for (const auto& name : unresolvedInputs) {
+        if (inputsInfo.count(name) == 0) {
+            SPDLOG_ERROR("Pipeline: {} input: {} is not consumed by any model node", pipelineName, name);
+            return StatusCode::PIPELINE_INPUTS_INFO_UNAVAILABLE;
+        }
+    }
+    return StatusCode::OK;
+}
+
 // Because of the way how pipeline_connections is implemented, this function is using
 // transpose of PipelineDefinition graph.(Transpose contains same cycles as original graph)
 Status PipelineDefinition::validateForCycles() {
@@ -304,7 +446,7 @@ Status PipelineFactory::create(std::unique_ptr<Pipeline>& pipeline,
     tensorflow::serving::PredictResponse* response,
     ModelManager& manager) const {
     if (!definitionExists(name)) {
-        SPDLOG_INFO("Pipeline with requested name:{} does not exist", name);
+        OVMS_REQUEST_DEBUG("Pipeline with requested name:{} does not exist", name);
         return StatusCode::PIPELINE_DEFINITION_NAME_MISSING;
     }
     std::shared_lock lock(definitionsMtx);
@@ -312,4 +454,14 @@ Status PipelineFactory::create(std::unique_ptr<Pipeline>& pipeline,
     lock.unlock();
     return definition.create(pipeline, request, response, manager);
 }
+
+Status PipelineFactory::getInputsInfo(const std::string& name, tensor_map_t& inputsInfo, ModelManager& manager) const {
+    if (!definitionExists(name)) {
+        return StatusCode::PIPELINE_DEFINITION_NAME_MISSING;
+    }
+    std::shared_lock lock(definitionsMtx);
+    auto& definition = *definitions.at(name);
+    lock.unlock();
+    return definition.getInputsInfo(inputsInfo, manager);
+}
 }  // namespace ovms
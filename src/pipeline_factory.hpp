@@ -17,6 +17,8 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
@@ -25,6 +27,8 @@
 
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 
+#include "custom_node_library.hpp"
+#include "nodecondition.hpp"
 #include "pipeline.hpp"
 #include "status.hpp"
 
@@ -37,10 +41,12 @@ using pipeline_connections_t = std::unordered_map<std::string, std::unordered_ma
 enum class NodeKind {
     ENTRY,
     DL,
+    CUSTOM,
     EXIT
 };
 
 const std::string DL_NODE_CONFIG_TYPE = "DL model";
+const std::string CUSTOM_NODE_CONFIG_TYPE = "custom";
 
 Status toNodeKind(const std::string& str, NodeKind& nodeKind);
 
@@ -50,26 +56,56 @@ struct NodeInfo {
     std::string modelName;
     std::optional<model_version_t> modelVersion;
     std::unordered_map<std::string, std::string> outputNameAliases;
+    // node outputs of [1, N, ...] shape are split into N sub-requests for following nodes
+    std::optional<size_t> demultiplyCount;
+    // node inputs are results of sub-requests of this demultiplexer, gathered back into a single tensor
+    std::optional<std::string> gatherFromNode;
+    // library and its parameters used by custom node
+    std::shared_ptr<CustomNodeLibrary> library;
+    std::unordered_map<std::string, std::string> parameters;
+    // DL node runs on network of the model compiled for this device, device is chosen per inference if empty
+    std::string device;
+    // node and its dependants are skipped if condition on node input is not met
+    std::optional<NodeCondition> condition;
 
     NodeInfo(NodeKind kind,
         const std::string& nodeName,
         const std::string& modelName = "",
         std::optional<model_version_t> modelVersion = std::nullopt,
-        std::unordered_map<std::string, std::string> outputNameAliases = {}) :
+        std::unordered_map<std::string, std::string> outputNameAliases = {},
+        std::optional<size_t> demultiplyCount = std::nullopt,
+        std::optional<std::string> gatherFromNode = std::nullopt) :
         kind(kind),
         nodeName(nodeName),
         modelName(modelName),
         modelVersion(modelVersion),
-        outputNameAliases(outputNameAliases) {}
+        outputNameAliases(outputNameAliases),
+        demultiplyCount(demultiplyCount),
+        gatherFromNode(gatherFromNode) {}
 };
 
 class PipelineDefinition {
+    /**
+     * @brief Connected nodes of pipelines which finished, reused by pipelines created for following requests
+     */
+    struct NodesPool {
+        std::mutex mtx;
+        std::vector<std::vector<std::unique_ptr<Node>>> idleNodes;
+    };
+
+    static constexpr size_t MAX_IDLE_NODES_SETS = 64;
+
     std::string pipelineName;
     std::vector<NodeInfo> nodeInfos;
     pipeline_connections_t connections;
+    // nodes are created in order of nodeInfos
+    size_t entryIndex = 0;
+    size_t exitIndex = 0;
+    std::shared_ptr<NodesPool> nodesPool;
 
 private:
     Status validateNode(ModelManager& manager, NodeInfo& node);
+    void createNodes(std::vector<std::unique_ptr<Node>>& nodes, ModelManager& manager) const;
 
 public:
     PipelineDefinition(const std::string& pipelineName,
@@ -77,8 +113,22 @@ public:
         const pipeline_connections_t& connections) :
         pipelineName(pipelineName),
         nodeInfos(nodeInfos),
-        connections(connections) {}
+        connections(connections),
+        nodesPool(std::make_shared<NodesPool>()) {
+        for (size_t i = 0; i < nodeInfos.size(); i++) {
+            if (nodeInfos[i].kind == NodeKind::ENTRY) {
+                entryIndex = i;
+            } else if (nodeInfos[i].kind == NodeKind::EXIT) {
+                exitIndex = i;
+            }
+        }
+    }
 
+    /**
+     * @brief Creates pipeline bound to request and response
+     *
+     * Nodes and connections are built once, pipeline reuses nodes of already destroyed pipeline if any is idle.
+     */
     Status create(std::unique_ptr<Pipeline>& pipeline,
         const tensorflow::serving::PredictRequest* request,
         tensorflow::serving::PredictResponse* response,
@@ -86,6 +136,13 @@ public:
 
     Status validateNodes(ModelManager& manager);
     Status validateForCycles();
+
+    /**
+     * @brief Resolves pipeline inputs to inputs of models of nodes consuming them
+     *
+     * @return PIPELINE_INPUTS_INFO_UNAVAILABLE if an input is consumed only by custom or exit nodes
+     */
+    Status getInputsInfo(tensor_map_t& inputsInfo, ModelManager& manager) const;
 };
 
 class PipelineFactory {
@@ -108,6 +165,8 @@ public:
         const tensorflow::serving::PredictRequest* request,
         tensorflow::serving::PredictResponse* response,
         ModelManager& manager) const;
+
+    Status getInputsInfo(const std::string& name, tensor_map_t& inputsInfo, ModelManager& manager) const;
 };
 
 }  // namespace ovms
@@ -0,0 +1,189 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "pipeline_tracer.hpp"
+
+#include <cmath>
+#include <utility>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+namespace {
+
+struct NodeSpan {
+    const char* name;
+    NodeTracePoint begin;
+    NodeTracePoint end;
+};
+
+const NodeSpan NODE_SPANS[] = {
+    {"waiting for stream", NodeTracePoint::READY, NodeTracePoint::STARTED},
+    {"execution", NodeTracePoint::STARTED, NodeTracePoint::FINISHED},
+    {"fetching results", NodeTracePoint::FINISHED, NodeTracePoint::FETCHED},
+    {"passing inputs", NodeTracePoint::FETCHED, NodeTracePoint::INPUTS_PASSED},
+};
+
+double microsecondsSince(PipelineTrace::clock::time_point epoch, PipelineTrace::clock::time_point timePoint) {
+    return std::chrono::duration<double, std::micro>(timePoint - epoch).count();
+}
+
+void writeMetadataEvent(rapidjson::Writer<rapidjson::StringBuffer>& writer, const char* name, uint64_t pid, size_t tid, const std::string& value) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(name);
+    writer.Key("ph");
+    writer.String("M");
+    writer.Key("pid");
+    writer.Uint64(pid);
+    writer.Key("tid");
+    writer.Uint64(tid);
+    writer.Key("args");
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(value.c_str());
+    writer.EndObject();
+    writer.EndObject();
+}
+
+void writeCompleteEvent(rapidjson::Writer<rapidjson::StringBuffer>& writer, const char* name, uint64_t pid, size_t tid, double ts, double dur) {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(name);
+    writer.Key("cat");
+    writer.String("pipeline");
+    writer.Key("ph");
+    writer.String("X");
+    writer.Key("pid");
+    writer.Uint64(pid);
+    writer.Key("tid");
+    writer.Uint64(tid);
+    writer.Key("ts");
+    writer.Double(ts);
+    writer.Key("dur");
+    writer.Double(dur);
+    writer.EndObject();
+}
+
+}  // namespace
+
+void PipelineTrace::record(const Node& node, NodeTracePoint point) {
+    auto& timeline = this->nodes[node.getIndex()];
+    auto& timePoint = timeline.points[static_cast<size_t>(point)];
+    if (timePoint) {
+        return;
+    }
+    timePoint = clock::now();
+    if (timeline.nodeName.empty()) {
+        timeline.nodeName = node.getName();
+    }
+}
+
+void PipelineTrace::writeChromeTraceEvents(std::ostream& os, uint64_t traceId, clock::time_point epoch) const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    // events are written as array, its brackets are stripped so events are appended to the array of the file
+    writer.StartArray();
+    // thread 0 shows the whole execution, node threads are shifted by one
+    writeMetadataEvent(writer, "process_name", traceId, 0, this->pipelineName + " (" + this->status.string() + ")");
+    writeMetadataEvent(writer, "thread_name", traceId, 0, this->pipelineName);
+    writeCompleteEvent(writer, "pipeline", traceId, 0, microsecondsSince(epoch, this->start), microsecondsSince(this->start, this->end));
+    for (size_t i = 0; i < this->nodes.size(); ++i) {
+        const auto& timeline = this->nodes[i];
+        if (timeline.nodeName.empty()) {
+            // node was never reached
+            continue;
+        }
+        writeMetadataEvent(writer, "thread_name", traceId, i + 1, timeline.nodeName);
+        for (const auto& span : NODE_SPANS) {
+            const auto& begin = timeline.points[static_cast<size_t>(span.begin)];
+            const auto& end = timeline.points[static_cast<size_t>(span.end)];
+            if (!begin || !end) {
+                continue;
+            }
+            writeCompleteEvent(writer, span.name, traceId, i + 1, microsecondsSince(epoch, begin.value()), microsecondsSince(begin.value(), end.value()));
+        }
+    }
+    writer.EndArray();
+    os.write(buffer.GetString() + 1, buffer.GetSize() - 2);
+    os << ",\n";
+}
+
+void PipelineTrace::addTimings(RequestTiming& timing) const {
+    timing.add("pipeline", microsecondsSince(this->start, this->end) / 1000);
+    for (const auto& timeline : this->nodes) {
+        const auto& ready = timeline.points[static_cast<size_t>(NodeTracePoint::READY)];
+        const auto& started = timeline.points[static_cast<size_t>(NodeTracePoint::STARTED)];
+        const auto& finished = timeline.points[static_cast<size_t>(NodeTracePoint::FINISHED)];
+        if (ready && started) {
+            timing.add("node." + timeline.nodeName + ".stream_wait", microsecondsSince(ready.value(), started.value()) / 1000);
+        }
+        if (started && finished) {
+            timing.add("node." + timeline.nodeName, microsecondsSince(started.value(), finished.value()) / 1000);
+        }
+    }
+}
+
+Status PipelineTracer::configure(const std::string& path, float samplingRate) {
+    std::lock_guard<std::mutex> lock(mtx);
+    this->enabled = false;
+    if (this->file.is_open()) {
+        this->file.close();
+    }
+    if (path.empty()) {
+        return StatusCode::OK;
+    }
+    this->file.open(path, std::ios::out | std::ios::trunc);
+    if (!this->file.is_open()) {
+        spdlog::error("Cannot open pipeline trace file: {}", path);
+        return StatusCode::FILE_INVALID;
+    }
+    this->file << "[\n";
+    this->file.flush();
+    this->samplingRate = samplingRate;
+    this->executionsCount = 0;
+    this->tracesCount = 0;
+    this->epoch = PipelineTrace::clock::now();
+    this->enabled = samplingRate > 0;
+    spdlog::info("Tracing {}% of pipeline executions to: {}", samplingRate * 100, path);
+    return StatusCode::OK;
+}
+
+std::unique_ptr<PipelineTrace> PipelineTracer::startTrace(const std::string& pipelineName, size_t nodesCount) {
+    if (!this->enabled) {
+        return nullptr;
+    }
+    // every execution which moves floor(n * rate) is sampled, it spreads traced executions evenly
+    const double rate = this->samplingRate;
+    const uint64_t n = this->executionsCount.fetch_add(1);
+    if (std::floor((n + 1) * rate) == std::floor(n * rate)) {
+        return nullptr;
+    }
+    return std::make_unique<PipelineTrace>(pipelineName, nodesCount);
+}
+
+void PipelineTracer::submit(const PipelineTrace& trace) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!this->file.is_open()) {
+        return;
+    }
+    trace.writeChromeTraceEvents(this->file, ++this->tracesCount, this->epoch);
+    this->file.flush();
+}
+
+}  // namespace ovms
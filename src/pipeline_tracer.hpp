@@ -0,0 +1,135 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "node.hpp"
+#include "requesttiming.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Moments of node execution recorded by pipeline trace, in order of occurrence
+ */
+enum class NodeTracePoint {
+    READY,          /*!< All dependencies finished, node waits for stream if execution is deferred */
+    STARTED,        /*!< Stream acquired and node execution started */
+    FINISHED,       /*!< Pipeline got notified that node finished */
+    FETCHED,        /*!< Results fetched from the node */
+    INPUTS_PASSED,  /*!< Results passed to following nodes, copied if these wait for other dependencies */
+    COUNT
+};
+
+/**
+ * @brief Timeline of a single sampled pipeline execution
+ */
+class PipelineTrace {
+public:
+    using clock = std::chrono::steady_clock;
+
+    PipelineTrace(const std::string& pipelineName, size_t nodesCount) :
+        pipelineName(pipelineName),
+        start(clock::now()),
+        nodes(nodesCount) {}
+
+    /**
+     * @brief Records the moment once, repeated records of the point are ignored
+     */
+    void record(const Node& node, NodeTracePoint point);
+
+    void finish(const Status& status) {
+        this->end = clock::now();
+        this->status = status;
+    }
+
+    /**
+     * @brief Writes execution as Chrome trace events, one process per execution and one thread per node
+     */
+    void writeChromeTraceEvents(std::ostream& os, uint64_t traceId, clock::time_point epoch) const;
+
+    /**
+     * @brief Adds pipeline duration and stream wait and execution durations of reached nodes to request timing
+     */
+    void addTimings(RequestTiming& timing) const;
+
+private:
+    struct NodeTimeline {
+        std::string nodeName;
+        std::array<std::optional<clock::time_point>, static_cast<size_t>(NodeTracePoint::COUNT)> points;
+    };
+
+    const std::string pipelineName;
+    const clock::time_point start;
+    clock::time_point end;
+    Status status;
+    // indexed by node index
+    std::vector<NodeTimeline> nodes;
+};
+
+/**
+ * @brief Samples pipeline executions for tracing and exports their timelines to Chrome trace file
+ *
+ * Trace file can be opened with chrome://tracing or Perfetto, it is a JSON array of events left open
+ * so events of executions finishing later can be appended.
+ */
+class PipelineTracer {
+public:
+    static PipelineTracer& getInstance() {
+        static PipelineTracer instance;
+        return instance;
+    }
+
+    /**
+     * @brief Enables tracing of samplingRate fraction of executions, empty path disables tracing
+     */
+    Status configure(const std::string& path, float samplingRate);
+
+    /**
+     * @brief Starts trace if execution is sampled
+     *
+     * @return trace or nullptr if execution is not traced
+     */
+    std::unique_ptr<PipelineTrace> startTrace(const std::string& pipelineName, size_t nodesCount);
+
+    /**
+     * @brief Writes finished trace to trace file
+     */
+    void submit(const PipelineTrace& trace);
+
+private:
+    PipelineTracer() = default;
+
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> executionsCount{0};
+    std::atomic<float> samplingRate{0};
+
+    std::mutex mtx;
+    std::ofstream file;
+    uint64_t tracesCount = 0;
+    PipelineTrace::clock::time_point epoch;
+};
+
+}  // namespace ovms
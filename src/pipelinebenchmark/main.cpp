@@ -0,0 +1,101 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cxxopts.hpp>
+
+#include "../modelmanager.hpp"
+#include "pipelinebenchmark.hpp"
+
+using namespace ovms;
+using namespace ovms::pipelinebenchmark;
+
+int main(int argc, char** argv) {
+    cxxopts::Options options(argv[0], "OpenVINO Model Server in process pipeline benchmark");
+    // clang-format off
+    options.add_options()
+        ("help", "show this help message and exit")
+        ("config_path", "server configuration file with models and pipeline definitions",
+            cxxopts::value<std::string>(), "CONFIG_PATH")
+        ("pipeline_name", "name of benchmarked pipeline",
+            cxxopts::value<std::string>(), "PIPELINE_NAME")
+        ("concurrency", "comma separated numbers of pipelines executed concurrently, each level is benchmarked in turn",
+            cxxopts::value<std::string>()->default_value("1,2,4,8"), "CONCURRENCY")
+        ("duration", "seconds of benchmarking each concurrency level",
+            cxxopts::value<uint>()->default_value("10"), "DURATION")
+        ("warmup", "seconds of executing pipelines before each concurrency level, not included in results",
+            cxxopts::value<uint>()->default_value("2"), "WARMUP");
+    // clang-format on
+
+    std::unique_ptr<cxxopts::ParseResult> result;
+    try {
+        result = std::make_unique<cxxopts::ParseResult>(options.parse(argc, argv));
+    } catch (const cxxopts::OptionException& e) {
+        std::cerr << "error parsing options: " << e.what() << std::endl;
+        return 1;
+    }
+    if (result->count("help") || !result->count("config_path") || !result->count("pipeline_name")) {
+        std::cout << options.help() << std::endl;
+        return result->count("help") ? 0 : 1;
+    }
+
+    std::vector<size_t> concurrencies;
+    std::stringstream levels((*result)["concurrency"].as<std::string>());
+    std::string level;
+    while (std::getline(levels, level, ',')) {
+        try {
+            concurrencies.push_back(std::stoul(level));
+        } catch (const std::exception&) {
+            concurrencies.push_back(0);
+        }
+        if (concurrencies.back() == 0) {
+            std::cerr << "concurrency must be comma separated positive numbers" << std::endl;
+            return 1;
+        }
+    }
+
+    auto& manager = ModelManager::getInstance();
+    auto status = manager.startFromFile((*result)["config_path"].as<std::string>());
+    if (!status.ok()) {
+        std::cerr << "loading configuration failed: " << status.string() << std::endl;
+        return 1;
+    }
+    const auto pipelineName = (*result)["pipeline_name"].as<std::string>();
+    PipelineBenchmark benchmark(manager.getPipelineFactory(), manager, pipelineName);
+    status = benchmark.prepareRequest();
+    if (!status.ok()) {
+        std::cerr << "preparing inputs of pipeline " << pipelineName << " failed: " << status.string() << std::endl;
+        manager.join();
+        return 1;
+    }
+
+    const std::chrono::seconds duration((*result)["duration"].as<uint>());
+    const std::chrono::seconds warmup((*result)["warmup"].as<uint>());
+    for (const auto concurrency : concurrencies) {
+        BenchmarkResult levelResult;
+        if (warmup.count() > 0) {
+            benchmark.run(concurrency, warmup, levelResult);
+        }
+        benchmark.run(concurrency, duration, levelResult);
+        PipelineBenchmark::printReport(std::cout, levelResult);
+    }
+    manager.join();
+    return 0;
+}
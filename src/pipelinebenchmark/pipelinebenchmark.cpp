@@ -0,0 +1,141 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "pipelinebenchmark.hpp"
+
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/core/framework/types.h"
+
+#include "../modelmanager.hpp"
+#include "../pipeline.hpp"
+#include "../pipeline_factory.hpp"
+#include "../requesttiming.hpp"
+
+namespace ovms {
+namespace pipelinebenchmark {
+
+Status PipelineBenchmark::prepareRequest() {
+    tensor_map_t inputsInfo;
+    auto status = factory.getInputsInfo(pipelineName, inputsInfo, manager);
+    if (!status.ok()) {
+        return status;
+    }
+    request.Clear();
+    request.mutable_model_spec()->set_name(pipelineName);
+    for (const auto& [name, info] : inputsInfo) {
+        auto& input = (*request.mutable_inputs())[name];
+        const auto dtype = info->getPrecisionAsDataType();
+        input.set_dtype(dtype);
+        size_t elements = 1;
+        for (const auto dim : info->getShape()) {
+            // dynamic dimensions are benchmarked with size 1
+            const size_t size = dim > 0 ? dim : 1;
+            input.mutable_tensor_shape()->add_dim()->set_size(size);
+            elements *= size;
+        }
+        // server reads these precisions from repeated fields
+        if (dtype == tensorflow::DataType::DT_HALF) {
+            input.mutable_half_val()->Resize(elements, 0);
+        } else if (dtype == tensorflow::DataType::DT_UINT16) {
+            input.mutable_int_val()->Resize(elements, 0);
+        } else {
+            input.mutable_tensor_content()->assign(elements * tensorflow::DataTypeSize(dtype), '\0');
+        }
+    }
+    return StatusCode::OK;
+}
+
+void PipelineBenchmark::run(size_t concurrency, std::chrono::milliseconds duration, BenchmarkResult& result) const {
+    using std::chrono::steady_clock;
+    std::vector<BenchmarkResult> threadResults(concurrency);
+    std::vector<std::thread> threads;
+    const auto start = steady_clock::now();
+    const auto end = start + duration;
+    for (size_t i = 0; i < concurrency; ++i) {
+        threads.emplace_back([this, end, &threadResult = threadResults[i]]() {
+            while (steady_clock::now() < end) {
+                const auto executionStart = steady_clock::now();
+                tensorflow::serving::PredictResponse response;
+                std::unique_ptr<Pipeline> pipeline;
+                RequestTiming timing;
+                auto status = factory.create(pipeline, pipelineName, &request, &response, manager);
+                if (status.ok()) {
+                    status = pipeline->execute(&timing);
+                }
+                if (!status.ok()) {
+                    ++threadResult.errors[status.string()];
+                    continue;
+                }
+                threadResult.latency.record(std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - executionStart).count());
+                for (const auto& [stage, milliseconds] : timing.getStages()) {
+                    if (stage != "pipeline") {
+                        threadResult.stages[stage].record(static_cast<uint64_t>(milliseconds * 1000));
+                    }
+                }
+                ++threadResult.succeeded;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    result = BenchmarkResult();
+    result.concurrency = concurrency;
+    result.elapsed = steady_clock::now() - start;
+    for (const auto& threadResult : threadResults) {
+        result.succeeded += threadResult.succeeded;
+        result.latency.merge(threadResult.latency);
+        for (const auto& [stage, histogram] : threadResult.stages) {
+            result.stages[stage].merge(histogram);
+        }
+        for (const auto& [error, count] : threadResult.errors) {
+            result.errors[error] += count;
+        }
+    }
+}
+
+namespace {
+void printLatency(std::ostream& out, const loadgen::LatencyHistogram& latency) {
+    out << std::setprecision(3)
+        << "p50: " << latency.getValueAtPercentile(50) / 1000.0
+        << ", p90: " << latency.getValueAtPercentile(90) / 1000.0
+        << ", p99: " << latency.getValueAtPercentile(99) / 1000.0
+        << ", max: " << latency.getMax() / 1000.0
+        << ", mean: " << latency.getMean() / 1000.0 << "\n";
+}
+}  // namespace
+
+void PipelineBenchmark::printReport(std::ostream& out, const BenchmarkResult& result) {
+    out << "concurrency: " << result.concurrency << "\n"
+        << std::fixed << std::setprecision(1)
+        << "  succeeded: " << result.succeeded << ", throughput: " << result.getThroughput() << " pipelines/s\n"
+        << "  end to end latency [ms] ";
+    printLatency(out, result.latency);
+    for (const auto& [stage, latency] : result.stages) {
+        out << "  " << stage << std::setprecision(1) << " throughput: " << latency.getCount() / result.elapsed.count()
+            << " executions/s, latency [ms] ";
+        printLatency(out, latency);
+    }
+    for (const auto& [error, count] : result.errors) {
+        out << "  error " << error << ": " << count << "\n";
+    }
+}
+
+}  // namespace pipelinebenchmark
+}  // namespace ovms
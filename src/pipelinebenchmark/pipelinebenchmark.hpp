@@ -0,0 +1,88 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "../loadgen/latencyhistogram.hpp"
+#include "../status.hpp"
+
+namespace ovms {
+
+class ModelManager;
+class PipelineFactory;
+
+namespace pipelinebenchmark {
+
+/**
+ * @brief Results of pipeline executions at single concurrency level, latencies are in microseconds
+ */
+struct BenchmarkResult {
+    size_t concurrency = 0;
+    std::chrono::duration<double> elapsed{0};
+    uint64_t succeeded = 0;
+    // keyed by status messages
+    std::map<std::string, uint64_t> errors;
+    loadgen::LatencyHistogram latency;
+    // keyed by timing stages of nodes, e.g. node.<name> and node.<name>.stream_wait
+    std::map<std::string, loadgen::LatencyHistogram> stages;
+
+    double getThroughput() const {
+        return elapsed.count() > 0 ? succeeded / elapsed.count() : 0;
+    }
+};
+
+/**
+ * @brief Executes a pipeline in process with synthetic inputs in closed loop, bypassing gRPC and REST
+ *
+ * Inputs are shaped after inputs of models consuming pipeline inputs. Each of concurrency threads creates
+ * and executes pipelines one after another, so concurrency equals pipelines in progress.
+ */
+class PipelineBenchmark {
+public:
+    PipelineBenchmark(const PipelineFactory& factory, ModelManager& manager, const std::string& pipelineName) :
+        factory(factory),
+        manager(manager),
+        pipelineName(pipelineName) {}
+
+    /**
+     * @brief Builds synthetic request, must succeed before run
+     */
+    Status prepareRequest();
+
+    const tensorflow::serving::PredictRequest& getRequest() const { return request; }
+
+    /**
+     * @brief Executes pipelines in concurrency threads for duration
+     */
+    void run(size_t concurrency, std::chrono::milliseconds duration, BenchmarkResult& result) const;
+
+    static void printReport(std::ostream& out, const BenchmarkResult& result);
+
+private:
+    const PipelineFactory& factory;
+    ModelManager& manager;
+    const std::string pipelineName;
+    tensorflow::serving::PredictRequest request;
+};
+
+}  // namespace pipelinebenchmark
+}  // namespace ovms
@@ -0,0 +1,190 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "postprocessing.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "tensorconversion.hpp"
+
+namespace ovms {
+
+const char* const POSTPROCESSING_INDICES_SUFFIX = "_indices";
+
+namespace {
+// scores are scanned in chunks, chunks without a score above the current K-th best are skipped with one comparison
+const size_t SCAN_CHUNK_SIZE = 16;
+
+void selectTopKRow(const float* scores, size_t classes, size_t k, float* topScores, int32_t* topIndices) {
+    size_t selected = 0;
+    for (size_t chunkBegin = 0; chunkBegin < classes; chunkBegin += SCAN_CHUNK_SIZE) {
+        const size_t chunkEnd = std::min(chunkBegin + SCAN_CHUNK_SIZE, classes);
+        if (selected == k) {
+            float chunkMax = scores[chunkBegin];
+            for (size_t i = chunkBegin + 1; i < chunkEnd; ++i) {
+                chunkMax = std::max(chunkMax, scores[i]);
+            }
+            if (!(chunkMax > topScores[k - 1])) {
+                continue;
+            }
+        }
+        for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+            const float score = scores[i];
+            if (selected == k && !(score > topScores[k - 1])) {
+                continue;
+            }
+            // keeps earlier classes first among equal scores
+            size_t position = selected < k ? selected++ : k - 1;
+            while (position > 0 && score > topScores[position - 1]) {
+                topScores[position] = topScores[position - 1];
+                topIndices[position] = topIndices[position - 1];
+                --position;
+            }
+            topScores[position] = score;
+            topIndices[position] = static_cast<int32_t>(i);
+        }
+    }
+}
+}  // namespace
+
+Status validatePostprocessing(const postprocessing_map_t& postprocessing, const tensor_map_t& outputsInfo) {
+    for (const auto& [name, info] : postprocessing) {
+        auto it = outputsInfo.find(name);
+        if (it == outputsInfo.end()) {
+            spdlog::error("Postprocessed output {} not found in network", name);
+            return StatusCode::INVALID_POSTPROCESSING_OUTPUT;
+        }
+        const auto& shape = it->second->getShape();
+        if (it->second->getPrecision() != InferenceEngine::Precision::FP32 || shape.empty() || shape.back() < info.topK) {
+            spdlog::error("Postprocessed output {} must have FP32 precision and at least {} classes in last dimension", name, info.topK);
+            return StatusCode::INVALID_POSTPROCESSING_OUTPUT;
+        }
+        if (outputsInfo.count(name + POSTPROCESSING_INDICES_SUFFIX)) {
+            spdlog::error("Indices of postprocessed output {} collide with output {}{}", name, name, POSTPROCESSING_INDICES_SUFFIX);
+            return StatusCode::INVALID_POSTPROCESSING_OUTPUT;
+        }
+    }
+    return StatusCode::OK;
+}
+
+void selectTopK(const float* scores, size_t rows, size_t classes, const OutputPostprocessingInfo& postprocessing, float* topScores, int32_t* topIndices) {
+    const size_t k = postprocessing.topK;
+    for (size_t row = 0; row < rows; ++row) {
+        float* rowScores = topScores + row * k;
+        int32_t* rowIndices = topIndices + row * k;
+        if (k == 1) {
+            const float* best = std::max_element(scores + row * classes, scores + (row + 1) * classes);
+            rowScores[0] = *best;
+            rowIndices[0] = static_cast<int32_t>(best - (scores + row * classes));
+        } else {
+            selectTopKRow(scores + row * classes, classes, k, rowScores, rowIndices);
+        }
+        for (size_t i = 0; i < k; ++i) {
+            if (rowScores[i] < postprocessing.minScore) {
+                rowScores[i] = 0;
+                rowIndices[i] = -1;
+            }
+        }
+    }
+}
+
+Status postprocessResponse(const postprocessing_map_t& postprocessing, tensorflow::serving::PredictResponse& response) {
+    for (const auto& [name, info] : postprocessing) {
+        auto it = response.mutable_outputs()->find(name);
+        if (it == response.mutable_outputs()->end()) {
+            continue;
+        }
+        auto& output = it->second;
+        const auto& shape = output.tensor_shape();
+        if (output.dtype() != tensorflow::DataType::DT_FLOAT || shape.dim_size() == 0) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_ERROR("{}: postprocessed output {} is not FP32", status.string(), name);
+            return status;
+        }
+        const size_t classes = static_cast<size_t>(shape.dim(shape.dim_size() - 1).size());
+        const size_t rows = classes > 0 ? output.tensor_content().size() / sizeof(float) / classes : 0;
+        if (classes < info.topK || rows * classes * sizeof(float) != output.tensor_content().size()) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_ERROR("{}: postprocessed output {} has unexpected size", status.string(), name);
+            return status;
+        }
+
+        tensorflow::TensorProto indices;
+        indices.set_dtype(tensorflow::DataType::DT_INT32);
+        *indices.mutable_tensor_shape() = shape;
+        indices.mutable_tensor_shape()->mutable_dim(shape.dim_size() - 1)->set_size(info.topK);
+        indices.mutable_tensor_content()->resize(rows * info.topK * sizeof(int32_t));
+        std::string topScores(rows * info.topK * sizeof(float), '\0');
+        selectTopK(reinterpret_cast<const float*>(output.tensor_content().data()), rows, classes, info,
+            reinterpret_cast<float*>(&topScores[0]), reinterpret_cast<int32_t*>(&(*indices.mutable_tensor_content())[0]));
+
+        output.mutable_tensor_shape()->mutable_dim(shape.dim_size() - 1)->set_size(info.topK);
+        output.mutable_tensor_content()->swap(topScores);
+        (*response.mutable_outputs())[name + POSTPROCESSING_INDICES_SUFFIX] = std::move(indices);
+    }
+    return StatusCode::OK;
+}
+
+Status validateOutputPrecision(const precisions_map_t& outputPrecisions, const tensor_map_t& outputsInfo) {
+    for (const auto& [name, precision] : outputPrecisions) {
+        auto it = outputsInfo.find(name);
+        if (it == outputsInfo.end() || it->second->getPrecision() != InferenceEngine::Precision::FP32) {
+            spdlog::error("Output {} with response precision {} not found in network or not FP32", name, precision);
+            return StatusCode::INVALID_OUTPUT_PRECISION;
+        }
+    }
+    return StatusCode::OK;
+}
+
+Status convertOutputPrecision(const std::string& outputPrecision, const precisions_map_t& outputPrecisions, tensorflow::serving::PredictResponse& response) {
+    if (outputPrecision.empty() && outputPrecisions.empty()) {
+        return StatusCode::OK;
+    }
+    for (auto& [name, output] : *response.mutable_outputs()) {
+        const std::string* precision = &outputPrecision;
+        if (outputPrecision.empty()) {
+            auto it = outputPrecisions.find(name);
+            if (it == outputPrecisions.end()) {
+                continue;
+            }
+            precision = &it->second;
+        }
+        if (*precision == "FP32" || output.dtype() != tensorflow::DataType::DT_FLOAT || output.tensor_content().size() % sizeof(float) != 0) {
+            continue;
+        }
+        const size_t count = output.tensor_content().size() / sizeof(float);
+        std::string converted(count * sizeof(uint16_t), '\0');
+        const float* source = reinterpret_cast<const float*>(output.tensor_content().data());
+        uint16_t* destination = reinterpret_cast<uint16_t*>(&converted[0]);
+        if (*precision == "FP16") {
+            floatToHalf(source, destination, count);
+            output.set_dtype(tensorflow::DataType::DT_HALF);
+        } else if (*precision == "BF16") {
+            floatToBfloat16(source, destination, count);
+            output.set_dtype(tensorflow::DataType::DT_BFLOAT16);
+        } else {
+            Status status = StatusCode::INVALID_OUTPUT_PRECISION;
+            SPDLOG_ERROR("{}: {} of output {}", status.string(), *precision, name);
+            return status;
+        }
+        output.mutable_tensor_content()->swap(converted);
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
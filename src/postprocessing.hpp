@@ -0,0 +1,66 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "modelconfig.hpp"
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Suffix of response output holding indices of scores kept by postprocessing
+ */
+extern const char* const POSTPROCESSING_INDICES_SUFFIX;
+
+/**
+ * @brief Checks that postprocessed outputs exist, have FP32 precision and at least top K classes in the last dimension
+ */
+Status validatePostprocessing(const postprocessing_map_t& postprocessing, const tensor_map_t& outputsInfo);
+
+/**
+ * @brief Selects top K scores of each row of rows x classes scores, in descending order
+ *
+ * Scores below min score are returned with index -1, so every row has K entries.
+ * Ties are ordered by lower index first.
+ */
+void selectTopK(const float* scores, size_t rows, size_t classes, const OutputPostprocessingInfo& postprocessing, float* topScores, int32_t* topIndices);
+
+/**
+ * @brief Replaces scores of postprocessed outputs in response with top K scores, and adds their indices as output
+ * with POSTPROCESSING_INDICES_SUFFIX suffix. Outputs missing in response are skipped.
+ */
+Status postprocessResponse(const postprocessing_map_t& postprocessing, tensorflow::serving::PredictResponse& response);
+
+/**
+ * @brief Checks that outputs with configured response precision exist in network and have FP32 precision
+ */
+Status validateOutputPrecision(const precisions_map_t& outputPrecisions, const tensor_map_t& outputsInfo);
+
+/**
+ * @brief Converts FP32 outputs of response to FP16 or BF16 tensor_content, either all of them or the named ones
+ *
+ * Outputs of other precisions and outputs with FP32 response precision stay unchanged.
+ */
+Status convertOutputPrecision(const std::string& outputPrecision, const precisions_map_t& outputPrecisions, tensorflow::serving::PredictResponse& response);
+
+}  // namespace ovms
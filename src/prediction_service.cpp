@@ -18,6 +18,7 @@
 #include <condition_variable>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include <inference_engine.hpp>
@@ -25,14 +26,21 @@
 
 #include "tensorflow/core/framework/tensor.h"
 
+#include "compression.hpp"
 #include "get_model_metadata_impl.hpp"
+#include "metrics.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "modelmanager.hpp"
 #include "ovinferrequestsqueue.hpp"
+#include "peerrouting.hpp"
 #include "prediction_service_utils.hpp"
+#include "requestdeadline.hpp"
+#include "requestlogging.hpp"
+#include "requesttiming.hpp"
+#include "sequencemanager.hpp"
 #include "status.hpp"
+#include "tenantscheduling.hpp"
 
-#define DEBUG
 #include "timer.hpp"
 
 using grpc::ServerContext;
@@ -51,7 +59,8 @@ Status getModelInstance(const PredictRequest* request,
     std::shared_ptr<ovms::ModelInstance>& modelInstance,
     std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) {
     ModelManager& manager = ModelManager::getInstance();
-    return getModelInstance(manager, request->model_spec().name(), request->model_spec().version().value(), modelInstance, modelInstanceUnloadGuardPtr);
+    return getModelInstance(manager, request->model_spec().name(), request->model_spec().version().value(), modelInstance, modelInstanceUnloadGuardPtr,
+        getContinuedSequenceId(*request));
 }
 
 Status getPipeline(const PredictRequest* request,
@@ -61,44 +70,95 @@ Status getPipeline(const PredictRequest* request,
     return getPipeline(manager, pipelinePtr, request, response);
 }
 
+Status getRequestPriority(const grpc::ServerContext& context, RequestPriority& priority) {
+    priority = RequestPriority::HIGH;
+    auto it = context.client_metadata().find(REQUEST_PRIORITY_HEADER);
+    if (it == context.client_metadata().end()) {
+        return StatusCode::OK;
+    }
+    return parseRequestPriority(std::string_view(it->second.data(), it->second.size()), priority);
+}
+
+std::string getRequestTenant(const grpc::ServerContext& context) {
+    auto it = context.client_metadata().find(REQUEST_TENANT_HEADER);
+    if (it == context.client_metadata().end()) {
+        return std::string();
+    }
+    return std::string(it->second.data(), it->second.size());
+}
+
 grpc::Status ovms::PredictionServiceImpl::Predict(
     ServerContext* context,
     const PredictRequest* request,
     PredictResponse* response) {
-    Timer timer;
-    timer.start("total");
-    using std::chrono::microseconds;
-    spdlog::debug("Processing gRPC request for model: {}; version: {}",
+    enum : size_t { TOTAL, TIMER_END };
+    Timer<TIMER_END> timer;
+    timer.start(TOTAL);
+    static Histogram& duration = MetricsRegistry::getInstance().histogram("ovms_predict_duration_seconds",
+        "Duration of successful predict requests", {{"api", "grpc"}}, MetricsRegistry::LATENCY_BUCKETS_SECONDS);
+    OVMS_REQUEST_DEBUG("Processing gRPC request for model: {}; version: {}",
         request->model_spec().name(),
         request->model_spec().version().value());
 
     std::shared_ptr<ovms::ModelInstance> modelInstance;
     std::unique_ptr<ovms::Pipeline> pipelinePtr;
 
+    // synchronous handler thread can poll cancellation of its call
+    const auto deadline = RequestDeadline::fromGrpcContext(*context, true);
+    auto status = deadline.check();
+    if (!status.ok()) {
+        return status.grpc();
+    }
+    RequestPriority priority;
+    status = getRequestPriority(*context, priority);
+    if (!status.ok()) {
+        return status.grpc();
+    }
+    const std::string tenant = getRequestTenant(*context);
+    status = Tenants::getInstance().admit(tenant);
+    if (!status.ok()) {
+        return status.grpc();
+    }
     std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
-    auto status = getModelInstance(request, modelInstance, modelInstanceUnloadGuard);
+    status = getModelInstance(request, modelInstance, modelInstanceUnloadGuard);
 
     if (status == StatusCode::MODEL_NAME_MISSING) {
-        SPDLOG_INFO("Requested model: {} does not exist. Searching for pipeline with that name...", request->model_spec().name());
+        OVMS_REQUEST_DEBUG("Requested model: {} does not exist. Searching for pipeline with that name...", request->model_spec().name());
         status = getPipeline(request, response, pipelinePtr);
     }
+    if ((status == StatusCode::MODEL_NAME_MISSING || status == StatusCode::MODEL_VERSION_MISSING) && PeerRouter::getInstance().isEnabled()) {
+        grpc::Status peerStatus;
+        if (PeerRouter::getInstance().forward(*context, *request, *response, peerStatus).ok()) {
+            return peerStatus;
+        }
+    }
     if (!status.ok()) {
-        SPDLOG_INFO("Getting modelInstance or pipeline failed. {}", status.string());
+        OVMS_REQUEST_DEBUG("Getting modelInstance or pipeline failed. {}", status.string());
         return status.grpc();
     }
 
+    std::unique_ptr<RequestTiming> timing;
+    if (context->client_metadata().count(RequestTiming::REQUEST_HEADER) > 0) {
+        timing = std::make_unique<RequestTiming>();
+    }
     if (pipelinePtr) {
-        status = pipelinePtr->execute();
+        status = pipelinePtr->execute(timing.get(), &deadline);
     } else {
-        status = inference(*modelInstance, request, response, modelInstanceUnloadGuard);
+        status = inference(*modelInstance, request, response, modelInstanceUnloadGuard, timing.get(), &deadline, priority, tenant);
+    }
+    if (timing) {
+        context->AddTrailingMetadata(RequestTiming::RESPONSE_HEADER, timing->serialize());
     }
 
     if (!status.ok()) {
         return status.grpc();
     }
 
-    timer.stop("total");
-    spdlog::debug("Total gRPC request processing time: {} ms", timer.elapsed<microseconds>("total") / 1000);
+    setGrpcResponseCompression(*context, response->ByteSizeLong());
+
+    timer.stop(TOTAL);
+    duration.observe(timer.elapsedSeconds(TOTAL));
+    OVMS_REQUEST_DEBUG("Total gRPC request processing time: {} ms", timer.elapsed<std::chrono::milliseconds>(TOTAL));
     return grpc::Status::OK;
 }
 
@@ -15,13 +15,29 @@
 //*****************************************************************************
 #pragma once
 
+#include <string>
+
 #include <grpcpp/server_context.h>
 
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 
+#include "ovinferrequestsqueue.hpp"
+#include "status.hpp"
+
 namespace ovms {
 
-class PredictionServiceImpl final : public tensorflow::serving::PredictionService::Service {
+/**
+ * @brief Reads priority class of the call from its metadata, high if it is not set
+ */
+Status getRequestPriority(const grpc::ServerContext& context, RequestPriority& priority);
+
+/**
+ * @brief Reads tenant of the call from its metadata, empty if it is not set
+ */
+std::string getRequestTenant(const grpc::ServerContext& context);
+
+class PredictionServiceImpl : public tensorflow::serving::PredictionService::Service {
+public:
     grpc::Status Predict(
         grpc::ServerContext* context,
         const tensorflow::serving::PredictRequest* request,
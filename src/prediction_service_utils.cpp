@@ -15,16 +15,37 @@
 //*****************************************************************************
 #include "prediction_service_utils.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "batchingscheduler.hpp"
+#include "cpuaffinity.hpp"
 #include "deserialization.hpp"
 #include "executinstreamidguard.hpp"
+#include "hedging.hpp"
+#include "microbatching.hpp"
 #include "modelinstance.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "modelmanager.hpp"
+#include "modelmetrics.hpp"
+#include "postprocessing.hpp"
+#include "requestcoalescer.hpp"
+#include "requestdeadline.hpp"
+#include "responsecache.hpp"
+#include "requestlogging.hpp"
+#include "requesttiming.hpp"
+#include "sequencemanager.hpp"
 #include "serialization.hpp"
-
-#define DEBUG
+#include "shapebuckets.hpp"
+#include "tenantscheduling.hpp"
 #include "timer.hpp"
 
 using tensorflow::serving::PredictRequest;
@@ -32,6 +53,19 @@ using tensorflow::serving::PredictResponse;
 
 namespace ovms {
 
+const std::string REQUEST_PRIORITY_HEADER = "ovms-priority";
+
+Status parseRequestPriority(std::string_view value, RequestPriority& priority) {
+    if (value == "high") {
+        priority = RequestPriority::HIGH;
+    } else if (value == "low") {
+        priority = RequestPriority::LOW;
+    } else {
+        return StatusCode::REQUEST_PRIORITY_INVALID;
+    }
+    return StatusCode::OK;
+}
+
 size_t getRequestBatchSize(const tensorflow::serving::PredictRequest* request) {
     auto requestInputItr = request->inputs().begin();
     if (requestInputItr == request->inputs().end()) {
@@ -60,25 +94,31 @@ Status getModelInstance(ovms::ModelManager& manager,
     const std::string& modelName,
     ovms::model_version_t modelVersionId,
     std::shared_ptr<ovms::ModelInstance>& modelInstance,
-    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) {
-    SPDLOG_INFO("Requesting model:{}; version:{}.", modelName, modelVersionId);
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr,
+    uint64_t sequenceId) {
+    OVMS_REQUEST_DEBUG("Requesting model:{}; version:{}.", modelName, modelVersionId);
 
     auto model = manager.findModelByName(modelName);
     if (model == nullptr) {
         return StatusCode::MODEL_NAME_MISSING;
     }
-    if (modelVersionId != 0) {
-        modelInstance = model->getModelInstanceByVersion(modelVersionId);
-        if (modelInstance == nullptr) {
-            return StatusCode::MODEL_VERSION_MISSING;
-        }
-    } else {
-        modelInstance = model->getDefaultModelInstance();
-        if (modelInstance == nullptr) {
-            return StatusCode::MODEL_VERSION_MISSING;
+    auto findInstance = [&model, modelVersionId, sequenceId]() {
+        return modelVersionId != 0 ? model->getModelInstanceByVersion(modelVersionId) : model->getRoutedModelInstance(sequenceId);
+    };
+    modelInstance = findInstance();
+    if (modelInstance == nullptr) {
+        return StatusCode::MODEL_VERSION_MISSING;
+    }
+    auto status = modelInstance->waitForLoaded(WAIT_FOR_MODEL_LOADED_TIMEOUT_MS, modelInstanceUnloadGuardPtr);
+    if (status == StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE) {
+        // instance might have been replaced by reload after it was found
+        auto replacement = findInstance();
+        if (replacement != nullptr && replacement != modelInstance) {
+            modelInstance = std::move(replacement);
+            status = modelInstance->waitForLoaded(WAIT_FOR_MODEL_LOADED_TIMEOUT_MS, modelInstanceUnloadGuardPtr);
         }
     }
-    return modelInstance->waitForLoaded(WAIT_FOR_MODEL_LOADED_TIMEOUT_MS, modelInstanceUnloadGuardPtr);
+    return status;
 }
 
 Status getPipeline(ovms::ModelManager& manager,
@@ -86,7 +126,7 @@ Status getPipeline(ovms::ModelManager& manager,
     const tensorflow::serving::PredictRequest* request,
     tensorflow::serving::PredictResponse* response) {
 
-    SPDLOG_INFO("Requesting pipeline: {};", request->model_spec().name());
+    OVMS_REQUEST_DEBUG("Requesting pipeline: {};", request->model_spec().name());
     auto status = manager.createPipeline(pipelinePtr, request->model_spec().name(), request, response);
     return status;
 }
@@ -108,51 +148,940 @@ Status performInference(ovms::OVInferRequestsQueue& inferRequestsQueue, const in
     return StatusCode::OK;
 }
 
-Status inference(
+namespace {
+enum InferenceStage : size_t {
+    QUEUE_WAIT,
+    DESERIALIZE,
+    PREDICTION,
+    SERIALIZE,
+    INFERENCE_STAGES_COUNT
+};
+
+using InferenceTimer = Timer<INFERENCE_STAGES_COUNT>;
+
+const char* const INFERENCE_STAGE_NAMES[INFERENCE_STAGES_COUNT] = {"queue_wait", "deserialization", "inference", "serialization"};
+
+void addTiming(RequestTiming* timing, const InferenceTimer& timer, InferenceStage stage) {
+    if (timing != nullptr) {
+        timing->add(INFERENCE_STAGE_NAMES[stage], timer.elapsed<std::chrono::milliseconds>(stage));
+    }
+}
+
+/**
+ * @brief Resources held by a request until its inference completion callback is done
+ */
+struct AsyncInferenceState {
+    std::shared_ptr<ModelInstance> modelInstance;
+    std::unique_ptr<ModelInstanceUnloadGuard> modelUnloadGuard;
+    // slot is released after stream is returned, so the next request of fair order finds it idle
+    std::unique_ptr<FairShareSlotGuard> fairShareSlotGuard;
+    std::unique_ptr<ExecutingStreamIdGuard> executingStreamIdGuard;
+    // destroyed before stream is returned
+    std::unique_ptr<ResponseBackedOutputBlobs> responseBackedOutputs;
+    InferenceTimer timer;
+    RequestTiming* timing = nullptr;
+};
+
+Status acquireFairShareSlot(ModelInstance& modelVersion, const std::string& tenant, const RequestDeadline* deadline,
+    std::unique_ptr<FairShareSlotGuard>& guard) {
+    FairShareQueue* fairShareQueue = modelVersion.getFairShareQueue();
+    if (fairShareQueue == nullptr) {
+        return StatusCode::OK;
+    }
+    auto status = fairShareQueue->acquire(tenant, Tenants::getInstance().getWeight(tenant), deadline != nullptr ? deadline->getDeadline() : std::nullopt);
+    if (status.ok()) {
+        guard = std::make_unique<FairShareSlotGuard>(*fairShareQueue);
+    }
+    return status;
+}
+
+/**
+ * @brief Takes slot of the tenant only if one is free and no one waits for it, true also when tenants are not scheduled
+ */
+bool tryAcquireFairShareSlot(ModelInstance& modelVersion, const std::string& tenant, std::unique_ptr<FairShareSlotGuard>& guard) {
+    FairShareQueue* fairShareQueue = modelVersion.getFairShareQueue();
+    if (fairShareQueue == nullptr) {
+        return true;
+    }
+    if (!fairShareQueue->tryAcquire(tenant, Tenants::getInstance().getWeight(tenant))) {
+        return false;
+    }
+    guard = std::make_unique<FairShareSlotGuard>(*fairShareQueue);
+    return true;
+}
+
+/**
+ * @brief Infers validated request on one of the networks of model instance, from waiting for infer request to serialization
+ */
+Status inferOnNetwork(
     ModelInstance& modelVersion,
+    OVInferRequestsQueue& inferRequestsQueue,
+    const tensor_map_t& inputsInfo,
+    const tensor_map_t& outputsInfo,
     const PredictRequest* requestProto,
     PredictResponse* responseProto,
-    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr) {
-    Timer timer;
-    using std::chrono::microseconds;
+    InferenceTimer& timer,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    Sequence* sequence = nullptr) {
+    ModelMetrics& metrics = modelVersion.getMetrics();
+    int executingInferId;
+    auto status = inferRequestsQueue.getIdleStreamWithinQueueLimits(executingInferId, deadline != nullptr ? deadline->getDeadline() : std::nullopt, priority);
+    if (!status.ok()) {
+        OVMS_REQUEST_DEBUG("Request rejected by model {}, version {}: {}", requestProto->model_spec().name(), modelVersion.getVersion(), status.string());
+        return status;
+    }
+    ExecutingStreamIdGuard executingStreamIdGuard(inferRequestsQueue, executingInferId);
+    InferenceEngine::InferRequest& inferRequest = inferRequestsQueue.getInferRequest(executingInferId);
+    timer.stop(QUEUE_WAIT);
+    metrics.queueWait.observe(timer.elapsedSeconds(QUEUE_WAIT));
+    addTiming(timing, timer, QUEUE_WAIT);
+    OVMS_REQUEST_DEBUG("Getting infer req duration in model {}, version {}, nireq {}: {:.3f} ms",
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<std::chrono::milliseconds>(QUEUE_WAIT));
+
+    if (sequence != nullptr) {
+        // infer request keeps memory state of the sequence it ran last, any stream can run next request of a sequence
+        status = sequence->restoreMemoryState(inferRequest);
+        if (!status.ok())
+            return status;
+    }
+    timer.start(DESERIALIZE);
+    status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(*requestProto, inputsInfo, inferRequest,
+        inferRequestsQueue.getPreallocatedInputBlobs(executingInferId));
+    timer.stop(DESERIALIZE);
+    if (!status.ok())
+        return status;
+    metrics.deserialization.observe(timer.elapsedSeconds(DESERIALIZE));
+    addTiming(timing, timer, DESERIALIZE);
+    OVMS_REQUEST_DEBUG("Deserialization duration in model {}, version {}, nireq {}: {:.3f} ms",
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<std::chrono::milliseconds>(DESERIALIZE));
+    status = checkDeadline(deadline);
+    if (!status.ok())
+        return status;
+    ResponseBackedOutputBlobs responseBackedOutputs(inferRequest, outputsInfo, responseProto);
+    timer.start(PREDICTION);
+    status = performInference(inferRequestsQueue, executingInferId, inferRequest);
+    timer.stop(PREDICTION);
+    if (!status.ok())
+        return status;
+    if (sequence != nullptr) {
+        status = sequence->updateMemoryState(inferRequest);
+        if (!status.ok())
+            return status;
+    }
+    modelVersion.recordPerfCounters(inferRequest);
+    inferRequestsQueue.recordInferenceLatency(std::chrono::microseconds(static_cast<int64_t>(timer.elapsed<std::chrono::microseconds>(PREDICTION))));
+    metrics.inference.observe(timer.elapsedSeconds(PREDICTION));
+    addTiming(timing, timer, PREDICTION);
+    OVMS_REQUEST_DEBUG("Prediction duration in model {}, version {}, nireq {}: {:.3f} ms",
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<std::chrono::milliseconds>(PREDICTION));
+
+    timer.start(SERIALIZE);
+    status = serializePredictResponse(inferRequest, outputsInfo, responseProto, &responseBackedOutputs);
+    timer.stop(SERIALIZE);
+    if (!status.ok())
+        return status;
+    metrics.serialization.observe(timer.elapsedSeconds(SERIALIZE));
+    addTiming(timing, timer, SERIALIZE);
+    OVMS_REQUEST_DEBUG("Serialization duration in model {}, version {}, nireq {}: {:.3f} ms",
+        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<std::chrono::milliseconds>(SERIALIZE));
+
+    return StatusCode::OK;
+}
+
+/**
+ * @brief Starts hedge of running request on an idle infer request of another network of the model, or the same one
+ *
+ * Hedge is not started if no infer request is idle, it must not wait behind the requests it is supposed to overtake.
+ * With tenant scheduling the hedge takes a fair share slot of the tenant, started only if one is free without waiting.
+ */
+bool startHedge(
+    ModelInstance& modelVersion,
+    HedgingPolicy& hedgingPolicy,
+    OVInferRequestsQueue& primaryQueue,
+    const PredictRequest* requestProto,
+    const std::string& tenant,
+    std::unique_ptr<ExecutingStreamIdGuard>& hedgeGuard,
+    std::unique_ptr<FairShareSlotGuard>& hedgeSlotGuard,
+    InferenceEngine::InferRequest*& hedgeRequest,
+    OVInferRequestsQueue*& hedgeQueue) {
+    OVInferRequestsQueue& queue = modelVersion.selectHedgeInferRequestsQueue(primaryQueue);
+    auto executingInferId = queue.tryGetIdleStream();
+    if (!executingInferId.has_value()) {
+        return false;
+    }
+    auto guard = std::make_unique<ExecutingStreamIdGuard>(queue, executingInferId.value());
+    std::unique_ptr<FairShareSlotGuard> slotGuard;
+    FairShareQueue* fairShareQueue = modelVersion.getFairShareQueue();
+    if (fairShareQueue != nullptr) {
+        if (!fairShareQueue->tryAcquire(tenant, Tenants::getInstance().getWeight(tenant))) {
+            return false;
+        }
+        slotGuard = std::make_unique<FairShareSlotGuard>(*fairShareQueue);
+    }
+    if (!hedgingPolicy.tryStartHedge()) {
+        return false;
+    }
+    InferenceEngine::InferRequest& inferRequest = queue.getInferRequest(executingInferId.value());
+    auto status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(*requestProto, modelVersion.getInputsInfo(), inferRequest,
+        queue.getPreallocatedInputBlobs(executingInferId.value()));
+    if (!status.ok()) {
+        return false;
+    }
+    try {
+        inferRequest.StartAsync();
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_DEBUG("Starting hedge of request to model {}, version {} failed: {}", requestProto->model_spec().name(), modelVersion.getVersion(), e.what());
+        return false;
+    }
+    hedgeGuard = std::move(guard);
+    hedgeSlotGuard = std::move(slotGuard);
+    hedgeRequest = &inferRequest;
+    hedgeQueue = &queue;
+    return true;
+}
+
+/**
+ * @brief Infers validated request and sends its copy to another infer request if it is still running after hedge delay
+ *
+ * The first successful inference answers the request, the other one cannot be cancelled and is handed to hedging policy
+ * which returns its infer request when it completes. Outputs are copied to the response, so the abandoned inference
+ * does not write to it. The abandoned inference keeps its fair share slot until it completes, its latency is recorded then.
+ */
+Status inferWithHedging(
+    ModelInstance& modelVersion,
+    HedgingPolicy& hedgingPolicy,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    InferenceTimer& timer,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant,
+    std::unique_ptr<FairShareSlotGuard>& fairShareSlotGuard) {
+    ModelMetrics& metrics = modelVersion.getMetrics();
+    hedgingPolicy.recordRequest();
+    OVInferRequestsQueue& primaryQueue = modelVersion.selectInferRequestsQueue();
+    int executingInferId;
+    auto status = primaryQueue.getIdleStreamWithinQueueLimits(executingInferId, deadline != nullptr ? deadline->getDeadline() : std::nullopt, priority);
+    if (!status.ok()) {
+        OVMS_REQUEST_DEBUG("Request rejected by model {}, version {}: {}", requestProto->model_spec().name(), modelVersion.getVersion(), status.string());
+        return status;
+    }
+    auto primaryGuard = std::make_unique<ExecutingStreamIdGuard>(primaryQueue, executingInferId);
+    InferenceEngine::InferRequest& primaryRequest = primaryQueue.getInferRequest(executingInferId);
+    timer.stop(QUEUE_WAIT);
+    metrics.queueWait.observe(timer.elapsedSeconds(QUEUE_WAIT));
+    addTiming(timing, timer, QUEUE_WAIT);
+
+    timer.start(DESERIALIZE);
+    status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(*requestProto, modelVersion.getInputsInfo(), primaryRequest,
+        primaryQueue.getPreallocatedInputBlobs(executingInferId));
+    timer.stop(DESERIALIZE);
+    if (!status.ok())
+        return status;
+    metrics.deserialization.observe(timer.elapsedSeconds(DESERIALIZE));
+    addTiming(timing, timer, DESERIALIZE);
+    status = checkDeadline(deadline);
+    if (!status.ok())
+        return status;
+
+    std::unique_ptr<ExecutingStreamIdGuard> hedgeGuard;
+    std::unique_ptr<FairShareSlotGuard> hedgeSlotGuard;
+    InferenceEngine::InferRequest* hedgeRequest = nullptr;
+    OVInferRequestsQueue* hedgeQueue = nullptr;
+    InferenceTimer hedgeTimer;
+    std::chrono::steady_clock::time_point primaryStarted, hedgeStarted;
+    bool hedgeWon = false;
+    timer.start(PREDICTION);
+    try {
+        primaryStarted = std::chrono::steady_clock::now();
+        primaryRequest.StartAsync();
+        auto sts = InferenceEngine::StatusCode::RESULT_NOT_READY;
+        auto delay = hedgingPolicy.getHedgeDelay();
+        if (delay.has_value()) {
+            // wait is in milliseconds, round up so that requests finishing right at the percentile are not hedged
+            sts = primaryRequest.Wait(std::max<int64_t>(1, (delay.value().count() + 999) / 1000));
+            if (sts == InferenceEngine::StatusCode::RESULT_NOT_READY) {
+                hedgeTimer.start(PREDICTION);
+                hedgeStarted = std::chrono::steady_clock::now();
+                if (startHedge(modelVersion, hedgingPolicy, primaryQueue, requestProto, tenant, hedgeGuard, hedgeSlotGuard, hedgeRequest, hedgeQueue)) {
+                    metrics.hedgedRequests.increment();
+                    OVMS_REQUEST_DEBUG("Request to model {}, version {} hedged after {} us", requestProto->model_spec().name(), modelVersion.getVersion(), delay.value().count());
+                }
+            }
+        }
+        while (hedgeRequest != nullptr && sts == InferenceEngine::StatusCode::RESULT_NOT_READY) {
+            sts = primaryRequest.Wait(1);
+            if (sts != InferenceEngine::StatusCode::RESULT_NOT_READY) {
+                break;
+            }
+            auto hedgeSts = hedgeRequest->Wait(InferenceEngine::IInferRequest::STATUS_ONLY);
+            if (hedgeSts == InferenceEngine::StatusCode::OK) {
+                hedgeWon = true;
+            } else if (hedgeSts != InferenceEngine::StatusCode::RESULT_NOT_READY) {
+                SPDLOG_DEBUG("Hedge of request to model {}, version {} failed: {}", requestProto->model_spec().name(), modelVersion.getVersion(), hedgeSts);
+                hedgeGuard.reset();
+                hedgeSlotGuard.reset();
+                hedgeRequest = nullptr;
+            }
+            if (hedgeWon) {
+                break;
+            }
+        }
+        if (!hedgeWon && sts == InferenceEngine::StatusCode::RESULT_NOT_READY) {
+            sts = primaryRequest.Wait(InferenceEngine::IInferRequest::RESULT_READY);
+        }
+        if (!hedgeWon && sts != InferenceEngine::StatusCode::OK && hedgeRequest != nullptr) {
+            // primary failed, hedge still answers the request
+            SPDLOG_DEBUG("Hedged request to model {}, version {} failed: {}", requestProto->model_spec().name(), modelVersion.getVersion(), sts);
+            hedgeWon = hedgeRequest->Wait(InferenceEngine::IInferRequest::RESULT_READY) == InferenceEngine::StatusCode::OK;
+        }
+        if (!hedgeWon && sts != InferenceEngine::StatusCode::OK) {
+            status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+            SPDLOG_ERROR("Async infer failed {}: {}", status.string(), sts);
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+        SPDLOG_ERROR("Async caught an exception {}: {}", status.string(), e.what());
+    }
+    timer.stop(PREDICTION);
+    // loser keeps its infer request until its inference completes
+    if (hedgeWon) {
+        hedgingPolicy.releaseWhenCompleted({&primaryRequest, std::move(primaryGuard), std::make_unique<ModelInstanceUnloadGuard>(modelVersion),
+            std::move(fairShareSlotGuard), &primaryQueue, primaryStarted});
+    } else if (hedgeRequest != nullptr) {
+        hedgingPolicy.releaseWhenCompleted({hedgeRequest, std::move(hedgeGuard), std::make_unique<ModelInstanceUnloadGuard>(modelVersion),
+            std::move(hedgeSlotGuard), hedgeQueue, hedgeStarted});
+    }
+    if (!status.ok())
+        return status;
+
+    InferenceEngine::InferRequest& winnerRequest = hedgeWon ? *hedgeRequest : primaryRequest;
+    if (hedgeWon) {
+        hedgeTimer.stop(PREDICTION);
+        metrics.hedgeWins.increment();
+        auto latency = std::chrono::microseconds(static_cast<int64_t>(hedgeTimer.elapsed<std::chrono::microseconds>(PREDICTION)));
+        hedgeQueue->recordInferenceLatency(latency);
+        hedgingPolicy.recordLatency(latency);
+    } else {
+        auto latency = std::chrono::microseconds(static_cast<int64_t>(timer.elapsed<std::chrono::microseconds>(PREDICTION)));
+        primaryQueue.recordInferenceLatency(latency);
+        hedgingPolicy.recordLatency(latency);
+    }
+    modelVersion.recordPerfCounters(winnerRequest);
+    metrics.inference.observe(timer.elapsedSeconds(PREDICTION));
+    addTiming(timing, timer, PREDICTION);
+    OVMS_REQUEST_DEBUG("Prediction duration in model {}, version {}, hedge won: {}: {:.3f} ms",
+        requestProto->model_spec().name(), modelVersion.getVersion(), hedgeWon, timer.elapsed<std::chrono::milliseconds>(PREDICTION));
+
+    timer.start(SERIALIZE);
+    status = serializePredictResponse(winnerRequest, modelVersion.getOutputsInfo(), responseProto);
+    timer.stop(SERIALIZE);
+    if (!status.ok())
+        return status;
+    metrics.serialization.observe(timer.elapsedSeconds(SERIALIZE));
+    addTiming(timing, timer, SERIALIZE);
+    return StatusCode::OK;
+}
+
+Status scheduleBatched(
+    ModelInstance& modelVersion,
+    BatchingScheduler& batchingScheduler,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    InferenceTimer& timer,
+    RequestTiming* timing) {
+    timer.start(PREDICTION);
+    auto status = batchingScheduler.schedule(requestProto, responseProto);
+    timer.stop(PREDICTION);
+    if (timing != nullptr) {
+        timing->add("batched_inference", timer.elapsed<std::chrono::milliseconds>(PREDICTION));
+    }
+    OVMS_REQUEST_DEBUG("Batched inference duration in model {}, version {}: {:.3f} ms",
+        requestProto->model_spec().name(), modelVersion.getVersion(), timer.elapsed<std::chrono::milliseconds>(PREDICTION));
+    return status;
+}
+
+/**
+ * @brief Pads request to shape bucket, infers it on bucket network and crops outputs back to request length
+ */
+Status inferenceInShapeBucket(
+    ModelInstance& modelVersion,
+    ShapeBucket& bucket,
+    size_t length,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority) {
+    InferenceTimer timer;
+    const size_t dimension = modelVersion.getModelConfig().getShapeBucketDimension();
+    PredictRequest paddedRequest;
+    auto status = padRequestToShapeBucket(*requestProto, bucket, dimension, paddedRequest);
+    if (!status.ok())
+        return status;
+    status = modelVersion.validateShapeBucketRequest(&paddedRequest, bucket);
+    if (!status.ok())
+        return status;
+    status = checkDeadline(deadline);
+    if (!status.ok())
+        return status;
+    OVMS_REQUEST_DEBUG("Request of length {} padded to shape bucket {} of model {}, version {}",
+        length, bucket.size, requestProto->model_spec().name(), modelVersion.getVersion());
+
+    if (bucket.batchingScheduler != nullptr && BatchingScheduler::isRequestBatchable(&paddedRequest)) {
+        status = scheduleBatched(modelVersion, *bucket.batchingScheduler, &paddedRequest, responseProto, timer, timing);
+    } else {
+        timer.start(QUEUE_WAIT);
+        status = inferOnNetwork(modelVersion, *bucket.inferRequestsQueue, bucket.inputsInfo, bucket.outputsInfo, &paddedRequest, responseProto,
+            timer, timing, deadline, priority);
+    }
+    if (!status.ok())
+        return status;
+    cropResponseToLength(*responseProto, bucket, dimension, length);
+    return StatusCode::OK;
+}
+
+/**
+ * @brief Infers micro-batches of the request on idle streams and merges their outputs
+ *
+ * Each micro-batch waits for its own infer request, so other requests of the model are interleaved with them.
+ * Micro-batches are started asynchronously as long as streams are idle.
+ */
+Status inferenceInMicroBatches(
+    ModelInstance& modelVersion,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    std::vector<PredictRequest>& microBatches,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant) {
+    // all micro-batches have the same shapes
+    auto status = modelVersion.validate(&microBatches.front());
+    status = reloadModelIfRequired(status, modelVersion, &microBatches.front(), modelUnloadGuardPtr);
+    if (!status.ok())
+        return status;
+    OVMS_REQUEST_DEBUG("Request of batch size {} split into {} micro-batches of model {}, version {}",
+        getRequestBatchSize(requestProto), microBatches.size(), requestProto->model_spec().name(), modelVersion.getVersion());
+
+    ModelMetrics& metrics = modelVersion.getMetrics();
+    std::vector<PredictResponse> microBatchResponses(microBatches.size());
+    std::mutex mtx;
+    std::condition_variable microBatchCompleted;
+    size_t running = 0;
+    Status firstError = StatusCode::OK;
+    auto complete = [&](const Status& microBatchStatus) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!microBatchStatus.ok() && firstError.ok()) {
+            firstError = microBatchStatus;
+        }
+        --running;
+        microBatchCompleted.notify_all();
+    };
+
+    InferenceTimer totalTimer;
+    totalTimer.start(PREDICTION);
+    for (size_t i = 0; i < microBatches.size(); ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!firstError.ok()) {
+                break;
+            }
+        }
+        auto state = std::make_shared<AsyncInferenceState>();
+        state->timer.start(QUEUE_WAIT);
+        status = acquireFairShareSlot(modelVersion, tenant, deadline, state->fairShareSlotGuard);
+        if (!status.ok())
+            break;
+        ovms::OVInferRequestsQueue& inferRequestsQueue = modelVersion.selectInferRequestsQueue();
+        int executingInferId;
+        status = inferRequestsQueue.getIdleStreamWithinQueueLimits(executingInferId, deadline != nullptr ? deadline->getDeadline() : std::nullopt, priority);
+        if (!status.ok())
+            break;
+        state->executingStreamIdGuard = std::make_unique<ExecutingStreamIdGuard>(inferRequestsQueue, executingInferId);
+        InferenceEngine::InferRequest& inferRequest = inferRequestsQueue.getInferRequest(executingInferId);
+        state->timer.stop(QUEUE_WAIT);
+        metrics.queueWait.observe(state->timer.elapsedSeconds(QUEUE_WAIT));
+
+        state->timer.start(DESERIALIZE);
+        status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(microBatches[i], modelVersion.getInputsInfo(), inferRequest,
+            inferRequestsQueue.getPreallocatedInputBlobs(executingInferId));
+        if (!status.ok())
+            break;
+        state->timer.stop(DESERIALIZE);
+        metrics.deserialization.observe(state->timer.elapsedSeconds(DESERIALIZE));
+        status = checkDeadline(deadline);
+        if (!status.ok())
+            break;
+
+        PredictResponse* microBatchResponse = &microBatchResponses[i];
+        state->responseBackedOutputs = std::make_unique<ResponseBackedOutputBlobs>(inferRequest, modelVersion.getOutputsInfo(), microBatchResponse);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++running;
+        }
+        try {
+            inferRequest.SetCompletionCallback<std::function<void(InferenceEngine::InferRequest, InferenceEngine::StatusCode)>>(
+                [state, &inferRequest, &inferRequestsQueue, &modelVersion, &metrics, microBatchResponse, complete](InferenceEngine::InferRequest, InferenceEngine::StatusCode code) mutable {
+                    Status status = StatusCode::OK;
+                    if (code != InferenceEngine::StatusCode::OK) {
+                        status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+                        SPDLOG_ERROR("Async infer of micro-batch failed {}: {}", status.string(), code);
+                    } else {
+                        state->timer.stop(PREDICTION);
+                        modelVersion.recordPerfCounters(inferRequest);
+                        inferRequestsQueue.recordInferenceLatency(std::chrono::microseconds(static_cast<int64_t>(state->timer.elapsed<std::chrono::microseconds>(PREDICTION))));
+                        metrics.inference.observe(state->timer.elapsedSeconds(PREDICTION));
+                        state->timer.start(SERIALIZE);
+                        status = serializePredictResponse(inferRequest, modelVersion.getOutputsInfo(), microBatchResponse, state->responseBackedOutputs.get());
+                        state->timer.stop(SERIALIZE);
+                        if (status.ok()) {
+                            metrics.serialization.observe(state->timer.elapsedSeconds(SERIALIZE));
+                        }
+                    }
+                    // resetting the callback destroys this lambda, move out everything still needed
+                    auto localState = std::move(state);
+                    auto localComplete = std::move(complete);
+                    inferRequest.SetCompletionCallback([]() {});
+                    localState.reset();
+                    localComplete(status);
+                });
+            state->timer.start(PREDICTION);
+            inferRequest.StartAsync();
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+            SPDLOG_ERROR("Async caught an exception {}: {}", status.string(), e.what());
+            inferRequest.SetCompletionCallback([]() {});
+            std::lock_guard<std::mutex> lock(mtx);
+            --running;
+            break;
+        }
+    }
+    // started micro-batches write to responses and completion state owned by this frame
+    std::unique_lock<std::mutex> lock(mtx);
+    microBatchCompleted.wait(lock, [&running]() { return running == 0; });
+    totalTimer.stop(PREDICTION);
+    if (!status.ok()) {
+        OVMS_REQUEST_DEBUG("Micro-batch of model {}, version {} failed: {}", requestProto->model_spec().name(), modelVersion.getVersion(), status.string());
+        return status;
+    }
+    if (!firstError.ok())
+        return firstError;
+    if (timing != nullptr) {
+        timing->add("micro_batched_inference", totalTimer.elapsed<std::chrono::milliseconds>(PREDICTION));
+    }
+    OVMS_REQUEST_DEBUG("Micro-batched inference duration in model {}, version {}: {:.3f} ms",
+        requestProto->model_spec().name(), modelVersion.getVersion(), totalTimer.elapsed<std::chrono::milliseconds>(PREDICTION));
+    return mergeMicroBatchResponses(microBatchResponses, getRequestBatchSize(requestProto), *responseProto);
+}
+
+/**
+ * @brief Infers request of stateful model with memory state of its sequence and adds sequence id to response
+ *
+ * Requests of one sequence are inferred one at a time, the sequence is removed when request ends it or start fails.
+ */
+Status inferenceInSequence(
+    ModelInstance& modelVersion,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant) {
+    uint64_t sequenceId;
+    uint32_t sequenceControl;
+    auto status = getSequenceProcessingSpec(*requestProto, sequenceId, sequenceControl);
+    if (!status.ok())
+        return status;
+    status = modelVersion.validate(requestProto);
+    status = reloadModelIfRequired(status, modelVersion, requestProto, modelUnloadGuardPtr);
+    if (!status.ok())
+        return status;
+    // reload may have applied config of model which is not stateful
+    auto sequenceManager = modelVersion.getSequenceManager();
+    if (sequenceManager == nullptr) {
+        OVMS_REQUEST_DEBUG("Request of sequence {} sent to model {}, version {} which is not stateful", sequenceId, requestProto->model_spec().name(), modelVersion.getVersion());
+        return StatusCode::MODEL_NOT_STATEFUL;
+    }
+    std::shared_ptr<Sequence> sequence;
+    status = sequenceManager->getSequence(sequenceId, sequenceControl, sequence);
+    if (!status.ok()) {
+        OVMS_REQUEST_DEBUG("Request of sequence {} rejected by model {}, version {}: {}", sequenceId, requestProto->model_spec().name(), modelVersion.getVersion(), status.string());
+        return status;
+    }
+    std::lock_guard<std::mutex> sequenceLock(sequence->getMutex());
+    if (sequence->isTerminated())
+        return StatusCode::SEQUENCE_TERMINATED;
+    status = checkDeadline(deadline);
+    if (status.ok()) {
+        InferenceTimer timer;
+        timer.start(QUEUE_WAIT);
+        std::unique_ptr<FairShareSlotGuard> fairShareSlotGuard;
+        status = acquireFairShareSlot(modelVersion, tenant, deadline, fairShareSlotGuard);
+        if (status.ok()) {
+            status = inferOnNetwork(modelVersion, modelVersion.selectInferRequestsQueue(), modelVersion.getInputsInfo(), modelVersion.getOutputsInfo(),
+                requestProto, responseProto, timer, timing, deadline, priority, sequence.get());
+        }
+    }
+    if (sequenceControl == SEQUENCE_END || (sequenceControl == SEQUENCE_START && !status.ok())) {
+        sequenceManager->removeSequence(sequenceId);
+    }
+    if (!status.ok())
+        return status;
+    addSequenceIdOutput(sequenceId, *responseProto);
+    return StatusCode::OK;
+}
+
+Status inferenceStages(
+    ModelInstance& modelVersion,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant) {
+    InferenceTimer timer;
+
+    if (modelVersion.getSequenceManager() != nullptr) {
+        return inferenceInSequence(modelVersion, requestProto, responseProto, modelUnloadGuardPtr, timing, deadline, priority, tenant);
+    }
+
+    size_t bucketLength;
+    ShapeBucket* shapeBucket = modelVersion.selectShapeBucket(requestProto, bucketLength);
+    if (shapeBucket != nullptr) {
+        return inferenceInShapeBucket(modelVersion, *shapeBucket, bucketLength, requestProto, responseProto, timing, deadline, priority);
+    }
+
+    std::vector<PredictRequest> microBatches;
+    if (modelVersion.isSplitToMicroBatches(requestProto) && splitRequestToMicroBatches(*requestProto, modelVersion.getBatchSize(), microBatches)) {
+        return inferenceInMicroBatches(modelVersion, requestProto, responseProto, microBatches, modelUnloadGuardPtr, timing, deadline, priority, tenant);
+    }
 
     auto status = modelVersion.validate(requestProto);
     status = reloadModelIfRequired(status, modelVersion, requestProto, modelUnloadGuardPtr);
+    if (!status.ok())
+        return status;
+    status = checkDeadline(deadline);
     if (!status.ok())
         return status;
 
-    timer.start("get infer request");
-    ovms::OVInferRequestsQueue& inferRequestsQueue = modelVersion.getInferRequestsQueue();
-    ExecutingStreamIdGuard executingStreamIdGuard(inferRequestsQueue);
-    int executingInferId = executingStreamIdGuard.getId();
-    InferenceEngine::InferRequest& inferRequest = inferRequestsQueue.getInferRequest(executingInferId);
-    timer.stop("get infer request");
-    spdlog::debug("Getting infer req duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("get infer request") / 1000);
+    BatchingScheduler* batchingScheduler = modelVersion.getBatchingScheduler();
+    if (batchingScheduler != nullptr && BatchingScheduler::isRequestBatchable(requestProto)) {
+        return scheduleBatched(modelVersion, *batchingScheduler, requestProto, responseProto, timer, timing);
+    }
+
+    timer.start(QUEUE_WAIT);
+    std::unique_ptr<FairShareSlotGuard> fairShareSlotGuard;
+    status = acquireFairShareSlot(modelVersion, tenant, deadline, fairShareSlotGuard);
+    if (!status.ok()) {
+        OVMS_REQUEST_DEBUG("Request of tenant {} rejected by model {}, version {}: {}", tenant, requestProto->model_spec().name(), modelVersion.getVersion(), status.string());
+        return status;
+    }
+    auto hedgingPolicy = modelVersion.getHedgingPolicy();
+    if (hedgingPolicy != nullptr) {
+        return inferWithHedging(modelVersion, *hedgingPolicy, requestProto, responseProto, timer, timing, deadline, priority, tenant, fairShareSlotGuard);
+    }
+    return inferOnNetwork(modelVersion, modelVersion.selectInferRequestsQueue(), modelVersion.getInputsInfo(), modelVersion.getOutputsInfo(),
+        requestProto, responseProto, timer, timing, deadline, priority);
+}
+}  // namespace
 
-    timer.start("deserialize");
-    status = deserializePredictRequest<ConcreteTensorProtoDeserializator>(*requestProto, modelVersion.getInputsInfo(), inferRequest);
-    timer.stop("deserialize");
+namespace {
+/**
+ * @brief Looks up response of cacheable request
+ *
+ * @param cacheKey receives key of cacheable request, nullopt if request cannot be cached
+ * @return true if response was copied from cache
+ */
+bool findCachedResponse(ModelInstance& modelVersion, ResponseCache* responseCache, const PredictRequest* requestProto, PredictResponse* responseProto,
+    RequestTiming* timing, std::optional<uint64_t>& cacheKey) {
+    uint64_t key;
+    if (responseCache == nullptr || !ResponseCache::computeKey(*requestProto, modelVersion.getVersion(), key)) {
+        return false;
+    }
+    cacheKey = key;
+    ModelMetrics& metrics = modelVersion.getMetrics();
+    if (!responseCache->get(key, *responseProto)) {
+        metrics.responseCacheMisses.increment();
+        return false;
+    }
+    metrics.responseCacheHits.increment();
+    if (timing != nullptr) {
+        timing->add("response_cache_hit", 0);
+    }
+    OVMS_REQUEST_DEBUG("Response of model {}, version {} found in cache", requestProto->model_spec().name(), modelVersion.getVersion());
+    return true;
+}
+}  // namespace
+
+Status inference(
+    ModelInstance& modelVersion,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant) {
+    ModelMetrics& metrics = modelVersion.getMetrics();
+    metrics.requests.increment();
+    auto responseCache = modelVersion.getResponseCache();
+    std::optional<uint64_t> cacheKey;
+    if (findCachedResponse(modelVersion, responseCache.get(), requestProto, responseProto, timing, cacheKey)) {
+        return StatusCode::OK;
+    }
+    auto requestCoalescer = modelVersion.getRequestCoalescer();
+    std::shared_ptr<RequestCoalescer::Flight> flight;
+    uint64_t flightKey = 0;
+    if (requestCoalescer != nullptr && (cacheKey || ResponseCache::computeKey(*requestProto, modelVersion.getVersion(), flightKey))) {
+        bool leader = false;
+        flight = requestCoalescer->join(cacheKey.value_or(flightKey), leader);
+        if (!leader) {
+            bool answered = false;
+            auto status = RequestCoalescer::wait(*flight, *responseProto, answered, deadline != nullptr ? deadline->getDeadline() : std::nullopt);
+            if (!status.ok()) {
+                metrics.countError(status);
+                return status;
+            }
+            if (answered) {
+                metrics.coalescedRequests.increment();
+                if (timing != nullptr) {
+                    timing->add("coalesced", 0);
+                }
+                OVMS_REQUEST_DEBUG("Request to model {}, version {} answered by in-flight inference of identical request", requestProto->model_spec().name(), modelVersion.getVersion());
+                return status;
+            }
+            // leader may be rejected for its own deadline, tenant share or priority, follower is checked on its own
+            OVMS_REQUEST_DEBUG("In-flight inference of request identical to request to model {}, version {} failed, inferring separately", requestProto->model_spec().name(), modelVersion.getVersion());
+            flight.reset();
+        }
+    }
+    // request thread copies inputs and outputs on CPUs of bound model, close to its infer request buffers
+    ScopedThreadAffinity pinnedAffinity(modelVersion.getPinnedCpus());
+    auto status = inferenceStages(modelVersion, requestProto, responseProto, modelUnloadGuardPtr, timing, deadline, priority, tenant);
+    if (status.ok()) {
+        status = postprocessResponse(modelVersion.getModelConfig().getPostprocessing(), *responseProto);
+    }
+    if (status.ok()) {
+        status = convertOutputPrecision(modelVersion.getModelConfig().getOutputPrecision(), modelVersion.getModelConfig().getOutputPrecisions(), *responseProto);
+    }
+    if (flight != nullptr) {
+        requestCoalescer->finish(flight, status, *responseProto);
+    }
+    if (!status.ok()) {
+        metrics.countError(status);
+    } else if (cacheKey) {
+        responseCache->put(cacheKey.value(), *responseProto);
+    }
+    return status;
+}
+
+namespace {
+/**
+ * @brief Starts inference, onCompleted is moved out only once inference is started
+ *
+ * If mayBlock is false nothing that waits is done: when model has to be reloaded, no fair share slot is free
+ * or no infer request is idle, deferred is set and OK is returned without starting inference.
+ */
+Status startInferenceAsync(
+    std::shared_ptr<ModelInstance> modelVersion,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    std::function<void(const Status&)>& onCompleted,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant,
+    bool mayBlock,
+    bool& deferred) {
+    ModelMetrics& metrics = modelVersion->getMetrics();
+    auto status = modelVersion->validate(requestProto);
+    if (!mayBlock && (status.batchSizeChangeRequired() || status.reshapeRequired())) {
+        deferred = true;
+        return StatusCode::OK;
+    }
+    status = reloadModelIfRequired(status, *modelVersion, requestProto, modelUnloadGuardPtr);
     if (!status.ok())
         return status;
-    spdlog::debug("Deserialization duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("deserialize") / 1000);
-    timer.start("prediction");
-    status = performInference(inferRequestsQueue, executingInferId, inferRequest);
-    timer.stop("prediction");
+    status = checkDeadline(deadline);
     if (!status.ok())
         return status;
-    spdlog::debug("Prediction duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("prediction") / 1000);
 
-    timer.start("serialize");
-    status = serializePredictResponse(inferRequest, modelVersion.getOutputsInfo(), responseProto);
-    timer.stop("serialize");
+    auto state = std::make_shared<AsyncInferenceState>();
+    state->modelInstance = modelVersion;
+    state->timing = timing;
+    state->timer.start(QUEUE_WAIT);
+    if (!mayBlock) {
+        if (!tryAcquireFairShareSlot(*modelVersion, tenant, state->fairShareSlotGuard)) {
+            deferred = true;
+            return StatusCode::OK;
+        }
+    } else {
+        status = acquireFairShareSlot(*modelVersion, tenant, deadline, state->fairShareSlotGuard);
+        if (!status.ok()) {
+            OVMS_REQUEST_DEBUG("Request of tenant {} rejected by model {}, version {}: {}", tenant, requestProto->model_spec().name(), modelVersion->getVersion(), status.string());
+            return status;
+        }
+    }
+    ovms::OVInferRequestsQueue& inferRequestsQueue = modelVersion->selectInferRequestsQueue();
+    int executingInferId;
+    if (!mayBlock) {
+        // queued requests wait on blocking executor, where queue limits are applied
+        auto idleStreamId = inferRequestsQueue.tryGetIdleStream(std::chrono::microseconds(0), priority);
+        if (!idleStreamId.has_value()) {
+            deferred = true;
+            return StatusCode::OK;
+        }
+        executingInferId = idleStreamId.value();
+    } else {
+        status = inferRequestsQueue.getIdleStreamWithinQueueLimits(executingInferId, deadline != nullptr ? deadline->getDeadline() : std::nullopt, priority);
+        if (!status.ok()) {
+            OVMS_REQUEST_DEBUG("Request rejected by model {}, version {}: {}", requestProto->model_spec().name(), modelVersion->getVersion(), status.string());
+            return status;
+        }
+    }
+    state->executingStreamIdGuard = std::make_unique<ExecutingStreamIdGuard>(inferRequestsQueue, executingInferId);
+    InferenceEngine::InferRequest& inferRequest = inferRequestsQueue.getInferRequest(executingInferId);
+    state->timer.stop(QUEUE_WAIT);
+    metrics.queueWait.observe(state->timer.elapsedSeconds(QUEUE_WAIT));
+    addTiming(timing, state->timer, QUEUE_WAIT);
+
+    state->timer.start(DESERIALIZE);
+    status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(*requestProto, modelVersion->getInputsInfo(), inferRequest,
+        inferRequestsQueue.getPreallocatedInputBlobs(executingInferId));
+    if (!status.ok())
+        return status;
+    state->timer.stop(DESERIALIZE);
+    metrics.deserialization.observe(state->timer.elapsedSeconds(DESERIALIZE));
+    addTiming(timing, state->timer, DESERIALIZE);
+    status = checkDeadline(deadline);
     if (!status.ok())
         return status;
-    spdlog::debug("Serialization duration in model {}, version {}, nireq {}: {:.3f} ms",
-        requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("serialize") / 1000);
 
+    state->responseBackedOutputs = std::make_unique<ResponseBackedOutputBlobs>(inferRequest, modelVersion->getOutputsInfo(), responseProto);
+    state->modelUnloadGuard = std::move(modelUnloadGuardPtr);
+    try {
+        inferRequest.SetCompletionCallback<std::function<void(InferenceEngine::InferRequest, InferenceEngine::StatusCode)>>(
+            [state, &inferRequest, &inferRequestsQueue, &metrics, responseProto, onCompleted = std::move(onCompleted)](InferenceEngine::InferRequest, InferenceEngine::StatusCode code) mutable {
+                Status status = StatusCode::OK;
+                if (code != InferenceEngine::StatusCode::OK) {
+                    status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+                    SPDLOG_ERROR("Async infer failed {}: {}", status.string(), code);
+                } else {
+                    state->timer.stop(PREDICTION);
+                    state->modelInstance->recordPerfCounters(inferRequest);
+                    inferRequestsQueue.recordInferenceLatency(std::chrono::microseconds(static_cast<int64_t>(state->timer.elapsed<std::chrono::microseconds>(PREDICTION))));
+                    metrics.inference.observe(state->timer.elapsedSeconds(PREDICTION));
+                    addTiming(state->timing, state->timer, PREDICTION);
+                    state->timer.start(SERIALIZE);
+                    status = serializePredictResponse(inferRequest, state->modelInstance->getOutputsInfo(), responseProto, state->responseBackedOutputs.get());
+                    if (status.ok()) {
+                        status = postprocessResponse(state->modelInstance->getModelConfig().getPostprocessing(), *responseProto);
+                    }
+                    if (status.ok()) {
+                        const auto& config = state->modelInstance->getModelConfig();
+                        status = convertOutputPrecision(config.getOutputPrecision(), config.getOutputPrecisions(), *responseProto);
+                    }
+                    state->timer.stop(SERIALIZE);
+                    if (status.ok()) {
+                        metrics.serialization.observe(state->timer.elapsedSeconds(SERIALIZE));
+                        addTiming(state->timing, state->timer, SERIALIZE);
+                    }
+                }
+                if (!status.ok()) {
+                    metrics.countError(status);
+                }
+                // resetting the callback destroys this lambda, move out everything still needed
+                auto localState = std::move(state);
+                auto localOnCompleted = std::move(onCompleted);
+                inferRequest.SetCompletionCallback([]() {});
+                localState.reset();
+                localOnCompleted(status);
+            });
+        state->timer.start(PREDICTION);
+        inferRequest.StartAsync();
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        Status status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+        SPDLOG_ERROR("Async caught an exception {}: {}", status.string(), e.what());
+        inferRequest.SetCompletionCallback([]() {});
+        return status;
+    }
+    return StatusCode::OK;
+}
+}  // namespace
+
+Status inferenceAsync(
+    std::shared_ptr<ModelInstance> modelVersion,
+    const PredictRequest* requestProto,
+    PredictResponse* responseProto,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    std::function<void(const Status&)> onCompleted,
+    RequestTiming* timing,
+    const RequestDeadline* deadline,
+    RequestPriority priority,
+    const std::string& tenant,
+    const blocking_task_scheduler_t& blockingScheduler) {
+    size_t bucketLength;
+    if (modelVersion->selectShapeBucket(requestProto, bucketLength) != nullptr || modelVersion->isSplitToMicroBatches(requestProto) ||
+        modelVersion->getHedgingPolicy() != nullptr || modelVersion->getSequenceManager() != nullptr) {
+        // padded, hedged, sequence and requests split into micro-batches are inferred synchronously
+        if (blockingScheduler == nullptr) {
+            auto status = inference(*modelVersion, requestProto, responseProto, modelUnloadGuardPtr, timing, deadline, priority, tenant);
+            onCompleted(status);
+            return StatusCode::OK;
+        }
+        auto guard = std::make_shared<std::unique_ptr<ModelInstanceUnloadGuard>>(std::move(modelUnloadGuardPtr));
+        blockingScheduler([modelVersion, requestProto, responseProto, guard, onCompleted = std::move(onCompleted), timing, deadline, priority, tenant]() {
+            onCompleted(inference(*modelVersion, requestProto, responseProto, *guard, timing, deadline, priority, tenant));
+        });
+        return StatusCode::OK;
+    }
+    ModelMetrics& metrics = modelVersion->getMetrics();
+    metrics.requests.increment();
+    auto responseCache = modelVersion->getResponseCache();
+    std::optional<uint64_t> cacheKey;
+    if (findCachedResponse(*modelVersion, responseCache.get(), requestProto, responseProto, timing, cacheKey)) {
+        onCompleted(StatusCode::OK);
+        return StatusCode::OK;
+    }
+    if (cacheKey) {
+        // callback holds the cache, model may be reloaded once inference state is released
+        onCompleted = [responseCache, key = cacheKey.value(), responseProto, onCompleted = std::move(onCompleted)](const Status& status) {
+            if (status.ok()) {
+                responseCache->put(key, *responseProto);
+            }
+            onCompleted(status);
+        };
+    }
+    // errors of started inference are counted by its completion callback
+    bool deferred = false;
+    auto status = startInferenceAsync(modelVersion, requestProto, responseProto, modelUnloadGuardPtr, onCompleted, timing, deadline, priority, tenant,
+        blockingScheduler == nullptr, deferred);
+    if (!status.ok()) {
+        metrics.countError(status);
+        return status;
+    }
+    if (deferred) {
+        // caller does not wait for reload, fair share or queued infer request, request is started again where waiting is allowed
+        auto guard = std::make_shared<std::unique_ptr<ModelInstanceUnloadGuard>>(std::move(modelUnloadGuardPtr));
+        blockingScheduler([modelVersion, requestProto, responseProto, guard, onCompleted = std::move(onCompleted), timing, deadline, priority, tenant]() {
+            // copy stays with this task if inference fails to start after callback is set
+            auto onStarted = onCompleted;
+            bool blockedDeferred = false;
+            auto status = startInferenceAsync(modelVersion, requestProto, responseProto, *guard, onStarted, timing, deadline, priority, tenant, true, blockedDeferred);
+            if (!status.ok()) {
+                modelVersion->getMetrics().countError(status);
+                onCompleted(status);
+            }
+        });
+    }
     return StatusCode::OK;
 }
 
@@ -173,7 +1102,7 @@ Status reloadModelIfRequired(
             SPDLOG_ERROR("Model instance reload (reshape) failed. Status Code: {}, Error: {}", status.getCode(), status.string());
         }
     } else if (!status.ok()) {
-        SPDLOG_INFO("Validation of inferRequest failed. Status Code: {}, Error: {}", status.getCode(), status.string());
+        OVMS_REQUEST_DEBUG("Validation of inferRequest failed. Status Code: {}, Error: {}", status.getCode(), status.string());
     }
     return status;
 }
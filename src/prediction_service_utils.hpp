@@ -14,28 +14,55 @@
 // limitations under the License.
 //*****************************************************************************
 #pragma once
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 
 #include "modelinstance.hpp"
 #include "modelmanager.hpp"
+#include "ovinferrequestsqueue.hpp"
 
 namespace ovms {
 
+class RequestDeadline;
+class RequestTiming;
+
 const uint WAIT_FOR_MODEL_LOADED_TIMEOUT_MS = 10000;
 
+/**
+ * @brief Runs task on thread which may block, e.g. of executor separate from completion queue threads
+ */
+using blocking_task_scheduler_t = std::function<void(std::function<void()>)>;
+
+/**
+ * @brief gRPC metadata key or HTTP header with priority class of predict request, high when missing
+ */
+extern const std::string REQUEST_PRIORITY_HEADER;
+
+/**
+ * @brief Parses REQUEST_PRIORITY_HEADER value, high or low
+ */
+Status parseRequestPriority(std::string_view value, RequestPriority& priority);
+
 size_t getRequestBatchSize(const tensorflow::serving::PredictRequest* request);
 std::map<std::string, shape_t> getRequestShapes(const tensorflow::serving::PredictRequest* request);
 
+/**
+ * @brief Finds model version and waits until it is loaded
+ *
+ * @param sequenceId id of sequence continued by request without version, pins it to the version the sequence was started on
+ */
 Status getModelInstance(ModelManager& manager,
     const std::string& modelName,
     model_version_t modelVersionId,
     std::shared_ptr<ModelInstance>& modelInstance,
-    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr);
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr,
+    uint64_t sequenceId = 0);
 
 Status getPipeline(ModelManager& manager,
     std::unique_ptr<Pipeline>& pipelinePtr,
@@ -44,11 +71,46 @@ Status getPipeline(ModelManager& manager,
 
 Status performInference(ovms::OVInferRequestsQueue& inferRequestsQueue, const int executingInferId, InferenceEngine::InferRequest& inferRequest);
 
+/**
+ * @brief Runs inference of a single model request, stages are added to timing if it is not null
+ *
+ * Request is dropped before waiting for infer request and before inference starts if its deadline is not null and passed.
+ * Priority applies to waiting for infer request, requests merged by batching scheduler are not prioritized.
+ * If tenant limits are configured, request of the tenant first waits for its fair share of model infer requests.
+ */
 Status inference(
     ModelInstance& modelVersion,
     const tensorflow::serving::PredictRequest* requestProto,
     tensorflow::serving::PredictResponse* responseProto,
-    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr);
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    RequestTiming* timing = nullptr,
+    const RequestDeadline* deadline = nullptr,
+    RequestPriority priority = RequestPriority::HIGH,
+    const std::string& tenant = std::string());
+
+/**
+ * @brief Starts inference without waiting for results.
+ *
+ * If OK is returned, onCompleted is called from inference completion callback after response is serialized.
+ * Otherwise request failed before inference was started and onCompleted is not called.
+ * Stages are added to timing if it is not null, it must stay alive until onCompleted is called.
+ * Deadline is checked only until inference is started.
+ * If blockingScheduler is set the caller is never blocked: requests which would wait for model reload, fair share of the tenant
+ * or queued infer request, and requests inferred synchronously, are run by task given to the scheduler, which may call onCompleted
+ * also with an error. Request, response, timing and deadline must then stay alive until onCompleted is called.
+ * Without scheduler waiting blocks the caller.
+ */
+Status inferenceAsync(
+    std::shared_ptr<ModelInstance> modelVersion,
+    const tensorflow::serving::PredictRequest* requestProto,
+    tensorflow::serving::PredictResponse* responseProto,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    std::function<void(const Status&)> onCompleted,
+    RequestTiming* timing = nullptr,
+    const RequestDeadline* deadline = nullptr,
+    RequestPriority priority = RequestPriority::HIGH,
+    const std::string& tenant = std::string(),
+    const blocking_task_scheduler_t& blockingScheduler = nullptr);
 
 Status reloadModelIfRequired(
     Status validationStatus,
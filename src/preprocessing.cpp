@@ -0,0 +1,84 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "preprocessing.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+namespace {
+const size_t CHANNEL_DIMENSION = 1;
+
+Status validatePreprocessing(const std::string& name, const InputPreprocessingInfo& info, const InferenceEngine::SizeVector& dims) {
+    if (dims.size() != 4) {
+        spdlog::error("Preprocessed input {} must have 4 dimensions", name);
+        return StatusCode::INVALID_PREPROCESSING_INPUT;
+    }
+    const size_t channels = dims[CHANNEL_DIMENSION];
+    if (!info.resize.empty() &&
+        (info.sourceShape.size() != dims.size() || info.sourceShape[0] != dims[0] || info.sourceShape[CHANNEL_DIMENSION] != channels)) {
+        spdlog::error("Source shape of resized input {} must differ from network shape only in height and width", name);
+        return StatusCode::INVALID_PREPROCESSING_INPUT;
+    }
+    if (!info.colorFormat.empty() && channels != 3) {
+        spdlog::error("Color format of input {} requires 3 channels", name);
+        return StatusCode::INVALID_PREPROCESSING_INPUT;
+    }
+    if ((!info.mean.empty() && info.mean.size() != channels) ||
+        (info.scale.size() > 1 && info.scale.size() != channels)) {
+        spdlog::error("Mean and scale of input {} must have {} values, one per channel", name, channels);
+        return StatusCode::INVALID_PREPROCESSING_INPUT;
+    }
+    return StatusCode::OK;
+}
+}  // namespace
+
+Status applyPreprocessing(const preprocessing_map_t& preprocessing, const InferenceEngine::InputsDataMap& networkInputs) {
+    for (const auto& [name, info] : preprocessing) {
+        auto it = networkInputs.find(name);
+        if (it == networkInputs.end()) {
+            spdlog::error("Preprocessed input {} not found in network", name);
+            return StatusCode::INVALID_PREPROCESSING_INPUT;
+        }
+        const auto& dims = it->second->getTensorDesc().getDims();
+        auto status = validatePreprocessing(name, info, dims);
+        if (!status.ok()) {
+            return status;
+        }
+        auto& preProcess = it->second->getPreProcess();
+        if (!info.resize.empty()) {
+            preProcess.setResizeAlgorithm(info.resize == "area" ? InferenceEngine::RESIZE_AREA : InferenceEngine::RESIZE_BILINEAR);
+        }
+        if (!info.colorFormat.empty()) {
+            preProcess.setColorFormat(info.colorFormat == "RGB" ? InferenceEngine::ColorFormat::RGB : InferenceEngine::ColorFormat::BGR);
+        }
+        if (!info.mean.empty() || !info.scale.empty()) {
+            const size_t channels = dims[CHANNEL_DIMENSION];
+            preProcess.init(channels);
+            for (size_t channel = 0; channel < channels; ++channel) {
+                preProcess[channel]->meanValue = info.mean.empty() ? 0.0f : info.mean[channel];
+                preProcess[channel]->stdScale = info.scale.empty() ? 1.0f : info.scale[info.scale.size() == 1 ? 0 : channel];
+            }
+            preProcess.setVariant(InferenceEngine::MEAN_VALUE);
+        }
+        spdlog::info("Input {} preprocessed by plugin; resize: {}; color format: {}; mean/scale: {}",
+            name, info.resize.empty() ? "none" : info.resize, info.colorFormat.empty() ? "network" : info.colorFormat,
+            !info.mean.empty() || !info.scale.empty());
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,33 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <inference_engine.hpp>
+
+#include "modelconfig.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Checks preprocessing against network inputs and sets it on their PreProcessInfo, so that plugin fuses
+ * resize, color conversion and mean/scale normalization into inference
+ *
+ * Preprocessed inputs must have 4 dimensions, mean and scale values match their channels.
+ */
+Status applyPreprocessing(const preprocessing_map_t& preprocessing, const InferenceEngine::InputsDataMap& networkInputs);
+
+}  // namespace ovms
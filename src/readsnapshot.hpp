@@ -0,0 +1,112 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace ovms {
+
+/**
+ * @brief Holds read-mostly data as immutable snapshot replaced as a whole on publish, read without locks on request path
+ *
+ * Each thread keeps the last snapshot it has read from each instance, readers only compare its generation with the
+ * current one, so steady state lookups neither lock nor write to cache lines shared with other threads. Thread takes
+ * the lock once after each publish to pick up the new snapshot. Thread cache has a slot per instance id, instances of
+ * the same type read alternately do not evict each other unless their ids collide. Generations are unique in the process,
+ * so snapshots cached for a destroyed instance are never mistaken for snapshots of another one.
+ */
+template <typename T>
+class ReadSnapshot {
+    static constexpr size_t THREAD_CACHE_SLOTS = 64;
+
+    mutable std::mutex publishMtx;
+    std::shared_ptr<const T> current;
+    std::atomic<uint64_t> generation;
+    const uint64_t id;
+    mutable uint64_t threadCacheMisses = 0;
+
+    struct CachedSnapshot {
+        uint64_t generation = 0;
+        std::shared_ptr<const T> snapshot;
+    };
+
+    CachedSnapshot& threadCachedSnapshot() const {
+        thread_local std::array<CachedSnapshot, THREAD_CACHE_SLOTS> cached;
+        return cached[id % THREAD_CACHE_SLOTS];
+    }
+
+    static uint64_t nextGeneration() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    static uint64_t nextId() {
+        static std::atomic<uint64_t> counter{0};
+        return counter++;
+    }
+
+public:
+    ReadSnapshot() :
+        current(std::make_shared<const T>()),
+        generation(nextGeneration()),
+        id(nextId()) {}
+
+    ReadSnapshot(const ReadSnapshot&) = delete;
+    ReadSnapshot& operator=(const ReadSnapshot&) = delete;
+
+    /**
+     * @brief Replaces snapshot, readers see it on their next read
+     */
+    void publish(T value) {
+        auto snapshot = std::make_shared<const T>(std::move(value));
+        std::lock_guard lock(publishMtx);
+        current = std::move(snapshot);
+        generation.store(nextGeneration(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Calls reader with current snapshot and returns its result
+     *
+     * Snapshot reference must not outlive the reader, reader must not read another snapshot of the same type.
+     */
+    template <typename Reader>
+    auto read(Reader&& reader) const {
+        auto& cached = threadCachedSnapshot();
+        if (cached.generation != generation.load(std::memory_order_acquire)) {
+            std::lock_guard lock(publishMtx);
+            ++threadCacheMisses;
+            cached.snapshot = current;
+            cached.generation = generation.load(std::memory_order_relaxed);
+        }
+        return reader(*cached.snapshot);
+    }
+
+    /**
+     * @brief Returns how many reads of all threads did not find current snapshot in thread cache
+     */
+    uint64_t getThreadCacheMissesCount() const {
+        std::lock_guard lock(publishMtx);
+        return threadCacheMisses;
+    }
+};
+
+}  // namespace ovms
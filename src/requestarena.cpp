@@ -0,0 +1,70 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "requestarena.hpp"
+
+#include <vector>
+
+namespace ovms {
+
+namespace {
+google::protobuf::ArenaOptions createArenaOptions(char* initialBlock, size_t initialBlockSize) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = initialBlock;
+    options.initial_block_size = initialBlockSize;
+    options.start_block_size = REQUEST_ARENA_INITIAL_BLOCK_SIZE;
+    options.max_block_size = REQUEST_ARENA_MAX_BLOCK_SIZE;
+    return options;
+}
+
+struct ThreadArena {
+    ThreadArena() :
+        initialBlock(REQUEST_ARENA_INITIAL_BLOCK_SIZE),
+        arena(createArenaOptions(initialBlock.data(), initialBlock.size())) {}
+
+    std::vector<char> initialBlock;
+    google::protobuf::Arena arena;
+    bool inUse = false;
+};
+
+ThreadArena& getThreadArena() {
+    thread_local ThreadArena threadArena;
+    return threadArena;
+}
+}  // namespace
+
+RequestArena::RequestArena() {
+    auto& threadArena = getThreadArena();
+    if (threadArena.inUse) {
+        nestedArena = std::make_unique<google::protobuf::Arena>(createArenaOptions(nullptr, 0));
+        arena = nestedArena.get();
+        return;
+    }
+    threadArena.inUse = true;
+    threadArenaTaken = true;
+    arena = &threadArena.arena;
+}
+
+RequestArena::~RequestArena() {
+    if (!threadArenaTaken) {
+        return;
+    }
+    // blocks beyond the initial one are freed, large requests do not keep memory of the thread
+    auto& threadArena = getThreadArena();
+    threadArena.arena.Reset();
+    threadArena.inUse = false;
+}
+
+}  // namespace ovms
@@ -0,0 +1,60 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+
+#include <google/protobuf/arena.h>
+
+namespace ovms {
+
+// memory of the thread arena kept between requests
+const size_t REQUEST_ARENA_INITIAL_BLOCK_SIZE = 256 * 1024;
+const size_t REQUEST_ARENA_MAX_BLOCK_SIZE = 8 * 1024 * 1024;
+
+/**
+ * @brief Arena for protos of a single request, reset when the request is done
+ *
+ * Requests handled one after another by a thread share the thread arena, so its first block is allocated once per thread.
+ * Request nested in another one on the same thread, like items of a batch request, gets its own arena.
+ * Protos created on the arena must not be used after it is destroyed.
+ */
+class RequestArena {
+public:
+    RequestArena();
+    ~RequestArena();
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    google::protobuf::Arena* get() {
+        return arena;
+    }
+
+    /**
+     * @brief Bytes allocated from the arena by this request
+     */
+    uint64_t getSpaceUsed() const {
+        return arena->SpaceUsed();
+    }
+
+private:
+    google::protobuf::Arena* arena;
+    std::unique_ptr<google::protobuf::Arena> nestedArena;
+    bool threadArenaTaken = false;
+};
+
+}  // namespace ovms
@@ -0,0 +1,74 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "requestcoalescer.hpp"
+
+namespace ovms {
+
+std::shared_ptr<RequestCoalescer::Flight> RequestCoalescer::join(uint64_t key, bool& leader) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = flights.find(key);
+    if (it != flights.end()) {
+        leader = false;
+        return it->second;
+    }
+    leader = true;
+    auto flight = std::make_shared<Flight>(key);
+    flights.emplace(key, flight);
+    return flight;
+}
+
+void RequestCoalescer::finish(const std::shared_ptr<Flight>& flight, const Status& status, const tensorflow::serving::PredictResponse& response) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = flights.find(flight->key);
+        if (it != flights.end() && it->second == flight) {
+            flights.erase(it);
+        }
+    }
+    // no follower joins after the flight is removed, response is copied once for all of them
+    std::lock_guard<std::mutex> lock(flight->mtx);
+    if (status.ok()) {
+        flight->succeeded = true;
+        flight->response = response;
+    }
+    flight->done = true;
+    flight->finished.notify_all();
+}
+
+Status RequestCoalescer::wait(Flight& flight, tensorflow::serving::PredictResponse& response, bool& answered,
+    std::optional<std::chrono::steady_clock::time_point> deadline) {
+    answered = false;
+    std::unique_lock<std::mutex> lock(flight.mtx);
+    if (deadline.has_value()) {
+        if (!flight.finished.wait_until(lock, deadline.value(), [&flight]() { return flight.done; })) {
+            return StatusCode::DEADLINE_EXCEEDED;
+        }
+    } else {
+        flight.finished.wait(lock, [&flight]() { return flight.done; });
+    }
+    if (flight.succeeded) {
+        response = flight.response;
+        answered = true;
+    }
+    return StatusCode::OK;
+}
+
+size_t RequestCoalescer::getFlightsCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return flights.size();
+}
+
+}  // namespace ovms
@@ -0,0 +1,92 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Coalesces identical concurrent requests of a model version into one inference
+ *
+ * The first request with a key leads the flight and infers, requests with the same key arriving before it finishes
+ * follow the flight and receive copies of its response. Keys are computed like response cache keys, without tenant,
+ * priority or deadline, so only successful results are shared. Failure of leading request may be specific to it,
+ * its followers run inference on their own then.
+ */
+class RequestCoalescer {
+public:
+    /**
+     * @brief Inference of leading request shared with requests following it
+     */
+    class Flight {
+    public:
+        explicit Flight(uint64_t key) :
+            key(key) {}
+
+        uint64_t getKey() const { return key; }
+
+    private:
+        friend class RequestCoalescer;
+
+        const uint64_t key;
+        std::mutex mtx;
+        std::condition_variable finished;
+        bool done = false;
+        bool succeeded = false;
+        tensorflow::serving::PredictResponse response;
+    };
+
+    /**
+     * @brief Attaches request to in-flight inference with the same key or starts new flight
+     *
+     * @param leader set to true if caller leads the flight and must finish it
+     */
+    std::shared_ptr<Flight> join(uint64_t key, bool& leader);
+
+    /**
+     * @brief Publishes response of leading request to its followers if it succeeded, later requests start new flight
+     */
+    void finish(const std::shared_ptr<Flight>& flight, const Status& status, const tensorflow::serving::PredictResponse& response);
+
+    /**
+     * @brief Waits for flight to finish and copies its response if leading request succeeded
+     *
+     * @param answered set to true if response was copied, false if leading request failed and caller has to infer itself
+     *
+     * @return DEADLINE_EXCEEDED if deadline passes first, OK otherwise
+     */
+    static Status wait(Flight& flight, tensorflow::serving::PredictResponse& response, bool& answered,
+        std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt);
+
+    size_t getFlightsCount() const;
+
+private:
+    mutable std::mutex mtx;
+    std::unordered_map<uint64_t, std::shared_ptr<Flight>> flights;
+};
+
+}  // namespace ovms
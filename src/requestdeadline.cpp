@@ -0,0 +1,63 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "requestdeadline.hpp"
+
+#include <grpcpp/server_context.h>
+
+namespace ovms {
+
+const std::string RequestDeadline::REQUEST_HEADER = "ovms-timeout-ms";
+
+RequestDeadline RequestDeadline::fromGrpcContext(const grpc::ServerContext& context, bool checkCancellation) {
+    RequestDeadline requestDeadline;
+    if (checkCancellation) {
+        requestDeadline.cancellableContext = &context;
+    }
+    const auto grpcDeadline = context.deadline();
+    // calls without deadline report infinite future
+    if (grpcDeadline != std::chrono::system_clock::time_point::max()) {
+        requestDeadline.deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(grpcDeadline - std::chrono::system_clock::now());
+    }
+    return requestDeadline;
+}
+
+Status RequestDeadline::fromTimeoutHeader(std::string_view value, RequestDeadline& requestDeadline) {
+    // at most 9 digits, so parsing cannot overflow
+    if (value.empty() || value.size() > 9) {
+        return StatusCode::REQUEST_TIMEOUT_HEADER_INVALID;
+    }
+    int64_t milliseconds = 0;
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            return StatusCode::REQUEST_TIMEOUT_HEADER_INVALID;
+        }
+        milliseconds = milliseconds * 10 + (c - '0');
+    }
+    requestDeadline = RequestDeadline(Clock::now() + std::chrono::milliseconds(milliseconds));
+    return StatusCode::OK;
+}
+
+Status RequestDeadline::check() const {
+    if (cancellableContext != nullptr && cancellableContext->IsCancelled()) {
+        return StatusCode::REQUEST_CANCELLED;
+    }
+    if (deadline.has_value() && Clock::now() >= deadline.value()) {
+        return StatusCode::DEADLINE_EXCEEDED;
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,84 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "status.hpp"
+
+namespace grpc {
+class ServerContext;
+}  // namespace grpc
+
+namespace ovms {
+
+/**
+ * @brief Time until which client waits for the response of a predict request
+ *
+ * Checked before waiting for infer request, before inference is started and before pipeline nodes are scheduled,
+ * so work of requests nobody waits for anymore is dropped early. Inference which already started is not interrupted.
+ */
+class RequestDeadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief HTTP header with time in milliseconds client waits for the response
+     */
+    static const std::string REQUEST_HEADER;
+
+    RequestDeadline() = default;
+    explicit RequestDeadline(Clock::time_point deadline) :
+        deadline(deadline) {}
+
+    /**
+     * @brief Takes deadline of gRPC call, cancellation is checked as well if it is safe to poll in call context
+     */
+    static RequestDeadline fromGrpcContext(const grpc::ServerContext& context, bool checkCancellation);
+
+    /**
+     * @brief Parses REQUEST_HEADER value, timeout is counted from now
+     */
+    static Status fromTimeoutHeader(std::string_view value, RequestDeadline& requestDeadline);
+
+    /**
+     * @return OK, DEADLINE_EXCEEDED or REQUEST_CANCELLED
+     */
+    Status check() const;
+
+    /**
+     * @brief Deadline of waiting, empty if client waits indefinitely
+     */
+    const std::optional<Clock::time_point>& getDeadline() const {
+        return deadline;
+    }
+
+private:
+    std::optional<Clock::time_point> deadline;
+    const grpc::ServerContext* cancellableContext = nullptr;
+};
+
+/**
+ * @brief Checks deadline which is null if request has none
+ */
+inline Status checkDeadline(const RequestDeadline* deadline) {
+    return deadline != nullptr ? deadline->check() : StatusCode::OK;
+}
+
+}  // namespace ovms
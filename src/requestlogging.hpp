@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+/**
+ * @brief Lets through one of every period calls, shared period is set from log_request_sampling option
+ *
+ * Every logging site on request path keeps its own sampler, so with each request passing a site once
+ * messages of roughly every period-th request are logged.
+ */
+class RequestLogSampler {
+public:
+    static void setPeriod(uint32_t newPeriod) {
+        period.store(newPeriod == 0 ? 1 : newPeriod, std::memory_order_relaxed);
+    }
+
+    static uint32_t getPeriod() {
+        return period.load(std::memory_order_relaxed);
+    }
+
+    bool sample() {
+        const uint32_t currentPeriod = getPeriod();
+        if (currentPeriod == 1) {
+            return true;
+        }
+        return calls.fetch_add(1, std::memory_order_relaxed) % currentPeriod == 0;
+    }
+
+private:
+    inline static std::atomic<uint32_t> period{1};
+    std::atomic<uint64_t> calls{0};
+};
+
+}  // namespace ovms
+
+/**
+ * @brief Logs per request message at debug level, sampled by RequestLogSampler
+ *
+ * Arguments are neither evaluated nor formatted unless debug level is enabled and the call is sampled.
+ */
+#define OVMS_REQUEST_DEBUG(...)                                                       \
+    do {                                                                              \
+        if (spdlog::default_logger_raw()->should_log(spdlog::level::debug)) {         \
+            static ovms::RequestLogSampler requestLogSampler;                         \
+            if (requestLogSampler.sample()) {                                         \
+                spdlog::default_logger_raw()->debug(__VA_ARGS__);                     \
+            }                                                                         \
+        }                                                                             \
+    } while (0)
@@ -0,0 +1,50 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "requesttiming.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace ovms {
+
+const std::string RequestTiming::REQUEST_HEADER = "ovms-timing";
+const std::string RequestTiming::RESPONSE_HEADER = "server-timing";
+
+namespace {
+// token characters of RFC 7230, metric names of Server-Timing header are tokens
+bool isTokenCharacter(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || (c != '\0' && std::strchr("!#$%&'*+-.^_`|~", c) != nullptr);
+}
+}  // namespace
+
+std::string RequestTiming::serialize() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < stages.size(); ++i) {
+        if (i > 0) {
+            ss << ", ";
+        }
+        for (char c : stages[i].first) {
+            ss << (isTokenCharacter(c) ? c : '_');
+        }
+        ss << ";dur=" << stages[i].second;
+    }
+    return ss.str();
+}
+
+}  // namespace ovms
@@ -0,0 +1,61 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ovms {
+
+/**
+ * @brief Durations of processing stages of a single predict request, returned to clients which asked for them
+ *
+ * Created only for requests carrying REQUEST_HEADER, otherwise nullptr is passed down and nothing is collected.
+ * Stages of a request are added sequentially, so it is not synchronized.
+ */
+class RequestTiming {
+public:
+    /**
+     * @brief gRPC metadata key or HTTP header requesting the breakdown, its value is ignored
+     */
+    static const std::string REQUEST_HEADER;
+
+    /**
+     * @brief gRPC trailing metadata key or HTTP header with the breakdown
+     */
+    static const std::string RESPONSE_HEADER;
+
+    void add(const std::string& stage, double milliseconds) {
+        stages.emplace_back(stage, milliseconds);
+    }
+
+    const std::vector<std::pair<std::string, double>>& getStages() const {
+        return stages;
+    }
+
+    /**
+     * @brief Serializes stages in Server-Timing header format, e.g. "queue_wait;dur=0.012, inference;dur=3.104"
+     *
+     * Characters not allowed in metric names are replaced with underscores.
+     */
+    std::string serialize() const;
+
+private:
+    std::vector<std::pair<std::string, double>> stages;
+};
+
+}  // namespace ovms
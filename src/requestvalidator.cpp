@@ -0,0 +1,121 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "requestvalidator.hpp"
+
+#include "hash.hpp"
+#include "sharedmemory.hpp"
+
+namespace ovms {
+
+namespace {
+// seeds tried before the table is grown
+const uint64_t MAX_PERFECT_HASH_ATTEMPTS = 64;
+}  // namespace
+
+size_t RequestValidator::slotOf(const std::string& name, uint64_t seed, size_t mask) const {
+    uint64_t hash = FNV_OFFSET_BASIS ^ seed;
+    fnv1a(hash, name.data(), name.size());
+    return hash & mask;
+}
+
+void RequestValidator::compile(const tensor_map_t& inputsInfo) {
+    clear();
+    for (const auto& pair : inputsInfo) {
+        ExpectedInput input;
+        input.name = pair.first;
+        input.dtype = pair.second->getPrecisionAsDataType();
+        input.shape = CompactShape(pair.second->getShape());
+        input.precisionSize = pair.second->getPrecision().size();
+        inputs.push_back(std::move(input));
+    }
+    size_t tableSize = 1;
+    while (tableSize < 2 * inputs.size()) {
+        tableSize *= 2;
+    }
+    while (true) {
+        for (uint64_t attempt = 0; attempt < MAX_PERFECT_HASH_ATTEMPTS; ++attempt) {
+            std::vector<int32_t> candidate(tableSize, -1);
+            bool collision = false;
+            for (size_t i = 0; i < inputs.size() && !collision; ++i) {
+                auto& slot = candidate[slotOf(inputs[i].name, attempt, tableSize - 1)];
+                collision = slot != -1;
+                slot = static_cast<int32_t>(i);
+            }
+            if (!collision) {
+                slots = std::move(candidate);
+                seed = attempt;
+                mask = tableSize - 1;
+                return;
+            }
+        }
+        tableSize *= 2;
+    }
+}
+
+void RequestValidator::clear() {
+    inputs.clear();
+    slots.clear();
+    seed = 0;
+    mask = 0;
+}
+
+bool RequestValidator::isValid(const tensorflow::serving::PredictRequest& request, size_t batchSize, bool anyBatchSize) const {
+    if (!isCompiled() || static_cast<size_t>(request.inputs_size()) != inputs.size()) {
+        return false;
+    }
+    // names of request inputs are unique, so each expected input is matched once
+    for (const auto& pair : request.inputs()) {
+        const int32_t index = slots[slotOf(pair.first, seed, mask)];
+        if (index == -1) {
+            return false;
+        }
+        const auto& expected = inputs[index];
+        if (expected.name != pair.first || !isInputValid(expected, pair.second, batchSize, anyBatchSize)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RequestValidator::isInputValid(const ExpectedInput& expected, const tensorflow::TensorProto& input, size_t batchSize, bool anyBatchSize) const {
+    if (input.dtype() != expected.dtype || isSharedMemoryInput(input)) {
+        return false;
+    }
+    const auto& shape = input.tensor_shape();
+    if (shape.dim_size() == 0 || static_cast<size_t>(shape.dim_size()) != expected.shape.size()) {
+        return false;
+    }
+    const int64_t batch = shape.dim(0).size();
+    if (batch <= 0 || (!anyBatchSize && (static_cast<size_t>(batch) != batchSize || batch != expected.shape[0]))) {
+        return false;
+    }
+    size_t valueCount = batch;
+    for (int i = 1; i < shape.dim_size(); ++i) {
+        if (shape.dim(i).size() != expected.shape[i]) {
+            return false;
+        }
+        valueCount *= expected.shape[i];
+    }
+    if (input.dtype() == tensorflow::DataType::DT_UINT16 && input.tensor_content().empty()) {
+        return static_cast<size_t>(input.int_val_size()) == valueCount;
+    }
+    if (input.dtype() == tensorflow::DataType::DT_HALF && input.tensor_content().empty()) {
+        return static_cast<size_t>(input.half_val_size()) == valueCount;
+    }
+    return input.tensor_content().size() == valueCount * expected.precisionSize;
+}
+
+}  // namespace ovms
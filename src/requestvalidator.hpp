@@ -0,0 +1,77 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "compactshape.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Expected inputs of a model version flattened when it is loaded, accepts valid requests without building error details
+ *
+ * Inputs are found by a perfect hash of their names. Validator only confirms that the request matches the network exactly,
+ * requests it does not accept are checked by ModelInstance::validate, which reports the reason or the required reload.
+ */
+class RequestValidator {
+public:
+    /**
+     * @brief Flattens expected precision, shape and content size of network inputs
+     */
+    void compile(const tensor_map_t& inputsInfo);
+
+    void clear();
+
+    bool isCompiled() const {
+        return !slots.empty();
+    }
+
+    /**
+     * @brief Checks if request matches names, precisions, shapes and content sizes of network inputs
+     *
+     * @param batchSize expected first dimension of inputs
+     * @param anyBatchSize accepts any positive first dimension, for requests merged by batching scheduler
+     *
+     * @return false also if request needs full validation, like inputs in shared memory
+     */
+    bool isValid(const tensorflow::serving::PredictRequest& request, size_t batchSize, bool anyBatchSize) const;
+
+private:
+    struct ExpectedInput {
+        std::string name;
+        tensorflow::DataType dtype;
+        CompactShape shape;
+        size_t precisionSize;
+    };
+
+    size_t slotOf(const std::string& name, uint64_t seed, size_t mask) const;
+
+    bool isInputValid(const ExpectedInput& expected, const tensorflow::TensorProto& input, size_t batchSize, bool anyBatchSize) const;
+
+    std::vector<ExpectedInput> inputs;
+    // index of input in slot given by hash of its name, -1 for free slots
+    std::vector<int32_t> slots;
+    uint64_t seed = 0;
+    size_t mask = 0;
+};
+
+}  // namespace ovms
@@ -0,0 +1,128 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "responsecache.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hash.hpp"
+#include "sharedmemory.hpp"
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+namespace {
+template <typename T>
+void hashValue(uint64_t& hash, const T& value) {
+    hash = xxhash64(reinterpret_cast<const char*>(&value), sizeof(value), hash);
+}
+
+void hashString(uint64_t& hash, const std::string& value) {
+    hashValue(hash, value.size());
+    hash = xxhash64(value.data(), value.size(), hash);
+}
+}  // namespace
+
+bool ResponseCache::computeKey(const PredictRequest& request, model_version_t version, uint64_t& key) {
+    // map iteration order is not defined, inputs are hashed in order of names
+    std::vector<const google::protobuf::Map<std::string, tensorflow::TensorProto>::value_type*> inputs;
+    for (const auto& pair : request.inputs()) {
+        const auto& input = pair.second;
+        if (input.tensor_content().empty() || isSharedMemoryInput(input)) {
+            return false;
+        }
+        inputs.push_back(&pair);
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+
+    uint64_t hash = 0;
+    hashValue(hash, version);
+    hashValue(hash, inputs.size());
+    for (const auto* pair : inputs) {
+        const auto& input = pair->second;
+        hashString(hash, pair->first);
+        hashValue(hash, static_cast<int>(input.dtype()));
+        hashValue(hash, input.tensor_shape().dim_size());
+        for (const auto& dim : input.tensor_shape().dim()) {
+            hashValue(hash, dim.size());
+        }
+        hashString(hash, input.tensor_content());
+    }
+    std::vector<std::string> outputFilter(request.output_filter().begin(), request.output_filter().end());
+    std::sort(outputFilter.begin(), outputFilter.end());
+    hashValue(hash, outputFilter.size());
+    for (const auto& name : outputFilter) {
+        hashString(hash, name);
+    }
+    key = hash;
+    return true;
+}
+
+bool ResponseCache::get(uint64_t key, PredictResponse& response, std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entriesByKey.find(key);
+    if (it == entriesByKey.end()) {
+        return false;
+    }
+    if (ttl.count() > 0 && it->second->expiry <= now) {
+        erase(it->second);
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    response = it->second->response;
+    return true;
+}
+
+void ResponseCache::put(uint64_t key, const PredictResponse& response, std::chrono::steady_clock::time_point now) {
+    const size_t responseSize = response.ByteSizeLong();
+    if (responseSize > maxSizeBytes) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    auto existing = entriesByKey.find(key);
+    if (existing != entriesByKey.end()) {
+        erase(existing->second);
+    }
+    while (!entries.empty() && sizeBytes + responseSize > maxSizeBytes) {
+        erase(std::prev(entries.end()));
+    }
+    entries.push_front({key, response, responseSize, now + ttl});
+    entriesByKey[key] = entries.begin();
+    sizeBytes += responseSize;
+}
+
+void ResponseCache::erase(std::list<Entry>::iterator it) {
+    sizeBytes -= it->sizeBytes;
+    entriesByKey.erase(it->key);
+    entries.erase(it);
+}
+
+size_t ResponseCache::getSizeBytes() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return sizeBytes;
+}
+
+size_t ResponseCache::getEntriesCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+}  // namespace ovms
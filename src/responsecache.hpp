@@ -0,0 +1,91 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "model_version_policy.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Least recently used responses of a model version keyed by hash of request inputs
+ *
+ * Entries are dropped when they expire or when responses added later exceed the size limit.
+ * Requests are identified by 64 bit xxHash only, inputs are not stored.
+ */
+class ResponseCache {
+public:
+    /**
+     * @param ttl lifetime of entries, zero for entries valid until evicted
+     */
+    ResponseCache(size_t maxSizeBytes, std::chrono::seconds ttl) :
+        maxSizeBytes(maxSizeBytes),
+        ttl(ttl) {}
+
+    /**
+     * @brief Computes cache key from model version, output filter and names, precisions, shapes and contents of inputs
+     *
+     * @return false if request cannot be cached, because an input is in shared memory or not sent as tensor content
+     */
+    static bool computeKey(const tensorflow::serving::PredictRequest& request, model_version_t version, uint64_t& key);
+
+    /**
+     * @brief Copies cached response, marks it as recently used
+     *
+     * @return false if there is no valid entry for the key
+     */
+    bool get(uint64_t key, tensorflow::serving::PredictResponse& response,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief Caches copy of response, evicting least recently used entries to stay within size limit
+     *
+     * Responses larger than the limit are not cached.
+     */
+    void put(uint64_t key, const tensorflow::serving::PredictResponse& response,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    size_t getSizeBytes() const;
+    size_t getEntriesCount() const;
+
+private:
+    struct Entry {
+        uint64_t key;
+        tensorflow::serving::PredictResponse response;
+        size_t sizeBytes;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    void erase(std::list<Entry>::iterator it);
+
+    const size_t maxSizeBytes;
+    const std::chrono::seconds ttl;
+
+    mutable std::mutex mtx;
+    // most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> entriesByKey;
+    size_t sizeBytes = 0;
+};
+
+}  // namespace ovms
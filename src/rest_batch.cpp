@@ -0,0 +1,85 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "rest_batch.hpp"
+
+#include <utility>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace ovms {
+
+Status parseBatchPredictRequest(const std::string& body, std::vector<BatchPredictItem>& items) {
+    rapidjson::Document document;
+    if (document.Parse(body.c_str()).HasParseError()) {
+        return StatusCode::JSON_INVALID;
+    }
+    if (!document.IsObject() || !document.HasMember("requests") || !document["requests"].IsArray()) {
+        return StatusCode::REST_BATCH_INVALID;
+    }
+    const auto& requests = document["requests"].GetArray();
+    if (requests.Empty() || requests.Size() > MAX_BATCH_PREDICT_REQUESTS) {
+        return StatusCode::REST_BATCH_INVALID;
+    }
+    items.clear();
+    items.reserve(requests.Size());
+    for (const auto& request : requests) {
+        if (!request.IsObject() ||
+            !request.HasMember("model_name") || !request["model_name"].IsString() ||
+            !request.HasMember("request") || !request["request"].IsObject()) {
+            return StatusCode::REST_BATCH_INVALID;
+        }
+        BatchPredictItem item;
+        item.modelName = request["model_name"].GetString();
+        if (request.HasMember("model_version")) {
+            if (!request["model_version"].IsInt64() || request["model_version"].GetInt64() < 0) {
+                return StatusCode::REST_BATCH_INVALID;
+            }
+            item.modelVersion = request["model_version"].GetInt64();
+        }
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        request["request"].Accept(writer);
+        item.body.assign(buffer.GetString(), buffer.GetSize());
+        items.push_back(std::move(item));
+    }
+    return StatusCode::OK;
+}
+
+void writeBatchPredictResponse(const std::vector<Status>& statuses, const std::vector<std::string>& responses, std::string& output) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("responses");
+    writer.StartArray();
+    for (size_t i = 0; i < statuses.size(); ++i) {
+        if (statuses[i].ok()) {
+            // predict responses are already serialized JSON objects
+            writer.RawValue(responses[i].c_str(), responses[i].size(), rapidjson::kObjectType);
+            continue;
+        }
+        writer.StartObject();
+        writer.Key("error");
+        writer.String(statuses[i].string().c_str());
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    output.assign(buffer.GetString(), buffer.GetSize());
+}
+
+}  // namespace ovms
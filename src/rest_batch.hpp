@@ -0,0 +1,56 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Single predict request of batch predict request
+ */
+struct BatchPredictItem {
+    std::string modelName;
+    std::optional<int64_t> modelVersion;
+    // JSON body of predict request, as accepted by model predict endpoint
+    std::string body;
+};
+
+/**
+ * @brief Limits work a single HTTP call can start
+ */
+constexpr size_t MAX_BATCH_PREDICT_REQUESTS = 256;
+
+/**
+ * @brief Parses body of batch predict request
+ *
+ * Body is a JSON object with requests array, each element holds model_name, optional model_version
+ * and request object with the predict request of the model.
+ */
+Status parseBatchPredictRequest(const std::string& body, std::vector<BatchPredictItem>& items);
+
+/**
+ * @brief Writes batch predict response, a responses array in order of requests
+ *
+ * Element of successful request is its predict response, failed request results in an object with error message.
+ */
+void writeBatchPredictResponse(const std::vector<Status>& statuses, const std::vector<std::string>& responses, std::string& output);
+
+}  // namespace ovms
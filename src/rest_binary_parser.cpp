@@ -0,0 +1,140 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "rest_binary_parser.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+#include <rapidjson/document.h>
+#include <spdlog/spdlog.h>
+
+#include "tensorflow/core/framework/types.h"
+
+namespace ovms {
+
+const std::string RestBinaryParser::INFERENCE_HEADER_CONTENT_LENGTH = "Inference-Header-Content-Length";
+
+bool RestBinaryParser::getDataType(const std::string& datatype, tensorflow::DataType& dataType) {
+    static const std::unordered_map<std::string, tensorflow::DataType> dataTypes = {
+        {"FP64", tensorflow::DataType::DT_DOUBLE},
+        {"FP32", tensorflow::DataType::DT_FLOAT},
+        {"FP16", tensorflow::DataType::DT_HALF},
+        {"INT64", tensorflow::DataType::DT_INT64},
+        {"INT32", tensorflow::DataType::DT_INT32},
+        {"INT16", tensorflow::DataType::DT_INT16},
+        {"INT8", tensorflow::DataType::DT_INT8},
+        {"UINT64", tensorflow::DataType::DT_UINT64},
+        {"UINT32", tensorflow::DataType::DT_UINT32},
+        {"UINT16", tensorflow::DataType::DT_UINT16},
+        {"UINT8", tensorflow::DataType::DT_UINT8},
+        {"BOOL", tensorflow::DataType::DT_BOOL},
+    };
+    auto it = dataTypes.find(datatype);
+    if (it == dataTypes.end()) {
+        return false;
+    }
+    dataType = it->second;
+    return true;
+}
+
+namespace {
+
+void setTensorData(tensorflow::TensorProto& proto, const char* data, size_t byteSize) {
+    // FP16 and U16 stay packed too, deserializers accept 2 byte values in tensor_content
+    proto.mutable_tensor_content()->assign(data, byteSize);
+}
+
+}  // namespace
+
+Status RestBinaryParser::parse(const std::string& body, size_t headerLength) {
+    if (headerLength == 0 || headerLength > body.size()) {
+        SPDLOG_DEBUG("Binary request header length {} exceeds body size {}", headerLength, body.size());
+        return StatusCode::REST_BINARY_HEADER_INVALID;
+    }
+    rapidjson::Document doc;
+    if (doc.Parse(body.data(), headerLength).HasParseError()) {
+        return StatusCode::JSON_INVALID;
+    }
+    if (!doc.IsObject()) {
+        return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
+    }
+    auto inputsItr = doc.FindMember("inputs");
+    if (inputsItr == doc.MemberEnd() || !inputsItr->value.IsObject()) {
+        return StatusCode::REST_INPUTS_NOT_AN_OBJECT;
+    }
+    if (inputsItr->value.MemberCount() == 0) {
+        return StatusCode::REST_NO_INPUTS_FOUND;
+    }
+
+    size_t offset = headerLength;
+    for (auto& input : inputsItr->value.GetObject()) {
+        const std::string name = input.name.GetString();
+        if (!input.value.IsObject()) {
+            SPDLOG_DEBUG("Binary request header of input {} is not an object", name);
+            return StatusCode::REST_BINARY_HEADER_INVALID;
+        }
+        auto datatypeItr = input.value.FindMember("datatype");
+        auto shapeItr = input.value.FindMember("shape");
+        if (datatypeItr == input.value.MemberEnd() || !datatypeItr->value.IsString() ||
+            shapeItr == input.value.MemberEnd() || !shapeItr->value.IsArray()) {
+            SPDLOG_DEBUG("Binary request header of input {} is missing datatype or shape", name);
+            return StatusCode::REST_BINARY_HEADER_INVALID;
+        }
+        tensorflow::DataType dataType;
+        if (!getDataType(datatypeItr->value.GetString(), dataType)) {
+            return StatusCode::REST_UNSUPPORTED_PRECISION;
+        }
+
+        auto& proto = (*requestProto->mutable_inputs())[name];
+        proto.Clear();
+        proto.set_dtype(dataType);
+        size_t expectedByteSize = tensorflow::DataTypeSize(dataType);
+        for (auto& dim : shapeItr->value.GetArray()) {
+            if (!dim.IsUint64() || dim.GetUint64() > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                SPDLOG_DEBUG("Binary request header of input {} has invalid shape", name);
+                return StatusCode::REST_BINARY_HEADER_INVALID;
+            }
+            proto.mutable_tensor_shape()->add_dim()->set_size(dim.GetUint64());
+            // wrapped size would pass the body length check with too short buffer
+            if (__builtin_mul_overflow(expectedByteSize, dim.GetUint64(), &expectedByteSize)) {
+                SPDLOG_DEBUG("Binary request header of input {} has shape too large", name);
+                return StatusCode::REST_BINARY_HEADER_INVALID;
+            }
+        }
+
+        auto binaryDataSizeItr = input.value.FindMember("binary_data_size");
+        if (binaryDataSizeItr != input.value.MemberEnd()) {
+            if (!binaryDataSizeItr->value.IsUint64() || binaryDataSizeItr->value.GetUint64() != expectedByteSize) {
+                SPDLOG_DEBUG("Binary data size of input {} does not match shape and datatype, expected {} bytes", name, expectedByteSize);
+                return StatusCode::REST_BINARY_DATA_SIZE_MISMATCH;
+            }
+        }
+        if (body.size() - offset < expectedByteSize) {
+            SPDLOG_DEBUG("Request body too short for input {}, expected {} bytes, remaining {}", name, expectedByteSize, body.size() - offset);
+            return StatusCode::REST_BINARY_DATA_SIZE_MISMATCH;
+        }
+        setTensorData(proto, body.data() + offset, expectedByteSize);
+        offset += expectedByteSize;
+    }
+    if (offset != body.size()) {
+        SPDLOG_DEBUG("Request body contains {} bytes not described by binary header", body.size() - offset);
+        return StatusCode::REST_BINARY_DATA_SIZE_MISMATCH;
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,98 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <string>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "rest_parser.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Parses predict request body consisting of JSON header followed by raw tensor data.
+ *
+ * Body layout follows binary data extension of KServe v2 protocol. First bytes, in number given by
+ * Inference-Header-Content-Length http header, are a JSON header:
+ * {
+ *     "inputs": {
+ *         "input1": {"datatype": "FP32", "shape": [1, 3, 224, 224], "binary_data_size": 602112},
+ *         "input2": {"datatype": "INT32", "shape": [1, 10]},
+ *         ...
+ *     }
+ * }
+ * followed by little endian tensor data of each input, in the same order as inputs in header.
+ * binary_data_size is optional, it is calculated from shape and datatype when missing.
+ */
+class RestBinaryParser {
+    /**
+     * @brief Request proto used when parser is not given an arena
+     */
+    tensorflow::serving::PredictRequest ownedRequestProto;
+
+    /**
+     * @brief Request proto, owned by arena given to parser
+     */
+    tensorflow::serving::PredictRequest* requestProto;
+
+public:
+    /**
+     * @param arena arena to allocate request proto on, proto outlives the parser then
+     */
+    explicit RestBinaryParser(google::protobuf::Arena* arena = nullptr) :
+        requestProto(arena != nullptr ? google::protobuf::Arena::CreateMessage<tensorflow::serving::PredictRequest>(arena) : &ownedRequestProto) {}
+
+    RestBinaryParser(const RestBinaryParser&) = delete;
+    RestBinaryParser& operator=(const RestBinaryParser&) = delete;
+
+    /**
+     * @brief Http header carrying JSON header size
+     */
+    static const std::string INFERENCE_HEADER_CONTENT_LENGTH;
+
+    /**
+     * @brief Gets parsed request proto
+     */
+    tensorflow::serving::PredictRequest& getProto() { return *requestProto; }
+
+    /**
+     * @brief Gets request order, response for binary request is sent in column format
+     */
+    Order getOrder() const {
+        return Order::COLUMN;
+    }
+
+    /**
+     * @brief Parses http request body
+     *
+     * @param body request body
+     * @param headerLength size of JSON header at the beginning of body
+     *
+     * @return Status indicating error code or success
+     */
+    Status parse(const std::string& body, size_t headerLength);
+
+    /**
+     * @brief Maps KServe datatype name to tensorflow data type
+     *
+     * @return false if datatype is not supported
+     */
+    static bool getDataType(const std::string& datatype, tensorflow::DataType& dataType);
+};
+
+}  // namespace ovms
@@ -16,16 +16,25 @@
 #include "rest_parser.hpp"
 
 #include <functional>
+#include <limits>
+#include <numeric>
 #include <string>
+#include <vector>
+
+#include <rapidjson/reader.h>
 
 namespace ovms {
 
-RestParser::RestParser(const tensor_map_t& tensors) {
+RestParser::RestParser(google::protobuf::Arena* arena) :
+    requestProto(arena != nullptr ? google::protobuf::Arena::CreateMessage<tensorflow::serving::PredictRequest>(arena) : &ownedRequestProto) {}
+
+RestParser::RestParser(const tensor_map_t& tensors, google::protobuf::Arena* arena) :
+    RestParser(arena) {
     for (const auto& kv : tensors) {
         const auto& name = kv.first;
         const auto& tensor = kv.second;
         tensorPrecisionMap[name] = tensor->getPrecision();
-        auto& input = (*requestProto.mutable_inputs())[name];
+        auto& input = (*requestProto->mutable_inputs())[name];
         input.set_dtype(tensor->getPrecisionAsDataType());
         input.mutable_tensor_content()->reserve(std::accumulate(
                                                     tensor->getShape().begin(),
@@ -37,7 +46,7 @@ RestParser::RestParser(const tensor_map_t& tensors) {
 }
 
 void RestParser::removeUnusedInputs() {
-    auto& inputs = (*requestProto.mutable_inputs());
+    auto& inputs = (*requestProto->mutable_inputs());
     auto it = inputs.begin();
     while (it != inputs.end()) {
         if (!it->second.tensor_shape().dim_size()) {
@@ -49,54 +58,9 @@ void RestParser::removeUnusedInputs() {
     }
 }
 
-bool RestParser::parseArray(rapidjson::Value& doc, int dim, tensorflow::TensorProto& proto, const std::string& tensorName) {
-    if (!doc.IsArray()) {
-        return false;
-    }
-    if (doc.GetArray().Size() == 0) {
-        return false;
-    }
-    if (!setDimOrValidate(proto, dim, doc.GetArray().Size())) {
-        return false;
-    }
-    if (doc.GetArray()[0].IsArray()) {
-        for (auto& itr : doc.GetArray()) {
-            if (!parseArray(itr, dim + 1, proto, tensorName)) {
-                return false;
-            }
-        }
-        return true;
-    } else {
-        if (!setPrecisionIfNotSet(doc.GetArray()[0], proto, tensorName))
-            return false;
-        for (auto& value : doc.GetArray()) {
-            if (!addValue(proto, value)) {
-                return false;
-            }
-        }
-        return true;
-    }
-    return false;
-}
-
-bool RestParser::parseInstance(rapidjson::Value& doc) {
-    if (doc.GetObject().MemberCount() == 0) {
-        return false;
-    }
-    for (auto& itr : doc.GetObject()) {
-        std::string tensorName = itr.name.GetString();
-        auto& proto = (*requestProto.mutable_inputs())[tensorName];
-        increaseBatchSize(proto);
-        if (!parseArray(itr.value, 1, proto, tensorName)) {
-            return false;
-        }
-    }
-    return true;
-}
-
 bool RestParser::isBatchSizeEqualForAllInputs() const {
     int64_t size = 0;
-    for (const auto& kv : requestProto.inputs()) {
+    for (const auto& kv : requestProto->inputs()) {
         if (size == 0) {
             size = kv.second.tensor_shape().dim(0).size();
         } else if (kv.second.tensor_shape().dim(0).size() != size) {
@@ -106,253 +70,573 @@ bool RestParser::isBatchSizeEqualForAllInputs() const {
     return true;
 }
 
-Status RestParser::parseRowFormat(rapidjson::Value& node) {
-    order = Order::ROW;
-    if (!node.IsArray()) {
-        return StatusCode::REST_INSTANCES_NOT_AN_ARRAY;
-    }
-    if (node.GetArray().Size() == 0) {
-        return StatusCode::REST_NO_INSTANCES_FOUND;
-    }
-    if (node.GetArray()[0].IsObject()) {
-        // named format
-        for (auto& instance : node.GetArray()) {
-            if (!instance.IsObject()) {
-                return StatusCode::REST_NAMED_INSTANCE_NOT_AN_OBJECT;
-            }
-            if (!this->parseInstance(instance)) {
-                return StatusCode::REST_COULD_NOT_PARSE_INSTANCE;
-            }
-        }
-    } else if (node.GetArray()[0].IsArray() || node.GetArray()[0].IsNumber()) {
-        // no named format
-        if (requestProto.inputs_size() != 1) {
-            return StatusCode::REST_INPUT_NOT_PREALLOCATED;
-        }
-        auto inputsIterator = requestProto.mutable_inputs()->begin();
-        if (inputsIterator == requestProto.mutable_inputs()->end()) {
-            const std::string details = "Failed to parse row formatted request.";
-            SPDLOG_ERROR("Internal error occured: {}", details);
-            return Status(StatusCode::INTERNAL_ERROR, details);
-        }
-        if (!parseArray(node, 0, inputsIterator->second, inputsIterator->first)) {
-            return StatusCode::REST_COULD_NOT_PARSE_INSTANCE;
-        } else {
-            format = Format::NONAMED;
-            return StatusCode::OK;
-        }
-    } else {
-        return StatusCode::REST_INSTANCES_NOT_NAMED_OR_NONAMED;
-    }
-    removeUnusedInputs();
-    if (!isBatchSizeEqualForAllInputs()) {
-        return StatusCode::REST_INSTANCES_BATCH_SIZE_DIFFER;
+void RestParser::increaseBatchSize(tensorflow::TensorProto& proto) {
+    if (proto.tensor_shape().dim_size() < 1) {
+        proto.mutable_tensor_shape()->add_dim()->set_size(0);
     }
-    format = Format::NAMED;
-    return StatusCode::OK;
+    proto.mutable_tensor_shape()->mutable_dim(0)->set_size(proto.tensor_shape().dim(0).size() + 1);
 }
 
-Status RestParser::parseColumnFormat(rapidjson::Value& node) {
-    order = Order::COLUMN;
-    // no named format
-    if (node.IsArray()) {
-        if (requestProto.inputs_size() != 1) {
-            return StatusCode::REST_INPUT_NOT_PREALLOCATED;
-        }
-        auto inputsIterator = requestProto.mutable_inputs()->begin();
-        if (inputsIterator == requestProto.mutable_inputs()->end()) {
-            const std::string details = "Failed to parse column formatted request.";
-            SPDLOG_ERROR("Internal error occured: {}", details);
-            return Status(StatusCode::INTERNAL_ERROR, details);
-        }
-        if (!parseArray(node, 0, inputsIterator->second, inputsIterator->first)) {
-            return StatusCode::REST_COULD_NOT_PARSE_INPUT;
-        }
-        format = Format::NONAMED;
-        return StatusCode::OK;
-    }
-    // named format
-    if (!node.IsObject()) {
-        return StatusCode::REST_INPUTS_NOT_AN_OBJECT;
-    }
-    if (node.GetObject().MemberCount() == 0) {
-        return StatusCode::REST_NO_INPUTS_FOUND;
+void RestParser::addDimIfMissing(tensorflow::TensorProto& proto, int dim) {
+    while (proto.tensor_shape().dim_size() <= dim) {
+        // size is known when array on this level of nesting ends
+        proto.mutable_tensor_shape()->add_dim()->set_size(-1);
     }
-    for (auto& kv : node.GetObject()) {
-        std::string tensorName = kv.name.GetString();
-        auto& proto = (*requestProto.mutable_inputs())[tensorName];
-        if (!parseArray(kv.value, 0, proto, tensorName)) {
-            return StatusCode::REST_COULD_NOT_PARSE_INPUT;
-        }
-    }
-    removeUnusedInputs();
-    format = Format::NAMED;
-    return StatusCode::OK;
 }
 
-Status RestParser::parse(const char* json) {
-    rapidjson::Document doc;
-    if (doc.Parse(json).HasParseError()) {
-        return StatusCode::JSON_INVALID;
+bool RestParser::setDimOrValidate(tensorflow::TensorProto& proto, int dim, int size) {
+    addDimIfMissing(proto, dim);
+    auto* shapeDim = proto.mutable_tensor_shape()->mutable_dim(dim);
+    if (shapeDim->size() == -1) {
+        shapeDim->set_size(size);
+        return true;
     }
-    if (!doc.IsObject()) {
-        return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
+    return shapeDim->size() == size;
+}
+
+namespace {
+
+/**
+ * @brief Numeric JSON value as reported by rapidjson reader
+ */
+struct JsonNumber {
+    enum class Type {
+        INT64,
+        UINT64,
+        DOUBLE
+    };
+    Type type;
+    int64_t intValue = 0;
+    uint64_t uintValue = 0;
+    double doubleValue = 0;
+
+    static JsonNumber fromInt64(int64_t value) {
+        JsonNumber number{Type::INT64};
+        number.intValue = value;
+        return number;
     }
-    auto instancesItr = doc.FindMember("instances");
-    auto inputsItr = doc.FindMember("inputs");
-    if (instancesItr != doc.MemberEnd() && inputsItr != doc.MemberEnd()) {
-        return StatusCode::REST_PREDICT_UNKNOWN_ORDER;
+
+    static JsonNumber fromUint64(uint64_t value) {
+        if (value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return fromInt64(static_cast<int64_t>(value));
+        }
+        JsonNumber number{Type::UINT64};
+        number.uintValue = value;
+        return number;
     }
-    if (instancesItr != doc.MemberEnd()) {
-        return parseRowFormat(instancesItr->value);
+
+    static JsonNumber fromDouble(double value) {
+        JsonNumber number{Type::DOUBLE};
+        number.doubleValue = value;
+        return number;
     }
-    if (inputsItr != doc.MemberEnd()) {
-        return parseColumnFormat(inputsItr->value);
+
+    bool isInt() const {
+        return type == Type::INT64 &&
+               intValue >= std::numeric_limits<int>::min() &&
+               intValue <= std::numeric_limits<int>::max();
     }
-    return StatusCode::REST_PREDICT_UNKNOWN_ORDER;
-}
 
-void RestParser::increaseBatchSize(tensorflow::TensorProto& proto) {
-    if (proto.tensor_shape().dim_size() < 1) {
-        proto.mutable_tensor_shape()->add_dim()->set_size(0);
+    bool isDouble() const {
+        return type == Type::DOUBLE;
     }
-    proto.mutable_tensor_shape()->mutable_dim(0)->set_size(proto.tensor_shape().dim(0).size() + 1);
-}
 
-bool RestParser::setDimOrValidate(tensorflow::TensorProto& proto, int dim, int size) {
-    if (proto.tensor_shape().dim_size() > dim) {
-        return proto.tensor_shape().dim(dim).size() == size;
-    } else {
-        while (proto.tensor_shape().dim_size() <= dim) {
-            proto.mutable_tensor_shape()->add_dim()->set_size(0);
+    template <typename T>
+    T as() const {
+        switch (type) {
+        case Type::DOUBLE:
+            return static_cast<T>(doubleValue);
+        case Type::UINT64:
+            return static_cast<T>(uintValue);
+        case Type::INT64:
+        default:
+            return static_cast<T>(intValue);
         }
-        proto.mutable_tensor_shape()->mutable_dim(dim)->set_size(size);
-        return true;
     }
-}
+};
 
 template <typename T>
-bool addToTensorContent(tensorflow::TensorProto& proto, T value) {
+bool addToTensorContent(tensorflow::TensorProto& proto, const JsonNumber& number) {
     if (sizeof(T) != DataTypeSize(proto.dtype())) {
         return false;
     }
+    T value = number.as<T>();
     proto.mutable_tensor_content()->append(reinterpret_cast<const char*>(&value), sizeof(T));
     return true;
 }
 
-template <typename T>
-bool addToTensorContent(tensorflow::TensorProto& proto, const rapidjson::Value& value) {
-    if (value.IsDouble()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetDouble()));
-    }
-    if (value.IsInt64()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetInt64()));
-    }
-    if (value.IsUint64()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetUint64()));
-    }
-    if (value.IsInt()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetInt()));
-    }
-    if (value.IsUint()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetUint()));
+bool addValue(tensorflow::TensorProto& proto, const JsonNumber& number) {
+    switch (proto.dtype()) {
+    case tensorflow::DataType::DT_FLOAT:
+        return addToTensorContent<float>(proto, number);
+    case tensorflow::DataType::DT_HALF:
+        proto.add_half_val(number.as<int32_t>());
+        return true;
+    case tensorflow::DataType::DT_DOUBLE:
+        return addToTensorContent<double>(proto, number);
+    case tensorflow::DataType::DT_INT32:
+        return addToTensorContent<int32_t>(proto, number);
+    case tensorflow::DataType::DT_INT16:
+        return addToTensorContent<int16_t>(proto, number);
+    case tensorflow::DataType::DT_UINT16:
+        proto.add_int_val(number.as<int32_t>());
+        return true;
+    case tensorflow::DataType::DT_INT8:
+        return addToTensorContent<int8_t>(proto, number);
+    case tensorflow::DataType::DT_UINT8:
+        return addToTensorContent<uint8_t>(proto, number);
+    case tensorflow::DataType::DT_INT64:
+        return addToTensorContent<int64_t>(proto, number);
+    case tensorflow::DataType::DT_UINT32:
+        return addToTensorContent<uint32_t>(proto, number);
+    case tensorflow::DataType::DT_UINT64:
+        return addToTensorContent<uint64_t>(proto, number);
+    case tensorflow::DataType::DT_BOOL:
+        return addToTensorContent<uint8_t>(proto, number);
+    default:
+        return false;
     }
-    return false;
 }
 
-bool addToHalfVal(tensorflow::TensorProto& proto, const rapidjson::Value& value) {
-    if (value.IsDouble()) {
-        proto.add_half_val(value.GetDouble());
+/**
+ * @brief Kind of JSON value starting at current reader position
+ */
+enum class ValueKind {
+    OBJECT,
+    ARRAY,
+    NUMBER,
+    BOOLEAN,
+    OTHER
+};
+
+bool isScalarValue(ValueKind kind) {
+    return kind == ValueKind::NUMBER || kind == ValueKind::BOOLEAN;
+}
+
+}  // namespace
+
+/**
+ * Handler keeps a stack of parsing states, one per open JSON container of the request structure.
+ * Tensor data (possibly nested arrays) is a single state with its own stack of array levels.
+ *
+ * After the first structural error the rest of current root member is skipped, so that JSON syntax
+ * errors anywhere in the body and order detection still take precedence, as with DOM parsing.
+ */
+class RestParser::SaxHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, RestParser::SaxHandler> {
+public:
+    explicit SaxHandler(RestParser& parser) :
+        parser(parser) {}
+
+    bool Null() { return onScalar(ValueKind::OTHER); }
+    bool Bool(bool value) { return onScalar(ValueKind::BOOLEAN, JsonNumber::fromInt64(value ? 1 : 0)); }
+    bool String(const char*, rapidjson::SizeType, bool) { return onScalar(ValueKind::OTHER); }
+    bool Int(int value) { return onScalar(ValueKind::NUMBER, JsonNumber::fromInt64(value)); }
+    bool Uint(unsigned value) { return onScalar(ValueKind::NUMBER, JsonNumber::fromInt64(value)); }
+    bool Int64(int64_t value) { return onScalar(ValueKind::NUMBER, JsonNumber::fromInt64(value)); }
+    bool Uint64(uint64_t value) { return onScalar(ValueKind::NUMBER, JsonNumber::fromUint64(value)); }
+    bool Double(double value) { return onScalar(ValueKind::NUMBER, JsonNumber::fromDouble(value)); }
+
+    bool StartObject() { return onContainerStart(ValueKind::OBJECT); }
+    bool StartArray() { return onContainerStart(ValueKind::ARRAY); }
+    bool EndObject(rapidjson::SizeType) { return onContainerEnd(); }
+    bool EndArray(rapidjson::SizeType) { return onContainerEnd(); }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+        if (skipping) {
+            return true;
+        }
+        std::string key(str, length);
+        State& state = states.back();
+        switch (state.type) {
+        case StateType::ROOT_OBJECT:
+            onRootKey(key);
+            break;
+        case StateType::INSTANCE_OBJECT:
+        case StateType::INPUTS_OBJECT:
+            state.count++;
+            tensorName = key;
+            break;
+        default:
+            break;
+        }
         return true;
     }
-    if (value.IsInt64()) {
-        proto.add_half_val(value.GetInt64());
-        return true;
+
+    Status getStatus() const {
+        if (!rootIsObject) {
+            return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
+        }
+        if (instancesFound == inputsFound) {
+            return StatusCode::REST_PREDICT_UNKNOWN_ORDER;
+        }
+        return status;
     }
-    if (value.IsUint64()) {
-        proto.add_half_val(value.GetUint64());
+
+private:
+    enum class StateType {
+        ROOT_OBJECT,
+        INSTANCES_ARRAY,
+        INSTANCE_OBJECT,
+        INPUTS_OBJECT,
+        TENSOR
+    };
+
+    enum class Member {
+        INSTANCES,
+        INPUTS,
+        OTHER
+    };
+
+    enum class InstancesFormat {
+        UNKNOWN,
+        NAMED,
+        NONAMED
+    };
+
+    struct State {
+        StateType type;
+        size_t count = 0;
+    };
+
+    enum class ArrayContent {
+        UNKNOWN,
+        ARRAYS,
+        VALUES
+    };
+
+    /**
+     * @brief Single level of tensor nested arrays
+     */
+    struct TensorLevel {
+        int dim;
+        size_t count = 0;
+        ArrayContent content = ArrayContent::UNKNOWN;
+    };
+
+    bool onScalar(ValueKind kind, const JsonNumber& number = JsonNumber::fromInt64(0)) {
+        if (!skipping) {
+            onValue(kind, number);
+        }
         return true;
     }
-    if (value.IsInt()) {
-        proto.add_half_val(value.GetInt());
+
+    bool onContainerStart(ValueKind kind) {
+        depth++;
+        if (!skipping) {
+            onValue(kind, JsonNumber::fromInt64(0));
+        }
         return true;
     }
-    if (value.IsUint()) {
-        proto.add_half_val(value.GetUint());
+
+    bool onContainerEnd() {
+        if (!skipping) {
+            onEnd();
+        }
+        depth--;
+        if (skipping && depth == resumeDepth) {
+            skipping = false;
+        }
         return true;
     }
-    return false;
-}
 
-bool addToIntVal(tensorflow::TensorProto& proto, const rapidjson::Value& value) {
-    if (value.IsDouble()) {
-        proto.add_int_val(value.GetDouble());
-        return true;
+    /**
+     * @brief Skips remaining part of current root member value
+     */
+    void skipRootMember() {
+        states.resize(1);
+        tensorLevels.clear();
+        if (depth > ROOT_MEMBER_DEPTH) {
+            skipping = true;
+            resumeDepth = ROOT_MEMBER_DEPTH;
+        }
     }
-    if (value.IsInt64()) {
-        proto.add_int_val(value.GetInt64());
-        return true;
+
+    void fail(StatusCode code) {
+        if (status.ok()) {
+            status = code;
+        }
+        skipRootMember();
     }
-    if (value.IsUint64()) {
-        proto.add_int_val(value.GetUint64());
-        return true;
+
+    void onRootKey(const std::string& key) {
+        if (key == "instances" && !instancesFound) {
+            instancesFound = true;
+            nextMember = inputsFound ? Member::OTHER : Member::INSTANCES;
+        } else if (key == "inputs" && !inputsFound) {
+            inputsFound = true;
+            nextMember = instancesFound ? Member::OTHER : Member::INPUTS;
+        } else {
+            nextMember = Member::OTHER;
+        }
     }
-    if (value.IsInt()) {
-        proto.add_int_val(value.GetInt());
-        return true;
+
+    void onValue(ValueKind kind, const JsonNumber& number) {
+        if (states.empty()) {
+            onRootValue(kind);
+            return;
+        }
+        State& state = states.back();
+        switch (state.type) {
+        case StateType::ROOT_OBJECT:
+            onRootMemberValue(kind);
+            return;
+        case StateType::INSTANCES_ARRAY:
+            onInstance(kind, number);
+            return;
+        case StateType::INSTANCE_OBJECT:
+            startTensor(kind, 1, StatusCode::REST_COULD_NOT_PARSE_INSTANCE);
+            return;
+        case StateType::INPUTS_OBJECT:
+            startTensor(kind, 0, StatusCode::REST_COULD_NOT_PARSE_INPUT);
+            return;
+        case StateType::TENSOR:
+            onTensorValue(kind, number);
+            return;
+        }
+    }
+
+    void onEnd() {
+        State state = states.back();
+        switch (state.type) {
+        case StateType::ROOT_OBJECT:
+            states.pop_back();
+            return;
+        case StateType::INSTANCES_ARRAY:
+            states.pop_back();
+            if (state.count == 0) {
+                fail(StatusCode::REST_NO_INSTANCES_FOUND);
+                return;
+            }
+            parser.removeUnusedInputs();
+            if (!parser.isBatchSizeEqualForAllInputs()) {
+                fail(StatusCode::REST_INSTANCES_BATCH_SIZE_DIFFER);
+                return;
+            }
+            parser.format = Format::NAMED;
+            return;
+        case StateType::INSTANCE_OBJECT:
+            states.pop_back();
+            if (state.count == 0) {
+                fail(StatusCode::REST_COULD_NOT_PARSE_INSTANCE);
+            }
+            return;
+        case StateType::INPUTS_OBJECT:
+            states.pop_back();
+            if (state.count == 0) {
+                fail(StatusCode::REST_NO_INPUTS_FOUND);
+                return;
+            }
+            parser.removeUnusedInputs();
+            parser.format = Format::NAMED;
+            return;
+        case StateType::TENSOR:
+            onTensorArrayEnd();
+            return;
+        }
+    }
+
+    void onRootValue(ValueKind kind) {
+        if (kind != ValueKind::OBJECT) {
+            rootIsObject = false;
+            // nothing else in the body matters
+            skipping = depth > 0;
+            resumeDepth = 0;
+            return;
+        }
+        states.push_back(State{StateType::ROOT_OBJECT});
+    }
+
+    void onRootMemberValue(ValueKind kind) {
+        Member member = nextMember;
+        nextMember = Member::OTHER;
+        if (member == Member::INSTANCES) {
+            parser.order = Order::ROW;
+            if (kind != ValueKind::ARRAY) {
+                fail(StatusCode::REST_INSTANCES_NOT_AN_ARRAY);
+                return;
+            }
+            states.push_back(State{StateType::INSTANCES_ARRAY});
+            instancesFormat = InstancesFormat::UNKNOWN;
+            return;
+        }
+        if (member == Member::INPUTS) {
+            parser.order = Order::COLUMN;
+            if (kind == ValueKind::ARRAY) {
+                // no named format
+                if (!selectOnlyInput()) {
+                    return;
+                }
+                beginTensorArray(0, StatusCode::REST_COULD_NOT_PARSE_INPUT, true);
+                return;
+            }
+            if (kind != ValueKind::OBJECT) {
+                fail(StatusCode::REST_INPUTS_NOT_AN_OBJECT);
+                return;
+            }
+            states.push_back(State{StateType::INPUTS_OBJECT});
+            return;
+        }
+        skipRootMember();
+    }
+
+    void onInstance(ValueKind kind, const JsonNumber& number) {
+        if (instancesFormat == InstancesFormat::UNKNOWN) {
+            if (kind == ValueKind::OBJECT) {
+                instancesFormat = InstancesFormat::NAMED;
+            } else if (kind == ValueKind::ARRAY || isScalarValue(kind)) {
+                // no named format, instances array is the tensor itself
+                instancesFormat = InstancesFormat::NONAMED;
+                if (!selectOnlyInput()) {
+                    return;
+                }
+                states.pop_back();
+                // instances array is already open, current element is processed as its first value
+                beginTensorArray(0, StatusCode::REST_COULD_NOT_PARSE_INSTANCE, true);
+                onTensorValue(kind, number);
+                return;
+            } else {
+                fail(StatusCode::REST_INSTANCES_NOT_NAMED_OR_NONAMED);
+                return;
+            }
+        }
+        states.back().count++;
+        if (kind != ValueKind::OBJECT) {
+            fail(StatusCode::REST_NAMED_INSTANCE_NOT_AN_OBJECT);
+            return;
+        }
+        states.push_back(State{StateType::INSTANCE_OBJECT});
     }
-    if (value.IsUint()) {
-        proto.add_int_val(value.GetUint());
+
+    bool selectOnlyInput() {
+        if (parser.requestProto->inputs_size() != 1) {
+            fail(StatusCode::REST_INPUT_NOT_PREALLOCATED);
+            return false;
+        }
+        auto inputsIterator = parser.requestProto->mutable_inputs()->begin();
+        tensorName = inputsIterator->first;
         return true;
     }
-    return false;
-}
 
-bool RestParser::addValue(tensorflow::TensorProto& proto, const rapidjson::Value& value) {
-    if (!value.IsNumber())
-        return false;
+    void startTensor(ValueKind kind, int dim, StatusCode errorCode) {
+        auto& proto = (*parser.requestProto->mutable_inputs())[tensorName];
+        if (dim == 1) {
+            parser.increaseBatchSize(proto);
+        }
+        if (kind != ValueKind::ARRAY) {
+            fail(errorCode);
+            return;
+        }
+        beginTensorArray(dim, errorCode, false);
+    }
 
-    switch (proto.dtype()) {
-    case tensorflow::DataType::DT_FLOAT:
-        return addToTensorContent<float>(proto, value);
-    case tensorflow::DataType::DT_HALF:
-        return addToHalfVal(proto, value);
-    case tensorflow::DataType::DT_DOUBLE:
-        return addToTensorContent<double>(proto, value);
-    case tensorflow::DataType::DT_INT32:
-        return addToTensorContent<int32_t>(proto, value);
-    case tensorflow::DataType::DT_INT16:
-        return addToTensorContent<int16_t>(proto, value);
-    case tensorflow::DataType::DT_UINT16:
-        return addToIntVal(proto, value);
-    case tensorflow::DataType::DT_INT8:
-        return addToTensorContent<int8_t>(proto, value);
-    case tensorflow::DataType::DT_UINT8:
-        return addToTensorContent<uint8_t>(proto, value);
-    case tensorflow::DataType::DT_INT64:
-        return addToTensorContent<int64_t>(proto, value);
-    case tensorflow::DataType::DT_UINT32:
-        return addToTensorContent<uint32_t>(proto, value);
-    case tensorflow::DataType::DT_UINT64:
-        return addToTensorContent<uint64_t>(proto, value);
-    default:
-        return false;
+    void beginTensorArray(int dim, StatusCode errorCode, bool noNamed) {
+        tensor = &(*parser.requestProto->mutable_inputs())[tensorName];
+        tensorErrorCode = errorCode;
+        tensorNoNamed = noNamed;
+        tensorLevels.clear();
+        states.push_back(State{StateType::TENSOR});
+        pushTensorLevel(dim);
+    }
+
+    void pushTensorLevel(int dim) {
+        parser.addDimIfMissing(*tensor, dim);
+        tensorLevels.push_back(TensorLevel{dim});
     }
-}
 
-bool RestParser::setPrecisionIfNotSet(const rapidjson::Value& value, tensorflow::TensorProto& proto, const std::string& tensorName) {
-    if (tensorPrecisionMap.count(tensorName))
+    bool setPrecisionIfNotSet(ValueKind kind, const JsonNumber& number) {
+        if (parser.tensorPrecisionMap.count(tensorName))
+            return true;
+
+        if (kind == ValueKind::BOOLEAN)
+            parser.tensorPrecisionMap[tensorName] = InferenceEngine::Precision::BOOL;
+        else if (number.isInt())
+            parser.tensorPrecisionMap[tensorName] = InferenceEngine::Precision::I32;
+        else if (number.isDouble())
+            parser.tensorPrecisionMap[tensorName] = InferenceEngine::Precision::FP32;
+        else
+            return false;
+
+        tensor->set_dtype(TensorInfo::getPrecisionAsDataType(parser.tensorPrecisionMap[tensorName]));
         return true;
+    }
 
-    if (value.IsInt())
-        tensorPrecisionMap[tensorName] = InferenceEngine::Precision::I32;
-    else if (value.IsDouble())
-        tensorPrecisionMap[tensorName] = InferenceEngine::Precision::FP32;
-    else
-        return false;
+    void onTensorValue(ValueKind kind, const JsonNumber& number) {
+        TensorLevel& level = tensorLevels.back();
+        level.count++;
+        if (level.content == ArrayContent::UNKNOWN) {
+            if (kind == ValueKind::ARRAY) {
+                level.content = ArrayContent::ARRAYS;
+            } else {
+                level.content = ArrayContent::VALUES;
+                if (!isScalarValue(kind) || !setPrecisionIfNotSet(kind, number)) {
+                    fail(tensorErrorCode);
+                    return;
+                }
+            }
+        }
+        if (level.content == ArrayContent::ARRAYS) {
+            if (kind != ValueKind::ARRAY) {
+                fail(tensorErrorCode);
+                return;
+            }
+            pushTensorLevel(level.dim + 1);
+            return;
+        }
+        // JSON booleans are accepted only by boolean tensors and the other way round
+        if (!isScalarValue(kind) ||
+            (kind == ValueKind::BOOLEAN) != (tensor->dtype() == tensorflow::DataType::DT_BOOL) ||
+            !addValue(*tensor, number)) {
+            fail(tensorErrorCode);
+        }
+    }
 
-    proto.set_dtype(TensorInfo::getPrecisionAsDataType(tensorPrecisionMap[tensorName]));
-    return true;
+    void onTensorArrayEnd() {
+        TensorLevel level = tensorLevels.back();
+        tensorLevels.pop_back();
+        if (level.count == 0 || !parser.setDimOrValidate(*tensor, level.dim, static_cast<int>(level.count))) {
+            fail(tensorErrorCode);
+            return;
+        }
+        if (!tensorLevels.empty()) {
+            return;
+        }
+        states.pop_back();
+        if (tensorNoNamed) {
+            parser.format = Format::NONAMED;
+        }
+    }
+
+    static const size_t ROOT_MEMBER_DEPTH = 1;
+
+    RestParser& parser;
+    std::vector<State> states;
+    std::vector<TensorLevel> tensorLevels;
+    Status status = StatusCode::OK;
+
+    size_t depth = 0;
+    bool skipping = false;
+    size_t resumeDepth = 0;
+
+    bool rootIsObject = true;
+    bool instancesFound = false;
+    bool inputsFound = false;
+    Member nextMember = Member::OTHER;
+    InstancesFormat instancesFormat = InstancesFormat::UNKNOWN;
+
+    std::string tensorName;
+    tensorflow::TensorProto* tensor = nullptr;
+    StatusCode tensorErrorCode = StatusCode::OK;
+    bool tensorNoNamed = false;
+};
+
+Status RestParser::parse(const char* json) {
+    SaxHandler handler(*this);
+    rapidjson::Reader reader;
+    rapidjson::StringStream stream(json);
+    if (reader.Parse(stream, handler).IsError()) {
+        return StatusCode::JSON_INVALID;
+    }
+    return handler.getStatus();
 }
 
 }  // namespace ovms
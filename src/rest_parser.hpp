@@ -18,7 +18,6 @@
 #include <map>
 #include <string>
 
-#include <rapidjson/document.h>
 #include <spdlog/spdlog.h>
 
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
@@ -61,9 +60,14 @@ class RestParser {
     Format format = Format::UNKNOWN;
 
     /**
-     * @brief Request proto
+     * @brief Request proto used when parser is not given an arena
      */
-    tensorflow::serving::PredictRequest requestProto;
+    tensorflow::serving::PredictRequest ownedRequestProto;
+
+    /**
+     * @brief Request proto, owned by arena given to parser
+     */
+    tensorflow::serving::PredictRequest* requestProto;
 
     /**
      * @brief Request content precision
@@ -78,50 +82,16 @@ class RestParser {
     static void increaseBatchSize(tensorflow::TensorProto& proto);
 
     /**
-     * @brief Sets specific dimension to given size
-     * 
-     * @return returns false if dimension already existed and did not match requested size, true otherwise
-     */
-    static bool setDimOrValidate(tensorflow::TensorProto& proto, int dim, int size);
-
-    /**
-     * Parses and adds rapidjson value to tensor proto depending on underlying tensor data type
+     * @brief Adds dimension with unknown size if tensor does not have it yet
      */
-    static bool addValue(tensorflow::TensorProto& proto, const rapidjson::Value& value);
+    static void addDimIfMissing(tensorflow::TensorProto& proto, int dim);
 
     /**
-     * @brief Parses rapidjson Node for arrays or numeric values on certain level of nesting.
-     * 
-     * @param doc rapidjson Node
-     * @param dim level of nesting
-     * @param input destination for parsing numeric values
-     * 
-     * @return false if processing failed, true when succeeded
-     * 
-     * Rapid json node expected to be passed in following structure:
-     * [
-     *     [...],
-     *     [...],
-     *     ...
-     * ]
-     */
-    bool parseArray(rapidjson::Value& doc, int dim, tensorflow::TensorProto& proto, const std::string& tensorName);
-
-    /**
-     * @brief Parses rapidjson Node for inputs in a string(name)=>array(data) format
-     * 
-     * @param doc rapidjson Node
-     * 
-     * @return false if processing failed, true when succeeded
+     * @brief Sets specific dimension to given size
      * 
-     * Rapid json node expected to be passed in following structure:
-     * {
-     *     "input1": [[...], [...], ...],
-     *     "input2": [[...], [...], ...],
-     *     ...
-     * }
+     * @return returns false if dimension size was already known and did not match requested size, true otherwise
      */
-    bool parseInstance(rapidjson::Value& doc);
+    static bool setDimOrValidate(tensorflow::TensorProto& proto, int dim, int size);
 
     /**
      * @brief Checks whether all inputs have equal batch size, 0th-dimension
@@ -131,52 +101,32 @@ class RestParser {
     bool isBatchSizeEqualForAllInputs() const;
 
     /**
-     * @brief Parses row format: list of objects, each object corresponding to one batch with one or multiple inputs.
-     *        When no named format is detected, instance is treated as array of single input batches with no name.
-     * 
-     * @param node rapidjson Node
-     * 
-     * @return Status indicating if processing succeeded, error code otherwise
-     *
-     * Rapid json node expected to be passed in following structure:
-     * [{inputs...}, {inputs...}, {inputs...}, ...]
-     * or:
-     * [no named input data batches...]
+     * @brief rapidjson SAX handler writing values straight into request proto while body is read
      */
-    Status parseRowFormat(rapidjson::Value& node);
+    class SaxHandler;
 
+public:
     /**
-     * @brief Parses column format: object of input:batches key value pairs.
-     *        When no named format is detected, instance is treated as array of single input batches with no name.
-     * 
-     * @param node rapidjson Node
-     * 
-     * @return Status indicating if processing succeeded, error code otherwise
-     * 
-     * Rapid json node expected to be passed in following structure:
-     * {"inputA": [...], "inputB": [...], ...}
-     * or:
-     * [no named input data batches...]
+     * @param arena arena to allocate request proto on, proto outlives the parser then
      */
-    Status parseColumnFormat(rapidjson::Value& node);
-
-    bool setPrecisionIfNotSet(const rapidjson::Value& value, tensorflow::TensorProto& proto, const std::string& tensorName);
-
-public:
-    RestParser() = default;
+    explicit RestParser(google::protobuf::Arena* arena = nullptr);
     /**
      * @brief Constructor for preallocating memory for inputs beforehand. Size is calculated from tensor shape required by backend.
      * 
      * @param tensors Tensor map with model input parameters
+     * @param arena arena to allocate request proto on, proto outlives the parser then
      */
-    RestParser(const tensor_map_t& tensors);
+    RestParser(const tensor_map_t& tensors, google::protobuf::Arena* arena = nullptr);
+
+    RestParser(const RestParser&) = delete;
+    RestParser& operator=(const RestParser&) = delete;
 
     /**
      * @brief Gets parsed request proto
      * 
      * @return proto
      */
-    tensorflow::serving::PredictRequest& getProto() { return requestProto; }
+    tensorflow::serving::PredictRequest& getProto() { return *requestProto; }
 
     /**
      * @brief Gets request order
@@ -195,6 +145,9 @@ public:
     /**
      * @brief Parses http request body string
      * 
+     * Body is read with SAX reader, no document object model is built. Numeric values are appended
+     * directly to tensor content buffers (preallocated from model input shapes when known).
+     *
      * @param json request string
      * 
      * @return Status indicating error code or success
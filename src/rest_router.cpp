@@ -0,0 +1,183 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "rest_router.hpp"
+
+namespace ovms {
+
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isWordCharacter(char c) {
+    return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+/**
+ * @brief Removes prefix from path if it is there
+ */
+bool consume(std::string_view& path, std::string_view prefix) {
+    if (path.substr(0, prefix.size()) != prefix) {
+        return false;
+    }
+    path.remove_prefix(prefix.size());
+    return true;
+}
+
+/**
+ * @brief Removes the longest non empty prefix of accepted characters
+ */
+template <typename Predicate>
+bool consumeWhile(std::string_view& path, std::string_view& consumed, Predicate accepted) {
+    size_t length = 0;
+    while (length < path.size() && accepted(path[length])) {
+        ++length;
+    }
+    if (length == 0) {
+        return false;
+    }
+    consumed = path.substr(0, length);
+    path.remove_prefix(length);
+    return true;
+}
+
+/**
+ * @brief Takes optional query string, path must end otherwise
+ */
+bool matchQuery(std::string_view path, RestRouteMatch& match) {
+    if (path.empty()) {
+        return true;
+    }
+    if (path[0] != '?') {
+        return false;
+    }
+    match.query = path.substr(1);
+    return true;
+}
+
+bool matchModelRoute(std::string_view path, RestRouteMatch& match) {
+    if (!consumeWhile(path, match.modelName, [](char c) { return c != '/' && c != ':'; })) {
+        return false;
+    }
+    std::string_view component;
+    if (consume(path, "/versions/")) {
+        if (!consumeWhile(path, component, isDigit)) {
+            return false;
+        }
+        match.modelVersion = component;
+    } else if (consume(path, "/labels/")) {
+        if (!consumeWhile(path, component, isWordCharacter)) {
+            return false;
+        }
+        match.modelVersionLabel = component;
+    }
+    if (path.empty()) {
+        match.route = RestRoute::MODEL_STATUS;
+        return true;
+    }
+    if (path == "/metadata") {
+        match.route = RestRoute::MODEL_METADATA;
+        return true;
+    }
+    if (consume(path, ":")) {
+        if (path == "classify" || path == "regress" || path == "predict") {
+            match.processingMethod = path;
+            match.route = RestRoute::PREDICT;
+            return true;
+        }
+        return false;
+    }
+    if (!match.modelVersionLabel && match.modelName.find('?') == std::string_view::npos && consume(path, "/perf_counters")) {
+        match.route = RestRoute::PERF_COUNTERS;
+        return matchQuery(path, match);
+    }
+    return false;
+}
+
+bool matchRoute(std::string_view path, RestRouteMatch& match) {
+    match = RestRouteMatch();
+    if (consume(path, "/v1/models/")) {
+        return matchModelRoute(path, match);
+    }
+    if (consume(path, "/v1/health/")) {
+        if (path == "live" || path == "ready") {
+            match.probe = path;
+            match.route = RestRoute::HEALTH;
+            return true;
+        }
+        return false;
+    }
+    if (path == "/metrics") {
+        match.route = RestRoute::METRICS;
+        return true;
+    }
+    if (consume(path, "/v1/shared_memory")) {
+        match.route = RestRoute::SHARED_MEMORY;
+        if (path.empty()) {
+            return true;
+        }
+        if (!consume(path, "/") || !consumeWhile(path, match.regionName, [](char c) { return c != '/' && c != ':'; }) || !consume(path, ":")) {
+            return false;
+        }
+        if (path == "register" || path == "unregister") {
+            match.regionAction = path;
+            return true;
+        }
+        return false;
+    }
+    if (consume(path, "/v1/jobs")) {
+        match.route = RestRoute::JOBS;
+        if (path.empty()) {
+            return true;
+        }
+        if (!consume(path, "/") || !consumeWhile(path, match.jobId, isDigit)) {
+            return false;
+        }
+        if (path.empty()) {
+            return true;
+        }
+        if (path == ":cancel") {
+            match.jobAction = path.substr(1);
+            return true;
+        }
+        return false;
+    }
+    if (path == "/v1/batch:predict") {
+        match.route = RestRoute::BATCH_PREDICT;
+        return true;
+    }
+    if (consume(path, "/v1/profile")) {
+        match.route = RestRoute::PROFILE;
+        return matchQuery(path, match);
+    }
+    return false;
+}
+
+}  // namespace
+
+bool matchRestRoute(std::string_view path, RestRouteMatch& match) {
+    if (matchRoute(path, match)) {
+        return true;
+    }
+    if (!path.empty() && matchRoute(path.substr(1), match)) {
+        return true;
+    }
+    match.route = RestRoute::NONE;
+    return false;
+}
+
+}  // namespace ovms
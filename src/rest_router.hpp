@@ -0,0 +1,70 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+namespace ovms {
+
+enum class RestRoute {
+    NONE,
+    PREDICT,         /*!< POST /v1/models/{name}[/versions/{v}|/labels/{l}]:(classify|regress|predict) */
+    MODEL_STATUS,    /*!< GET /v1/models/{name}[/versions/{v}|/labels/{l}] */
+    MODEL_METADATA,  /*!< GET /v1/models/{name}[/versions/{v}|/labels/{l}]/metadata */
+    PERF_COUNTERS,   /*!< GET /v1/models/{name}[/versions/{v}]/perf_counters[?{query}] */
+    HEALTH,          /*!< GET /v1/health/(live|ready) */
+    METRICS,         /*!< GET /metrics */
+    PROFILE,         /*!< GET /v1/profile[?{query}] */
+    SHARED_MEMORY,   /*!< GET /v1/shared_memory, POST /v1/shared_memory/{region}:(register|unregister) */
+    BATCH_PREDICT,   /*!< POST /v1/batch:predict */
+    JOBS,            /*!< GET|POST /v1/jobs, GET /v1/jobs/{id}, POST /v1/jobs/{id}:cancel */
+};
+
+/**
+ * @brief Components of matched REST path, views into the matched path
+ */
+struct RestRouteMatch {
+    RestRoute route = RestRoute::NONE;
+    std::string_view modelName;
+    // digits only, not checked for overflow
+    std::optional<std::string_view> modelVersion;
+    std::optional<std::string_view> modelVersionLabel;
+    // classify, regress or predict
+    std::string_view processingMethod;
+    // live or ready
+    std::string_view probe;
+    // empty when listing shared memory regions
+    std::string_view regionName;
+    // register or unregister
+    std::string_view regionAction;
+    // digits only, empty when listing or submitting jobs
+    std::string_view jobId;
+    // cancel or empty
+    std::string_view jobAction;
+    std::string_view query;
+};
+
+/**
+ * @brief Matches REST API path in a single pass without allocations
+ *
+ * Any single character is accepted before the path, as with the regular expressions used before.
+ *
+ * @return false if path does not match any route, match route is NONE then
+ */
+bool matchRestRoute(std::string_view path, RestRouteMatch& match);
+
+}  // namespace ovms
@@ -15,111 +15,307 @@
 //*****************************************************************************
 #include "rest_utils.hpp"
 
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
 #include <spdlog/spdlog.h>
 
-#include "tensorflow_serving/util/json_tensor.h"
-#define DEBUG
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/strings/numbers.h"
+
+#include "metrics.hpp"
+#include "requestlogging.hpp"
+#include "requesttiming.hpp"
+#include "tensorconversion.hpp"
 #include "timer.hpp"
 
 using tensorflow::DataType;
 using tensorflow::DataTypeSize;
-using tensorflow::serving::JsonPredictRequestFormat;
-using tensorflow::serving::MakeJsonFromTensors;
 using tensorflow::serving::PredictResponse;
 
 namespace ovms {
+
+namespace {
+
+using JsonWriter = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+const char* const PREDICTIONS_KEY = "predictions";
+const char* const OUTPUTS_KEY = "outputs";
+
+// Estimated number of characters written per tensor value, used to reserve output buffer
+const size_t ESTIMATED_VALUE_JSON_SIZE = 16;
+
+bool writeNonFinite(JsonWriter& writer, double value) {
+    if (std::isnan(value)) {
+        return writer.RawValue("NaN", 3, rapidjson::kNumberType);
+    }
+    if (value > 0) {
+        return writer.RawValue("Infinity", 8, rapidjson::kNumberType);
+    }
+    return writer.RawValue("-Infinity", 9, rapidjson::kNumberType);
+}
+
+bool writeValue(JsonWriter& writer, float value) {
+    if (!std::isfinite(value)) {
+        return writeNonFinite(writer, value);
+    }
+    // shortest representation which parses back to the same float, as TensorFlow Serving prints it
+    char buffer[tensorflow::strings::kFastToBufferSize + 2];
+    tensorflow::strings::FloatToBuffer(value, buffer);
+    size_t length = std::strlen(buffer);
+    if (std::strpbrk(buffer, ".eE") == nullptr) {
+        buffer[length++] = '.';
+        buffer[length++] = '0';
+    }
+    return writer.RawValue(buffer, length, rapidjson::kNumberType);
+}
+
+/**
+ * @brief Bits of FP16 and BF16 values of outputs converted to response precision
+ */
+struct Half {
+    uint16_t bits;
+};
+struct Bfloat16 {
+    uint16_t bits;
+};
+
+/**
+ * @brief Writes value with as many significant digits as its precision holds, so that reduced precision is not padded with noise digits
+ */
+bool writeReducedPrecisionValue(JsonWriter& writer, float value, int significantDigits) {
+    if (!std::isfinite(value)) {
+        return writeNonFinite(writer, value);
+    }
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer) - 2, "%.*g", significantDigits, value);
+    if (std::strpbrk(buffer, ".eE") == nullptr) {
+        buffer[length++] = '.';
+        buffer[length++] = '0';
+    }
+    return writer.RawValue(buffer, length, rapidjson::kNumberType);
+}
+
+bool writeValue(JsonWriter& writer, Half value) { return writeReducedPrecisionValue(writer, halfToFloat(value.bits), 5); }
+bool writeValue(JsonWriter& writer, Bfloat16 value) { return writeReducedPrecisionValue(writer, bfloat16ToFloat(value.bits), 4); }
+
+bool writeValue(JsonWriter& writer, double value) {
+    if (!std::isfinite(value)) {
+        return writeNonFinite(writer, value);
+    }
+    return writer.Double(value);
+}
+
+bool writeValue(JsonWriter& writer, int8_t value) { return writer.Int(value); }
+bool writeValue(JsonWriter& writer, int16_t value) { return writer.Int(value); }
+bool writeValue(JsonWriter& writer, int32_t value) { return writer.Int(value); }
+bool writeValue(JsonWriter& writer, int64_t value) { return writer.Int64(value); }
+bool writeValue(JsonWriter& writer, uint8_t value) { return writer.Uint(value); }
+bool writeValue(JsonWriter& writer, uint16_t value) { return writer.Uint(value); }
+bool writeValue(JsonWriter& writer, uint32_t value) { return writer.Uint(value); }
+bool writeValue(JsonWriter& writer, uint64_t value) { return writer.Uint64(value); }
+bool writeValue(JsonWriter& writer, bool value) { return writer.Bool(value); }
+
+/**
+ * @brief Writes nested arrays of tensor values starting from dimension, advances data pointer by written values
+ */
+template <typename T>
+bool writeTensorValues(JsonWriter& writer, const char*& data, const tensorflow::TensorShapeProto& shape, int dimension) {
+    if (dimension == shape.dim_size()) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return writeValue(writer, value);
+    }
+    writer.StartArray();
+    const auto size = shape.dim(dimension).size();
+    for (int64_t i = 0; i < size; i++) {
+        if (!writeTensorValues<T>(writer, data, shape, dimension + 1)) {
+            return false;
+        }
+    }
+    return writer.EndArray();
+}
+
+bool writeTensorValues(JsonWriter& writer, const char* data, const tensorflow::TensorProto& tensor, int dimension) {
+    switch (tensor.dtype()) {
+    case DataType::DT_FLOAT:
+        return writeTensorValues<float>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_HALF:
+        return writeTensorValues<Half>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_BFLOAT16:
+        return writeTensorValues<Bfloat16>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_DOUBLE:
+        return writeTensorValues<double>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_INT32:
+        return writeTensorValues<int32_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_INT16:
+        return writeTensorValues<int16_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_INT8:
+        return writeTensorValues<int8_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_UINT8:
+        return writeTensorValues<uint8_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_UINT16:
+        return writeTensorValues<uint16_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_INT64:
+        return writeTensorValues<int64_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_UINT32:
+        return writeTensorValues<uint32_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_UINT64:
+        return writeTensorValues<uint64_t>(writer, data, tensor.tensor_shape(), dimension);
+    case DataType::DT_BOOL:
+        return writeTensorValues<bool>(writer, data, tensor.tensor_shape(), dimension);
+    default:
+        return false;
+    }
+}
+
+bool isSupportedDataType(DataType dataType) {
+    switch (dataType) {
+    case DataType::DT_FLOAT:
+    case DataType::DT_HALF:
+    case DataType::DT_BFLOAT16:
+    case DataType::DT_DOUBLE:
+    case DataType::DT_INT32:
+    case DataType::DT_INT16:
+    case DataType::DT_INT8:
+    case DataType::DT_UINT8:
+    case DataType::DT_UINT16:
+    case DataType::DT_INT64:
+    case DataType::DT_UINT32:
+    case DataType::DT_UINT64:
+    case DataType::DT_BOOL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status writeRowFormat(JsonWriter& writer, const PredictResponse& response) {
+    const auto& outputs = response.outputs();
+    int64_t batchSize = -1;
+    for (const auto& kv : outputs) {
+        const auto& shape = kv.second.tensor_shape();
+        if (shape.dim_size() == 0) {
+            SPDLOG_ERROR("Cannot serialize tensor {} in row format, tensor must have at least one dimension", kv.first);
+            return StatusCode::REST_PROTO_TO_STRING_ERROR;
+        }
+        if (batchSize != -1 && batchSize != shape.dim(0).size()) {
+            SPDLOG_ERROR("Cannot serialize outputs in row format, tensors must have the same 0-th dimension");
+            return StatusCode::REST_PROTO_TO_STRING_ERROR;
+        }
+        batchSize = shape.dim(0).size();
+    }
+
+    writer.Key(PREDICTIONS_KEY);
+    writer.StartArray();
+    for (int64_t i = 0; i < batchSize; i++) {
+        if (outputs.size() == 1) {
+            const auto& tensor = outputs.begin()->second;
+            const size_t rowByteSize = tensor.tensor_content().size() / batchSize;
+            writer.SetFormatOptions(rapidjson::kFormatSingleLineArray);
+            writeTensorValues(writer, tensor.tensor_content().data() + i * rowByteSize, tensor, 1);
+            writer.SetFormatOptions(rapidjson::kFormatDefault);
+            continue;
+        }
+        writer.StartObject();
+        for (const auto& kv : outputs) {
+            const auto& tensor = kv.second;
+            const size_t rowByteSize = tensor.tensor_content().size() / batchSize;
+            writer.Key(kv.first.c_str(), kv.first.size());
+            writer.SetFormatOptions(rapidjson::kFormatSingleLineArray);
+            writeTensorValues(writer, tensor.tensor_content().data() + i * rowByteSize, tensor, 1);
+            writer.SetFormatOptions(rapidjson::kFormatDefault);
+        }
+        writer.EndObject();
+    }
+    writer.EndArray();
+    return StatusCode::OK;
+}
+
+Status writeColumnFormat(JsonWriter& writer, const PredictResponse& response) {
+    const auto& outputs = response.outputs();
+    writer.Key(OUTPUTS_KEY);
+    if (outputs.size() == 1) {
+        const auto& tensor = outputs.begin()->second;
+        writeTensorValues(writer, tensor.tensor_content().data(), tensor, 0);
+        return StatusCode::OK;
+    }
+    writer.StartObject();
+    for (const auto& kv : outputs) {
+        writer.Key(kv.first.c_str(), kv.first.size());
+        writeTensorValues(writer, kv.second.tensor_content().data(), kv.second, 0);
+    }
+    writer.EndObject();
+    return StatusCode::OK;
+}
+
+}  // namespace
+
 Status makeJsonFromPredictResponse(
     PredictResponse& response_proto,
     std::string* response_json,
-    Order order) {
+    Order order,
+    RequestTiming* timing) {
     if (order == Order::UNKNOWN) {
         return StatusCode::REST_PREDICT_UNKNOWN_ORDER;
     }
 
-    Timer timer;
-    using std::chrono::microseconds;
-
-    timer.start("convert");
+    enum : size_t { VALIDATE, WRITE_JSON, TIMER_END };
+    Timer<TIMER_END> timer;
+    timer.start(VALIDATE);
 
-    for (auto& kv : *response_proto.mutable_outputs()) {
-        auto& tensor = kv.second;
+    size_t valuesCount = 0;
+    for (const auto& kv : response_proto.outputs()) {
+        const auto& tensor = kv.second;
 
-        size_t expected_content_size = DataTypeSize(tensor.dtype());
+        size_t expectedValuesCount = 1;
         for (int i = 0; i < tensor.tensor_shape().dim_size(); i++) {
-            expected_content_size *= tensor.tensor_shape().dim(i).size();
+            expectedValuesCount *= tensor.tensor_shape().dim(i).size();
         }
 
-        if (tensor.tensor_content().size() != expected_content_size) {
+        if (tensor.tensor_content().size() != expectedValuesCount * DataTypeSize(tensor.dtype())) {
             return StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE;
         }
 
-        switch (tensor.dtype()) {
-        case DataType::DT_FLOAT:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(float)) {
-                tensor.add_float_val(*reinterpret_cast<float*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_DOUBLE:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(double)) {
-                tensor.add_double_val(*reinterpret_cast<double*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT32:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int32_t)) {
-                tensor.add_int_val(*reinterpret_cast<int32_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT16:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int16_t)) {
-                tensor.add_int_val(*reinterpret_cast<int16_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT8:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int8_t)) {
-                tensor.add_int_val(*reinterpret_cast<int8_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_UINT8:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(uint8_t)) {
-                tensor.add_int_val(*reinterpret_cast<uint8_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT64:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int64_t)) {
-                tensor.add_int64_val(*reinterpret_cast<int64_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_UINT32:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(uint32_t)) {
-                tensor.add_uint32_val(*reinterpret_cast<uint32_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_UINT64:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(uint64_t)) {
-                tensor.add_uint64_val(*reinterpret_cast<uint64_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        default:
+        if (!isSupportedDataType(tensor.dtype())) {
             return StatusCode::REST_UNSUPPORTED_PRECISION;
         }
+        valuesCount += expectedValuesCount;
     }
 
-    timer.stop("convert");
-    timer.start("MakeJsonFromTensors");
+    timer.stop(VALIDATE);
 
-    const auto& tf_status = MakeJsonFromTensors(
-        response_proto.outputs(),
-        order == Order::ROW ? JsonPredictRequestFormat::kRow : JsonPredictRequestFormat::kColumnar,
-        response_json);
+    if (response_proto.outputs().size() == 0) {
+        SPDLOG_ERROR("Cannot serialize predict response without outputs");
+        return StatusCode::REST_PROTO_TO_STRING_ERROR;
+    }
 
-    timer.stop("MakeJsonFromTensors");
-    spdlog::debug("tensor_content to *_val container conversion: {:.3f} ms", timer.elapsed<microseconds>("convert") / 1000);
-    spdlog::debug("MakeJsonFromTensors call: {:.3f} ms", timer.elapsed<microseconds>("MakeJsonFromTensors") / 1000);
+    timer.start(WRITE_JSON);
 
-    if (!tf_status.ok()) {
-        SPDLOG_ERROR("MakeJsonFromTensors error: {}", tf_status.error_message());
-        return StatusCode::REST_PROTO_TO_STRING_ERROR;
+    // values are written straight from tensor_content, without intermediate repeated fields
+    rapidjson::StringBuffer buffer(nullptr, valuesCount * ESTIMATED_VALUE_JSON_SIZE);
+    JsonWriter writer(buffer);
+    writer.StartObject();
+    auto status = order == Order::ROW ? writeRowFormat(writer, response_proto) : writeColumnFormat(writer, response_proto);
+    if (!status.ok()) {
+        return status;
+    }
+    writer.EndObject();
+    response_json->assign(buffer.GetString(), buffer.GetSize());
+
+    timer.stop(WRITE_JSON);
+    static Histogram& duration = MetricsRegistry::getInstance().histogram("ovms_rest_predict_stage_duration_seconds",
+        "Duration of REST predict request stages", {{"stage", "write_json"}}, MetricsRegistry::LATENCY_BUCKETS_SECONDS);
+    duration.observe(timer.elapsedSeconds(WRITE_JSON));
+    if (timing != nullptr) {
+        timing->add("write_json", timer.elapsed<std::chrono::milliseconds>(WRITE_JSON));
     }
+    OVMS_REQUEST_DEBUG("tensor_content validation: {:.3f} ms", timer.elapsed<std::chrono::milliseconds>(VALIDATE));
+    OVMS_REQUEST_DEBUG("JSON writing: {:.3f} ms", timer.elapsed<std::chrono::milliseconds>(WRITE_JSON));
 
     return StatusCode::OK;
 }
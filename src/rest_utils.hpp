@@ -23,8 +23,14 @@
 #include "status.hpp"
 
 namespace ovms {
+class RequestTiming;
+
+/**
+ * @brief Writes predict response as JSON, time of writing without validation of outputs is added to timing if it is not null
+ */
 Status makeJsonFromPredictResponse(
     tensorflow::serving::PredictResponse& response_proto,
     std::string* response_json,
-    Order order);
+    Order order,
+    RequestTiming* timing = nullptr);
 }  // namespace ovms
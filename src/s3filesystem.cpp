@@ -25,14 +25,22 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "s3filesystem.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/client/DefaultRetryStrategy.h>
+#include <aws/core/http/HttpResponse.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadBucketRequest.h>
@@ -40,6 +48,8 @@
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <spdlog/spdlog.h>
 
+#include "cloudfilecache.hpp"
+#include "instrumentedfilesystem.hpp"
 #include "stringutils.hpp"
 
 namespace ovms {
@@ -48,6 +58,29 @@ namespace s3 = Aws::S3;
 namespace fs = std::filesystem;
 
 const std::string S3FileSystem::S3_URL_PREFIX = "s3://";
+const uint64_t S3FileSystem::DOWNLOAD_PART_SIZE = 32 * 1024 * 1024;
+const uint S3FileSystem::MAX_CONNECTIONS = 16;
+const uint S3FileSystem::MAX_CHANGED_OBJECT_RETRIES = 3;
+const uint S3FileSystem::CONNECT_TIMEOUT_MS = 5000;
+const uint S3FileSystem::REQUEST_TIMEOUT_MS = 30000;
+
+namespace {
+
+/**
+ * @brief Default retry strategy of the SDK counting retries it makes
+ */
+class CountingRetryStrategy : public Aws::Client::DefaultRetryStrategy {
+public:
+    bool ShouldRetry(const Aws::Client::AWSError<Aws::Client::CoreErrors>& error, long attemptedRetries) const override {  // NOLINT(runtime/int)
+        const bool retry = Aws::Client::DefaultRetryStrategy::ShouldRetry(error, attemptedRetries);
+        if (retry) {
+            InstrumentedFileSystem::getRetriesCounter("s3").increment();
+        }
+        return retry;
+    }
+};
+
+}  // namespace
 
 StatusCode S3FileSystem::parsePath(const std::string& path, std::string* bucket, std::string* object) {
     std::smatch sm;
@@ -105,6 +138,12 @@ S3FileSystem::S3FileSystem(const Aws::SDKOptions& options, const std::string& s3
         config = Aws::Client::ClientConfiguration("default");
     }
 
+    // concurrent downloads share the client, requests wait for a free connection above this limit
+    config.maxConnections = MAX_CONNECTIONS;
+    config.connectTimeoutMs = CONNECT_TIMEOUT_MS;
+    config.requestTimeoutMs = REQUEST_TIMEOUT_MS;
+    config.retryStrategy = std::make_shared<CountingRetryStrategy>();
+
     std::string host_name, host_port, bucket, object;
     std::smatch sm;
     if (std::regex_match(s3_path, sm, s3_regex_)) {
@@ -360,13 +399,8 @@ StatusCode S3FileSystem::readTextFile(const std::string& path, std::string* cont
     if (get_object_outcome.IsSuccess()) {
         auto& object_result = get_object_outcome.GetResultWithOwnership().GetBody();
 
-        std::string data = "";
-        char c = 0;
-        while (object_result.get(c)) {
-            data += c;
-        }
-
-        *contents = data;
+        // model weights are read this way when streaming models, so the whole buffer is consumed at once
+        contents->assign(std::istreambuf_iterator<char>(object_result), std::istreambuf_iterator<char>());
     } else {
         spdlog::error("Failed to get object at {}", path);
         return StatusCode::S3_FILE_INVALID;
@@ -441,60 +475,173 @@ StatusCode S3FileSystem::downloadFileFolder(const std::string& path, const std::
             }
         }
 
+        std::vector<DownloadPart> parts;
         for (auto iter = files.begin(); iter != files.end(); ++iter) {
             if (std::any_of(acceptedFiles.begin(), acceptedFiles.end(), [&iter](const std::string& x) {
                     return iter->size() > 0 && endsWith(*iter, x);
                 })) {
-                std::string bucket, object;
-                status = parsePath(*iter, &bucket, &object);
+                std::string s3_removed_path = (*iter).substr(effective_path.size());
+                std::string local_file_path = joinPath({local_path, s3_removed_path});
+                status = prepareDownloadParts(*iter, local_file_path, parts);
                 if (status != StatusCode::OK) {
                     return status;
                 }
+            }
+        }
+        return downloadParts(parts);
+    }
+
+    std::vector<DownloadPart> parts;
+    status = prepareDownloadParts(effective_path, local_path, parts);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+    return downloadParts(parts);
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> S3FileSystem::splitIntoParts(uint64_t size, uint64_t partSize) {
+    std::vector<std::pair<uint64_t, uint64_t>> parts;
+    for (uint64_t offset = 0; offset < size; offset += partSize) {
+        parts.emplace_back(offset, std::min(partSize, size - offset));
+    }
+    return parts;
+}
+
+StatusCode S3FileSystem::prepareDownloadParts(const std::string& path, const std::string& local_path, std::vector<DownloadPart>& parts) {
+    std::string bucket, object;
+    auto status = parsePath(path, &bucket, &object);
+    if (status != StatusCode::OK) {
+        return status;
+    }
+
+    s3::Model::HeadObjectRequest head_request;
+    head_request.SetBucket(bucket.c_str());
+    head_request.SetKey(object.c_str());
+    auto head_object_outcome = client_.HeadObject(head_request);
+    if (!head_object_outcome.IsSuccess()) {
+        spdlog::error("Failed to get object metadata at {}", path);
+        return StatusCode::S3_FAILED_GET_OBJECT;
+    }
+    const uint64_t size = head_object_outcome.GetResult().GetContentLength();
+    const std::string etag = head_object_outcome.GetResult().GetETag().c_str();
+    if (CloudFileCache::getInstance().fetch(S3_URL_PREFIX + bucket + "/" + object, etag, local_path)) {
+        return StatusCode::OK;
+    }
+
+    // parts are written in place, so the file is created with its final size
+    std::ofstream(local_path.c_str(), std::ios::binary).close();
+    std::error_code ec;
+    fs::resize_file(local_path, size, ec);
+    if (ec) {
+        spdlog::error("Failed to create local file: {} {}", local_path, ec.message());
+        return StatusCode::PATH_INVALID;
+    }
+
+    // empty object has no range to download, empty local file is complete
+    if (size == 0) {
+        CloudFileCache::getInstance().store(S3_URL_PREFIX + bucket + "/" + object, etag, local_path);
+        return StatusCode::OK;
+    }
+    if (size <= DOWNLOAD_PART_SIZE) {
+        parts.push_back({bucket, object, local_path, 0, size, false, etag});
+        return StatusCode::OK;
+    }
+    for (const auto& [offset, partSize] : splitIntoParts(size, DOWNLOAD_PART_SIZE)) {
+        parts.push_back({bucket, object, local_path, offset, partSize, true, etag});
+    }
+    return StatusCode::OK;
+}
+
+StatusCode S3FileSystem::downloadPart(const DownloadPart& part, bool& objectChanged) {
+    objectChanged = false;
+    s3::Model::GetObjectRequest object_request;
+    object_request.SetBucket(part.bucket.c_str());
+    object_request.SetKey(part.object.c_str());
+    object_request.SetIfMatch(part.objectVersion.c_str());
+    if (part.ranged) {
+        object_request.SetRange(("bytes=" + std::to_string(part.offset) + "-" + std::to_string(part.offset + part.size - 1)).c_str());
+    }
+
+    auto get_object_outcome = client_.GetObject(object_request);
+    if (!get_object_outcome.IsSuccess() && get_object_outcome.GetError().GetResponseCode() == Aws::Http::HttpResponseCode::PRECONDITION_FAILED) {
+        spdlog::warn("Object at {}/{} changed during download", part.bucket, part.object);
+        objectChanged = true;
+        return StatusCode::OK;
+    }
+    if (!get_object_outcome.IsSuccess()) {
+        spdlog::error("Failed to get object at {}/{} range offset: {} size: {}", part.bucket, part.object, part.offset, part.size);
+        return StatusCode::S3_FAILED_GET_OBJECT;
+    }
+    auto& retrieved_file = get_object_outcome.GetResultWithOwnership().GetBody();
+    std::fstream output_file(part.localPath.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+    output_file.seekp(part.offset);
+    output_file << retrieved_file.rdbuf();
+    output_file.close();
+    if (!output_file) {
+        spdlog::error("Failed to write local file: {}", part.localPath);
+        return StatusCode::S3_FAILED_GET_OBJECT;
+    }
+    return StatusCode::OK;
+}
 
-                // Send a request for the objects metadata
-                s3::Model::GetObjectRequest object_request;
-                object_request.SetBucket(bucket.c_str());
-                object_request.SetKey(object.c_str());
-
-                auto get_object_outcome = client_.GetObject(object_request);
-                if (get_object_outcome.IsSuccess()) {
-                    auto& retrieved_file =
-                        get_object_outcome.GetResultWithOwnership().GetBody();
-                    std::string s3_removed_path = (*iter).substr(effective_path.size());
-                    std::string local_file_path = joinPath({local_path, s3_removed_path});
-                    std::ofstream output_file(local_file_path.c_str(), std::ios::binary);
-                    output_file << retrieved_file.rdbuf();
-                    output_file.close();
-                } else {
-                    spdlog::error("Failed to get object at {}", *iter);
-                    return StatusCode::S3_FAILED_GET_OBJECT;
+StatusCode S3FileSystem::downloadParts(std::vector<DownloadPart> parts) {
+    for (uint attempt = 0; !parts.empty(); ++attempt) {
+        // files and parts of large files are downloaded concurrently, each thread uses single connection
+        const size_t threadsCount = std::min<size_t>(MAX_CONNECTIONS, parts.size());
+        std::atomic<size_t> nextPart{0};
+        std::mutex resultMtx;
+        StatusCode result = StatusCode::OK;
+        std::set<std::string> changedObjects;
+        auto download = [this, &parts, &nextPart, &resultMtx, &result, &changedObjects]() {
+            for (size_t i = nextPart++; i < parts.size(); i = nextPart++) {
+                bool objectChanged = false;
+                auto status = downloadPart(parts[i], objectChanged);
+                if (status != StatusCode::OK) {
+                    std::lock_guard<std::mutex> lock(resultMtx);
+                    result = status;
+                    // remaining parts are skipped
+                    nextPart = parts.size();
+                } else if (objectChanged) {
+                    std::lock_guard<std::mutex> lock(resultMtx);
+                    changedObjects.insert(parts[i].localPath);
                 }
             }
+        };
+        if (threadsCount <= 1) {
+            download();
+        } else {
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < threadsCount; ++i) {
+                threads.emplace_back(download);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
         }
-    } else {
-        std::string bucket, object;
-        auto s = parsePath(effective_path, &bucket, &object);
-        if (s != StatusCode::OK) {
-            return s;
+        if (result != StatusCode::OK) {
+            return result;
         }
-
-        // Send a request for the objects metadata
-        s3::Model::GetObjectRequest object_request;
-        object_request.SetBucket(bucket.c_str());
-        object_request.SetKey(object.c_str());
-
-        auto get_object_outcome = client_.GetObject(object_request);
-        if (get_object_outcome.IsSuccess()) {
-            auto& retrieved_file = get_object_outcome.GetResultWithOwnership().GetBody();
-            std::ofstream output_file(local_path.c_str(), std::ios::binary);
-            output_file << retrieved_file.rdbuf();
-            output_file.close();
-        } else {
-            spdlog::error("Failed to get object at {}", effective_path);
-            return StatusCode::S3_FAILED_GET_OBJECT;
+        std::vector<DownloadPart> changedParts;
+        for (const auto& part : parts) {
+            if (part.offset != 0) {
+                continue;
+            }
+            if (changedObjects.count(part.localPath) == 0) {
+                CloudFileCache::getInstance().store(S3_URL_PREFIX + part.bucket + "/" + part.object, part.objectVersion, part.localPath);
+                continue;
+            }
+            if (attempt >= MAX_CHANGED_OBJECT_RETRIES) {
+                spdlog::error("Object at {}/{} kept changing during download", part.bucket, part.object);
+                return StatusCode::S3_FAILED_GET_OBJECT;
+            }
+            // object is read again from the start with its new size and ETag
+            auto status = prepareDownloadParts(S3_URL_PREFIX + part.bucket + "/" + part.object, part.localPath, changedParts);
+            if (status != StatusCode::OK) {
+                return status;
+            }
         }
+        parts = std::move(changedParts);
     }
-
     return StatusCode::OK;
 }
 
@@ -15,8 +15,10 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstdint>
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <aws/core/Aws.h>
@@ -126,7 +128,63 @@ public:
 
     static const std::string S3_URL_PREFIX;
 
+    /**
+     * @brief Objects larger than part size are downloaded with concurrent ranged requests
+     */
+    static const uint64_t DOWNLOAD_PART_SIZE;
+
+    /**
+     * @brief Size of connection pool, also number of parts downloaded concurrently
+     */
+    static const uint MAX_CONNECTIONS;
+
+    /**
+     * @brief Downloads of objects replaced while their parts were downloaded are started over at most this many times
+     */
+    static const uint MAX_CHANGED_OBJECT_RETRIES;
+
+    /**
+     * @brief Time limits of establishing connection and of waiting for response data, so hanging requests fail instead of delaying model checks
+     */
+    static const uint CONNECT_TIMEOUT_MS;
+    static const uint REQUEST_TIMEOUT_MS;
+
+    /**
+     * @brief Splits object of given size into ranges of at most part size, described by offset and size
+     */
+    static std::vector<std::pair<uint64_t, uint64_t>> splitIntoParts(uint64_t size, uint64_t partSize);
+
 private:
+    struct DownloadPart {
+        std::string bucket;
+        std::string object;
+        std::string localPath;
+        uint64_t offset;
+        uint64_t size;
+        bool ranged;
+        // ETag of the object, identifies its content in cloud file cache
+        std::string objectVersion;
+    };
+
+    /**
+     * @brief Creates local file of object size and adds its parts to download, cached objects are not downloaded
+     */
+    StatusCode prepareDownloadParts(const std::string& path, const std::string& local_path, std::vector<DownloadPart>& parts);
+
+    /**
+     * @brief Downloads parts of all objects on pool of MAX_CONNECTIONS threads
+     *
+     * Objects replaced during download are downloaded again from the start, so parts of different contents are not mixed.
+     */
+    StatusCode downloadParts(std::vector<DownloadPart> parts);
+
+    /**
+     * @brief Downloads part if object still has the ETag read before download
+     *
+     * @param objectChanged set to true if object was replaced since, part is not written then
+     */
+    StatusCode downloadPart(const DownloadPart& part, bool& objectChanged);
+
     /**
      * @brief 
      * 
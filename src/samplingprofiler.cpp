@@ -0,0 +1,196 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "samplingprofiler.hpp"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+std::atomic<SamplingProfiler::SamplesBuffer*> SamplingProfiler::activeBuffer{nullptr};
+std::atomic<uint32_t> SamplingProfiler::handlersInProgress{0};
+
+namespace {
+// frames of the signal handler and of the signal trampoline on top of each sample
+const int HANDLER_FRAMES = 2;
+
+void readThreadNames(std::map<pid_t, std::string>& names) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+        std::ifstream comm(entry.path() / "comm");
+        std::string name;
+        if (!std::getline(comm, name)) {
+            continue;
+        }
+        try {
+            names[static_cast<pid_t>(std::stol(entry.path().filename().string()))] = name;
+        } catch (const std::exception&) {
+        }
+    }
+}
+
+std::string symbolize(void* address) {
+    Dl_info info;
+    if (dladdr(address, &info) == 0) {
+        std::stringstream ss;
+        ss << address;
+        return ss.str();
+    }
+    if (info.dli_sname != nullptr) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 ? demangled : info.dli_sname;
+        std::free(demangled);
+        return name;
+    }
+    // symbols not exported by the module can be resolved offline from module offset
+    std::stringstream ss;
+    ss << (info.dli_fname != nullptr ? std::filesystem::path(info.dli_fname).filename().string() : "?")
+       << "+0x" << std::hex << (static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+    return ss.str();
+}
+}  // namespace
+
+void setCurrentThreadName(const std::string& name) {
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
+
+void SamplingProfiler::handleSignal(int) {
+    handlersInProgress.fetch_add(1);
+    const int savedErrno = errno;
+    SamplesBuffer* samplesBuffer = activeBuffer.load();
+    if (samplesBuffer != nullptr) {
+        const size_t index = samplesBuffer->count.fetch_add(1, std::memory_order_relaxed);
+        if (index < MAX_SAMPLES) {
+            Sample& sample = samplesBuffer->samples[index];
+            sample.threadId = static_cast<pid_t>(syscall(SYS_gettid));
+            sample.depth = backtrace(sample.frames, MAX_STACK_DEPTH);
+            sample.ready.store(true, std::memory_order_release);
+        }
+    }
+    errno = savedErrno;
+    handlersInProgress.fetch_sub(1);
+}
+
+Status SamplingProfiler::profile(std::chrono::seconds duration, uint frequency, std::string& profile) {
+    if (duration.count() < 1 || duration.count() > MAX_DURATION_SECONDS || frequency < 1 || frequency > MAX_FREQUENCY) {
+        return StatusCode::PROFILER_INVALID_PARAMETERS;
+    }
+    std::unique_lock<std::mutex> lock(mtx, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return StatusCode::PROFILER_ALREADY_RUNNING;
+    }
+    if (!buffer) {
+        buffer = std::make_unique<SamplesBuffer>();
+    }
+    for (size_t i = 0; i < MAX_SAMPLES; ++i) {
+        buffer->samples[i].ready.store(false, std::memory_order_relaxed);
+    }
+    buffer->count.store(0);
+    // first backtrace loads the unwinder library, which must not happen in signal handler
+    void* warmUpFrame;
+    backtrace(&warmUpFrame, 1);
+
+    // handler stays installed afterwards, signals still pending when sampling stops must not terminate the process
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = &SamplingProfiler::handleSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0) {
+        spdlog::error("Failed to install profiler signal handler: {}", std::strerror(errno));
+        return StatusCode::PROFILER_START_FAILED;
+    }
+    std::map<pid_t, std::string> threadNames;
+    readThreadNames(threadNames);
+    activeBuffer.store(buffer.get());
+
+    struct itimerval timer;
+    std::memset(&timer, 0, sizeof(timer));
+    const long intervalMicroseconds = 1000000 / frequency;
+    timer.it_interval.tv_sec = intervalMicroseconds / 1000000;
+    timer.it_interval.tv_usec = intervalMicroseconds % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        activeBuffer.store(nullptr);
+        spdlog::error("Failed to start profiler timer: {}", std::strerror(errno));
+        return StatusCode::PROFILER_START_FAILED;
+    }
+    spdlog::info("Started sampling profiler for {} s at {} Hz", duration.count(), frequency);
+    std::this_thread::sleep_for(duration);
+
+    std::memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    activeBuffer.store(nullptr);
+    while (handlersInProgress.load() > 0) {
+        std::this_thread::yield();
+    }
+    // threads started during sampling are named as well, exited threads keep names read at start
+    readThreadNames(threadNames);
+
+    const size_t samplesCount = buffer->count.load();
+    if (samplesCount > MAX_SAMPLES) {
+        spdlog::warn("Profiler dropped {} samples above limit of {}", samplesCount - MAX_SAMPLES, MAX_SAMPLES);
+    }
+    std::map<std::string, uint64_t> stacks;
+    std::unordered_map<void*, std::string> symbols;
+    for (size_t i = 0; i < std::min(samplesCount, MAX_SAMPLES); ++i) {
+        const Sample& sample = buffer->samples[i];
+        if (!sample.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+        auto name = threadNames.find(sample.threadId);
+        std::string stack = name != threadNames.end() ? name->second : "thread-" + std::to_string(sample.threadId);
+        for (int frame = sample.depth - 1; frame >= HANDLER_FRAMES; --frame) {
+            auto symbol = symbols.find(sample.frames[frame]);
+            if (symbol == symbols.end()) {
+                symbol = symbols.emplace(sample.frames[frame], symbolize(sample.frames[frame])).first;
+            }
+            stack += ';';
+            stack += symbol->second;
+        }
+        ++stacks[stack];
+    }
+    std::stringstream ss;
+    for (const auto& [stack, count] : stacks) {
+        ss << stack << ' ' << count << '\n';
+    }
+    profile = ss.str();
+    spdlog::info("Sampling profiler finished with {} samples", std::min(samplesCount, MAX_SAMPLES));
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
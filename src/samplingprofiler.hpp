@@ -0,0 +1,92 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <sys/types.h>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Sets name of calling thread shown by profiles and system tools, names are truncated to 15 characters
+ */
+void setCurrentThreadName(const std::string& name);
+
+/**
+ * @brief Samples call stacks of all server threads on demand, production builds are profiled as they run
+ *
+ * Samples are taken by SIGPROF handler at the given frequency of process CPU time, so idle threads are not sampled.
+ * Handler only copies the stack into preallocated buffer, symbols are resolved after sampling finishes.
+ * Profile is written in collapsed stack format read by flamegraph.pl, speedscope and pprof converters,
+ * each line holds thread name and frames from the outermost separated by semicolons, followed by sample count.
+ */
+class SamplingProfiler {
+public:
+    static SamplingProfiler& getInstance() {
+        static SamplingProfiler instance;
+        return instance;
+    }
+
+    static constexpr uint MAX_DURATION_SECONDS = 300;
+    static constexpr uint MAX_FREQUENCY = 1000;
+    static constexpr uint DEFAULT_FREQUENCY = 99;
+
+    /**
+     * @brief Samples stacks for duration and returns collapsed profile, blocks calling thread until done
+     *
+     * @return PROFILER_ALREADY_RUNNING if other profile is in progress, PROFILER_INVALID_PARAMETERS or OK
+     */
+    Status profile(std::chrono::seconds duration, uint frequency, std::string& profile);
+
+    static constexpr int MAX_STACK_DEPTH = 64;
+
+    /**
+     * @brief Samples kept in a single profile, later samples are counted as dropped
+     */
+    static constexpr size_t MAX_SAMPLES = 1 << 16;
+
+private:
+    SamplingProfiler() = default;
+
+    struct Sample {
+        std::atomic<bool> ready{false};
+        pid_t threadId;
+        int depth;
+        void* frames[MAX_STACK_DEPTH];
+    };
+
+    struct SamplesBuffer {
+        std::unique_ptr<Sample[]> samples = std::make_unique<Sample[]>(MAX_SAMPLES);
+        std::atomic<size_t> count{0};
+    };
+
+    static void handleSignal(int signal);
+
+    static std::atomic<SamplesBuffer*> activeBuffer;
+    static std::atomic<uint32_t> handlersInProgress;
+
+    std::mutex mtx;
+    std::unique_ptr<SamplesBuffer> buffer;
+};
+
+}  // namespace ovms
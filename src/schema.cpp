@@ -50,6 +50,24 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 						"shape": {
 							"type": ["object", "string"]
 						},
+						"layout": {
+							"type": ["object", "string"]
+						},
+						"precision": {
+							"oneOf": [
+								{
+									"type": "string",
+									"enum": ["FP32", "FP16", "U8", "I8", "U16", "I16", "I32"]
+								},
+								{
+									"type": "object",
+									"additionalProperties": {
+										"type": "string",
+										"enum": ["FP32", "FP16", "U8", "I8", "U16", "I16", "I32"]
+									}
+								}
+							]
+						},
 						"nireq": {
 							"type": "integer"
 						},
@@ -58,6 +76,294 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 						},
 						"plugin_config": {
 							"type": "object"
+						},
+						"dynamic_batching": {
+							"type": "object",
+							"required": ["max_batch_size"],
+							"properties": {
+								"max_batch_size": {
+									"type": "integer",
+									"minimum": 1
+								},
+								"timeout_us": {
+									"type": "integer",
+									"minimum": 0
+								}
+							},
+							"additionalProperties": false
+						},
+						"warmup_iterations": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"load_on_demand": {
+							"type": "boolean"
+						},
+						"idle_unload_seconds": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"numa_node": {
+							"type": "integer",
+							"minimum": 0,
+							"maximum": 1023
+						},
+						"isolation_group": {
+							"type": "string",
+							"minLength": 1
+						},
+						"replica_devices": {
+							"type": "array",
+							"items": {
+								"type": "string",
+								"minLength": 1
+							},
+							"maxItems": 8
+						},
+						"version_weights": {
+							"type": "object",
+							"patternProperties": {
+								"^[1-9][0-9]*$": {
+									"type": "integer",
+									"minimum": 0,
+									"maximum": 1000000
+								}
+							},
+							"additionalProperties": false
+						},
+						"cpu_streams_weight": {
+							"type": "integer",
+							"minimum": 1,
+							"maximum": 1000
+						},
+						"auto_tune": {
+							"type": "object",
+							"properties": {
+								"latency_slo_ms": {
+									"type": "integer",
+									"minimum": 0
+								},
+								"measurement_ms": {
+									"type": "integer",
+									"minimum": 10,
+									"maximum": 60000
+								}
+							},
+							"additionalProperties": false
+						},
+						"shape_buckets": {
+							"type": "object",
+							"required": ["sizes"],
+							"properties": {
+								"sizes": {
+									"type": "array",
+									"items": {
+										"type": "integer",
+										"minimum": 1
+									},
+									"minItems": 1,
+									"maxItems": 16
+								},
+								"dimension": {
+									"type": "integer",
+									"minimum": 0
+								}
+							},
+							"additionalProperties": false
+						},
+						"micro_batching": {
+							"type": "boolean"
+						},
+						"overlap_request_processing": {
+							"type": "boolean"
+						},
+						"request_coalescing": {
+							"type": "boolean"
+						},
+						"shared_gpu_context": {
+							"type": "boolean"
+						},
+						"response_cache": {
+							"type": "object",
+							"required": ["size_mb"],
+							"properties": {
+								"size_mb": {
+									"type": "integer",
+									"minimum": 1
+								},
+								"ttl_seconds": {
+									"type": "integer",
+									"minimum": 0
+								}
+							},
+							"additionalProperties": false
+						},
+						"node_output_cache": {
+							"type": "object",
+							"required": ["size_mb"],
+							"properties": {
+								"size_mb": {
+									"type": "integer",
+									"minimum": 1
+								},
+								"ttl_ms": {
+									"type": "integer",
+									"minimum": 1
+								}
+							},
+							"additionalProperties": false
+						},
+						"hedging": {
+							"type": "object",
+							"properties": {
+								"percentile": {
+									"type": "integer",
+									"minimum": 50,
+									"maximum": 99
+								},
+								"budget_percent": {
+									"type": "integer",
+									"minimum": 1,
+									"maximum": 100
+								}
+							},
+							"additionalProperties": false
+						},
+						"storage_polling": {
+							"type": "object",
+							"properties": {
+								"interval_seconds": {
+									"type": "integer",
+									"minimum": 1
+								},
+								"max_interval_seconds": {
+									"type": "integer",
+									"minimum": 1
+								}
+							},
+							"additionalProperties": false
+						},
+						"stateful": {
+							"type": "object",
+							"properties": {
+								"timeout_seconds": {
+									"type": "integer",
+									"minimum": 1
+								},
+								"max_sequence_number": {
+									"type": "integer",
+									"minimum": 1
+								}
+							},
+							"additionalProperties": false
+						},
+						"output_precision": {
+							"oneOf": [
+								{
+									"type": "string",
+									"enum": ["FP32", "FP16", "BF16"]
+								},
+								{
+									"type": "object",
+									"additionalProperties": {
+										"type": "string",
+										"enum": ["FP32", "FP16", "BF16"]
+									}
+								}
+							]
+						},
+						"preprocessing": {
+							"type": "object",
+							"additionalProperties": {
+								"type": "object",
+								"properties": {
+									"resize": {
+										"type": "string",
+										"enum": ["bilinear", "area"]
+									},
+									"source_shape": {
+										"type": "array",
+										"items": {
+											"type": "integer",
+											"minimum": 1
+										},
+										"minItems": 4,
+										"maxItems": 4
+									},
+									"color_format": {
+										"type": "string",
+										"enum": ["RGB", "BGR"]
+									},
+									"mean": {
+										"type": "array",
+										"items": {
+											"type": "number"
+										},
+										"minItems": 1
+									},
+									"scale": {
+										"oneOf": [
+											{
+												"type": "number",
+												"minimum": 0,
+												"exclusiveMinimum": true
+											},
+											{
+												"type": "array",
+												"items": {
+													"type": "number",
+													"minimum": 0,
+												"exclusiveMinimum": true
+												},
+												"minItems": 1
+											}
+										]
+									}
+								},
+								"dependencies": {
+									"resize": ["source_shape"],
+									"source_shape": ["resize"]
+								},
+								"additionalProperties": false
+							}
+						},
+						"postprocessing": {
+							"type": "object",
+							"additionalProperties": {
+								"type": "object",
+								"properties": {
+									"top_k": {
+										"type": "integer",
+										"minimum": 1
+									},
+									"min_score": {
+										"type": "number"
+									}
+								},
+								"additionalProperties": false
+							}
+						},
+						"admission_control": {
+							"type": "object",
+							"properties": {
+								"max_queue_size": {
+									"type": "integer",
+									"minimum": 0
+								},
+								"max_queue_time_us": {
+									"type": "integer",
+									"minimum": 0
+								},
+								"reserved_high_priority_streams": {
+									"type": "integer",
+									"minimum": 0
+								},
+								"max_low_priority_queue_size": {
+									"type": "integer",
+									"minimum": 0
+								}
+							},
+							"additionalProperties": false
 						}
 					},
 					"additionalProperties": false
@@ -101,7 +407,7 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 		},
 		"node_config": {
 			"type": "object",
-			"required": ["name", "model_name", "inputs", "outputs"],
+			"required": ["name", "inputs", "outputs"],
 			"properties": {
 				"name": {
 					"type": "string"
@@ -111,11 +417,23 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 				},
 				"type": {
 					"type": "string",
-					"enum": ["DL model", "Demultiplexer", "Batch dispatcher"]
+					"enum": ["DL model", "custom", "Demultiplexer", "Batch dispatcher"]
+				},
+				"library_path": {
+					"type": "string"
+				},
+				"params": {
+					"type": "object",
+					"additionalProperties": {
+						"type": "string"
+					}
 				},
 				"version": {
 					"type": "integer"
 				},
+				"device": {
+					"type": "string"
+				},
 				"inputs": {
 					"type": "array",
 					"items": {
@@ -127,6 +445,30 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 					"items": {
 						"$ref": "#/definitions/output_alias"
 					}
+				},
+				"demultiply_count": {
+					"type": "integer",
+					"minimum": 1
+				},
+				"gather_from_node": {
+					"type": "string"
+				},
+				"run_if": {
+					"type": "object",
+					"required": ["input"],
+					"properties": {
+						"input": {
+							"type": "string"
+						},
+						"min_score": {
+							"type": "number"
+						},
+						"min_count": {
+							"type": "integer",
+							"minimum": 1
+						}
+					},
+					"additionalProperties": false
 				}
 			},
 			"additionalProperties": false
@@ -155,6 +497,9 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 					"items": {
 						"$ref": "#/definitions/source_node"
 					}
+				},
+				"gather_from_node": {
+					"type": "string"
 				}
 			},
 			"additionalProperties": false
@@ -0,0 +1,223 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "sequencemanager.hpp"
+
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include "ov_utils.hpp"
+
+namespace ovms {
+
+namespace {
+// idle sequences are looked for at most this often, and always when sequence limit is reached
+const std::chrono::seconds IDLE_CHECK_INTERVAL(1);
+
+template <typename T>
+bool readSingleValue(const tensorflow::TensorProto& input, const google::protobuf::RepeatedField<T>& typedValues, T& value) {
+    for (const auto& dim : input.tensor_shape().dim()) {
+        if (dim.size() != 1) {
+            return false;
+        }
+    }
+    if (typedValues.size() == 1 && input.tensor_content().empty()) {
+        value = typedValues.Get(0);
+        return true;
+    }
+    if (typedValues.size() == 0 && input.tensor_content().size() == sizeof(T)) {
+        std::memcpy(&value, input.tensor_content().data(), sizeof(T));
+        return true;
+    }
+    return false;
+}
+
+// unique across versions, so requests continuing sequence without version find the version it was started on
+uint64_t nextAssignedSequenceId() {
+    static std::atomic<uint64_t> counter{0};
+    uint64_t id;
+    do {
+        id = ++counter;
+    } while (id == 0);
+    return id;
+}
+}  // namespace
+
+bool isSequenceInput(const std::string& name) {
+    return name == SEQUENCE_ID_INPUT || name == SEQUENCE_CONTROL_INPUT;
+}
+
+size_t countSequenceInputs(const tensorflow::serving::PredictRequest& request) {
+    return request.inputs().count(SEQUENCE_ID_INPUT) + request.inputs().count(SEQUENCE_CONTROL_INPUT);
+}
+
+Status getSequenceProcessingSpec(const tensorflow::serving::PredictRequest& request, uint64_t& sequenceId, uint32_t& sequenceControl) {
+    sequenceId = 0;
+    sequenceControl = NO_CONTROL_INPUT;
+    auto it = request.inputs().find(SEQUENCE_ID_INPUT);
+    if (it != request.inputs().end()) {
+        if (it->second.dtype() != tensorflow::DataType::DT_UINT64 || !readSingleValue(it->second, it->second.uint64_val(), sequenceId)) {
+            return StatusCode::INVALID_SEQUENCE_CONTROL_INPUT;
+        }
+    }
+    it = request.inputs().find(SEQUENCE_CONTROL_INPUT);
+    if (it != request.inputs().end()) {
+        if (it->second.dtype() != tensorflow::DataType::DT_UINT32 || !readSingleValue(it->second, it->second.uint32_val(), sequenceControl) ||
+            sequenceControl > SEQUENCE_END) {
+            return StatusCode::INVALID_SEQUENCE_CONTROL_INPUT;
+        }
+    }
+    if (sequenceId == 0 && sequenceControl != SEQUENCE_START) {
+        return StatusCode::SEQUENCE_ID_NOT_PROVIDED;
+    }
+    return StatusCode::OK;
+}
+
+uint64_t getContinuedSequenceId(const tensorflow::serving::PredictRequest& request) {
+    if (countSequenceInputs(request) == 0) {
+        return 0;
+    }
+    uint64_t sequenceId;
+    uint32_t sequenceControl;
+    if (!getSequenceProcessingSpec(request, sequenceId, sequenceControl).ok() || sequenceControl == SEQUENCE_START) {
+        return 0;
+    }
+    return sequenceId;
+}
+
+void addSequenceIdOutput(uint64_t sequenceId, tensorflow::serving::PredictResponse& response) {
+    auto& output = (*response.mutable_outputs())[SEQUENCE_ID_INPUT];
+    output.Clear();
+    output.set_dtype(tensorflow::DataType::DT_UINT64);
+    output.mutable_tensor_shape()->add_dim()->set_size(1);
+    output.mutable_tensor_content()->assign(reinterpret_cast<const char*>(&sequenceId), sizeof(sequenceId));
+}
+
+Status Sequence::restoreMemoryState(InferenceEngine::InferRequest& inferRequest) const {
+    try {
+        for (auto& state : inferRequest.QueryState()) {
+            auto it = memoryState.find(state.GetName());
+            if (it == memoryState.end()) {
+                state.Reset();
+            } else {
+                state.SetState(it->second);
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_ERROR("Cannot restore memory state of sequence {}: {}", id, e.what());
+        return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+    }
+    return StatusCode::OK;
+}
+
+Status Sequence::updateMemoryState(InferenceEngine::InferRequest& inferRequest) {
+    try {
+        for (auto& state : inferRequest.QueryState()) {
+            auto lastState = state.GetLastState();
+            auto& stored = memoryState[state.GetName()];
+            // state of the same size is copied into blob of previous request
+            if (stored != nullptr && stored->byteSize() == lastState->byteSize()) {
+                std::memcpy((void*)stored->buffer(), (const void*)lastState->cbuffer(), lastState->byteSize());
+                continue;
+            }
+            stored = blobClone(lastState);
+            if (stored == nullptr) {
+                memoryState.erase(state.GetName());
+                SPDLOG_ERROR("Cannot copy memory state {} of sequence {}", state.GetName(), id);
+                return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_ERROR("Cannot read memory state of sequence {}: {}", id, e.what());
+        return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+    }
+    return StatusCode::OK;
+}
+
+Status SequenceManager::getSequence(uint64_t& sequenceId, uint32_t sequenceControl, std::shared_ptr<Sequence>& sequence,
+    std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (now - lastIdleCheck >= IDLE_CHECK_INTERVAL) {
+        removeIdleSequences(now);
+    }
+    if (sequenceControl == SEQUENCE_START) {
+        if (sequenceId != 0 && sequences.count(sequenceId) > 0) {
+            return StatusCode::SEQUENCE_ALREADY_EXISTS;
+        }
+        if (sequences.size() >= maxSequenceNumber) {
+            removeIdleSequences(now);
+            if (sequences.size() >= maxSequenceNumber) {
+                return StatusCode::MAX_SEQUENCE_NUMBER_REACHED;
+            }
+        }
+        if (sequenceId == 0) {
+            // skips ids chosen by clients
+            do {
+                sequenceId = nextAssignedSequenceId();
+            } while (sequences.count(sequenceId) > 0);
+        }
+        sequence = std::make_shared<Sequence>(sequenceId);
+        sequences[sequenceId] = {sequence, now};
+        return StatusCode::OK;
+    }
+    auto it = sequences.find(sequenceId);
+    if (it == sequences.end()) {
+        return StatusCode::SEQUENCE_MISSING;
+    }
+    if (now - it->second.lastActivity > timeout) {
+        it->second.sequence->terminate();
+        sequences.erase(it);
+        return StatusCode::SEQUENCE_MISSING;
+    }
+    it->second.lastActivity = now;
+    sequence = it->second.sequence;
+    return StatusCode::OK;
+}
+
+void SequenceManager::removeSequence(uint64_t sequenceId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = sequences.find(sequenceId);
+    if (it == sequences.end()) {
+        return;
+    }
+    it->second.sequence->terminate();
+    sequences.erase(it);
+}
+
+bool SequenceManager::hasSequence(uint64_t sequenceId) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return sequences.count(sequenceId) > 0;
+}
+
+size_t SequenceManager::getSequencesCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return sequences.size();
+}
+
+void SequenceManager::removeIdleSequences(std::chrono::steady_clock::time_point now) {
+    lastIdleCheck = now;
+    for (auto it = sequences.begin(); it != sequences.end();) {
+        if (now - it->second.lastActivity > timeout) {
+            SPDLOG_DEBUG("Sequence {} removed after {} s of inactivity", it->first, timeout.count());
+            it->second.sequence->terminate();
+            it = sequences.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,165 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <inference_engine.hpp>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "status.hpp"
+
+namespace ovms {
+
+const std::string SEQUENCE_ID_INPUT = "sequence_id";
+const std::string SEQUENCE_CONTROL_INPUT = "sequence_control_input";
+
+enum SequenceControl : uint32_t {
+    NO_CONTROL_INPUT = 0,
+    SEQUENCE_START = 1,
+    SEQUENCE_END = 2,
+};
+
+/**
+ * @brief Checks if request input carries sequence id or control value instead of network input
+ */
+bool isSequenceInput(const std::string& name);
+
+/**
+ * @brief Counts sequence id and control inputs of request
+ */
+size_t countSequenceInputs(const tensorflow::serving::PredictRequest& request);
+
+/**
+ * @brief Reads sequence id from DT_UINT64 input and control value from DT_UINT32 input of request
+ *
+ * Both inputs hold a single value in typed field or in tensor_content, missing inputs read as 0.
+ */
+Status getSequenceProcessingSpec(const tensorflow::serving::PredictRequest& request, uint64_t& sequenceId, uint32_t& sequenceControl);
+
+/**
+ * @brief Gets id of sequence continued or ended by request
+ *
+ * @return id or 0 if request starts sequence, has no sequence inputs or these are invalid
+ */
+uint64_t getContinuedSequenceId(const tensorflow::serving::PredictRequest& request);
+
+/**
+ * @brief Adds sequence id output to response, so that clients starting sequence learn the id assigned by server
+ */
+void addSequenceIdOutput(uint64_t sequenceId, tensorflow::serving::PredictResponse& response);
+
+using sequence_memory_state_t = std::unordered_map<std::string, InferenceEngine::Blob::Ptr>;
+
+/**
+ * @brief Memory state of network kept between requests of one sequence
+ *
+ * State is stored in the sequence rather than in an infer request, so requests of a sequence run on any idle stream.
+ * Requests of a sequence are inferred one at a time under its mutex.
+ */
+class Sequence {
+public:
+    explicit Sequence(uint64_t id) :
+        id(id) {}
+
+    uint64_t getId() const {
+        return id;
+    }
+
+    std::mutex& getMutex() {
+        return mtx;
+    }
+
+    bool isTerminated() const {
+        return terminated;
+    }
+
+    void terminate() {
+        terminated = true;
+    }
+
+    /**
+     * @brief Sets memory states of infer request to state of this sequence, resets them for a sequence without state yet
+     */
+    Status restoreMemoryState(InferenceEngine::InferRequest& inferRequest) const;
+
+    /**
+     * @brief Copies memory states of infer request after inference of a request of this sequence
+     */
+    Status updateMemoryState(InferenceEngine::InferRequest& inferRequest);
+
+    const sequence_memory_state_t& getMemoryState() const {
+        return memoryState;
+    }
+
+private:
+    const uint64_t id;
+    std::mutex mtx;
+    std::atomic<bool> terminated{false};
+    sequence_memory_state_t memoryState;
+};
+
+/**
+ * @brief Sequences of a stateful model version, started and ended by control input of requests and dropped when idle
+ */
+class SequenceManager {
+public:
+    SequenceManager(uint32_t maxSequenceNumber, std::chrono::seconds timeout) :
+        maxSequenceNumber(maxSequenceNumber),
+        timeout(timeout) {}
+
+    /**
+     * @brief Starts new sequence or finds existing sequence for request
+     *
+     * @param sequenceId id from request, 0 with SEQUENCE_START is replaced with unique id assigned by server
+     * @param sequenceControl control value from request
+     * @param sequence receives sequence of the request
+     */
+    Status getSequence(uint64_t& sequenceId, uint32_t sequenceControl, std::shared_ptr<Sequence>& sequence,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief Removes sequence, requests waiting for it fail as terminated
+     */
+    void removeSequence(uint64_t sequenceId);
+
+    bool hasSequence(uint64_t sequenceId) const;
+
+    size_t getSequencesCount() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<Sequence> sequence;
+        std::chrono::steady_clock::time_point lastActivity;
+    };
+
+    void removeIdleSequences(std::chrono::steady_clock::time_point now);
+
+    const uint32_t maxSequenceNumber;
+    const std::chrono::seconds timeout;
+    mutable std::mutex mtx;
+    std::unordered_map<uint64_t, Entry> sequences;
+    std::chrono::steady_clock::time_point lastIdleCheck;
+};
+
+}  // namespace ovms
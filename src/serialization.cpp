@@ -17,11 +17,11 @@
 
 namespace ovms {
 
-Status serializeBlobToTensorProto(
+namespace {
+
+Status setTensorProtoDataType(
     tensorflow::TensorProto& responseOutput,
-    const std::shared_ptr<TensorInfo>& networkOutput,
-    InferenceEngine::Blob::Ptr blob) {
-    responseOutput.Clear();
+    const std::shared_ptr<TensorInfo>& networkOutput) {
     switch (networkOutput->getPrecision()) {
     case InferenceEngine::Precision::FP32:
         responseOutput.set_dtype(tensorflow::DataTypeToEnum<float>::value);
@@ -39,21 +39,26 @@ Status serializeBlobToTensorProto(
         responseOutput.set_dtype(tensorflow::DataTypeToEnum<int8_t>::value);
         break;
 
-    // 2 byte padding [v1, v0, 0, 0, u1, u0, 0, 0, ...]
+    // 2 byte values packed in tensor_content, as read by TensorFlow tensor_util, not padded to 4 bytes in int_val and half_val
     case InferenceEngine::Precision::U16:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<uint32_t>::value);
+        responseOutput.set_dtype(tensorflow::DataTypeToEnum<uint16_t>::value);
         break;
     case InferenceEngine::Precision::FP16:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<float>::value);
+        responseOutput.set_dtype(tensorflow::DataType::DT_HALF);
         break;
 
     case InferenceEngine::Precision::I64:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<int32_t>::value);
+        responseOutput.set_dtype(tensorflow::DataTypeToEnum<int64_t>::value);
+        break;
+    case InferenceEngine::Precision::U64:
+        responseOutput.set_dtype(tensorflow::DataTypeToEnum<uint64_t>::value);
+        break;
+    case InferenceEngine::Precision::BOOL:
+        responseOutput.set_dtype(tensorflow::DataTypeToEnum<bool>::value);
         break;
 
     case InferenceEngine::Precision::Q78:
     case InferenceEngine::Precision::BIN:
-    case InferenceEngine::Precision::BOOL:
     case InferenceEngine::Precision::MIXED:
     case InferenceEngine::Precision::CUSTOM:
     default: {
@@ -62,6 +67,98 @@ Status serializeBlobToTensorProto(
         return status;
     }
     }
+    return StatusCode::OK;
+}
+
+template <typename T>
+InferenceEngine::Blob::Ptr makeResponseBackedBlob(tensorflow::TensorProto& responseOutput, const std::shared_ptr<TensorInfo>& networkOutput) {
+    return InferenceEngine::make_shared_blob<T>(
+        networkOutput->getTensorDesc(),
+        reinterpret_cast<T*>(responseOutput.mutable_tensor_content()->data()));
+}
+
+InferenceEngine::Blob::Ptr makeResponseBackedBlob(tensorflow::TensorProto& responseOutput, const std::shared_ptr<TensorInfo>& networkOutput) {
+    switch (networkOutput->getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        return makeResponseBackedBlob<float>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::I32:
+        return makeResponseBackedBlob<int32_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::I16:
+        return makeResponseBackedBlob<int16_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::U8:
+        return makeResponseBackedBlob<uint8_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::I8:
+        return makeResponseBackedBlob<int8_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::U16:
+        return makeResponseBackedBlob<uint16_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::FP16:
+        return makeResponseBackedBlob<int16_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::I64:
+        return makeResponseBackedBlob<int64_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::U64:
+        return makeResponseBackedBlob<uint64_t>(responseOutput, networkOutput);
+    case InferenceEngine::Precision::BOOL:
+        return makeResponseBackedBlob<uint8_t>(responseOutput, networkOutput);
+    default:
+        return nullptr;
+    }
+}
+
+}  // namespace
+
+ResponseBackedOutputBlobs::ResponseBackedOutputBlobs(InferenceEngine::InferRequest& inferRequest,
+    const tensor_map_t& outputMap,
+    tensorflow::serving::PredictResponse* response) :
+    inferRequest(inferRequest) {
+    for (const auto& pair : outputMap) {
+        auto& networkOutput = pair.second;
+        auto& responseOutput = (*response->mutable_outputs())[networkOutput->getMappedName()];
+        responseOutput.Clear();
+        if (!setTensorProtoDataType(responseOutput, networkOutput).ok()) {
+            continue;
+        }
+        size_t byteSize = networkOutput->getPrecision().size();
+        for (auto dim : networkOutput->getShape()) {
+            responseOutput.mutable_tensor_shape()->add_dim()->set_size(dim);
+            byteSize *= dim;
+        }
+        responseOutput.mutable_tensor_content()->resize(byteSize);
+        auto blob = makeResponseBackedBlob(responseOutput, networkOutput);
+        if (blob == nullptr) {
+            responseOutput.Clear();
+            continue;
+        }
+        try {
+            auto originalBlob = inferRequest.GetBlob(networkOutput->getName());
+            inferRequest.SetBlob(networkOutput->getName(), blob);
+            originalBlobs.emplace(networkOutput->getName(), originalBlob);
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            // plugin does not accept user output blobs, output will be copied during serialization
+            SPDLOG_DEBUG("Cannot set response backed output blob {}: {}", networkOutput->getName(), e.what());
+            responseOutput.Clear();
+        }
+    }
+}
+
+ResponseBackedOutputBlobs::~ResponseBackedOutputBlobs() {
+    for (const auto& [name, blob] : originalBlobs) {
+        try {
+            inferRequest.SetBlob(name, blob);
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            SPDLOG_ERROR("Failed to restore output blob {}: {}", name, e.what());
+        }
+    }
+}
+
+Status serializeBlobToTensorProto(
+    tensorflow::TensorProto& responseOutput,
+    const std::shared_ptr<TensorInfo>& networkOutput,
+    InferenceEngine::Blob::Ptr blob) {
+    responseOutput.Clear();
+    auto status = setTensorProtoDataType(responseOutput, networkOutput);
+    if (!status.ok()) {
+        return status;
+    }
     responseOutput.mutable_tensor_shape()->Clear();
     for (auto dim : networkOutput->getShape()) {
         responseOutput.mutable_tensor_shape()->add_dim()->set_size(dim);
@@ -70,13 +167,44 @@ Status serializeBlobToTensorProto(
     return StatusCode::OK;
 }
 
+Status serializeBlobBatchSliceToTensorProto(
+    tensorflow::TensorProto& responseOutput,
+    const std::shared_ptr<TensorInfo>& networkOutput,
+    InferenceEngine::Blob::Ptr blob,
+    size_t batchIndex) {
+    responseOutput.Clear();
+    auto& shape = networkOutput->getShape();
+    if (shape.size() == 0 || shape[0] <= batchIndex) {
+        Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+        SPDLOG_ERROR("{}: batch index {} out of range for output {}", status.string(), batchIndex, networkOutput->getName());
+        return status;
+    }
+    auto status = setTensorProtoDataType(responseOutput, networkOutput);
+    if (!status.ok()) {
+        return status;
+    }
+    responseOutput.mutable_tensor_shape()->Clear();
+    responseOutput.mutable_tensor_shape()->add_dim()->set_size(1);
+    for (size_t i = 1; i < shape.size(); i++) {
+        responseOutput.mutable_tensor_shape()->add_dim()->set_size(shape[i]);
+    }
+    const size_t sliceByteSize = blob->byteSize() / shape[0];
+    responseOutput.mutable_tensor_content()->assign((char*)blob->buffer() + batchIndex * sliceByteSize, sliceByteSize);
+    return StatusCode::OK;
+}
+
 Status serializePredictResponse(
     InferenceEngine::InferRequest& inferRequest,
     const tensor_map_t& outputMap,
-    tensorflow::serving::PredictResponse* response) {
+    tensorflow::serving::PredictResponse* response,
+    const ResponseBackedOutputBlobs* responseBackedOutputs) {
 
     for (const auto& pair : outputMap) {
         auto networkOutput = pair.second;
+        if (responseBackedOutputs != nullptr && responseBackedOutputs->contains(networkOutput->getName())) {
+            // inference has already written results into response
+            continue;
+        }
         InferenceEngine::Blob::Ptr blob;
         try {
             blob = inferRequest.GetBlob(networkOutput->getName());
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include <inference_engine.hpp>
 #include <spdlog/spdlog.h>
@@ -34,9 +35,43 @@ Status serializeBlobToTensorProto(
     const std::shared_ptr<TensorInfo>& networkOutput,
     InferenceEngine::Blob::Ptr blob);
 
+/**
+ * @brief Serializes a single batch element of a blob with batch dimension at position 0
+ */
+Status serializeBlobBatchSliceToTensorProto(
+    tensorflow::TensorProto& responseOutput,
+    const std::shared_ptr<TensorInfo>& networkOutput,
+    InferenceEngine::Blob::Ptr blob,
+    size_t batchIndex);
+
+/**
+ * @brief Points output blobs of infer request to tensor_content of response outputs, so inference writes results
+ * directly into the response instead of copying them during serialization.
+ *
+ * Only precisions with the same memory layout in blob and tensor_content are handled, remaining outputs are
+ * serialized regularly. Original output blobs are restored on destruction, which must happen before infer request
+ * is returned to the queue.
+ */
+class ResponseBackedOutputBlobs {
+public:
+    ResponseBackedOutputBlobs(InferenceEngine::InferRequest& inferRequest,
+        const tensor_map_t& outputMap,
+        tensorflow::serving::PredictResponse* response);
+    ~ResponseBackedOutputBlobs();
+
+    bool contains(const std::string& outputName) const {
+        return originalBlobs.count(outputName) > 0;
+    }
+
+private:
+    InferenceEngine::InferRequest& inferRequest;
+    std::unordered_map<std::string, InferenceEngine::Blob::Ptr> originalBlobs;
+};
+
 Status serializePredictResponse(
     InferenceEngine::InferRequest& inferRequest,
     const tensor_map_t& outputMap,
-    tensorflow::serving::PredictResponse* response);
+    tensorflow::serving::PredictResponse* response,
+    const ResponseBackedOutputBlobs* responseBackedOutputs = nullptr);
 
 }  // namespace ovms
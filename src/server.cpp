@@ -13,18 +13,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <grpcpp/health_check_service_interface.h>
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
 #include <netinet/in.h>
 #include <signal.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/spdlog.h>
@@ -33,12 +37,31 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "async_prediction_service.hpp"
+#include "azurestorage.hpp"
+#include "batchjobs.hpp"
+#include "cloudfilecache.hpp"
+#include "compiled_network_cache.hpp"
+#include "compression.hpp"
 #include "config.hpp"
+#include "cpustreamsbudget.hpp"
 #include "http_server.hpp"
+#include "isolationgroups.hpp"
+#include "kserve_service.hpp"
 #include "model_service.hpp"
 #include "modelmanager.hpp"
+#include "ondemandmodels.hpp"
+#include "peerrouting.hpp"
+#include "pipeline_tracer.hpp"
 #include "prediction_service.hpp"
+#include "requestlogging.hpp"
+#include "serversnapshot.hpp"
+#include "sharedmemory.hpp"
+#include "sharednetworks.hpp"
+#include "streaming_prediction_service.hpp"
 #include "stringutils.hpp"
+#include "tenantscheduling.hpp"
+#include "tensorbufferpool.hpp"
 
 using grpc::Server;
 using grpc::ServerBuilder;
@@ -49,7 +72,7 @@ namespace {
 volatile sig_atomic_t shutdown_request = 0;
 }
 
-uint getGRPCServersCount() {
+uint getGRPCCompletionQueuesCount() {
     const char* environmentVariableBuffer = std::getenv("GRPC_SERVERS");
     if (environmentVariableBuffer) {
         auto result = stou32(environmentVariableBuffer);
@@ -103,13 +126,24 @@ Status parseGrpcChannelArgs(const std::string& channel_arguments_str, std::vecto
     return StatusCode::OK;
 }
 
-void configure_logger(const std::string log_level, const std::string log_path) {
+void configure_logger(const std::string log_level, const std::string log_path, uint log_queue_size) {
     std::vector<spdlog::sink_ptr> sinks;
     sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_st>());
     if (!log_path.empty()) {
         sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_path));
     }
-    auto serving_logger = std::make_shared<spdlog::logger>("serving", begin(sinks), end(sinks));
+    std::shared_ptr<spdlog::logger> serving_logger;
+    if (log_queue_size > 0) {
+        // sinks are written by a single background thread, when the queue is full oldest messages are dropped
+        // so that logging threads never wait for output
+        spdlog::init_thread_pool(log_queue_size, 1);
+        serving_logger = std::make_shared<spdlog::async_logger>("serving", begin(sinks), end(sinks),
+            spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+        // flush queued messages before static objects are destroyed
+        std::atexit([]() { spdlog::shutdown(); });
+    } else {
+        serving_logger = std::make_shared<spdlog::logger>("serving", begin(sinks), end(sinks));
+    }
     serving_logger->set_level(spdlog::level::info);
     if (!log_level.empty()) {
         if (log_level == "DEBUG") {
@@ -140,10 +174,31 @@ void logConfig(Config& config) {
     spdlog::debug("gRPC port: {}", config.port());
     spdlog::debug("REST port: {}", config.restPort());
     spdlog::debug("REST workers: {}", config.restWorkers());
+    spdlog::debug("REST inline dispatch: {}", config.restInlineDispatch());
+    spdlog::debug("REST keep alive timeout: {}", config.restKeepAliveTimeoutSeconds());
     spdlog::debug("gRPC workers: {}", config.grpcWorkers());
+    spdlog::debug("gRPC polling threads: {}", config.grpcPollingThreads());
+    spdlog::debug("gRPC NUMA pinning: {}", config.grpcNumaPinning());
+    spdlog::debug("gRPC async: {}", config.grpcAsync());
+    spdlog::debug("gRPC stream max in flight: {}", config.grpcStreamMaxInFlight());
     spdlog::debug("gRPC channel arguments: {}", config.grpcChannelArguments());
     spdlog::debug("log level: {}", config.logLevel());
     spdlog::debug("log path: {}", config.logPath());
+    spdlog::debug("log queue size: {}", config.logQueueSize());
+    spdlog::debug("log request sampling: {}", config.logRequestSampling());
+    spdlog::debug("compiled model cache dir: {}", config.compiledModelCacheDir());
+    spdlog::debug("server snapshot path: {}", config.serverSnapshotPath());
+    spdlog::debug("batch jobs output path: {}", config.batchJobsOutputPath());
+    spdlog::debug("on demand models memory budget: {} MB", config.onDemandModelsMemoryBudgetMb());
+    spdlog::debug("CPU streams budget: {}", config.cpuStreamsBudget());
+    spdlog::debug("tensor buffer pool size: {} MB", config.tensorBufferPoolSizeMb());
+    spdlog::debug("isolation groups: {}", config.isolationGroups());
+    spdlog::debug("peers: {}", config.peers());
+    spdlog::debug("peer poll interval: {} ms", config.peerPollIntervalMs());
+    spdlog::debug("drain timeout: {} s", config.drainTimeoutSeconds());
+    spdlog::debug("pipeline trace path: {}", config.pipelineTracePath());
+    spdlog::debug("pipeline trace sampling rate: {}", config.pipelineTraceSamplingRate());
+    spdlog::debug("enable profiling: {}", config.enableProfiling());
 }
 
 void onInterrupt(int status) {
@@ -151,7 +206,7 @@ void onInterrupt(int status) {
 }
 
 void onTerminate(int status) {
-    shutdown_request = 1;
+    shutdown_request = 3;
 }
 
 void onIllegal(int status) {
@@ -178,9 +233,14 @@ void installSignalHandlers() {
     sigaction(SIGILL, &sigIllHandler, NULL);
 }
 
-std::vector<std::unique_ptr<Server>> startGRPCServer(
+std::unique_ptr<Server> startGRPCServer(
     PredictionServiceImpl& predict_service,
-    ModelServiceImpl& model_service) {
+    AsyncPredictionServiceImpl& async_predict_service,
+    StreamingPredictionServiceImpl& streaming_predict_service,
+    ModelServiceImpl& model_service,
+    PeerServiceImpl& peer_service,
+    KServeInferenceServiceImpl& kserve_service,
+    std::unique_ptr<AsyncPredictServer>& async_predict_server) {
     const int GIGABYTE = 1024 * 1024 * 1024;
 
     std::vector<GrpcChannelArgument> channel_arguments;
@@ -199,12 +259,25 @@ std::vector<std::unique_ptr<Server>> startGRPCServer(
         exit(1);
     }
 
+    // standard grpc.health.v1.Health service, servers are started after models from config are loaded
+    grpc::EnableDefaultHealthCheckService(true);
     ServerBuilder builder;
     builder.SetMaxReceiveMessageSize(GIGABYTE);
     builder.SetMaxSendMessageSize(GIGABYTE);
     builder.AddListeningPort("0.0.0.0:" + std::to_string(config.port()), grpc::InsecureServerCredentials());
-    builder.RegisterService(&predict_service);
+    if (!config.grpcUdsPath().empty()) {
+        // co-located clients skip TCP stack, existing socket file is replaced
+        builder.AddListeningPort("unix:" + config.grpcUdsPath(), grpc::InsecureServerCredentials());
+    }
+    if (config.grpcAsync()) {
+        builder.RegisterService(&async_predict_service);
+    } else {
+        builder.RegisterService(&predict_service);
+    }
+    builder.RegisterService(&streaming_predict_service);
     builder.RegisterService(&model_service);
+    builder.RegisterService(&peer_service);
+    builder.RegisterService(&kserve_service);
     for (const GrpcChannelArgument& channel_argument : channel_arguments) {
         // gRPC accept arguments of two types, int and string. We will attempt to
         // parse each arg as int and pass it on as such if successful. Otherwise we
@@ -220,24 +293,37 @@ std::vector<std::unique_ptr<Server>> startGRPCServer(
         }
     }
 
-    std::vector<std::unique_ptr<Server>> servers;
-    uint grpcServersCount = getGRPCServersCount();
-    servers.reserve(grpcServersCount);
-    spdlog::debug("Starting grpc servers: {}", grpcServersCount);
+    // single server, concurrency comes from completion queues instead of server instances sharing the port
+    const uint completionQueuesCount = getGRPCCompletionQueuesCount();
+    const uint pollingThreads = config.grpcPollingThreads();
+    spdlog::debug("Starting grpc server with completion queues: {}", completionQueuesCount);
 
     if (!isPortAvailable(config.port())) {
         throw std::runtime_error("Failed to start GRPC server at " + std::to_string(config.port()));
     }
-    for (uint i = 0; i < grpcServersCount; ++i) {
-        std::unique_ptr<Server> server = builder.BuildAndStart();
-        if (server == nullptr) {
-            throw std::runtime_error("Failed to start GRPC server at " + std::to_string(config.port()));
+    if (config.grpcAsync()) {
+        async_predict_server = std::make_unique<AsyncPredictServer>(async_predict_service, completionQueuesCount,
+            std::max<uint>(1, std::thread::hardware_concurrency()), std::max<uint>(1, std::thread::hardware_concurrency()),
+            pollingThreads, config.grpcNumaPinning());
+        async_predict_server->registerCompletionQueues(builder);
+    } else {
+        builder.SetSyncServerOption(ServerBuilder::SyncServerOption::NUM_CQS, completionQueuesCount);
+        if (pollingThreads > 0) {
+            builder.SetSyncServerOption(ServerBuilder::SyncServerOption::MIN_POLLERS, pollingThreads);
+            builder.SetSyncServerOption(ServerBuilder::SyncServerOption::MAX_POLLERS, pollingThreads);
         }
-        servers.push_back(std::move(server));
     }
+    std::unique_ptr<Server> server = builder.BuildAndStart();
+    if (server == nullptr) {
+        throw std::runtime_error("Failed to start GRPC server at " + std::to_string(config.port()));
+    }
+    if (async_predict_server != nullptr) {
+        async_predict_server->start();
+    }
+    server->GetHealthCheckService()->SetServingStatus(true);
     spdlog::info("Server started on port {}", config.port());
 
-    return servers;
+    return server;
 }
 
 std::unique_ptr<ovms::http_server> startRESTServer() {
@@ -250,7 +336,10 @@ std::unique_ptr<ovms::http_server> startRESTServer() {
         int workers = config.restWorkers() ? config.restWorkers() : 10;
         spdlog::info("Will start {} REST workers", workers);
 
-        std::unique_ptr<ovms::http_server> restServer = ovms::createAndStartHttpServer(config.restPort(), workers, REST_TIMEOUT);
+        // validated together with other parameters
+        auto inlineDispatch = ovms::parseRestInlineDispatch(config.restInlineDispatch()).value_or(ovms::RestInlineDispatch::NONE);
+        std::unique_ptr<ovms::http_server> restServer = ovms::createAndStartHttpServer(config.restPort(), workers, REST_TIMEOUT, config.enableProfiling(),
+            inlineDispatch, config.restKeepAliveTimeoutSeconds());
         if (restServer != nullptr) {
             spdlog::info("Started REST server at {}", server_address);
         } else {
@@ -263,17 +352,80 @@ std::unique_ptr<ovms::http_server> startRESTServer() {
     return nullptr;
 }
 
+void waitForInFlightRequests(ModelManager& manager, std::chrono::system_clock::time_point deadline) {
+    uint64_t inFlight = manager.getInFlightRequestsCount();
+    while (inFlight > 0 && std::chrono::system_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        inFlight = manager.getInFlightRequestsCount();
+    }
+    if (inFlight > 0) {
+        spdlog::warn("Drain timeout expired with {} requests in progress", inFlight);
+    } else {
+        spdlog::info("All requests in progress finished");
+    }
+}
+
 int server_main(int argc, char** argv) {
     installSignalHandlers();
     try {
         auto& config = ovms::Config::instance().parse(argc, argv);
-        configure_logger(config.logLevel(), config.logPath());
+        configure_logger(config.logLevel(), config.logPath(), config.logQueueSize());
+        RequestLogSampler::setPeriod(config.logRequestSampling());
+        ResponseCompression::setThreshold(config.compressionThresholdBytes());
+        auto status = PipelineTracer::getInstance().configure(config.pipelineTracePath(), config.pipelineTraceSamplingRate());
+        if (!status.ok()) {
+            spdlog::error("Pipeline tracing configuration failed: {}", status.string());
+            return EXIT_FAILURE;
+        }
+        status = CompiledNetworkCache::getInstance().configure(config.compiledModelCacheDir());
+        if (!status.ok()) {
+            spdlog::error("Compiled model cache configuration failed: {}", status.string());
+            return EXIT_FAILURE;
+        }
+        ServerSnapshot::getInstance().configure(config.serverSnapshotPath());
+        SharedNetworks::getInstance().setEnabled(config.shareIdenticalModels());
+        SharedMemoryRegistry::getInstance().setEnabled(config.allowSharedMemory());
+        status = CloudFileCache::getInstance().configure(config.cloudModelCacheDir(), config.cloudModelCacheSizeMb() * 1024 * 1024);
+        if (!status.ok()) {
+            spdlog::error("Cloud model files cache configuration failed: {}", status.string());
+            return EXIT_FAILURE;
+        }
+        AzureStorageBlob::setDownloadOptions(config.azureDownloadParallelism(), uint64_t(config.azureDownloadChunkSizeMb()) * 1024 * 1024);
+        OnDemandModels::getInstance().setMemoryBudget(config.onDemandModelsMemoryBudgetMb() * 1024 * 1024);
+        CpuStreamsBudget::getInstance().configure(config.cpuStreamsBudget(), std::thread::hardware_concurrency());
+        TensorBufferPool::getInstance().setMaxPooledBytes(config.tensorBufferPoolSizeMb() * 1024 * 1024);
+        status = Tenants::getInstance().configure(config.tenantLimits());
+        if (!status.ok()) {
+            spdlog::error("Tenant limits configuration failed: {}", status.string());
+            return EXIT_FAILURE;
+        }
+        status = IsolationGroups::getInstance().configure(config.isolationGroups());
+        if (!status.ok()) {
+            spdlog::error("Isolation groups configuration failed: {}", status.string());
+            return EXIT_FAILURE;
+        }
+        status = BatchJobs::getInstance().configure(config.batchJobsOutputPath());
+        if (!status.ok()) {
+            spdlog::error("Batch jobs configuration failed: {}", status.string());
+            return EXIT_FAILURE;
+        }
+        status = PeerRouter::getInstance().configure(config.peers(), std::chrono::milliseconds(config.peerPollIntervalMs()));
+        if (!status.ok()) {
+            spdlog::error("Peers configuration failed: {}", status.string());
+            return EXIT_FAILURE;
+        }
 
         PredictionServiceImpl predict_service;
+        AsyncPredictionServiceImpl async_predict_service;
+        StreamingPredictionServiceImpl streaming_predict_service(ModelManager::getInstance(), config.grpcStreamMaxInFlight());
         ModelServiceImpl model_service;
+        PeerServiceImpl peer_service(ModelManager::getInstance());
+        KServeInferenceServiceImpl kserve_service(ModelManager::getInstance(), predict_service);
+        std::unique_ptr<AsyncPredictServer> async_predict_server;
 
-        auto grpc = startGRPCServer(predict_service, model_service);
+        // REST server is started first, so its readiness endpoint reports progress of loading models
         auto rest = startRESTServer();
+        auto grpc = startGRPCServer(predict_service, async_predict_service, streaming_predict_service, model_service, peer_service, kserve_service, async_predict_server);
 
         while (!shutdown_request) {
             std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -282,14 +434,35 @@ int server_main(int argc, char** argv) {
             spdlog::error("Illegal operation. OVMS started on unsupported device");
         }
         spdlog::info("Shutting down");
-        for (const auto& g : grpc) {
-            g->Shutdown();
+        const bool drain = shutdown_request == 3 && config.drainTimeoutSeconds() > 0;
+        const auto drainDeadline = std::chrono::system_clock::now() + std::chrono::seconds(config.drainTimeoutSeconds());
+        if (drain) {
+            spdlog::info("Draining requests in progress for up to {} seconds", config.drainTimeoutSeconds());
+            ModelManager::getInstance().markDraining();
+        }
+        grpc->GetHealthCheckService()->SetServingStatus(false);
+        if (drain) {
+            // new calls are rejected, calls in progress are cancelled at deadline
+            grpc->Shutdown(drainDeadline);
+        } else {
+            grpc->Shutdown();
+        }
+        if (async_predict_server != nullptr) {
+            async_predict_server->shutdown();
+        }
+        if (drain) {
+            // REST server replies only until terminated, so it is terminated after its requests finish
+            waitForInFlightRequests(ModelManager::getInstance(), drainDeadline);
         }
 
         if (rest != nullptr) {
             rest->Terminate();
         }
 
+        PeerRouter::getInstance().join();
+        BatchJobs::getInstance().join();
+        // saved while models are still loaded
+        ServerSnapshot::getInstance().save(ModelManager::getInstance());
         ModelManager::getInstance().join();
     } catch (std::exception& e) {
         SPDLOG_ERROR("Exception catch: {} - will now terminate.", e.what());
@@ -0,0 +1,352 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "serversnapshot.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <spdlog/spdlog.h>
+
+#include "modelinstance.hpp"
+#include "modelmanager.hpp"
+
+namespace ovms {
+
+namespace {
+
+bool readFileStamp(const std::string& filePath, uintmax_t& size, int64_t& modificationTime) {
+    std::error_code ec;
+    size = std::filesystem::file_size(filePath, ec);
+    if (ec) {
+        return false;
+    }
+    auto time = std::filesystem::last_write_time(filePath, ec);
+    if (ec) {
+        return false;
+    }
+    modificationTime = time.time_since_epoch().count();
+    return true;
+}
+
+std::string tuningResultKey(const std::string& name, model_version_t version, const std::string& description) {
+    return name + ";" + std::to_string(version) + ";" + description;
+}
+
+}  // namespace
+
+Status ServerSnapshot::configure(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->path = path;
+    restoredModels.clear();
+    savedModels.clear();
+    modelsRestored = false;
+    fileHashes.clear();
+    tuningResults.clear();
+    if (path.empty()) {
+        return StatusCode::OK;
+    }
+    auto status = restore();
+    if (!status.ok()) {
+        spdlog::warn("Server snapshot: {} not restored: {}", path, status.string());
+        restoredModels.clear();
+        fileHashes.clear();
+        tuningResults.clear();
+    }
+    return StatusCode::OK;
+}
+
+Status ServerSnapshot::restore() {
+    if (!std::filesystem::exists(path)) {
+        spdlog::info("Server snapshot: {} does not exist yet, it is saved on shutdown", path);
+        return StatusCode::OK;
+    }
+    std::ifstream file(path);
+    if (!file.good()) {
+        return StatusCode::FILE_INVALID;
+    }
+    rapidjson::IStreamWrapper stream(file);
+    rapidjson::Document document;
+    if (document.ParseStream(stream).HasParseError() || !document.IsObject()) {
+        return StatusCode::JSON_INVALID;
+    }
+    const auto modelsIt = document.FindMember("models");
+    if (modelsIt != document.MemberEnd()) {
+        if (!modelsIt->value.IsObject()) {
+            return StatusCode::JSON_INVALID;
+        }
+        for (const auto& model : modelsIt->value.GetObject()) {
+            if (!model.value.IsObject()) {
+                return StatusCode::JSON_INVALID;
+            }
+            const auto basePathIt = model.value.FindMember("base_path");
+            const auto versionsIt = model.value.FindMember("versions");
+            if (basePathIt == model.value.MemberEnd() || !basePathIt->value.IsString() ||
+                versionsIt == model.value.MemberEnd() || !versionsIt->value.IsArray()) {
+                return StatusCode::JSON_INVALID;
+            }
+            ModelVersions entry{basePathIt->value.GetString(), {}};
+            for (const auto& version : versionsIt->value.GetArray()) {
+                if (!version.IsInt64() || version.GetInt64() <= 0) {
+                    return StatusCode::JSON_INVALID;
+                }
+                entry.versions.push_back(version.GetInt64());
+            }
+            restoredModels.emplace(model.name.GetString(), std::move(entry));
+        }
+    }
+    const auto hashesIt = document.FindMember("file_hashes");
+    if (hashesIt != document.MemberEnd()) {
+        if (!hashesIt->value.IsArray()) {
+            return StatusCode::JSON_INVALID;
+        }
+        for (const auto& entry : hashesIt->value.GetArray()) {
+            if (!entry.IsObject() || !entry.HasMember("path") || !entry["path"].IsString() ||
+                !entry.HasMember("seed") || !entry["seed"].IsUint64() ||
+                !entry.HasMember("size") || !entry["size"].IsUint64() ||
+                !entry.HasMember("modification_time") || !entry["modification_time"].IsInt64() ||
+                !entry.HasMember("hash") || !entry["hash"].IsUint64()) {
+                return StatusCode::JSON_INVALID;
+            }
+            FileHash fileHash;
+            fileHash.size = entry["size"].GetUint64();
+            fileHash.modificationTime = entry["modification_time"].GetInt64();
+            fileHash.hash = entry["hash"].GetUint64();
+            fileHashes[{entry["path"].GetString(), entry["seed"].GetUint64()}] = fileHash;
+        }
+    }
+    const auto tuningIt = document.FindMember("tuning_results");
+    if (tuningIt != document.MemberEnd()) {
+        if (!tuningIt->value.IsArray()) {
+            return StatusCode::JSON_INVALID;
+        }
+        for (const auto& entry : tuningIt->value.GetArray()) {
+            if (!entry.IsObject() || !entry.HasMember("model") || !entry["model"].IsString() ||
+                !entry.HasMember("version") || !entry["version"].IsInt64() ||
+                !entry.HasMember("description") || !entry["description"].IsString() ||
+                !entry.HasMember("streams") || !entry["streams"].IsUint() ||
+                !entry.HasMember("nireq") || !entry["nireq"].IsUint()) {
+                return StatusCode::JSON_INVALID;
+            }
+            TuningResult result;
+            result.name = entry["model"].GetString();
+            result.version = entry["version"].GetInt64();
+            result.description = entry["description"].GetString();
+            result.candidate = TuningCandidate{entry["streams"].GetUint(), entry["nireq"].GetUint()};
+            if (result.candidate.streams == 0 || result.candidate.nireq == 0) {
+                return StatusCode::JSON_INVALID;
+            }
+            tuningResults[tuningResultKey(result.name, result.version, result.description)] = std::move(result);
+        }
+    }
+    spdlog::info("Restored server snapshot: {}; models: {}; file hashes: {}; tuning results: {}",
+        path, restoredModels.size(), fileHashes.size(), tuningResults.size());
+    return StatusCode::OK;
+}
+
+bool ServerSnapshot::takeModelVersions(const std::string& name, const std::string& basePath, model_versions_t& versions) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = restoredModels.find(name);
+    if (it == restoredModels.end()) {
+        return false;
+    }
+    const bool matches = it->second.basePath == basePath;
+    if (matches) {
+        versions = it->second.versions;
+        modelsRestored = true;
+        spdlog::info("Loading model: {} versions restored from server snapshot, storage is verified by config watcher", name);
+    }
+    restoredModels.erase(it);
+    return matches;
+}
+
+bool ServerSnapshot::hasRestoredModels() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return modelsRestored;
+}
+
+std::optional<uint64_t> ServerSnapshot::findFileHash(const std::string& filePath, uint64_t seed) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!isEnabled()) {
+        return std::nullopt;
+    }
+    auto it = fileHashes.find({filePath, seed});
+    if (it == fileHashes.end()) {
+        return std::nullopt;
+    }
+    uintmax_t size;
+    int64_t modificationTime;
+    if (!readFileStamp(filePath, size, modificationTime) ||
+        size != it->second.size || modificationTime != it->second.modificationTime) {
+        fileHashes.erase(it);
+        return std::nullopt;
+    }
+    it->second.used = true;
+    return it->second.hash;
+}
+
+void ServerSnapshot::recordFileHash(const std::string& filePath, uint64_t seed, uint64_t hash) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!isEnabled()) {
+        return;
+    }
+    FileHash fileHash;
+    if (!readFileStamp(filePath, fileHash.size, fileHash.modificationTime)) {
+        return;
+    }
+    fileHash.hash = hash;
+    fileHash.used = true;
+    fileHashes[{filePath, seed}] = fileHash;
+}
+
+std::optional<TuningCandidate> ServerSnapshot::findTuningResult(const std::string& name, model_version_t version, const std::string& description) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = tuningResults.find(tuningResultKey(name, version, description));
+    if (it == tuningResults.end()) {
+        return std::nullopt;
+    }
+    it->second.used = true;
+    return it->second.candidate;
+}
+
+void ServerSnapshot::recordTuningResult(const std::string& name, model_version_t version, const std::string& description, const TuningCandidate& candidate) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!isEnabled()) {
+        return;
+    }
+    tuningResults[tuningResultKey(name, version, description)] = TuningResult{name, version, description, candidate, true};
+}
+
+void ServerSnapshot::recordModelVersions(const std::string& name, const std::string& basePath, const model_versions_t& versions) {
+    std::lock_guard<std::mutex> lock(mutex);
+    savedModels[name] = ModelVersions{basePath, versions};
+}
+
+Status ServerSnapshot::save(ModelManager& manager) {
+    if (!isEnabled()) {
+        return StatusCode::OK;
+    }
+    for (const auto& [name, model] : manager.getModelsSnapshot()) {
+        std::string basePath;
+        model_versions_t versions;
+        for (const auto& [version, instance] : model->getModelVersionsMapCopy()) {
+            if (instance->getStatus().getState() != ModelVersionState::AVAILABLE) {
+                continue;
+            }
+            basePath = instance->getModelConfig().getBasePath();
+            versions.push_back(version);
+        }
+        // listing local model repository is cheap and always current
+        if (!versions.empty() && isCloudPath(basePath)) {
+            recordModelVersions(name, basePath, versions);
+        }
+    }
+    return save();
+}
+
+Status ServerSnapshot::save() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!isEnabled()) {
+        return StatusCode::OK;
+    }
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("models");
+    writer.StartObject();
+    for (const auto& [name, model] : savedModels) {
+        writer.Key(name.c_str());
+        writer.StartObject();
+        writer.Key("base_path");
+        writer.String(model.basePath.c_str());
+        writer.Key("versions");
+        writer.StartArray();
+        for (const auto version : model.versions) {
+            writer.Int64(version);
+        }
+        writer.EndArray();
+        writer.EndObject();
+    }
+    writer.EndObject();
+    writer.Key("file_hashes");
+    writer.StartArray();
+    for (const auto& [key, fileHash] : fileHashes) {
+        if (!fileHash.used) {
+            continue;
+        }
+        writer.StartObject();
+        writer.Key("path");
+        writer.String(key.first.c_str());
+        writer.Key("seed");
+        writer.Uint64(key.second);
+        writer.Key("size");
+        writer.Uint64(fileHash.size);
+        writer.Key("modification_time");
+        writer.Int64(fileHash.modificationTime);
+        writer.Key("hash");
+        writer.Uint64(fileHash.hash);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.Key("tuning_results");
+    writer.StartArray();
+    for (const auto& [key, result] : tuningResults) {
+        if (!result.used) {
+            continue;
+        }
+        writer.StartObject();
+        writer.Key("model");
+        writer.String(result.name.c_str());
+        writer.Key("version");
+        writer.Int64(result.version);
+        writer.Key("description");
+        writer.String(result.description.c_str());
+        writer.Key("streams");
+        writer.Uint(result.candidate.streams);
+        writer.Key("nireq");
+        writer.Uint(result.candidate.nireq);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    // written aside and renamed, so interrupted shutdown never leaves partial snapshot
+    auto temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        file << buffer.GetString();
+        if (!file.good()) {
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+            spdlog::error("Could not write server snapshot: {}", temporaryPath);
+            return StatusCode::FILE_INVALID;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporaryPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporaryPath, ec);
+        spdlog::error("Could not save server snapshot: {}; error: {}", path, ec.message());
+        return StatusCode::FILE_INVALID;
+    }
+    spdlog::info("Saved server snapshot: {}; models: {}", path, savedModels.size());
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
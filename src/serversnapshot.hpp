@@ -0,0 +1,133 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "autotuning.hpp"
+#include "model_version_policy.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+class ModelManager;
+
+/**
+ * @brief State of the server saved on shutdown and restored on the next start, so restart skips work done before
+ *
+ * Snapshot keeps versions of cloud models that were loaded, hashes of model files with their size and modification
+ * time, and auto-tuning results of models which version directories are not persistent. Restored versions of cloud
+ * models are loaded without listing the storage and are verified by the first check of the config watcher.
+ * Snapshot is disabled until path is configured.
+ */
+class ServerSnapshot {
+public:
+    static ServerSnapshot& getInstance() {
+        static ServerSnapshot instance;
+        return instance;
+    }
+
+    /**
+     * @brief Sets path of the snapshot and restores state saved there, empty path disables the snapshot
+     *
+     * Missing or unreadable snapshot is not an error, server starts without restored state.
+     */
+    Status configure(const std::string& path);
+
+    bool isEnabled() const { return !path.empty(); }
+
+    /**
+     * @brief Takes versions of the model restored from the snapshot if it was loaded from the same base path
+     *
+     * Versions are given once, later reloads of the model list the storage.
+     */
+    bool takeModelVersions(const std::string& name, const std::string& basePath, model_versions_t& versions);
+
+    /**
+     * @brief Tells if any of the models was loaded with versions restored from the snapshot
+     */
+    bool hasRestoredModels() const;
+
+    /**
+     * @brief Finds hash of file continued from given seed, if file size and modification time did not change
+     */
+    std::optional<uint64_t> findFileHash(const std::string& filePath, uint64_t seed);
+
+    void recordFileHash(const std::string& filePath, uint64_t seed, uint64_t hash);
+
+    /**
+     * @brief Finds auto-tuning result of model version tuned as described
+     */
+    std::optional<TuningCandidate> findTuningResult(const std::string& name, model_version_t version, const std::string& description);
+
+    void recordTuningResult(const std::string& name, model_version_t version, const std::string& description, const TuningCandidate& candidate);
+
+    void recordModelVersions(const std::string& name, const std::string& basePath, const model_versions_t& versions);
+
+    /**
+     * @brief Records versions of cloud models available in manager and writes the snapshot
+     */
+    Status save(ModelManager& manager);
+
+    /**
+     * @brief Writes recorded state to the snapshot
+     *
+     * Only file hashes and tuning results used or computed since start are written, so entries of removed models expire.
+     */
+    Status save();
+
+private:
+    ServerSnapshot() = default;
+
+    struct FileHash {
+        uintmax_t size = 0;
+        int64_t modificationTime = 0;
+        uint64_t hash = 0;
+        bool used = false;
+    };
+
+    struct ModelVersions {
+        std::string basePath;
+        model_versions_t versions;
+    };
+
+    struct TuningResult {
+        std::string name;
+        model_version_t version = 0;
+        std::string description;
+        TuningCandidate candidate;
+        bool used = false;
+    };
+
+    Status restore();
+
+    std::string path;
+    mutable std::mutex mutex;
+    std::map<std::string, ModelVersions> restoredModels;
+    std::map<std::string, ModelVersions> savedModels;
+    bool modelsRestored = false;
+    // keyed by file path and seed the hash was continued from
+    std::map<std::pair<std::string, uint64_t>, FileHash> fileHashes;
+    // keyed by model name, version and tuning description
+    std::map<std::string, TuningResult> tuningResults;
+};
+
+}  // namespace ovms
@@ -0,0 +1,152 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "shapebuckets.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+namespace {
+
+size_t elementsCount(const shape_t& shape) {
+    return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+shape_t getTensorProtoShape(const tensorflow::TensorProto& tensor) {
+    shape_t shape;
+    for (const auto& dim : tensor.tensor_shape().dim()) {
+        shape.push_back(static_cast<size_t>(dim.size()));
+    }
+    return shape;
+}
+
+// tensor proto elements may be wider than network precision, e.g. FP16 serialized as float
+size_t getTensorContentElementSize(const tensorflow::TensorProto& tensor, const shape_t& shape) {
+    const size_t count = elementsCount(shape);
+    return count > 0 ? tensor.tensor_content().size() / count : 0;
+}
+
+/**
+ * @brief Copies row major content as outer rows of inner slices along the dimension, from length slices into newLength slices
+ */
+std::string resizeAlongDimension(const std::string& content, const shape_t& shape, size_t dimension, size_t newLength, size_t elementSize) {
+    const size_t outer = std::accumulate(shape.begin(), shape.begin() + dimension, size_t(1), std::multiplies<size_t>());
+    const size_t inner = std::accumulate(shape.begin() + dimension + 1, shape.end(), size_t(1), std::multiplies<size_t>()) * elementSize;
+    const size_t length = shape[dimension];
+    const size_t copied = std::min(length, newLength) * inner;
+    std::string resized(outer * newLength * inner, '\0');
+    for (size_t row = 0; row < outer; ++row) {
+        std::copy_n(content.data() + row * length * inner, copied, resized.begin() + row * newLength * inner);
+    }
+    return resized;
+}
+
+}  // namespace
+
+std::optional<size_t> findShapeBucket(const std::vector<size_t>& sizes, size_t length) {
+    auto it = std::lower_bound(sizes.begin(), sizes.end(), length);
+    if (it == sizes.end()) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(std::distance(sizes.begin(), it));
+}
+
+std::string padAlongDimension(const std::string& content, const shape_t& shape, size_t dimension, size_t size, size_t elementSize) {
+    return resizeAlongDimension(content, shape, dimension, std::max(size, shape[dimension]), elementSize);
+}
+
+std::string cropAlongDimension(const std::string& content, const shape_t& shape, size_t dimension, size_t length, size_t elementSize) {
+    return resizeAlongDimension(content, shape, dimension, std::min(length, shape[dimension]), elementSize);
+}
+
+bool getShapeBucketLength(const PredictRequest& request, const tensor_map_t& bucketInputs, size_t dimension, size_t& length) {
+    std::optional<size_t> found;
+    for (const auto& pair : bucketInputs) {
+        if (!isPaddedToShapeBucket(pair.second->getShape(), dimension)) {
+            continue;
+        }
+        auto it = request.inputs().find(pair.first);
+        if (it == request.inputs().end()) {
+            return false;
+        }
+        const auto& input = it->second;
+        const auto shape = getTensorProtoShape(input);
+        if (shape.size() != pair.second->getShape().size() || input.tensor_content().empty()) {
+            return false;
+        }
+        if (found && found.value() != shape[dimension]) {
+            return false;
+        }
+        found = shape[dimension];
+    }
+    if (!found) {
+        return false;
+    }
+    length = found.value();
+    return true;
+}
+
+Status padRequestToShapeBucket(const PredictRequest& request, const ShapeBucket& bucket, size_t dimension, PredictRequest& padded) {
+    padded = request;
+    for (const auto& pair : bucket.inputsInfo) {
+        if (!isPaddedToShapeBucket(pair.second->getShape(), dimension)) {
+            continue;
+        }
+        auto& input = (*padded.mutable_inputs())[pair.first];
+        const auto shape = getTensorProtoShape(input);
+        if (shape[dimension] == bucket.size) {
+            continue;
+        }
+        const size_t elementSize = getTensorContentElementSize(input, shape);
+        if (elementSize == 0 || elementSize * elementsCount(shape) != input.tensor_content().size()) {
+            return StatusCode::INVALID_CONTENT_SIZE;
+        }
+        *input.mutable_tensor_content() = padAlongDimension(input.tensor_content(), shape, dimension, bucket.size, elementSize);
+        input.mutable_tensor_shape()->mutable_dim(dimension)->set_size(bucket.size);
+    }
+    return StatusCode::OK;
+}
+
+void cropResponseToLength(PredictResponse& response, const ShapeBucket& bucket, size_t dimension, size_t length) {
+    if (length == bucket.size) {
+        return;
+    }
+    for (const auto& pair : bucket.outputsInfo) {
+        const auto& outputShape = pair.second->getShape();
+        if (!isPaddedToShapeBucket(outputShape, dimension) || outputShape[dimension] != bucket.size) {
+            continue;
+        }
+        auto it = response.mutable_outputs()->find(pair.first);
+        if (it == response.mutable_outputs()->end()) {
+            continue;
+        }
+        auto& output = it->second;
+        const auto shape = getTensorProtoShape(output);
+        const size_t elementSize = getTensorContentElementSize(output, shape);
+        if (shape.size() != outputShape.size() || elementSize == 0) {
+            continue;
+        }
+        *output.mutable_tensor_content() = cropAlongDimension(output.tensor_content(), shape, dimension, length, elementSize);
+        output.mutable_tensor_shape()->mutable_dim(dimension)->set_size(length);
+    }
+}
+
+}  // namespace ovms
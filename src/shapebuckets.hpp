@@ -0,0 +1,94 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+#include "batchingscheduler.hpp"
+#include "ovinferrequestsqueue.hpp"
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Network compiled ahead of time for inputs of one length along shape bucket dimension
+ *
+ * Requests up to that length are padded to it, so variable length requests do not reshape the model.
+ */
+struct ShapeBucket {
+    size_t size = 0;
+    std::shared_ptr<InferenceEngine::ExecutableNetwork> execNetwork;
+    std::unique_ptr<OVInferRequestsQueue> inferRequestsQueue;
+    tensor_map_t inputsInfo;
+    tensor_map_t outputsInfo;
+    // merges batch size 1 requests of this bucket, nullptr if dynamic batching is not active
+    std::unique_ptr<BatchingScheduler> batchingScheduler;
+};
+
+/**
+ * @brief Finds the smallest bucket size not lower than length
+ *
+ * @param sizes ascending bucket sizes
+ * @return index of the bucket or nullopt if length exceeds all of them
+ */
+std::optional<size_t> findShapeBucket(const std::vector<size_t>& sizes, size_t length);
+
+/**
+ * @brief Checks if tensor with the shape is padded to bucket size, tensors with no more dimensions than the bucket dimension are not
+ */
+inline bool isPaddedToShapeBucket(const shape_t& shape, size_t dimension) {
+    return shape.size() > dimension;
+}
+
+/**
+ * @brief Pads row major tensor content with zeros along the dimension
+ *
+ * @param shape shape of content, its size along the dimension is padded to size
+ */
+std::string padAlongDimension(const std::string& content, const shape_t& shape, size_t dimension, size_t size, size_t elementSize);
+
+/**
+ * @brief Keeps first length elements of row major tensor content along the dimension
+ */
+std::string cropAlongDimension(const std::string& content, const shape_t& shape, size_t dimension, size_t length, size_t elementSize);
+
+/**
+ * @brief Gets length of request inputs padded to shape bucket
+ *
+ * @return false if inputs padded to bucket differ in length, have too few dimensions or are not sent as tensor content
+ */
+bool getShapeBucketLength(const tensorflow::serving::PredictRequest& request, const tensor_map_t& bucketInputs, size_t dimension, size_t& length);
+
+/**
+ * @brief Copies request with inputs padded to bucket size along the dimension
+ */
+Status padRequestToShapeBucket(const tensorflow::serving::PredictRequest& request, const ShapeBucket& bucket, size_t dimension,
+    tensorflow::serving::PredictRequest& padded);
+
+/**
+ * @brief Crops response outputs with bucket size along the dimension back to request length
+ */
+void cropResponseToLength(tensorflow::serving::PredictResponse& response, const ShapeBucket& bucket, size_t dimension, size_t length);
+
+}  // namespace ovms
@@ -0,0 +1,39 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "shardedcounter.hpp"
+
+namespace ovms {
+
+size_t ShardedCounter::getThreadShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARDS_COUNT;
+    return shard;
+}
+
+uint64_t ShardedCounter::get() const {
+    // every counted release makes its acquisition visible, so acquisitions summed afterwards are not fewer
+    uint64_t decrements = 0;
+    for (const auto& shard : shards) {
+        decrements += shard.decrements.load(std::memory_order_acquire);
+    }
+    uint64_t increments = 0;
+    for (const auto& shard : shards) {
+        increments += shard.increments.load(std::memory_order_seq_cst);
+    }
+    return increments - decrements;
+}
+
+}  // namespace ovms
@@ -0,0 +1,59 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ovms {
+
+/**
+ * @brief Count of held references, acquired and released by many threads at high rate and read rarely
+ *
+ * Threads update separate shards, so concurrent requests do not contend on the same cache line.
+ * Acquisitions and releases are counted separately and a reference may be released by other thread than
+ * the one which acquired it. The value sums releases before acquisitions, so it does not read 0 while any
+ * reference acquired before the read is still held.
+ */
+class ShardedCounter {
+public:
+    void increment() {
+        // pairs with the read by the thread waiting for all references to be released
+        shards[getThreadShard()].increments.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    void decrement() {
+        shards[getThreadShard()].decrements.fetch_add(1, std::memory_order_release);
+    }
+
+    uint64_t get() const;
+
+    static constexpr size_t SHARDS_COUNT = 32;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> increments{0};
+        std::atomic<uint64_t> decrements{0};
+    };
+
+    static size_t getThreadShard();
+
+    std::array<Shard, SHARDS_COUNT> shards;
+};
+
+}  // namespace ovms
@@ -0,0 +1,156 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "sharedmemory.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+const char* const SHARED_MEMORY_CONTAINER = "ovms_shared_memory";
+
+namespace {
+bool isValidName(std::string_view name) {
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.';
+    });
+}
+
+bool isValidKey(const std::string& key) {
+    // single component names only, shm_open does not resolve paths
+    return key.size() > 1 && key[0] == '/' && isValidName(std::string_view(key).substr(1));
+}
+}  // namespace
+
+SharedMemoryRegion::SharedMemoryRegion(const std::string& key, size_t offset, size_t byteSize, void* mapping, size_t mappingSize) :
+    key(key),
+    offset(offset),
+    byteSize(byteSize),
+    mapping(mapping),
+    mappingSize(mappingSize),
+    data(static_cast<const char*>(mapping) + mappingSize - byteSize) {}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    munmap(mapping, mappingSize);
+}
+
+Status SharedMemoryRegion::map(const std::string& key, size_t offset, size_t byteSize, std::shared_ptr<SharedMemoryRegion>& region) {
+    if (!isValidKey(key) || byteSize == 0) {
+        return StatusCode::SHARED_MEMORY_REGION_INVALID;
+    }
+    const int fd = shm_open(key.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        SPDLOG_DEBUG("Cannot open shared memory object: {}", key);
+        return StatusCode::SHARED_MEMORY_REGION_INVALID;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || offset > static_cast<size_t>(info.st_size) || byteSize > static_cast<size_t>(info.st_size) - offset) {
+        close(fd);
+        return StatusCode::SHARED_MEMORY_REGION_INVALID;
+    }
+    // mapping has to start at page boundary
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t mappingOffset = offset - offset % pageSize;
+    const size_t mappingSize = byteSize + offset - mappingOffset;
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, mappingOffset);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return StatusCode::SHARED_MEMORY_REGION_INVALID;
+    }
+    region.reset(new SharedMemoryRegion(key, offset, byteSize, mapping, mappingSize));
+    return StatusCode::OK;
+}
+
+Status SharedMemoryRegistry::registerRegion(const std::string& name, const std::string& key, size_t offset, size_t byteSize) {
+    if (!enabled) {
+        return StatusCode::SHARED_MEMORY_DISABLED;
+    }
+    if (!isValidName(name)) {
+        return StatusCode::SHARED_MEMORY_REGION_INVALID;
+    }
+    std::shared_ptr<SharedMemoryRegion> region;
+    auto status = SharedMemoryRegion::map(key, offset, byteSize, region);
+    if (!status.ok()) {
+        return status;
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    if (!regions.emplace(name, std::move(region)).second) {
+        return StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED;
+    }
+    spdlog::info("Registered shared memory region:{}; object:{}; offset:{}; size:{}", name, key, offset, byteSize);
+    return StatusCode::OK;
+}
+
+Status SharedMemoryRegistry::unregisterRegion(const std::string& name) {
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    if (regions.erase(name) == 0) {
+        return StatusCode::SHARED_MEMORY_REGION_MISSING;
+    }
+    spdlog::info("Unregistered shared memory region:{}", name);
+    return StatusCode::OK;
+}
+
+std::shared_ptr<const SharedMemoryRegion> SharedMemoryRegistry::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    auto it = regions.find(name);
+    return it != regions.end() ? it->second : nullptr;
+}
+
+std::string SharedMemoryRegistry::toJson() const {
+    std::shared_lock<std::shared_mutex> lock(mtx);
+    std::stringstream json;
+    json << "{";
+    for (auto it = regions.begin(); it != regions.end(); ++it) {
+        // names and keys are limited to characters which do not need escaping in JSON
+        json << (it == regions.begin() ? "" : ", ") << "\"" << it->first << "\": {\"key\": \"" << it->second->getKey()
+             << "\", \"offset\": " << it->second->getOffset() << ", \"byte_size\": " << it->second->getByteSize() << "}";
+    }
+    json << "}";
+    return json.str();
+}
+
+bool isSharedMemoryInput(const tensorflow::TensorProto& input) {
+    return input.resource_handle_val_size() == 1 && input.resource_handle_val(0).container() == SHARED_MEMORY_CONTAINER;
+}
+
+Status getSharedMemoryInput(const tensorflow::TensorProto& input, size_t byteSize, std::shared_ptr<const SharedMemoryRegion>& region, const char*& data) {
+    const auto& handle = input.resource_handle_val(0);
+    region = SharedMemoryRegistry::getInstance().find(handle.name());
+    if (region == nullptr) {
+        return Status(StatusCode::SHARED_MEMORY_REGION_MISSING, handle.name());
+    }
+    const size_t offset = handle.hash_code();
+    if (offset > region->getByteSize() || byteSize > region->getByteSize() - offset) {
+        std::stringstream ss;
+        ss << "Region size: " << region->getByteSize() << " bytes; Input offset: " << offset << "; Input size: " << byteSize << " bytes";
+        return Status(StatusCode::SHARED_MEMORY_INPUT_OUT_OF_RANGE, ss.str());
+    }
+    data = region->getData() + offset;
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
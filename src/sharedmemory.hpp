@@ -0,0 +1,122 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Container of resource handle which marks request input passed through registered shared memory region
+ *
+ * Handle name is the region name and hash_code is the offset of input data within the region.
+ */
+extern const char* const SHARED_MEMORY_CONTAINER;
+
+/**
+ * @brief Read only mapping of POSIX shared memory object, unmapped when the last user releases it
+ */
+class SharedMemoryRegion {
+public:
+    /**
+     * @brief Maps byteSize bytes of shared memory object starting at offset
+     *
+     * @param key name of the object passed to shm_open, e.g. "/frames"
+     */
+    static Status map(const std::string& key, size_t offset, size_t byteSize, std::shared_ptr<SharedMemoryRegion>& region);
+
+    ~SharedMemoryRegion();
+
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    const std::string& getKey() const { return key; }
+    size_t getOffset() const { return offset; }
+    size_t getByteSize() const { return byteSize; }
+    const char* getData() const { return data; }
+
+private:
+    SharedMemoryRegion(const std::string& key, size_t offset, size_t byteSize, void* mapping, size_t mappingSize);
+
+    const std::string key;
+    const size_t offset;
+    const size_t byteSize;
+    void* const mapping;
+    const size_t mappingSize;
+    const char* const data;
+};
+
+/**
+ * @brief Regions of shared memory registered by co-located clients under their names
+ *
+ * Clients write inputs into a region and reference them in Predict requests instead of sending the data,
+ * these are then inferred straight from the mapping. Unregistered region stays mapped until inferences reading it
+ * are finished. Registration is disabled by default.
+ */
+class SharedMemoryRegistry {
+public:
+    static SharedMemoryRegistry& getInstance() {
+        static SharedMemoryRegistry instance;
+        return instance;
+    }
+
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+
+    bool isEnabled() const { return enabled; }
+
+    Status registerRegion(const std::string& name, const std::string& key, size_t offset, size_t byteSize);
+
+    Status unregisterRegion(const std::string& name);
+
+    /**
+     * @return region or nullptr if it is not registered
+     */
+    std::shared_ptr<const SharedMemoryRegion> find(const std::string& name) const;
+
+    /**
+     * @brief Serializes registered regions as JSON object keyed by region names
+     */
+    std::string toJson() const;
+
+private:
+    SharedMemoryRegistry() = default;
+
+    std::atomic<bool> enabled = false;
+    mutable std::shared_mutex mtx;
+    std::map<std::string, std::shared_ptr<const SharedMemoryRegion>> regions;
+};
+
+/**
+ * @brief Checks if request input references shared memory region instead of carrying data
+ */
+bool isSharedMemoryInput(const tensorflow::TensorProto& input);
+
+/**
+ * @brief Resolves byteSize bytes of input referencing shared memory region
+ *
+ * @param region keeps data mapped while it is used
+ */
+Status getSharedMemoryInput(const tensorflow::TensorProto& input, size_t byteSize, std::shared_ptr<const SharedMemoryRegion>& region, const char*& data);
+
+}  // namespace ovms
@@ -0,0 +1,61 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "sharednetworks.hpp"
+
+namespace ovms {
+
+SharedNetworks::network_ptr_t SharedNetworks::getOrLoad(const std::string& key, const std::function<network_ptr_t()>& load) {
+    std::unique_lock<std::mutex> lock(mtx);
+    loadFinished.wait(lock, [this, &key]() { return loading.count(key) == 0; });
+    auto it = networks.find(key);
+    if (it != networks.end()) {
+        if (auto network = it->second.lock()) {
+            return network;
+        }
+        networks.erase(it);
+    }
+    loading.insert(key);
+    lock.unlock();
+    network_ptr_t network;
+    try {
+        network = load();
+    } catch (...) {
+        lock.lock();
+        loading.erase(key);
+        loadFinished.notify_all();
+        throw;
+    }
+    lock.lock();
+    if (network) {
+        networks[key] = network;
+    }
+    loading.erase(key);
+    loadFinished.notify_all();
+    return network;
+}
+
+size_t SharedNetworks::size() {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t count = 0;
+    for (const auto& pair : networks) {
+        if (!pair.second.expired()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}  // namespace ovms
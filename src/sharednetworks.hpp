@@ -0,0 +1,73 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <inference_engine.hpp>
+
+namespace ovms {
+
+/**
+ * @brief Registry of executable networks shared by model versions and models compiled from identical model files
+ *
+ * Networks are keyed by content hash of model files and description of the compilation. Registry does not own
+ * the networks, a network is released when the last model instance using it is unloaded. Each model instance
+ * keeps its own infer requests queue created from the shared network. Registry is disabled by default.
+ */
+class SharedNetworks {
+public:
+    using network_ptr_t = std::shared_ptr<InferenceEngine::ExecutableNetwork>;
+
+    static SharedNetworks& getInstance() {
+        static SharedNetworks instance;
+        return instance;
+    }
+
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Returns network registered under the key or loads and registers it
+     *
+     * Concurrent calls with the same key wait for the first one to load the network. If that fails,
+     * next caller tries to load it. Null returned by load is not registered.
+     */
+    network_ptr_t getOrLoad(const std::string& key, const std::function<network_ptr_t()>& load);
+
+    /**
+     * @brief Counts networks in use by at least one model instance
+     */
+    size_t size();
+
+private:
+    SharedNetworks() = default;
+
+    std::mutex mtx;
+    std::condition_variable loadFinished;
+    std::map<std::string, std::weak_ptr<InferenceEngine::ExecutableNetwork>> networks;
+    std::set<std::string> loading;
+    bool enabled = false;
+};
+
+}  // namespace ovms
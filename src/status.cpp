@@ -31,19 +31,41 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::PLUGIN_CONFIG_WRONG_FORMAT, "Plugin config is in wrong format"},
     {StatusCode::MODEL_VERSION_POLICY_WRONG_FORMAT, "Model version policy is in wrong format"},
     {StatusCode::MODEL_VERSION_POLICY_UNSUPPORTED_KEY, "Model version policy contains unsupported key"},
+    {StatusCode::MODEL_VERSION_WEIGHTS_WRONG_FORMAT, "Model version weights are in wrong format"},
     {StatusCode::RESHAPE_ERROR, "Model could not be reshaped with requested shape"},
     {StatusCode::ANONYMOUS_FIXED_SHAPE_NOT_ALLOWED, "Anonymous fixed shape is invalid for models with multiple inputs"},
     {StatusCode::CANNOT_LOAD_NETWORK_INTO_TARGET_DEVICE, "Cannot load network into target device"},
     {StatusCode::MODEL_MISSING, "Model with requested name and/or version is not found"},
     {StatusCode::MODEL_NAME_MISSING, "Model with requested name is not found"},
     {StatusCode::PIPELINE_DEFINITION_NAME_MISSING, "Model with requested name is not found"},
+    {StatusCode::PIPELINE_INPUTS_INFO_UNAVAILABLE, "Pipeline input is not consumed by any model node, its shape is unknown"},
+    {StatusCode::PIPELINE_NODE_DEVICE_UNAVAILABLE, "Model of pipeline node does not run on device requested for the node"},
+    {StatusCode::PIPELINE_CONDITION_INVALID, "Condition of pipeline node refers to input the node does not receive"},
+    {StatusCode::PIPELINE_CONDITION_UNSUPPORTED_PRECISION, "Condition of pipeline node does not support precision of its input"},
     {StatusCode::MODEL_VERSION_MISSING, "Model with requested version is not found"},
     {StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE, "Model with requested version is retired"},
     {StatusCode::MODEL_VERSION_NOT_LOADED_YET, "Model with requested version is not loaded yet"},
     {StatusCode::MODEL_SPEC_MISSING, "model_spec missing in request"},
     {StatusCode::INVALID_SIGNATURE_DEF, "Invalid signature name"},
     {StatusCode::CONFIG_SHAPE_IS_NOT_IN_NETWORK, "Shape from config not found in network"},
+    {StatusCode::CONFIG_PRECISION_IS_NOT_IN_NETWORK, "Precision from config not found in network"},
+    {StatusCode::INVALID_PREPROCESSING_INPUT, "Preprocessed input not found in network or preprocessing does not match its shape"},
+    {StatusCode::INVALID_POSTPROCESSING_OUTPUT, "Postprocessed output not found in network, not FP32 or with less classes than top K"},
+    {StatusCode::INVALID_OUTPUT_PRECISION, "Output with response precision from config not found in network or not FP32"},
     {StatusCode::INVALID_NIREQ, "Nireq parameter too high"},
+    {StatusCode::INVALID_NUMA_NODE, "NUMA node does not exist or has no CPUs"},
+    {StatusCode::REQUEST_QUEUE_FULL, "Model request queue is full"},
+    {StatusCode::REQUEST_QUEUE_TIMEOUT, "Request exceeded time limit of waiting in model request queue"},
+    {StatusCode::DEADLINE_EXCEEDED, "Request deadline exceeded"},
+    {StatusCode::REQUEST_CANCELLED, "Request cancelled by client"},
+    {StatusCode::REQUEST_TIMEOUT_HEADER_INVALID, "Invalid request timeout header"},
+    {StatusCode::REQUEST_PRIORITY_INVALID, "Invalid request priority, should be high or low"},
+    {StatusCode::TENANT_RATE_LIMITED, "Tenant request rate limit exceeded"},
+    {StatusCode::TENANT_CONFIG_INVALID, "Invalid tenant limits configuration"},
+    {StatusCode::PEER_CONFIG_INVALID, "Invalid peers configuration"},
+    {StatusCode::ISOLATION_GROUPS_CONFIG_INVALID, "Invalid isolation groups configuration"},
+    {StatusCode::ISOLATION_GROUP_MISSING, "Isolation group is not configured"},
+    {StatusCode::SERVER_NOT_READY, "Server is not ready yet, models are being loaded"},
 
     // Predict request validation
     {StatusCode::INVALID_NO_OF_INPUTS, "Invalid number of inputs"},
@@ -54,6 +76,15 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::INVALID_PRECISION, "Invalid input precision"},
     {StatusCode::INVALID_VALUE_COUNT, "Invalid number of values in tensor proto container"},
     {StatusCode::INVALID_CONTENT_SIZE, "Invalid content size of tensor proto"},
+    {StatusCode::IMAGE_PARSING_FAILED, "Image parsing failed"},
+    {StatusCode::UNSUPPORTED_IMAGE_INPUT, "Input does not accept encoded images, it must have 4 dimensions with 1 or 3 channels, NCHW or NHWC layout and U8 or FP32 precision"},
+    {StatusCode::SEQUENCE_ID_NOT_PROVIDED, "Sequence id has to be provided unless sequence is started"},
+    {StatusCode::INVALID_SEQUENCE_CONTROL_INPUT, "Sequence id must be a single DT_UINT64 value and sequence control input a single DT_UINT32 value of 0, 1 or 2"},
+    {StatusCode::SEQUENCE_MISSING, "Sequence with provided id does not exist"},
+    {StatusCode::SEQUENCE_ALREADY_EXISTS, "Sequence with provided id already exists"},
+    {StatusCode::SEQUENCE_TERMINATED, "Sequence with provided id was ended by another request"},
+    {StatusCode::MAX_SEQUENCE_NUMBER_REACHED, "Max sequence number of the model has been reached"},
+    {StatusCode::MODEL_NOT_STATEFUL, "Model version is not stateful"},
 
     // Deserialization
     {StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION, "Unsupported deserialization precision"},
@@ -89,6 +120,27 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::REST_PROTO_TO_STRING_ERROR, "Response parsing to JSON error"},
     {StatusCode::REST_UNSUPPORTED_PRECISION, "Could not parse input content. Unsupported data precision detected"},
     {StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE, "Tensor serialization error"},
+    {StatusCode::REST_BINARY_HEADER_INVALID, "Invalid binary tensor request header"},
+    {StatusCode::REST_BINARY_DATA_SIZE_MISMATCH, "Binary tensor data size does not match request header"},
+    {StatusCode::COMPRESSION_ERROR, "Invalid or too large compressed content"},
+    {StatusCode::REST_BATCH_INVALID, "Invalid batch predict request"},
+
+    // Shared memory
+    {StatusCode::SHARED_MEMORY_DISABLED, "Shared memory is not enabled"},
+    {StatusCode::SHARED_MEMORY_REGION_INVALID, "Shared memory object cannot be mapped"},
+    {StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED, "Shared memory region with this name is already registered"},
+    {StatusCode::SHARED_MEMORY_REGION_MISSING, "Shared memory region is not registered"},
+    {StatusCode::SHARED_MEMORY_INPUT_OUT_OF_RANGE, "Input exceeds its shared memory region"},
+
+    // Batch jobs
+    {StatusCode::BATCH_JOBS_DISABLED, "Batch jobs are not enabled"},
+    {StatusCode::BATCH_JOB_INVALID, "Invalid batch job"},
+    {StatusCode::BATCH_JOB_MISSING, "Batch job does not exist"},
+    {StatusCode::BATCH_JOB_OUTPUT_ERROR, "Batch job result could not be written"},
+    {StatusCode::NPY_FILE_INVALID, "Invalid .npy file"},
+    {StatusCode::KSERVE_VERSION_INVALID, "Invalid model version"},
+    {StatusCode::KSERVE_DATATYPE_UNSUPPORTED, "Unsupported input datatype"},
+    {StatusCode::KSERVE_INPUT_CONTENTS_INVALID, "Invalid input contents"},
 
     // Storage errors
     // S3
@@ -124,6 +176,16 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::AS_FILE_INVALID, "AS File path is invalid"},
     {StatusCode::AS_FAILED_GET_OBJECT, "AS Failed to get object from path"},
     {StatusCode::AS_INCORRECT_REQUESTED_OBJECT_TYPE, "AS invalid object type in path"},
+
+    // Custom node
+    {StatusCode::NODE_LIBRARY_LOAD_FAILED, "Custom node library could not be loaded"},
+    {StatusCode::NODE_LIBRARY_EXECUTION_FAILED, "Custom node library execution failed"},
+    {StatusCode::NODE_LIBRARY_OUTPUTS_INVALID, "Custom node library returned invalid outputs"},
+
+    // Sampling profiler
+    {StatusCode::PROFILER_INVALID_PARAMETERS, "Invalid profiling parameters, duration, sampling frequency or number of inferences out of range"},
+    {StatusCode::PROFILER_ALREADY_RUNNING, "Other profile is in progress"},
+    {StatusCode::PROFILER_START_FAILED, "Sampling profiler could not be started"},
 };
 
 const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
@@ -146,6 +208,14 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
     {StatusCode::MODEL_VERSION_MISSING, grpc::StatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE, grpc::StatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_NOT_LOADED_YET, grpc::StatusCode::NOT_FOUND},
+    {StatusCode::REQUEST_QUEUE_FULL, grpc::StatusCode::RESOURCE_EXHAUSTED},
+    {StatusCode::REQUEST_QUEUE_TIMEOUT, grpc::StatusCode::RESOURCE_EXHAUSTED},
+    {StatusCode::DEADLINE_EXCEEDED, grpc::StatusCode::DEADLINE_EXCEEDED},
+    {StatusCode::REQUEST_CANCELLED, grpc::StatusCode::CANCELLED},
+    {StatusCode::REQUEST_TIMEOUT_HEADER_INVALID, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::REQUEST_PRIORITY_INVALID, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::TENANT_RATE_LIMITED, grpc::StatusCode::RESOURCE_EXHAUSTED},
+    {StatusCode::SERVER_NOT_READY, grpc::StatusCode::UNAVAILABLE},
     {StatusCode::MODEL_SPEC_MISSING, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_SIGNATURE_DEF, grpc::StatusCode::INVALID_ARGUMENT},
 
@@ -158,6 +228,20 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
     {StatusCode::INVALID_PRECISION, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_VALUE_COUNT, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_CONTENT_SIZE, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::IMAGE_PARSING_FAILED, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::UNSUPPORTED_IMAGE_INPUT, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::SEQUENCE_ID_NOT_PROVIDED, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::INVALID_SEQUENCE_CONTROL_INPUT, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::SEQUENCE_MISSING, grpc::StatusCode::NOT_FOUND},
+    {StatusCode::SEQUENCE_ALREADY_EXISTS, grpc::StatusCode::ALREADY_EXISTS},
+    {StatusCode::SEQUENCE_TERMINATED, grpc::StatusCode::FAILED_PRECONDITION},
+    {StatusCode::MAX_SEQUENCE_NUMBER_REACHED, grpc::StatusCode::RESOURCE_EXHAUSTED},
+    {StatusCode::MODEL_NOT_STATEFUL, grpc::StatusCode::FAILED_PRECONDITION},
+    {StatusCode::SHARED_MEMORY_REGION_MISSING, grpc::StatusCode::NOT_FOUND},
+    {StatusCode::SHARED_MEMORY_INPUT_OUT_OF_RANGE, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::KSERVE_VERSION_INVALID, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::KSERVE_DATATYPE_UNSUPPORTED, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::KSERVE_INPUT_CONTENTS_INVALID, grpc::StatusCode::INVALID_ARGUMENT},
 
     // Deserialization
 
@@ -176,6 +260,11 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
 
     // GetModelStatus
     {StatusCode::INTERNAL_ERROR, grpc::StatusCode::INTERNAL},
+
+    // Custom node
+    {StatusCode::NODE_LIBRARY_EXECUTION_FAILED, grpc::StatusCode::INTERNAL},
+    {StatusCode::NODE_LIBRARY_OUTPUTS_INVALID, grpc::StatusCode::INTERNAL},
+    {StatusCode::PIPELINE_CONDITION_UNSUPPORTED_PRECISION, grpc::StatusCode::INTERNAL},
 };
 
 const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap = {
@@ -201,6 +290,23 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     {StatusCode::REST_PROTO_TO_STRING_ERROR, net_http::HTTPStatusCode::ERROR},
     {StatusCode::REST_UNSUPPORTED_PRECISION, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::REST_BINARY_HEADER_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::REST_BINARY_DATA_SIZE_MISMATCH, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::COMPRESSION_ERROR, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::REST_BATCH_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::SHARED_MEMORY_DISABLED, net_http::HTTPStatusCode::FORBIDDEN},
+    {StatusCode::SHARED_MEMORY_REGION_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED, net_http::HTTPStatusCode::CONFLICT},
+    {StatusCode::SHARED_MEMORY_REGION_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
+    {StatusCode::SHARED_MEMORY_INPUT_OUT_OF_RANGE, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::BATCH_JOBS_DISABLED, net_http::HTTPStatusCode::FORBIDDEN},
+    {StatusCode::BATCH_JOB_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::BATCH_JOB_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
+    {StatusCode::BATCH_JOB_OUTPUT_ERROR, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::NPY_FILE_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::KSERVE_VERSION_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::KSERVE_DATATYPE_UNSUPPORTED, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::KSERVE_INPUT_CONTENTS_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
 
     {StatusCode::PATH_INVALID, net_http::HTTPStatusCode::ERROR},
     {StatusCode::FILE_INVALID, net_http::HTTPStatusCode::ERROR},
@@ -219,6 +325,14 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     {StatusCode::MODEL_VERSION_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE, net_http::HTTPStatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_NOT_LOADED_YET, net_http::HTTPStatusCode::NOT_FOUND},
+    {StatusCode::REQUEST_QUEUE_FULL, net_http::HTTPStatusCode::SERVICE_UNAV},
+    {StatusCode::REQUEST_QUEUE_TIMEOUT, net_http::HTTPStatusCode::SERVICE_UNAV},
+    {StatusCode::DEADLINE_EXCEEDED, net_http::HTTPStatusCode::GATEWAY_TO},
+    {StatusCode::REQUEST_CANCELLED, net_http::HTTPStatusCode::SERVICE_UNAV},
+    {StatusCode::REQUEST_TIMEOUT_HEADER_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::REQUEST_PRIORITY_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::TENANT_RATE_LIMITED, net_http::HTTPStatusCode::SERVICE_UNAV},
+    {StatusCode::SERVER_NOT_READY, net_http::HTTPStatusCode::SERVICE_UNAV},
     {StatusCode::MODEL_SPEC_MISSING, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_SIGNATURE_DEF, net_http::HTTPStatusCode::BAD_REQUEST},
 
@@ -231,6 +345,15 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     {StatusCode::INVALID_PRECISION, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_VALUE_COUNT, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_CONTENT_SIZE, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::IMAGE_PARSING_FAILED, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::UNSUPPORTED_IMAGE_INPUT, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::SEQUENCE_ID_NOT_PROVIDED, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::INVALID_SEQUENCE_CONTROL_INPUT, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::SEQUENCE_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
+    {StatusCode::SEQUENCE_ALREADY_EXISTS, net_http::HTTPStatusCode::CONFLICT},
+    {StatusCode::SEQUENCE_TERMINATED, net_http::HTTPStatusCode::PRECOND_FAILED},
+    {StatusCode::MAX_SEQUENCE_NUMBER_REACHED, net_http::HTTPStatusCode::SERVICE_UNAV},
+    {StatusCode::MODEL_NOT_STATEFUL, net_http::HTTPStatusCode::PRECOND_FAILED},
 
     // Deserialization
 
@@ -249,6 +372,16 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
 
     // GetModelStatus
     {StatusCode::INTERNAL_ERROR, net_http::HTTPStatusCode::ERROR},
+
+    // Custom node
+    {StatusCode::NODE_LIBRARY_EXECUTION_FAILED, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::NODE_LIBRARY_OUTPUTS_INVALID, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::PIPELINE_CONDITION_UNSUPPORTED_PRECISION, net_http::HTTPStatusCode::ERROR},
+
+    // Sampling profiler
+    {StatusCode::PROFILER_INVALID_PARAMETERS, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::PROFILER_ALREADY_RUNNING, net_http::HTTPStatusCode::SERVICE_UNAV},
+    {StatusCode::PROFILER_START_FAILED, net_http::HTTPStatusCode::ERROR},
 };
 
 }  // namespace ovms
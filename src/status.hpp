@@ -41,6 +41,7 @@ enum class StatusCode {
     PLUGIN_CONFIG_WRONG_FORMAT,           /*!< Plugin config is in wrong format */
     MODEL_VERSION_POLICY_WRONG_FORMAT,    /*!< Model version policy is in wrong format */
     MODEL_VERSION_POLICY_UNSUPPORTED_KEY, /*!< Model version policy contains invalid key */
+    MODEL_VERSION_WEIGHTS_WRONG_FORMAT,   /*!< Model version weights are in wrong format */
     GRPC_CHANNEL_ARG_WRONG_FORMAT,
     NO_MODEL_VERSION_AVAILABLE,             /*!< No model version found in path */
     RESHAPE_ERROR,                          /*!< Impossible to perform reshape */
@@ -49,6 +50,10 @@ enum class StatusCode {
     FORBIDDEN_MODEL_DYNAMIC_PARAMETER,      /*!< Value of the provided param is forbidden */
     ANONYMOUS_FIXED_SHAPE_NOT_ALLOWED,      /*!< Anonymous fixed shape is invalid for models with multiple inputs */
     CONFIG_SHAPE_IS_NOT_IN_NETWORK,         /*!< Invalid shape dimension number or dimension value */
+    CONFIG_PRECISION_IS_NOT_IN_NETWORK,     /*!< Input of precision from config not found in network */
+    INVALID_PREPROCESSING_INPUT,            /*!< Preprocessed input not found in network or preprocessing does not match its shape */
+    INVALID_POSTPROCESSING_OUTPUT,          /*!< Postprocessed output not found in network or not reducible to top K */
+    INVALID_OUTPUT_PRECISION,               /*!< Output of response precision from config not found in network or not FP32 */
     CANNOT_LOAD_NETWORK_INTO_TARGET_DEVICE, /*!< Cannot load network into target device */
 
     // Model management
@@ -58,6 +63,19 @@ enum class StatusCode {
     MODEL_VERSION_NOT_LOADED_ANYMORE, /*!< Model with requested version is retired */
     MODEL_VERSION_NOT_LOADED_YET,     /*!< Model with requested version is not loaded yet */
     INVALID_NIREQ,                    /*!< Invalid NIREQ requested */
+    INVALID_NUMA_NODE,                /*!< Configured NUMA node does not exist or has no CPUs */
+    REQUEST_QUEUE_FULL,               /*!< Model request queue is full */
+    REQUEST_QUEUE_TIMEOUT,            /*!< Request waited in model request queue too long */
+    DEADLINE_EXCEEDED,                /*!< Client deadline passed before request was processed */
+    REQUEST_CANCELLED,                /*!< Client cancelled the request */
+    REQUEST_TIMEOUT_HEADER_INVALID,   /*!< Request timeout header is not a number of milliseconds */
+    REQUEST_PRIORITY_INVALID,         /*!< Request priority is neither high nor low */
+    TENANT_RATE_LIMITED,              /*!< Tenant of the request exceeded its request rate limit */
+    TENANT_CONFIG_INVALID,            /*!< Tenant limits configuration is malformed */
+    PEER_CONFIG_INVALID,              /*!< Peer addresses are malformed */
+    ISOLATION_GROUPS_CONFIG_INVALID,  /*!< Isolation groups configuration is malformed */
+    ISOLATION_GROUP_MISSING,          /*!< Model is assigned to isolation group which is not configured */
+    SERVER_NOT_READY,                 /*!< Models from config are still being loaded at startup */
 
     // Predict request validation
     INVALID_NO_OF_INPUTS,           /*!< Invalid number of inputs */
@@ -69,6 +87,15 @@ enum class StatusCode {
     INVALID_PRECISION,              /*!< Invalid precision */
     INVALID_VALUE_COUNT,            /*!< Invalid value count error status for uint16 and half float data types */
     INVALID_CONTENT_SIZE,           /*!< Invalid content size error status for types using tensor_content() */
+    IMAGE_PARSING_FAILED,           /*!< Encoded image in string_val cannot be decoded */
+    UNSUPPORTED_IMAGE_INPUT,        /*!< Network input does not accept encoded images */
+    SEQUENCE_ID_NOT_PROVIDED,       /*!< Request to stateful model continues or ends sequence without its id */
+    INVALID_SEQUENCE_CONTROL_INPUT, /*!< Sequence id or control input has wrong type, shape or value */
+    SEQUENCE_MISSING,               /*!< Sequence with the id does not exist or timed out */
+    SEQUENCE_ALREADY_EXISTS,        /*!< Sequence started with the id of existing sequence */
+    SEQUENCE_TERMINATED,            /*!< Sequence ended while request was waiting for it */
+    MAX_SEQUENCE_NUMBER_REACHED,    /*!< Limit of sequences of the model is reached */
+    MODEL_NOT_STATEFUL,             /*!< Request of sequence reached model version which is not stateful */
 
     // Deserialization
     OV_UNSUPPORTED_DESERIALIZATION_PRECISION, /*!< Unsupported deserialization precision, theoretically should never be returned since ModelInstance::validation checks against network precision */
@@ -150,6 +177,29 @@ enum class StatusCode {
     REST_PROTO_TO_STRING_ERROR,          /*!< Error while parsing ResponseProto to JSON string */
     REST_UNSUPPORTED_PRECISION,          /*!< Unsupported conversion from tensor_content to _val container */
     REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE,
+    REST_BINARY_HEADER_INVALID,     /*!< Binary tensor request header is missing or malformed */
+    REST_BINARY_DATA_SIZE_MISMATCH, /*!< Binary tensor data size does not match header */
+    COMPRESSION_ERROR,              /*!< Request body could not be decompressed or response compressed */
+    REST_BATCH_INVALID,             /*!< Batch predict request is not an array of predict requests or has too many of them */
+
+    // Shared memory
+    SHARED_MEMORY_DISABLED,                  /*!< Shared memory regions registration is not enabled */
+    SHARED_MEMORY_REGION_INVALID,            /*!< Shared memory object cannot be opened or mapped */
+    SHARED_MEMORY_REGION_ALREADY_REGISTERED, /*!< Region with the name is already registered */
+    SHARED_MEMORY_REGION_MISSING,            /*!< Region with the name is not registered */
+    SHARED_MEMORY_INPUT_OUT_OF_RANGE,        /*!< Input referenced in request exceeds its region */
+
+    // Batch jobs
+    BATCH_JOBS_DISABLED,    /*!< Batch jobs output path is not configured */
+    BATCH_JOB_INVALID,      /*!< Batch job submission or its input is malformed */
+    BATCH_JOB_MISSING,      /*!< Batch job with the id does not exist */
+    BATCH_JOB_OUTPUT_ERROR, /*!< Batch job result could not be written */
+    NPY_FILE_INVALID,       /*!< File is not a supported NumPy array */
+
+    // KServe API
+    KSERVE_VERSION_INVALID,        /*!< Model version is not a number */
+    KSERVE_DATATYPE_UNSUPPORTED,   /*!< Input datatype has no OpenVINO precision */
+    KSERVE_INPUT_CONTENTS_INVALID, /*!< Raw input contents do not match inputs or contents are missing */
 
     PIPELINE_DEFINITION_ALREADY_EXIST,
     PIPELINE_NODE_WRONG_KIND_CONFIGURATION,
@@ -162,6 +212,25 @@ enum class StatusCode {
     PIPELINE_CYCLE_FOUND,
     PIPELINE_CONTAINS_UNCONNECTED_NODES,
     PIPELINE_DEFINITION_MISSING_DEPENDENCY_MAPPING,
+    PIPELINE_DEMULTIPLY_COUNT_INVALID,
+    PIPELINE_DEMULTIPLEXER_INVALID_OUTPUT_SHAPE,
+    PIPELINE_GATHER_FROM_NOT_DEMULTIPLEXER,
+    PIPELINE_INPUTS_INFO_UNAVAILABLE, /*!< Pipeline input is not consumed by any model node, its shape is unknown */
+    PIPELINE_NODE_DEVICE_UNAVAILABLE, /*!< Model of pipeline node does not run on device requested for the node */
+    PIPELINE_CONDITION_INVALID,               /*!< Condition of pipeline node refers to input the node does not receive */
+    PIPELINE_CONDITION_UNSUPPORTED_PRECISION, /*!< Condition of pipeline node cannot compare scores of input precision */
+
+    // Custom node
+    NODE_LIBRARY_LOAD_FAILED,      /*!< Custom node library could not be loaded or misses required functions */
+    NODE_LIBRARY_EXECUTION_FAILED, /*!< Custom node library execute returned error */
+    NODE_LIBRARY_OUTPUTS_INVALID,  /*!< Custom node library returned outputs with unsupported precision or wrong size */
+
+    // Sampling profiler
+    PROFILER_INVALID_PARAMETERS, /*!< Profile duration or sampling frequency out of range */
+    PROFILER_ALREADY_RUNNING,    /*!< Other profile is in progress */
+    PROFILER_START_FAILED,       /*!< Profiling signal handler or timer could not be set up */
+
+    STATUS_CODE_END, /*!< Number of status codes, not returned as status */
 };
 
 class Status {
@@ -0,0 +1,73 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "storagepollschedule.hpp"
+
+#include <algorithm>
+
+namespace ovms {
+
+StoragePollSchedule::StoragePollSchedule(uint32_t seed) :
+    random(seed) {}
+
+bool StoragePollSchedule::isDue(const std::string& name, std::chrono::seconds interval, std::chrono::seconds maxInterval, clock::time_point now) {
+    maxInterval = std::max(maxInterval, interval);
+    auto it = models.find(name);
+    if (it == models.end() || it->second.baseInterval != interval || it->second.maxInterval != maxInterval) {
+        ModelSchedule schedule{interval, maxInterval, interval, now};
+        if (!checkNewModelsNow) {
+            // first check is spread over the whole interval, replicas starting together do not stay in sync
+            schedule.nextCheck += randomized(interval, 0.5, 1.5);
+        }
+        it = models.insert_or_assign(name, schedule).first;
+    }
+    return now >= it->second.nextCheck;
+}
+
+void StoragePollSchedule::reportCheck(const std::string& name, bool changed, clock::time_point now) {
+    auto it = models.find(name);
+    if (it == models.end()) {
+        return;
+    }
+    auto& schedule = it->second;
+    if (changed) {
+        schedule.interval = schedule.baseInterval;
+    } else {
+        schedule.interval = std::min<std::chrono::milliseconds>(schedule.interval * 2, schedule.maxInterval);
+    }
+    schedule.nextCheck = now + randomized(schedule.interval, 1 - STORAGE_POLL_JITTER, 1 + STORAGE_POLL_JITTER);
+}
+
+void StoragePollSchedule::retain(const std::set<std::string>& names) {
+    for (auto it = models.begin(); it != models.end();) {
+        if (names.count(it->first)) {
+            ++it;
+        } else {
+            it = models.erase(it);
+        }
+    }
+}
+
+std::chrono::milliseconds StoragePollSchedule::getInterval(const std::string& name) const {
+    auto it = models.find(name);
+    return it == models.end() ? std::chrono::milliseconds(0) : it->second.interval;
+}
+
+std::chrono::milliseconds StoragePollSchedule::randomized(std::chrono::milliseconds interval, double minFactor, double maxFactor) {
+    std::uniform_real_distribution<double> factor(minFactor, maxFactor);
+    return std::chrono::milliseconds(static_cast<int64_t>(interval.count() * factor(random)));
+}
+
+}  // namespace ovms
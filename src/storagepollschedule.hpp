@@ -0,0 +1,88 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+namespace ovms {
+
+// every scheduled interval is randomly shortened or lengthened by up to this fraction
+const double STORAGE_POLL_JITTER = 0.2;
+
+/**
+ * @brief Times of next version listing of models in remote storage
+ *
+ * Each model is listed at its own interval. Checks finding no change double the interval up to the model maximum,
+ * a detected change or listing error returns to the base interval. Intervals are randomized, so replicas
+ * started together do not list the same storage in sync. Used by the watcher thread only.
+ */
+class StoragePollSchedule {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit StoragePollSchedule(uint32_t seed = std::random_device()());
+
+    /**
+     * @brief Checks if model storage should be listed now
+     *
+     * Model seen for the first time, or with changed intervals, has its first check scheduled between half
+     * and one and a half of the base interval, or now when checks of new models are not delayed.
+     */
+    bool isDue(const std::string& name, std::chrono::seconds interval, std::chrono::seconds maxInterval, clock::time_point now);
+
+    /**
+     * @brief Schedules next check of the model after its storage was listed
+     */
+    void reportCheck(const std::string& name, bool changed, clock::time_point now);
+
+    /**
+     * @brief Forgets models not served any more
+     */
+    void retain(const std::set<std::string>& names);
+
+    /**
+     * @brief New models are checked on first call to isDue, used for versions restored from server snapshot
+     */
+    void setCheckNewModelsNow(bool checkNow) {
+        checkNewModelsNow = checkNow;
+    }
+
+    /**
+     * @brief Current interval of the model before randomization, 0 for unknown models
+     */
+    std::chrono::milliseconds getInterval(const std::string& name) const;
+
+private:
+    struct ModelSchedule {
+        std::chrono::seconds baseInterval;
+        std::chrono::seconds maxInterval;
+        std::chrono::milliseconds interval;
+        clock::time_point nextCheck;
+    };
+
+    std::chrono::milliseconds randomized(std::chrono::milliseconds interval, double minFactor, double maxFactor);
+
+    std::map<std::string, ModelSchedule> models;
+    std::mt19937 random;
+    bool checkNewModelsNow = false;
+};
+
+}  // namespace ovms
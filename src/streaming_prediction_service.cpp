@@ -0,0 +1,255 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "streaming_prediction_service.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <grpcpp/impl/codegen/method_handler_impl.h>
+#include <grpcpp/impl/codegen/rpc_service_method.h>
+#include <spdlog/spdlog.h>
+
+#include "batchingscheduler.hpp"
+#include "compression.hpp"
+#include "modelinstance.hpp"
+#include "modelinstanceunloadguard.hpp"
+#include "modelmanager.hpp"
+#include "pipeline.hpp"
+#include "prediction_service.hpp"
+#include "prediction_service_utils.hpp"
+#include "requestlogging.hpp"
+#include "status.hpp"
+#include "tenantscheduling.hpp"
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+namespace {
+
+struct Frame {
+    PredictRequest request;
+    PredictResponse response;
+    Status status;
+    bool completed = false;
+};
+
+/**
+ * @brief Frames of a single stream, read by the RPC thread and written back in order by its writer thread
+ */
+class FramesInFlight {
+public:
+    explicit FramesInFlight(size_t maxFrames) :
+        maxFrames(maxFrames) {}
+
+    /**
+     * @brief Blocks until there is room for another frame
+     *
+     * @return false if the stream already failed
+     */
+    bool waitForRoom() {
+        std::unique_lock<std::mutex> lock(mtx);
+        changed.wait(lock, [this]() { return frames.size() < maxFrames || !firstError.ok(); });
+        return firstError.ok();
+    }
+
+    void push(std::shared_ptr<Frame> frame) {
+        std::lock_guard<std::mutex> lock(mtx);
+        frames.push_back(std::move(frame));
+    }
+
+    void complete(Frame& frame, const Status& status) {
+        std::lock_guard<std::mutex> lock(mtx);
+        frame.status = status;
+        frame.completed = true;
+        changed.notify_all();
+    }
+
+    void finishReading() {
+        std::lock_guard<std::mutex> lock(mtx);
+        readingFinished = true;
+        changed.notify_all();
+    }
+
+    /**
+     * @brief Writes completed frames in order until all frames are written or the stream fails
+     *
+     * Waits for inferences of frames left after failure, so they do not outlive the stream.
+     */
+    void writeResponses(grpc::ServerContext& context, PredictStreamReaderWriter& stream) {
+        std::unique_lock<std::mutex> lock(mtx);
+        bool first = true;
+        while (true) {
+            changed.wait(lock, [this]() { return (!frames.empty() && frames.front()->completed) || (frames.empty() && readingFinished); });
+            if (frames.empty()) {
+                return;
+            }
+            auto frame = std::move(frames.front());
+            frames.pop_front();
+            if (firstError.ok() && !frame->status.ok()) {
+                firstError = frame->status;
+            }
+            if (firstError.ok()) {
+                lock.unlock();
+                if (first) {
+                    // compression is negotiated once per stream, with initial metadata sent together with the first response
+                    setGrpcResponseCompression(context, frame->response.ByteSizeLong());
+                    first = false;
+                }
+                bool written = stream.Write(frame->response);
+                lock.lock();
+                if (!written) {
+                    firstError = StatusCode::INTERNAL_ERROR;
+                }
+            }
+            changed.notify_all();
+        }
+    }
+
+    Status getFirstError() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return firstError;
+    }
+
+private:
+    const size_t maxFrames;
+    std::mutex mtx;
+    std::condition_variable changed;
+    std::deque<std::shared_ptr<Frame>> frames;
+    bool readingFinished = false;
+    Status firstError = StatusCode::OK;
+};
+
+/**
+ * @brief Model version bound to a stream, it is not kept loaded by the stream
+ */
+struct StreamBinding {
+    explicit StreamBinding(ModelManager& manager) :
+        manager(manager) {}
+
+    ModelManager& manager;
+    std::string name;
+    model_version_t version = 0;
+    std::shared_ptr<ModelInstance> instance;
+    bool pipeline = false;
+
+    bool matches(const PredictRequest& request) const {
+        return !name.empty() && name == request.model_spec().name() && version == request.model_spec().version().value();
+    }
+
+    Status acquire(const PredictRequest& request, std::unique_ptr<ModelInstanceUnloadGuard>& guard) {
+        if (matches(request)) {
+            if (pipeline) {
+                return StatusCode::OK;
+            }
+            auto status = instance->waitForLoaded(WAIT_FOR_MODEL_LOADED_TIMEOUT_MS, guard);
+            if (status != StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE) {
+                return status;
+            }
+        }
+        name = request.model_spec().name();
+        version = request.model_spec().version().value();
+        instance.reset();
+        pipeline = false;
+        auto status = getModelInstance(manager, name, version, instance, guard);
+        if (status == StatusCode::MODEL_NAME_MISSING && manager.pipelineDefinitionExists(name)) {
+            pipeline = true;
+            return StatusCode::OK;
+        }
+        if (!status.ok()) {
+            name.clear();
+        }
+        return status;
+    }
+};
+
+}  // namespace
+
+const char* StreamingPredictionServiceImpl::PREDICT_STREAM_METHOD = "/ovms.StreamingPredictionService/PredictStream";
+
+StreamingPredictionServiceImpl::StreamingPredictionServiceImpl(ModelManager& manager, uint maxFramesInFlight) :
+    manager(manager),
+    maxFramesInFlight(std::max<uint>(1, maxFramesInFlight)) {
+    AddMethod(new grpc::internal::RpcServiceMethod(
+        PREDICT_STREAM_METHOD,
+        grpc::internal::RpcMethod::BIDI_STREAMING,
+        new grpc::internal::BidiStreamingHandler<StreamingPredictionServiceImpl, PredictRequest, PredictResponse>(
+            [](StreamingPredictionServiceImpl* service, grpc::ServerContext* context, PredictStreamReaderWriter* stream) {
+                return service->PredictStream(context, stream);
+            },
+            this)));
+}
+
+grpc::Status StreamingPredictionServiceImpl::PredictStream(grpc::ServerContext* context, PredictStreamReaderWriter* stream) {
+    FramesInFlight framesInFlight(maxFramesInFlight);
+    std::thread writer([&framesInFlight, context, stream]() { framesInFlight.writeResponses(*context, *stream); });
+    StreamBinding binding(manager);
+    // every frame of the stream counts against rate limit of its tenant
+    const std::string tenant = getRequestTenant(*context);
+    while (!context->IsCancelled() && framesInFlight.waitForRoom()) {
+        auto frame = std::make_shared<Frame>();
+        if (!stream->Read(&frame->request)) {
+            break;
+        }
+        framesInFlight.push(frame);
+        auto status = Tenants::getInstance().admit(tenant);
+        if (!status.ok()) {
+            framesInFlight.complete(*frame, status);
+            continue;
+        }
+        std::unique_ptr<ModelInstanceUnloadGuard> guard;
+        status = binding.acquire(frame->request, guard);
+        if (!status.ok()) {
+            OVMS_REQUEST_DEBUG("Getting model for stream failed. {}", status.string());
+            framesInFlight.complete(*frame, status);
+            continue;
+        }
+        if (binding.pipeline) {
+            std::unique_ptr<Pipeline> pipeline;
+            status = getPipeline(manager, pipeline, &frame->request, &frame->response);
+            if (status.ok()) {
+                status = pipeline->execute();
+            }
+            framesInFlight.complete(*frame, status);
+            continue;
+        }
+        if (binding.instance->getBatchingScheduler() != nullptr && BatchingScheduler::isRequestBatchable(&frame->request)) {
+            status = inference(*binding.instance, &frame->request, &frame->response, guard, nullptr, nullptr, RequestPriority::HIGH, tenant);
+            framesInFlight.complete(*frame, status);
+            continue;
+        }
+        status = inferenceAsync(binding.instance, &frame->request, &frame->response, guard,
+            [&framesInFlight, frame](const Status& status) { framesInFlight.complete(*frame, status); }, nullptr, nullptr, RequestPriority::HIGH, tenant);
+        if (!status.ok()) {
+            framesInFlight.complete(*frame, status);
+        }
+    }
+    framesInFlight.finishReading();
+    writer.join();
+    if (context->IsCancelled()) {
+        return grpc::Status(grpc::StatusCode::CANCELLED, "stream cancelled");
+    }
+    return framesInFlight.getFirstError().grpc();
+}
+
+}  // namespace ovms
@@ -0,0 +1,50 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/sync_stream.h>
+
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+
+namespace ovms {
+
+class ModelManager;
+
+using PredictStreamReaderWriter = grpc::ServerReaderWriter<tensorflow::serving::PredictResponse, tensorflow::serving::PredictRequest>;
+
+/**
+ * @brief Bidirectional streaming Predict, defined in streaming_prediction_service.proto
+ *
+ * Model version is resolved once per stream and looked up again only when the stream requests other model or version,
+ * or when the bound version stops being available. Up to maxFramesInFlight requests of a stream are inferred
+ * concurrently, responses are written in order of requests. The stream is finished with the status of the first
+ * failed request.
+ */
+class StreamingPredictionServiceImpl final : public grpc::Service {
+public:
+    static const char* PREDICT_STREAM_METHOD;
+
+    StreamingPredictionServiceImpl(ModelManager& manager, uint maxFramesInFlight);
+
+    grpc::Status PredictStream(grpc::ServerContext* context, PredictStreamReaderWriter* stream);
+
+private:
+    ModelManager& manager;
+    const uint maxFramesInFlight;
+};
+
+}  // namespace ovms
@@ -0,0 +1,186 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "tenantscheduling.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "stringutils.hpp"
+
+namespace ovms {
+
+const std::string REQUEST_TENANT_HEADER = "ovms-tenant";
+
+namespace {
+const std::string DEFAULT_TENANT = "default";
+}  // namespace
+
+bool TokenBucket::tryTake(std::chrono::steady_clock::time_point now) {
+    if (now > lastRefill) {
+        tokens = std::min(burst, tokens + rate * std::chrono::duration<double>(now - lastRefill).count());
+        lastRefill = now;
+    }
+    if (tokens < 1) {
+        return false;
+    }
+    tokens -= 1;
+    return true;
+}
+
+Status Tenants::configure(const std::string& limitsList) {
+    std::lock_guard<std::mutex> lock(mtx);
+    enabled = false;
+    defaultLimits = TenantLimits();
+    limits.clear();
+    buckets.clear();
+    if (limitsList.empty()) {
+        return StatusCode::OK;
+    }
+    for (const auto& entry : tokenize(limitsList, ',')) {
+        auto keyValue = tokenize(entry, '=');
+        if (keyValue.size() != 2 || keyValue[0].empty()) {
+            spdlog::error("Tenant limits entry {} should be in tenant=rate[:burst[:weight]] format", entry);
+            return StatusCode::TENANT_CONFIG_INVALID;
+        }
+        auto values = tokenize(keyValue[1], ':');
+        if (values.empty() || values.size() > 3) {
+            spdlog::error("Tenant limits entry {} should be in tenant=rate[:burst[:weight]] format", entry);
+            return StatusCode::TENANT_CONFIG_INVALID;
+        }
+        std::vector<uint32_t> parsed;
+        for (const auto& value : values) {
+            auto number = stou32(value);
+            if (!number) {
+                spdlog::error("Tenant limits entry {} contains invalid number {}", entry, value);
+                return StatusCode::TENANT_CONFIG_INVALID;
+            }
+            parsed.push_back(number.value());
+        }
+        TenantLimits tenantLimits;
+        tenantLimits.requestsPerSecond = parsed[0];
+        tenantLimits.burst = std::max<uint32_t>(1, parsed.size() > 1 ? parsed[1] : parsed[0]);
+        if (parsed.size() > 2) {
+            if (parsed[2] == 0) {
+                spdlog::error("Weight of tenant {} should be positive", keyValue[0]);
+                return StatusCode::TENANT_CONFIG_INVALID;
+            }
+            tenantLimits.weight = parsed[2];
+        }
+        if (keyValue[0] == DEFAULT_TENANT) {
+            defaultLimits = tenantLimits;
+        } else {
+            limits[keyValue[0]] = tenantLimits;
+        }
+        spdlog::info("Tenant {} limits: {} requests per second; burst: {}; weight: {}",
+            keyValue[0], tenantLimits.requestsPerSecond, tenantLimits.burst, tenantLimits.weight);
+    }
+    enabled = true;
+    return StatusCode::OK;
+}
+
+const TenantLimits& Tenants::getLimits(const std::string& tenant) const {
+    auto it = limits.find(tenant);
+    return it != limits.end() ? it->second : defaultLimits;
+}
+
+Status Tenants::admit(const std::string& tenant, std::chrono::steady_clock::time_point now) {
+    if (!enabled) {
+        return StatusCode::OK;
+    }
+    const TenantLimits& tenantLimits = getLimits(tenant);
+    if (tenantLimits.requestsPerSecond == 0) {
+        return StatusCode::OK;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = buckets.find(tenant);
+    if (it == buckets.end()) {
+        // client chosen tenant names must not grow the map without bound
+        const std::string& key = (buckets.size() < MAX_TRACKED_TENANTS || limits.count(tenant) > 0) ? tenant : DEFAULT_TENANT;
+        const TenantLimits& keyLimits = getLimits(key);
+        it = buckets.emplace(key, TokenBucket(keyLimits.requestsPerSecond, keyLimits.burst, now)).first;
+    }
+    if (!it->second.tryTake(now)) {
+        SPDLOG_DEBUG("Request of tenant {} exceeded its rate limit", tenant);
+        return StatusCode::TENANT_RATE_LIMITED;
+    }
+    return StatusCode::OK;
+}
+
+double FairShareQueue::assignStartTag(const std::string& tenant, uint32_t weight) {
+    if (finishTags.size() >= MAX_TRACKED_TENANTS && finishTags.count(tenant) == 0) {
+        // tenants not active since virtual time passed their finish tags start from virtual time anyway
+        for (auto it = finishTags.begin(); it != finishTags.end();) {
+            it = it->second <= virtualTime ? finishTags.erase(it) : std::next(it);
+        }
+    }
+    double& finishTag = finishTags[tenant];
+    const double startTag = std::max(virtualTime, finishTag);
+    finishTag = startTag + 1.0 / std::max<uint32_t>(1, weight);
+    return startTag;
+}
+
+Status FairShareQueue::acquire(const std::string& tenant, uint32_t weight, std::optional<std::chrono::steady_clock::time_point> deadline) {
+    std::unique_lock<std::mutex> lock(mtx);
+    const double startTag = assignStartTag(tenant, weight);
+    if (freeSlots > 0 && waiting.empty()) {
+        --freeSlots;
+        virtualTime = startTag;
+        return StatusCode::OK;
+    }
+    const auto key = std::make_pair(startTag, nextSequence++);
+    waiting.insert(key);
+    auto isGranted = [this, &key]() { return freeSlots > 0 && *waiting.begin() == key; };
+    if (deadline) {
+        if (!slotReleased.wait_until(lock, deadline.value(), isGranted)) {
+            waiting.erase(key);
+            // the next request may be able to take the free slot instead
+            slotReleased.notify_all();
+            return StatusCode::DEADLINE_EXCEEDED;
+        }
+    } else {
+        slotReleased.wait(lock, isGranted);
+    }
+    waiting.erase(key);
+    --freeSlots;
+    virtualTime = startTag;
+    if (freeSlots > 0 && !waiting.empty()) {
+        slotReleased.notify_all();
+    }
+    return StatusCode::OK;
+}
+
+bool FairShareQueue::tryAcquire(const std::string& tenant, uint32_t weight) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (freeSlots == 0 || !waiting.empty()) {
+        return false;
+    }
+    // tenant is charged only for slots it gets
+    virtualTime = assignStartTag(tenant, weight);
+    --freeSlots;
+    return true;
+}
+
+void FairShareQueue::release() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++freeSlots;
+    }
+    slotReleased.notify_all();
+}
+
+}  // namespace ovms
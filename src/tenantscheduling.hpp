@@ -0,0 +1,189 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief gRPC metadata key or HTTP header identifying tenant of predict request, requests without it belong to default tenant
+ */
+extern const std::string REQUEST_TENANT_HEADER;
+
+/**
+ * @brief Tenants tracked separately, tenants above it share limits state of default tenant
+ */
+const size_t MAX_TRACKED_TENANTS = 1024;
+
+/**
+ * @brief Request rate limit and fair share weight of a tenant
+ */
+struct TenantLimits {
+    /**
+     * @brief Allowed requests per second, 0 means no limit
+     */
+    double requestsPerSecond = 0;
+
+    /**
+     * @brief Requests allowed at once above the rate, at least one
+     */
+    double burst = 1;
+
+    /**
+     * @brief Share of infer requests of a model given to the tenant when tenants compete for them
+     */
+    uint32_t weight = 1;
+};
+
+/**
+ * @brief Token bucket refilled with requestsPerSecond tokens per second up to burst tokens
+ */
+class TokenBucket {
+public:
+    TokenBucket(double rate, double burst, std::chrono::steady_clock::time_point now) :
+        rate(rate),
+        burst(burst),
+        tokens(burst),
+        lastRefill(now) {}
+
+    /**
+     * @brief Takes one token if available
+     */
+    bool tryTake(std::chrono::steady_clock::time_point now);
+
+private:
+    const double rate;
+    const double burst;
+    double tokens;
+    std::chrono::steady_clock::time_point lastRefill;
+};
+
+/**
+ * @brief Limits of tenants sharing the server, configured with --tenant_limits
+ *
+ * Tenants without their own limits get default ones, each with its own bucket.
+ */
+class Tenants {
+public:
+    static Tenants& getInstance() {
+        static Tenants instance;
+        return instance;
+    }
+
+    /**
+     * @brief Parses comma separated list of tenant=rate:burst:weight entries, tenant named default sets default limits
+     *
+     * Burst and weight can be omitted. Empty list disables tenant limits.
+     */
+    Status configure(const std::string& limits);
+
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Admits request of the tenant if its rate limit allows it
+     *
+     * @return OK or TENANT_RATE_LIMITED
+     */
+    Status admit(const std::string& tenant, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    const TenantLimits& getLimits(const std::string& tenant) const;
+
+    uint32_t getWeight(const std::string& tenant) const { return getLimits(tenant).weight; }
+
+private:
+    Tenants() = default;
+
+    bool enabled = false;
+    TenantLimits defaultLimits;
+    std::map<std::string, TenantLimits> limits;
+
+    std::mutex mtx;
+    std::unordered_map<std::string, TokenBucket> buckets;
+};
+
+/**
+ * @brief Hands out a fixed number of slots to waiting requests in weighted fair order of their tenants
+ *
+ * Start-time fair queuing: every request gets a start tag not lower than the virtual time nor the finish tag of
+ * previous request of its tenant, and advances the finish tag of its tenant by inverse of its weight.
+ * Requests are granted in order of start tags, so a tenant sending many requests does not delay others.
+ */
+class FairShareQueue {
+public:
+    explicit FairShareQueue(size_t slots) :
+        freeSlots(slots),
+        slots(slots) {}
+
+    /**
+     * @brief Waits for a slot until deadline
+     *
+     * @return OK or DEADLINE_EXCEEDED
+     */
+    Status acquire(const std::string& tenant, uint32_t weight, std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt);
+
+    /**
+     * @brief Takes a slot only if one is free and no request waits for it, without waiting
+     */
+    bool tryAcquire(const std::string& tenant, uint32_t weight);
+
+    void release();
+
+    size_t getSlots() const { return slots; }
+
+private:
+    double assignStartTag(const std::string& tenant, uint32_t weight);
+
+    std::mutex mtx;
+    std::condition_variable slotReleased;
+    size_t freeSlots;
+    const size_t slots;
+    double virtualTime = 0;
+    uint64_t nextSequence = 0;
+    std::unordered_map<std::string, double> finishTags;
+    // start tag and arrival sequence of waiting requests
+    std::set<std::pair<double, uint64_t>> waiting;
+};
+
+/**
+ * @brief Releases slot of fair share queue when destroyed
+ */
+class FairShareSlotGuard {
+public:
+    explicit FairShareSlotGuard(FairShareQueue& queue) :
+        queue(queue) {}
+    ~FairShareSlotGuard() {
+        queue.release();
+    }
+    FairShareSlotGuard(const FairShareSlotGuard&) = delete;
+    FairShareSlotGuard& operator=(const FairShareSlotGuard&) = delete;
+
+private:
+    FairShareQueue& queue;
+};
+
+}  // namespace ovms
@@ -0,0 +1,175 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "tensorbufferpool.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+
+#include "metrics.hpp"
+
+namespace ovms {
+
+namespace {
+// placed in front of buffers smaller than huge page, keeps buffer aligned
+struct alignas(TensorBufferPool::ALIGNMENT) BufferHeader {
+    uint32_t sizeClass;
+};
+
+const uint32_t UNPOOLED_SIZE_CLASS = UINT32_MAX;
+
+uint32_t getSizeClass(size_t size) {
+    uint32_t sizeClass = 0;
+    while ((size_t(1) << (sizeClass + TensorBufferPool::MIN_SIZE_CLASS_SHIFT)) < size) {
+        if (++sizeClass == TensorBufferPool::SIZE_CLASSES_COUNT) {
+            return UNPOOLED_SIZE_CLASS;
+        }
+    }
+    return sizeClass;
+}
+
+size_t getSizeClassSize(uint32_t sizeClass) {
+    return size_t(1) << (sizeClass + TensorBufferPool::MIN_SIZE_CLASS_SHIFT);
+}
+
+BufferHeader* getHeader(void* buffer) {
+    return static_cast<BufferHeader*>(buffer) - 1;
+}
+
+bool isHugePageAligned(void* buffer) {
+    return reinterpret_cast<uintptr_t>(buffer) % TensorBufferPool::HUGE_PAGE_SIZE == 0;
+}
+}  // namespace
+
+void* TensorBufferPool::allocateBuffer(uint32_t sizeClass, size_t size) {
+    if (size < HUGE_PAGE_SIZE) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, ALIGNMENT, sizeof(BufferHeader) + size) != 0) {
+            return nullptr;
+        }
+        auto header = static_cast<BufferHeader*>(memory);
+        header->sizeClass = sizeClass;
+        return header + 1;
+    }
+    // header in front would break alignment and spill into another huge page, size class is kept aside
+    void* memory = nullptr;
+    if (posix_memalign(&memory, HUGE_PAGE_SIZE, size) != 0) {
+        return nullptr;
+    }
+    // hint only, it is ignored if transparent huge pages are disabled
+    madvise(memory, size, MADV_HUGEPAGE);
+    std::lock_guard<std::mutex> lock(hugeBuffersMtx);
+    hugeBufferSizeClasses.emplace(memory, sizeClass);
+    return memory;
+}
+
+uint32_t TensorBufferPool::getBufferSizeClass(void* buffer) {
+    // buffers with header are huge page aligned only by chance, others are looked up
+    if (isHugePageAligned(buffer)) {
+        std::lock_guard<std::mutex> lock(hugeBuffersMtx);
+        auto it = hugeBufferSizeClasses.find(buffer);
+        if (it != hugeBufferSizeClasses.end()) {
+            return it->second;
+        }
+    }
+    return getHeader(buffer)->sizeClass;
+}
+
+void TensorBufferPool::freeBuffer(void* buffer) {
+    if (isHugePageAligned(buffer)) {
+        std::lock_guard<std::mutex> lock(hugeBuffersMtx);
+        if (hugeBufferSizeClasses.erase(buffer) > 0) {
+            std::free(buffer);
+            return;
+        }
+    }
+    std::free(getHeader(buffer));
+}
+
+TensorBufferPool::TensorBufferPool() :
+    hits(MetricsRegistry::getInstance().counter("ovms_tensor_buffer_pool_allocations_total", "Tensor buffers allocated from the pool", {{"result", "hit"}})),
+    misses(MetricsRegistry::getInstance().counter("ovms_tensor_buffer_pool_allocations_total", "Tensor buffers allocated from the pool", {{"result", "miss"}})),
+    pooledBytesGauge(MetricsRegistry::getInstance().gauge("ovms_tensor_buffer_pool_bytes", "Memory of idle tensor buffers kept for reuse")) {}
+
+size_t TensorBufferPool::getSizeClassBytes(size_t size) {
+    auto sizeClass = getSizeClass(size);
+    return sizeClass == UNPOOLED_SIZE_CLASS ? 0 : getSizeClassSize(sizeClass);
+}
+
+void TensorBufferPool::setMaxPooledBytes(size_t maxPooledBytes) {
+    this->maxPooledBytes.store(maxPooledBytes, std::memory_order_relaxed);
+    if (getPooledBytes() > maxPooledBytes) {
+        freeIdleBuffers();
+    }
+}
+
+void* TensorBufferPool::allocate(size_t size) {
+    const uint32_t sizeClass = getSizeClass(size);
+    if (sizeClass == UNPOOLED_SIZE_CLASS) {
+        return allocateBuffer(UNPOOLED_SIZE_CLASS, size);
+    }
+    auto& pooled = sizeClasses[sizeClass];
+    {
+        std::lock_guard<std::mutex> lock(pooled.mtx);
+        if (!pooled.idleBuffers.empty()) {
+            void* buffer = pooled.idleBuffers.back();
+            pooled.idleBuffers.pop_back();
+            pooledBytes.fetch_sub(getSizeClassSize(sizeClass), std::memory_order_relaxed);
+            pooledBytesGauge.decrement(getSizeClassSize(sizeClass));
+            hits.increment();
+            return buffer;
+        }
+    }
+    misses.increment();
+    return allocateBuffer(sizeClass, getSizeClassSize(sizeClass));
+}
+
+void TensorBufferPool::release(void* buffer) {
+    if (buffer == nullptr) {
+        return;
+    }
+    const uint32_t sizeClass = getBufferSizeClass(buffer);
+    if (sizeClass != UNPOOLED_SIZE_CLASS) {
+        const size_t size = getSizeClassSize(sizeClass);
+        if (pooledBytes.fetch_add(size, std::memory_order_relaxed) + size <= getMaxPooledBytes()) {
+            auto& pooled = sizeClasses[sizeClass];
+            std::lock_guard<std::mutex> lock(pooled.mtx);
+            pooled.idleBuffers.push_back(buffer);
+            pooledBytesGauge.increment(size);
+            return;
+        }
+        pooledBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+    freeBuffer(buffer);
+}
+
+void TensorBufferPool::freeIdleBuffers() {
+    for (size_t sizeClass = 0; sizeClass < SIZE_CLASSES_COUNT; ++sizeClass) {
+        auto& pooled = sizeClasses[sizeClass];
+        std::lock_guard<std::mutex> lock(pooled.mtx);
+        for (void* buffer : pooled.idleBuffers) {
+            freeBuffer(buffer);
+        }
+        const size_t size = getSizeClassSize(sizeClass) * pooled.idleBuffers.size();
+        pooledBytes.fetch_sub(size, std::memory_order_relaxed);
+        pooledBytesGauge.decrement(size);
+        pooled.idleBuffers.clear();
+    }
+}
+
+}  // namespace ovms
@@ -0,0 +1,108 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ovms {
+
+class Counter;
+class Gauge;
+
+/**
+ * @brief Pool of tensor buffers in power of two size classes, reused instead of returning them to malloc
+ *
+ * Buffers are 64 byte aligned. Buffers of 2 MB and more are aligned to 2 MB and advised for transparent huge pages.
+ * Each size class has its own lock, idle buffers of all classes together are limited by max pooled bytes.
+ */
+class TensorBufferPool {
+public:
+    static const size_t MIN_SIZE_CLASS_SHIFT = 8;
+    static const size_t MAX_SIZE_CLASS_SHIFT = 30;
+    static const size_t SIZE_CLASSES_COUNT = MAX_SIZE_CLASS_SHIFT - MIN_SIZE_CLASS_SHIFT + 1;
+    static const size_t ALIGNMENT = 64;
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    /**
+     * @brief Pool is never destroyed, blobs may be released during destruction of other static objects
+     */
+    static TensorBufferPool& getInstance() {
+        static TensorBufferPool* instance = new TensorBufferPool();
+        return *instance;
+    }
+
+    /**
+     * @brief Creates pool keeping no idle buffers until max pooled bytes are set, metrics are shared by all pools
+     */
+    TensorBufferPool();
+
+    /**
+     * @brief Limits memory of idle buffers, 0 disables pooling, buffers above the limit are freed
+     */
+    void setMaxPooledBytes(size_t maxPooledBytes);
+
+    size_t getMaxPooledBytes() const {
+        return maxPooledBytes.load(std::memory_order_relaxed);
+    }
+
+    size_t getPooledBytes() const {
+        return pooledBytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return buffer of at least size bytes or nullptr if memory could not be allocated
+     */
+    void* allocate(size_t size);
+
+    void release(void* buffer);
+
+    /**
+     * @brief Size of buffers in the size class holding size bytes
+     *
+     * @return size class bytes or 0 if buffers of that size are not pooled
+     */
+    static size_t getSizeClassBytes(size_t size);
+
+private:
+    struct SizeClass {
+        std::mutex mtx;
+        std::vector<void*> idleBuffers;
+    };
+
+    void freeIdleBuffers();
+
+    void* allocateBuffer(uint32_t sizeClass, size_t size);
+    uint32_t getBufferSizeClass(void* buffer);
+    void freeBuffer(void* buffer);
+
+    std::array<SizeClass, SIZE_CLASSES_COUNT> sizeClasses;
+    std::atomic<size_t> maxPooledBytes{0};
+    std::atomic<size_t> pooledBytes{0};
+    // size classes of huge page aligned buffers, which have no header
+    std::mutex hugeBuffersMtx;
+    std::unordered_map<void*, uint32_t> hugeBufferSizeClasses;
+    Counter& hits;
+    Counter& misses;
+    Gauge& pooledBytesGauge;
+};
+
+}  // namespace ovms
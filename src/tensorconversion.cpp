@@ -0,0 +1,297 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "tensorconversion.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define OVMS_X86_SIMD
+#endif
+
+namespace ovms {
+
+namespace {
+
+void narrowToUint16Scalar(const int32_t* source, uint16_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = static_cast<uint16_t>(source[i]);
+    }
+}
+
+void widenToUint32Scalar(const uint16_t* source, uint32_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = source[i];
+    }
+}
+
+uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bitsToFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t floatToHalfValue(float value) {
+    const uint32_t F16_MAX = (127 + 16) << 23;
+    const uint32_t F32_INFINITY = 255 << 23;
+    const uint32_t MIN_NORMAL = 113 << 23;
+    // adding it to a value below half normal range leaves the rounded half subnormal in lower mantissa bits
+    const uint32_t DENORMAL_MAGIC = ((127 - 15) + (23 - 10) + 1) << 23;
+    uint32_t bits = floatBits(value);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+    uint32_t half;
+    if (bits >= F16_MAX) {
+        half = bits > F32_INFINITY ? 0x7E00 : 0x7C00;
+    } else if (bits < MIN_NORMAL) {
+        half = floatBits(bitsToFloat(bits) + bitsToFloat(DENORMAL_MAGIC)) - DENORMAL_MAGIC;
+    } else {
+        const uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + mantissaOdd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+uint16_t floatToBfloat16Value(float value) {
+    const uint32_t bits = floatBits(value);
+    if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+        // keeps NaN a quiet NaN after the mantissa is truncated
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    }
+    return static_cast<uint16_t>((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+}
+
+void floatToHalfScalar(const float* source, uint16_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = floatToHalfValue(source[i]);
+    }
+}
+
+void floatToBfloat16Scalar(const float* source, uint16_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = floatToBfloat16Value(source[i]);
+    }
+}
+
+#ifdef OVMS_X86_SIMD
+__attribute__((target("avx2,f16c"))) void floatToHalfAvx2(const float* source, uint16_t* destination, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i converted = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), converted);
+    }
+    floatToHalfScalar(source + i, destination + i, count - i);
+}
+
+__attribute__((target("avx512f"))) void floatToHalfAvx512(const float* source, uint16_t* destination, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i converted = _mm512_cvtps_ph(_mm512_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), converted);
+    }
+    floatToHalfScalar(source + i, destination + i, count - i);
+}
+
+__attribute__((target("avx2"))) __m256i floatToBfloat16Avx2(__m256i bits) {
+    const __m256i absMask = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i infinity = _mm256_set1_epi32(0x7F800000);
+    __m256i leastSignificantBit = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(_mm256_set1_epi32(0x7FFF), leastSignificantBit)), 16);
+    __m256i quietNan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x40));
+    __m256i isNan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, absMask), infinity);
+    return _mm256_blendv_epi8(rounded, quietNan, isNan);
+}
+
+__attribute__((target("avx2"))) void floatToBfloat16Avx2(const float* source, uint16_t* destination, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i first = floatToBfloat16Avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)));
+        __m256i second = floatToBfloat16Avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 8)));
+        // packing works within 128 bit lanes, restore element order afterwards
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(first, second), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), packed);
+    }
+    floatToBfloat16Scalar(source + i, destination + i, count - i);
+}
+
+__attribute__((target("avx2"))) void narrowToUint16Avx2(const int32_t* source, uint16_t* destination, size_t count) {
+    const __m256i lowerHalfMask = _mm256_set1_epi32(0xFFFF);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i first = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)), lowerHalfMask);
+        __m256i second = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 8)), lowerHalfMask);
+        // packing works within 128 bit lanes, restore element order afterwards
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(first, second), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), packed);
+    }
+    narrowToUint16Scalar(source + i, destination + i, count - i);
+}
+
+__attribute__((target("avx2"))) void widenToUint32Avx2(const uint16_t* source, uint32_t* destination, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i widened = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), widened);
+    }
+    widenToUint32Scalar(source + i, destination + i, count - i);
+}
+
+__attribute__((target("avx512f"))) void narrowToUint16Avx512(const int32_t* source, uint16_t* destination, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i narrowed = _mm512_cvtepi32_epi16(_mm512_loadu_si512(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), narrowed);
+    }
+    narrowToUint16Scalar(source + i, destination + i, count - i);
+}
+
+__attribute__((target("avx512f"))) void widenToUint32Avx512(const uint16_t* source, uint32_t* destination, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i widened = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)));
+        _mm512_storeu_si512(destination + i, widened);
+    }
+    widenToUint32Scalar(source + i, destination + i, count - i);
+}
+#endif
+
+SimdLevel detectSimdLevel() {
+#ifdef OVMS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+bool detectF16c() {
+#ifdef OVMS_X86_SIMD
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("f16c");
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+SimdLevel getSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+void narrowToUint16(const int32_t* source, uint16_t* destination, size_t count) {
+    narrowToUint16(source, destination, count, getSimdLevel());
+}
+
+void narrowToUint16(const int32_t* source, uint16_t* destination, size_t count, SimdLevel level) {
+    switch (level) {
+#ifdef OVMS_X86_SIMD
+    case SimdLevel::AVX512:
+        return narrowToUint16Avx512(source, destination, count);
+    case SimdLevel::AVX2:
+        return narrowToUint16Avx2(source, destination, count);
+#endif
+    default:
+        return narrowToUint16Scalar(source, destination, count);
+    }
+}
+
+void widenToUint32(const uint16_t* source, uint32_t* destination, size_t count) {
+    widenToUint32(source, destination, count, getSimdLevel());
+}
+
+void widenToUint32(const uint16_t* source, uint32_t* destination, size_t count, SimdLevel level) {
+    switch (level) {
+#ifdef OVMS_X86_SIMD
+    case SimdLevel::AVX512:
+        return widenToUint32Avx512(source, destination, count);
+    case SimdLevel::AVX2:
+        return widenToUint32Avx2(source, destination, count);
+#endif
+    default:
+        return widenToUint32Scalar(source, destination, count);
+    }
+}
+
+void floatToHalf(const float* source, uint16_t* destination, size_t count) {
+    floatToHalf(source, destination, count, getSimdLevel());
+}
+
+void floatToHalf(const float* source, uint16_t* destination, size_t count, SimdLevel level) {
+    static const bool f16c = detectF16c();
+    switch (level) {
+#ifdef OVMS_X86_SIMD
+    case SimdLevel::AVX512:
+        return floatToHalfAvx512(source, destination, count);
+    case SimdLevel::AVX2:
+        if (f16c) {
+            return floatToHalfAvx2(source, destination, count);
+        }
+        return floatToHalfScalar(source, destination, count);
+#endif
+    default:
+        return floatToHalfScalar(source, destination, count);
+    }
+}
+
+void floatToBfloat16(const float* source, uint16_t* destination, size_t count) {
+    floatToBfloat16(source, destination, count, getSimdLevel());
+}
+
+void floatToBfloat16(const float* source, uint16_t* destination, size_t count, SimdLevel level) {
+    switch (level) {
+#ifdef OVMS_X86_SIMD
+    case SimdLevel::AVX512:
+    case SimdLevel::AVX2:
+        return floatToBfloat16Avx2(source, destination, count);
+#endif
+    default:
+        return floatToBfloat16Scalar(source, destination, count);
+    }
+}
+
+float halfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+    if (exponent == 0) {
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 0x1F) {
+        return bitsToFloat(sign | 0x7F800000 | (mantissa << 13));
+    }
+    return bitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+float bfloat16ToFloat(uint16_t value) {
+    return bitsToFloat(static_cast<uint32_t>(value) << 16);
+}
+
+}  // namespace ovms
@@ -0,0 +1,64 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ovms {
+
+/**
+ * @brief Instruction set used by tensor conversion kernels
+ */
+enum class SimdLevel {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Best instruction set supported by the CPU, detected once
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Narrows 4 byte proto values (half_val, int_val) to 2 byte blob values, upper bytes are dropped
+ */
+void narrowToUint16(const int32_t* source, uint16_t* destination, size_t count);
+void narrowToUint16(const int32_t* source, uint16_t* destination, size_t count, SimdLevel level);
+
+/**
+ * @brief Widens 2 byte blob values to zero padded 4 byte proto values
+ */
+void widenToUint32(const uint16_t* source, uint32_t* destination, size_t count);
+void widenToUint32(const uint16_t* source, uint32_t* destination, size_t count, SimdLevel level);
+
+/**
+ * @brief Converts floats to IEEE half precision, rounding to nearest even
+ */
+void floatToHalf(const float* source, uint16_t* destination, size_t count);
+void floatToHalf(const float* source, uint16_t* destination, size_t count, SimdLevel level);
+
+/**
+ * @brief Converts floats to bfloat16, keeping upper 16 bits rounded to nearest even
+ */
+void floatToBfloat16(const float* source, uint16_t* destination, size_t count);
+void floatToBfloat16(const float* source, uint16_t* destination, size_t count, SimdLevel level);
+
+float halfToFloat(uint16_t value);
+float bfloat16ToFloat(uint16_t value);
+
+}  // namespace ovms
@@ -27,6 +27,35 @@
 
 namespace ovms {
 
+class TensorInfo;
+
+/**
+ * @brief Creates input blob from request input, on tensor_content memory when no conversion is needed
+ */
+using blob_deserializer_t = InferenceEngine::Blob::Ptr (*)(const tensorflow::TensorProto& requestInput, const TensorInfo& tensorInfo);
+
+/**
+ * @brief Writes request input into blob allocated by plugin
+ */
+using preallocated_blob_deserializer_t = void (*)(const tensorflow::TensorProto& requestInput, InferenceEngine::Blob& blob);
+
+/**
+ * @brief Deserializer variants of one precision, for inputs sent packed in tensor_content and in typed proto fields
+ *
+ * Null when precision is not supported by deserialization.
+ */
+struct TensorDeserializers {
+    blob_deserializer_t fromContent = nullptr;
+    blob_deserializer_t fromValues = nullptr;
+    preallocated_blob_deserializer_t copyContent = nullptr;
+    preallocated_blob_deserializer_t copyValues = nullptr;
+};
+
+/**
+ * @brief Resolves deserializers for precision, called once when tensor precision is set
+ */
+TensorDeserializers getTensorDeserializers(InferenceEngine::Precision precision);
+
 /**
      * @brief Class containing information about the tensor
      */
@@ -55,13 +84,33 @@ protected:
     /**
          * @brief Tensor layout
          */
-    InferenceEngine::Layout layout;
+    InferenceEngine::Layout layout = InferenceEngine::Layout::ANY;
 
     /**
-         * @brief TensorDesc
+         * @brief TensorDesc of precision, shape and layout, built once instead of for each request blob
          */
     InferenceEngine::TensorDesc tensorDesc;
 
+    /**
+         * @brief False if layout does not match shape and TensorDesc cannot be built
+         */
+    bool tensorDescBuilt = false;
+
+    /**
+         * @brief Deserializers of precision, resolved at model load so that requests do not dispatch on precision
+         */
+    TensorDeserializers deserializers;
+
+    void buildTensorDesc() {
+        deserializers = getTensorDeserializers(precision);
+        try {
+            tensorDesc = InferenceEngine::TensorDesc{precision, shape, layout};
+            tensorDescBuilt = true;
+        } catch (const InferenceEngine::details::InferenceEngineException&) {
+            tensorDescBuilt = false;
+        }
+    }
+
 public:
     /**
          * @brief Construct a new Tensor Info object
@@ -82,7 +131,9 @@ public:
         name(name),
         mapping(""),
         precision(precision),
-        shape(shape) {}
+        shape(shape) {
+        buildTensorDesc();
+    }
 
     /**
          * @brief Construct a new Tensor Info object
@@ -101,7 +152,9 @@ public:
         mapping(""),
         precision(precision),
         shape(shape),
-        layout(layout) {}
+        layout(layout) {
+        buildTensorDesc();
+    }
 
     /**
          * @brief Construct a new Tensor Info object
@@ -120,7 +173,9 @@ public:
         mapping(mapping),
         precision(precision),
         shape(shape),
-        layout(layout) {}
+        layout(layout) {
+        buildTensorDesc();
+    }
 
     /**
          * @brief Get the Name object
@@ -156,6 +211,16 @@ public:
          */
     void setPrecision(const InferenceEngine::Precision& requestedPrecision) {
         precision = requestedPrecision;
+        buildTensorDesc();
+    }
+
+    /**
+         * @brief Get deserializers resolved for tensor precision
+         *
+         * @return const TensorDeserializers&
+         */
+    const TensorDeserializers& getDeserializers() const {
+        return deserializers;
     }
 
     /**
@@ -224,6 +289,8 @@ public:
             return "I32";
         case InferenceEngine::Precision::I64:
             return "I64";
+        case InferenceEngine::Precision::U64:
+            return "U64";
         case InferenceEngine::Precision::BOOL:
             return "BOOL";
         default:
@@ -231,6 +298,30 @@ public:
         }
     }
 
+    /**
+         * @brief Get the InferenceEngine Precision from string
+         *
+         * @param precision
+         * @return InferenceEngine::Precision, UNSPECIFIED if not supported by deserialization
+         */
+    static InferenceEngine::Precision getPrecisionFromString(const std::string& precision) {
+        if (precision == "FP32")
+            return InferenceEngine::Precision::FP32;
+        if (precision == "FP16")
+            return InferenceEngine::Precision::FP16;
+        if (precision == "U8")
+            return InferenceEngine::Precision::U8;
+        if (precision == "I8")
+            return InferenceEngine::Precision::I8;
+        if (precision == "U16")
+            return InferenceEngine::Precision::U16;
+        if (precision == "I16")
+            return InferenceEngine::Precision::I16;
+        if (precision == "I32")
+            return InferenceEngine::Precision::I32;
+        return InferenceEngine::Precision::UNSPECIFIED;
+    }
+
     static const std::string getDataTypeAsString(tensorflow::DataType dataType) {
         switch (dataType) {
         case tensorflow::DataType::DT_FLOAT:
@@ -368,8 +459,12 @@ public:
          * 
          * @return const InferenceEngine::TensorDesc& 
          */
-    const InferenceEngine::TensorDesc getTensorDesc() const {
-        return InferenceEngine::TensorDesc{precision, shape, layout};
+    const InferenceEngine::TensorDesc& getTensorDesc() const {
+        if (!tensorDescBuilt) {
+            // throws the error of mismatched layout, as when TensorDesc was not cached
+            InferenceEngine::TensorDesc{precision, shape, layout};
+        }
+        return tensorDesc;
     }
 
     static std::string shapeToString(const shape_t& shape) {
@@ -0,0 +1,78 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../autotuning.hpp"
+
+using namespace ovms;
+
+TEST(AutoTuning, CandidatesArePowersOfTwoStreamsUpToCpus) {
+    EXPECT_EQ(generateTuningCandidates(1), (std::vector<TuningCandidate>{{1, 1}, {1, 2}}));
+    EXPECT_EQ(generateTuningCandidates(6), (std::vector<TuningCandidate>{{1, 1}, {1, 2}, {2, 2}, {2, 4}, {4, 4}, {4, 8}}));
+    EXPECT_EQ(generateTuningCandidates(0), (std::vector<TuningCandidate>{{1, 1}, {1, 2}}));
+}
+
+TEST(AutoTuning, ChoosesHighestThroughputWithinLatencySlo) {
+    std::vector<TuningMeasurement> measurements{
+        {{1, 1}, 100, 10},
+        {{2, 4}, 300, 25},
+        {{4, 8}, 400, 60}};
+    EXPECT_EQ(chooseTuningCandidate(measurements, 0), (TuningCandidate{4, 8}));
+    EXPECT_EQ(chooseTuningCandidate(measurements, 50), (TuningCandidate{2, 4}));
+    // none meets the SLO, lowest latency is chosen
+    EXPECT_EQ(chooseTuningCandidate(measurements, 5), (TuningCandidate{1, 1}));
+    EXPECT_FALSE(chooseTuningCandidate({}, 5).has_value());
+}
+
+class AutoTuningResultTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove_all(versionDir);
+        std::filesystem::create_directories(versionDir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(versionDir);
+    }
+
+    const std::string versionDir = "/tmp/ovms_auto_tuning_test/1";
+};
+
+TEST_F(AutoTuningResultTest, SavedResultIsLoadedForSameDescription) {
+    EXPECT_FALSE(loadTuningResult(versionDir, "CPU;8").has_value());
+    ASSERT_TRUE(saveTuningResult(versionDir, "CPU;8", {4, 8}));
+    EXPECT_EQ(loadTuningResult(versionDir, "CPU;8"), (TuningCandidate{4, 8}));
+    EXPECT_FALSE(loadTuningResult(versionDir, "CPU;16").has_value());
+    ASSERT_TRUE(saveTuningResult(versionDir, "CPU;16", {8, 8}));
+    EXPECT_EQ(loadTuningResult(versionDir, "CPU;16"), (TuningCandidate{8, 8}));
+    EXPECT_FALSE(loadTuningResult(versionDir, "CPU;8").has_value());
+}
+
+TEST_F(AutoTuningResultTest, MalformedResultIsIgnored) {
+    std::ofstream(versionDir + "/" + TUNING_RESULT_FILE_NAME) << R"({"description": "CPU;8", "streams": "4"})";
+    EXPECT_FALSE(loadTuningResult(versionDir, "CPU;8").has_value());
+    std::ofstream(versionDir + "/" + TUNING_RESULT_FILE_NAME) << "not json";
+    EXPECT_FALSE(loadTuningResult(versionDir, "CPU;8").has_value());
+}
+
+TEST_F(AutoTuningResultTest, SaveFailsInMissingDirectory) {
+    EXPECT_FALSE(saveTuningResult(versionDir + "/missing", "CPU;8", {4, 8}));
+}
@@ -0,0 +1,165 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../batchingscheduler.hpp"
+#include "../modelinstance.hpp"
+#include "../modelinstanceunloadguard.hpp"
+#include "../prediction_service_utils.hpp"
+#include "test_utils.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+using testing::Eq;
+
+namespace {
+tensorflow::serving::PredictRequest prepareDummyRequest(float value) {
+    tensorflow::serving::PredictRequest request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME,
+            std::tuple<ovms::shape_t, tensorflow::DataType>{{1, DUMMY_MODEL_INPUT_SIZE}, tensorflow::DataType::DT_FLOAT}}});
+    std::vector<float> data(DUMMY_MODEL_INPUT_SIZE, value);
+    (*request.mutable_inputs())[DUMMY_MODEL_INPUT_NAME].mutable_tensor_content()->assign(
+        reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+    return request;
+}
+
+ovms::BlobMap prepareDummyNodeInputs(float value) {
+    InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, DUMMY_MODEL_INPUT_SIZE}, InferenceEngine::Layout::NC};
+    auto blob = InferenceEngine::make_shared_blob<float>(desc);
+    blob->allocate();
+    std::fill_n(blob->buffer().as<float*>(), DUMMY_MODEL_INPUT_SIZE, value);
+    return {{DUMMY_MODEL_INPUT_NAME, blob}};
+}
+}  // namespace
+
+class TestBatchingScheduler : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config = DUMMY_MODEL_CONFIG;
+        config.setBatchingParams(0);
+        config.setNireq(2);
+        config.setMaxBatchSize(4);
+    }
+
+    ovms::ModelConfig config;
+};
+
+TEST_F(TestBatchingScheduler, BatchableRequest) {
+    auto request = prepareDummyRequest(1.0);
+    EXPECT_TRUE(ovms::BatchingScheduler::isRequestBatchable(&request));
+    request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME,
+            std::tuple<ovms::shape_t, tensorflow::DataType>{{2, DUMMY_MODEL_INPUT_SIZE}, tensorflow::DataType::DT_FLOAT}}});
+    EXPECT_FALSE(ovms::BatchingScheduler::isRequestBatchable(&request));
+}
+
+TEST_F(TestBatchingScheduler, NetworkLoadedWithMaxBatchSize) {
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.getBatchSize(), 4);
+    ASSERT_NE(modelInstance.getBatchingScheduler(), nullptr);
+    auto request = prepareDummyRequest(1.0);
+    EXPECT_EQ(modelInstance.validate(&request), ovms::StatusCode::OK);
+}
+
+TEST_F(TestBatchingScheduler, SingleRequestExecutedAfterTimeout) {
+    config.setBatchTimeoutMicroseconds(1000);
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    auto request = prepareDummyRequest(1.0);
+    tensorflow::serving::PredictResponse response;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+    ASSERT_EQ(ovms::inference(modelInstance, &request, &response, unloadGuard), ovms::StatusCode::OK);
+    auto& output = response.outputs().at(DUMMY_MODEL_OUTPUT_NAME);
+    EXPECT_THAT(asVector(output.tensor_shape()), ElementsAre(1, DUMMY_MODEL_OUTPUT_SIZE));
+    EXPECT_THAT(asVector<float>(output.tensor_content()), Each(Eq(2.)));
+}
+
+TEST_F(TestBatchingScheduler, ConcurrentRequestsGetOwnResults) {
+    const size_t numberOfRequests = 10;
+    config.setBatchTimeoutMicroseconds(100000);
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+
+    std::vector<tensorflow::serving::PredictRequest> requests;
+    for (size_t i = 0; i < numberOfRequests; i++) {
+        requests.emplace_back(prepareDummyRequest(static_cast<float>(i)));
+    }
+    std::vector<tensorflow::serving::PredictResponse> responses(numberOfRequests);
+    std::vector<ovms::Status> statuses(numberOfRequests);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numberOfRequests; i++) {
+        threads.emplace_back([&, i]() {
+            std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+            statuses[i] = ovms::inference(modelInstance, &requests[i], &responses[i], unloadGuard);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < numberOfRequests; i++) {
+        ASSERT_EQ(statuses[i], ovms::StatusCode::OK);
+        auto& output = responses[i].outputs().at(DUMMY_MODEL_OUTPUT_NAME);
+        EXPECT_THAT(asVector(output.tensor_shape()), ElementsAre(1, DUMMY_MODEL_OUTPUT_SIZE));
+        EXPECT_THAT(asVector<float>(output.tensor_content()), Each(Eq(static_cast<float>(i) + 1)));
+    }
+}
+
+TEST_F(TestBatchingScheduler, BatchableNodeInputs) {
+    EXPECT_TRUE(ovms::BatchingScheduler::areBlobsBatchable(prepareDummyNodeInputs(1.0)));
+    InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {2, DUMMY_MODEL_INPUT_SIZE}, InferenceEngine::Layout::NC};
+    ovms::BlobMap inputs{{DUMMY_MODEL_INPUT_NAME, InferenceEngine::make_shared_blob<float>(desc)}};
+    EXPECT_FALSE(ovms::BatchingScheduler::areBlobsBatchable(inputs));
+}
+
+TEST_F(TestBatchingScheduler, NodesAndRequestsMergedGetOwnResults) {
+    const size_t numberOfNodes = 6;
+    config.setBatchTimeoutMicroseconds(100000);
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    auto scheduler = modelInstance.getBatchingScheduler();
+    ASSERT_NE(scheduler, nullptr);
+
+    std::vector<std::promise<std::pair<ovms::Status, ovms::BlobMap>>> results(numberOfNodes);
+    for (size_t i = 0; i < numberOfNodes; i++) {
+        // nodes do not wait for results, batches started by nodes are executed by scheduler
+        scheduler->scheduleNode(prepareDummyNodeInputs(static_cast<float>(i)), [&results, i](const ovms::Status& status, ovms::BlobMap&& outputs) {
+            results[i].set_value({status, std::move(outputs)});
+        });
+    }
+    auto request = prepareDummyRequest(10.0);
+    tensorflow::serving::PredictResponse response;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+    ASSERT_EQ(ovms::inference(modelInstance, &request, &response, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_THAT(asVector<float>(response.outputs().at(DUMMY_MODEL_OUTPUT_NAME).tensor_content()), Each(Eq(11.)));
+
+    for (size_t i = 0; i < numberOfNodes; i++) {
+        auto result = results[i].get_future().get();
+        ASSERT_EQ(result.first, ovms::StatusCode::OK);
+        ASSERT_EQ(result.second.count(DUMMY_MODEL_OUTPUT_NAME), 1);
+        auto& blob = result.second.at(DUMMY_MODEL_OUTPUT_NAME);
+        EXPECT_THAT(blob->getTensorDesc().getDims(), ElementsAre(1, DUMMY_MODEL_OUTPUT_SIZE));
+        const float* data = blob->cbuffer().as<const float*>();
+        EXPECT_THAT(std::vector<float>(data, data + DUMMY_MODEL_OUTPUT_SIZE), Each(Eq(static_cast<float>(i) + 1)));
+    }
+}
@@ -0,0 +1,118 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../batchjobs.hpp"
+#include "../modelmanager.hpp"
+
+using namespace ovms;
+
+namespace {
+std::string createNpy(const std::string& header, const std::string& data) {
+    std::string contents("\x93NUMPY\x01\x00", 8);
+    contents.push_back(static_cast<char>(header.size() & 0xff));
+    contents.push_back(static_cast<char>(header.size() >> 8));
+    return contents + header + data;
+}
+
+std::string floatData(const std::vector<float>& values) {
+    return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+}
+}  // namespace
+
+TEST(BatchJobs, ParseNpy) {
+    auto data = floatData({0, 1, 2, 3, 4, 5});
+    tensorflow::TensorProto tensor;
+    ASSERT_EQ(parseNpy(createNpy("{'descr': '<f4', 'fortran_order': False, 'shape': (2, 3), }\n", data), tensor), StatusCode::OK);
+    EXPECT_EQ(tensor.dtype(), tensorflow::DataType::DT_FLOAT);
+    ASSERT_EQ(tensor.tensor_shape().dim_size(), 2);
+    EXPECT_EQ(tensor.tensor_shape().dim(0).size(), 2);
+    EXPECT_EQ(tensor.tensor_shape().dim(1).size(), 3);
+    EXPECT_EQ(tensor.tensor_content(), data);
+
+    ASSERT_EQ(parseNpy(createNpy("{'descr': '|u1', 'fortran_order': False, 'shape': (3,), }\n", "abc"), tensor), StatusCode::OK);
+    EXPECT_EQ(tensor.dtype(), tensorflow::DataType::DT_UINT8);
+    ASSERT_EQ(tensor.tensor_shape().dim_size(), 1);
+    EXPECT_EQ(tensor.tensor_shape().dim(0).size(), 3);
+}
+
+TEST(BatchJobs, ParseNpyRejectsUnsupportedFiles) {
+    auto data = floatData({0, 1, 2, 3, 4, 5});
+    tensorflow::TensorProto tensor;
+    EXPECT_EQ(parseNpy("not a numpy file", tensor), StatusCode::NPY_FILE_INVALID);
+    EXPECT_EQ(parseNpy(createNpy("{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3), }\n", data), tensor), StatusCode::NPY_FILE_INVALID);
+    EXPECT_EQ(parseNpy(createNpy("{'descr': '>f4', 'fortran_order': False, 'shape': (2, 3), }\n", data), tensor), StatusCode::NPY_FILE_INVALID);
+    EXPECT_EQ(parseNpy(createNpy("{'descr': '<f4', 'fortran_order': False, 'shape': (2, 4), }\n", data), tensor), StatusCode::NPY_FILE_INVALID);
+    EXPECT_EQ(parseNpy(createNpy("{'descr': '<f4', 'fortran_order': False}\n", data), tensor), StatusCode::NPY_FILE_INVALID);
+}
+
+TEST(BatchJobs, SerializeNpyRoundTrip) {
+    tensorflow::TensorProto tensor;
+    tensor.set_dtype(tensorflow::DataType::DT_FLOAT);
+    tensor.mutable_tensor_shape()->add_dim()->set_size(1);
+    tensor.mutable_tensor_shape()->add_dim()->set_size(3);
+    tensor.mutable_tensor_content()->assign(floatData({0.5, 1.5, 2.5}));
+    std::string contents;
+    ASSERT_EQ(serializeNpy(tensor, contents), StatusCode::OK);
+    const size_t headerSize = static_cast<uint8_t>(contents[8]) | (static_cast<uint8_t>(contents[9]) << 8);
+    EXPECT_EQ((10 + headerSize) % 64, 0);
+    EXPECT_EQ(contents[10 + headerSize - 1], '\n');
+
+    tensorflow::TensorProto parsed;
+    ASSERT_EQ(parseNpy(contents, parsed), StatusCode::OK);
+    EXPECT_EQ(parsed.dtype(), tensor.dtype());
+    ASSERT_EQ(parsed.tensor_shape().dim_size(), 2);
+    EXPECT_EQ(parsed.tensor_shape().dim(1).size(), 3);
+    EXPECT_EQ(parsed.tensor_content(), tensor.tensor_content());
+
+    tensor.mutable_tensor_content()->resize(4);
+    EXPECT_EQ(serializeNpy(tensor, contents), StatusCode::NPY_FILE_INVALID);
+}
+
+TEST(BatchJobs, ParseSpec) {
+    BatchJobSpec spec;
+    ASSERT_EQ(parseBatchJobSpec(R"({"model_name": "resnet", "model_version": 2, "input": "s3://bucket/images", "output": "nightly/resnet", "concurrency": 8})", spec), StatusCode::OK);
+    EXPECT_EQ(spec.servableName, "resnet");
+    EXPECT_EQ(spec.version, 2);
+    EXPECT_EQ(spec.inputPath, "s3://bucket/images");
+    EXPECT_EQ(spec.outputPath, "nightly/resnet");
+    EXPECT_EQ(spec.concurrency, 8);
+
+    BatchJobSpec defaults;
+    ASSERT_EQ(parseBatchJobSpec(R"({"model_name": "resnet", "input": "/data/images", "output": "resnet"})", defaults), StatusCode::OK);
+    EXPECT_EQ(defaults.version, 0);
+    EXPECT_EQ(defaults.concurrency, 0);
+
+    EXPECT_EQ(parseBatchJobSpec("[]", spec), StatusCode::REST_BODY_IS_NOT_AN_OBJECT);
+    EXPECT_EQ(parseBatchJobSpec(R"({"model_name": "resnet", "input": "/data/images"})", spec), StatusCode::BATCH_JOB_INVALID);
+    EXPECT_EQ(parseBatchJobSpec(R"({"model_name": "resnet", "input": "/data/images", "output": "/tmp/resnet"})", spec), StatusCode::BATCH_JOB_INVALID);
+    EXPECT_EQ(parseBatchJobSpec(R"({"model_name": "resnet", "input": "/data/images", "output": "resnet/../../etc"})", spec), StatusCode::BATCH_JOB_INVALID);
+    EXPECT_EQ(parseBatchJobSpec(R"({"model_name": "resnet", "model_version": -1, "input": "/data/images", "output": "resnet"})", spec), StatusCode::BATCH_JOB_INVALID);
+}
+
+TEST(BatchJobs, DisabledWithoutOutputPath) {
+    auto& jobs = BatchJobs::getInstance();
+    ASSERT_EQ(jobs.configure(""), StatusCode::OK);
+    EXPECT_FALSE(jobs.isEnabled());
+    std::string response;
+    EXPECT_EQ(jobs.submit(R"({"model_name": "resnet", "input": "/data/images", "output": "resnet"})", ModelManager::getInstance(), response),
+        StatusCode::BATCH_JOBS_DISABLED);
+    EXPECT_EQ(jobs.configure("s3://bucket/results"), StatusCode::PATH_INVALID);
+    EXPECT_FALSE(jobs.isEnabled());
+}
@@ -0,0 +1,87 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdint>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../blobconversion.hpp"
+#include "../tensorconversion.hpp"
+
+using namespace ovms;
+using testing::ElementsAre;
+
+namespace {
+const InferenceEngine::SizeVector SHAPE{1, 4};
+}  // namespace
+
+TEST(BlobConversion, ConvertsIntegersToFloat) {
+    std::vector<uint8_t> data{0, 1, 128, 255};
+    auto source = InferenceEngine::make_shared_blob<uint8_t>({InferenceEngine::Precision::U8, SHAPE, InferenceEngine::Layout::NC}, data.data());
+    InferenceEngine::Blob::Ptr converted;
+    ASSERT_EQ(convertBlobPrecision(source, InferenceEngine::Precision::FP32, converted), StatusCode::OK);
+    EXPECT_EQ(converted->getTensorDesc().getPrecision(), InferenceEngine::Precision::FP32);
+    EXPECT_EQ(converted->getTensorDesc().getDims(), SHAPE);
+    EXPECT_EQ(converted->getTensorDesc().getLayout(), InferenceEngine::Layout::NC);
+    const float* values = converted->cbuffer().as<const float*>();
+    EXPECT_THAT(std::vector<float>(values, values + 4), ElementsAre(0.0f, 1.0f, 128.0f, 255.0f));
+}
+
+TEST(BlobConversion, ConvertsBytesToHalf) {
+    std::vector<int8_t> data{0, 1, -128, 127};
+    auto source = InferenceEngine::make_shared_blob<int8_t>({InferenceEngine::Precision::I8, SHAPE, InferenceEngine::Layout::NC}, data.data());
+    InferenceEngine::Blob::Ptr converted;
+    ASSERT_EQ(convertBlobPrecision(source, InferenceEngine::Precision::FP16, converted), StatusCode::OK);
+    EXPECT_EQ(converted->getTensorDesc().getPrecision(), InferenceEngine::Precision::FP16);
+    const uint16_t* values = converted->cbuffer().as<const uint16_t*>();
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(halfToFloat(values[i]), static_cast<float>(data[i]));
+    }
+}
+
+TEST(BlobConversion, RejectsLossyConversions) {
+    EXPECT_FALSE(isBlobConversionSupported(InferenceEngine::Precision::FP32, InferenceEngine::Precision::U8));
+    EXPECT_FALSE(isBlobConversionSupported(InferenceEngine::Precision::I32, InferenceEngine::Precision::I16));
+    EXPECT_FALSE(isBlobConversionSupported(InferenceEngine::Precision::I64, InferenceEngine::Precision::FP16));
+    EXPECT_FALSE(isBlobConversionSupported(InferenceEngine::Precision::FP32, InferenceEngine::Precision::FP16));
+    EXPECT_FALSE(isBlobConversionSupported(InferenceEngine::Precision::I32, InferenceEngine::Precision::FP32));
+    EXPECT_FALSE(isBlobConversionSupported(InferenceEngine::Precision::I64, InferenceEngine::Precision::FP32));
+    EXPECT_TRUE(isBlobConversionSupported(InferenceEngine::Precision::I16, InferenceEngine::Precision::I32));
+    std::vector<float> data(4);
+    auto source = InferenceEngine::make_shared_blob<float>({InferenceEngine::Precision::FP32, SHAPE, InferenceEngine::Layout::NC}, data.data());
+    InferenceEngine::Blob::Ptr converted;
+    EXPECT_EQ(convertBlobPrecision(source, InferenceEngine::Precision::I32, converted), StatusCode::INVALID_PRECISION);
+}
+
+TEST(BlobConversion, CacheConvertsSourceOncePerPrecision) {
+    std::vector<uint8_t> data{1, 2, 3, 4};
+    InferenceEngine::Blob::Ptr source = InferenceEngine::make_shared_blob<uint8_t>({InferenceEngine::Precision::U8, SHAPE, InferenceEngine::Layout::NC}, data.data());
+    BlobConversionCache cache;
+    InferenceEngine::Blob::Ptr first, second, half;
+    ASSERT_EQ(cache.convert(source, InferenceEngine::Precision::FP32, first), StatusCode::OK);
+    ASSERT_EQ(cache.convert(source, InferenceEngine::Precision::FP32, second), StatusCode::OK);
+    EXPECT_EQ(first, second);
+    ASSERT_EQ(cache.convert(source, InferenceEngine::Precision::FP16, half), StatusCode::OK);
+    EXPECT_NE(first, half);
+    EXPECT_EQ(cache.size(), 2u);
+
+    InferenceEngine::Blob::Ptr other = InferenceEngine::make_shared_blob<uint8_t>({InferenceEngine::Precision::U8, SHAPE, InferenceEngine::Layout::NC}, data.data());
+    InferenceEngine::Blob::Ptr otherConverted;
+    ASSERT_EQ(cache.convert(other, InferenceEngine::Precision::FP32, otherConverted), StatusCode::OK);
+    EXPECT_NE(otherConverted, first);
+    EXPECT_EQ(cache.size(), 3u);
+}
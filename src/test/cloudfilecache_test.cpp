@@ -0,0 +1,104 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../cloudfilecache.hpp"
+
+using ovms::CloudFileCache;
+
+class CloudFileCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove_all(cacheDir);
+        std::filesystem::remove_all(modelDir);
+        std::filesystem::create_directories(modelDir);
+    }
+
+    void TearDown() override {
+        CloudFileCache::getInstance().configure("", 0);
+        std::filesystem::remove_all(cacheDir);
+        std::filesystem::remove_all(modelDir);
+    }
+
+    static void writeFile(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+
+    static std::string readFile(const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    const std::string cacheDir = "/tmp/ovms_cloud_file_cache_test";
+    const std::string modelDir = "/tmp/ovms_cloud_file_cache_test_model";
+    const std::string downloadedFile = modelDir + "/model.bin";
+    const std::string fetchedFile = modelDir + "/fetched.bin";
+    const std::string remotePath = "s3://bucket/model/1/model.bin";
+};
+
+TEST_F(CloudFileCacheTest, DisabledByDefault) {
+    auto& cache = CloudFileCache::getInstance();
+    EXPECT_FALSE(cache.isEnabled());
+    writeFile(downloadedFile, "weights");
+    cache.store(remotePath, "etag", downloadedFile);
+    EXPECT_FALSE(cache.fetch(remotePath, "etag", fetchedFile));
+}
+
+TEST_F(CloudFileCacheTest, FetchesStoredFileOfTheSameVersion) {
+    auto& cache = CloudFileCache::getInstance();
+    ASSERT_EQ(cache.configure(cacheDir, 0), ovms::StatusCode::OK);
+    writeFile(downloadedFile, "weights");
+    cache.store(remotePath, "etag1", downloadedFile);
+    EXPECT_FALSE(cache.fetch(remotePath, "etag2", fetchedFile));
+    EXPECT_FALSE(cache.fetch("s3://bucket/model/2/model.bin", "etag1", fetchedFile));
+    ASSERT_TRUE(cache.fetch(remotePath, "etag1", fetchedFile));
+    EXPECT_EQ(readFile(fetchedFile), "weights");
+}
+
+TEST_F(CloudFileCacheTest, FilesWithoutVersionAreNotCached) {
+    auto& cache = CloudFileCache::getInstance();
+    ASSERT_EQ(cache.configure(cacheDir, 0), ovms::StatusCode::OK);
+    writeFile(downloadedFile, "weights");
+    cache.store(remotePath, "", downloadedFile);
+    EXPECT_FALSE(cache.fetch(remotePath, "", fetchedFile));
+}
+
+TEST_F(CloudFileCacheTest, LeastRecentlyUsedFilesAreEvictedAboveSizeLimit) {
+    auto& cache = CloudFileCache::getInstance();
+    ASSERT_EQ(cache.configure(cacheDir, 13), ovms::StatusCode::OK);
+    writeFile(downloadedFile, "123456");
+    cache.store("s3://bucket/a.bin", "etag", downloadedFile);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    cache.store("s3://bucket/b.bin", "etag", downloadedFile);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_TRUE(cache.fetch("s3://bucket/a.bin", "etag", fetchedFile));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // a.bin was used more recently than b.bin, so b.bin is removed to fit c.bin
+    cache.store("s3://bucket/c.bin", "etag", downloadedFile);
+    EXPECT_FALSE(cache.fetch("s3://bucket/b.bin", "etag", fetchedFile));
+    EXPECT_TRUE(cache.fetch("s3://bucket/a.bin", "etag", fetchedFile));
+    EXPECT_TRUE(cache.fetch("s3://bucket/c.bin", "etag", fetchedFile));
+}
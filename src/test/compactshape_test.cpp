@@ -0,0 +1,56 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdint>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../compactshape.hpp"
+
+using namespace ovms;
+using testing::ElementsAre;
+
+TEST(CompactShape, StoresDimensionsInPlace) {
+    CompactShape shape(std::vector<size_t>{1, 3, 224, 224});
+    EXPECT_EQ(shape.size(), 4);
+    EXPECT_THAT(std::vector<int64_t>(shape.begin(), shape.end()), ElementsAre(1, 3, 224, 224));
+    const auto* base = reinterpret_cast<const char*>(&shape);
+    const auto* data = reinterpret_cast<const char*>(shape.data());
+    EXPECT_TRUE(data >= base && data < base + sizeof(shape));
+}
+
+TEST(CompactShape, FallsBackToHeapBeyondInlineDimensions) {
+    std::vector<size_t> dims(CompactShape::INLINE_DIMS + 2);
+    for (size_t i = 0; i < dims.size(); ++i) {
+        dims[i] = i + 1;
+    }
+    CompactShape shape(dims);
+    ASSERT_EQ(shape.size(), dims.size());
+    for (size_t i = 0; i < dims.size(); ++i) {
+        EXPECT_EQ(shape[i], static_cast<int64_t>(i + 1));
+    }
+    CompactShape copy = shape;
+    EXPECT_EQ(copy, shape);
+    EXPECT_EQ(copy[CompactShape::INLINE_DIMS + 1], static_cast<int64_t>(dims.size()));
+}
+
+TEST(CompactShape, Compare) {
+    EXPECT_EQ(CompactShape(std::vector<int>{1, 2}), CompactShape(std::vector<int64_t>{1, 2}));
+    EXPECT_NE(CompactShape(std::vector<int>{1, 2}), CompactShape(std::vector<int>{1, 2, 1}));
+    EXPECT_NE(CompactShape(std::vector<int>{1, 2}), CompactShape(std::vector<int>{1, 3}));
+    EXPECT_TRUE(CompactShape().empty());
+}
@@ -0,0 +1,93 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../compiled_network_cache.hpp"
+#include "../modelinstance.hpp"
+#include "test_utils.hpp"
+
+using ovms::CompiledNetworkCache;
+
+class CompiledNetworkCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove_all(cacheDir);
+        std::filesystem::create_directories(modelDir);
+        writeFile(modelFile, "model");
+    }
+
+    void TearDown() override {
+        CompiledNetworkCache::getInstance().configure("");
+        std::filesystem::remove_all(cacheDir);
+        std::filesystem::remove_all(modelDir);
+    }
+
+    static void writeFile(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+
+    const std::string cacheDir = "/tmp/ovms_compiled_network_cache_test";
+    const std::string modelDir = "/tmp/ovms_compiled_network_cache_test_model";
+    const std::string modelFile = modelDir + "/model.xml";
+};
+
+TEST_F(CompiledNetworkCacheTest, DisabledByDefault) {
+    EXPECT_FALSE(CompiledNetworkCache::getInstance().isEnabled());
+}
+
+TEST_F(CompiledNetworkCacheTest, ConfigureCreatesDirectory) {
+    ASSERT_EQ(CompiledNetworkCache::getInstance().configure(cacheDir), ovms::StatusCode::OK);
+    EXPECT_TRUE(CompiledNetworkCache::getInstance().isEnabled());
+    EXPECT_TRUE(std::filesystem::is_directory(cacheDir));
+}
+
+TEST_F(CompiledNetworkCacheTest, DirectoryCannotBeCreated) {
+    EXPECT_EQ(CompiledNetworkCache::getInstance().configure(modelFile + "/cache"), ovms::StatusCode::PATH_INVALID);
+    EXPECT_FALSE(CompiledNetworkCache::getInstance().isEnabled());
+}
+
+TEST_F(CompiledNetworkCacheTest, BlobPathDependsOnModelFilesAndDescription) {
+    auto& cache = CompiledNetworkCache::getInstance();
+    ASSERT_EQ(cache.configure(cacheDir), ovms::StatusCode::OK);
+    const auto blobPath = cache.getBlobPath({modelFile}, "CPU");
+    EXPECT_EQ(blobPath.rfind(cacheDir, 0), 0);
+    EXPECT_EQ(cache.getBlobPath({modelFile}, "CPU"), blobPath);
+    EXPECT_NE(cache.getBlobPath({modelFile}, "MYRIAD"), blobPath);
+    writeFile(modelFile, "changed model");
+    EXPECT_NE(cache.getBlobPath({modelFile}, "CPU"), blobPath);
+    EXPECT_EQ(cache.getBlobPath({modelDir + "/missing.bin"}, "CPU"), "");
+}
+
+TEST_F(CompiledNetworkCacheTest, ModelLoadedAgainWithCacheEnabled) {
+    ASSERT_EQ(CompiledNetworkCache::getInstance().configure(cacheDir), ovms::StatusCode::OK);
+    {
+        ovms::ModelInstance modelInstance;
+        ASSERT_EQ(modelInstance.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    }
+    // blob is imported if device supports export, otherwise network is compiled again
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.getStatus().getState(), ovms::ModelVersionState::AVAILABLE);
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDir)) {
+        EXPECT_EQ(entry.path().extension(), ".blob") << "temporary export file left: " << entry.path();
+    }
+}
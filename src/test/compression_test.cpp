@@ -0,0 +1,84 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../compression.hpp"
+
+using namespace ovms;
+
+TEST(Compression, GzipRoundTrip) {
+    std::string input(100000, 'a');
+    std::mt19937 generator(42);
+    for (size_t i = 0; i < input.size(); i += 7) {
+        input[i] = static_cast<char>(generator());
+    }
+    std::string compressed;
+    ASSERT_EQ(gzipCompress(input, compressed), StatusCode::OK);
+    EXPECT_TRUE(isGzip(compressed));
+    EXPECT_LT(compressed.size(), input.size());
+    std::string decompressed;
+    ASSERT_EQ(gzipDecompress(compressed, decompressed, input.size()), StatusCode::OK);
+    EXPECT_EQ(decompressed, input);
+}
+
+TEST(Compression, GzipEmptyInput) {
+    std::string compressed;
+    ASSERT_EQ(gzipCompress("", compressed), StatusCode::OK);
+    std::string decompressed = "stale";
+    ASSERT_EQ(gzipDecompress(compressed, decompressed, 10), StatusCode::OK);
+    EXPECT_TRUE(decompressed.empty());
+}
+
+TEST(Compression, GzipDecompressOverMaxSize) {
+    std::string compressed;
+    ASSERT_EQ(gzipCompress(std::string(10000, 'x'), compressed), StatusCode::OK);
+    std::string decompressed;
+    EXPECT_EQ(gzipDecompress(compressed, decompressed, 9999), StatusCode::COMPRESSION_ERROR);
+    EXPECT_TRUE(decompressed.empty());
+}
+
+TEST(Compression, GzipDecompressInvalidInput) {
+    std::string decompressed;
+    EXPECT_EQ(gzipDecompress("not gzip data", decompressed, 1000), StatusCode::COMPRESSION_ERROR);
+    std::string compressed;
+    ASSERT_EQ(gzipCompress(std::string(1000, 'x'), compressed), StatusCode::OK);
+    EXPECT_EQ(gzipDecompress(compressed.substr(0, compressed.size() / 2), decompressed, 1000), StatusCode::COMPRESSION_ERROR);
+    EXPECT_FALSE(isGzip("{\"instances\": []}"));
+}
+
+TEST(Compression, AcceptsEncoding) {
+    EXPECT_TRUE(acceptsEncoding("gzip", "gzip"));
+    EXPECT_TRUE(acceptsEncoding("deflate, GZIP;q=0.5", "gzip"));
+    EXPECT_TRUE(acceptsEncoding("identity, *", "gzip"));
+    EXPECT_FALSE(acceptsEncoding("", "gzip"));
+    EXPECT_FALSE(acceptsEncoding("identity,deflate", "gzip"));
+    EXPECT_FALSE(acceptsEncoding("gzip;q=0", "gzip"));
+    EXPECT_FALSE(acceptsEncoding("br, gzip ; q=0.000", "gzip"));
+    EXPECT_FALSE(acceptsEncoding("gzipped", "gzip"));
+}
+
+TEST(Compression, ShouldCompressAboveThreshold) {
+    ResponseCompression::setThreshold(0);
+    EXPECT_FALSE(ResponseCompression::shouldCompress(1 << 20, "gzip"));
+    ResponseCompression::setThreshold(1024);
+    EXPECT_FALSE(ResponseCompression::shouldCompress(1023, "gzip"));
+    EXPECT_TRUE(ResponseCompression::shouldCompress(1024, "gzip"));
+    EXPECT_FALSE(ResponseCompression::shouldCompress(1 << 20, "deflate"));
+    ResponseCompression::setThreshold(0);
+}
@@ -0,0 +1,90 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <pthread.h>
+#include <sched.h>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../cpuaffinity.hpp"
+
+using namespace ovms;
+
+TEST(CpuAffinity, ParseCpuList) {
+    EXPECT_EQ(parseCpuList("0"), (std::vector<int>{0}));
+    EXPECT_EQ(parseCpuList("0-3,8-9"), (std::vector<int>{0, 1, 2, 3, 8, 9}));
+    EXPECT_EQ(parseCpuList("4,2, 0-1\n"), (std::vector<int>{0, 1, 2, 4}));
+    EXPECT_TRUE(parseCpuList("").empty());
+}
+
+TEST(CpuAffinity, ParseMalformedCpuList) {
+    EXPECT_TRUE(parseCpuList("3-1").empty());
+    EXPECT_TRUE(parseCpuList("a-b").empty());
+    EXPECT_TRUE(parseCpuList("-1").empty());
+    EXPECT_TRUE(parseCpuList("0-4000000000").empty());
+}
+
+TEST(CpuAffinity, NumaNodesCoverCpus) {
+    auto nodes = getNumaNodesCpus();
+    ASSERT_FALSE(nodes.empty());
+    for (const auto& cpus : nodes) {
+        EXPECT_FALSE(cpus.empty());
+    }
+}
+
+TEST(CpuAffinity, PinThread) {
+    std::thread thread([]() {
+        const int cpu = sched_getcpu();
+        ASSERT_GE(cpu, 0);
+        ASSERT_TRUE(pinCurrentThread({cpu}));
+        EXPECT_EQ(sched_getcpu(), cpu);
+        EXPECT_FALSE(pinCurrentThread({}));
+        EXPECT_FALSE(pinCurrentThread({-1}));
+    });
+    thread.join();
+}
+
+TEST(CpuAffinity, NumaNodeCpus) {
+    EXPECT_TRUE(getNumaNodeCpus(1023).empty());
+    auto nodes = getNumaNodesCpus();
+    auto firstNode = getNumaNodeCpus(0);
+    if (!firstNode.empty()) {
+        EXPECT_EQ(firstNode, nodes[0]);
+    }
+}
+
+TEST(CpuAffinity, ScopedThreadAffinityRestoresPrevious) {
+    std::thread thread([]() {
+        cpu_set_t before;
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(before), &before), 0);
+        const int cpu = sched_getcpu();
+        {
+            ScopedThreadAffinity affinity({cpu});
+            ASSERT_TRUE(affinity.isPinned());
+            cpu_set_t pinned;
+            ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(pinned), &pinned), 0);
+            EXPECT_EQ(CPU_COUNT(&pinned), 1);
+        }
+        cpu_set_t after;
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(after), &after), 0);
+        EXPECT_TRUE(CPU_EQUAL(&before, &after));
+        ScopedThreadAffinity unchanged({});
+        EXPECT_FALSE(unchanged.isPinned());
+    });
+    thread.join();
+}
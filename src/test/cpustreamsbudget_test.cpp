@@ -0,0 +1,77 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../cpustreamsbudget.hpp"
+#include "../modelconfig.hpp"
+
+using namespace ovms;
+
+class CpuStreamsBudgetTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        CpuStreamsBudget::getInstance().configure(0, 0);
+    }
+};
+
+TEST_F(CpuStreamsBudgetTest, SplitProportionallyToWeights) {
+    auto& budget = CpuStreamsBudget::getInstance();
+    budget.configure(12, 48);
+    EXPECT_EQ(budget.getThreadsPerStream(), 4);
+    EXPECT_EQ(budget.split({1, 1, 1}), (std::vector<uint32_t>{4, 4, 4}));
+    EXPECT_EQ(budget.split({2, 1}), (std::vector<uint32_t>{8, 4}));
+    // leftover of rounding goes to largest remainder
+    EXPECT_EQ(budget.split({1, 1, 3}), (std::vector<uint32_t>{3, 3, 6}));
+    EXPECT_EQ(budget.split({1, 1, 1, 1, 1}), (std::vector<uint32_t>{3, 3, 2, 2, 2}));
+}
+
+TEST_F(CpuStreamsBudgetTest, EveryModelGetsAtLeastOneStream) {
+    auto& budget = CpuStreamsBudget::getInstance();
+    budget.configure(2, 8);
+    EXPECT_EQ(budget.split({100, 1}), (std::vector<uint32_t>{1, 1}));
+    EXPECT_EQ(budget.split({1, 1, 1}), (std::vector<uint32_t>{1, 1, 1}));
+    budget.configure(4, 8);
+    EXPECT_EQ(budget.split({100, 1}), (std::vector<uint32_t>{3, 1}));
+}
+
+TEST_F(CpuStreamsBudgetTest, AssignSharesToCpuModelsWithoutStreamsConfigured) {
+    std::vector<ModelConfig> configs{
+        ModelConfig("first"),
+        ModelConfig("gpu", "", "GPU"),
+        ModelConfig("configured"),
+        ModelConfig("second")};
+    configs[0].setCpuStreamsWeight(3);
+    configs[2].setPluginConfig({{"CPU_THROUGHPUT_STREAMS", "2"}});
+
+    CpuStreamsBudget::getInstance().assignShares(configs);
+    for (const auto& config : configs) {
+        EXPECT_EQ(config.getCpuStreamsShare(), 0);
+    }
+
+    CpuStreamsBudget::getInstance().configure(8, 16);
+    CpuStreamsBudget::getInstance().assignShares(configs);
+    EXPECT_EQ(configs[0].getCpuStreamsShare(), 6);
+    EXPECT_EQ(configs[1].getCpuStreamsShare(), 0);
+    EXPECT_EQ(configs[2].getCpuStreamsShare(), 0);
+    EXPECT_EQ(configs[3].getCpuStreamsShare(), 2);
+
+    // removed model leaves its streams to the others
+    configs.erase(configs.begin());
+    CpuStreamsBudget::getInstance().assignShares(configs);
+    EXPECT_EQ(configs[2].getCpuStreamsShare(), 8);
+}
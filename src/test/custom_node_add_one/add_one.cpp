@@ -0,0 +1,63 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../../custom_node_interface.h"
+
+// Test library adding add_value parameter (1 by default) to every FP32 input element,
+// results are returned under the same names as inputs
+extern "C" {
+
+int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount) {
+    float addValue = 1.0f;
+    for (int i = 0; i < paramsCount; i++) {
+        if (std::string(params[i].key) == "add_value") {
+            addValue = std::stof(params[i].value);
+        }
+    }
+    for (int i = 0; i < inputsCount; i++) {
+        if (inputs[i].precision != CUSTOM_NODE_TENSOR_PRECISION_FP32) {
+            return 1;
+        }
+    }
+    *outputsCount = inputsCount;
+    *outputs = static_cast<struct CustomNodeTensor*>(malloc(inputsCount * sizeof(struct CustomNodeTensor)));
+    for (int i = 0; i < inputsCount; i++) {
+        const auto& input = inputs[i];
+        auto& output = (*outputs)[i];
+        output.name = input.name;
+        output.precision = input.precision;
+        output.dataBytes = input.dataBytes;
+        output.data = static_cast<uint8_t*>(malloc(input.dataBytes));
+        const float* inputData = reinterpret_cast<const float*>(input.data);
+        float* outputData = reinterpret_cast<float*>(output.data);
+        for (uint64_t j = 0; j < input.dataBytes / sizeof(float); j++) {
+            outputData[j] = inputData[j] + addValue;
+        }
+        output.dimsCount = input.dimsCount;
+        output.dims = static_cast<uint64_t*>(malloc(input.dimsCount * sizeof(uint64_t)));
+        std::memcpy(output.dims, input.dims, input.dimsCount * sizeof(uint64_t));
+    }
+    return 0;
+}
+
+int releaseBuffer(void* ptr) {
+    free(ptr);
+    return 0;
+}
+}
@@ -0,0 +1,142 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../custom_node.hpp"
+#include "../custom_node_library.hpp"
+#include "../dl_node.hpp"
+#include "../entry_node.hpp"
+#include "../exit_node.hpp"
+#include "../pipeline.hpp"
+#include "../status.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+using namespace tensorflow::serving;
+
+const std::string ADD_ONE_LIBRARY_PATH = "/ovms/bazel-bin/src/libcustom_node_add_one.so";
+
+class CustomNodeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tensorflow::TensorProto& proto = (*request.mutable_inputs())[pipelineInputName];
+        proto.set_dtype(tensorflow::DataType::DT_FLOAT);
+        proto.mutable_tensor_content()->assign((char*)requestData.data(), requestData.size() * sizeof(float));
+        proto.mutable_tensor_shape()->add_dim()->set_size(1);
+        proto.mutable_tensor_shape()->add_dim()->set_size(DUMMY_MODEL_INPUT_SIZE);
+        ASSERT_EQ(CustomNodeLibrary::load(ADD_ONE_LIBRARY_PATH, library), StatusCode::OK);
+    }
+
+    void checkResponse(float addedValue) {
+        ASSERT_EQ(response.outputs().count(pipelineOutputName), 1);
+        const auto& proto = response.outputs().at(pipelineOutputName);
+        ASSERT_EQ(proto.tensor_shape().dim_size(), 2);
+        ASSERT_EQ(proto.tensor_shape().dim(0).size(), 1);
+        ASSERT_EQ(proto.tensor_shape().dim(1).size(), DUMMY_MODEL_OUTPUT_SIZE);
+        ASSERT_EQ(proto.tensor_content().size(), DUMMY_MODEL_OUTPUT_SIZE * sizeof(float));
+        const float* actual = reinterpret_cast<const float*>(proto.tensor_content().data());
+        for (size_t i = 0; i < requestData.size(); i++) {
+            EXPECT_EQ(actual[i], requestData[i] + addedValue) << "at place: " << i;
+        }
+    }
+
+    PredictRequest request;
+    PredictResponse response;
+    std::shared_ptr<CustomNodeLibrary> library;
+
+    const std::string pipelineInputName = "pipeline_input";
+    const std::string pipelineOutputName = "pipeline_output";
+    const std::string libraryInputName = "input_numbers";
+    const std::string libraryOutputName = "input_numbers";
+    const std::vector<float> requestData{-5.0, 3.0, 0.0, -12.0, 9.0, -100.0, 102.0, 92.0, -1.0, 12.0};
+};
+
+TEST_F(CustomNodeTest, LoadingMissingLibraryFails) {
+    std::shared_ptr<CustomNodeLibrary> missingLibrary;
+    EXPECT_EQ(CustomNodeLibrary::load("/ovms/non_existing_library.so", missingLibrary), StatusCode::NODE_LIBRARY_LOAD_FAILED);
+    EXPECT_EQ(missingLibrary, nullptr);
+}
+
+TEST_F(CustomNodeTest, PipelineWithCustomNode) {
+    // input   add_one   output
+    //  O------->O------->O
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto custom_node = std::make_unique<CustomNode>("custom_node", library, std::unordered_map<std::string, std::string>{{"add_value", "2.5"}});
+    auto output_node = std::make_unique<ExitNode>(&response);
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *custom_node, {{pipelineInputName, libraryInputName}});
+    pipeline.connect(*custom_node, *output_node, {{libraryOutputName, pipelineOutputName}});
+
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(custom_node));
+    pipeline.push(std::move(output_node));
+
+    ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+    checkResponse(2.5);
+}
+
+TEST_F(CustomNodeTest, CustomNodeFollowingDLNode) {
+    // input   dummy   add_one   output
+    //  O------->O------->O------->O
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(DUMMY_MODEL_CONFIG);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto model_node = std::make_unique<DLNode>("dummy_node", "dummy", std::nullopt, managerWithDummyModel);
+    auto custom_node = std::make_unique<CustomNode>("custom_node", library, std::unordered_map<std::string, std::string>{},
+        std::unordered_map<std::string, std::string>{{"node_output", libraryInputName}});
+    auto output_node = std::make_unique<ExitNode>(&response);
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *model_node, {{pipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*model_node, *custom_node, {{DUMMY_MODEL_OUTPUT_NAME, libraryInputName}});
+    pipeline.connect(*custom_node, *output_node, {{"node_output", pipelineOutputName}});
+
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(model_node));
+    pipeline.push(std::move(custom_node));
+    pipeline.push(std::move(output_node));
+
+    ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+    // dummy adds 1 and library adds 1 by default
+    checkResponse(2.0);
+}
+
+TEST_F(CustomNodeTest, LibraryRejectingInputsFailsPipeline) {
+    // library supports only FP32 inputs
+    (*request.mutable_inputs())[pipelineInputName].set_dtype(tensorflow::DataType::DT_INT32);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto custom_node = std::make_unique<CustomNode>("custom_node", library);
+    auto output_node = std::make_unique<ExitNode>(&response);
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *custom_node, {{pipelineInputName, libraryInputName}});
+    pipeline.connect(*custom_node, *output_node, {{libraryOutputName, pipelineOutputName}});
+
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(custom_node));
+    pipeline.push(std::move(output_node));
+
+    EXPECT_EQ(pipeline.execute(), StatusCode::NODE_LIBRARY_EXECUTION_FAILED);
+}
@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -57,9 +58,9 @@ const std::vector<Precision> SUPPORTED_INPUT_PRECISIONS{
     Precision::I8,
     Precision::U16,
     Precision::I32,
-    // Precision::I64,
+    Precision::I64,
     // Precision::BIN,
-    // Precision::BOOL
+    Precision::BOOL
     // //Precision::CUSTOM)
 };
 
@@ -74,9 +75,9 @@ const std::vector<Precision> UNSUPPORTED_INPUT_PRECISIONS{
     // Precision::I8,
     // Precision::U16,
     // Precision::I32,
-    Precision::I64,
+    // Precision::I64,
     Precision::BIN,
-    Precision::BOOL
+    // Precision::BOOL
     // Precision::CUSTOM)
 };
 
@@ -201,6 +202,56 @@ TEST_P(GRPCPredictRequest, ShouldSuccessForSupportedPrecision) {
     EXPECT_TRUE(status.ok());
 }
 
+TEST_P(GRPCPredictRequest, ShouldWriteIntoPreallocatedBlobWithoutSetBlob) {
+    Precision testedPrecision = GetParam();
+    tensorMap[tensorName]->setPrecision(testedPrecision);
+    InferenceEngine::Blob::Ptr blob = InferenceEngine::Blob::CreateFromData(
+        std::make_shared<InferenceEngine::Data>(tensorName, tensorMap[tensorName]->getTensorDesc()));
+    blob->allocate();
+    std::memset(blob->buffer().as<char*>(), 0, blob->byteSize());
+    InferenceEngine::BlobMap preallocatedBlobs{{tensorName, blob}};
+    std::shared_ptr<MockIInferRequest> mInferRequestPtr = std::make_shared<MockIInferRequest>();
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    EXPECT_CALL(*mInferRequestPtr, GetBlob(_, _, _))
+        .WillOnce(testing::DoAll(testing::SetArgReferee<1>(blob), testing::Return(InferenceEngine::StatusCode::OK)));
+    EXPECT_CALL(*mInferRequestPtr, SetBlob(_, _, _)).Times(0);
+    auto status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(request, tensorMap, inferRequest, preallocatedBlobs);
+    EXPECT_TRUE(status.ok());
+    if (testedPrecision != Precision::FP16 && testedPrecision != Precision::U16) {
+        EXPECT_EQ(std::memcmp(blob->buffer().as<char*>(), tensorProto.tensor_content().data(), tensorProto.tensor_content().size()), 0);
+    }
+}
+
+TEST_P(GRPCPredictRequest, ShouldSetPreallocatedBlobBackWhenReplaced) {
+    Precision testedPrecision = GetParam();
+    tensorMap[tensorName]->setPrecision(testedPrecision);
+    auto createBlob = [this]() {
+        InferenceEngine::Blob::Ptr blob = InferenceEngine::Blob::CreateFromData(
+            std::make_shared<InferenceEngine::Data>(tensorName, tensorMap[tensorName]->getTensorDesc()));
+        blob->allocate();
+        return blob;
+    };
+    InferenceEngine::Blob::Ptr blob = createBlob();
+    InferenceEngine::Blob::Ptr otherBlob = createBlob();
+    InferenceEngine::BlobMap preallocatedBlobs{{tensorName, blob}};
+    std::shared_ptr<MockIInferRequest> mInferRequestPtr = std::make_shared<MockIInferRequest>();
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    EXPECT_CALL(*mInferRequestPtr, GetBlob(_, _, _))
+        .WillOnce(testing::DoAll(testing::SetArgReferee<1>(otherBlob), testing::Return(InferenceEngine::StatusCode::OK)));
+    EXPECT_CALL(*mInferRequestPtr, SetBlob(_, blob, _)).Times(1);
+    auto status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(request, tensorMap, inferRequest, preallocatedBlobs);
+    EXPECT_TRUE(status.ok());
+}
+
+TEST_P(GRPCPredictRequestNegative, ShouldReturnDeserializationErrorForPreallocatedBlobPrecision) {
+    Precision testedPrecision = GetParam();
+    tensorMap[tensorName]->setPrecision(testedPrecision);
+    InferenceEngine::BlobMap preallocatedBlobs{{tensorName, std::make_shared<NiceMock<MockBlob>>(tensorMap[tensorName]->getTensorDesc())}};
+    InferenceEngine::InferRequest inferRequest;
+    auto status = deserializePredictRequest<PreallocatedBlobTensorProtoDeserializator>(request, tensorMap, inferRequest, preallocatedBlobs);
+    EXPECT_EQ(status, ovms::StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION);
+}
+
 TEST_P(DeserializeTFTensorProtoNegative, ShouldReturnNullptrForPrecision) {
     Precision testedPrecision = GetParam();
     tensorMap[tensorName]->setPrecision(testedPrecision);
@@ -222,6 +273,34 @@ TEST_P(DeserializeTFTensorProto, ShouldReturnValidBlob) {
                                 << " should return valid blob ptr";
 }
 
+TEST(TensorInfoDeserializers, ShouldResolveDeserializersWhenPrecisionIsSet) {
+    TensorInfo tensorInfo("input", Precision::MIXED, shape_t{1, 2});
+    EXPECT_EQ(tensorInfo.getDeserializers().fromContent, nullptr);
+    EXPECT_EQ(tensorInfo.getDeserializers().copyValues, nullptr);
+
+    tensorInfo.setPrecision(Precision::FP32);
+    EXPECT_NE(tensorInfo.getDeserializers().fromContent, nullptr);
+    EXPECT_EQ(tensorInfo.getDeserializers().fromContent, tensorInfo.getDeserializers().fromValues);
+
+    tensorInfo.setPrecision(Precision::FP16);
+    EXPECT_NE(tensorInfo.getDeserializers().fromValues, nullptr);
+    EXPECT_NE(tensorInfo.getDeserializers().fromContent, tensorInfo.getDeserializers().fromValues);
+    EXPECT_NE(tensorInfo.getDeserializers().copyContent, tensorInfo.getDeserializers().copyValues);
+}
+
+TEST(TensorInfoDeserializers, ShouldNarrowPaddedHalfValues) {
+    auto tensorInfo = std::make_shared<TensorInfo>("input", Precision::FP16, shape_t{1, 2}, Layout::NC);
+    TensorProto tensorProto;
+    tensorProto.set_dtype(tensorflow::DataType::DT_HALF);
+    tensorProto.add_half_val(0x3C00);
+    tensorProto.add_half_val(0x4000);
+    auto blob = ConcreteTensorProtoDeserializator::deserializeTensorProto(tensorProto, tensorInfo);
+    ASSERT_NE(blob, nullptr);
+    auto data = blob->buffer().as<uint16_t*>();
+    EXPECT_EQ(data[0], 0x3C00);
+    EXPECT_EQ(data[1], 0x4000);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     TestDeserialize,
     GRPCPredictRequestNegative,
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <future>
 #include <sstream>
 
 #include <gmock/gmock.h>
@@ -214,8 +215,9 @@ TEST_F(EnsembleFlowTest, DummyModelDirectAndPipelineInference) {
 TEST_F(EnsembleFlowTest, SeriesOfDummyModels) {
     // Most basic configuration, just process single dummy model request
 
-    Timer timer;
-    timer.start("prepare pipeline");
+    enum : size_t { PREPARE, EXECUTE, COMPARE, TIMER_END };
+    Timer<TIMER_END> timer;
+    timer.start(PREPARE);
 
     const int N = 100;
     // input      dummy x N      output
@@ -246,18 +248,86 @@ TEST_F(EnsembleFlowTest, SeriesOfDummyModels) {
         pipeline.push(std::move(dummy_node));
     }
 
-    timer.stop("prepare pipeline");
-    timer.start("pipeline::execute");
+    timer.stop(PREPARE);
+    timer.start(EXECUTE);
     pipeline.execute();
-    timer.stop("pipeline::execute");
+    timer.stop(EXECUTE);
 
-    timer.start("compare results");
+    timer.start(COMPARE);
     checkResponse(N);
-    timer.stop("compare results");
+    timer.stop(COMPARE);
 
-    std::cout << "prepare pipeline: " << timer.elapsed<std::chrono::microseconds>("prepare pipeline") / 1000 << "ms\n";
-    std::cout << "pipeline::execute: " << timer.elapsed<std::chrono::microseconds>("pipeline::execute") / 1000 << "ms\n";
-    std::cout << "compare results: " << timer.elapsed<std::chrono::microseconds>("compare results") / 1000 << "ms\n";
+    std::cout << "prepare pipeline: " << timer.elapsed<std::chrono::milliseconds>(PREPARE) << "ms\n";
+    std::cout << "pipeline::execute: " << timer.elapsed<std::chrono::milliseconds>(EXECUTE) << "ms\n";
+    std::cout << "compare results: " << timer.elapsed<std::chrono::milliseconds>(COMPARE) << "ms\n";
+}
+
+TEST_F(EnsembleFlowTest, SeriesOfDummyModelsSharingSingleStream) {
+    // Output blobs of a node keep its stream reserved, following node of the same model
+    // has to copy them when it cannot get the only stream
+    // input      dummy x N      output
+    //  O------->O->O...O->O------->O
+    const int N = 3;
+    config.setNireq(1);
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    std::unique_ptr<DLNode> dummy_nodes[N];
+    for (int i = 0; i < N; i++) {
+        dummy_nodes[i] = std::make_unique<DLNode>("dummy_node_" + std::to_string(i), dummyModelName, requestedModelVersion, managerWithDummyModel);
+    }
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *(dummy_nodes[0]), {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*(dummy_nodes[N - 1]), *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+    for (int i = 0; i < N - 1; i++) {
+        pipeline.connect(*(dummy_nodes[i]), *(dummy_nodes[i + 1]), {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
+    }
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    for (auto& dummy_node : dummy_nodes) {
+        pipeline.push(std::move(dummy_node));
+    }
+
+    ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+    checkResponse(N);
+}
+
+TEST_F(EnsembleFlowTest, ExecuteAsyncSeriesOfDummyModels) {
+    // input      dummy x N      output
+    //  O------->O->O...O->O------->O
+    const int N = 10;
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    std::unique_ptr<DLNode> dummy_nodes[N];
+    for (int i = 0; i < N; i++) {
+        dummy_nodes[i] = std::make_unique<DLNode>("dummy_node_" + std::to_string(i), dummyModelName, requestedModelVersion, managerWithDummyModel);
+    }
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *(dummy_nodes[0]), {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*(dummy_nodes[N - 1]), *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+    for (int i = 0; i < N - 1; i++) {
+        pipeline.connect(*(dummy_nodes[i]), *(dummy_nodes[i + 1]), {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
+    }
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    for (auto& dummy_node : dummy_nodes) {
+        pipeline.push(std::move(dummy_node));
+    }
+
+    tensorflow::serving::ThreadPoolExecutor executor(tensorflow::Env::Default(), "testpipelines", 2);
+    std::promise<Status> completed;
+    pipeline.executeAsync(executor, [&completed](const Status& status) { completed.set_value(status); });
+    auto result = completed.get_future();
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    ASSERT_EQ(result.get(), StatusCode::OK);
+    checkResponse(N);
 }
 
 TEST_F(EnsembleFlowTest, ExecutePipelineWithDynamicBatchSize) {
@@ -546,6 +616,76 @@ TEST_F(EnsembleFlowTest, ParallelDummyModels) {
     }
 }
 
+TEST_F(EnsembleFlowTest, RequiredOutputsOfNodeListedOnce) {
+    EntryNode entry(&request);
+    ExitNode firstExit(&response);
+    ExitNode secondExit(&response);
+    Pipeline::connect(entry, firstExit, {{"a", "x"}, {"b", "y"}});
+    Pipeline::connect(entry, secondExit, {{"b", "x"}, {"c", "y"}});
+    EXPECT_THAT(entry.getRequiredOutputs(), testing::ElementsAre("a", "b", "c"));
+    EXPECT_EQ(secondExit.getMappingByDependency(entry), (InputPairs{{"b", "x"}, {"c", "y"}}));
+    EXPECT_THROW(secondExit.getMappingByDependency(firstExit), std::out_of_range);
+}
+
+class NodeReservingStream : public EntryNode {
+public:
+    NodeReservingStream() :
+        EntryNode(nullptr) {}
+    bool outputsReserveStream() const override { return true; }
+};
+
+TEST_F(EnsembleFlowTest, ExitNodeSerializesInputsFromWaitingDependencyWithoutCopy) {
+    NodeReservingStream dependency;
+    ExitNode exitNode(&response);
+    exitNode.addDependency(dependency, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+
+    InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, DUMMY_MODEL_OUTPUT_SIZE}, InferenceEngine::Layout::NC};
+    auto blob = InferenceEngine::make_shared_blob<float>(desc, requestData.data());
+    BlobMap outputs{{DUMMY_MODEL_OUTPUT_NAME, blob}};
+    ASSERT_EQ(exitNode.setInputs(dependency, outputs), ovms::StatusCode::OK);
+    outputs.clear();
+    ASSERT_EQ(exitNode.copyInputsFrom(dependency), ovms::StatusCode::OK);
+    // exit node does not hold the blob received from dependency anymore
+    EXPECT_EQ(blob.use_count(), 1);
+    checkResponse(0);
+
+    BlobMap fetched;
+    ASSERT_EQ(exitNode.fetchResults(fetched), ovms::StatusCode::OK);
+    checkResponse(0);
+}
+
+TEST_F(EnsembleFlowTest, ExitNodeSerializesHalfPrecisionPacked) {
+    ExitNode exitNode(&response);
+    std::vector<uint16_t> data{0x3C00, 0x4000, 0xC000};
+    for (auto precision : {InferenceEngine::Precision::FP16, InferenceEngine::Precision::U16}) {
+        InferenceEngine::TensorDesc desc{precision, {1, 3}, InferenceEngine::Layout::NC};
+        auto blob = InferenceEngine::make_shared_blob<uint16_t>(desc, data.data());
+        tensorflow::TensorProto proto;
+        ASSERT_EQ(exitNode.serialize(blob, proto), ovms::StatusCode::OK);
+        EXPECT_EQ(proto.dtype(), precision == InferenceEngine::Precision::FP16 ? tensorflow::DataType::DT_HALF : tensorflow::DataType::DT_UINT16);
+        // 2 byte values are not widened to 4 bytes
+        ASSERT_EQ(proto.tensor_content().size(), data.size() * sizeof(uint16_t));
+        EXPECT_EQ(0, std::memcmp(proto.tensor_content().data(), data.data(), data.size() * sizeof(uint16_t)));
+    }
+}
+
+TEST_F(EnsembleFlowTest, EntryNodeDeserializesHalfPrecisionPacked) {
+    EntryNode entryNode(&request);
+    std::vector<uint16_t> data{0x3C00, 0x4000, 0xC000};
+    for (auto dataType : {tensorflow::DataType::DT_HALF, tensorflow::DataType::DT_UINT16}) {
+        tensorflow::TensorProto proto;
+        proto.set_dtype(dataType);
+        proto.mutable_tensor_shape()->add_dim()->set_size(1);
+        proto.mutable_tensor_shape()->add_dim()->set_size(3);
+        proto.mutable_tensor_content()->assign(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(uint16_t));
+        InferenceEngine::Blob::Ptr blob;
+        ASSERT_EQ(entryNode.deserialize(proto, blob), ovms::StatusCode::OK);
+        EXPECT_EQ(blob->getTensorDesc().getPrecision(), dataType == tensorflow::DataType::DT_HALF ? InferenceEngine::Precision::FP16 : InferenceEngine::Precision::U16);
+        ASSERT_EQ(blob->byteSize(), data.size() * sizeof(uint16_t));
+        EXPECT_EQ(0, std::memcmp(blob->cbuffer().as<const void*>(), data.data(), data.size() * sizeof(uint16_t)));
+    }
+}
+
 TEST_F(EnsembleFlowTest, FailInDLNodeSetInputsMissingInput) {
     // Most basic configuration, just process single dummy model request
 
@@ -685,6 +825,32 @@ TEST_F(EnsembleFlowTest, PipelineDefinitionNodesWithModelBatchingModeAutoValidat
     ASSERT_EQ(pipelineDefinition->validateNodes(managerWithDummyModel), StatusCode::FORBIDDEN_MODEL_DYNAMIC_PARAMETER);
 }
 
+TEST_F(EnsembleFlowTest, PipelineDefinitionNodesWithDeviceValidation) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+    connections["dummy_node"] = {
+        {"request", {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["response"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+
+    // node placed on target device of the model
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, "request"},
+        {NodeKind::DL, "dummy_node", "dummy"},
+        {NodeKind::EXIT, "response"},
+    };
+    info[1].device = "CPU";
+    std::unique_ptr<PipelineDefinition> pipelineDefinition = std::make_unique<PipelineDefinition>("my_new_pipeline", info, connections);
+    ASSERT_EQ(pipelineDefinition->validateNodes(managerWithDummyModel), StatusCode::OK);
+
+    // model has no replica on requested device
+    info[1].device = "GPU";
+    pipelineDefinition = std::make_unique<PipelineDefinition>("my_new_pipeline", info, connections);
+    ASSERT_EQ(pipelineDefinition->validateNodes(managerWithDummyModel), StatusCode::PIPELINE_NODE_DEVICE_UNAVAILABLE);
+}
+
 TEST_F(EnsembleFlowTest, PipelineDefinitionNodesWithModelShapeModeAutoValidation) {
     ConstructorEnabledModelManager managerWithDummyModel;
     config.parseShapeParameter("auto");
@@ -1133,6 +1299,216 @@ TEST_F(EnsembleFlowTest, SimplePipelineFactoryCreation) {
     checkResponse(dummySeriallyConnectedCount);
 }
 
+TEST_F(EnsembleFlowTest, PipelineFactoryReusesNodesOfDestroyedPipeline) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    PipelineFactory factory;
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, "request"},
+        {NodeKind::DL, "dummy_node", "dummy"},
+        {NodeKind::EXIT, "response"},
+    };
+
+    std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+    connections["dummy_node"] = {
+        {"request", {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["response"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+
+    ASSERT_EQ(factory.createDefinition("my_new_pipeline", info, connections, managerWithDummyModel), StatusCode::OK);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(factory.create(pipeline, "my_new_pipeline", &request, &response, managerWithDummyModel), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    const Node* firstEntry = &pipeline->getEntry();
+    pipeline.reset();
+
+    // Pipeline created for next request is bound to new response with nodes of the destroyed one
+    response.Clear();
+    ASSERT_EQ(factory.create(pipeline, "my_new_pipeline", &request, &response, managerWithDummyModel), StatusCode::OK);
+    EXPECT_EQ(&pipeline->getEntry(), firstEntry);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    const int dummySeriallyConnectedCount = 1;
+    checkResponse(dummySeriallyConnectedCount);
+
+    // Pipelines existing at the same time do not share nodes
+    std::unique_ptr<Pipeline> secondPipeline;
+    PredictResponse secondResponse;
+    ASSERT_EQ(factory.create(secondPipeline, "my_new_pipeline", &request, &secondResponse, managerWithDummyModel), StatusCode::OK);
+    EXPECT_NE(&secondPipeline->getEntry(), &pipeline->getEntry());
+}
+
+TEST_F(EnsembleFlowTest, DemultiplexedOutputsGatheredInResponse) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    PipelineFactory factory;
+
+    // Dummy output of (1,10) shape is split into 10 sub-requests and gathered back in response
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, "request"},
+        {NodeKind::DL, "dummy_node", "dummy", std::nullopt, {}, DUMMY_MODEL_OUTPUT_SIZE},
+        {NodeKind::EXIT, "response", "", std::nullopt, {}, std::nullopt, "dummy_node"},
+    };
+
+    std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+    connections["dummy_node"] = {
+        {"request", {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["response"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+
+    ASSERT_EQ(factory.createDefinition("my_new_pipeline", info, connections, managerWithDummyModel), StatusCode::OK);
+
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(factory.create(pipeline, "my_new_pipeline", &request, &response, managerWithDummyModel), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(), StatusCode::OK);
+    const int dummySeriallyConnectedCount = 1;
+    checkResponse(dummySeriallyConnectedCount);
+}
+
+TEST_F(EnsembleFlowTest, DemultiplexerOutputsShareMemoryWithNodeResults) {
+    const size_t count = 3;
+    auto blob = InferenceEngine::make_shared_blob<float>(InferenceEngine::TensorDesc(InferenceEngine::Precision::FP32, {1, count, 2}, InferenceEngine::Layout::CHW));
+    blob->allocate();
+    BlobMap outputs{{"output", blob}};
+
+    EntryNode node(&request);
+    node.setDemultiplyCount(count);
+    ASSERT_EQ(node.demultiplyOutputs(outputs), StatusCode::OK);
+    EXPECT_EQ(outputs.at("output")->getTensorDesc().getDims(), (InferenceEngine::SizeVector{count, 2}));
+    EXPECT_EQ(outputs.at("output")->buffer().as<float*>(), blob->buffer().as<float*>());
+
+    BlobMap wrongOutputs{{"output", blob}};
+    node.setDemultiplyCount(count + 1);
+    EXPECT_EQ(node.demultiplyOutputs(wrongOutputs), StatusCode::INVALID_SHAPE);
+}
+
+TEST_F(EnsembleFlowTest, PipelineDefinitionDemultiplexerWithWrongOutputShapeValidation) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    PipelineFactory factory;
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, "request"},
+        {NodeKind::DL, "dummy_node", "dummy", std::nullopt, {}, DUMMY_MODEL_OUTPUT_SIZE + 1},
+        {NodeKind::EXIT, "response", "", std::nullopt, {}, std::nullopt, "dummy_node"},
+    };
+
+    std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+    connections["dummy_node"] = {
+        {"request", {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["response"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+
+    EXPECT_EQ(factory.createDefinition("my_new_pipeline", info, connections, managerWithDummyModel), StatusCode::PIPELINE_DEMULTIPLEXER_INVALID_OUTPUT_SHAPE);
+}
+
+TEST_F(EnsembleFlowTest, PipelineDefinitionGatherFromNodeWhichIsNotDemultiplexerValidation) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    PipelineFactory factory;
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, "request"},
+        {NodeKind::DL, "dummy_node", "dummy"},
+        {NodeKind::EXIT, "response", "", std::nullopt, {}, std::nullopt, "dummy_node"},
+    };
+
+    std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+    connections["dummy_node"] = {
+        {"request", {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["response"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+
+    EXPECT_EQ(factory.createDefinition("my_new_pipeline", info, connections, managerWithDummyModel), StatusCode::PIPELINE_GATHER_FROM_NOT_DEMULTIPLEXER);
+}
+
+TEST_F(EnsembleFlowTest, ConditionalNodeRunsIfConditionMet) {
+    // input  dummy_1 (run if any input above 100)  dummy_2  output
+    //  O------->O---------------------------------->O-------->O
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    auto dummy_node_1 = std::make_unique<DLNode>("dummy_node_1", dummyModelName, requestedModelVersion, managerWithDummyModel);
+    auto dummy_node_2 = std::make_unique<DLNode>("dummy_node_2", dummyModelName, requestedModelVersion, managerWithDummyModel);
+    dummy_node_1->setCondition(NodeCondition{DUMMY_MODEL_INPUT_NAME, 100.0f, 1});
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *dummy_node_1, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*dummy_node_1, *dummy_node_2, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*dummy_node_2, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    pipeline.push(std::move(dummy_node_1));
+    pipeline.push(std::move(dummy_node_2));
+
+    ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+    checkResponse(2);
+}
+
+TEST_F(EnsembleFlowTest, ConditionalNodeSkippedWithDependants) {
+    //         dummy_1 (run if 2 inputs above 100)  dummy_2
+    //         .------->O------------------------------>O--------v
+    //  input O                                                   O output
+    //         *------->O-----------------------------------------^
+    //               dummy_3
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    const std::string directOutputName = "direct_dummy_output";
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    auto dummy_node_1 = std::make_unique<DLNode>("dummy_node_1", dummyModelName, requestedModelVersion, managerWithDummyModel);
+    auto dummy_node_2 = std::make_unique<DLNode>("dummy_node_2", dummyModelName, requestedModelVersion, managerWithDummyModel);
+    auto dummy_node_3 = std::make_unique<DLNode>("dummy_node_3", dummyModelName, requestedModelVersion, managerWithDummyModel);
+    dummy_node_1->setCondition(NodeCondition{DUMMY_MODEL_INPUT_NAME, 100.0f, 2});
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *dummy_node_1, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*input_node, *dummy_node_3, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*dummy_node_1, *dummy_node_2, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*dummy_node_2, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+    pipeline.connect(*dummy_node_3, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, directOutputName}});
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    pipeline.push(std::move(dummy_node_1));
+    pipeline.push(std::move(dummy_node_2));
+    pipeline.push(std::move(dummy_node_3));
+
+    ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+    EXPECT_EQ(response.outputs().count(customPipelineOutputName), 0);
+    ASSERT_EQ(response.outputs().count(directOutputName), 1);
+    EXPECT_EQ(response.outputs().at(directOutputName).tensor_content().size(), DUMMY_MODEL_OUTPUT_SIZE * sizeof(float));
+}
+
+TEST_F(EnsembleFlowTest, PipelineDefinitionConditionOnMissingInputValidation) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    PipelineFactory factory;
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, "request"},
+        {NodeKind::DL, "dummy_node", "dummy"},
+        {NodeKind::EXIT, "response"},
+    };
+    info[1].condition = NodeCondition{"MISSING", std::nullopt, 1};
+
+    std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+    connections["dummy_node"] = {
+        {"request", {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+    connections["response"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+
+    EXPECT_EQ(factory.createDefinition("my_new_pipeline", info, connections, managerWithDummyModel), StatusCode::PIPELINE_CONDITION_INVALID);
+}
+
 TEST_F(EnsembleFlowTest, ParallelPipelineFactoryUsage) {
     // Prepare manager
     ConstructorEnabledModelManager managerWithDummyModel;
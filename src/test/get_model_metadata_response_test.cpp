@@ -237,6 +237,46 @@ TEST_F(GetModelMetadataResponse, HasCorrectShape) {
         {2, 20, 3}));
 }
 
+TEST_F(GetModelMetadataResponse, PostprocessedOutputsServedAsTopK) {
+    ovms::proto_signature_map_t outputs;
+    ovms::GetModelMetadataImpl::convert(networkOutputs, &outputs);
+    ovms::OutputPostprocessingInfo info;
+    info.topK = 5;
+    ovms::GetModelMetadataImpl::applyPostprocessing({{"Output_FP32_2_20_3", info}, {"missing", info}}, &outputs);
+
+    ASSERT_EQ(outputs.size(), 3);
+    const auto& scores = outputs.at("Output_FP32_2_20_3");
+    EXPECT_EQ(scores.dtype(), tensorflow::DT_FLOAT);
+    ASSERT_EQ(scores.tensor_shape().dim_size(), 3);
+    EXPECT_EQ(scores.tensor_shape().dim(2).size(), 5);
+    const auto& indices = outputs.at("Output_FP32_2_20_3_indices");
+    EXPECT_EQ(indices.name(), "Output_FP32_2_20_3_indices");
+    EXPECT_EQ(indices.dtype(), tensorflow::DT_INT32);
+    ASSERT_EQ(indices.tensor_shape().dim_size(), 3);
+    EXPECT_EQ(indices.tensor_shape().dim(0).size(), 2);
+    EXPECT_EQ(indices.tensor_shape().dim(1).size(), 20);
+    EXPECT_EQ(indices.tensor_shape().dim(2).size(), 5);
+    EXPECT_EQ(outputs.at("Output_I32_1_2000").tensor_shape().dim(1).size(), 2000);
+}
+
+TEST_F(GetModelMetadataResponse, OutputsReportedInResponsePrecision) {
+    ovms::proto_signature_map_t outputs;
+    ovms::GetModelMetadataImpl::convert(networkOutputs, &outputs);
+    ovms::GetModelMetadataImpl::applyOutputPrecision("FP16", {}, &outputs);
+    EXPECT_EQ(outputs.at("Output_FP32_2_20_3").dtype(), tensorflow::DT_HALF);
+    EXPECT_EQ(outputs.at("Output_I32_1_2000").dtype(), tensorflow::DT_INT32);
+
+    outputs.clear();
+    ovms::GetModelMetadataImpl::convert(networkOutputs, &outputs);
+    ovms::GetModelMetadataImpl::applyOutputPrecision("", {{"Output_FP32_2_20_3", "BF16"}}, &outputs);
+    EXPECT_EQ(outputs.at("Output_FP32_2_20_3").dtype(), tensorflow::DT_BFLOAT16);
+
+    outputs.clear();
+    ovms::GetModelMetadataImpl::convert(networkOutputs, &outputs);
+    ovms::GetModelMetadataImpl::applyOutputPrecision("", {{"Output_FP32_2_20_3", "FP32"}}, &outputs);
+    EXPECT_EQ(outputs.at("Output_FP32_2_20_3").dtype(), tensorflow::DT_FLOAT);
+}
+
 TEST_F(GetModelMetadataResponse, serialize2Json) {
     ovms::GetModelMetadataImpl::buildResponse(instance, &response);
     std::string json_output;
@@ -250,6 +290,17 @@ TEST_F(GetModelMetadataResponse, serialize2Json) {
     EXPECT_TRUE(received_doc.HasMember("metadata"));
 }
 
+TEST_F(GetModelMetadataResponse, MetadataCacheMatchesBuiltResponse) {
+    ovms::GetModelMetadataImpl::buildResponse(instance, &response);
+    std::string json_output;
+    ASSERT_EQ(ovms::GetModelMetadataImpl::serializeResponse2Json(&response, &json_output), ovms::StatusCode::OK);
+
+    auto metadata = ovms::GetModelMetadataImpl::buildMetadataCache(*instance);
+    ASSERT_NE(metadata, nullptr);
+    EXPECT_EQ(metadata->response.SerializeAsString(), response.SerializeAsString());
+    EXPECT_EQ(metadata->json, json_output);
+}
+
 TEST(RESTGetModelMetadataResponse, createGrpcRequestVersionSet) {
     std::string model_name = "dummy";
     std::optional<int64_t> model_version = 1;
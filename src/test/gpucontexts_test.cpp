@@ -0,0 +1,39 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <gtest/gtest.h>
+
+#include "../gpucontexts.hpp"
+
+using ovms::GpuContexts;
+
+TEST(GpuContexts, RecognizesGpuDevices) {
+    EXPECT_TRUE(GpuContexts::isGpuDevice("GPU"));
+    EXPECT_TRUE(GpuContexts::isGpuDevice("GPU.0"));
+    EXPECT_TRUE(GpuContexts::isGpuDevice("GPU.12"));
+    for (auto device : {"", "CPU", "GPU.", "GPU.a", "GPUX", "MULTI:GPU,CPU", "HETERO:GPU,CPU", "MYRIAD"}) {
+        EXPECT_FALSE(GpuContexts::isGpuDevice(device)) << device;
+    }
+}
+
+TEST(GpuContexts, NoContextOfOtherDevices) {
+    EXPECT_EQ(GpuContexts::getInstance().get("CPU"), nullptr);
+    EXPECT_EQ(GpuContexts::getInstance().get("HETERO:GPU,CPU"), nullptr);
+}
+
+TEST(GpuContexts, NoNetworkCompiledWithoutContext) {
+    InferenceEngine::CNNNetwork network;
+    EXPECT_THROW(GpuContexts::getInstance().loadNetwork(network, nullptr, {}), std::logic_error);
+}
@@ -0,0 +1,37 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "../hash.hpp"
+
+TEST(XxHash64, MatchesReferenceValues) {
+    for (const auto& [text, expected] : std::initializer_list<std::pair<const char*, uint64_t>>{
+             {"", 0xEF46DB3751D8E999ULL},
+             {"a", 0xD24EC4F1A98C6E5BULL},
+             {"abc", 0x44BC2CF5AD770999ULL},
+             {"Nobody inspects the spammish repetition", 0xFBCEA83C8A378BF1ULL}}) {
+        EXPECT_EQ(ovms::xxhash64(text, std::strlen(text)), expected) << text;
+    }
+}
+
+TEST(XxHash64, SeedChangesHash) {
+    const char data[] = "tensor content";
+    EXPECT_NE(ovms::xxhash64(data, sizeof(data), 0), ovms::xxhash64(data, sizeof(data), 1));
+}
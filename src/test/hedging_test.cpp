@@ -0,0 +1,103 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../hedging.hpp"
+#include "../modelinstance.hpp"
+#include "../modelinstanceunloadguard.hpp"
+#include "../prediction_service_utils.hpp"
+#include "test_utils.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(HedgingPolicy, DelayIsPercentileOfRecordedLatencies) {
+    ovms::HedgingPolicy policy(95, 5);
+    for (int i = 1; i < static_cast<int>(ovms::HEDGING_MIN_SAMPLES); ++i) {
+        policy.recordLatency(std::chrono::microseconds(i));
+    }
+    EXPECT_FALSE(policy.getHedgeDelay().has_value());
+    // delay is recomputed in intervals, not on every sample
+    for (int i = ovms::HEDGING_MIN_SAMPLES; i < 200; ++i) {
+        policy.recordLatency(std::chrono::microseconds(i));
+    }
+    ASSERT_TRUE(policy.getHedgeDelay().has_value());
+    EXPECT_GE(policy.getHedgeDelay().value(), 180us);
+    EXPECT_LE(policy.getHedgeDelay().value(), 199us);
+}
+
+TEST(HedgingPolicy, OldLatenciesLeaveWindow) {
+    ovms::HedgingPolicy policy(50, 5);
+    for (size_t i = 0; i < ovms::HEDGING_LATENCY_WINDOW; ++i) {
+        policy.recordLatency(1000us);
+    }
+    EXPECT_EQ(policy.getHedgeDelay().value(), 1000us);
+    for (size_t i = 0; i < ovms::HEDGING_LATENCY_WINDOW; ++i) {
+        policy.recordLatency(10us);
+    }
+    EXPECT_EQ(policy.getHedgeDelay().value(), 10us);
+}
+
+TEST(HedgingPolicy, HedgesAreLimitedByBudget) {
+    ovms::HedgingPolicy policy(95, 10);
+    EXPECT_FALSE(policy.tryStartHedge());
+    for (int i = 0; i < 9; ++i) {
+        policy.recordRequest();
+    }
+    EXPECT_FALSE(policy.tryStartHedge());
+    policy.recordRequest();
+    EXPECT_TRUE(policy.tryStartHedge());
+    EXPECT_FALSE(policy.tryStartHedge());
+
+    // quiet period earns only limited burst of hedges
+    for (int i = 0; i < 1000; ++i) {
+        policy.recordRequest();
+    }
+    int hedges = 0;
+    while (policy.tryStartHedge()) {
+        ++hedges;
+    }
+    EXPECT_EQ(hedges, static_cast<int>(ovms::HEDGING_BUDGET_BURST));
+}
+
+TEST(HedgingPolicy, HedgedRequestsGetCorrectResponses) {
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setNireq(2);
+    config.setHedging(true);
+    config.setHedgingPercentile(50);
+    config.setHedgingBudgetPercent(100);
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    ASSERT_NE(modelInstance.getHedgingPolicy(), nullptr);
+
+    auto request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{1, DUMMY_MODEL_INPUT_SIZE}, tensorflow::DataType::DT_FLOAT}}});
+    std::vector<float> data(DUMMY_MODEL_INPUT_SIZE, 1.0);
+    (*request.mutable_inputs())[DUMMY_MODEL_INPUT_NAME].set_tensor_content(data.data(), data.size() * sizeof(float));
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+    for (int i = 0; i < 300; ++i) {
+        tensorflow::serving::PredictResponse response;
+        ASSERT_EQ(ovms::inference(modelInstance, &request, &response, unloadGuard), ovms::StatusCode::OK);
+        const auto& content = response.outputs().at(DUMMY_MODEL_OUTPUT_NAME).tensor_content();
+        ASSERT_EQ(content.size(), DUMMY_MODEL_OUTPUT_SIZE * sizeof(float));
+        EXPECT_EQ(reinterpret_cast<const float*>(content.data())[0], 2.0);
+    }
+    EXPECT_TRUE(modelInstance.getHedgingPolicy()->getHedgeDelay().has_value());
+    EXPECT_GE(modelInstance.getMetrics().hedgedRequests.get(), modelInstance.getMetrics().hedgeWins.get());
+}
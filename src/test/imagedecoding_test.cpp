@@ -0,0 +1,106 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+#include "../deserialization.hpp"
+#include "../imagedecoding.hpp"
+#include "../tensorinfo.hpp"
+
+using namespace ovms;
+
+namespace {
+// 4x2 BGR image, every pixel holds its column in blue, row in green and 200 in red
+std::string encodePng() {
+    cv::Mat image(2, 4, CV_8UC3);
+    for (int row = 0; row < image.rows; ++row) {
+        for (int col = 0; col < image.cols; ++col) {
+            image.at<cv::Vec3b>(row, col) = cv::Vec3b(col, row, 200);
+        }
+    }
+    std::vector<uchar> encoded;
+    cv::imencode(".png", image, encoded);
+    return std::string(encoded.begin(), encoded.end());
+}
+
+tensorflow::TensorProto makeImagesProto(const std::vector<std::string>& images) {
+    tensorflow::TensorProto proto;
+    proto.set_dtype(tensorflow::DataType::DT_STRING);
+    proto.mutable_tensor_shape()->add_dim()->set_size(images.size());
+    for (const auto& image : images) {
+        proto.add_string_val(image);
+    }
+    return proto;
+}
+}  // namespace
+
+TEST(ImageDecoding, ValidateImageInput) {
+    const auto images = makeImagesProto({encodePng(), encodePng()});
+    EXPECT_EQ(validateImageInput(TensorInfo("image", InferenceEngine::Precision::U8, {2, 3, 2, 4}, InferenceEngine::Layout::NCHW), images), StatusCode::OK);
+    EXPECT_EQ(validateImageInput(TensorInfo("image", InferenceEngine::Precision::FP32, {1, 3, 2, 4}, InferenceEngine::Layout::NCHW), images), StatusCode::INVALID_BATCH_SIZE);
+    EXPECT_EQ(validateImageInput(TensorInfo("image", InferenceEngine::Precision::I32, {2, 3, 2, 4}, InferenceEngine::Layout::NCHW), images), StatusCode::UNSUPPORTED_IMAGE_INPUT);
+    EXPECT_EQ(validateImageInput(TensorInfo("image", InferenceEngine::Precision::FP32, {2, 3, 8}, InferenceEngine::Layout::CHW), images), StatusCode::UNSUPPORTED_IMAGE_INPUT);
+
+    auto missingImage = images;
+    missingImage.mutable_string_val()->RemoveLast();
+    EXPECT_EQ(validateImageInput(TensorInfo("image", InferenceEngine::Precision::U8, {2, 3, 2, 4}, InferenceEngine::Layout::NCHW), missingImage), StatusCode::INVALID_VALUE_COUNT);
+}
+
+TEST(ImageDecoding, DecodeToNCHWFloat) {
+    auto blob = InferenceEngine::make_shared_blob<float>({InferenceEngine::Precision::FP32, {2, 3, 2, 4}, InferenceEngine::Layout::NCHW});
+    blob->allocate();
+    ASSERT_EQ(decodeImages(makeImagesProto({encodePng(), encodePng()}), blob), StatusCode::OK);
+    const float* data = blob->cbuffer().as<const float*>();
+    const size_t planeSize = 2 * 4;
+    for (size_t image = 0; image < 2; ++image) {
+        const float* planes = data + image * 3 * planeSize;
+        EXPECT_EQ(planes[1 * 4 + 3], 3.0f);
+        EXPECT_EQ(planes[planeSize + 1 * 4 + 3], 1.0f);
+        EXPECT_EQ(planes[2 * planeSize + 1 * 4 + 3], 200.0f);
+    }
+}
+
+TEST(ImageDecoding, DecodeToNHWCAndResize) {
+    auto blob = InferenceEngine::make_shared_blob<uint8_t>({InferenceEngine::Precision::U8, {1, 3, 4, 8}, InferenceEngine::Layout::NHWC});
+    blob->allocate();
+    ASSERT_EQ(decodeImages(makeImagesProto({encodePng()}), blob), StatusCode::OK);
+    const uint8_t* data = blob->cbuffer().as<const uint8_t*>();
+    // upscaled image keeps interleaved channels, red is 200 everywhere
+    for (size_t pixel = 0; pixel < 4 * 8; ++pixel) {
+        EXPECT_EQ(data[pixel * 3 + 2], 200);
+    }
+    EXPECT_EQ(data[0], 0);
+}
+
+TEST(ImageDecoding, InvalidImage) {
+    auto blob = InferenceEngine::make_shared_blob<uint8_t>({InferenceEngine::Precision::U8, {1, 3, 2, 4}, InferenceEngine::Layout::NCHW});
+    blob->allocate();
+    EXPECT_EQ(decodeImages(makeImagesProto({"not an image"}), blob), StatusCode::IMAGE_PARSING_FAILED);
+}
+
+TEST(ImageDecoding, DeserializationReturnsDecodingStatus) {
+    tensorflow::serving::PredictRequest request;
+    (*request.mutable_inputs())["image"] = makeImagesProto({"not an image"});
+    tensor_map_t inputs;
+    inputs["image"] = std::make_shared<TensorInfo>("image", InferenceEngine::Precision::U8, shape_t{1, 3, 2, 4}, InferenceEngine::Layout::NCHW);
+    InferenceEngine::InferRequest inferRequest;
+    EXPECT_EQ(deserializePredictRequest<ConcreteTensorProtoDeserializator>(request, inputs, inferRequest), StatusCode::IMAGE_PARSING_FAILED);
+}
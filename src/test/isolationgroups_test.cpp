@@ -0,0 +1,60 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../isolationgroups.hpp"
+
+using ovms::IsolationGroups;
+
+class IsolationGroupsTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        IsolationGroups::getInstance().configure("");
+    }
+
+    const std::vector<int> hostCpus{0, 1, 2, 3, 4, 5, 6, 7};
+};
+
+TEST_F(IsolationGroupsTest, DisabledByDefault) {
+    auto& groups = IsolationGroups::getInstance();
+    EXPECT_FALSE(groups.isEnabled());
+    EXPECT_TRUE(groups.getUngroupedCpus().empty());
+    EXPECT_EQ(groups.excludeReservedCpus({0, 1}), std::vector<int>({0, 1}));
+}
+
+TEST_F(IsolationGroupsTest, GroupsReserveTheirCpus) {
+    auto& groups = IsolationGroups::getInstance();
+    ASSERT_EQ(groups.configure("realtime=0-1;batch=4,6", hostCpus), ovms::StatusCode::OK);
+    EXPECT_TRUE(groups.isEnabled());
+    EXPECT_EQ(groups.getGroupCpus("realtime"), std::vector<int>({0, 1}));
+    EXPECT_EQ(groups.getGroupCpus("batch"), std::vector<int>({4, 6}));
+    EXPECT_TRUE(groups.getGroupCpus("missing").empty());
+    EXPECT_EQ(groups.getUngroupedCpus(), std::vector<int>({2, 3, 5, 7}));
+    EXPECT_EQ(groups.excludeReservedCpus({0, 1, 2, 3}), std::vector<int>({2, 3}));
+}
+
+TEST_F(IsolationGroupsTest, MalformedGroupsAreRejected) {
+    auto& groups = IsolationGroups::getInstance();
+    EXPECT_EQ(groups.configure("realtime", hostCpus), ovms::StatusCode::ISOLATION_GROUPS_CONFIG_INVALID);
+    EXPECT_EQ(groups.configure("realtime=3-1", hostCpus), ovms::StatusCode::ISOLATION_GROUPS_CONFIG_INVALID);
+    EXPECT_EQ(groups.configure("realtime=0-1;realtime=2", hostCpus), ovms::StatusCode::ISOLATION_GROUPS_CONFIG_INVALID);
+    EXPECT_EQ(groups.configure("realtime=0-1;batch=1-2", hostCpus), ovms::StatusCode::ISOLATION_GROUPS_CONFIG_INVALID);
+    EXPECT_EQ(groups.configure("realtime=8", hostCpus), ovms::StatusCode::ISOLATION_GROUPS_CONFIG_INVALID);
+    EXPECT_EQ(groups.configure("realtime=0-7", hostCpus), ovms::StatusCode::ISOLATION_GROUPS_CONFIG_INVALID);
+    EXPECT_FALSE(groups.isEnabled());
+}
@@ -0,0 +1,193 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../kserve_service.hpp"
+#include "../prediction_service.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+using inference::ModelInferRequest;
+using inference::ModelInferResponse;
+using tensorflow::DataType;
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+using testing::ElementsAre;
+
+TEST(KServeDatatype, MapsDatatypesBothWays) {
+    EXPECT_EQ(fromKServeDatatype("FP16"), DataType::DT_HALF);
+    EXPECT_EQ(fromKServeDatatype("INT64"), DataType::DT_INT64);
+    EXPECT_EQ(fromKServeDatatype("BOOL"), DataType::DT_BOOL);
+    EXPECT_EQ(fromKServeDatatype("BYTES"), DataType::DT_INVALID);
+    EXPECT_EQ(toKServeDatatype(DataType::DT_FLOAT), "FP32");
+    EXPECT_EQ(toKServeDatatype(DataType::DT_HALF), "FP16");
+    EXPECT_EQ(toKServeDatatype(DataType::DT_UINT16), "UINT16");
+    EXPECT_EQ(toKServeDatatype(DataType::DT_STRING), "");
+}
+
+TEST(KServeConversion, RawInputContentsAreMovedToTensorContent) {
+    ModelInferRequest request;
+    request.set_model_name("dummy");
+    request.set_model_version("2");
+    auto* input = request.add_inputs();
+    input->set_name("b");
+    input->set_datatype("FP16");
+    input->add_shape(1);
+    input->add_shape(3);
+    const std::string raw("\x00\x3c\x00\x40\x00\x42", 6);
+    request.add_raw_input_contents(raw);
+    request.add_outputs()->set_name("a");
+
+    PredictRequest predictRequest;
+    ASSERT_EQ(convertKServeRequest(request, predictRequest), StatusCode::OK);
+    EXPECT_EQ(predictRequest.model_spec().name(), "dummy");
+    EXPECT_EQ(predictRequest.model_spec().version().value(), 2);
+    const auto& proto = predictRequest.inputs().at("b");
+    EXPECT_EQ(proto.dtype(), DataType::DT_HALF);
+    EXPECT_THAT(asVector(proto.tensor_shape()), ElementsAre(1, 3));
+    EXPECT_EQ(proto.tensor_content(), raw);
+    EXPECT_EQ(proto.half_val_size(), 0);
+    EXPECT_THAT(predictRequest.output_filter(), ElementsAre("a"));
+}
+
+TEST(KServeConversion, TypedContentsArePacked) {
+    ModelInferRequest request;
+    request.set_model_name("dummy");
+    auto* input = request.add_inputs();
+    input->set_name("ids");
+    input->set_datatype("INT64");
+    input->add_shape(2);
+    input->mutable_contents()->add_int64_contents(7);
+    input->mutable_contents()->add_int64_contents(-1);
+
+    PredictRequest predictRequest;
+    ASSERT_EQ(convertKServeRequest(request, predictRequest), StatusCode::OK);
+    EXPECT_FALSE(predictRequest.model_spec().has_version());
+    EXPECT_THAT(asVector<int64_t>(predictRequest.inputs().at("ids").tensor_content()), ElementsAre(7, -1));
+}
+
+TEST(KServeConversion, InvalidRequestsAreRejected) {
+    ModelInferRequest request;
+    request.set_model_name("dummy");
+    request.set_model_version("latest");
+    PredictRequest predictRequest;
+    EXPECT_EQ(convertKServeRequest(request, predictRequest), StatusCode::KSERVE_VERSION_INVALID);
+
+    request.clear_model_version();
+    auto* input = request.add_inputs();
+    input->set_name("b");
+    input->set_datatype("BYTES");
+    predictRequest.Clear();
+    EXPECT_EQ(convertKServeRequest(request, predictRequest), StatusCode::KSERVE_DATATYPE_UNSUPPORTED);
+
+    input->set_datatype("FP16");
+    predictRequest.Clear();
+    EXPECT_EQ(convertKServeRequest(request, predictRequest), StatusCode::KSERVE_INPUT_CONTENTS_INVALID);
+
+    request.add_raw_input_contents("ab");
+    request.add_raw_input_contents("cd");
+    predictRequest.Clear();
+    EXPECT_EQ(convertKServeRequest(request, predictRequest), StatusCode::KSERVE_INPUT_CONTENTS_INVALID);
+}
+
+TEST(KServeConversion, ResponseHasRequestedOutputsInRawContents) {
+    ModelInferRequest request;
+    request.set_model_name("dummy");
+    request.set_id("17");
+    request.add_outputs()->set_name("second");
+    request.add_outputs()->set_name("first");
+
+    PredictResponse predictResponse;
+    auto& first = (*predictResponse.mutable_outputs())["first"];
+    first.set_dtype(DataType::DT_HALF);
+    first.mutable_tensor_shape()->add_dim()->set_size(2);
+    first.mutable_tensor_content()->assign(4, '\x01');
+    auto& second = (*predictResponse.mutable_outputs())["second"];
+    second.set_dtype(DataType::DT_INT32);
+    second.mutable_tensor_shape()->add_dim()->set_size(1);
+    second.mutable_tensor_content()->assign(4, '\x02');
+
+    ModelInferResponse response;
+    ASSERT_EQ(convertPredictResponse(request, predictResponse, response), StatusCode::OK);
+    EXPECT_EQ(response.model_name(), "dummy");
+    EXPECT_EQ(response.id(), "17");
+    ASSERT_EQ(response.outputs_size(), 2);
+    ASSERT_EQ(response.raw_output_contents_size(), 2);
+    EXPECT_EQ(response.outputs(0).name(), "second");
+    EXPECT_EQ(response.outputs(0).datatype(), "INT32");
+    EXPECT_EQ(response.raw_output_contents(0), std::string(4, '\x02'));
+    EXPECT_EQ(response.outputs(1).name(), "first");
+    EXPECT_EQ(response.outputs(1).datatype(), "FP16");
+    EXPECT_THAT(response.outputs(1).shape(), ElementsAre(2));
+
+    request.add_outputs()->set_name("third");
+    response.Clear();
+    EXPECT_EQ(convertPredictResponse(request, predictResponse, response), StatusCode::INVALID_MISSING_OUTPUT);
+}
+
+class KServeInferenceServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(manager.reloadModelWithVersions(DUMMY_MODEL_CONFIG), StatusCode::OK);
+        service = std::make_unique<KServeInferenceServiceImpl>(manager, predictionService);
+    }
+
+    ConstructorEnabledModelManager manager;
+    PredictionServiceImpl predictionService;
+    std::unique_ptr<KServeInferenceServiceImpl> service;
+    grpc::ServerContext context;
+};
+
+TEST_F(KServeInferenceServiceTest, ModelReady) {
+    inference::ModelReadyRequest request;
+    inference::ModelReadyResponse response;
+    request.set_name(DUMMY_MODEL_CONFIG.getName());
+    ASSERT_TRUE(service->ModelReady(&context, &request, &response).ok());
+    EXPECT_TRUE(response.ready());
+
+    request.set_version("42");
+    EXPECT_EQ(service->ModelReady(&context, &request, &response).error_code(), grpc::StatusCode::NOT_FOUND);
+    request.set_name("missing");
+    request.clear_version();
+    EXPECT_EQ(service->ModelReady(&context, &request, &response).error_code(), grpc::StatusCode::NOT_FOUND);
+}
+
+TEST_F(KServeInferenceServiceTest, ModelMetadata) {
+    inference::ModelMetadataRequest request;
+    inference::ModelMetadataResponse response;
+    request.set_name(DUMMY_MODEL_CONFIG.getName());
+    ASSERT_TRUE(service->ModelMetadata(&context, &request, &response).ok());
+    EXPECT_EQ(response.name(), DUMMY_MODEL_CONFIG.getName());
+    EXPECT_THAT(response.versions(), ElementsAre("1"));
+    ASSERT_EQ(response.inputs_size(), 1);
+    EXPECT_EQ(response.inputs(0).name(), DUMMY_MODEL_INPUT_NAME);
+    EXPECT_EQ(response.inputs(0).datatype(), "FP32");
+    EXPECT_THAT(response.inputs(0).shape(), ElementsAre(1, DUMMY_MODEL_INPUT_SIZE));
+    ASSERT_EQ(response.outputs_size(), 1);
+    EXPECT_EQ(response.outputs(0).name(), DUMMY_MODEL_OUTPUT_NAME);
+
+    request.set_version("1");
+    response.Clear();
+    ASSERT_TRUE(service->ModelMetadata(&context, &request, &response).ok());
+    EXPECT_THAT(response.versions(), ElementsAre("1"));
+    request.set_version("42");
+    EXPECT_EQ(service->ModelMetadata(&context, &request, &response).error_code(), grpc::StatusCode::NOT_FOUND);
+}
@@ -0,0 +1,165 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "../loadgen/latencyhistogram.hpp"
+#include "../loadgen/loadgenerator.hpp"
+
+using namespace ovms::loadgen;
+
+namespace {
+class ImmediateLoadClient : public LoadClient {
+public:
+    void send(size_t target, Callback onCompleted) override {
+        onCompleted(target == 1 ? "grpc UNAVAILABLE" : "");
+    }
+};
+
+class NeverCompletingLoadClient : public LoadClient {
+public:
+    void send(size_t, Callback onCompleted) override {
+        std::lock_guard<std::mutex> lock(mtx);
+        pending.push_back(onCompleted);
+    }
+    void completeAll() {
+        std::vector<Callback> toComplete;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            toComplete.swap(pending);
+        }
+        for (auto& onCompleted : toComplete) {
+            onCompleted("");
+        }
+    }
+
+private:
+    std::mutex mtx;
+    std::vector<Callback> pending;
+};
+}  // namespace
+
+TEST(LatencyHistogram, PercentilesWithinPrecision) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.getCount(), 100000);
+    EXPECT_EQ(histogram.getMin(), 1);
+    EXPECT_EQ(histogram.getMax(), 100000);
+    EXPECT_NEAR(histogram.getMean(), 50000.5, 50);
+    EXPECT_NEAR(histogram.getValueAtPercentile(50), 50000, 50);
+    EXPECT_NEAR(histogram.getValueAtPercentile(99), 99000, 99);
+    EXPECT_NEAR(histogram.getValueAtPercentile(99.9), 99900, 100);
+    EXPECT_NEAR(histogram.getValueAtPercentile(100), 100000, 100);
+}
+
+TEST(LatencyHistogram, MergeAddsCounts) {
+    LatencyHistogram first, second;
+    first.record(10);
+    second.record(1000);
+    second.record(2000);
+    first.merge(second);
+    EXPECT_EQ(first.getCount(), 3);
+    EXPECT_EQ(first.getMin(), 10);
+    EXPECT_EQ(first.getMax(), 2000);
+    EXPECT_EQ(first.getValueAtPercentile(30), 10);
+}
+
+TEST(LatencyHistogram, WritesHdrPercentileDistribution) {
+    LatencyHistogram histogram;
+    histogram.record(1000);
+    histogram.record(2000);
+    std::stringstream out;
+    histogram.writePercentileDistribution(out, 1000);
+    EXPECT_THAT(out.str(), ::testing::HasSubstr("1/(1-Percentile)"));
+    EXPECT_THAT(out.str(), ::testing::HasSubstr("#[Max     =        2.000, Total count    =            2]"));
+}
+
+TEST(LoadGenerator, SendsAtRateAndCountsErrorsPerTarget) {
+    ImmediateLoadClient client;
+    LoadOptions options;
+    options.rate = 1000;
+    options.duration = std::chrono::seconds(1);
+    LoadGenerator generator(client, {"dummy", "other"}, options);
+    generator.run();
+
+    const auto& reports = generator.getReports();
+    ASSERT_EQ(reports.size(), 2);
+    EXPECT_EQ(reports[0].sent, 500);
+    EXPECT_EQ(reports[0].succeeded, 500);
+    EXPECT_EQ(reports[0].latency.getCount(), 500);
+    EXPECT_EQ(reports[1].sent, 500);
+    EXPECT_EQ(reports[1].succeeded, 0);
+    EXPECT_EQ(reports[1].errors.at("grpc UNAVAILABLE"), 500);
+
+    auto total = generator.getTotalReport();
+    EXPECT_EQ(total.sent, 1000);
+    EXPECT_EQ(total.succeeded, 500);
+    EXPECT_EQ(total.errors.at("grpc UNAVAILABLE"), 500);
+    EXPECT_GE(generator.getElapsed().count(), 0.99);
+}
+
+TEST(LoadGenerator, DropsRequestsAboveMaxOutstanding) {
+    NeverCompletingLoadClient client;
+    LoadOptions options;
+    options.rate = 100;
+    options.duration = std::chrono::seconds(1);
+    options.maxOutstanding = 10;
+    LoadGenerator generator(client, {"dummy"}, options);
+    std::thread completer([&client]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        client.completeAll();
+    });
+    generator.run();
+    completer.join();
+
+    const auto& report = generator.getReports()[0];
+    EXPECT_EQ(report.sent, 100);
+    EXPECT_EQ(report.dropped, 90);
+    EXPECT_EQ(report.succeeded, 10);
+}
+
+TEST(LoadGenerator, WritesJsonReport) {
+    ImmediateLoadClient client;
+    LoadOptions options;
+    options.rate = 100;
+    options.duration = std::chrono::seconds(1);
+    LoadGenerator generator(client, {"dummy", "other"}, options);
+    generator.run();
+
+    std::stringstream out;
+    generator.writeJsonReport(out);
+    rapidjson::Document report;
+    ASSERT_FALSE(report.Parse(out.str().c_str()).HasParseError());
+    EXPECT_EQ(report["rate"].GetDouble(), 100);
+    EXPECT_STREQ(report["arrival"].GetString(), "constant");
+    ASSERT_EQ(report["targets"].Size(), 2);
+    EXPECT_STREQ(report["targets"][0]["name"].GetString(), "dummy");
+    EXPECT_EQ(report["targets"][0]["succeeded"].GetUint64(), 50);
+    EXPECT_EQ(report["targets"][1]["errors"]["grpc UNAVAILABLE"].GetUint64(), 50);
+    EXPECT_EQ(report["total"]["sent"].GetUint64(), 100);
+    EXPECT_GT(report["total"]["throughput"].GetDouble(), 0);
+    EXPECT_TRUE(report["total"]["latency_ms"].HasMember("p99"));
+}
@@ -0,0 +1,85 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "../loadprogress.hpp"
+
+using ovms::LoadProgress;
+
+TEST(LoadProgress, CountsModelsInEachState) {
+    LoadProgress progress;
+    progress.markPending("resnet");
+    progress.markPending("alpha");
+    progress.markPending("beta");
+    EXPECT_EQ(progress.count(LoadProgress::ModelLoadState::PENDING), 3);
+    progress.markFinished("resnet", true);
+    progress.markFinished("alpha", false);
+    EXPECT_EQ(progress.count(LoadProgress::ModelLoadState::PENDING), 1);
+    EXPECT_EQ(progress.count(LoadProgress::ModelLoadState::LOADED), 1);
+    EXPECT_EQ(progress.count(LoadProgress::ModelLoadState::FAILED), 1);
+    progress.remove("beta");
+    EXPECT_EQ(progress.count(LoadProgress::ModelLoadState::PENDING), 0);
+}
+
+TEST(LoadProgress, FinishingUnknownModelIsIgnored) {
+    LoadProgress progress;
+    progress.markFinished("resnet", true);
+    EXPECT_EQ(progress.getModelsProgress().size(), 0);
+}
+
+TEST(LoadProgress, ReadyAfterStartupCompleted) {
+    LoadProgress progress;
+    EXPECT_FALSE(progress.isReady());
+    progress.markStartupCompleted();
+    EXPECT_TRUE(progress.isReady());
+}
+
+TEST(LoadProgress, NotReadyWhileDraining) {
+    LoadProgress progress;
+    progress.markStartupCompleted();
+    progress.markDraining();
+    EXPECT_FALSE(progress.isReady());
+    EXPECT_TRUE(progress.isDraining());
+
+    rapidjson::Document json;
+    ASSERT_FALSE(json.Parse(progress.toJson().c_str()).HasParseError());
+    EXPECT_FALSE(json["ready"].GetBool());
+    EXPECT_TRUE(json["draining"].GetBool());
+}
+
+TEST(LoadProgress, SerializesProgressToJson) {
+    LoadProgress progress;
+    progress.markPending("resnet");
+    progress.markPending("alpha");
+    progress.markFinished("resnet", true);
+
+    rapidjson::Document json;
+    ASSERT_FALSE(json.Parse(progress.toJson().c_str()).HasParseError());
+    EXPECT_FALSE(json["ready"].GetBool());
+    EXPECT_EQ(json["models_pending"].GetUint64(), 1);
+    EXPECT_EQ(json["models_loaded"].GetUint64(), 1);
+    EXPECT_EQ(json["models_failed"].GetUint64(), 0);
+    const auto& models = json["models"].GetArray();
+    ASSERT_EQ(models.Size(), 2);
+    EXPECT_EQ(std::string(models[0]["name"].GetString()), "alpha");
+    EXPECT_EQ(std::string(models[0]["state"].GetString()), "PENDING");
+    EXPECT_EQ(std::string(models[1]["name"].GetString()), "resnet");
+    EXPECT_EQ(std::string(models[1]["state"].GetString()), "LOADED");
+    EXPECT_TRUE(models[1]["load_time_ms"].IsUint64());
+}
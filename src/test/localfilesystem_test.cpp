@@ -16,13 +16,17 @@
 
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <string>
 #include <thread>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "../filesystem.hpp"
+#include "../instrumentedfilesystem.hpp"
 #include "../localfilesystem.hpp"
+#include "../metrics.hpp"
 
 using namespace testing;
 using ::testing::UnorderedElementsAre;
@@ -129,6 +133,14 @@ TEST(LocalFileSystem, DownloadFileFolder) {
     EXPECT_EQ(status, ovms::StatusCode::OK);
 }
 
+TEST(LocalFileSystem, DownloadModelVersionsLoadsInPlace) {
+    ovms::LocalFileSystem lfs;
+    std::string location;
+    auto status = lfs.downloadModelVersions("/tmp/structure", &location, {1, 2});
+    EXPECT_EQ(status, ovms::StatusCode::OK);
+    EXPECT_EQ(location, "/tmp/structure");
+}
+
 TEST(LocalFileSystem, DestroyFileFolder) {
     ovms::LocalFileSystem lfs;
     bool exists = false;
@@ -144,6 +156,27 @@ TEST(LocalFileSystem, DestroyFileFolder) {
     EXPECT_EQ(status, ovms::StatusCode::PATH_INVALID);
 }
 
+TEST(InstrumentedFileSystem, CountsRequestsAndErrors) {
+    createTmpFiles();
+    ovms::InstrumentedFileSystem fs(std::make_shared<ovms::LocalFileSystem>(), "local_test");
+    auto& registry = ovms::MetricsRegistry::getInstance();
+    const ovms::metric_labels_t labels{{"backend", "local_test"}, {"operation", "read"}};
+    auto& requests = registry.counter("ovms_storage_requests_total", "Calls of model storage operations", labels);
+    auto& errors = registry.counter("ovms_storage_errors_total", "Calls of model storage operations which failed", labels);
+    auto& duration = registry.histogram("ovms_storage_request_duration_seconds", "Duration of model storage operations", labels,
+        ovms::MetricsRegistry::LATENCY_BUCKETS_SECONDS);
+    const auto initialRequests = requests.get();
+    const auto initialErrors = errors.get();
+
+    std::string contents;
+    EXPECT_EQ(fs.readTextFile(TMP_PATH + TMP_FILE, &contents), ovms::StatusCode::OK);
+    EXPECT_EQ(fs.readTextFile(TMP_PATH + "missing.txt", &contents), ovms::StatusCode::PATH_INVALID);
+
+    EXPECT_EQ(requests.get(), initialRequests + 2);
+    EXPECT_EQ(errors.get(), initialErrors + 1);
+    EXPECT_EQ(duration.getCount(), initialRequests + 2);
+}
+
 TEST(FileSystem, CreateTempFolder) {
     std::string local_path;
     namespace fs = std::filesystem;
@@ -0,0 +1,79 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../localfilesystemwatcher.hpp"
+
+using namespace testing;
+
+class LocalFileSystemWatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory + "/1");
+    }
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    const std::string directory = "/tmp/ovms_watched_model";
+    const std::chrono::milliseconds timeout{100};
+};
+
+TEST_F(LocalFileSystemWatcherTest, NoChangesReportedForUntouchedDirectory) {
+    ovms::LocalFileSystemWatcher watcher;
+    ASSERT_TRUE(watcher.isAvailable());
+    ASSERT_TRUE(watcher.watchDirectory(directory));
+    EXPECT_THAT(watcher.waitForChanges(timeout), IsEmpty());
+}
+
+TEST_F(LocalFileSystemWatcherTest, CreatedSubdirectoryReportedAsChangeOfWatchedDirectory) {
+    ovms::LocalFileSystemWatcher watcher;
+    ASSERT_TRUE(watcher.watchDirectory(directory + "/"));
+    std::filesystem::create_directories(directory + "/2");
+    EXPECT_THAT(watcher.waitForChanges(timeout), ElementsAre(directory));
+}
+
+TEST_F(LocalFileSystemWatcherTest, WrittenFileReportedAsChangeOfItsDirectory) {
+    ovms::LocalFileSystemWatcher watcher;
+    ASSERT_TRUE(watcher.watchDirectory(directory));
+    ASSERT_TRUE(watcher.watchDirectory(directory + "/1"));
+    std::ofstream file(directory + "/1/model.xml");
+    file << "content";
+    file.close();
+    EXPECT_THAT(watcher.waitForChanges(timeout), ElementsAre(directory + "/1"));
+}
+
+TEST_F(LocalFileSystemWatcherTest, RemovedDirectoryCanBeWatchedAgain) {
+    ovms::LocalFileSystemWatcher watcher;
+    ASSERT_TRUE(watcher.watchDirectory(directory + "/1"));
+    std::filesystem::remove_all(directory + "/1");
+    EXPECT_THAT(watcher.waitForChanges(timeout), ElementsAre(directory + "/1"));
+    EXPECT_FALSE(watcher.watchDirectory(directory + "/1"));
+    std::filesystem::create_directories(directory + "/1");
+    EXPECT_TRUE(watcher.watchDirectory(directory + "/1"));
+}
+
+TEST(LocalFileSystemWatcher, NonExistingDirectoryCannotBeWatched) {
+    ovms::LocalFileSystemWatcher watcher;
+    EXPECT_FALSE(watcher.watchDirectory("/tmp/ovms_non_existing_directory"));
+}
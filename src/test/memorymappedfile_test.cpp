@@ -0,0 +1,59 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "../memorymappedfile.hpp"
+
+TEST(MemoryMappedFile, MapsWholeFileContent) {
+    const std::string path = "/tmp/ovms_mapped_file.bin";
+    const std::string content = "weights content";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+    auto mapped = ovms::MemoryMappedFile::map(path);
+    ASSERT_NE(mapped, nullptr);
+    ASSERT_EQ(mapped->size(), content.size());
+    EXPECT_EQ(std::memcmp(mapped->data(), content.data(), content.size()), 0);
+}
+
+TEST(MemoryMappedFile, EmptyOrMissingFileIsNotMapped) {
+    const std::string path = "/tmp/ovms_mapped_empty_file.bin";
+    std::ofstream(path).close();
+    EXPECT_EQ(ovms::MemoryMappedFile::map(path), nullptr);
+    EXPECT_EQ(ovms::MemoryMappedFile::map("/tmp/ovms_non_existing_mapped_file.bin"), nullptr);
+}
+
+TEST(MemoryMappedFile, MappingOutlivesRemovedFile) {
+    const std::string path = "/tmp/ovms_mapped_removed_file.bin";
+    const std::string content(3 * 4096, 'w');
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+    auto mapped = ovms::MemoryMappedFile::map(path);
+    ASSERT_NE(mapped, nullptr);
+    // old version directory is removed after new one is published
+    ASSERT_EQ(unlink(path.c_str()), 0);
+    ASSERT_EQ(mapped->size(), content.size());
+    EXPECT_EQ(std::memcmp(mapped->data(), content.data(), content.size()), 0);
+}
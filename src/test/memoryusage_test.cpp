@@ -0,0 +1,34 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../memoryusage.hpp"
+
+TEST(MemoryUsage, ParsesResidentPagesOfStatm) {
+    EXPECT_EQ(ovms::parseResidentPages("25000 1234 300 10 0 2000 0"), 1234);
+    EXPECT_EQ(ovms::parseResidentPages("25000"), 0);
+    EXPECT_EQ(ovms::parseResidentPages(""), 0);
+}
+
+TEST(MemoryUsage, ResidentMemoryGrowsWithTouchedAllocation) {
+    const uint64_t before = ovms::getResidentMemoryBytes();
+    ASSERT_GT(before, 0);
+    std::vector<char> buffer(64 * 1024 * 1024, 1);
+    EXPECT_GE(ovms::getResidentMemoryBytes(), before + buffer.size() / 2);
+}
@@ -0,0 +1,115 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../metrics.hpp"
+#include "../modelmetrics.hpp"
+#include "../status.hpp"
+
+using ovms::MetricsRegistry;
+
+TEST(Metrics, HistogramCountsValuesInBuckets) {
+    ovms::Histogram histogram({1, 10});
+    histogram.observe(0.5);
+    histogram.observe(1);
+    histogram.observe(5);
+    histogram.observe(100);
+    EXPECT_EQ(histogram.getBucketCount(0), 2);
+    EXPECT_EQ(histogram.getBucketCount(1), 1);
+    EXPECT_EQ(histogram.getBucketCount(2), 1);
+    EXPECT_EQ(histogram.getCount(), 4);
+    EXPECT_DOUBLE_EQ(histogram.getSum(), 106.5);
+}
+
+TEST(Metrics, ConcurrentUpdatesAreNotLost) {
+    ovms::Counter counter;
+    ovms::Gauge gauge;
+    ovms::Histogram histogram({1});
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&counter, &gauge, &histogram]() {
+            for (int j = 0; j < 1000; ++j) {
+                counter.increment();
+                gauge.increment(2);
+                gauge.decrement();
+                histogram.observe(2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.get(), 4000);
+    EXPECT_DOUBLE_EQ(gauge.get(), 4000);
+    EXPECT_EQ(histogram.getBucketCount(1), 4000);
+    EXPECT_DOUBLE_EQ(histogram.getSum(), 8000);
+}
+
+TEST(Metrics, RegistryReturnsTheSameMetricForNameAndLabels) {
+    auto& registry = MetricsRegistry::getInstance();
+    auto& counter = registry.counter("ovms_test_same_total", "Test counter", {{"label", "a"}});
+    EXPECT_EQ(&registry.counter("ovms_test_same_total", "Test counter", {{"label", "a"}}), &counter);
+    EXPECT_NE(&registry.counter("ovms_test_same_total", "Test counter", {{"label", "b"}}), &counter);
+    EXPECT_THROW(registry.gauge("ovms_test_same_total", "Test gauge"), std::logic_error);
+}
+
+TEST(Metrics, UsageGaugeIsSerializedAsGauge) {
+    auto& registry = MetricsRegistry::getInstance();
+    auto& gauge = registry.usageGauge("ovms_test_usage_gauge", "Test usage gauge");
+    gauge.increment();
+    gauge.increment();
+    gauge.decrement();
+    EXPECT_EQ(gauge.get(), 1);
+    EXPECT_NE(registry.serialize().find("# TYPE ovms_test_usage_gauge gauge\novms_test_usage_gauge 1\n"), std::string::npos);
+    EXPECT_THROW(registry.gauge("ovms_test_usage_gauge", "Test gauge"), std::logic_error);
+}
+
+TEST(Metrics, RegistrySerializesPrometheusTextFormat) {
+    auto& registry = MetricsRegistry::getInstance();
+    registry.counter("ovms_test_serialized_total", "Test counter", {{"backend", "s\"3"}}).increment(1234567);
+    registry.gauge("ovms_test_serialized_gauge", "Test gauge").set(1.5);
+    registry.histogram("ovms_test_serialized_seconds", "Test histogram", {{"operation", "list"}}, {0.1, 1}).observe(0.5);
+    const auto text = registry.serialize();
+    EXPECT_NE(text.find("# HELP ovms_test_serialized_total Test counter\n# TYPE ovms_test_serialized_total counter\n"
+                        "ovms_test_serialized_total{backend=\"s\\\"3\"} 1234567\n"),
+        std::string::npos);
+    EXPECT_NE(text.find("# TYPE ovms_test_serialized_gauge gauge\novms_test_serialized_gauge 1.5\n"), std::string::npos);
+    EXPECT_NE(text.find("ovms_test_serialized_seconds_bucket{operation=\"list\",le=\"0.1\"} 0\n"
+                        "ovms_test_serialized_seconds_bucket{operation=\"list\",le=\"1\"} 1\n"
+                        "ovms_test_serialized_seconds_bucket{operation=\"list\",le=\"+Inf\"} 1\n"
+                        "ovms_test_serialized_seconds_sum{operation=\"list\"} 0.5\n"
+                        "ovms_test_serialized_seconds_count{operation=\"list\"} 1\n"),
+        std::string::npos);
+}
+
+TEST(Metrics, ModelMetricsCountErrorsByStatusCode) {
+    ovms::ModelMetrics metrics("metrics_test_model", 3);
+    metrics.countError(ovms::StatusCode::INVALID_SHAPE);
+    metrics.countError(ovms::StatusCode::INVALID_SHAPE);
+    metrics.countError(ovms::StatusCode::OV_INTERNAL_INFERENCE_ERROR);
+    auto& registry = MetricsRegistry::getInstance();
+    auto errors = [&registry](ovms::StatusCode code) {
+        return registry.counter("ovms_request_errors_total", "Failed predict requests by status code",
+                           {{"name", "metrics_test_model"}, {"version", "3"}, {"code", std::to_string(static_cast<int>(code))}})
+            .get();
+    };
+    EXPECT_EQ(errors(ovms::StatusCode::INVALID_SHAPE), 2);
+    EXPECT_EQ(errors(ovms::StatusCode::OV_INTERNAL_INFERENCE_ERROR), 1);
+}
@@ -0,0 +1,120 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../microbatching.hpp"
+#include "../modelinstance.hpp"
+#include "../modelinstanceunloadguard.hpp"
+#include "../prediction_service_utils.hpp"
+#include "test_utils.hpp"
+
+using testing::ElementsAre;
+
+namespace {
+std::string asContent(const std::vector<int32_t>& values) {
+    return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int32_t));
+}
+
+void setOutput(tensorflow::serving::PredictResponse& response, const std::string& name, const std::vector<int64_t>& shape, const std::vector<int32_t>& values) {
+    auto& output = (*response.mutable_outputs())[name];
+    output.set_dtype(tensorflow::DataType::DT_INT32);
+    for (auto dim : shape) {
+        output.mutable_tensor_shape()->add_dim()->set_size(dim);
+    }
+    output.set_tensor_content(asContent(values));
+}
+}  // namespace
+
+TEST(MicroBatching, SplitRequestPadsLastMicroBatch) {
+    auto request = preparePredictRequest(
+        {{"a", std::tuple<ovms::shape_t, tensorflow::DataType>{{5, 2}, tensorflow::DataType::DT_INT32}}});
+    (*request.mutable_inputs())["a"].set_tensor_content(asContent({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    std::vector<tensorflow::serving::PredictRequest> microBatches;
+    ASSERT_TRUE(ovms::splitRequestToMicroBatches(request, 2, microBatches));
+    ASSERT_EQ(microBatches.size(), 3);
+    for (const auto& microBatch : microBatches) {
+        EXPECT_THAT(asVector(microBatch.inputs().at("a").tensor_shape()), ElementsAre(2, 2));
+    }
+    EXPECT_THAT(asVector<int32_t>(microBatches[1].inputs().at("a").tensor_content()), ElementsAre(4, 5, 6, 7));
+    EXPECT_THAT(asVector<int32_t>(microBatches[2].inputs().at("a").tensor_content()), ElementsAre(8, 9, 0, 0));
+}
+
+TEST(MicroBatching, RequestsWhichCannotBeSplit) {
+    std::vector<tensorflow::serving::PredictRequest> microBatches;
+    auto fitting = preparePredictRequest(
+        {{"a", std::tuple<ovms::shape_t, tensorflow::DataType>{{2, 2}, tensorflow::DataType::DT_INT32}}});
+    EXPECT_FALSE(ovms::splitRequestToMicroBatches(fitting, 2, microBatches));
+
+    auto differentBatches = preparePredictRequest(
+        {{"a", std::tuple<ovms::shape_t, tensorflow::DataType>{{4, 2}, tensorflow::DataType::DT_INT32}},
+            {"b", std::tuple<ovms::shape_t, tensorflow::DataType>{{3, 2}, tensorflow::DataType::DT_INT32}}});
+    EXPECT_FALSE(ovms::splitRequestToMicroBatches(differentBatches, 2, microBatches));
+
+    auto noContent = preparePredictRequest(
+        {{"a", std::tuple<ovms::shape_t, tensorflow::DataType>{{4, 2}, tensorflow::DataType::DT_INT32}}});
+    (*noContent.mutable_inputs())["a"].clear_tensor_content();
+    EXPECT_FALSE(ovms::splitRequestToMicroBatches(noContent, 2, microBatches));
+}
+
+TEST(MicroBatching, MergeResponsesCropsPadding) {
+    std::vector<tensorflow::serving::PredictResponse> responses(2);
+    setOutput(responses[0], "out", {2, 1}, {10, 11});
+    setOutput(responses[1], "out", {2, 1}, {12, 0});
+    tensorflow::serving::PredictResponse response;
+    ASSERT_EQ(ovms::mergeMicroBatchResponses(responses, 3, response), ovms::StatusCode::OK);
+    EXPECT_THAT(asVector(response.outputs().at("out").tensor_shape()), ElementsAre(3, 1));
+    EXPECT_THAT(asVector<int32_t>(response.outputs().at("out").tensor_content()), ElementsAre(10, 11, 12));
+
+    setOutput(responses[1], "out", {1, 1}, {12});
+    EXPECT_EQ(ovms::mergeMicroBatchResponses(responses, 3, response), ovms::StatusCode::INTERNAL_ERROR);
+}
+
+TEST(MicroBatching, LargeBatchRequestInferredInMicroBatches) {
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setMicroBatching(true);
+    config.setNireq(2);
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+
+    const size_t batchSize = 5;
+    auto request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{batchSize, DUMMY_MODEL_INPUT_SIZE}, tensorflow::DataType::DT_FLOAT}}});
+    std::vector<float> data(batchSize * DUMMY_MODEL_INPUT_SIZE);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = i;
+    }
+    (*request.mutable_inputs())[DUMMY_MODEL_INPUT_NAME].mutable_tensor_content()->assign(
+        reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+    ASSERT_TRUE(modelInstance.isSplitToMicroBatches(&request));
+
+    tensorflow::serving::PredictResponse response;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+    ASSERT_EQ(ovms::inference(modelInstance, &request, &response, unloadGuard), ovms::StatusCode::OK);
+    const auto& output = response.outputs().at(DUMMY_MODEL_OUTPUT_NAME);
+    EXPECT_THAT(asVector(output.tensor_shape()), ElementsAre(batchSize, DUMMY_MODEL_INPUT_SIZE));
+    auto values = asVector<float>(output.tensor_content());
+    ASSERT_EQ(values.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(values[i], data[i] + 1);
+    }
+    // network keeps batch size it was loaded with
+    EXPECT_EQ(modelInstance.getBatchSize(), 1);
+}
@@ -14,6 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 #include <deque>
+#include <memory>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -124,3 +126,59 @@ TEST_F(ModelDefaultVersions, DefaultVersionShouldReturnHighestWhenVersionReloade
     EXPECT_TRUE(nullptr != defaultInstance);
     EXPECT_EQ(2, defaultInstance->getVersion());
 }
+
+class ModelReloadVersions : public ::testing::Test {};
+
+TEST_F(ModelReloadVersions, ReloadPublishesNewInstanceAndUnloadsReplacedOne) {
+    MockModelWithInstancesJustChangingStates mockModel;
+    std::shared_ptr<ovms::model_versions_t> versionsToChange = std::make_shared<ovms::model_versions_t>();
+    versionsToChange->push_back(1);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    ASSERT_EQ(mockModel.addVersions(versionsToChange, config), ovms::StatusCode::OK);
+    auto replacedInstance = mockModel.getModelInstanceByVersion(1);
+
+    ASSERT_EQ(mockModel.reloadVersions(versionsToChange, config), ovms::StatusCode::OK);
+    auto reloadedInstance = mockModel.getModelInstanceByVersion(1);
+    ASSERT_NE(nullptr, reloadedInstance);
+    EXPECT_NE(replacedInstance, reloadedInstance);
+    EXPECT_EQ(reloadedInstance, mockModel.getDefaultModelInstance());
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, reloadedInstance->getStatus().getState());
+    EXPECT_EQ(ovms::ModelVersionState::END, replacedInstance->getStatus().getState());
+}
+
+class MockModelRecordingStateOfReplacedInstance : public MockModelWithInstancesJustChangingStates {
+public:
+    std::vector<ovms::ModelVersionState> statesDuringLoad;
+
+protected:
+    class Instance : public MockModelInstanceChangingStates {
+    public:
+        Instance(MockModelRecordingStateOfReplacedInstance& model) :
+            model(model) {}
+        ovms::Status loadModel(const ovms::ModelConfig& config) override {
+            auto current = model.getModelInstanceByVersion(config.getVersion());
+            if (current) {
+                model.statesDuringLoad.push_back(current->getStatus().getState());
+            }
+            return MockModelInstanceChangingStates::loadModel(config);
+        }
+
+    private:
+        MockModelRecordingStateOfReplacedInstance& model;
+    };
+
+    std::shared_ptr<ovms::ModelInstance> modelInstanceFactory() override {
+        return std::make_shared<Instance>(*this);
+    }
+};
+
+TEST_F(ModelReloadVersions, ReplacedInstanceStaysAvailableWhileNewOneIsLoading) {
+    MockModelRecordingStateOfReplacedInstance mockModel;
+    std::shared_ptr<ovms::model_versions_t> versionsToChange = std::make_shared<ovms::model_versions_t>();
+    versionsToChange->push_back(1);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    ASSERT_EQ(mockModel.addVersions(versionsToChange, config), ovms::StatusCode::OK);
+    ASSERT_EQ(mockModel.reloadVersions(versionsToChange, config), ovms::StatusCode::OK);
+    ASSERT_EQ(mockModel.statesDuringLoad.size(), 1);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, mockModel.statesDuringLoad[0]);
+}
@@ -26,6 +26,7 @@
 #include "test_utils.hpp"
 
 using namespace testing;
+using ::testing::ElementsAre;
 using ::testing::UnorderedElementsAre;
 
 TEST(ModelConfig, getters_setters) {
@@ -439,3 +440,425 @@ TEST(ModelConfig, modelVersionPolicyIncorrect) {
     auto result = config.parseModelVersionPolicy(command);
     EXPECT_EQ(result, ovms::StatusCode::MODEL_VERSION_POLICY_UNSUPPORTED_KEY);
 }
+
+TEST(ModelConfig, parseDynamicBatching) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "batch_size": "auto",
+        "dynamic_batching": {"max_batch_size": 8, "timeout_us": 200}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isDynamicBatchingEnabled());
+    EXPECT_EQ(config.getMaxBatchSize(), 8);
+    EXPECT_EQ(config.getBatchTimeoutMicroseconds(), 200);
+    EXPECT_EQ(config.getBatchingMode(), ovms::FIXED);
+    EXPECT_EQ(config.getBatchSize(), 0);
+
+    ovms::ModelConfig other = config;
+    other.setBatchTimeoutMicroseconds(100);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseAdmissionControl) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "admission_control": {"max_queue_size": 16, "max_queue_time_us": 5000}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getMaxQueueSize(), 16);
+    EXPECT_EQ(config.getMaxQueueTimeMicroseconds(), 5000);
+
+    ovms::ModelConfig other = config;
+    other.setMaxQueueSize(8);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseAdmissionControlPriorities) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "admission_control": {"reserved_high_priority_streams": 2, "max_low_priority_queue_size": 64}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getReservedHighPriorityStreams(), 2);
+    EXPECT_EQ(config.getMaxLowPriorityQueueSize(), 64);
+    EXPECT_EQ(config.getMaxQueueSize(), 0);
+
+    ovms::ModelConfig other = config;
+    other.setReservedHighPriorityStreams(1);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseReplicaDevices) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "target_device": "CPU",
+        "replica_devices": ["GPU", "MYRIAD"]
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getTargetDevice(), "CPU");
+    EXPECT_THAT(config.getReplicaDevices(), ElementsAre("GPU", "MYRIAD"));
+
+    ovms::ModelConfig other = config;
+    other.setReplicaDevices({"GPU"});
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseAutoTune) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "auto_tune": {"latency_slo_ms": 40}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isAutoTuneEnabled());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isAutoTuneEnabled());
+    EXPECT_EQ(config.getAutoTuneLatencySloMilliseconds(), 40);
+    EXPECT_EQ(config.getAutoTuneMeasurementMilliseconds(), ovms::DEFAULT_AUTO_TUNE_MEASUREMENT_MILLISECONDS);
+
+    ovms::ModelConfig other = config;
+    other.setAutoTuneLatencySloMilliseconds(20);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseShapeBuckets) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "shape": "auto",
+        "shape_buckets": {"sizes": [128, 32, 64, 32], "dimension": 1}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_THAT(config.getShapeBuckets(), ElementsAre(32, 64, 128));
+    EXPECT_EQ(config.getShapeBucketDimension(), 1);
+
+    ovms::ModelConfig other = config;
+    other.setShapeBuckets({32, 64});
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseMicroBatching) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "micro_batching": true
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isMicroBatchingEnabled());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isMicroBatchingEnabled());
+
+    ovms::ModelConfig other = config;
+    other.setMicroBatching(false);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseOverlapRequestProcessing) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "overlap_request_processing": true
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isOverlapRequestProcessingEnabled());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isOverlapRequestProcessingEnabled());
+
+    ovms::ModelConfig other = config;
+    other.setOverlapRequestProcessing(false);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseRequestCoalescing) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "request_coalescing": true
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isRequestCoalescingEnabled());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isRequestCoalescingEnabled());
+
+    ovms::ModelConfig other = config;
+    other.setRequestCoalescing(false);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseSharedGpuContext) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "target_device": "GPU",
+        "shared_gpu_context": true
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isGpuContextShared());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isGpuContextShared());
+
+    ovms::ModelConfig other = config;
+    other.setSharedGpuContext(false);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseResponseCache) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "response_cache": {"size_mb": 64, "ttl_seconds": 30}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isResponseCacheEnabled());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isResponseCacheEnabled());
+    EXPECT_EQ(config.getResponseCacheSizeMegabytes(), 64);
+    EXPECT_EQ(config.getResponseCacheTtlSeconds(), 30);
+
+    ovms::ModelConfig other = config;
+    other.setResponseCacheTtlSeconds(0);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseNodeOutputCache) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "node_output_cache": {"size_mb": 16}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isNodeOutputCacheEnabled());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isNodeOutputCacheEnabled());
+    EXPECT_EQ(config.getNodeOutputCacheSizeMegabytes(), 16);
+    EXPECT_EQ(config.getNodeOutputCacheTtlMilliseconds(), ovms::DEFAULT_NODE_OUTPUT_CACHE_TTL_MILLISECONDS);
+
+    ovms::ModelConfig other = config;
+    other.setNodeOutputCacheTtlMilliseconds(200);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseHedging) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "hedging": {"percentile": 99}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isHedgingEnabled());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isHedgingEnabled());
+    EXPECT_EQ(config.getHedgingPercentile(), 99);
+    EXPECT_EQ(config.getHedgingBudgetPercent(), ovms::DEFAULT_HEDGING_BUDGET_PERCENT);
+
+    ovms::ModelConfig other = config;
+    other.setHedgingBudgetPercent(20);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseStoragePolling) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "s3://bucket/dummy",
+        "storage_polling": {"interval_seconds": 30}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_EQ(config.getStoragePollIntervalSeconds(), 0);
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getStoragePollIntervalSeconds(), 30);
+    EXPECT_EQ(config.getStoragePollMaxIntervalSeconds(), 0);
+
+    // polling is applied by watcher to served config, loaded versions stay
+    ovms::ModelConfig other = config;
+    other.setStoragePollMaxIntervalSeconds(600);
+    EXPECT_FALSE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseStateful) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "stateful": {"timeout_seconds": 30}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_FALSE(config.isStateful());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_TRUE(config.isStateful());
+    EXPECT_EQ(config.getSequenceTimeoutSeconds(), 30);
+    EXPECT_EQ(config.getMaxSequenceNumber(), ovms::DEFAULT_MAX_SEQUENCE_NUMBER);
+
+    ovms::ModelConfig other = config;
+    other.setMaxSequenceNumber(10);
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseIsolationGroup) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "isolation_group": "realtime"
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_EQ(config.getIsolationGroup(), "");
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getIsolationGroup(), "realtime");
+
+    ovms::ModelConfig other = config;
+    other.setIsolationGroup("batch");
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseVersionWeights) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "version_weights": {"3": 95, "4": 5}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    EXPECT_TRUE(config.getVersionWeights().empty());
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getVersionWeights(), ovms::version_weights_t({{3, 95}, {4, 5}}));
+
+    // weights route requests between loaded versions, these are not reloaded
+    ovms::ModelConfig other = config;
+    other.setVersionWeights({{3, 50}, {4, 50}});
+    EXPECT_FALSE(config.isReloadRequired(other));
+
+    std::string invalid = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "version_weights": {"latest": 1}
+    })";
+    ASSERT_FALSE(doc.Parse(invalid.c_str()).HasParseError());
+    ovms::ModelConfig invalidConfig;
+    EXPECT_EQ(invalidConfig.parseNode(doc), ovms::StatusCode::MODEL_VERSION_WEIGHTS_WRONG_FORMAT);
+}
+
+TEST(ModelConfig, parsePrecision) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "layout": {"image": "NHWC"},
+        "precision": {"image": "U8"}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getLayouts().at("image"), "NHWC");
+    EXPECT_EQ(config.getPrecision(), "");
+    EXPECT_EQ(config.getPrecisions().at("image"), "U8");
+
+    ovms::ModelConfig other = config;
+    other.setPrecision("FP32");
+    EXPECT_TRUE(config.isReloadRequired(other));
+    EXPECT_TRUE(other.getPrecisions().empty());
+}
+
+TEST(ModelConfig, parsePreprocessing) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "preprocessing": {"data": {"resize": "bilinear", "source_shape": [1, 3, 480, 640], "color_format": "RGB",
+            "mean": [123.675, 116.28, 103.53], "scale": 58.4}, "mask": {"scale": [2, 4]}}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    ASSERT_EQ(config.getPreprocessing().size(), 2);
+    const auto& data = config.getPreprocessing().at("data");
+    EXPECT_EQ(data.resize, "bilinear");
+    EXPECT_EQ(data.sourceShape, ovms::shape_t({1, 3, 480, 640}));
+    EXPECT_EQ(data.colorFormat, "RGB");
+    EXPECT_EQ(data.mean, std::vector<float>({123.675f, 116.28f, 103.53f}));
+    EXPECT_EQ(data.scale, std::vector<float>({58.4f}));
+    EXPECT_EQ(config.getPreprocessing().at("mask").scale, std::vector<float>({2, 4}));
+
+    ovms::ModelConfig other = config;
+    other.addPreprocessing("data", ovms::InputPreprocessingInfo());
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parsePostprocessing) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "postprocessing": {"prob": {"top_k": 5, "min_score": 0.25}, "best": {}}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    ASSERT_EQ(config.getPostprocessing().size(), 2);
+    EXPECT_EQ(config.getPostprocessing().at("prob").topK, 5);
+    EXPECT_EQ(config.getPostprocessing().at("prob").minScore, 0.25f);
+    EXPECT_EQ(config.getPostprocessing().at("best").topK, 1);
+
+    ovms::ModelConfig other = config;
+    other.addPostprocessing("prob", ovms::OutputPostprocessingInfo());
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
+
+TEST(ModelConfig, parseOutputPrecision) {
+    std::string json = R"({
+        "name": "dummy",
+        "base_path": "/path",
+        "output_precision": {"prob": "BF16"}
+    })";
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(json.c_str()).HasParseError());
+    ovms::ModelConfig config;
+    ASSERT_EQ(config.parseNode(doc), ovms::StatusCode::OK);
+    EXPECT_EQ(config.getOutputPrecision(), "");
+    ASSERT_EQ(config.getOutputPrecisions().size(), 1);
+    EXPECT_EQ(config.getOutputPrecisions().at("prob"), "BF16");
+
+    ovms::ModelConfig other = config;
+    other.setOutputPrecision("FP16");
+    EXPECT_TRUE(other.getOutputPrecisions().empty());
+    EXPECT_TRUE(config.isReloadRequired(other));
+}
@@ -16,12 +16,20 @@
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <stdlib.h>
 
+#include "../cpuaffinity.hpp"
+#include "../cpustreamsbudget.hpp"
 #include "../modelinstance.hpp"
+#include "../ondemandmodels.hpp"
+#include "../sharednetworks.hpp"
 #include "test_utils.hpp"
 
 using testing::Return;
@@ -292,6 +300,261 @@ TEST_F(TestReloadModel, SuccessfulReloadFromAlreadyUnloadedWithNewShape) {
     EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
 }
 
+class MockModelInstanceCountingNetworkCompilations : public ovms::ModelInstance {
+public:
+    size_t compilationsCount = 0;
+
+protected:
+    void loadExecutableNetworkPtr(const ovms::plugin_config_t& pluginConfig) override {
+        ++compilationsCount;
+        ovms::ModelInstance::loadExecutableNetworkPtr(pluginConfig);
+    }
+};
+
+TEST_F(TestReloadModel, ReloadToEarlierBatchSizeReusesCompiledNetwork) {
+    MockModelInstanceCountingNetworkCompilations modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBatchingParams("auto");
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.compilationsCount, 1);
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(modelInstance.reloadModel(2, {}, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.getBatchSize(), 2);
+    EXPECT_EQ(modelInstance.compilationsCount, 2);
+    unloadGuard.reset();
+    ASSERT_EQ(modelInstance.reloadModel(1, {}, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.getBatchSize(), 1);
+    EXPECT_EQ(modelInstance.getInputsInfo().begin()->second->getShape()[0], 1);
+    unloadGuard.reset();
+    ASSERT_EQ(modelInstance.reloadModel(2, {}, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.getBatchSize(), 2);
+    EXPECT_EQ(modelInstance.compilationsCount, 2);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+}
+
+TEST_F(TestReloadModel, ReloadWithConfigDropsCompiledNetworks) {
+    MockModelInstanceCountingNetworkCompilations modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBatchingParams("auto");
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(modelInstance.reloadModel(2, {}, unloadGuard), ovms::StatusCode::OK);
+    unloadGuard.reset();
+    ASSERT_EQ(modelInstance.reloadModel(config), ovms::StatusCode::OK);
+    ASSERT_EQ(modelInstance.reloadModel(2, {}, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.compilationsCount, 4);
+}
+
+TEST_F(TestLoadModel, IdenticalModelsShareCompiledNetwork) {
+    auto& sharedNetworks = ovms::SharedNetworks::getInstance();
+    sharedNetworks.setEnabled(true);
+    {
+        MockModelInstanceCountingNetworkCompilations first;
+        MockModelInstanceCountingNetworkCompilations second;
+        ASSERT_EQ(first.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+        ASSERT_EQ(second.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+        EXPECT_EQ(first.compilationsCount, 1);
+        EXPECT_EQ(second.compilationsCount, 0);
+        EXPECT_EQ(sharedNetworks.size(), 1);
+        EXPECT_NE(&first.getInferRequestsQueue(), &second.getInferRequestsQueue());
+
+        ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+        config.setBatchSize(2);
+        MockModelInstanceCountingNetworkCompilations third;
+        ASSERT_EQ(third.loadModel(config), ovms::StatusCode::OK);
+        EXPECT_EQ(third.compilationsCount, 1);
+    }
+    EXPECT_EQ(sharedNetworks.size(), 0);
+    sharedNetworks.setEnabled(false);
+}
+
+class MockModelInstanceObservingWarmUp : public ovms::ModelInstance {
+public:
+    size_t warmUpsCount = 0;
+    ovms::ModelVersionState stateDuringWarmUp = ovms::ModelVersionState::AVAILABLE;
+
+protected:
+    ovms::Status warmUp(const ovms::ModelConfig& config) override {
+        ++warmUpsCount;
+        stateDuringWarmUp = getStatus().getState();
+        return ovms::ModelInstance::warmUp(config);
+    }
+};
+
+TEST_F(TestLoadModel, WarmUpRunsBeforeModelIsAvailable) {
+    MockModelInstanceObservingWarmUp modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setWarmupIterations(2);
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.warmUpsCount, 1);
+    EXPECT_NE(modelInstance.stateDuringWarmUp, ovms::ModelVersionState::AVAILABLE);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+}
+
+TEST_F(TestReloadModel, WarmUpSkippedForReusedCompiledNetwork) {
+    MockModelInstanceObservingWarmUp modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBatchingParams("auto");
+    config.setWarmupIterations(1);
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(modelInstance.reloadModel(2, {}, unloadGuard), ovms::StatusCode::OK);
+    unloadGuard.reset();
+    ASSERT_EQ(modelInstance.reloadModel(1, {}, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.warmUpsCount, 2);
+}
+
+TEST_F(TestLoadModel, NumaNodeWithoutCpusIsRejected) {
+    ovms::ModelInstance modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setNumaNode(1023);
+    EXPECT_EQ(modelInstance.loadModel(config), ovms::StatusCode::INVALID_NUMA_NODE);
+    EXPECT_NE(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+}
+
+TEST_F(TestLoadModel, NumaNodeBindsInferenceCpus) {
+    auto cpus = ovms::getNumaNodeCpus(0);
+    if (cpus.empty()) {
+        GTEST_SKIP() << "NUMA topology is not exposed";
+    }
+    ovms::ModelInstance modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setNumaNode(0);
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.getPinnedCpus(), cpus);
+}
+
+class MockModelInstanceRecordingPluginConfigs : public ovms::ModelInstance {
+public:
+    std::vector<ovms::plugin_config_t> pluginConfigs;
+
+protected:
+    void loadExecutableNetworkPtr(const ovms::plugin_config_t& pluginConfig) override {
+        pluginConfigs.push_back(pluginConfig);
+        ovms::ModelInstance::loadExecutableNetworkPtr(pluginConfig);
+    }
+};
+
+TEST_F(TestReloadModel, PerfCountersCollectionReloadsWithPerfCountEnabled) {
+    MockModelInstanceRecordingPluginConfigs modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    std::string json;
+    ASSERT_EQ(modelInstance.collectPerfCounters(1, std::chrono::milliseconds(1), json), ovms::StatusCode::OK);
+    ASSERT_EQ(modelInstance.pluginConfigs.size(), 3);
+    EXPECT_EQ(modelInstance.pluginConfigs[0].count("PERF_COUNT"), 0);
+    EXPECT_EQ(modelInstance.pluginConfigs[1].at("PERF_COUNT"), "YES");
+    EXPECT_EQ(modelInstance.pluginConfigs[2].count("PERF_COUNT"), 0);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    EXPECT_NE(json.find("\"inferences\":0"), std::string::npos) << json;
+}
+
+TEST_F(TestReloadModel, PerfCountersCollectedFromInferences) {
+    MockModelInstanceRecordingPluginConfigs modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setPluginConfig({{"PERF_COUNT", "YES"}});
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    std::string json;
+    auto collection = std::async(std::launch::async, [&modelInstance, &json]() {
+        return modelInstance.collectPerfCounters(2, std::chrono::seconds(30), json);
+    });
+    auto& inferRequestsQueue = modelInstance.getInferRequestsQueue();
+    while (collection.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+        int streamId = inferRequestsQueue.getIdleStream();
+        auto& inferRequest = inferRequestsQueue.getInferRequest(streamId);
+        inferRequest.Infer();
+        modelInstance.recordPerfCounters(inferRequest);
+        inferRequestsQueue.returnStream(streamId);
+    }
+    EXPECT_EQ(collection.get(), ovms::StatusCode::OK);
+    // plugin config enables counters, collection does not reload
+    EXPECT_EQ(modelInstance.pluginConfigs.size(), 1);
+    EXPECT_NE(json.find("\"inferences\":2"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"executed\":2"), std::string::npos) << json;
+}
+
+TEST_F(TestReloadModel, PerfCountersCollectionDoesNotReloadRetiredVersion) {
+    MockModelInstanceRecordingPluginConfigs modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    modelInstance.unloadModel();
+    std::string json;
+    EXPECT_EQ(modelInstance.collectPerfCounters(1, std::chrono::milliseconds(1), json), ovms::StatusCode::MODEL_VERSION_NOT_LOADED_YET);
+    EXPECT_EQ(modelInstance.pluginConfigs.size(), 1);
+    EXPECT_EQ(ovms::ModelVersionState::END, modelInstance.getStatus().getState());
+}
+
+TEST_F(TestReloadModel, ConcurrentPerfCountersCollectionRejected) {
+    ovms::ModelInstance modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setPluginConfig({{"PERF_COUNT", "YES"}});
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    std::string json;
+    EXPECT_EQ(modelInstance.collectPerfCounters(0, std::chrono::seconds(1), json), ovms::StatusCode::PROFILER_INVALID_PARAMETERS);
+    auto collection = std::async(std::launch::async, [&modelInstance]() {
+        std::string json;
+        return modelInstance.collectPerfCounters(1, std::chrono::milliseconds(500), json);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(modelInstance.collectPerfCounters(1, std::chrono::milliseconds(1), json), ovms::StatusCode::PROFILER_ALREADY_RUNNING);
+    EXPECT_EQ(collection.get(), ovms::StatusCode::OK);
+}
+
+class TestLoadModelOnDemand : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config = DUMMY_MODEL_CONFIG;
+        config.setLoadOnDemand(true);
+    }
+    void TearDown() override {
+        ovms::OnDemandModels::getInstance().setMemoryBudget(0);
+    }
+
+    ovms::ModelConfig config;
+};
+
+TEST_F(TestLoadModelOnDemand, NetworkCompiledOnFirstRequest) {
+    MockModelInstanceCountingNetworkCompilations modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    EXPECT_EQ(modelInstance.compilationsCount, 0);
+    EXPECT_GT(modelInstance.getModelFilesSize(), 0);
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(modelInstance.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_NE(unloadGuard, nullptr);
+    EXPECT_EQ(modelInstance.compilationsCount, 1);
+    EXPECT_EQ(modelInstance.getInputsInfo().size(), 1);
+    unloadGuard.reset();
+    ASSERT_EQ(modelInstance.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.compilationsCount, 1);
+}
+
+TEST_F(TestLoadModelOnDemand, EvictionSkipsVersionInUse) {
+    MockModelInstanceCountingNetworkCompilations modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_FALSE(modelInstance.tryEvict());
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(modelInstance.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_FALSE(modelInstance.tryEvict());
+    unloadGuard.reset();
+    EXPECT_TRUE(modelInstance.tryEvict());
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    ASSERT_EQ(modelInstance.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.compilationsCount, 2);
+}
+
+TEST_F(TestLoadModelOnDemand, LeastRecentlyUsedVersionEvictedToFitMemoryBudget) {
+    MockModelInstanceCountingNetworkCompilations first, second;
+    ASSERT_EQ(first.loadModel(config), ovms::StatusCode::OK);
+    ASSERT_EQ(second.loadModel(config), ovms::StatusCode::OK);
+    ovms::OnDemandModels::getInstance().setMemoryBudget(first.getModelFilesSize());
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(first.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    unloadGuard.reset();
+    ASSERT_EQ(second.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    unloadGuard.reset();
+    EXPECT_FALSE(first.tryEvict());
+    EXPECT_TRUE(second.tryEvict());
+}
+
 TEST(CpuThroughputStreamsNotSpecified, DefaultIsSetForCPU) {
     ovms::ModelConfig config;
     config.setTargetDevice("CPU");
@@ -308,6 +571,29 @@ TEST(CpuThroughputStreamsNotSpecified, DefaultIsSetForHeteroCPU) {
     EXPECT_EQ(pluginConfig.count("CPU_THROUGHPUT_STREAMS"), 1);
 }
 
+TEST(CpuThroughputStreamsNotSpecified, SizedForNumaNode) {
+    ovms::ModelConfig config;
+    config.setTargetDevice("CPU");
+    config.setPluginConfig({{"CPU_THREADS_NUM", "8"}});
+    ovms::plugin_config_t pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config, 24);
+    EXPECT_EQ(pluginConfig["CPU_THROUGHPUT_STREAMS"], "6");
+    EXPECT_EQ(pluginConfig["CPU_THREADS_NUM"], "8");
+    EXPECT_EQ(pluginConfig["CPU_BIND_THREAD"], "NO");
+    pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config, 2);
+    EXPECT_EQ(pluginConfig["CPU_THROUGHPUT_STREAMS"], "1");
+}
+
+TEST(CpuThroughputStreamsNotSpecified, SizedForCpuStreamsBudgetShare) {
+    ovms::CpuStreamsBudget::getInstance().configure(8, 32);
+    ovms::ModelConfig config;
+    config.setTargetDevice("CPU");
+    config.setCpuStreamsShare(3);
+    ovms::plugin_config_t pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
+    EXPECT_EQ(pluginConfig["CPU_THROUGHPUT_STREAMS"], "3");
+    EXPECT_EQ(pluginConfig["CPU_THREADS_NUM"], "12");
+    ovms::CpuStreamsBudget::getInstance().configure(0, 0);
+}
+
 TEST(CpuThroughputStreamsNotSpecified, NotSetForNonCpuDevices) {
     ovms::ModelConfig config;
     config.setPluginConfig({});
@@ -15,6 +15,9 @@
 //*****************************************************************************
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <sstream>
+#include <string>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -27,6 +30,7 @@
 
 using testing::_;
 using testing::ContainerEq;
+using testing::Invoke;
 using testing::Return;
 using testing::ReturnRef;
 using testing::UnorderedElementsAre;
@@ -64,11 +68,40 @@ const char* config_2_models = R"({
     }]
 })";
 
+const char* config_3_models = R"({
+   "model_config_list": [
+    {
+      "config": {
+        "name": "resnet",
+        "base_path": "/tmp/models/dummy1",
+        "target_device": "CPU",
+        "model_version_policy": {"all": {}}
+      }
+    },
+    {
+      "config": {
+        "name": "alpha",
+        "base_path": "/tmp/models/dummy2",
+        "target_device": "CPU",
+        "model_version_policy": {"all": {}}
+      }
+    },
+    {
+      "config": {
+        "name": "beta",
+        "base_path": "/tmp/models/dummy3",
+        "target_device": "CPU",
+        "model_version_policy": {"all": {}}
+      }
+    }]
+})";
+
 const std::string FIRST_MODEL_NAME = "resnet";
 const std::string SECOND_MODEL_NAME = "alpha";
 
 const std::string model_1_path = "/tmp/models/dummy1/1";
 const std::string model_2_path = "/tmp/models/dummy2/2";
+const std::string model_3_path = "/tmp/models/dummy3/3";
 
 const std::chrono::duration SLEEP_TIME_S = std::chrono::seconds(3);
 
@@ -290,6 +323,53 @@ TEST(ModelManager, StartFromFile) {
     modelMock.reset();
 }
 
+TEST(ModelManager, ConfigReloadingSkipsModelsWithUnchangedConfig) {
+    std::filesystem::create_directories(model_1_path);
+    std::filesystem::create_directories(model_2_path);
+    std::string fileToReload = "/tmp/ovms_config_file_unchanged.json";
+    createConfigFileWithContent(config_1_model, fileToReload);
+    modelMock = std::make_shared<MockModel>();
+    MockModelManager manager;
+    // resnet is loaded once, alpha is loaded when it is added to config
+    EXPECT_CALL(*modelMock, addVersion(_))
+        .Times(2)
+        .WillRepeatedly(Return(ovms::Status(ovms::StatusCode::OK)));
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    createConfigFileWithContent(config_2_models, fileToReload);
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    EXPECT_EQ(manager.getModels().size(), 2);
+    modelMock.reset();
+}
+
+TEST(ModelManager, CloudPathsAreRecognized) {
+    EXPECT_TRUE(ovms::isCloudPath("s3://bucket/model"));
+    EXPECT_TRUE(ovms::isCloudPath("gs://bucket/model"));
+    EXPECT_TRUE(ovms::isCloudPath("azfs://share/model"));
+    EXPECT_TRUE(ovms::isCloudPath("az://container/model"));
+    EXPECT_FALSE(ovms::isCloudPath("/models/s3://model"));
+    EXPECT_FALSE(ovms::isCloudPath("/models/model"));
+}
+
+TEST(ModelManager, ConfigLoadingReportsLoadProgress) {
+    std::filesystem::create_directories(model_1_path);
+    std::filesystem::create_directories(model_2_path);
+    std::string fileToReload = "/tmp/ovms_config_file_progress.json";
+    createConfigFileWithContent(config_2_models, fileToReload);
+    modelMock = std::make_shared<MockModel>();
+    MockModelManager manager;
+    EXPECT_CALL(*modelMock, addVersion(_))
+        .WillRepeatedly(Return(ovms::Status(ovms::StatusCode::OK)));
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    const auto& progress = manager.getLoadProgress();
+    EXPECT_EQ(progress.count(ovms::LoadProgress::ModelLoadState::LOADED), 2);
+    EXPECT_EQ(progress.count(ovms::LoadProgress::ModelLoadState::PENDING), 0);
+    EXPECT_EQ(progress.count(ovms::LoadProgress::ModelLoadState::FAILED), 0);
+    // readiness is reported after start completes, not after reloads of config file
+    EXPECT_FALSE(progress.isReady());
+    modelMock.reset();
+}
+
 TEST(ModelManager, ConfigReloadingShouldAddNewModel) {
     std::filesystem::create_directories(model_1_path);
     std::filesystem::create_directories(model_2_path);
@@ -321,6 +401,51 @@ TEST(ModelManager, ConfigReloadingShouldAddNewModel) {
     modelMock.reset();
 }
 
+TEST(ModelManager, ConfigReloadingDoesNotWaitForLoadsOfOtherModels) {
+    std::filesystem::create_directories(model_1_path);
+    std::filesystem::create_directories(model_2_path);
+    std::filesystem::create_directories(model_3_path);
+    std::string fileToReload = "/tmp/ovms_config_file_background.json";
+    createConfigFileWithContent(config_1_model, fileToReload);
+    modelMock = std::make_shared<MockModel>();
+    MockModelManager manager;
+    std::promise<void> releaseSecondModel;
+    std::shared_future<void> secondModelReleased = releaseSecondModel.get_future().share();
+    EXPECT_CALL(*modelMock, addVersion(_))
+        .WillRepeatedly(Invoke([secondModelReleased](const ovms::ModelConfig& config) {
+            if (config.getName() == SECOND_MODEL_NAME) {
+                secondModelReleased.wait();
+            }
+            return ovms::Status(ovms::StatusCode::OK);
+        }));
+    auto waitForState = [&manager](const std::string& name, ovms::LoadProgress::ModelLoadState state) {
+        for (int i = 0; i < 100; ++i) {
+            auto progress = manager.getLoadProgress().getModelsProgress();
+            auto it = progress.find(name);
+            if (it != progress.end() && it->second.state == state) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        return false;
+    };
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    manager.startWatcher();
+    // config file changes are detected with resolution of one second
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    createConfigFileWithContent(config_2_models, fileToReload);
+    EXPECT_TRUE(waitForState(SECOND_MODEL_NAME, ovms::LoadProgress::ModelLoadState::PENDING));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    createConfigFileWithContent(config_3_models, fileToReload);
+    // third model is added and loaded while load of the second one still runs
+    EXPECT_TRUE(waitForState("beta", ovms::LoadProgress::ModelLoadState::LOADED));
+    EXPECT_EQ(manager.getLoadProgress().getModelsProgress().at(SECOND_MODEL_NAME).state, ovms::LoadProgress::ModelLoadState::PENDING);
+    releaseSecondModel.set_value();
+    EXPECT_TRUE(waitForState(SECOND_MODEL_NAME, ovms::LoadProgress::ModelLoadState::LOADED));
+    manager.join();
+    modelMock.reset();
+}
+
 TEST(ModelManager, ConfigReloadingWithWrongInputName) {
     ConstructorEnabledModelManager manager;
     ovms::ModelConfig config;
@@ -330,6 +455,26 @@ TEST(ModelManager, ConfigReloadingWithWrongInputName) {
     ASSERT_EQ(status, ovms::StatusCode::CONFIG_SHAPE_IS_NOT_IN_NETWORK);
 }
 
+TEST(ModelManager, ConfigWithManyModelsLoadsAllOfThem) {
+    const size_t modelsCount = 6;
+    std::stringstream config;
+    config << R"({"model_config_list": [)";
+    for (size_t i = 0; i < modelsCount; ++i) {
+        config << (i > 0 ? "," : "") << R"({"config": {"name": "dummy)" << i << R"(", "base_path": "/ovms/src/test/dummy"}})";
+    }
+    config << "]}";
+    std::string fileToReload = "/tmp/ovms_config_file_many_models.json";
+    createConfigFileWithContent(config.str(), fileToReload);
+    ConstructorEnabledModelManager manager;
+    ASSERT_EQ(manager.startFromFile(fileToReload), ovms::StatusCode::OK);
+    ASSERT_EQ(manager.getModels().size(), modelsCount);
+    for (size_t i = 0; i < modelsCount; ++i) {
+        auto instance = manager.findModelInstance("dummy" + std::to_string(i));
+        ASSERT_NE(instance, nullptr);
+        EXPECT_EQ(instance->getStatus().getState(), ovms::ModelVersionState::AVAILABLE);
+    }
+}
+
 class MockModelManagerWithModelInstancesJustChangingStates : public ovms::ModelManager {
 public:
     std::shared_ptr<ovms::Model> modelFactory(const std::string& name) override {
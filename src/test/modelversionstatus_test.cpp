@@ -104,3 +104,16 @@ TEST(ModelVersionStatus, loading_fault_test_flow) {
 
     // others are not implemented in python version.
 }
+
+TEST(ModelVersionStatus, snapshot_reads_state_and_error_code_together) {
+    ModelVersionStatus mvs("SampleModelName", 15);
+    mvs.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
+    auto snapshot = mvs.getSnapshot();
+    mvs.setAvailable();
+    EXPECT_EQ(snapshot.state, ovms::ModelVersionState::LOADING);
+    EXPECT_EQ(snapshot.errorCode, ModelVersionStatusErrorCode::UNKNOWN);
+    EXPECT_EQ(snapshot.getStateString(), "LOADING");
+    EXPECT_EQ(snapshot.getErrorMsg(), "UNKNOWN");
+    EXPECT_EQ(mvs.getSnapshot().state, ovms::ModelVersionState::AVAILABLE);
+    EXPECT_EQ(mvs.getSnapshot().errorCode, ModelVersionStatusErrorCode::OK);
+}
@@ -0,0 +1,76 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../nodecondition.hpp"
+#include "../tensorconversion.hpp"
+
+using namespace ovms;
+
+namespace {
+template <typename T>
+InferenceEngine::Blob::Ptr makeBlob(InferenceEngine::Precision precision, std::vector<T> values) {
+    auto blob = InferenceEngine::make_shared_blob<T>(InferenceEngine::TensorDesc(precision, {1, values.size()}, InferenceEngine::Layout::NC));
+    blob->allocate();
+    std::copy(values.begin(), values.end(), blob->buffer().template as<T*>());
+    return blob;
+}
+}  // namespace
+
+TEST(NodeCondition, CountsScoresAboveMinScore) {
+    auto scores = makeBlob<float>(InferenceEngine::Precision::FP32, {0.1f, 0.7f, 0.5f, 0.9f});
+    bool met = false;
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"scores", 0.5f, 2}, scores, met), StatusCode::OK);
+    EXPECT_TRUE(met);
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"scores", 0.5f, 3}, scores, met), StatusCode::OK);
+    EXPECT_FALSE(met);
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"scores", 0.9f, 1}, scores, met), StatusCode::OK);
+    EXPECT_FALSE(met);
+}
+
+TEST(NodeCondition, CountsElementsWithoutMinScore) {
+    auto detections = makeBlob<float>(InferenceEngine::Precision::FP32, {0.0f, 0.0f});
+    bool met = false;
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"detections", std::nullopt, 2}, detections, met), StatusCode::OK);
+    EXPECT_TRUE(met);
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"detections", std::nullopt, 3}, detections, met), StatusCode::OK);
+    EXPECT_FALSE(met);
+}
+
+TEST(NodeCondition, ComparesIntegerAndHalfPrecisionInputs) {
+    auto counts = makeBlob<int32_t>(InferenceEngine::Precision::I32, {0, 0, 3});
+    bool met = false;
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"count", 0.0f, 1}, counts, met), StatusCode::OK);
+    EXPECT_TRUE(met);
+
+    std::vector<float> floats{0.25f, 0.75f};
+    std::vector<uint16_t> halves(floats.size());
+    floatToHalf(floats.data(), halves.data(), floats.size());
+    auto scores = makeBlob<uint16_t>(InferenceEngine::Precision::FP16, halves);
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"scores", 0.5f, 1}, scores, met), StatusCode::OK);
+    EXPECT_TRUE(met);
+    ASSERT_EQ(evaluateNodeCondition(NodeCondition{"scores", 0.5f, 2}, scores, met), StatusCode::OK);
+    EXPECT_FALSE(met);
+}
+
+TEST(NodeCondition, UnsupportedPrecision) {
+    auto values = makeBlob<int64_t>(InferenceEngine::Precision::I64, {1, 2});
+    bool met = false;
+    EXPECT_EQ(evaluateNodeCondition(NodeCondition{"values", 0.0f, 1}, values, met), StatusCode::PIPELINE_CONDITION_UNSUPPORTED_PRECISION);
+}
@@ -0,0 +1,81 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../nodeoutputcache.hpp"
+
+using namespace ovms;
+
+namespace {
+InferenceEngine::Blob::Ptr makeBlob(std::vector<float> values) {
+    InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, values.size()}, InferenceEngine::Layout::NC};
+    auto blob = InferenceEngine::make_shared_blob<float>(desc);
+    blob->allocate();
+    std::copy(values.begin(), values.end(), blob->buffer().as<float*>());
+    return blob;
+}
+
+std::shared_ptr<const cached_blobs_t> makeOutputs(size_t elements) {
+    auto outputs = std::make_shared<cached_blobs_t>();
+    outputs->emplace("out", makeBlob(std::vector<float>(elements, 1.0)));
+    return outputs;
+}
+}  // namespace
+
+TEST(NodeOutputCache, KeyDependsOnVersionAndInputs) {
+    cached_blobs_t inputs{{"a", makeBlob({1, 2})}, {"b", makeBlob({3})}};
+    cached_blobs_t sameInputs{{"b", makeBlob({3})}, {"a", makeBlob({1, 2})}};
+    cached_blobs_t otherInputs{{"a", makeBlob({1, 2})}, {"b", makeBlob({4})}};
+    cached_blobs_t renamedInputs{{"a", makeBlob({1, 2})}, {"c", makeBlob({3})}};
+    const auto key = NodeOutputCache::computeKey(inputs, 1);
+    EXPECT_EQ(key, NodeOutputCache::computeKey(sameInputs, 1));
+    EXPECT_NE(key, NodeOutputCache::computeKey(inputs, 2));
+    EXPECT_NE(key, NodeOutputCache::computeKey(otherInputs, 1));
+    EXPECT_NE(key, NodeOutputCache::computeKey(renamedInputs, 1));
+}
+
+TEST(NodeOutputCache, EntriesExpire) {
+    NodeOutputCache cache(1024, std::chrono::milliseconds(100));
+    const auto now = std::chrono::steady_clock::now();
+    auto outputs = makeOutputs(4);
+    cache.put(1, outputs, now);
+    EXPECT_EQ(cache.get(1, now + std::chrono::milliseconds(99)), outputs);
+    EXPECT_EQ(cache.get(2, now), nullptr);
+    EXPECT_EQ(cache.get(1, now + std::chrono::milliseconds(100)), nullptr);
+    EXPECT_EQ(cache.getEntriesCount(), 0);
+    EXPECT_EQ(cache.getSizeBytes(), 0);
+}
+
+TEST(NodeOutputCache, EvictsLeastRecentlyUsed) {
+    NodeOutputCache cache(2 * 64 * sizeof(float), std::chrono::milliseconds(1000));
+    cache.put(1, makeOutputs(64));
+    cache.put(2, makeOutputs(64));
+    ASSERT_NE(cache.get(1), nullptr);
+    cache.put(3, makeOutputs(64));
+    EXPECT_NE(cache.get(1), nullptr);
+    EXPECT_EQ(cache.get(2), nullptr);
+    EXPECT_NE(cache.get(3), nullptr);
+    EXPECT_EQ(cache.getSizeBytes(), 2 * 64 * sizeof(float));
+
+    // outputs larger than the limit are not cached
+    cache.put(4, makeOutputs(3 * 64));
+    EXPECT_EQ(cache.get(4), nullptr);
+    EXPECT_EQ(cache.getEntriesCount(), 2);
+}
@@ -0,0 +1,70 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../objectlisting.hpp"
+
+using ovms::ObjectListing;
+
+class ObjectListingTest : public ::testing::Test {
+protected:
+    const ObjectListing listing{"gs://bucket/model/", {
+                                                          "gs://bucket/model/1/model.bin",
+                                                          "gs://bucket/model/1/model.xml",
+                                                          "gs://bucket/model/2/",
+                                                          "gs://bucket/model/3/model.xml",
+                                                          "gs://bucket/model/README",
+                                                      }};
+};
+
+TEST_F(ObjectListingTest, CoversOnlyPathsUnderRoot) {
+    EXPECT_TRUE(listing.covers("gs://bucket/model"));
+    EXPECT_TRUE(listing.covers("gs://bucket/model/1/model.xml"));
+    EXPECT_FALSE(listing.covers("gs://bucket/model2"));
+    EXPECT_FALSE(listing.covers("gs://bucket"));
+}
+
+TEST_F(ObjectListingTest, ChecksExistenceOfFilesAndDirectories) {
+    EXPECT_TRUE(listing.exists("gs://bucket/model/1/model.xml"));
+    EXPECT_TRUE(listing.exists("gs://bucket/model/1"));
+    EXPECT_TRUE(listing.exists("gs://bucket/model/2/"));
+    EXPECT_FALSE(listing.exists("gs://bucket/model/4"));
+    EXPECT_FALSE(listing.exists("gs://bucket/model/1/model"));
+    EXPECT_TRUE(listing.isDirectory("gs://bucket/model/1/"));
+    EXPECT_TRUE(listing.isDirectory("gs://bucket/model/2"));
+    EXPECT_FALSE(listing.isDirectory("gs://bucket/model/README"));
+    EXPECT_FALSE(listing.isDirectory("gs://bucket/model/1/model.xml"));
+}
+
+TEST_F(ObjectListingTest, ListsDirectoryEntries) {
+    std::set<std::string> contents, subdirs, files;
+    listing.getDirectoryContents("gs://bucket/model", &contents);
+    listing.getDirectorySubdirs("gs://bucket/model", &subdirs);
+    listing.getDirectoryFiles("gs://bucket/model", &files);
+    EXPECT_EQ(contents, std::set<std::string>({"1", "2", "3", "README"}));
+    EXPECT_EQ(subdirs, std::set<std::string>({"1", "2", "3"}));
+    EXPECT_EQ(files, std::set<std::string>({"README"}));
+
+    files.clear();
+    listing.getDirectoryFiles("gs://bucket/model/1/", &files);
+    EXPECT_EQ(files, std::set<std::string>({"model.bin", "model.xml"}));
+    files.clear();
+    listing.getDirectoryFiles("gs://bucket/model/2", &files);
+    EXPECT_TRUE(files.empty());
+}
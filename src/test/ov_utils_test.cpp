@@ -14,12 +14,17 @@
 // limitations under the License.
 //*****************************************************************************
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <string>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "../ov_utils.hpp"
+#include "../tensorbufferpool.hpp"
 
 using testing::ElementsAre;
 
@@ -62,3 +67,57 @@ TEST(OVUtils, CopyBlob) {
     // Expect memory addresses to differ since cloning should allocate new memory space for the cloned blob
     EXPECT_NE((float*)copyBlob->buffer(), (float*)originalBlob->buffer());
 }
+
+TEST(OVUtils, CopyBlobReusesReleasedBuffer) {
+    auto& pool = ovms::TensorBufferPool::getInstance();
+    const size_t maxPooledBytes = pool.getMaxPooledBytes();
+    pool.setMaxPooledBytes(16 * 1024 * 1024);
+
+    const InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, 3, 224, 224}, InferenceEngine::Layout::NCHW};
+    std::vector<float> data(3 * 224 * 224, 1.0f);
+    InferenceEngine::Blob::Ptr originalBlob = InferenceEngine::make_shared_blob<float>(desc, data.data());
+
+    InferenceEngine::Blob::Ptr copyBlob = ovms::blobClone(originalBlob);
+    ASSERT_NE(copyBlob, nullptr);
+    void* buffer = copyBlob->buffer();
+    copyBlob.reset();
+
+    // intermediate blobs of the same size in steady state pipelines are allocated from released buffers
+    copyBlob = ovms::blobClone(originalBlob);
+    ASSERT_NE(copyBlob, nullptr);
+    EXPECT_EQ((void*)copyBlob->buffer(), buffer);
+    EXPECT_EQ(((float*)copyBlob->buffer())[0], 1.0f);
+
+    copyBlob.reset();
+    pool.setMaxPooledBytes(maxPooledBytes);
+}
+
+TEST(OVUtils, HostBlobIsNotCopiedToHost) {
+    const InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, 10}, InferenceEngine::Layout::NC};
+    std::vector<float> data(10, 1.0f);
+    InferenceEngine::Blob::Ptr blob = InferenceEngine::make_shared_blob<float>(desc, data.data());
+    EXPECT_FALSE(ovms::isRemoteBlob(blob));
+    EXPECT_EQ(ovms::blobToHost(blob), blob);
+}
+
+TEST(OVUtils, SmallOrAlignedContentIsNotRealigned) {
+    std::string small(ovms::CONTENT_REALIGNMENT_MIN_BYTES - 1, 'a');
+    EXPECT_FALSE(ovms::contentRequiresRealignment(small));
+
+    std::string large(ovms::CONTENT_REALIGNMENT_MIN_BYTES + ovms::CONTENT_ALIGNMENT, 'a');
+    const bool aligned = reinterpret_cast<uintptr_t>(large.data()) % ovms::CONTENT_ALIGNMENT == 0;
+    EXPECT_EQ(ovms::contentRequiresRealignment(large), !aligned);
+}
+
+TEST(OVUtils, RealignedBlobIsAlignedCopyOfContent) {
+    const size_t count = ovms::CONTENT_REALIGNMENT_MIN_BYTES / sizeof(float);
+    std::vector<float> values(count);
+    std::iota(values.begin(), values.end(), 0.0f);
+    std::string content(reinterpret_cast<const char*>(values.data()), count * sizeof(float));
+
+    InferenceEngine::TensorDesc desc(InferenceEngine::Precision::FP32, {1, count}, InferenceEngine::Layout::NC);
+    auto blob = ovms::blobRealignedFromContent(desc, content);
+    ASSERT_NE(blob, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(blob->buffer().as<void*>()) % ovms::CONTENT_ALIGNMENT, 0);
+    EXPECT_EQ(std::memcmp(blob->buffer().as<const void*>(), values.data(), count * sizeof(float)), 0);
+}
@@ -14,8 +14,10 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <optional>
 #include <random>
 #include <string>
 #include <thread>
@@ -23,8 +25,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "../modelmetrics.hpp"
 #include "../ovinferrequestsqueue.hpp"
-#define DEBUG
 #include "../timer.hpp"
 
 using namespace testing;
@@ -37,14 +39,14 @@ TEST(OVInferRequestQueue, ShortQueue) {
     InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
     ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, 3);
     int reqid;
-    reqid = inferRequestsQueue.getIdleStream().get();
+    reqid = inferRequestsQueue.getIdleStream();
     EXPECT_EQ(reqid, 0);
-    reqid = inferRequestsQueue.getIdleStream().get();
+    reqid = inferRequestsQueue.getIdleStream();
     EXPECT_EQ(reqid, 1);
-    reqid = inferRequestsQueue.getIdleStream().get();
+    reqid = inferRequestsQueue.getIdleStream();
     EXPECT_EQ(reqid, 2);
     inferRequestsQueue.returnStream(0);
-    reqid = inferRequestsQueue.getIdleStream().get();
+    reqid = inferRequestsQueue.getIdleStream();
     EXPECT_EQ(reqid, 0);
 }
 
@@ -54,28 +56,29 @@ void releaseStream(ovms::OVInferRequestsQueue& requestsQueue) {
 }
 
 TEST(OVInferRequestQueue, FullQueue) {
-    Timer timer;
+    enum : size_t { QUEUE, TIMER_END };
+    Timer<TIMER_END> timer;
     InferenceEngine::Core engine;
     InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
     InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
     ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, 50);
     int reqid;
     for (int i = 0; i < 50; i++) {
-        reqid = inferRequestsQueue.getIdleStream().get();
+        reqid = inferRequestsQueue.getIdleStream();
     }
-    timer.start("queue");
+    timer.start(QUEUE);
     std::thread th(&releaseStream, std::ref(inferRequestsQueue));
     th.detach();
-    reqid = inferRequestsQueue.getIdleStream().get();  // it should wait 1s for released request
-    timer.stop("queue");
+    reqid = inferRequestsQueue.getIdleStream();  // it should wait 1s for released request
+    timer.stop(QUEUE);
 
-    EXPECT_GT(timer.elapsed<std::chrono::microseconds>("queue"), 1'000'000);
+    EXPECT_GT(timer.elapsed<std::chrono::microseconds>(QUEUE), 1'000'000);
     EXPECT_EQ(reqid, 3);
 }
 
 void inferenceSimulate(ovms::OVInferRequestsQueue& ms, std::vector<int>& tv) {
     for (int i = 1; i <= 10; i++) {
-        int st = ms.getIdleStream().get();
+        int st = ms.getIdleStream();
         int rd = std::rand();
         tv[st] = rd;
         std::mt19937_64 eng{std::random_device{}()};
@@ -108,22 +111,274 @@ TEST(OVInferRequestQueue, MultiThread) {
     // wait for all thread to complete successfully
 }
 
-TEST(OVInferRequestQueue, AsyncGetInferRequest) {
+TEST(OVInferRequestQueue, TryGetInferRequest) {
     InferenceEngine::Core engine;
     InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
     InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
     const int nireq = 1;
     ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq);
 
-    std::future<int> firstStreamRequest = inferRequestsQueue.getIdleStream();
-    std::future<int> secondStreamRequest = inferRequestsQueue.getIdleStream();
+    std::optional<int> firstStreamId = inferRequestsQueue.tryGetIdleStream(std::chrono::microseconds(1));
+    ASSERT_TRUE(firstStreamId.has_value());
+    EXPECT_FALSE(inferRequestsQueue.tryGetIdleStream(std::chrono::milliseconds(1)).has_value());
 
-    EXPECT_EQ(std::future_status::ready, firstStreamRequest.wait_for(std::chrono::microseconds(1)));
-    EXPECT_EQ(std::future_status::timeout, secondStreamRequest.wait_for(std::chrono::milliseconds(1)));
+    inferRequestsQueue.returnStream(firstStreamId.value());
+    std::optional<int> secondStreamId = inferRequestsQueue.tryGetIdleStream(std::chrono::microseconds(1));
+    ASSERT_TRUE(secondStreamId.has_value());
+    EXPECT_EQ(firstStreamId.value(), secondStreamId.value());
+}
+
+TEST(OVInferRequestQueue, TryGetInferRequestWakesUpOnReturn) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 3;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq);
+    for (int i = 0; i < nireq; i++) {
+        inferRequestsQueue.getIdleStream();
+    }
+    std::thread th([&inferRequestsQueue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        inferRequestsQueue.returnStream(1);
+    });
+    std::optional<int> streamId = inferRequestsQueue.tryGetIdleStream(std::chrono::seconds(5));
+    th.join();
+    ASSERT_TRUE(streamId.has_value());
+    EXPECT_EQ(streamId.value(), 1);
+}
+
+TEST(OVInferRequestQueue, RejectWhenQueueIsFull) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 1;
+    const size_t maxQueueSize = 1;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, maxQueueSize);
+    int streamId;
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(streamId), ovms::StatusCode::OK);
+
+    int queuedStreamId = -1;
+    std::thread queued([&inferRequestsQueue, &queuedStreamId]() {
+        EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(queuedStreamId), ovms::StatusCode::OK);
+    });
+    while (inferRequestsQueue.getStatistics().queueDepth == 0) {
+        std::this_thread::yield();
+    }
+    int rejectedStreamId;
+    EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(rejectedStreamId), ovms::StatusCode::REQUEST_QUEUE_FULL);
+    inferRequestsQueue.returnStream(streamId);
+    queued.join();
+    EXPECT_EQ(queuedStreamId, streamId);
+
+    auto statistics = inferRequestsQueue.getStatistics();
+    EXPECT_EQ(statistics.queueDepth, 0);
+    EXPECT_EQ(statistics.queuedRequests, 1);
+    EXPECT_EQ(statistics.rejectedQueueFull, 1);
+    EXPECT_EQ(statistics.rejectedQueueTimeout, 0);
+}
+
+TEST(OVInferRequestQueue, RejectWhenQueueTimeExceeded) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 1;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, 0, std::chrono::milliseconds(5));
+    int streamId;
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(streamId), ovms::StatusCode::OK);
+    int rejectedStreamId;
+    EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(rejectedStreamId), ovms::StatusCode::REQUEST_QUEUE_TIMEOUT);
+
+    auto statistics = inferRequestsQueue.getStatistics();
+    EXPECT_EQ(statistics.rejectedQueueTimeout, 1);
+    EXPECT_GE(statistics.totalQueueWaitMicroseconds, 5000);
+}
+
+TEST(OVInferRequestQueue, DeadlineShortensQueueWait) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 1;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, 0, std::chrono::seconds(10));
+    int streamId;
+    EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(streamId, std::chrono::steady_clock::now() - std::chrono::milliseconds(1)),
+        ovms::StatusCode::DEADLINE_EXCEEDED);
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(streamId), ovms::StatusCode::OK);
+    int rejectedStreamId;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(rejectedStreamId, start + std::chrono::milliseconds(5)),
+        ovms::StatusCode::DEADLINE_EXCEEDED);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_EQ(inferRequestsQueue.getStatistics().rejectedQueueTimeout, 0);
+}
+
+TEST(OVInferRequestQueue, LowPriorityLeavesReservedStreams) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 2;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, 0, std::chrono::milliseconds(5), nullptr, 1);
+    int lowPriorityStreamId;
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(lowPriorityStreamId, std::nullopt, ovms::RequestPriority::LOW), ovms::StatusCode::OK);
+    int rejectedStreamId;
+    EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(rejectedStreamId, std::nullopt, ovms::RequestPriority::LOW), ovms::StatusCode::REQUEST_QUEUE_TIMEOUT);
+    int highPriorityStreamId;
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(highPriorityStreamId), ovms::StatusCode::OK);
+    EXPECT_NE(lowPriorityStreamId, highPriorityStreamId);
+    inferRequestsQueue.returnStream(lowPriorityStreamId);
+    inferRequestsQueue.returnStream(highPriorityStreamId);
+}
+
+TEST(OVInferRequestQueue, TryGetIdleStreamLeavesReservedStreamsToHighPriority) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 2;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, 0, std::chrono::microseconds(0), nullptr, 1);
+    auto lowPriorityStreamId = inferRequestsQueue.tryGetIdleStream(std::chrono::microseconds(0), ovms::RequestPriority::LOW);
+    ASSERT_TRUE(lowPriorityStreamId.has_value());
+    EXPECT_FALSE(inferRequestsQueue.tryGetIdleStream(std::chrono::microseconds(0), ovms::RequestPriority::LOW).has_value());
+    auto highPriorityStreamId = inferRequestsQueue.tryGetIdleStream();
+    ASSERT_TRUE(highPriorityStreamId.has_value());
+    EXPECT_FALSE(inferRequestsQueue.tryGetIdleStream().has_value());
+    inferRequestsQueue.returnStream(lowPriorityStreamId.value());
+    inferRequestsQueue.returnStream(highPriorityStreamId.value());
+}
 
-    const int firstStreamId = firstStreamRequest.get();
+TEST(OVInferRequestQueue, LowPriorityWaitersAreBounded) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 2;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, 0, std::chrono::microseconds(0), nullptr, 1, 1);
+    int lowPriorityStreamId;
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(lowPriorityStreamId, std::nullopt, ovms::RequestPriority::LOW), ovms::StatusCode::OK);
+    std::atomic<bool> queuedAcquired{false};
+    int queuedStreamId;
+    std::thread queued([&]() {
+        EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(queuedStreamId, std::nullopt, ovms::RequestPriority::LOW), ovms::StatusCode::OK);
+        queuedAcquired = true;
+    });
+    while (inferRequestsQueue.getStatistics().queueDepth == 0) {
+        std::this_thread::yield();
+    }
+    int rejectedStreamId;
+    EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(rejectedStreamId, std::nullopt, ovms::RequestPriority::LOW), ovms::StatusCode::REQUEST_QUEUE_FULL);
+    int highPriorityStreamId;
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(highPriorityStreamId), ovms::StatusCode::OK);
+    // single idle stream stays reserved
+    inferRequestsQueue.returnStream(lowPriorityStreamId);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(queuedAcquired);
+    inferRequestsQueue.returnStream(highPriorityStreamId);
+    queued.join();
+    EXPECT_TRUE(queuedAcquired);
+    inferRequestsQueue.returnStream(queuedStreamId);
+}
+
+TEST(OVInferRequestQueue, StreamReturnedListenerNotifiedUntilRemoved) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 1;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq);
+    std::atomic<int> notifications{0};
+    uint64_t listenerId = inferRequestsQueue.addStreamReturnedListener([&notifications]() { notifications++; });
+
+    int streamId = inferRequestsQueue.getIdleStream();
+    inferRequestsQueue.returnStream(streamId);
+    EXPECT_EQ(notifications, 1);
+
+    inferRequestsQueue.removeStreamReturnedListener(listenerId);
+    streamId = inferRequestsQueue.getIdleStream();
+    inferRequestsQueue.returnStream(streamId);
+    EXPECT_EQ(notifications, 1);
+}
+
+TEST(OVInferRequestQueue, ReportsUtilizationToMetrics) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 2;
+    ovms::ModelMetrics modelMetrics("infer_requests_queue_metrics", 1);
+    auto& metrics = modelMetrics.inferRequestsQueue;
+    const auto initialAcquisitions = metrics.acquisition.getCount();
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, 0, std::chrono::microseconds(0), &metrics);
+
+    int firstStreamId = inferRequestsQueue.getIdleStream();
+    int secondStreamId = inferRequestsQueue.getIdleStream();
+    EXPECT_EQ(metrics.streamsInUse.get(), 2);
+    EXPECT_EQ(metrics.waiters.get(), 0);
+
+    std::thread waiting([&inferRequestsQueue]() {
+        inferRequestsQueue.returnStream(inferRequestsQueue.getIdleStream());
+    });
+    while (metrics.waiters.get() == 0) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
     inferRequestsQueue.returnStream(firstStreamId);
-    EXPECT_EQ(std::future_status::ready, secondStreamRequest.wait_for(std::chrono::microseconds(1)));
-    const int secondStreamId = secondStreamRequest.get();
-    EXPECT_EQ(firstStreamId, secondStreamId);
+    waiting.join();
+    inferRequestsQueue.returnStream(secondStreamId);
+
+    EXPECT_EQ(metrics.streamsInUse.get(), 0);
+    EXPECT_EQ(metrics.waiters.get(), 0);
+    EXPECT_EQ(metrics.acquisition.getCount(), initialAcquisitions + 3);
+    // waiting acquisition took at least 10 ms
+    EXPECT_GE(metrics.acquisition.getSum(), 0.01);
+}
+
+TEST(OVInferRequestQueue, ReportsRequestQueueToMetrics) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 1;
+    ovms::ModelMetrics modelMetrics("infer_requests_queue_limits_metrics", 1);
+    auto& metrics = modelMetrics.inferRequestsQueue;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq, 0, std::chrono::milliseconds(5), &metrics);
+    int streamId;
+    ASSERT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(streamId), ovms::StatusCode::OK);
+    int rejectedStreamId;
+    EXPECT_EQ(inferRequestsQueue.getIdleStreamWithinQueueLimits(rejectedStreamId), ovms::StatusCode::REQUEST_QUEUE_TIMEOUT);
+    inferRequestsQueue.returnStream(streamId);
+
+    EXPECT_EQ(metrics.queueDepth.get(), 0);
+    EXPECT_EQ(metrics.queuedRequests.get(), 1);
+    EXPECT_EQ(metrics.rejectedQueueFull.get(), 0);
+    EXPECT_EQ(metrics.rejectedQueueTimeout.get(), 1);
+    EXPECT_GE(metrics.queueWaitMicroseconds.get(), 5000);
+    const auto text = ovms::MetricsRegistry::getInstance().serialize();
+    const std::string labels = "{name=\"infer_requests_queue_limits_metrics\",version=\"1\"";
+    EXPECT_NE(text.find("ovms_request_queue_depth" + labels + "} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("ovms_request_queue_queued_total" + labels + "} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("ovms_request_queue_rejections_total" + labels + ",reason=\"full\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("ovms_request_queue_rejections_total" + labels + ",reason=\"timeout\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("ovms_request_queue_wait_microseconds_total" + labels + "}"), std::string::npos);
+}
+
+TEST(OVInferRequestQueue, CompletionTimeEstimateGrowsWithBusyStreams) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    const int nireq = 2;
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, nireq);
+    // pool which has not been measured yet is preferred
+    EXPECT_EQ(inferRequestsQueue.estimateCompletionTime(), std::chrono::microseconds(0));
+
+    inferRequestsQueue.recordInferenceLatency(std::chrono::microseconds(1000));
+    EXPECT_EQ(inferRequestsQueue.estimateCompletionTime(), std::chrono::microseconds(500));
+    int firstStreamId = inferRequestsQueue.getIdleStream();
+    EXPECT_EQ(inferRequestsQueue.estimateCompletionTime(), std::chrono::microseconds(1000));
+    EXPECT_EQ(inferRequestsQueue.getBusyStreamsCount(), 1);
+    int secondStreamId = inferRequestsQueue.getIdleStream();
+    EXPECT_EQ(inferRequestsQueue.estimateCompletionTime(), std::chrono::microseconds(1500));
+    EXPECT_EQ(inferRequestsQueue.getBusyStreamsCount(), 2);
+    inferRequestsQueue.returnStream(firstStreamId);
+    inferRequestsQueue.returnStream(secondStreamId);
+    EXPECT_EQ(inferRequestsQueue.getBusyStreamsCount(), 0);
+
+    // average follows recent latencies
+    for (int i = 0; i < 64; ++i) {
+        inferRequestsQueue.recordInferenceLatency(std::chrono::microseconds(3000));
+    }
+    EXPECT_NEAR(inferRequestsQueue.estimateCompletionTime().count(), 1500, 50);
 }
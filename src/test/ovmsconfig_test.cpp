@@ -165,6 +165,18 @@ TEST_F(DISABLED_OvmsConfigTest, negativeGrpcWorkersMax) {
     EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "grpc_workers count should be from 1");
 }
 
+TEST_F(DISABLED_OvmsConfigTest, negativeGrpcPollingThreadsMax) {
+    char* n_argv[] = {"ovms", "--model_path", "/path1", "--model_name", "model", "--grpc_polling_threads", "10000"};
+    int arg_count = 7;
+    EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "grpc_polling_threads count should be from 0");
+}
+
+TEST_F(DISABLED_OvmsConfigTest, negativeGrpcNumaPinningWithoutAsync) {
+    char* n_argv[] = {"ovms", "--model_path", "/path1", "--model_name", "model", "--grpc_numa_pinning", "true"};
+    int arg_count = 7;
+    EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "grpc_numa_pinning requires grpc_async");
+}
+
 TEST_F(DISABLED_OvmsConfigTest, negativeUint64Max) {
     char* n_argv[] = {"ovms", "--config_path", "/path1", "--rest_port", "0xffffffffffffffff"};
     int arg_count = 5;
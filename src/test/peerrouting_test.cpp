@@ -0,0 +1,85 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <gtest/gtest.h>
+
+#include "../peerrouting.hpp"
+
+using namespace ovms;
+
+TEST(PeerRouting, ServedModelsRoundTrip) {
+    served_models_t models;
+    models["resnet"].versions = {1, 3};
+    models["resnet"].load = 2;
+    models["ssd"].versions = {7};
+    google::protobuf::Struct message;
+    serializeServedModels(models, message);
+
+    served_models_t parsed;
+    ASSERT_EQ(deserializeServedModels(message, parsed), StatusCode::OK);
+    ASSERT_EQ(parsed.size(), 2);
+    EXPECT_EQ(parsed["resnet"].versions, (std::set<model_version_t>{1, 3}));
+    EXPECT_EQ(parsed["resnet"].load, 2);
+    EXPECT_EQ(parsed["ssd"].versions, (std::set<model_version_t>{7}));
+    EXPECT_EQ(parsed["ssd"].load, 0);
+}
+
+TEST(PeerRouting, RejectsInvalidServedModels) {
+    google::protobuf::Struct message;
+    served_models_t parsed;
+    EXPECT_EQ(deserializeServedModels(message, parsed), StatusCode::JSON_INVALID);
+
+    auto& model = *(*(*message.mutable_fields())["models"].mutable_struct_value()->mutable_fields())["resnet"].mutable_struct_value()->mutable_fields();
+    model["versions"].mutable_list_value()->add_values()->set_string_value("1");
+    EXPECT_EQ(deserializeServedModels(message, parsed), StatusCode::JSON_INVALID);
+    EXPECT_TRUE(parsed.empty());
+}
+
+TEST(PeerRouting, SelectsLeastLoadedPeerServingVersion) {
+    PeerTable table(3);
+    EXPECT_FALSE(table.select("resnet", 0));
+
+    served_models_t first, second, third;
+    first["resnet"].versions = {1};
+    first["resnet"].load = 4;
+    second["resnet"].versions = {1, 2};
+    second["resnet"].load = 1;
+    third["ssd"].versions = {1};
+    table.update(0, first);
+    table.update(1, second);
+    table.update(2, third);
+
+    EXPECT_EQ(table.select("resnet", 0), 1);
+    EXPECT_EQ(table.select("resnet", 1), 1);
+    EXPECT_EQ(table.select("resnet", 2), 1);
+    EXPECT_FALSE(table.select("resnet", 3));
+    EXPECT_EQ(table.select("ssd", 0), 2);
+    EXPECT_TRUE(table.serves("resnet"));
+    EXPECT_FALSE(table.serves("bert"));
+
+    // requests forwarded since the last advertisement count as load
+    for (int i = 0; i < 4; i++) {
+        table.startForwarding(1);
+    }
+    EXPECT_EQ(table.select("resnet", 1), 0);
+    table.finishForwarding(1);
+    table.finishForwarding(1);
+    EXPECT_EQ(table.select("resnet", 1), 1);
+
+    // peer which stopped answering serves nothing
+    table.update(1, {});
+    EXPECT_EQ(table.select("resnet", 0), 0);
+    EXPECT_FALSE(table.select("resnet", 2));
+}
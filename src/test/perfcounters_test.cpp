@@ -0,0 +1,80 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../perfcounters.hpp"
+
+using ovms::PerfCountersCollector;
+
+namespace {
+InferenceEngine::InferenceEngineProfileInfo makeLayerInfo(const char* layerType, long long realTime, long long cpuTime, bool executed = true) {
+    InferenceEngine::InferenceEngineProfileInfo info{};
+    info.status = executed ? InferenceEngine::InferenceEngineProfileInfo::EXECUTED : InferenceEngine::InferenceEngineProfileInfo::OPTIMIZED_OUT;
+    info.realTime_uSec = realTime;
+    info.cpu_uSec = cpuTime;
+    std::strncpy(info.layer_type, layerType, sizeof(info.layer_type) - 1);
+    std::strncpy(info.exec_type, "jit_avx2_FP32", sizeof(info.exec_type) - 1);
+    return info;
+}
+}  // namespace
+
+TEST(PerfCountersCollector, LayersAveragedAndSortedByRealTime) {
+    PerfCountersCollector collector(2);
+    collector.add({{"conv", makeLayerInfo("Convolution", 100, 90)}, {"relu", makeLayerInfo("ReLU", 10, 10)}});
+    collector.add({{"conv", makeLayerInfo("Convolution", 300, 270)}, {"relu", makeLayerInfo("ReLU", 30, 30)}});
+    EXPECT_EQ(collector.getCollectedCount(), 2);
+    EXPECT_TRUE(collector.waitForCompletion(std::chrono::milliseconds(0)));
+    const auto json = collector.toJson();
+    EXPECT_NE(json.find("\"inferences\":2"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"avg_real_time_us\":220"), std::string::npos) << json;
+    auto conv = json.find("\"name\":\"conv\"");
+    auto relu = json.find("\"name\":\"relu\"");
+    ASSERT_NE(conv, std::string::npos);
+    ASSERT_NE(relu, std::string::npos);
+    EXPECT_LT(conv, relu);
+    const auto convJson = json.substr(conv, relu - conv);
+    EXPECT_NE(convJson.find("\"layer_type\":\"Convolution\",\"exec_type\":\"jit_avx2_FP32\",\"executed\":2,\"avg_real_time_us\":200"), std::string::npos) << json;
+    EXPECT_NE(convJson.find("\"avg_cpu_time_us\":180"), std::string::npos) << json;
+}
+
+TEST(PerfCountersCollector, NotExecutedLayersReportedWithoutTime) {
+    PerfCountersCollector collector(1);
+    collector.add({{"conv", makeLayerInfo("Convolution", 100, 90)}, {"reshape", makeLayerInfo("Reshape", 5, 5, false)}});
+    const auto json = collector.toJson();
+    EXPECT_NE(json.find("\"name\":\"reshape\",\"layer_type\":\"Reshape\",\"exec_type\":\"jit_avx2_FP32\",\"executed\":0,\"avg_real_time_us\":0"), std::string::npos) << json;
+}
+
+TEST(PerfCountersCollector, InferencesAboveRequestedCountIgnored) {
+    PerfCountersCollector collector(1);
+    collector.add({{"conv", makeLayerInfo("Convolution", 100, 90)}});
+    collector.add({{"conv", makeLayerInfo("Convolution", 500, 500)}});
+    EXPECT_EQ(collector.getCollectedCount(), 1);
+    EXPECT_NE(collector.toJson().find("\"avg_real_time_us\":100"), std::string::npos);
+}
+
+TEST(PerfCountersCollector, WaitTimesOutWhenNotEnoughInferences) {
+    PerfCountersCollector collector(2);
+    collector.add({{"conv", makeLayerInfo("Convolution", 100, 90)}});
+    EXPECT_FALSE(collector.waitForCompletion(std::chrono::milliseconds(10)));
+    std::thread inference([&collector]() { collector.add({{"conv", makeLayerInfo("Convolution", 100, 90)}}); });
+    EXPECT_TRUE(collector.waitForCompletion(std::chrono::seconds(10)));
+    inference.join();
+}
@@ -0,0 +1,149 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "../pipeline.hpp"
+#include "../pipeline_tracer.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+class PipelineTracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        request = preparePredictRequest(
+            {{inputName,
+                std::tuple<ovms::shape_t, tensorflow::DataType>{{1, DUMMY_MODEL_INPUT_SIZE}, tensorflow::DataType::DT_FLOAT}}});
+    }
+
+    void TearDown() override {
+        PipelineTracer::getInstance().configure("", 0);
+        std::remove(tracePath.c_str());
+    }
+
+    rapidjson::Document readTrace() {
+        std::ifstream file(tracePath);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        // trace file is an array left open, last event is followed by comma
+        std::string content = ss.str();
+        auto lastComma = content.rfind(',');
+        if (lastComma != std::string::npos) {
+            content.erase(lastComma);
+        }
+        content += "]";
+        rapidjson::Document document;
+        document.Parse(content.c_str());
+        return document;
+    }
+
+    static size_t countEvents(const rapidjson::Document& document, const std::string& name) {
+        size_t count = 0;
+        for (const auto& event : document.GetArray()) {
+            if (event["name"].GetString() == name) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    const std::string tracePath = "/tmp/ovms_pipeline_trace_test.json";
+    const std::string inputName = "pipeline_input";
+    const std::string outputName = "pipeline_output";
+    tensorflow::serving::PredictRequest request;
+    tensorflow::serving::PredictResponse response;
+};
+
+TEST_F(PipelineTracerTest, TracingDisabledByDefault) {
+    EXPECT_EQ(PipelineTracer::getInstance().startTrace("pipeline", 2), nullptr);
+}
+
+TEST_F(PipelineTracerTest, SamplingRateSpreadsTracedExecutions) {
+    ASSERT_EQ(PipelineTracer::getInstance().configure(tracePath, 0.25), StatusCode::OK);
+    size_t traced = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        if (PipelineTracer::getInstance().startTrace("pipeline", 2) != nullptr) {
+            ++traced;
+        }
+    }
+    EXPECT_EQ(traced, 2);
+}
+
+TEST_F(PipelineTracerTest, ZeroSamplingRateDisablesTracing) {
+    ASSERT_EQ(PipelineTracer::getInstance().configure(tracePath, 0), StatusCode::OK);
+    EXPECT_EQ(PipelineTracer::getInstance().startTrace("pipeline", 2), nullptr);
+}
+
+TEST_F(PipelineTracerTest, WrongTracePath) {
+    EXPECT_EQ(PipelineTracer::getInstance().configure("/not/existing/dir/trace.json", 1), StatusCode::FILE_INVALID);
+    EXPECT_EQ(PipelineTracer::getInstance().startTrace("pipeline", 2), nullptr);
+}
+
+TEST_F(PipelineTracerTest, PipelineExecutionWrittenAsChromeTraceEvents) {
+    ASSERT_EQ(PipelineTracer::getInstance().configure(tracePath, 1), StatusCode::OK);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    Pipeline pipeline(*input_node, *output_node, "traced_pipeline");
+    pipeline.connect(*input_node, *output_node, {{inputName, outputName}});
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+    ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+
+    auto document = readTrace();
+    ASSERT_FALSE(document.HasParseError());
+    ASSERT_TRUE(document.IsArray());
+    EXPECT_EQ(countEvents(document, "pipeline"), 2);
+    // request and response nodes of both executions
+    EXPECT_EQ(countEvents(document, "execution"), 4);
+    // only request node passes its results to other nodes
+    EXPECT_EQ(countEvents(document, "passing inputs"), 2);
+    EXPECT_EQ(countEvents(document, "waiting for stream"), 4);
+    for (const auto& event : document.GetArray()) {
+        if (std::string(event["ph"].GetString()) == "X") {
+            EXPECT_GE(event["dur"].GetDouble(), 0);
+        }
+    }
+}
+
+TEST_F(PipelineTracerTest, RequestTimingFilledWhenTracingDisabled) {
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    Pipeline pipeline(*input_node, *output_node, "timed_pipeline");
+    pipeline.connect(*input_node, *output_node, {{inputName, outputName}});
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    RequestTiming timing;
+    ASSERT_EQ(pipeline.execute(&timing), StatusCode::OK);
+
+    std::vector<std::string> stages;
+    for (const auto& [stage, milliseconds] : timing.getStages()) {
+        EXPECT_GE(milliseconds, 0);
+        stages.push_back(stage);
+    }
+    EXPECT_THAT(stages, ::testing::ElementsAre("pipeline", "node.request.stream_wait", "node.request",
+                            "node.response.stream_wait", "node.response"));
+}
@@ -0,0 +1,112 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../pipeline_factory.hpp"
+#include "../pipelinebenchmark/pipelinebenchmark.hpp"
+#include "../status.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+using namespace ovms::pipelinebenchmark;
+
+using testing::HasSubstr;
+
+class PipelineBenchmarkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        manager.reloadModelWithVersions(DUMMY_MODEL_CONFIG);
+    }
+
+    Status createDummyPipeline(NodeKind consumerKind = NodeKind::DL) {
+        std::vector<NodeInfo> info{
+            {NodeKind::ENTRY, "request"},
+            {NodeKind::DL, "dummy_node", "dummy"},
+            {NodeKind::EXIT, "response"},
+        };
+        std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+        connections["dummy_node"] = {
+            {"request", {{"pipeline_input", DUMMY_MODEL_INPUT_NAME}}}};
+        connections["response"] = {
+            {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, "pipeline_output"}}}};
+        if (consumerKind == NodeKind::EXIT) {
+            connections["response"]["request"] = {{"passed_through_input", "passed_through_output"}};
+        }
+        return factory.createDefinition("pipeline", info, connections, manager);
+    }
+
+    ConstructorEnabledModelManager manager;
+    PipelineFactory factory;
+};
+
+TEST_F(PipelineBenchmarkTest, InputsInfoOfPipelineAreTakenFromConsumingModel) {
+    ASSERT_EQ(createDummyPipeline(), StatusCode::OK);
+    tensor_map_t inputsInfo;
+    ASSERT_EQ(factory.getInputsInfo("pipeline", inputsInfo, manager), StatusCode::OK);
+    ASSERT_EQ(inputsInfo.size(), 1);
+    ASSERT_EQ(inputsInfo.count("pipeline_input"), 1);
+    EXPECT_EQ(inputsInfo.at("pipeline_input")->getShape(), (shape_t{1, DUMMY_MODEL_INPUT_SIZE}));
+    EXPECT_EQ(inputsInfo.at("pipeline_input")->getPrecision(), InferenceEngine::Precision::FP32);
+}
+
+TEST_F(PipelineBenchmarkTest, InputsInfoUnavailableWhenInputIsNotConsumedByModel) {
+    ASSERT_EQ(createDummyPipeline(NodeKind::EXIT), StatusCode::OK);
+    tensor_map_t inputsInfo;
+    EXPECT_EQ(factory.getInputsInfo("pipeline", inputsInfo, manager), StatusCode::PIPELINE_INPUTS_INFO_UNAVAILABLE);
+    EXPECT_EQ(factory.getInputsInfo("missing", inputsInfo, manager), StatusCode::PIPELINE_DEFINITION_NAME_MISSING);
+}
+
+TEST_F(PipelineBenchmarkTest, SyntheticRequestMatchesInputsOfModel) {
+    ASSERT_EQ(createDummyPipeline(), StatusCode::OK);
+    PipelineBenchmark benchmark(factory, manager, "pipeline");
+    ASSERT_EQ(benchmark.prepareRequest(), StatusCode::OK);
+    const auto& request = benchmark.getRequest();
+    EXPECT_EQ(request.model_spec().name(), "pipeline");
+    ASSERT_EQ(request.inputs().count("pipeline_input"), 1);
+    const auto& input = request.inputs().at("pipeline_input");
+    EXPECT_EQ(input.dtype(), tensorflow::DataType::DT_FLOAT);
+    ASSERT_EQ(input.tensor_shape().dim_size(), 2);
+    EXPECT_EQ(input.tensor_shape().dim(0).size(), 1);
+    EXPECT_EQ(input.tensor_shape().dim(1).size(), DUMMY_MODEL_INPUT_SIZE);
+    EXPECT_EQ(input.tensor_content().size(), DUMMY_MODEL_INPUT_SIZE * sizeof(float));
+}
+
+TEST_F(PipelineBenchmarkTest, RunReportsEndToEndAndNodeLatencies) {
+    ASSERT_EQ(createDummyPipeline(), StatusCode::OK);
+    PipelineBenchmark benchmark(factory, manager, "pipeline");
+    ASSERT_EQ(benchmark.prepareRequest(), StatusCode::OK);
+    BenchmarkResult result;
+    benchmark.run(2, std::chrono::milliseconds(200), result);
+    EXPECT_EQ(result.concurrency, 2);
+    EXPECT_GT(result.succeeded, 0);
+    EXPECT_TRUE(result.errors.empty());
+    EXPECT_EQ(result.latency.getCount(), result.succeeded);
+    ASSERT_EQ(result.stages.count("node.dummy_node"), 1);
+    EXPECT_EQ(result.stages.at("node.dummy_node").getCount(), result.succeeded);
+    EXPECT_GT(result.getThroughput(), 0);
+
+    std::stringstream report;
+    PipelineBenchmark::printReport(report, result);
+    EXPECT_THAT(report.str(), HasSubstr("concurrency: 2"));
+    EXPECT_THAT(report.str(), HasSubstr("node.dummy_node throughput"));
+}
@@ -0,0 +1,156 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../postprocessing.hpp"
+
+using namespace ovms;
+using testing::ElementsAre;
+
+TEST(Postprocessing, SelectTopK) {
+    std::vector<float> scores(100);
+    for (size_t i = 0; i < scores.size(); ++i) {
+        scores[i] = static_cast<float>(i % 10);
+    }
+    scores[57] = 50;
+    OutputPostprocessingInfo info;
+    info.topK = 3;
+    std::vector<float> topScores(3);
+    std::vector<int32_t> topIndices(3);
+    selectTopK(scores.data(), 1, scores.size(), info, topScores.data(), topIndices.data());
+    EXPECT_THAT(topScores, ElementsAre(50, 9, 9));
+    // equal scores keep lower index first
+    EXPECT_THAT(topIndices, ElementsAre(57, 9, 19));
+}
+
+TEST(Postprocessing, SelectArgmaxPerRow) {
+    const std::vector<float> scores{0.1, 0.7, 0.2, 0.6, 0.3, 0.1};
+    OutputPostprocessingInfo info;
+    std::vector<float> topScores(2);
+    std::vector<int32_t> topIndices(2);
+    selectTopK(scores.data(), 2, 3, info, topScores.data(), topIndices.data());
+    EXPECT_THAT(topScores, ElementsAre(0.7f, 0.6f));
+    EXPECT_THAT(topIndices, ElementsAre(1, 0));
+}
+
+TEST(Postprocessing, MinScore) {
+    const std::vector<float> scores{0.05, 0.8, 0.15};
+    OutputPostprocessingInfo info;
+    info.topK = 3;
+    info.minScore = 0.1;
+    std::vector<float> topScores(3);
+    std::vector<int32_t> topIndices(3);
+    selectTopK(scores.data(), 1, 3, info, topScores.data(), topIndices.data());
+    EXPECT_THAT(topScores, ElementsAre(0.8f, 0.15f, 0));
+    EXPECT_THAT(topIndices, ElementsAre(1, 2, -1));
+}
+
+TEST(Postprocessing, Response) {
+    tensorflow::serving::PredictResponse response;
+    auto& output = (*response.mutable_outputs())["prob"];
+    output.set_dtype(tensorflow::DataType::DT_FLOAT);
+    output.mutable_tensor_shape()->add_dim()->set_size(2);
+    output.mutable_tensor_shape()->add_dim()->set_size(4);
+    const std::vector<float> scores{1, 4, 3, 2, 8, 5, 6, 7};
+    output.mutable_tensor_content()->assign(reinterpret_cast<const char*>(scores.data()), scores.size() * sizeof(float));
+    (*response.mutable_outputs())["other"].set_dtype(tensorflow::DataType::DT_INT32);
+
+    postprocessing_map_t postprocessing;
+    postprocessing["prob"].topK = 2;
+    postprocessing["missing"].topK = 2;
+    ASSERT_EQ(postprocessResponse(postprocessing, response), StatusCode::OK);
+
+    const auto& top = response.outputs().at("prob");
+    ASSERT_EQ(top.tensor_shape().dim_size(), 2);
+    EXPECT_EQ(top.tensor_shape().dim(0).size(), 2);
+    EXPECT_EQ(top.tensor_shape().dim(1).size(), 2);
+    std::vector<float> topScores(4);
+    ASSERT_EQ(top.tensor_content().size(), topScores.size() * sizeof(float));
+    std::memcpy(topScores.data(), top.tensor_content().data(), top.tensor_content().size());
+    EXPECT_THAT(topScores, ElementsAre(4, 3, 8, 7));
+
+    const auto& indices = response.outputs().at(std::string("prob") + POSTPROCESSING_INDICES_SUFFIX);
+    EXPECT_EQ(indices.dtype(), tensorflow::DataType::DT_INT32);
+    EXPECT_EQ(indices.tensor_shape().dim(1).size(), 2);
+    std::vector<int32_t> topIndices(4);
+    ASSERT_EQ(indices.tensor_content().size(), topIndices.size() * sizeof(int32_t));
+    std::memcpy(topIndices.data(), indices.tensor_content().data(), indices.tensor_content().size());
+    EXPECT_THAT(topIndices, ElementsAre(1, 2, 0, 3));
+    EXPECT_EQ(response.outputs().size(), 3);
+}
+
+TEST(Postprocessing, Validate) {
+    tensor_map_t outputs;
+    outputs["prob"] = std::make_shared<TensorInfo>("prob", InferenceEngine::Precision::FP32, shape_t{1, 1000});
+    outputs["labels"] = std::make_shared<TensorInfo>("labels", InferenceEngine::Precision::I32, shape_t{1, 1000});
+    postprocessing_map_t postprocessing;
+    postprocessing["prob"].topK = 5;
+    EXPECT_EQ(validatePostprocessing(postprocessing, outputs), StatusCode::OK);
+    postprocessing["prob"].topK = 1001;
+    EXPECT_EQ(validatePostprocessing(postprocessing, outputs), StatusCode::INVALID_POSTPROCESSING_OUTPUT);
+    postprocessing.clear();
+    postprocessing["labels"].topK = 5;
+    EXPECT_EQ(validatePostprocessing(postprocessing, outputs), StatusCode::INVALID_POSTPROCESSING_OUTPUT);
+    postprocessing.clear();
+    postprocessing["missing"].topK = 5;
+    EXPECT_EQ(validatePostprocessing(postprocessing, outputs), StatusCode::INVALID_POSTPROCESSING_OUTPUT);
+}
+
+TEST(Postprocessing, ConvertOutputPrecision) {
+    tensorflow::serving::PredictResponse response;
+    const std::vector<float> scores{1.0f, -2.5f, 0.125f};
+    const std::vector<int32_t> labels{7, 8, 9};
+    auto& prob = (*response.mutable_outputs())["prob"];
+    prob.set_dtype(tensorflow::DataType::DT_FLOAT);
+    prob.mutable_tensor_content()->assign(reinterpret_cast<const char*>(scores.data()), scores.size() * sizeof(float));
+    auto& other = (*response.mutable_outputs())["other"];
+    other.set_dtype(tensorflow::DataType::DT_FLOAT);
+    other.mutable_tensor_content()->assign(reinterpret_cast<const char*>(scores.data()), scores.size() * sizeof(float));
+    auto& ids = (*response.mutable_outputs())["labels"];
+    ids.set_dtype(tensorflow::DataType::DT_INT32);
+    ids.mutable_tensor_content()->assign(reinterpret_cast<const char*>(labels.data()), labels.size() * sizeof(int32_t));
+
+    precisions_map_t precisions{{"prob", "FP16"}, {"labels", "FP16"}};
+    ASSERT_EQ(convertOutputPrecision("", precisions, response), StatusCode::OK);
+    EXPECT_EQ(prob.dtype(), tensorflow::DataType::DT_HALF);
+    std::vector<uint16_t> half(3);
+    ASSERT_EQ(prob.tensor_content().size(), half.size() * sizeof(uint16_t));
+    std::memcpy(half.data(), prob.tensor_content().data(), prob.tensor_content().size());
+    EXPECT_THAT(half, ElementsAre(0x3C00, 0xC100, 0x3000));
+    // only named FP32 outputs are converted
+    EXPECT_EQ(other.dtype(), tensorflow::DataType::DT_FLOAT);
+    EXPECT_EQ(ids.dtype(), tensorflow::DataType::DT_INT32);
+    EXPECT_EQ(ids.tensor_content().size(), labels.size() * sizeof(int32_t));
+
+    ASSERT_EQ(convertOutputPrecision("FP16", {}, response), StatusCode::OK);
+    EXPECT_EQ(other.dtype(), tensorflow::DataType::DT_HALF);
+    EXPECT_EQ(other.tensor_content().size(), scores.size() * sizeof(uint16_t));
+}
+
+TEST(Postprocessing, ValidateOutputPrecision) {
+    tensor_map_t outputs;
+    outputs["prob"] = std::make_shared<TensorInfo>("prob", InferenceEngine::Precision::FP32, shape_t{1, 1000});
+    outputs["labels"] = std::make_shared<TensorInfo>("labels", InferenceEngine::Precision::I32, shape_t{1, 1000});
+    EXPECT_EQ(validateOutputPrecision({{"prob", "BF16"}}, outputs), StatusCode::OK);
+    EXPECT_EQ(validateOutputPrecision({{"labels", "BF16"}}, outputs), StatusCode::INVALID_OUTPUT_PRECISION);
+    EXPECT_EQ(validateOutputPrecision({{"missing", "FP16"}}, outputs), StatusCode::INVALID_OUTPUT_PRECISION);
+}
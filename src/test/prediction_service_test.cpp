@@ -18,7 +18,9 @@
 #include <filesystem>
 #include <fstream>
 #include <future>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -26,8 +28,10 @@
 #include <stdlib.h>
 
 #include "../executinstreamidguard.hpp"
+#include "../metrics.hpp"
 #include "../modelinstance.hpp"
 #include "../prediction_service_utils.hpp"
+#include "../requesttiming.hpp"
 #include "test_utils.hpp"
 
 using testing::Each;
@@ -478,3 +482,114 @@ TEST_F(TestPredict, ChangeBatchSizeViaRequestAndConfigChange) {
     ASSERT_EQ(performInferenceWithBatchSize(response, 3), StatusCode::OK);
     checkOutputShape(response, {3, 10});
 }
+
+TEST_F(TestPredict, SuccesfullAsyncInferenceOnDummyModel) {
+    config.setBatchingParams("1");
+    ASSERT_EQ(manager.reloadModelWithVersions(config), ovms::StatusCode::OK);
+    auto request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_FLOAT}}});
+    tensorflow::serving::PredictResponse response;
+    std::shared_ptr<ovms::ModelInstance> modelInstance;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(ovms::getModelInstance(manager, "dummy", 0, modelInstance, unloadGuard), ovms::StatusCode::OK);
+
+    std::promise<ovms::Status> completed;
+    auto completedFuture = completed.get_future();
+    ASSERT_EQ(ovms::inferenceAsync(modelInstance, &request, &response, unloadGuard,
+                  [&completed](const ovms::Status& status) { completed.set_value(status); }),
+        ovms::StatusCode::OK);
+    ASSERT_EQ(completedFuture.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(completedFuture.get(), ovms::StatusCode::OK);
+    checkOutputShape(response, {1, 10});
+    // stream and model instance are released after completion
+    EXPECT_TRUE(modelInstance->canUnloadInstance());
+}
+
+TEST_F(TestPredict, AsyncInferenceNotStartedOnInvalidRequest) {
+    config.setBatchingParams("1");
+    ASSERT_EQ(manager.reloadModelWithVersions(config), ovms::StatusCode::OK);
+    auto request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_INT32}}});
+    tensorflow::serving::PredictResponse response;
+    std::shared_ptr<ovms::ModelInstance> modelInstance;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(ovms::getModelInstance(manager, "dummy", 0, modelInstance, unloadGuard), ovms::StatusCode::OK);
+    bool called = false;
+    EXPECT_EQ(ovms::inferenceAsync(modelInstance, &request, &response, unloadGuard,
+                  [&called](const ovms::Status&) { called = true; }),
+        ovms::StatusCode::INVALID_PRECISION);
+    EXPECT_FALSE(called);
+}
+
+TEST_F(TestPredict, InferenceUpdatesModelMetrics) {
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    ASSERT_EQ(manager.reloadModelWithVersions(config), ovms::StatusCode::OK);
+    std::shared_ptr<ovms::ModelInstance> modelInstance;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(ovms::getModelInstance(manager, "dummy", 0, modelInstance, unloadGuard), ovms::StatusCode::OK);
+    auto& metrics = modelInstance->getMetrics();
+    const auto initialRequests = metrics.requests.get();
+    const auto initialQueueWaits = metrics.queueWait.getCount();
+    const auto initialDeserializations = metrics.deserialization.getCount();
+    const auto initialInferences = metrics.inference.getCount();
+    const auto initialSerializations = metrics.serialization.getCount();
+    unloadGuard.reset();
+
+    tensorflow::serving::PredictResponse response;
+    ASSERT_EQ(performInferenceWithShape(response, {1, 10}), ovms::StatusCode::OK);
+    ASSERT_EQ(performInferenceWithShape(response, {1, 10}, tensorflow::DataType::DT_INT32), ovms::StatusCode::INVALID_PRECISION);
+
+    EXPECT_EQ(metrics.requests.get(), initialRequests + 2);
+    // request with invalid precision is rejected by validation, before any stage
+    EXPECT_EQ(metrics.queueWait.getCount(), initialQueueWaits + 1);
+    EXPECT_EQ(metrics.deserialization.getCount(), initialDeserializations + 1);
+    EXPECT_EQ(metrics.inference.getCount(), initialInferences + 1);
+    EXPECT_EQ(metrics.serialization.getCount(), initialSerializations + 1);
+    const auto text = ovms::MetricsRegistry::getInstance().serialize();
+    EXPECT_NE(text.find("ovms_request_errors_total{name=\"dummy\",version=\"1\",code=\"" +
+                        std::to_string(static_cast<int>(ovms::StatusCode::INVALID_PRECISION)) + "\"}"),
+        std::string::npos);
+}
+
+TEST_F(TestPredict, InferenceAddsStagesToRequestTiming) {
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    ASSERT_EQ(manager.reloadModelWithVersions(config), ovms::StatusCode::OK);
+    std::shared_ptr<ovms::ModelInstance> modelInstance;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(ovms::getModelInstance(manager, "dummy", 0, modelInstance, unloadGuard), ovms::StatusCode::OK);
+    auto request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_FLOAT}}});
+    tensorflow::serving::PredictResponse response;
+    ovms::RequestTiming timing;
+    ASSERT_EQ(ovms::inference(*modelInstance, &request, &response, unloadGuard, &timing), ovms::StatusCode::OK);
+
+    std::vector<std::string> stages;
+    for (const auto& [stage, milliseconds] : timing.getStages()) {
+        EXPECT_GE(milliseconds, 0);
+        stages.push_back(stage);
+    }
+    EXPECT_THAT(stages, ::testing::ElementsAre("queue_wait", "deserialization", "inference", "serialization"));
+}
+
+TEST_F(TestPredict, OutputsWrittenDirectlyToResponseAreNotOverwrittenByNextInference) {
+    config.setBatchingParams("1");
+    config.setNireq(1);
+    ASSERT_EQ(manager.reloadModelWithVersions(config), ovms::StatusCode::OK);
+    auto firstRequest = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_FLOAT}}});
+    std::vector<float> firstData(DUMMY_MODEL_INPUT_SIZE, 1.0);
+    std::vector<float> secondData(DUMMY_MODEL_INPUT_SIZE, 5.0);
+    auto secondRequest = firstRequest;
+    (*firstRequest.mutable_inputs())[DUMMY_MODEL_INPUT_NAME].mutable_tensor_content()->assign(
+        reinterpret_cast<const char*>(firstData.data()), firstData.size() * sizeof(float));
+    (*secondRequest.mutable_inputs())[DUMMY_MODEL_INPUT_NAME].mutable_tensor_content()->assign(
+        reinterpret_cast<const char*>(secondData.data()), secondData.size() * sizeof(float));
+
+    tensorflow::serving::PredictResponse firstResponse, secondResponse;
+    ASSERT_EQ(performInferenceWithRequest(firstRequest, firstResponse), ovms::StatusCode::OK);
+    ASSERT_EQ(performInferenceWithRequest(secondRequest, secondResponse), ovms::StatusCode::OK);
+    checkOutputShape(firstResponse, {1, 10});
+    checkOutputShape(secondResponse, {1, 10});
+    EXPECT_THAT(asVector<float>(firstResponse.outputs().at(DUMMY_MODEL_OUTPUT_NAME).tensor_content()), Each(Eq(2.)));
+    EXPECT_THAT(asVector<float>(secondResponse.outputs().at(DUMMY_MODEL_OUTPUT_NAME).tensor_content()), Each(Eq(6.)));
+}
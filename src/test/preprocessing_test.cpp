@@ -0,0 +1,68 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "../preprocessing.hpp"
+
+using namespace ovms;
+
+namespace {
+InferenceEngine::InputsDataMap makeNetworkInputs(const InferenceEngine::SizeVector& dims) {
+    auto input = std::make_shared<InferenceEngine::InputInfo>();
+    input->setInputData(std::make_shared<InferenceEngine::Data>("data",
+        InferenceEngine::TensorDesc(InferenceEngine::Precision::FP32, dims, InferenceEngine::Layout::NCHW)));
+    return {{"data", input}};
+}
+}  // namespace
+
+TEST(Preprocessing, SetsPreProcessInfoOfNetworkInput) {
+    auto inputs = makeNetworkInputs({1, 3, 224, 224});
+    InputPreprocessingInfo info;
+    info.resize = "area";
+    info.sourceShape = {1, 3, 480, 640};
+    info.colorFormat = "RGB";
+    info.mean = {1, 2, 3};
+    info.scale = {4};
+    ASSERT_EQ(applyPreprocessing({{"data", info}}, inputs), StatusCode::OK);
+    auto& preProcess = inputs["data"]->getPreProcess();
+    EXPECT_EQ(preProcess.getResizeAlgorithm(), InferenceEngine::RESIZE_AREA);
+    EXPECT_EQ(preProcess.getColorFormat(), InferenceEngine::ColorFormat::RGB);
+    EXPECT_EQ(preProcess.getMeanVariant(), InferenceEngine::MEAN_VALUE);
+    ASSERT_EQ(preProcess.getNumberOfChannels(), 3);
+    EXPECT_EQ(preProcess[2]->meanValue, 3);
+    EXPECT_EQ(preProcess[2]->stdScale, 4);
+}
+
+TEST(Preprocessing, RejectsPreprocessingNotMatchingNetworkInput) {
+    auto inputs = makeNetworkInputs({1, 3, 224, 224});
+    InputPreprocessingInfo info;
+    EXPECT_EQ(applyPreprocessing({{"missing", info}}, inputs), StatusCode::INVALID_PREPROCESSING_INPUT);
+
+    info.mean = {1, 2};
+    EXPECT_EQ(applyPreprocessing({{"data", info}}, inputs), StatusCode::INVALID_PREPROCESSING_INPUT);
+
+    info.mean = {};
+    info.resize = "bilinear";
+    info.sourceShape = {1, 1, 480, 640};
+    EXPECT_EQ(applyPreprocessing({{"data", info}}, inputs), StatusCode::INVALID_PREPROCESSING_INPUT);
+
+    auto grayInputs = makeNetworkInputs({1, 1, 224, 224});
+    InputPreprocessingInfo color;
+    color.colorFormat = "RGB";
+    EXPECT_EQ(applyPreprocessing({{"data", color}}, grayInputs), StatusCode::INVALID_PREPROCESSING_INPUT);
+}
@@ -0,0 +1,104 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../readsnapshot.hpp"
+
+using namespace ovms;
+
+using snapshot_map_t = std::map<std::string, int>;
+
+namespace {
+int readValue(const ReadSnapshot<snapshot_map_t>& snapshot, const std::string& key) {
+    return snapshot.read([&key](const snapshot_map_t& values) {
+        auto it = values.find(key);
+        return it != values.end() ? it->second : -1;
+    });
+}
+}  // namespace
+
+TEST(ReadSnapshot, EmptyUntilPublished) {
+    ReadSnapshot<snapshot_map_t> snapshot;
+    EXPECT_EQ(readValue(snapshot, "a"), -1);
+    snapshot.publish({{"a", 1}});
+    EXPECT_EQ(readValue(snapshot, "a"), 1);
+    snapshot.publish({{"a", 2}, {"b", 3}});
+    EXPECT_EQ(readValue(snapshot, "a"), 2);
+    EXPECT_EQ(readValue(snapshot, "b"), 3);
+}
+
+TEST(ReadSnapshot, InstancesDoNotShareThreadCache) {
+    ReadSnapshot<snapshot_map_t> first;
+    ReadSnapshot<snapshot_map_t> second;
+    first.publish({{"a", 1}});
+    second.publish({{"a", 2}});
+    EXPECT_EQ(readValue(first, "a"), 1);
+    EXPECT_EQ(readValue(second, "a"), 2);
+    EXPECT_EQ(readValue(first, "a"), 1);
+    {
+        ReadSnapshot<snapshot_map_t> destroyed;
+        destroyed.publish({{"a", 3}});
+        EXPECT_EQ(readValue(destroyed, "a"), 3);
+    }
+    ReadSnapshot<snapshot_map_t> created;
+    EXPECT_EQ(readValue(created, "a"), -1);
+}
+
+TEST(ReadSnapshot, AlternatingReadsOfInstancesHitThreadCache) {
+    ReadSnapshot<snapshot_map_t> first;
+    ReadSnapshot<snapshot_map_t> second;
+    first.publish({{"a", 1}});
+    second.publish({{"a", 2}});
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(readValue(first, "a"), 1);
+        EXPECT_EQ(readValue(second, "a"), 2);
+    }
+    EXPECT_EQ(first.getThreadCacheMissesCount(), 1);
+    EXPECT_EQ(second.getThreadCacheMissesCount(), 1);
+    first.publish({{"a", 3}});
+    EXPECT_EQ(readValue(first, "a"), 3);
+    EXPECT_EQ(readValue(second, "a"), 2);
+    EXPECT_EQ(first.getThreadCacheMissesCount(), 2);
+    EXPECT_EQ(second.getThreadCacheMissesCount(), 1);
+}
+
+TEST(ReadSnapshot, ReadersSeePublishedSnapshotsInOrder) {
+    ReadSnapshot<snapshot_map_t> snapshot;
+    const int publishes = 1000;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&snapshot]() {
+            int last = -1;
+            while (last < publishes) {
+                int value = readValue(snapshot, "value");
+                EXPECT_GE(value, last);
+                last = value;
+            }
+        });
+    }
+    for (int i = 0; i <= publishes; ++i) {
+        snapshot.publish({{"value", i}});
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
@@ -0,0 +1,65 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../requestarena.hpp"
+#include "../rest_binary_parser.hpp"
+#include "test_utils.hpp"
+
+TEST(RequestArena, ThreadArenaIsResetAfterRequest) {
+    google::protobuf::Arena* first;
+    {
+        ovms::RequestArena arena;
+        first = arena.get();
+        auto* request = google::protobuf::Arena::CreateMessage<tensorflow::serving::PredictRequest>(arena.get());
+        (*request->mutable_inputs())["a"].mutable_tensor_shape()->add_dim()->set_size(1);
+        EXPECT_GT(arena.getSpaceUsed(), 0);
+    }
+    ovms::RequestArena arena;
+    EXPECT_EQ(arena.get(), first);
+    EXPECT_EQ(arena.getSpaceUsed(), 0);
+}
+
+TEST(RequestArena, NestedRequestGetsOwnArena) {
+    ovms::RequestArena outer;
+    ovms::RequestArena nested;
+    EXPECT_NE(outer.get(), nested.get());
+    google::protobuf::Arena* otherThreadArena = nullptr;
+    std::thread([&otherThreadArena]() {
+        ovms::RequestArena arena;
+        otherThreadArena = arena.get();
+    }).join();
+    EXPECT_NE(outer.get(), otherThreadArena);
+}
+
+TEST(RequestArena, ParsedProtoOutlivesParser) {
+    ovms::RequestArena arena;
+    tensorflow::serving::PredictRequest* request;
+    {
+        std::string header = R"({"inputs": {"inputA": {"datatype": "INT32", "shape": [1, 2]}}})";
+        std::string body = header;
+        body.append(std::string(2 * sizeof(int32_t), '\0'));
+        ovms::RestBinaryParser parser(arena.get());
+        ASSERT_EQ(parser.parse(body, header.size()), ovms::StatusCode::OK);
+        request = &parser.getProto();
+    }
+    EXPECT_EQ(request->GetArena(), arena.get());
+    ASSERT_EQ(request->inputs_size(), 1);
+    EXPECT_EQ(request->inputs().at("inputA").tensor_content().size(), 2 * sizeof(int32_t));
+}
@@ -0,0 +1,116 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../requestcoalescer.hpp"
+
+using namespace ovms;
+using tensorflow::serving::PredictResponse;
+
+namespace {
+PredictResponse responseWithOutput(const std::string& name, float value) {
+    PredictResponse response;
+    auto& output = (*response.mutable_outputs())[name];
+    output.set_dtype(tensorflow::DataType::DT_FLOAT);
+    output.add_float_val(value);
+    return response;
+}
+}  // namespace
+
+TEST(RequestCoalescer, FirstRequestLeadsFlight) {
+    RequestCoalescer coalescer;
+    bool leader = false;
+    auto flight = coalescer.join(1, leader);
+    EXPECT_TRUE(leader);
+    EXPECT_EQ(flight->getKey(), 1);
+    bool otherLeader = false;
+    auto other = coalescer.join(2, otherLeader);
+    EXPECT_TRUE(otherLeader);
+    EXPECT_NE(flight, other);
+    EXPECT_EQ(coalescer.getFlightsCount(), 2);
+}
+
+TEST(RequestCoalescer, FollowersReceiveResponseOfLeader) {
+    RequestCoalescer coalescer;
+    bool leader = false;
+    auto flight = coalescer.join(1, leader);
+    ASSERT_TRUE(leader);
+    const size_t followersCount = 4;
+    std::vector<std::thread> followers;
+    std::vector<PredictResponse> responses(followersCount);
+    std::vector<Status> statuses(followersCount, StatusCode::INTERNAL_ERROR);
+    for (size_t i = 0; i < followersCount; ++i) {
+        bool followerLeader = true;
+        auto joined = coalescer.join(1, followerLeader);
+        ASSERT_FALSE(followerLeader);
+        ASSERT_EQ(joined, flight);
+        followers.emplace_back([&, i, joined]() {
+            bool answered = false;
+            statuses[i] = RequestCoalescer::wait(*joined, responses[i], answered);
+            EXPECT_TRUE(answered);
+        });
+    }
+    coalescer.finish(flight, StatusCode::OK, responseWithOutput("out", 3.0f));
+    for (auto& follower : followers) {
+        follower.join();
+    }
+    for (size_t i = 0; i < followersCount; ++i) {
+        EXPECT_EQ(statuses[i], StatusCode::OK);
+        ASSERT_EQ(responses[i].outputs().count("out"), 1);
+        EXPECT_EQ(responses[i].outputs().at("out").float_val(0), 3.0f);
+    }
+    EXPECT_EQ(coalescer.getFlightsCount(), 0);
+}
+
+TEST(RequestCoalescer, FollowersNotAnsweredByErrorOfLeader) {
+    RequestCoalescer coalescer;
+    bool leader = false;
+    auto flight = coalescer.join(1, leader);
+    auto joined = coalescer.join(1, leader);
+    ASSERT_FALSE(leader);
+    coalescer.finish(flight, StatusCode::DEADLINE_EXCEEDED, PredictResponse());
+    PredictResponse response;
+    bool answered = true;
+    EXPECT_EQ(RequestCoalescer::wait(*joined, response, answered), StatusCode::OK);
+    EXPECT_FALSE(answered);
+    EXPECT_TRUE(response.outputs().empty());
+}
+
+TEST(RequestCoalescer, RequestAfterFinishStartsNewFlight) {
+    RequestCoalescer coalescer;
+    bool leader = false;
+    auto flight = coalescer.join(1, leader);
+    coalescer.finish(flight, StatusCode::OK, responseWithOutput("out", 1.0f));
+    auto next = coalescer.join(1, leader);
+    EXPECT_TRUE(leader);
+    EXPECT_NE(next, flight);
+}
+
+TEST(RequestCoalescer, FollowerStopsWaitingAtDeadline) {
+    RequestCoalescer coalescer;
+    bool leader = false;
+    auto flight = coalescer.join(1, leader);
+    auto joined = coalescer.join(1, leader);
+    PredictResponse response;
+    bool answered = true;
+    EXPECT_EQ(RequestCoalescer::wait(*joined, response, answered, std::chrono::steady_clock::now() + std::chrono::milliseconds(5)), StatusCode::DEADLINE_EXCEEDED);
+    EXPECT_FALSE(answered);
+    coalescer.finish(flight, StatusCode::OK, responseWithOutput("out", 1.0f));
+}
@@ -0,0 +1,64 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <thread>
+
+#include <grpcpp/server_context.h>
+#include <gtest/gtest.h>
+
+#include "../requestdeadline.hpp"
+
+using namespace ovms;
+
+TEST(RequestDeadline, NoDeadlineNeverExpires) {
+    RequestDeadline deadline;
+    EXPECT_FALSE(deadline.getDeadline().has_value());
+    EXPECT_EQ(deadline.check(), StatusCode::OK);
+    EXPECT_EQ(checkDeadline(nullptr), StatusCode::OK);
+}
+
+TEST(RequestDeadline, ExpiresAfterDeadline) {
+    RequestDeadline passed(RequestDeadline::Clock::now() - std::chrono::milliseconds(1));
+    EXPECT_EQ(passed.check(), StatusCode::DEADLINE_EXCEEDED);
+    EXPECT_EQ(checkDeadline(&passed), StatusCode::DEADLINE_EXCEEDED);
+    RequestDeadline future(RequestDeadline::Clock::now() + std::chrono::seconds(60));
+    EXPECT_EQ(future.check(), StatusCode::OK);
+}
+
+TEST(RequestDeadline, ParsesTimeoutHeader) {
+    RequestDeadline deadline;
+    ASSERT_EQ(RequestDeadline::fromTimeoutHeader("5", deadline), StatusCode::OK);
+    ASSERT_TRUE(deadline.getDeadline().has_value());
+    EXPECT_EQ(deadline.check(), StatusCode::OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(deadline.check(), StatusCode::DEADLINE_EXCEEDED);
+    ASSERT_EQ(RequestDeadline::fromTimeoutHeader("0", deadline), StatusCode::OK);
+    EXPECT_EQ(deadline.check(), StatusCode::DEADLINE_EXCEEDED);
+}
+
+TEST(RequestDeadline, RejectsInvalidTimeoutHeader) {
+    RequestDeadline deadline;
+    for (auto value : {"", "-1", "1.5", "10ms", "1000000000"}) {
+        EXPECT_EQ(RequestDeadline::fromTimeoutHeader(value, deadline), StatusCode::REQUEST_TIMEOUT_HEADER_INVALID) << value;
+    }
+}
+
+TEST(RequestDeadline, GrpcCallWithoutDeadline) {
+    grpc::ServerContext context;
+    auto deadline = RequestDeadline::fromGrpcContext(context, true);
+    EXPECT_FALSE(deadline.getDeadline().has_value());
+    EXPECT_EQ(deadline.check(), StatusCode::OK);
+}
@@ -0,0 +1,86 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "../requestlogging.hpp"
+
+using ovms::RequestLogSampler;
+
+namespace {
+class RequestLoggingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        previousLogger = spdlog::default_logger();
+        auto logger = std::make_shared<spdlog::logger>("request_logging_test", std::make_shared<spdlog::sinks::ostream_sink_st>(output));
+        logger->set_pattern("%v");
+        spdlog::set_default_logger(logger);
+    }
+
+    void TearDown() override {
+        RequestLogSampler::setPeriod(1);
+        spdlog::set_default_logger(previousLogger);
+    }
+
+    size_t loggedLines() {
+        const auto text = output.str();
+        return std::count(text.begin(), text.end(), '\n');
+    }
+
+    std::shared_ptr<spdlog::logger> previousLogger;
+    std::ostringstream output;
+};
+}  // namespace
+
+TEST_F(RequestLoggingTest, ArgumentsNotEvaluatedBelowDebugLevel) {
+    spdlog::default_logger()->set_level(spdlog::level::info);
+    int evaluations = 0;
+    auto argument = [&evaluations]() { return ++evaluations; };
+    for (int i = 0; i < 10; ++i) {
+        OVMS_REQUEST_DEBUG("request {}", argument());
+    }
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_EQ(loggedLines(), 0);
+}
+
+TEST_F(RequestLoggingTest, AllRequestsLoggedByDefault) {
+    spdlog::default_logger()->set_level(spdlog::level::debug);
+    for (int i = 0; i < 10; ++i) {
+        OVMS_REQUEST_DEBUG("request {}", i);
+    }
+    EXPECT_EQ(loggedLines(), 10);
+}
+
+TEST_F(RequestLoggingTest, OneOfPeriodRequestsLogged) {
+    spdlog::default_logger()->set_level(spdlog::level::debug);
+    RequestLogSampler::setPeriod(4);
+    for (int i = 0; i < 12; ++i) {
+        OVMS_REQUEST_DEBUG("request {}", i);
+    }
+    EXPECT_EQ(loggedLines(), 3);
+    EXPECT_EQ(output.str(), "request 0\nrequest 4\nrequest 8\n");
+}
+
+TEST(RequestLogSampler, ZeroPeriodLogsAllRequests) {
+    RequestLogSampler::setPeriod(0);
+    EXPECT_EQ(RequestLogSampler::getPeriod(), 1);
+}
@@ -0,0 +1,38 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <gtest/gtest.h>
+
+#include "../requesttiming.hpp"
+
+using ovms::RequestTiming;
+
+TEST(RequestTiming, SerializedInServerTimingFormat) {
+    RequestTiming timing;
+    timing.add("queue_wait", 0.0123);
+    timing.add("inference", 3);
+    EXPECT_EQ(timing.serialize(), "queue_wait;dur=0.012, inference;dur=3.000");
+}
+
+TEST(RequestTiming, InvalidCharactersOfStageNamesReplaced) {
+    RequestTiming timing;
+    timing.add("node.my node;1,2", 1.5);
+    EXPECT_EQ(timing.serialize(), "node.my_node_1_2;dur=1.500");
+}
+
+TEST(RequestTiming, EmptyWhenNoStages) {
+    RequestTiming timing;
+    EXPECT_EQ(timing.serialize(), "");
+}
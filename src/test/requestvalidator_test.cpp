@@ -0,0 +1,113 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../requestvalidator.hpp"
+#include "test_utils.hpp"
+
+namespace {
+class RequestValidatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        inputsInfo["a"] = std::make_shared<ovms::TensorInfo>("a", InferenceEngine::Precision::FP32, ovms::shape_t{1, 3, 4}, InferenceEngine::Layout::ANY);
+        inputsInfo["b"] = std::make_shared<ovms::TensorInfo>("b", InferenceEngine::Precision::U8, ovms::shape_t{1, 10}, InferenceEngine::Layout::ANY);
+        inputsInfo["c"] = std::make_shared<ovms::TensorInfo>("c", InferenceEngine::Precision::U16, ovms::shape_t{1, 2}, InferenceEngine::Layout::ANY);
+        validator.compile(inputsInfo);
+
+        request = preparePredictRequest(
+            {{"a", std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 3, 4}, tensorflow::DataType::DT_FLOAT}},
+                {"b", std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 10}, tensorflow::DataType::DT_UINT8}}});
+        auto& c = (*request.mutable_inputs())["c"];
+        c.set_dtype(tensorflow::DataType::DT_UINT16);
+        c.mutable_tensor_shape()->add_dim()->set_size(1);
+        c.mutable_tensor_shape()->add_dim()->set_size(2);
+        c.mutable_int_val()->Resize(2, 1);
+    }
+
+    ovms::tensor_map_t inputsInfo;
+    ovms::RequestValidator validator;
+    tensorflow::serving::PredictRequest request;
+};
+}  // namespace
+
+TEST_F(RequestValidatorTest, AcceptsMatchingRequest) {
+    ASSERT_TRUE(validator.isCompiled());
+    EXPECT_TRUE(validator.isValid(request, 1, false));
+}
+
+TEST_F(RequestValidatorTest, RejectsMismatchingInputs) {
+    auto wrongPrecision = request;
+    (*wrongPrecision.mutable_inputs())["b"].set_dtype(tensorflow::DataType::DT_INT8);
+    EXPECT_FALSE(validator.isValid(wrongPrecision, 1, false));
+
+    auto wrongShape = request;
+    (*wrongShape.mutable_inputs())["a"].mutable_tensor_shape()->mutable_dim(2)->set_size(5);
+    EXPECT_FALSE(validator.isValid(wrongShape, 1, false));
+
+    auto wrongContentSize = request;
+    (*wrongContentSize.mutable_inputs())["a"].mutable_tensor_content()->resize(3);
+    EXPECT_FALSE(validator.isValid(wrongContentSize, 1, false));
+
+    auto wrongValueCount = request;
+    (*wrongValueCount.mutable_inputs())["c"].mutable_int_val()->Resize(3, 1);
+    EXPECT_FALSE(validator.isValid(wrongValueCount, 1, false));
+
+    auto missingInput = request;
+    missingInput.mutable_inputs()->erase("b");
+    EXPECT_FALSE(validator.isValid(missingInput, 1, false));
+
+    auto renamedInput = request;
+    (*renamedInput.mutable_inputs())["d"] = renamedInput.inputs().at("b");
+    renamedInput.mutable_inputs()->erase("b");
+    EXPECT_FALSE(validator.isValid(renamedInput, 1, false));
+}
+
+TEST_F(RequestValidatorTest, BatchSize) {
+    auto batched = preparePredictRequest(
+        {{"a", std::tuple<ovms::shape_t, tensorflow::DataType>{{2, 3, 4}, tensorflow::DataType::DT_FLOAT}},
+            {"b", std::tuple<ovms::shape_t, tensorflow::DataType>{{2, 10}, tensorflow::DataType::DT_UINT8}}});
+    auto& c = (*batched.mutable_inputs())["c"];
+    c.set_dtype(tensorflow::DataType::DT_UINT16);
+    c.mutable_tensor_shape()->add_dim()->set_size(2);
+    c.mutable_tensor_shape()->add_dim()->set_size(2);
+    c.mutable_int_val()->Resize(4, 1);
+    EXPECT_FALSE(validator.isValid(batched, 1, false));
+    EXPECT_FALSE(validator.isValid(request, 2, false));
+    EXPECT_TRUE(validator.isValid(batched, 1, true));
+}
+
+TEST_F(RequestValidatorTest, FindsManyInputs) {
+    ovms::tensor_map_t manyInputs;
+    tensorflow::serving::PredictRequest manyInputsRequest;
+    for (int i = 0; i < 100; ++i) {
+        const std::string name = "input_" + std::to_string(i);
+        manyInputs[name] = std::make_shared<ovms::TensorInfo>(name, InferenceEngine::Precision::FP32, ovms::shape_t{1, 1}, InferenceEngine::Layout::ANY);
+        auto& input = (*manyInputsRequest.mutable_inputs())[name];
+        input.set_dtype(tensorflow::DataType::DT_FLOAT);
+        input.mutable_tensor_shape()->add_dim()->set_size(1);
+        input.mutable_tensor_shape()->add_dim()->set_size(1);
+        input.mutable_tensor_content()->resize(sizeof(float));
+    }
+    ovms::RequestValidator manyInputsValidator;
+    manyInputsValidator.compile(manyInputs);
+    EXPECT_TRUE(manyInputsValidator.isValid(manyInputsRequest, 1, false));
+    manyInputsValidator.clear();
+    EXPECT_FALSE(manyInputsValidator.isCompiled());
+    EXPECT_FALSE(manyInputsValidator.isValid(manyInputsRequest, 1, false));
+}
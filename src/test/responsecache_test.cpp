@@ -0,0 +1,117 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../modelinstance.hpp"
+#include "../modelinstanceunloadguard.hpp"
+#include "../prediction_service_utils.hpp"
+#include "../responsecache.hpp"
+#include "test_utils.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+tensorflow::serving::PredictRequest prepareRequest(const std::string& content) {
+    auto request = preparePredictRequest(
+        {{"a", std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 2}, tensorflow::DataType::DT_FLOAT}},
+            {"b", std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 2}, tensorflow::DataType::DT_FLOAT}}});
+    (*request.mutable_inputs())["a"].set_tensor_content(content);
+    return request;
+}
+
+tensorflow::serving::PredictResponse prepareResponse(size_t contentSize) {
+    tensorflow::serving::PredictResponse response;
+    (*response.mutable_outputs())["out"].set_tensor_content(std::string(contentSize, 'x'));
+    return response;
+}
+}  // namespace
+
+TEST(ResponseCache, KeyDependsOnInputsAndVersion) {
+    uint64_t key, sameKey, otherContentKey, otherVersionKey;
+    ASSERT_TRUE(ovms::ResponseCache::computeKey(prepareRequest("12345678"), 1, key));
+    ASSERT_TRUE(ovms::ResponseCache::computeKey(prepareRequest("12345678"), 1, sameKey));
+    ASSERT_TRUE(ovms::ResponseCache::computeKey(prepareRequest("12345679"), 1, otherContentKey));
+    ASSERT_TRUE(ovms::ResponseCache::computeKey(prepareRequest("12345678"), 2, otherVersionKey));
+    EXPECT_EQ(key, sameKey);
+    EXPECT_NE(key, otherContentKey);
+    EXPECT_NE(key, otherVersionKey);
+
+    auto filtered = prepareRequest("12345678");
+    filtered.add_output_filter("out");
+    uint64_t filteredKey;
+    ASSERT_TRUE(ovms::ResponseCache::computeKey(filtered, 1, filteredKey));
+    EXPECT_NE(key, filteredKey);
+
+    auto withoutContent = prepareRequest("");
+    EXPECT_FALSE(ovms::ResponseCache::computeKey(withoutContent, 1, key));
+}
+
+TEST(ResponseCache, EvictsLeastRecentlyUsed) {
+    const size_t responseSize = prepareResponse(100).ByteSizeLong();
+    ovms::ResponseCache cache(2 * responseSize, 0s);
+    cache.put(1, prepareResponse(100));
+    cache.put(2, prepareResponse(100));
+    tensorflow::serving::PredictResponse response;
+    ASSERT_TRUE(cache.get(1, response));
+    cache.put(3, prepareResponse(100));
+    EXPECT_EQ(cache.getEntriesCount(), 2);
+    EXPECT_EQ(cache.getSizeBytes(), 2 * responseSize);
+    EXPECT_TRUE(cache.get(1, response));
+    EXPECT_FALSE(cache.get(2, response));
+    EXPECT_TRUE(cache.get(3, response));
+    EXPECT_EQ(response.outputs().at("out").tensor_content().size(), 100);
+
+    // larger than the whole cache
+    cache.put(4, prepareResponse(300));
+    EXPECT_FALSE(cache.get(4, response));
+    EXPECT_EQ(cache.getEntriesCount(), 2);
+}
+
+TEST(ResponseCache, EntriesExpire) {
+    ovms::ResponseCache cache(1024, 10s);
+    const auto now = std::chrono::steady_clock::now();
+    cache.put(1, prepareResponse(10), now);
+    tensorflow::serving::PredictResponse response;
+    EXPECT_TRUE(cache.get(1, response, now + 9s));
+    EXPECT_FALSE(cache.get(1, response, now + 10s));
+    EXPECT_EQ(cache.getEntriesCount(), 0);
+    EXPECT_EQ(cache.getSizeBytes(), 0);
+}
+
+TEST(ResponseCache, RepeatedRequestSkipsInference) {
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setResponseCacheSizeMegabytes(1);
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    ASSERT_NE(modelInstance.getResponseCache(), nullptr);
+
+    auto request = preparePredictRequest(
+        {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{1, DUMMY_MODEL_INPUT_SIZE}, tensorflow::DataType::DT_FLOAT}}});
+    auto& metrics = modelInstance.getMetrics();
+    const auto hits = metrics.responseCacheHits.get();
+    const auto inferences = metrics.inference.getCount();
+    tensorflow::serving::PredictResponse first, second;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+    ASSERT_EQ(ovms::inference(modelInstance, &request, &first, unloadGuard), ovms::StatusCode::OK);
+    ASSERT_EQ(ovms::inference(modelInstance, &request, &second, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(metrics.responseCacheHits.get(), hits + 1);
+    EXPECT_EQ(metrics.inference.getCount(), inferences + 1);
+    EXPECT_EQ(first.SerializeAsString(), second.SerializeAsString());
+}
@@ -0,0 +1,73 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../rest_batch.hpp"
+
+using namespace ovms;
+
+TEST(RestBatch, ParsesRequests) {
+    std::vector<BatchPredictItem> items;
+    ASSERT_EQ(parseBatchPredictRequest(R"({"requests": [
+        {"model_name": "dummy", "request": {"instances": [[1, 2]]}},
+        {"model_name": "resnet", "model_version": 3, "request": {"inputs": {"in": [0.5]}}}
+    ]})",
+                  items),
+        StatusCode::OK);
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items[0].modelName, "dummy");
+    EXPECT_FALSE(items[0].modelVersion.has_value());
+    EXPECT_EQ(items[0].body, R"({"instances":[[1,2]]})");
+    EXPECT_EQ(items[1].modelName, "resnet");
+    EXPECT_EQ(items[1].modelVersion.value(), 3);
+    EXPECT_EQ(items[1].body, R"({"inputs":{"in":[0.5]}})");
+}
+
+TEST(RestBatch, RejectsInvalidEnvelopes) {
+    std::vector<BatchPredictItem> items;
+    EXPECT_EQ(parseBatchPredictRequest("{", items), StatusCode::JSON_INVALID);
+    for (const std::string body : {
+             R"([])",
+             R"({"requests": {}})",
+             R"({"requests": []})",
+             R"({"requests": [{"request": {}}]})",
+             R"({"requests": [{"model_name": "dummy"}]})",
+             R"({"requests": [{"model_name": "dummy", "request": []}]})",
+             R"({"requests": [{"model_name": "dummy", "model_version": -1, "request": {}}]})",
+             R"({"requests": [{"model_name": "dummy", "model_version": "1", "request": {}}]})"}) {
+        EXPECT_EQ(parseBatchPredictRequest(body, items), StatusCode::REST_BATCH_INVALID) << body;
+    }
+}
+
+TEST(RestBatch, RejectsTooManyRequests) {
+    std::string body = R"({"requests": [)";
+    for (size_t i = 0; i <= MAX_BATCH_PREDICT_REQUESTS; ++i) {
+        body += std::string(i ? "," : "") + R"({"model_name": "dummy", "request": {}})";
+    }
+    body += "]}";
+    std::vector<BatchPredictItem> items;
+    EXPECT_EQ(parseBatchPredictRequest(body, items), StatusCode::REST_BATCH_INVALID);
+}
+
+TEST(RestBatch, WritesResponsesInOrder) {
+    std::string output;
+    writeBatchPredictResponse({StatusCode::OK, StatusCode::MODEL_NAME_MISSING},
+        {R"({"predictions": [[1.0]]})", ""}, output);
+    EXPECT_EQ(output, R"({"responses":[{"predictions": [[1.0]]},{"error":")" + Status(StatusCode::MODEL_NAME_MISSING).string() + R"("}]})");
+}
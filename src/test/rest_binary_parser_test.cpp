@@ -0,0 +1,132 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../rest_binary_parser.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+using namespace testing;
+using ::testing::ElementsAre;
+
+using tensorflow::DataType;
+
+namespace {
+
+template <typename T>
+void appendData(std::string& body, const std::vector<T>& data) {
+    body.append(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+}
+
+}  // namespace
+
+TEST(RestBinaryParser, ParseValid) {
+    std::string header = R"({"inputs": {
+        "inputA": {"datatype": "FP32", "shape": [1, 2, 2], "binary_data_size": 16},
+        "inputB": {"datatype": "INT32", "shape": [1, 3]}
+    }})";
+    std::string body = header;
+    appendData<float>(body, {1.0, 2.0, 3.0, 4.0});
+    appendData<int32_t>(body, {5, 6, 7});
+
+    RestBinaryParser parser;
+    ASSERT_EQ(parser.parse(body, header.size()), StatusCode::OK);
+    EXPECT_EQ(parser.getOrder(), Order::COLUMN);
+    ASSERT_EQ(parser.getProto().inputs_size(), 2);
+    const auto& inputA = parser.getProto().inputs().at("inputA");
+    EXPECT_EQ(inputA.dtype(), DataType::DT_FLOAT);
+    EXPECT_THAT(asVector(inputA.tensor_shape()), ElementsAre(1, 2, 2));
+    ASSERT_EQ(inputA.tensor_content().size(), 16);
+    EXPECT_THAT(asVector<float>(inputA.tensor_content()), ElementsAre(1.0, 2.0, 3.0, 4.0));
+    const auto& inputB = parser.getProto().inputs().at("inputB");
+    EXPECT_EQ(inputB.dtype(), DataType::DT_INT32);
+    EXPECT_THAT(asVector(inputB.tensor_shape()), ElementsAre(1, 3));
+    EXPECT_THAT(asVector<int32_t>(inputB.tensor_content()), ElementsAre(5, 6, 7));
+}
+
+TEST(RestBinaryParser, ParseValidHalfPrecisionPacked) {
+    std::string header = R"({"inputs": {"inputA": {"datatype": "FP16", "shape": [1, 3]}, "inputB": {"datatype": "UINT16", "shape": [1, 2]}}})";
+    std::string body = header;
+    appendData<uint16_t>(body, {0x3C00, 0x4000, 0xC000});
+    appendData<uint16_t>(body, {1, 65535});
+
+    RestBinaryParser parser;
+    ASSERT_EQ(parser.parse(body, header.size()), StatusCode::OK);
+    const auto& inputA = parser.getProto().inputs().at("inputA");
+    EXPECT_EQ(inputA.dtype(), DataType::DT_HALF);
+    EXPECT_EQ(inputA.half_val_size(), 0);
+    EXPECT_THAT(asVector<uint16_t>(inputA.tensor_content()), ElementsAre(0x3C00, 0x4000, 0xC000));
+    const auto& inputB = parser.getProto().inputs().at("inputB");
+    EXPECT_EQ(inputB.dtype(), DataType::DT_UINT16);
+    EXPECT_EQ(inputB.int_val_size(), 0);
+    EXPECT_THAT(asVector<uint16_t>(inputB.tensor_content()), ElementsAre(1, 65535));
+}
+
+TEST(RestBinaryParser, HeaderLengthExceedingBody) {
+    std::string body = R"({"inputs": {}})";
+    RestBinaryParser parser;
+    EXPECT_EQ(parser.parse(body, 0), StatusCode::REST_BINARY_HEADER_INVALID);
+    EXPECT_EQ(parser.parse(body, body.size() + 1), StatusCode::REST_BINARY_HEADER_INVALID);
+}
+
+TEST(RestBinaryParser, InvalidHeader) {
+    RestBinaryParser parser;
+    std::string body = R"({"inputs": {"inputA": )";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::JSON_INVALID);
+    body = R"([1, 2])";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_BODY_IS_NOT_AN_OBJECT);
+    body = R"({"inputs": []})";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_INPUTS_NOT_AN_OBJECT);
+    body = R"({"inputs": {}})";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_NO_INPUTS_FOUND);
+    body = R"({"inputs": {"inputA": {"shape": [1]}}})";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_BINARY_HEADER_INVALID);
+    body = R"({"inputs": {"inputA": {"datatype": "FP32", "shape": [1, -1]}}})";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_BINARY_HEADER_INVALID);
+    body = R"({"inputs": {"inputA": {"datatype": "BYTES", "shape": [1]}}})";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_UNSUPPORTED_PRECISION);
+}
+
+TEST(RestBinaryParser, ShapeOverflow) {
+    RestBinaryParser parser;
+    std::string body = R"({"inputs": {"inputA": {"datatype": "FP32", "shape": [1, 9223372036854775808]}}})";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_BINARY_HEADER_INVALID);
+    body = R"({"inputs": {"inputA": {"datatype": "FP32", "shape": [4294967296, 4294967296]}}})";
+    EXPECT_EQ(parser.parse(body, body.size()), StatusCode::REST_BINARY_HEADER_INVALID);
+}
+
+TEST(RestBinaryParser, DataSizeMismatch) {
+    std::string header = R"({"inputs": {"inputA": {"datatype": "FP32", "shape": [1, 2], "binary_data_size": 12}}})";
+    std::string body = header;
+    appendData<float>(body, {1.0, 2.0, 3.0});
+    RestBinaryParser parser;
+    EXPECT_EQ(parser.parse(body, header.size()), StatusCode::REST_BINARY_DATA_SIZE_MISMATCH);
+
+    header = R"({"inputs": {"inputA": {"datatype": "FP32", "shape": [1, 2]}}})";
+    body = header;
+    appendData<float>(body, {1.0});
+    EXPECT_EQ(parser.parse(body, header.size()), StatusCode::REST_BINARY_DATA_SIZE_MISMATCH);
+
+    body = header;
+    appendData<float>(body, {1.0, 2.0, 3.0});
+    EXPECT_EQ(parser.parse(body, header.size()), StatusCode::REST_BINARY_DATA_SIZE_MISMATCH);
+}
@@ -411,6 +411,24 @@ TEST(RestParserColumn, CannotParseInput) {
     }
 }
 
+TEST(RestParserColumn, ParseBooleanInput) {
+    std::vector<RestParser> parsers{RestParser(), RestParser(prepareTensors({{"i", {2, 2}}}, InferenceEngine::Precision::BOOL))};
+    for (RestParser& parser : parsers) {
+        ASSERT_EQ(parser.parse(R"({"signature_name":"","inputs":{"i":[[true,false],[false,true]]}})"), StatusCode::OK);
+        const auto& input = parser.getProto().inputs().at("i");
+        EXPECT_EQ(input.dtype(), DataType::DT_BOOL);
+        EXPECT_THAT(asVector(input.tensor_shape()), ElementsAre(2, 2));
+        EXPECT_EQ(input.tensor_content(), std::string("\x01\x00\x00\x01", 4));
+    }
+}
+
+TEST(RestParserColumn, CannotMixBooleanAndNumericValues) {
+    RestParser floatParser(prepareTensors({{"i", {2}}}));
+    EXPECT_EQ(floatParser.parse(R"({"signature_name":"","inputs":{"i":[1.0,true]}})"), StatusCode::REST_COULD_NOT_PARSE_INPUT);
+    RestParser boolParser(prepareTensors({{"i", {2}}}, InferenceEngine::Precision::BOOL));
+    EXPECT_EQ(boolParser.parse(R"({"signature_name":"","inputs":{"i":[true,1]}})"), StatusCode::REST_COULD_NOT_PARSE_INPUT);
+}
+
 TEST(RestParserColumn, InputNotNdArray_1) {
     std::vector<RestParser> parsers{RestParser(), RestParser(prepareTensors({{"i", {1, 2, 3, 2}}}))};
     for (RestParser& parser : parsers) {
@@ -399,6 +399,14 @@ TEST(RestParserRow, CouldNotDetectOrder) {
     EXPECT_EQ(parser.parse(R"({"signature_name":"","instances":[{"i":[1]}],"inputs":{"i":[[1]]}})"), StatusCode::REST_PREDICT_UNKNOWN_ORDER);
 }
 
+TEST(RestParserRow, InvalidJsonTakesPrecedenceOverStructureErrors) {
+    RestParser parser(prepareTensors({{"i", {1, 1}}}));
+
+    EXPECT_EQ(parser.parse(R"({"signature_name":"","instances":5,"x":])"), StatusCode::JSON_INVALID);
+    EXPECT_EQ(parser.parse(R"({"signature_name":"","instances":[{"i":[1,null]}],"x":[})"), StatusCode::JSON_INVALID);
+    EXPECT_EQ(parser.parse(R"({"signature_name":"","instances":[{"i":[1,null]}],"inputs":{"i":[[1]]}})"), StatusCode::REST_PREDICT_UNKNOWN_ORDER);
+}
+
 TEST(RestParserRow, InstancesNotAnArray) {
     RestParser parser;
 
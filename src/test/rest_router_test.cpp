@@ -0,0 +1,176 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../rest_router.hpp"
+
+using namespace ovms;
+
+TEST(RestRouter, ModelStatus) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet", match));
+    EXPECT_EQ(match.route, RestRoute::MODEL_STATUS);
+    EXPECT_EQ(match.modelName, "resnet");
+    EXPECT_FALSE(match.modelVersion.has_value());
+    EXPECT_FALSE(match.modelVersionLabel.has_value());
+
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/versions/12", match));
+    EXPECT_EQ(match.route, RestRoute::MODEL_STATUS);
+    EXPECT_EQ(match.modelVersion.value(), "12");
+
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/labels/stable_1", match));
+    EXPECT_EQ(match.route, RestRoute::MODEL_STATUS);
+    EXPECT_FALSE(match.modelVersion.has_value());
+    EXPECT_EQ(match.modelVersionLabel.value(), "stable_1");
+}
+
+TEST(RestRouter, ModelMetadata) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/metadata", match));
+    EXPECT_EQ(match.route, RestRoute::MODEL_METADATA);
+    EXPECT_EQ(match.modelName, "resnet");
+
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/versions/3/metadata", match));
+    EXPECT_EQ(match.route, RestRoute::MODEL_METADATA);
+    EXPECT_EQ(match.modelVersion.value(), "3");
+}
+
+TEST(RestRouter, Predict) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet:predict", match));
+    EXPECT_EQ(match.route, RestRoute::PREDICT);
+    EXPECT_EQ(match.modelName, "resnet");
+    EXPECT_EQ(match.processingMethod, "predict");
+
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/versions/1:classify", match));
+    EXPECT_EQ(match.processingMethod, "classify");
+    EXPECT_EQ(match.modelVersion.value(), "1");
+
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/labels/latest:regress", match));
+    EXPECT_EQ(match.processingMethod, "regress");
+    EXPECT_EQ(match.modelVersionLabel.value(), "latest");
+}
+
+TEST(RestRouter, SingleCharacterBeforePathIsAccepted) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("x/v1/models/resnet:predict", match));
+    EXPECT_EQ(match.route, RestRoute::PREDICT);
+    EXPECT_EQ(match.modelName, "resnet");
+    ASSERT_TRUE(matchRestRoute("//metrics", match));
+    EXPECT_EQ(match.route, RestRoute::METRICS);
+    EXPECT_FALSE(matchRestRoute("xy/metrics", match));
+    EXPECT_EQ(match.route, RestRoute::NONE);
+}
+
+TEST(RestRouter, ServerRoutes) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/health/live", match));
+    EXPECT_EQ(match.route, RestRoute::HEALTH);
+    EXPECT_EQ(match.probe, "live");
+    ASSERT_TRUE(matchRestRoute("/v1/health/ready", match));
+    EXPECT_EQ(match.probe, "ready");
+    ASSERT_TRUE(matchRestRoute("/metrics", match));
+    EXPECT_EQ(match.route, RestRoute::METRICS);
+    ASSERT_TRUE(matchRestRoute("/v1/profile", match));
+    EXPECT_EQ(match.route, RestRoute::PROFILE);
+    EXPECT_TRUE(match.query.empty());
+    ASSERT_TRUE(matchRestRoute("/v1/profile?seconds=5&frequency=99", match));
+    EXPECT_EQ(match.query, "seconds=5&frequency=99");
+}
+
+TEST(RestRouter, PerfCounters) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/perf_counters", match));
+    EXPECT_EQ(match.route, RestRoute::PERF_COUNTERS);
+    EXPECT_EQ(match.modelName, "resnet");
+    EXPECT_TRUE(match.query.empty());
+    ASSERT_TRUE(matchRestRoute("/v1/models/resnet/versions/2/perf_counters?inferences=10", match));
+    EXPECT_EQ(match.route, RestRoute::PERF_COUNTERS);
+    EXPECT_EQ(match.modelVersion.value(), "2");
+    EXPECT_EQ(match.query, "inferences=10");
+    EXPECT_FALSE(matchRestRoute("/v1/models/resnet/labels/stable/perf_counters", match));
+}
+
+TEST(RestRouter, InvalidPaths) {
+    RestRouteMatch match;
+    for (const std::string path : {
+             "",
+             "/",
+             "/v1/models",
+             "/v1/models/",
+             "/v1/models/resnet/",
+             "/v1/models/resnet:infer",
+             "/v1/models/resnet/versions/",
+             "/v1/models/resnet/versions/a",
+             "/v1/models/resnet/versions/1/labels/a",
+             "/v1/models/resnet/labels/a-b",
+             "/v1/models/resnet/metadata/",
+             "/v1/models/resnet/versions/1:predict/metadata",
+             "/v1/health/dead",
+             "/v1/health",
+             "/metricsx",
+             "/v1/profilex",
+             "/v2/models/resnet",
+         }) {
+        EXPECT_FALSE(matchRestRoute(path, match)) << path;
+        EXPECT_EQ(match.route, RestRoute::NONE) << path;
+    }
+}
+
+TEST(RestRouter, SharedMemory) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/shared_memory", match));
+    EXPECT_EQ(match.route, RestRoute::SHARED_MEMORY);
+    EXPECT_TRUE(match.regionName.empty());
+    ASSERT_TRUE(matchRestRoute("/v1/shared_memory/frames_0:register", match));
+    EXPECT_EQ(match.route, RestRoute::SHARED_MEMORY);
+    EXPECT_EQ(match.regionName, "frames_0");
+    EXPECT_EQ(match.regionAction, "register");
+    ASSERT_TRUE(matchRestRoute("/v1/shared_memory/frames_0:unregister", match));
+    EXPECT_EQ(match.regionAction, "unregister");
+    EXPECT_FALSE(matchRestRoute("/v1/shared_memory/frames_0", match));
+    EXPECT_EQ(match.route, RestRoute::NONE);
+    EXPECT_FALSE(matchRestRoute("/v1/shared_memory/:register", match));
+    EXPECT_FALSE(matchRestRoute("/v1/shared_memory/frames_0:delete", match));
+}
+
+TEST(RestRouter, Jobs) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/jobs", match));
+    EXPECT_EQ(match.route, RestRoute::JOBS);
+    EXPECT_TRUE(match.jobId.empty());
+    ASSERT_TRUE(matchRestRoute("/v1/jobs/17", match));
+    EXPECT_EQ(match.route, RestRoute::JOBS);
+    EXPECT_EQ(match.jobId, "17");
+    EXPECT_TRUE(match.jobAction.empty());
+    ASSERT_TRUE(matchRestRoute("/v1/jobs/17:cancel", match));
+    EXPECT_EQ(match.jobId, "17");
+    EXPECT_EQ(match.jobAction, "cancel");
+    EXPECT_FALSE(matchRestRoute("/v1/jobs/first", match));
+    EXPECT_EQ(match.route, RestRoute::NONE);
+    EXPECT_FALSE(matchRestRoute("/v1/jobs/17:pause", match));
+    EXPECT_FALSE(matchRestRoute("/v1/jobs/17/results", match));
+}
+
+TEST(RestRouter, BatchPredict) {
+    RestRouteMatch match;
+    ASSERT_TRUE(matchRestRoute("/v1/batch:predict", match));
+    EXPECT_EQ(match.route, RestRoute::BATCH_PREDICT);
+    EXPECT_FALSE(matchRestRoute("/v1/batch", match));
+    EXPECT_FALSE(matchRestRoute("/v1/batch:classify", match));
+}
@@ -13,6 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <limits>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -236,6 +238,37 @@ TEST_F(RestUtilsTest, MakeJsonFromPredictResponse_ErrorWhenNoOutputs) {
     EXPECT_EQ(makeJsonFromPredictResponse(proto, &json, Order::COLUMN), StatusCode::REST_PROTO_TO_STRING_ERROR);
 }
 
+TEST_F(RestUtilsTest, MakeJsonFromPredictResponse_RowOrderDifferentBatchSizesError) {
+    output2->mutable_tensor_shape()->mutable_dim(0)->set_size(1);
+    output2->mutable_tensor_shape()->mutable_dim(1)->set_size(10);
+    EXPECT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::REST_PROTO_TO_STRING_ERROR);
+    EXPECT_EQ(makeJsonFromPredictResponse(proto, &json, Order::COLUMN), StatusCode::OK);
+}
+
+TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_FloatShortestRepresentation) {
+    float data[4] = {0.1f, 3.0f, -1.25e-7f, 123456.7f};
+    output->mutable_tensor_shape()->mutable_dim(1)->set_size(4);
+    output->set_dtype(tensorflow::DataType::DT_FLOAT);
+    output->mutable_tensor_content()->assign(reinterpret_cast<const char*>(data), 4 * sizeof(float));
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "predictions": [[0.1, 3.0, -1.25e-07, 123456.703]
+    ]
+})");
+}
+
+TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_FloatNonFinite) {
+    float data[3] = {std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+    output->mutable_tensor_shape()->mutable_dim(1)->set_size(3);
+    output->set_dtype(tensorflow::DataType::DT_FLOAT);
+    output->mutable_tensor_content()->assign(reinterpret_cast<const char*>(data), 3 * sizeof(float));
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "predictions": [[NaN, Infinity, -Infinity]
+    ]
+})");
+}
+
 TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Float) {
     float data = 92.5f;
     output->set_dtype(tensorflow::DataType::DT_FLOAT);
@@ -255,6 +288,31 @@ TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Float) {
 })");
 }
 
+TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Half) {
+    // 0.1 and 2 in FP16
+    const uint16_t data[] = {0x2E66, 0x4000};
+    output->set_dtype(tensorflow::DataType::DT_HALF);
+    output->mutable_tensor_shape()->mutable_dim(1)->set_size(2);
+    output->mutable_tensor_content()->assign(reinterpret_cast<const char*>(data), sizeof(data));
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "predictions": [[0.099976, 2.0]
+    ]
+})");
+}
+
+TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Bfloat16) {
+    // 92.5 in BF16
+    const uint16_t data = 0x42B9;
+    output->set_dtype(tensorflow::DataType::DT_BFLOAT16);
+    output->mutable_tensor_content()->assign(reinterpret_cast<const char*>(&data), sizeof(data));
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "predictions": [[92.5]
+    ]
+})");
+}
+
 TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Double) {
     double data = 15.99;
     output->set_dtype(tensorflow::DataType::DT_DOUBLE);
@@ -350,6 +408,25 @@ TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Uint8) {
 })");
 }
 
+TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Uint16) {
+    uint16_t data = 65000;
+    output->set_dtype(tensorflow::DataType::DT_UINT16);
+    output->mutable_tensor_content()->assign(reinterpret_cast<const char*>(&data), sizeof(uint16_t));
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "predictions": [[65000]
+    ]
+})");
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::COLUMN), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "outputs": [
+        [
+            65000
+        ]
+    ]
+})");
+}
+
 TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Int64) {
     int64_t data = -658324;
     output->set_dtype(tensorflow::DataType::DT_INT64);
@@ -406,3 +483,22 @@ TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Uint64) {
     ]
 })");
 }
+
+TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Bool) {
+    uint8_t data = 1;
+    output->set_dtype(tensorflow::DataType::DT_BOOL);
+    output->mutable_tensor_content()->assign(reinterpret_cast<const char*>(&data), sizeof(uint8_t));
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "predictions": [[true]
+    ]
+})");
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::COLUMN), StatusCode::OK);
+    EXPECT_EQ(json, R"({
+    "outputs": [
+        [
+            true
+        ]
+    ]
+})");
+}
@@ -0,0 +1,39 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../s3filesystem.hpp"
+
+using ovms::S3FileSystem;
+
+TEST(S3FileSystem, SplitIntoPartsCoversWholeObject) {
+    auto parts = S3FileSystem::splitIntoParts(10, 4);
+    std::vector<std::pair<uint64_t, uint64_t>> expected{{0, 4}, {4, 4}, {8, 2}};
+    EXPECT_EQ(parts, expected);
+}
+
+TEST(S3FileSystem, SplitIntoPartsOfExactMultiple) {
+    auto parts = S3FileSystem::splitIntoParts(8, 4);
+    std::vector<std::pair<uint64_t, uint64_t>> expected{{0, 4}, {4, 4}};
+    EXPECT_EQ(parts, expected);
+}
+
+TEST(S3FileSystem, SplitEmptyObject) {
+    EXPECT_EQ(S3FileSystem::splitIntoParts(0, 4).size(), 0);
+}
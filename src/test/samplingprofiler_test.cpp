@@ -0,0 +1,72 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../samplingprofiler.hpp"
+
+using namespace ovms;
+
+TEST(SamplingProfiler, InvalidParametersRejected) {
+    std::string profile;
+    EXPECT_EQ(SamplingProfiler::getInstance().profile(std::chrono::seconds(0), 99, profile), StatusCode::PROFILER_INVALID_PARAMETERS);
+    EXPECT_EQ(SamplingProfiler::getInstance().profile(std::chrono::seconds(SamplingProfiler::MAX_DURATION_SECONDS + 1), 99, profile),
+        StatusCode::PROFILER_INVALID_PARAMETERS);
+    EXPECT_EQ(SamplingProfiler::getInstance().profile(std::chrono::seconds(1), 0, profile), StatusCode::PROFILER_INVALID_PARAMETERS);
+    EXPECT_EQ(SamplingProfiler::getInstance().profile(std::chrono::seconds(1), SamplingProfiler::MAX_FREQUENCY + 1, profile),
+        StatusCode::PROFILER_INVALID_PARAMETERS);
+}
+
+TEST(SamplingProfiler, BusyThreadSampledWithItsName) {
+    std::atomic<bool> stop{false};
+    std::thread busy([&stop]() {
+        setCurrentThreadName("profiled_busy");
+        volatile uint64_t counter = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            counter = counter + 1;
+        }
+    });
+    std::string otherProfile;
+    std::thread concurrent([&otherProfile]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        EXPECT_EQ(SamplingProfiler::getInstance().profile(std::chrono::seconds(1), 99, otherProfile), StatusCode::PROFILER_ALREADY_RUNNING);
+    });
+    std::string profile;
+    auto status = SamplingProfiler::getInstance().profile(std::chrono::seconds(1), 199, profile);
+    stop = true;
+    busy.join();
+    concurrent.join();
+    ASSERT_EQ(status, StatusCode::OK);
+
+    uint64_t busySamples = 0;
+    std::stringstream lines(profile);
+    std::string line;
+    while (std::getline(lines, line)) {
+        auto countPosition = line.rfind(' ');
+        ASSERT_NE(countPosition, std::string::npos) << line;
+        if (line.rfind("profiled_busy;", 0) == 0) {
+            busySamples += std::stoull(line.substr(countPosition + 1));
+        }
+    }
+    // thread spinning for a second at 199 Hz, some ticks may land on other threads
+    EXPECT_GT(busySamples, 50);
+}
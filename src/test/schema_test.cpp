@@ -13,6 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <cstdio>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -676,3 +678,30 @@ TEST(SchemaTest, parseModelMappingWhenConfigIsNotJson) {
     result = ovms::validateJsonAgainstSchema(mappingConfigIsNotAJsonParsed, ovms::MODELS_MAPPING_OUTPUTS_SCHEMA);
     EXPECT_EQ(result, ovms::StatusCode::JSON_INVALID);
 }
+
+TEST(SchemaTest, ModelConfigPrecision) {
+    const char* modelConfigTemplate = R"({
+    "model_config_list": [
+        {
+            "config": {
+                "name": "dummy_model",
+                "base_path": "dummy_path",
+                "precision": %s
+            }
+        }
+    ]})";
+    for (const char* precision : {R"("U8")", R"({"image": "U8", "scale": "FP32"})"}) {
+        char modelConfig[512];
+        std::snprintf(modelConfig, sizeof(modelConfig), modelConfigTemplate, precision);
+        rapidjson::Document modelConfigParsed;
+        modelConfigParsed.Parse(modelConfig);
+        EXPECT_EQ(ovms::validateJsonAgainstSchema(modelConfigParsed, ovms::MODELS_CONFIG_SCHEMA), ovms::StatusCode::OK) << precision;
+    }
+    for (const char* precision : {R"("U32")", R"({"image": "FP64"})", "8"}) {
+        char modelConfig[512];
+        std::snprintf(modelConfig, sizeof(modelConfig), modelConfigTemplate, precision);
+        rapidjson::Document modelConfigParsed;
+        modelConfigParsed.Parse(modelConfig);
+        EXPECT_EQ(ovms::validateJsonAgainstSchema(modelConfigParsed, ovms::MODELS_CONFIG_SCHEMA), ovms::StatusCode::JSON_INVALID) << precision;
+    }
+}
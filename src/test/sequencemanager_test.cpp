@@ -0,0 +1,159 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "../sequencemanager.hpp"
+
+using namespace ovms;
+
+namespace {
+void addSequenceInputs(tensorflow::serving::PredictRequest& request, uint64_t sequenceId, uint32_t sequenceControl) {
+    auto& id = (*request.mutable_inputs())[SEQUENCE_ID_INPUT];
+    id.set_dtype(tensorflow::DataType::DT_UINT64);
+    id.mutable_tensor_shape()->add_dim()->set_size(1);
+    id.add_uint64_val(sequenceId);
+    auto& control = (*request.mutable_inputs())[SEQUENCE_CONTROL_INPUT];
+    control.set_dtype(tensorflow::DataType::DT_UINT32);
+    control.mutable_tensor_content()->assign(reinterpret_cast<const char*>(&sequenceControl), sizeof(sequenceControl));
+}
+}  // namespace
+
+TEST(SequenceProcessingSpec, ReadsIdAndControl) {
+    tensorflow::serving::PredictRequest request;
+    addSequenceInputs(request, 42, SEQUENCE_END);
+    (*request.mutable_inputs())["data"].set_dtype(tensorflow::DataType::DT_FLOAT);
+    uint64_t sequenceId;
+    uint32_t sequenceControl;
+    ASSERT_EQ(getSequenceProcessingSpec(request, sequenceId, sequenceControl), StatusCode::OK);
+    EXPECT_EQ(sequenceId, 42);
+    EXPECT_EQ(sequenceControl, SEQUENCE_END);
+    EXPECT_EQ(countSequenceInputs(request), 2);
+    EXPECT_TRUE(isSequenceInput(SEQUENCE_CONTROL_INPUT));
+    EXPECT_FALSE(isSequenceInput("data"));
+}
+
+TEST(SequenceProcessingSpec, RejectsInvalidInputs) {
+    uint64_t sequenceId;
+    uint32_t sequenceControl;
+    tensorflow::serving::PredictRequest request;
+    EXPECT_EQ(getSequenceProcessingSpec(request, sequenceId, sequenceControl), StatusCode::SEQUENCE_ID_NOT_PROVIDED);
+
+    addSequenceInputs(request, 0, SEQUENCE_START);
+    EXPECT_EQ(getSequenceProcessingSpec(request, sequenceId, sequenceControl), StatusCode::OK);
+
+    addSequenceInputs(request, 1, 3);
+    EXPECT_EQ(getSequenceProcessingSpec(request, sequenceId, sequenceControl), StatusCode::INVALID_SEQUENCE_CONTROL_INPUT);
+
+    request.Clear();
+    addSequenceInputs(request, 1, NO_CONTROL_INPUT);
+    (*request.mutable_inputs())[SEQUENCE_ID_INPUT].set_dtype(tensorflow::DataType::DT_INT64);
+    EXPECT_EQ(getSequenceProcessingSpec(request, sequenceId, sequenceControl), StatusCode::INVALID_SEQUENCE_CONTROL_INPUT);
+
+    request.Clear();
+    addSequenceInputs(request, 1, NO_CONTROL_INPUT);
+    (*request.mutable_inputs())[SEQUENCE_ID_INPUT].add_uint64_val(2);
+    EXPECT_EQ(getSequenceProcessingSpec(request, sequenceId, sequenceControl), StatusCode::INVALID_SEQUENCE_CONTROL_INPUT);
+}
+
+TEST(SequenceProcessingSpec, AddsSequenceIdOutput) {
+    tensorflow::serving::PredictResponse response;
+    addSequenceIdOutput(7, response);
+    const auto& output = response.outputs().at(SEQUENCE_ID_INPUT);
+    EXPECT_EQ(output.dtype(), tensorflow::DataType::DT_UINT64);
+    ASSERT_EQ(output.tensor_content().size(), sizeof(uint64_t));
+    uint64_t sequenceId;
+    std::memcpy(&sequenceId, output.tensor_content().data(), sizeof(sequenceId));
+    EXPECT_EQ(sequenceId, 7);
+}
+
+TEST(SequenceManager, StartsFindsAndRemovesSequences) {
+    SequenceManager manager(10, std::chrono::seconds(60));
+    std::shared_ptr<Sequence> sequence;
+    uint64_t sequenceId = 0;
+    ASSERT_EQ(manager.getSequence(sequenceId, SEQUENCE_START, sequence), StatusCode::OK);
+    EXPECT_NE(sequenceId, 0);
+    EXPECT_EQ(sequence->getId(), sequenceId);
+
+    std::shared_ptr<Sequence> found;
+    ASSERT_EQ(manager.getSequence(sequenceId, NO_CONTROL_INPUT, found), StatusCode::OK);
+    EXPECT_EQ(found, sequence);
+    EXPECT_EQ(manager.getSequence(sequenceId, SEQUENCE_START, found), StatusCode::SEQUENCE_ALREADY_EXISTS);
+
+    manager.removeSequence(sequenceId);
+    EXPECT_TRUE(sequence->isTerminated());
+    EXPECT_EQ(manager.getSequence(sequenceId, SEQUENCE_END, found), StatusCode::SEQUENCE_MISSING);
+    EXPECT_EQ(manager.getSequencesCount(), 0);
+}
+
+TEST(SequenceManager, AssignedIdsSkipIdsOfClients) {
+    SequenceManager manager(10, std::chrono::seconds(60));
+    std::shared_ptr<Sequence> sequence;
+    uint64_t clientId = 1;
+    ASSERT_EQ(manager.getSequence(clientId, SEQUENCE_START, sequence), StatusCode::OK);
+    uint64_t assignedId = 0;
+    ASSERT_EQ(manager.getSequence(assignedId, SEQUENCE_START, sequence), StatusCode::OK);
+    EXPECT_NE(assignedId, clientId);
+    EXPECT_EQ(manager.getSequencesCount(), 2);
+}
+
+TEST(SequenceManager, DropsIdleSequencesAndLimitsNumber) {
+    SequenceManager manager(2, std::chrono::seconds(10));
+    const auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<Sequence> first, second, third;
+    uint64_t firstId = 0, secondId = 0, thirdId = 0;
+    ASSERT_EQ(manager.getSequence(firstId, SEQUENCE_START, first, start), StatusCode::OK);
+    ASSERT_EQ(manager.getSequence(secondId, SEQUENCE_START, second, start + std::chrono::seconds(5)), StatusCode::OK);
+    EXPECT_EQ(manager.getSequence(thirdId, SEQUENCE_START, third, start + std::chrono::seconds(6)), StatusCode::MAX_SEQUENCE_NUMBER_REACHED);
+
+    // first sequence is idle for longer than timeout and makes room for a new one
+    thirdId = 0;
+    ASSERT_EQ(manager.getSequence(thirdId, SEQUENCE_START, third, start + std::chrono::seconds(11)), StatusCode::OK);
+    EXPECT_TRUE(first->isTerminated());
+    std::shared_ptr<Sequence> found;
+    EXPECT_EQ(manager.getSequence(firstId, NO_CONTROL_INPUT, found, start + std::chrono::seconds(11)), StatusCode::SEQUENCE_MISSING);
+    ASSERT_EQ(manager.getSequence(secondId, NO_CONTROL_INPUT, found, start + std::chrono::seconds(11)), StatusCode::OK);
+    EXPECT_EQ(found, second);
+}
+
+TEST(SequenceManager, AssignedIdsAreUniqueAcrossManagers) {
+    SequenceManager first(10, std::chrono::seconds(60));
+    SequenceManager second(10, std::chrono::seconds(60));
+    std::shared_ptr<Sequence> sequence;
+    uint64_t firstId = 0, secondId = 0;
+    ASSERT_EQ(first.getSequence(firstId, SEQUENCE_START, sequence), StatusCode::OK);
+    ASSERT_EQ(second.getSequence(secondId, SEQUENCE_START, sequence), StatusCode::OK);
+    EXPECT_NE(firstId, secondId);
+    EXPECT_TRUE(first.hasSequence(firstId));
+    EXPECT_FALSE(second.hasSequence(firstId));
+}
+
+TEST(SequenceManager, ContinuedSequenceIdOfRequest) {
+    tensorflow::serving::PredictRequest request;
+    EXPECT_EQ(getContinuedSequenceId(request), 0);
+    addSequenceInputs(request, 42, SEQUENCE_START);
+    EXPECT_EQ(getContinuedSequenceId(request), 0);
+    request.Clear();
+    addSequenceInputs(request, 42, NO_CONTROL_INPUT);
+    EXPECT_EQ(getContinuedSequenceId(request), 42);
+    request.Clear();
+    addSequenceInputs(request, 42, SEQUENCE_END);
+    EXPECT_EQ(getContinuedSequenceId(request), 42);
+}
@@ -59,7 +59,7 @@ const std::vector<Precision> SUPPORTED_OUTPUT_PRECISIONS{
     Precision::I32,
     Precision::I64,
     // Precision::BIN,
-    // Precision::BOOL
+    Precision::BOOL
     // //Precision::CUSTOM)
 };
 
@@ -76,7 +76,7 @@ const std::vector<Precision> UNSUPPORTED_OUTPUT_PRECISIONS{
     // Precision::I32,
     // Precision::I64,
     Precision::BIN,
-    Precision::BOOL
+    // Precision::BOOL
     // Precision::CUSTOM),
 };
 
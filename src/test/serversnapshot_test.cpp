@@ -0,0 +1,130 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../serversnapshot.hpp"
+
+using ovms::ServerSnapshot;
+
+class ServerSnapshotTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        writeFile(modelFile, "model");
+    }
+
+    void TearDown() override {
+        ServerSnapshot::getInstance().configure("");
+        std::filesystem::remove_all(directory);
+    }
+
+    static void writeFile(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+
+    const std::string directory = "/tmp/ovms_server_snapshot_test";
+    const std::string snapshotPath = directory + "/snapshot.json";
+    const std::string modelFile = directory + "/model.xml";
+};
+
+TEST_F(ServerSnapshotTest, DisabledByDefault) {
+    auto& snapshot = ServerSnapshot::getInstance();
+    EXPECT_FALSE(snapshot.isEnabled());
+    snapshot.recordFileHash(modelFile, 1, 42);
+    EXPECT_FALSE(snapshot.findFileHash(modelFile, 1).has_value());
+    EXPECT_EQ(snapshot.save(), ovms::StatusCode::OK);
+    EXPECT_FALSE(std::filesystem::exists(snapshotPath));
+}
+
+TEST_F(ServerSnapshotTest, RestoresStateSavedBeforeRestart) {
+    auto& snapshot = ServerSnapshot::getInstance();
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    snapshot.recordModelVersions("resnet", "s3://bucket/resnet", {1, 3});
+    snapshot.recordFileHash(modelFile, 1, 42);
+    snapshot.recordTuningResult("resnet", 3, "CPU;16", {4, 8});
+    ASSERT_EQ(snapshot.save(), ovms::StatusCode::OK);
+
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    EXPECT_FALSE(snapshot.hasRestoredModels());
+    ovms::model_versions_t versions;
+    ASSERT_TRUE(snapshot.takeModelVersions("resnet", "s3://bucket/resnet", versions));
+    EXPECT_EQ(versions, ovms::model_versions_t({1, 3}));
+    EXPECT_TRUE(snapshot.hasRestoredModels());
+    EXPECT_FALSE(snapshot.takeModelVersions("resnet", "s3://bucket/resnet", versions));
+    EXPECT_EQ(snapshot.findFileHash(modelFile, 1), 42);
+    EXPECT_FALSE(snapshot.findFileHash(modelFile, 2).has_value());
+    auto candidate = snapshot.findTuningResult("resnet", 3, "CPU;16");
+    ASSERT_TRUE(candidate.has_value());
+    EXPECT_EQ(*candidate, ovms::TuningCandidate({4, 8}));
+    EXPECT_FALSE(snapshot.findTuningResult("resnet", 3, "CPU;8").has_value());
+}
+
+TEST_F(ServerSnapshotTest, ModelVersionsNotRestoredForChangedBasePath) {
+    auto& snapshot = ServerSnapshot::getInstance();
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    snapshot.recordModelVersions("resnet", "s3://bucket/resnet", {1});
+    ASSERT_EQ(snapshot.save(), ovms::StatusCode::OK);
+
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    ovms::model_versions_t versions;
+    EXPECT_FALSE(snapshot.takeModelVersions("resnet", "gs://bucket/resnet", versions));
+    EXPECT_TRUE(versions.empty());
+    EXPECT_FALSE(snapshot.hasRestoredModels());
+}
+
+TEST_F(ServerSnapshotTest, FileHashInvalidatedByChangedFile) {
+    auto& snapshot = ServerSnapshot::getInstance();
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    snapshot.recordFileHash(modelFile, 1, 42);
+    ASSERT_EQ(snapshot.save(), ovms::StatusCode::OK);
+
+    writeFile(modelFile, "changed model");
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    EXPECT_FALSE(snapshot.findFileHash(modelFile, 1).has_value());
+}
+
+TEST_F(ServerSnapshotTest, UnusedEntriesAreNotSavedAgain) {
+    auto& snapshot = ServerSnapshot::getInstance();
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    snapshot.recordFileHash(modelFile, 1, 42);
+    snapshot.recordTuningResult("resnet", 1, "CPU;16", {4, 8});
+    ASSERT_EQ(snapshot.save(), ovms::StatusCode::OK);
+
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    ASSERT_EQ(snapshot.save(), ovms::StatusCode::OK);
+    ASSERT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    EXPECT_FALSE(snapshot.findFileHash(modelFile, 1).has_value());
+    EXPECT_FALSE(snapshot.findTuningResult("resnet", 1, "CPU;16").has_value());
+}
+
+TEST_F(ServerSnapshotTest, CorruptedSnapshotIsIgnored) {
+    writeFile(snapshotPath, R"({"models": {"resnet": {"base_path": "s3://bucket/resnet", "versions": ["one"]}}})");
+    auto& snapshot = ServerSnapshot::getInstance();
+    EXPECT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    EXPECT_TRUE(snapshot.isEnabled());
+    ovms::model_versions_t versions;
+    EXPECT_FALSE(snapshot.takeModelVersions("resnet", "s3://bucket/resnet", versions));
+
+    writeFile(snapshotPath, "not json");
+    EXPECT_EQ(snapshot.configure(snapshotPath), ovms::StatusCode::OK);
+    EXPECT_FALSE(snapshot.takeModelVersions("resnet", "s3://bucket/resnet", versions));
+}
@@ -0,0 +1,135 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../modelinstance.hpp"
+#include "../modelinstanceunloadguard.hpp"
+#include "../prediction_service_utils.hpp"
+#include "../shapebuckets.hpp"
+#include "test_utils.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+using testing::Eq;
+
+namespace {
+std::string asContent(const std::vector<int32_t>& values) {
+    return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int32_t));
+}
+
+ovms::ShapeBucket prepareBucket(size_t size) {
+    ovms::ShapeBucket bucket;
+    bucket.size = size;
+    bucket.inputsInfo["ids"] = std::make_shared<ovms::TensorInfo>("ids", InferenceEngine::Precision::I32, ovms::shape_t{1, size});
+    bucket.inputsInfo["scalar"] = std::make_shared<ovms::TensorInfo>("scalar", InferenceEngine::Precision::I32, ovms::shape_t{1});
+    bucket.outputsInfo["tokens"] = std::make_shared<ovms::TensorInfo>("tokens", InferenceEngine::Precision::I32, ovms::shape_t{1, size, 2});
+    bucket.outputsInfo["pooled"] = std::make_shared<ovms::TensorInfo>("pooled", InferenceEngine::Precision::I32, ovms::shape_t{1, 2});
+    return bucket;
+}
+}  // namespace
+
+TEST(ShapeBuckets, FindSmallestFittingBucket) {
+    const std::vector<size_t> sizes{32, 64, 128};
+    EXPECT_EQ(ovms::findShapeBucket(sizes, 1), 0);
+    EXPECT_EQ(ovms::findShapeBucket(sizes, 32), 0);
+    EXPECT_EQ(ovms::findShapeBucket(sizes, 33), 1);
+    EXPECT_EQ(ovms::findShapeBucket(sizes, 128), 2);
+    EXPECT_EQ(ovms::findShapeBucket(sizes, 129), std::nullopt);
+}
+
+TEST(ShapeBuckets, PadAndCropAlongDimension) {
+    // 2x2x2 tensor padded along middle dimension to 3
+    const std::string content = asContent({1, 2, 3, 4, 5, 6, 7, 8});
+    const std::string padded = ovms::padAlongDimension(content, {2, 2, 2}, 1, 3, sizeof(int32_t));
+    EXPECT_EQ(padded, asContent({1, 2, 3, 4, 0, 0, 5, 6, 7, 8, 0, 0}));
+    EXPECT_EQ(ovms::cropAlongDimension(padded, {2, 3, 2}, 1, 2, sizeof(int32_t)), content);
+    EXPECT_EQ(ovms::cropAlongDimension(content, {2, 2, 2}, 2, 1, sizeof(int32_t)), asContent({1, 3, 5, 7}));
+}
+
+TEST(ShapeBuckets, PadRequestAndCropResponse) {
+    auto bucket = prepareBucket(4);
+    auto request = preparePredictRequest(
+        {{"ids", std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 3}, tensorflow::DataType::DT_INT32}},
+            {"scalar", std::tuple<ovms::shape_t, tensorflow::DataType>{{1}, tensorflow::DataType::DT_INT32}}});
+    (*request.mutable_inputs())["ids"].mutable_tensor_content()->assign(asContent({7, 8, 9}));
+    size_t length = 0;
+    ASSERT_TRUE(ovms::getShapeBucketLength(request, bucket.inputsInfo, 1, length));
+    EXPECT_EQ(length, 3);
+
+    tensorflow::serving::PredictRequest padded;
+    ASSERT_EQ(ovms::padRequestToShapeBucket(request, bucket, 1, padded), ovms::StatusCode::OK);
+    EXPECT_THAT(asVector(padded.inputs().at("ids").tensor_shape()), ElementsAre(1, 4));
+    EXPECT_THAT(asVector<int32_t>(padded.inputs().at("ids").tensor_content()), ElementsAre(7, 8, 9, 0));
+    EXPECT_EQ(padded.inputs().at("scalar").tensor_content(), request.inputs().at("scalar").tensor_content());
+
+    tensorflow::serving::PredictResponse response;
+    auto& tokens = (*response.mutable_outputs())["tokens"];
+    for (auto dim : {1, 4, 2}) {
+        tokens.mutable_tensor_shape()->add_dim()->set_size(dim);
+    }
+    tokens.set_tensor_content(asContent({1, 2, 3, 4, 5, 6, 7, 8}));
+    auto& pooled = (*response.mutable_outputs())["pooled"];
+    for (auto dim : {1, 2}) {
+        pooled.mutable_tensor_shape()->add_dim()->set_size(dim);
+    }
+    pooled.set_tensor_content(asContent({1, 2}));
+    ovms::cropResponseToLength(response, bucket, 1, length);
+    EXPECT_THAT(asVector(response.outputs().at("tokens").tensor_shape()), ElementsAre(1, 3, 2));
+    EXPECT_THAT(asVector<int32_t>(response.outputs().at("tokens").tensor_content()), ElementsAre(1, 2, 3, 4, 5, 6));
+    EXPECT_THAT(asVector<int32_t>(response.outputs().at("pooled").tensor_content()), ElementsAre(1, 2));
+}
+
+TEST(ShapeBuckets, RequestsOfDifferentLengthsDoNotMatch) {
+    auto bucket = prepareBucket(4);
+    bucket.inputsInfo["mask"] = std::make_shared<ovms::TensorInfo>("mask", InferenceEngine::Precision::I32, ovms::shape_t{1, 4});
+    auto request = preparePredictRequest(
+        {{"ids", std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 3}, tensorflow::DataType::DT_INT32}},
+            {"mask", std::tuple<ovms::shape_t, tensorflow::DataType>{{1, 2}, tensorflow::DataType::DT_INT32}},
+            {"scalar", std::tuple<ovms::shape_t, tensorflow::DataType>{{1}, tensorflow::DataType::DT_INT32}}});
+    size_t length = 0;
+    EXPECT_FALSE(ovms::getShapeBucketLength(request, bucket.inputsInfo, 1, length));
+}
+
+TEST(ShapeBuckets, VariableLengthRequestsInferredWithoutReshape) {
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    ASSERT_EQ(config.parseShapeParameter("auto"), ovms::StatusCode::OK);
+    config.setShapeBuckets({16, 8});
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    ASSERT_TRUE(modelInstance.hasShapeBuckets());
+
+    for (size_t length : {3, 8, 11}) {
+        auto request = preparePredictRequest(
+            {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, tensorflow::DataType>{{1, length}, tensorflow::DataType::DT_FLOAT}}});
+        std::vector<float> data(length, 1.0);
+        (*request.mutable_inputs())[DUMMY_MODEL_INPUT_NAME].mutable_tensor_content()->assign(
+            reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+        tensorflow::serving::PredictResponse response;
+        std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard = std::make_unique<ovms::ModelInstanceUnloadGuard>(modelInstance);
+        ASSERT_EQ(ovms::inference(modelInstance, &request, &response, unloadGuard), ovms::StatusCode::OK);
+        auto& output = response.outputs().at(DUMMY_MODEL_OUTPUT_NAME);
+        EXPECT_THAT(asVector(output.tensor_shape()), ElementsAre(1, length));
+        EXPECT_THAT(asVector<float>(output.tensor_content()), Each(Eq(2.)));
+        // model network keeps its shape
+        EXPECT_THAT(modelInstance.getInputsInfo().at(DUMMY_MODEL_INPUT_NAME)->getShape(), ElementsAre(1, DUMMY_MODEL_INPUT_SIZE));
+    }
+}
@@ -0,0 +1,77 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../shardedcounter.hpp"
+
+using ovms::ShardedCounter;
+
+TEST(ShardedCounter, CountsHeldReferences) {
+    ShardedCounter counter;
+    EXPECT_EQ(counter.get(), 0);
+    counter.increment();
+    counter.increment();
+    EXPECT_EQ(counter.get(), 2);
+    counter.decrement();
+    EXPECT_EQ(counter.get(), 1);
+    counter.decrement();
+    EXPECT_EQ(counter.get(), 0);
+}
+
+TEST(ShardedCounter, ReferenceReleasedByOtherThread) {
+    ShardedCounter counter;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&counter]() { counter.increment(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.get(), 4);
+    for (int i = 0; i < 4; ++i) {
+        counter.decrement();
+    }
+    EXPECT_EQ(counter.get(), 0);
+}
+
+TEST(ShardedCounter, HeldReferenceIsNeverMissedByConcurrentReads) {
+    ShardedCounter counter;
+    counter.increment();
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&counter, &stop]() {
+            while (!stop) {
+                counter.increment();
+                // released by another thread, so acquisitions and releases land in different shards
+                std::thread([&counter]() { counter.decrement(); }).join();
+            }
+        });
+    }
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_GE(counter.get(), 1);
+    }
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    counter.decrement();
+    EXPECT_EQ(counter.get(), 0);
+}
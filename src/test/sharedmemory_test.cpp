@@ -0,0 +1,121 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../sharedmemory.hpp"
+
+using namespace ovms;
+
+class SharedMemoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        key = "/ovms_test_" + std::to_string(getpid());
+        const int fd = shm_open(key.c_str(), O_CREAT | O_RDWR, 0600);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(ftruncate(fd, OBJECT_SIZE), 0);
+        void* mapping = mmap(nullptr, OBJECT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        ASSERT_NE(mapping, MAP_FAILED);
+        for (size_t i = 0; i < OBJECT_SIZE; ++i) {
+            static_cast<char*>(mapping)[i] = static_cast<char>(i % 251);
+        }
+        munmap(mapping, OBJECT_SIZE);
+        SharedMemoryRegistry::getInstance().setEnabled(true);
+    }
+
+    void TearDown() override {
+        auto& registry = SharedMemoryRegistry::getInstance();
+        registry.unregisterRegion("frames");
+        registry.setEnabled(false);
+        shm_unlink(key.c_str());
+    }
+
+    static tensorflow::TensorProto makeInput(const std::string& regionName, uint64_t offset) {
+        tensorflow::TensorProto input;
+        input.set_dtype(tensorflow::DataType::DT_FLOAT);
+        auto handle = input.add_resource_handle_val();
+        handle->set_container(SHARED_MEMORY_CONTAINER);
+        handle->set_name(regionName);
+        handle->set_hash_code(offset);
+        return input;
+    }
+
+    static const size_t OBJECT_SIZE = 3 * 4096;
+    std::string key;
+};
+
+TEST_F(SharedMemoryTest, MapsRegionAtUnalignedOffset) {
+    std::shared_ptr<SharedMemoryRegion> region;
+    ASSERT_EQ(SharedMemoryRegion::map(key, 5000, 1000, region), StatusCode::OK);
+    EXPECT_EQ(region->getByteSize(), 1000);
+    EXPECT_EQ(region->getData()[0], static_cast<char>(5000 % 251));
+    EXPECT_EQ(region->getData()[999], static_cast<char>(5999 % 251));
+}
+
+TEST_F(SharedMemoryTest, RejectsInvalidRegions) {
+    std::shared_ptr<SharedMemoryRegion> region;
+    EXPECT_EQ(SharedMemoryRegion::map(key, 0, OBJECT_SIZE + 1, region), StatusCode::SHARED_MEMORY_REGION_INVALID);
+    EXPECT_EQ(SharedMemoryRegion::map(key, OBJECT_SIZE, 1, region), StatusCode::SHARED_MEMORY_REGION_INVALID);
+    EXPECT_EQ(SharedMemoryRegion::map(key, 0, 0, region), StatusCode::SHARED_MEMORY_REGION_INVALID);
+    EXPECT_EQ(SharedMemoryRegion::map("/ovms_test_missing_object", 0, 1, region), StatusCode::SHARED_MEMORY_REGION_INVALID);
+    EXPECT_EQ(SharedMemoryRegion::map("/../etc/passwd", 0, 1, region), StatusCode::SHARED_MEMORY_REGION_INVALID);
+    EXPECT_EQ(region, nullptr);
+}
+
+TEST_F(SharedMemoryTest, RegistersRegions) {
+    auto& registry = SharedMemoryRegistry::getInstance();
+    ASSERT_EQ(registry.registerRegion("frames", key, 4096, 4096), StatusCode::OK);
+    EXPECT_EQ(registry.registerRegion("frames", key, 0, 4096), StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED);
+    EXPECT_EQ(registry.registerRegion("\"quoted\"", key, 0, 4096), StatusCode::SHARED_MEMORY_REGION_INVALID);
+    EXPECT_EQ(registry.toJson(), "{\"frames\": {\"key\": \"" + key + "\", \"offset\": 4096, \"byte_size\": 4096}}");
+    auto region = registry.find("frames");
+    ASSERT_NE(region, nullptr);
+    ASSERT_EQ(registry.unregisterRegion("frames"), StatusCode::OK);
+    EXPECT_EQ(registry.find("frames"), nullptr);
+    EXPECT_EQ(registry.unregisterRegion("frames"), StatusCode::SHARED_MEMORY_REGION_MISSING);
+    // mapping outlives unregistration while it is used
+    EXPECT_EQ(region->getData()[0], static_cast<char>(4096 % 251));
+}
+
+TEST_F(SharedMemoryTest, RegistrationCanBeDisabled) {
+    auto& registry = SharedMemoryRegistry::getInstance();
+    registry.setEnabled(false);
+    EXPECT_EQ(registry.registerRegion("frames", key, 0, 4096), StatusCode::SHARED_MEMORY_DISABLED);
+}
+
+TEST_F(SharedMemoryTest, ResolvesInputs) {
+    ASSERT_EQ(SharedMemoryRegistry::getInstance().registerRegion("frames", key, 0, 4096), StatusCode::OK);
+    tensorflow::TensorProto dataInput;
+    dataInput.set_dtype(tensorflow::DataType::DT_FLOAT);
+    EXPECT_FALSE(isSharedMemoryInput(dataInput));
+    auto input = makeInput("frames", 96);
+    ASSERT_TRUE(isSharedMemoryInput(input));
+    std::shared_ptr<const SharedMemoryRegion> region;
+    const char* data = nullptr;
+    ASSERT_EQ(getSharedMemoryInput(input, 4000, region, data), StatusCode::OK);
+    EXPECT_EQ(data, region->getData() + 96);
+    EXPECT_EQ(getSharedMemoryInput(input, 4001, region, data), StatusCode::SHARED_MEMORY_INPUT_OUT_OF_RANGE);
+    EXPECT_EQ(getSharedMemoryInput(makeInput("frames", 5000), 1, region, data), StatusCode::SHARED_MEMORY_INPUT_OUT_OF_RANGE);
+    EXPECT_EQ(getSharedMemoryInput(makeInput("other", 0), 1, region, data), StatusCode::SHARED_MEMORY_REGION_MISSING);
+}
@@ -0,0 +1,75 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../sharednetworks.hpp"
+
+using ovms::SharedNetworks;
+
+TEST(SharedNetworks, NetworkIsLoadedOnceWhileInUse) {
+    auto& sharedNetworks = SharedNetworks::getInstance();
+    size_t loads = 0;
+    auto load = [&loads]() {
+        ++loads;
+        return std::make_shared<InferenceEngine::ExecutableNetwork>();
+    };
+    auto first = sharedNetworks.getOrLoad("NetworkIsLoadedOnceWhileInUse", load);
+    auto second = sharedNetworks.getOrLoad("NetworkIsLoadedOnceWhileInUse", load);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(loads, 1);
+    auto other = sharedNetworks.getOrLoad("NetworkIsLoadedOnceWhileInUse;other", load);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(loads, 2);
+    first.reset();
+    second.reset();
+    other.reset();
+    EXPECT_EQ(sharedNetworks.size(), 0);
+    sharedNetworks.getOrLoad("NetworkIsLoadedOnceWhileInUse", load);
+    EXPECT_EQ(loads, 3);
+}
+
+TEST(SharedNetworks, FailedLoadIsNotRegistered) {
+    auto& sharedNetworks = SharedNetworks::getInstance();
+    auto network = sharedNetworks.getOrLoad("FailedLoadIsNotRegistered", []() { return nullptr; });
+    EXPECT_EQ(network, nullptr);
+    EXPECT_THROW(sharedNetworks.getOrLoad("FailedLoadIsNotRegistered", []() -> SharedNetworks::network_ptr_t { throw std::runtime_error("failed"); }),
+        std::runtime_error);
+    network = sharedNetworks.getOrLoad("FailedLoadIsNotRegistered", []() { return std::make_shared<InferenceEngine::ExecutableNetwork>(); });
+    EXPECT_NE(network, nullptr);
+}
+
+TEST(SharedNetworks, ConcurrentLoadsWaitForFirstOne) {
+    auto& sharedNetworks = SharedNetworks::getInstance();
+    std::atomic<size_t> loads{0};
+    auto load = [&loads]() {
+        ++loads;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return std::make_shared<InferenceEngine::ExecutableNetwork>();
+    };
+    SharedNetworks::network_ptr_t first, second;
+    std::thread firstThread([&]() { first = sharedNetworks.getOrLoad("ConcurrentLoadsWaitForFirstOne", load); });
+    std::thread secondThread([&]() { second = sharedNetworks.getOrLoad("ConcurrentLoadsWaitForFirstOne", load); });
+    firstThread.join();
+    secondThread.join();
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(first, second);
+}
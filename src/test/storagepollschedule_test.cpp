@@ -0,0 +1,93 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../storagepollschedule.hpp"
+
+using namespace std::chrono_literals;
+using ovms::StoragePollSchedule;
+
+TEST(StoragePollSchedule, FirstCheckIsSpreadAroundInterval) {
+    StoragePollSchedule schedule(7);
+    const auto start = StoragePollSchedule::clock::now();
+    EXPECT_FALSE(schedule.isDue("resnet", 60s, 240s, start));
+    EXPECT_FALSE(schedule.isDue("resnet", 60s, 240s, start + 29s));
+    EXPECT_TRUE(schedule.isDue("resnet", 60s, 240s, start + 91s));
+}
+
+TEST(StoragePollSchedule, NewModelsAreCheckedNowWhenRequested) {
+    StoragePollSchedule schedule(7);
+    schedule.setCheckNewModelsNow(true);
+    EXPECT_TRUE(schedule.isDue("resnet", 60s, 240s, StoragePollSchedule::clock::now()));
+}
+
+TEST(StoragePollSchedule, UnchangedChecksBackOffUpToMaximum) {
+    StoragePollSchedule schedule(7);
+    auto now = StoragePollSchedule::clock::now();
+    schedule.isDue("resnet", 60s, 240s, now);
+    schedule.reportCheck("resnet", false, now);
+    EXPECT_EQ(schedule.getInterval("resnet"), 120s);
+    EXPECT_FALSE(schedule.isDue("resnet", 60s, 240s, now + 95s));
+    EXPECT_TRUE(schedule.isDue("resnet", 60s, 240s, now + 145s));
+    schedule.reportCheck("resnet", false, now);
+    EXPECT_EQ(schedule.getInterval("resnet"), 240s);
+    schedule.reportCheck("resnet", false, now);
+    EXPECT_EQ(schedule.getInterval("resnet"), 240s);
+    schedule.reportCheck("resnet", true, now);
+    EXPECT_EQ(schedule.getInterval("resnet"), 60s);
+}
+
+TEST(StoragePollSchedule, ChangedIntervalsRestartSchedule) {
+    StoragePollSchedule schedule(7);
+    auto now = StoragePollSchedule::clock::now();
+    schedule.isDue("resnet", 60s, 240s, now);
+    schedule.reportCheck("resnet", false, now);
+    schedule.isDue("resnet", 10s, 240s, now);
+    EXPECT_EQ(schedule.getInterval("resnet"), 10s);
+    // maximum below base interval disables backoff
+    schedule.isDue("resnet", 10s, 1s, now);
+    schedule.reportCheck("resnet", false, now);
+    EXPECT_EQ(schedule.getInterval("resnet"), 10s);
+}
+
+TEST(StoragePollSchedule, ReplicasAreNotInSync) {
+    const auto start = StoragePollSchedule::clock::now();
+    std::set<int64_t> firstChecks;
+    for (uint32_t seed = 0; seed < 10; ++seed) {
+        StoragePollSchedule schedule(seed);
+        schedule.isDue("resnet", 60s, 240s, start);
+        auto now = start;
+        while (!schedule.isDue("resnet", 60s, 240s, now)) {
+            now += 100ms;
+        }
+        firstChecks.insert((now - start) / 100ms);
+    }
+    EXPECT_GT(firstChecks.size(), 5);
+}
+
+TEST(StoragePollSchedule, RetainForgetsRemovedModels) {
+    StoragePollSchedule schedule(7);
+    auto now = StoragePollSchedule::clock::now();
+    schedule.isDue("resnet", 60s, 240s, now);
+    schedule.isDue("dummy", 60s, 240s, now);
+    schedule.retain({"dummy"});
+    EXPECT_EQ(schedule.getInterval("resnet"), 0ms);
+    EXPECT_EQ(schedule.getInterval("dummy"), 60s);
+}
@@ -0,0 +1,108 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <vector>
+
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/sync_stream.h>
+#include <gtest/gtest.h>
+
+#include "../streaming_prediction_service.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+class StreamingPredictionServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ModelConfig config = DUMMY_MODEL_CONFIG;
+        config.setNireq(2);
+        ASSERT_EQ(manager.reloadModelWithVersions(config), StatusCode::OK);
+        service = std::make_unique<StreamingPredictionServiceImpl>(manager, 2);
+        grpc::ServerBuilder builder;
+        builder.RegisterService(service.get());
+        server = builder.BuildAndStart();
+        ASSERT_NE(server, nullptr);
+        channel = server->InProcessChannel(grpc::ChannelArguments());
+    }
+
+    void TearDown() override {
+        server->Shutdown();
+    }
+
+    std::unique_ptr<grpc::ClientReaderWriter<PredictRequest, PredictResponse>> openStream(grpc::ClientContext& context) {
+        grpc::internal::RpcMethod method(StreamingPredictionServiceImpl::PREDICT_STREAM_METHOD, grpc::internal::RpcMethod::BIDI_STREAMING, channel);
+        return std::unique_ptr<grpc::ClientReaderWriter<PredictRequest, PredictResponse>>(
+            grpc::internal::ClientReaderWriterFactory<PredictRequest, PredictResponse>::Create(channel.get(), method, &context));
+    }
+
+    static PredictRequest prepareFrame(const std::string& name, float value) {
+        PredictRequest request;
+        request.mutable_model_spec()->set_name(name);
+        auto& input = (*request.mutable_inputs())[DUMMY_MODEL_INPUT_NAME];
+        input.set_dtype(tensorflow::DataType::DT_FLOAT);
+        input.mutable_tensor_shape()->add_dim()->set_size(1);
+        input.mutable_tensor_shape()->add_dim()->set_size(DUMMY_MODEL_INPUT_SIZE);
+        std::vector<float> data(DUMMY_MODEL_INPUT_SIZE, value);
+        input.mutable_tensor_content()->assign(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+        return request;
+    }
+
+    ConstructorEnabledModelManager manager;
+    std::unique_ptr<StreamingPredictionServiceImpl> service;
+    std::unique_ptr<grpc::Server> server;
+    std::shared_ptr<grpc::Channel> channel;
+};
+
+TEST_F(StreamingPredictionServiceTest, ResponsesAreReturnedInOrderOfRequests) {
+    grpc::ClientContext context;
+    auto stream = openStream(context);
+    const int framesCount = 20;
+    for (int i = 0; i < framesCount; ++i) {
+        ASSERT_TRUE(stream->Write(prepareFrame("dummy", i)));
+    }
+    stream->WritesDone();
+    PredictResponse response;
+    for (int i = 0; i < framesCount; ++i) {
+        ASSERT_TRUE(stream->Read(&response)) << i;
+        ASSERT_EQ(response.outputs().count(DUMMY_MODEL_OUTPUT_NAME), 1);
+        const auto& content = response.outputs().at(DUMMY_MODEL_OUTPUT_NAME).tensor_content();
+        ASSERT_EQ(content.size(), DUMMY_MODEL_OUTPUT_SIZE * sizeof(float));
+        EXPECT_EQ(reinterpret_cast<const float*>(content.data())[0], i + 1) << i;
+    }
+    EXPECT_FALSE(stream->Read(&response));
+    EXPECT_TRUE(stream->Finish().ok());
+}
+
+TEST_F(StreamingPredictionServiceTest, StreamIsFinishedWithStatusOfFailedRequest) {
+    grpc::ClientContext context;
+    auto stream = openStream(context);
+    ASSERT_TRUE(stream->Write(prepareFrame("dummy", 1)));
+    stream->Write(prepareFrame("missing", 1));
+    stream->WritesDone();
+    PredictResponse response;
+    EXPECT_TRUE(stream->Read(&response));
+    EXPECT_FALSE(stream->Read(&response));
+    auto status = stream->Finish();
+    EXPECT_EQ(status.error_code(), Status(StatusCode::MODEL_NAME_MISSING).grpc().error_code());
+}
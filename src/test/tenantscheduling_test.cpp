@@ -0,0 +1,137 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../tenantscheduling.hpp"
+
+using namespace ovms;
+using namespace std::chrono_literals;
+
+class TenantsTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        Tenants::getInstance().configure("");
+    }
+};
+
+TEST_F(TenantsTest, ParseLimits) {
+    auto& tenants = Tenants::getInstance();
+    ASSERT_EQ(tenants.configure("default=50,batch=10:20:1,web=0:1:4"), StatusCode::OK);
+    EXPECT_TRUE(tenants.isEnabled());
+    EXPECT_EQ(tenants.getLimits("batch").requestsPerSecond, 10);
+    EXPECT_EQ(tenants.getLimits("batch").burst, 20);
+    EXPECT_EQ(tenants.getWeight("web"), 4);
+    EXPECT_EQ(tenants.getLimits("unknown").requestsPerSecond, 50);
+    EXPECT_EQ(tenants.getLimits("unknown").burst, 50);
+    EXPECT_EQ(tenants.getWeight(""), 1);
+
+    EXPECT_EQ(tenants.configure("batch"), StatusCode::TENANT_CONFIG_INVALID);
+    EXPECT_EQ(tenants.configure("batch=1:2:3:4"), StatusCode::TENANT_CONFIG_INVALID);
+    EXPECT_EQ(tenants.configure("batch=-1"), StatusCode::TENANT_CONFIG_INVALID);
+    EXPECT_EQ(tenants.configure("batch=1:1:0"), StatusCode::TENANT_CONFIG_INVALID);
+    EXPECT_EQ(tenants.configure(""), StatusCode::OK);
+    EXPECT_FALSE(tenants.isEnabled());
+}
+
+TEST_F(TenantsTest, RateLimitPerTenant) {
+    auto& tenants = Tenants::getInstance();
+    ASSERT_EQ(tenants.configure("default=2,web=0"), StatusCode::OK);
+    const auto now = std::chrono::steady_clock::now();
+    EXPECT_EQ(tenants.admit("a", now), StatusCode::OK);
+    EXPECT_EQ(tenants.admit("a", now), StatusCode::OK);
+    EXPECT_EQ(tenants.admit("a", now), StatusCode::TENANT_RATE_LIMITED);
+    // other tenant has its own bucket
+    EXPECT_EQ(tenants.admit("b", now), StatusCode::OK);
+    // bucket refills with rate
+    EXPECT_EQ(tenants.admit("a", now + 500ms), StatusCode::OK);
+    EXPECT_EQ(tenants.admit("a", now + 500ms), StatusCode::TENANT_RATE_LIMITED);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(tenants.admit("web", now), StatusCode::OK);
+    }
+}
+
+TEST(TokenBucket, BurstCapsRefill) {
+    const auto now = std::chrono::steady_clock::now();
+    TokenBucket bucket(10, 2, now);
+    EXPECT_TRUE(bucket.tryTake(now));
+    EXPECT_TRUE(bucket.tryTake(now));
+    EXPECT_FALSE(bucket.tryTake(now));
+    EXPECT_TRUE(bucket.tryTake(now + 10s));
+    EXPECT_TRUE(bucket.tryTake(now + 10s));
+    EXPECT_FALSE(bucket.tryTake(now + 10s));
+}
+
+TEST(FairShareQueue, TimesOutAtDeadline) {
+    FairShareQueue queue(1);
+    ASSERT_EQ(queue.acquire("a", 1), StatusCode::OK);
+    EXPECT_EQ(queue.acquire("b", 1, std::chrono::steady_clock::now() + 10ms), StatusCode::DEADLINE_EXCEEDED);
+    queue.release();
+    EXPECT_EQ(queue.acquire("b", 1, std::chrono::steady_clock::now() + 10ms), StatusCode::OK);
+    queue.release();
+}
+
+TEST(FairShareQueue, TryAcquireDoesNotWait) {
+    FairShareQueue queue(1);
+    ASSERT_TRUE(queue.tryAcquire("a", 1));
+    EXPECT_FALSE(queue.tryAcquire("b", 1));
+    queue.release();
+    EXPECT_TRUE(queue.tryAcquire("b", 1));
+    queue.release();
+}
+
+TEST(FairShareQueue, GrantsWaitingTenantsByWeight) {
+    FairShareQueue queue(1);
+    ASSERT_EQ(queue.acquire("holder", 1), StatusCode::OK);
+    std::mutex mtx;
+    std::vector<std::string> order;
+    std::vector<std::thread> threads;
+    std::atomic<int> started{0};
+    auto waitFor = [&](const std::string& tenant, uint32_t weight) {
+        threads.emplace_back([&, tenant, weight]() {
+            ++started;
+            ASSERT_EQ(queue.acquire(tenant, weight), StatusCode::OK);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                order.push_back(tenant);
+            }
+            queue.release();
+        });
+        // enqueue in known order
+        while (started < static_cast<int>(threads.size())) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(10ms);
+    };
+    // heavy tenant floods the queue before light tenant with higher weight arrives
+    for (int i = 0; i < 4; ++i) {
+        waitFor("heavy", 1);
+    }
+    for (int i = 0; i < 2; ++i) {
+        waitFor("light", 2);
+    }
+    queue.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(order, (std::vector<std::string>{"heavy", "light", "light", "heavy", "heavy", "heavy"}));
+}
@@ -0,0 +1,92 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "../tensorbufferpool.hpp"
+
+using namespace ovms;
+
+TEST(TensorBufferPool, SizeClasses) {
+    EXPECT_EQ(TensorBufferPool::getSizeClassBytes(1), 256);
+    EXPECT_EQ(TensorBufferPool::getSizeClassBytes(256), 256);
+    EXPECT_EQ(TensorBufferPool::getSizeClassBytes(257), 512);
+    EXPECT_EQ(TensorBufferPool::getSizeClassBytes(3 * 1024 * 1024), 4 * 1024 * 1024);
+    EXPECT_EQ(TensorBufferPool::getSizeClassBytes(size_t(1) << 30), size_t(1) << 30);
+    EXPECT_EQ(TensorBufferPool::getSizeClassBytes((size_t(1) << 30) + 1), 0);
+}
+
+TEST(TensorBufferPool, ReusesReleasedBuffer) {
+    TensorBufferPool pool;
+    pool.setMaxPooledBytes(1024 * 1024);
+    void* buffer = pool.allocate(1000);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % TensorBufferPool::ALIGNMENT, 0);
+    pool.release(buffer);
+    EXPECT_EQ(pool.getPooledBytes(), 1024);
+    EXPECT_EQ(pool.allocate(1024), buffer);
+    EXPECT_EQ(pool.getPooledBytes(), 0);
+    void* other = pool.allocate(1000);
+    EXPECT_NE(other, buffer);
+    pool.release(buffer);
+    pool.release(other);
+    EXPECT_EQ(pool.getPooledBytes(), 2048);
+}
+
+TEST(TensorBufferPool, HugeBuffersAligned) {
+    TensorBufferPool pool;
+    pool.setMaxPooledBytes(size_t(16) << 20);
+    void* buffer = pool.allocate(TensorBufferPool::HUGE_PAGE_SIZE);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % TensorBufferPool::HUGE_PAGE_SIZE, 0);
+    void* larger = pool.allocate(3 * TensorBufferPool::HUGE_PAGE_SIZE);
+    ASSERT_NE(larger, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(larger) % TensorBufferPool::HUGE_PAGE_SIZE, 0);
+    pool.release(buffer);
+    pool.release(larger);
+    EXPECT_EQ(pool.getPooledBytes(), TensorBufferPool::HUGE_PAGE_SIZE + TensorBufferPool::getSizeClassBytes(3 * TensorBufferPool::HUGE_PAGE_SIZE));
+    EXPECT_EQ(pool.allocate(TensorBufferPool::HUGE_PAGE_SIZE), buffer);
+    pool.release(buffer);
+}
+
+TEST(TensorBufferPool, IdleBuffersLimited) {
+    TensorBufferPool pool;
+    void* buffer = pool.allocate(512);
+    pool.release(buffer);
+    EXPECT_EQ(pool.getPooledBytes(), 0) << "pool with no limit set keeps no buffers";
+
+    pool.setMaxPooledBytes(1024);
+    void* first = pool.allocate(1024);
+    void* second = pool.allocate(1024);
+    pool.release(first);
+    pool.release(second);
+    EXPECT_EQ(pool.getPooledBytes(), 1024);
+
+    pool.setMaxPooledBytes(0);
+    EXPECT_EQ(pool.getPooledBytes(), 0);
+}
+
+TEST(TensorBufferPool, LargeBuffersNotPooled) {
+    TensorBufferPool pool;
+    pool.setMaxPooledBytes(size_t(4) << 30);
+    void* buffer = pool.allocate((size_t(1) << 30) + 1);
+    if (buffer == nullptr) {
+        GTEST_SKIP() << "not enough memory";
+    }
+    pool.release(buffer);
+    EXPECT_EQ(pool.getPooledBytes(), 0);
+}
@@ -0,0 +1,142 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../tensorconversion.hpp"
+
+using namespace ovms;
+
+class TensorConversion : public ::testing::TestWithParam<SimdLevel> {
+protected:
+    void SetUp() override {
+        if (GetParam() > getSimdLevel()) {
+            GTEST_SKIP() << "Instruction set not supported by CPU";
+        }
+    }
+};
+
+TEST_P(TensorConversion, NarrowDropsUpperBytes) {
+    // sizes not divisible by vector width check scalar tail
+    for (size_t count : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+        std::vector<int32_t> source(count);
+        for (size_t i = 0; i < count; i++) {
+            source[i] = static_cast<int32_t>(i * 2654435761u);
+        }
+        std::vector<uint16_t> destination(count);
+        narrowToUint16(source.data(), destination.data(), count, GetParam());
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(destination[i], static_cast<uint16_t>(source[i])) << "count: " << count << " index: " << i;
+        }
+    }
+}
+
+TEST_P(TensorConversion, WidenPadsWithZeros) {
+    for (size_t count : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+        std::vector<uint16_t> source(count);
+        for (size_t i = 0; i < count; i++) {
+            source[i] = static_cast<uint16_t>(65535 - i * 37);
+        }
+        std::vector<uint32_t> destination(count, 0xFFFFFFFF);
+        widenToUint32(source.data(), destination.data(), count, GetParam());
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(destination[i], static_cast<uint32_t>(source[i])) << "count: " << count << " index: " << i;
+        }
+    }
+}
+
+namespace {
+std::vector<float> floatConversionSource(size_t count) {
+    // ties, subnormals, overflow and non finite values mixed with regular values
+    const std::vector<float> special{0.0f, -0.0f, 1.0f, -2.5f, 1.00048828125f, 1.00146484375f, 65504.0f, 65520.0f, 1e6f,
+        5.96e-8f, 3e-8f, 1e-5f, -6.1e-5f, 1e-40f, INFINITY, -INFINITY, NAN, 3.3895314e38f};
+    std::vector<float> source(count);
+    for (size_t i = 0; i < count; i++) {
+        source[i] = i < special.size() ? special[i] : static_cast<float>(i) * 0.37f - 100.0f;
+    }
+    return source;
+}
+}  // namespace
+
+TEST_P(TensorConversion, FloatToHalfRoundsToNearestEven) {
+    for (size_t count : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+        auto source = floatConversionSource(count);
+        std::vector<uint16_t> expected(count);
+        std::vector<uint16_t> destination(count);
+        floatToHalf(source.data(), expected.data(), count, SimdLevel::SCALAR);
+        floatToHalf(source.data(), destination.data(), count, GetParam());
+        for (size_t i = 0; i < count; i++) {
+            if (std::isnan(source[i])) {
+                EXPECT_TRUE(std::isnan(halfToFloat(destination[i])));
+            } else {
+                EXPECT_EQ(destination[i], expected[i]) << "count: " << count << " index: " << i;
+            }
+        }
+    }
+}
+
+TEST_P(TensorConversion, FloatToBfloat16RoundsToNearestEven) {
+    for (size_t count : {0, 1, 7, 8, 15, 16, 17, 33, 1000}) {
+        auto source = floatConversionSource(count);
+        std::vector<uint16_t> expected(count);
+        std::vector<uint16_t> destination(count);
+        floatToBfloat16(source.data(), expected.data(), count, SimdLevel::SCALAR);
+        floatToBfloat16(source.data(), destination.data(), count, GetParam());
+        EXPECT_EQ(destination, expected) << "count: " << count;
+    }
+}
+
+TEST(TensorConversionValues, Half) {
+    const std::vector<float> source{1.0f, -2.5f, 1.00048828125f, 1.00146484375f, 65504.0f, 65520.0f, 5.9604645e-8f, 1e-5f, INFINITY};
+    std::vector<uint16_t> half(source.size());
+    floatToHalf(source.data(), half.data(), source.size(), SimdLevel::SCALAR);
+    // ties round to even mantissa, 65520 overflows to infinity
+    EXPECT_EQ(half, (std::vector<uint16_t>{0x3C00, 0xC100, 0x3C00, 0x3C02, 0x7BFF, 0x7C00, 0x0001, 0x00A8, 0x7C00}));
+    EXPECT_EQ(halfToFloat(0x3C00), 1.0f);
+    EXPECT_EQ(halfToFloat(0xC100), -2.5f);
+    EXPECT_EQ(halfToFloat(0x0001), 5.9604645e-8f);
+    EXPECT_EQ(halfToFloat(0x7BFF), 65504.0f);
+    EXPECT_TRUE(std::isinf(halfToFloat(0x7C00)));
+    EXPECT_TRUE(std::isnan(halfToFloat(0x7E00)));
+}
+
+TEST(TensorConversionValues, Bfloat16) {
+    const std::vector<float> source{1.0f, -2.5f, 1.00390625f, 1.01171875f, NAN};
+    std::vector<uint16_t> bfloat16(source.size());
+    floatToBfloat16(source.data(), bfloat16.data(), source.size(), SimdLevel::SCALAR);
+    EXPECT_EQ(bfloat16[0], 0x3F80);
+    EXPECT_EQ(bfloat16[1], 0xC020);
+    EXPECT_EQ(bfloat16[2], 0x3F80);
+    EXPECT_EQ(bfloat16[3], 0x3F82);
+    EXPECT_TRUE(std::isnan(bfloat16ToFloat(bfloat16[4])));
+    EXPECT_EQ(bfloat16ToFloat(0xC020), -2.5f);
+}
+
+TEST(TensorConversionDispatch, DefaultKernelMatchesScalar) {
+    std::vector<int32_t> source{1, -1, 65536, 65535, 0x12345678};
+    std::vector<uint16_t> expected(source.size());
+    std::vector<uint16_t> actual(source.size());
+    narrowToUint16(source.data(), expected.data(), source.size(), SimdLevel::SCALAR);
+    narrowToUint16(source.data(), actual.data(), source.size());
+    EXPECT_EQ(actual, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Test,
+    TensorConversion,
+    ::testing::Values(SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512));
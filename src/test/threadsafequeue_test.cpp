@@ -13,11 +13,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <queue>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -125,3 +127,114 @@ TEST(TestThreadSafeQueue, SeveralThreadsAllElementsPresent) {
         EXPECT_EQ(NUMBER_OF_PRODUCERS, counter);
     }
 }
+
+TEST(TestThreadSafeQueue, PullReturnsElementsBeforeWakeUp) {
+    ThreadSafeQueue<int> queue;
+    queue.push(1);
+    queue.wakeUp();
+    EXPECT_EQ(1, queue.pull());
+    EXPECT_EQ(std::nullopt, queue.pull());
+    queue.push(2);
+    EXPECT_EQ(2, queue.pull());
+}
+
+TEST(TestThreadSafeQueue, WakeUpUnblocksPull) {
+    ThreadSafeQueue<int> queue;
+    std::thread waker([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.wakeUp();
+    });
+    EXPECT_EQ(std::nullopt, queue.pull());
+    waker.join();
+}
+
+TEST(TestThreadSafeQueue, TryPullEventAndPushListener) {
+    ThreadSafeQueue<int> queue;
+    int notifications = 0;
+    queue.setPushListener([&notifications]() { notifications++; });
+    std::optional<int> element;
+    EXPECT_FALSE(queue.tryPullEvent(element));
+    queue.push(1);
+    queue.wakeUp();
+    EXPECT_EQ(notifications, 2);
+    ASSERT_TRUE(queue.tryPullEvent(element));
+    EXPECT_EQ(element, 1);
+    ASSERT_TRUE(queue.tryPullEvent(element));
+    EXPECT_EQ(element, std::nullopt);
+    EXPECT_FALSE(queue.tryPullEvent(element));
+}
+
+TEST(TestThreadSafeQueue, PullAllTakesElementsInFIFOOrder) {
+    ThreadSafeQueue<int> queue;
+    for (int i = 0; i < 5; ++i) {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.size(), 5);
+    std::vector<int> elements;
+    EXPECT_FALSE(queue.pullAll(elements));
+    EXPECT_EQ(elements, std::vector<int>({0, 1, 2, 3, 4}));
+    EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(TestThreadSafeQueue, PullAllReportsWakeUp) {
+    ThreadSafeQueue<int> queue;
+    queue.push(1);
+    queue.wakeUp();
+    std::vector<int> elements;
+    EXPECT_TRUE(queue.pullAll(elements));
+    EXPECT_EQ(elements, std::vector<int>({1}));
+    std::thread waker([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.wakeUp();
+    });
+    elements.clear();
+    EXPECT_TRUE(queue.pullAll(elements));
+    EXPECT_TRUE(elements.empty());
+    waker.join();
+}
+
+TEST(TestThreadSafeQueue, PullAllWaitsForProducers) {
+    const uint NUMBER_OF_PRODUCERS = 8;
+    ThreadSafeQueue<int> queue;
+    std::vector<std::thread> producers;
+    for (auto i = 0u; i < NUMBER_OF_PRODUCERS; ++i) {
+        producers.emplace_back([&queue]() {
+            for (auto j = 0u; j < ELEMENTS_TO_INSERT; ++j) {
+                queue.push(j);
+            }
+        });
+    }
+    std::vector<int> elements;
+    while (elements.size() < NUMBER_OF_PRODUCERS * ELEMENTS_TO_INSERT) {
+        queue.pullAll(elements);
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    std::map<int, uint> counts;
+    for (auto e : elements) {
+        counts[e]++;
+    }
+    ASSERT_EQ(counts.size(), ELEMENTS_TO_INSERT);
+    for (auto [key, counter] : counts) {
+        EXPECT_EQ(NUMBER_OF_PRODUCERS, counter);
+    }
+}
+
+TEST(TestThreadSafeQueue, SetPushListenerWaitsForNotifyingProducer) {
+    ThreadSafeQueue<int> queue;
+    std::atomic<bool> listenerEntered{false};
+    std::atomic<bool> listenerFinished{false};
+    queue.setPushListener([&]() {
+        listenerEntered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        listenerFinished = true;
+    });
+    std::thread producer([&queue]() { queue.push(1); });
+    while (!listenerEntered) {
+        std::this_thread::yield();
+    }
+    queue.setPushListener(nullptr);
+    EXPECT_TRUE(listenerFinished);
+    producer.join();
+}
@@ -0,0 +1,68 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "../versionrouting.hpp"
+
+using ovms::WeightedVersionSelector;
+
+TEST(WeightedVersionSelector, EmptyWithoutPositiveWeights) {
+    EXPECT_TRUE(WeightedVersionSelector().empty());
+    WeightedVersionSelector selector({{1, 0}, {2, 0}});
+    EXPECT_TRUE(selector.empty());
+    EXPECT_EQ(selector.select(7), 0);
+}
+
+TEST(WeightedVersionSelector, PicksVersionsInProportionToWeights) {
+    WeightedVersionSelector selector({{3, 95}, {4, 5}, {5, 0}});
+    ASSERT_FALSE(selector.empty());
+    std::map<ovms::model_version_t, int> picks;
+    for (uint64_t random = 0; random < 1000; ++random) {
+        ++picks[selector.select(random)];
+    }
+    EXPECT_EQ(picks[3], 950);
+    EXPECT_EQ(picks[4], 50);
+    EXPECT_EQ(picks.count(5), 0);
+    EXPECT_EQ(selector.select(94), 3);
+    EXPECT_EQ(selector.select(95), 4);
+    EXPECT_EQ(selector.select(100), 3);
+}
+
+TEST(WeightedVersionSelector, ThreadGeneratorPicksWeightedVersions) {
+    WeightedVersionSelector selector({{1, 1}, {2, 1}});
+    std::map<ovms::model_version_t, int> picks;
+    for (int i = 0; i < 1000; ++i) {
+        ++picks[selector.select()];
+    }
+    EXPECT_EQ(picks.size(), 2);
+    EXPECT_GT(picks[1], 300);
+    EXPECT_GT(picks[2], 300);
+}
+
+TEST(WeightedVersionSelector, SkipsRejectedVersionsAndNormalizesWeights) {
+    WeightedVersionSelector selector({{1, 50}, {2, 30}, {3, 20}});
+    auto withoutFirst = [](ovms::model_version_t version) { return version != 1; };
+    std::map<ovms::model_version_t, int> picks;
+    for (uint64_t random = 0; random < 1000; ++random) {
+        ++picks[selector.selectFiltered(random, withoutFirst)];
+    }
+    EXPECT_EQ(picks.count(1), 0);
+    EXPECT_EQ(picks[2], 600);
+    EXPECT_EQ(picks[3], 400);
+    EXPECT_EQ(selector.selectFiltered(7, [](ovms::model_version_t) { return false; }), 0);
+}
@@ -15,51 +15,241 @@
 //*****************************************************************************
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <queue>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace ovms {
 
+/**
+ * @brief Lock-free multiple producers single consumer queue of events, e.g. pipeline node completions
+ *
+ * Producers link elements into the queue with a single atomic exchange and wake up the consumer only if it is parked.
+ * Consumer spins for a bounded number of attempts before it parks on condition variable, so bursts of completions
+ * are taken without sleeping, and it may take all pushed elements at once.
+ */
 template <typename T>
 class ThreadSafeQueue {
 public:
+    ThreadSafeQueue() :
+        head(new Cell()),
+        tail(head.load(std::memory_order_relaxed)) {}
+
+    ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+    ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
+
+    ~ThreadSafeQueue() {
+        // producer may still notify about element consumer already took
+        waitForProducers();
+        while (tail != nullptr) {
+            Cell* next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
     void push(const T& element) {
-        std::unique_lock<std::mutex> lock(mtx);
-        queue.push(std::move(element));
-        lock.unlock();
-        signal.notify_one();
+        push(T(element));
     }
 
     void push(T&& element) {
-        std::unique_lock<std::mutex> lock(mtx);
-        queue.push(std::move(element));
-        lock.unlock();
-        signal.notify_one();
+        ProducerGuard guard(activeProducers);
+        Cell* cell = new Cell();
+        cell->value.emplace(std::move(element));
+        elementsCount.fetch_add(1, std::memory_order_relaxed);
+        Cell* previous = head.exchange(cell, std::memory_order_acq_rel);
+        // pairs with consumer setting parked before it rechecks the queue
+        previous->next.store(cell, std::memory_order_seq_cst);
+        notify();
     }
 
     std::optional<T> tryPull(const uint waitDurationMicroseconds) {
-        std::unique_lock<std::mutex> lock(mtx);
-        if (signal.wait_for(lock,
-                std::chrono::microseconds(waitDurationMicroseconds),
-                [this]() { return queue.size() > 0; })) {
-            T element = std::move(queue.front());
-            queue.pop();
-            return std::optional<T>{std::move(element)};
-        } else {
-            return std::nullopt;
+        std::optional<T> element;
+        if (popOrSpin(element)) {
+            return element;
         }
+        std::unique_lock<std::mutex> lock(parkMutex);
+        parked.store(true, std::memory_order_seq_cst);
+        signal.wait_for(lock, std::chrono::microseconds(waitDurationMicroseconds), [this, &element]() { return pop(element); });
+        parked.store(false, std::memory_order_relaxed);
+        return element;
+    }
+
+    /**
+     * @brief Blocks until element is pushed or consumer is woken up
+     *
+     * @return element, or std::nullopt when woken up by wakeUp() with queue empty
+     */
+    std::optional<T> pull() {
+        std::optional<T> element;
+        park([this, &element]() { return pop(element) || takeWakeUp(); });
+        return element;
+    }
+
+    /**
+     * @brief Blocks until element is pushed or consumer is woken up and takes all elements pushed so far
+     *
+     * @return true if consumer was woken up by wakeUp(), elements are appended in order of pushes
+     */
+    bool pullAll(std::vector<T>& elements) {
+        const size_t previousSize = elements.size();
+        bool wokenUp = false;
+        park([this, &elements, &wokenUp, previousSize]() {
+            popAll(elements);
+            wokenUp = takeWakeUp();
+            return wokenUp || elements.size() > previousSize;
+        });
+        return wokenUp;
+    }
+
+    /**
+     * @brief Wakes up consumer blocked in pull() without pushing an element
+     */
+    void wakeUp() {
+        ProducerGuard guard(activeProducers);
+        wakeUpRequested.store(true, std::memory_order_seq_cst);
+        notify();
     }
 
-    size_t size() {
-        return queue.size();
+    /**
+     * @brief Takes element or pending wake up without waiting
+     *
+     * @return false if there is neither element nor wake up, otherwise element is set or std::nullopt for wake up
+     */
+    bool tryPullEvent(std::optional<T>& element) {
+        element.reset();
+        return pop(element) || takeWakeUp();
     }
 
+    /**
+     * @brief Sets callback invoked on every push and wake up
+     *
+     * Returns once producers which could invoke previous callback finished, so that the queue can be destroyed
+     * by consumer right after it took the last element and removed the callback.
+     */
+    void setPushListener(std::function<void()> listener) {
+        std::atomic_store(&pushListener, listener ? std::make_shared<std::function<void()>>(std::move(listener)) : nullptr);
+        waitForProducers();
+    }
+
+    size_t size() const {
+        return elementsCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of attempts to take element before consumer is parked
+     */
+    static const uint PULL_SPIN_COUNT = 64;
+
 private:
-    std::mutex mtx;
-    std::queue<T> queue;
+    struct Cell {
+        std::atomic<Cell*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    class ProducerGuard {
+    public:
+        explicit ProducerGuard(std::atomic<uint32_t>& producers) :
+            producers(producers) {
+            producers.fetch_add(1, std::memory_order_seq_cst);
+        }
+        ~ProducerGuard() {
+            // last access of producer to the queue
+            producers.fetch_sub(1, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<uint32_t>& producers;
+    };
+
+    void waitForProducers() const {
+        while (activeProducers.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Takes the oldest element, called by consumer only
+     */
+    bool pop(std::optional<T>& element) {
+        Cell* next = tail->next.load(std::memory_order_seq_cst);
+        if (next == nullptr) {
+            return false;
+        }
+        // taken cell becomes empty head of the list
+        element.emplace(std::move(next->value.value()));
+        next->value.reset();
+        delete tail;
+        tail = next;
+        elementsCount.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void popAll(std::vector<T>& elements) {
+        std::optional<T> element;
+        while (pop(element)) {
+            elements.push_back(std::move(element.value()));
+        }
+    }
+
+    bool takeWakeUp() {
+        return wakeUpRequested.load(std::memory_order_seq_cst) && wakeUpRequested.exchange(false, std::memory_order_seq_cst);
+    }
+
+    bool popOrSpin(std::optional<T>& element) {
+        for (uint i = 0; i < PULL_SPIN_COUNT; ++i) {
+            if (pop(element)) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    /**
+     * @brief Spins and then parks consumer until event predicate holds
+     */
+    template <typename Predicate>
+    void park(Predicate takeEvent) {
+        for (uint i = 0; i < PULL_SPIN_COUNT; ++i) {
+            if (takeEvent()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(parkMutex);
+        parked.store(true, std::memory_order_seq_cst);
+        signal.wait(lock, takeEvent);
+        parked.store(false, std::memory_order_relaxed);
+    }
+
+    void notify() {
+        // pairs with consumer setting parked before it rechecks the queue
+        if (parked.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            signal.notify_one();
+        }
+        auto listener = std::atomic_load(&pushListener);
+        if (listener) {
+            (*listener)();
+        }
+    }
+
+    alignas(64) std::atomic<Cell*> head;
+    std::atomic<size_t> elementsCount{0};
+    std::atomic<bool> wakeUpRequested{false};
+    std::atomic<uint32_t> activeProducers{0};
+    alignas(64) Cell* tail;
+    std::atomic<bool> parked{false};
+    std::mutex parkMutex;
     std::condition_variable signal;
+    std::shared_ptr<std::function<void()>> pushListener;
 };
 }  // namespace ovms
@@ -15,10 +15,10 @@
 //*****************************************************************************
 #pragma once
 
+#include <array>
 #include <chrono>
-#include <iostream>
-#include <string>
-#include <unordered_map>
+#include <cstddef>
+#include <type_traits>
 
 template <typename T>
 struct is_chrono_duration_type : std::false_type {};
@@ -26,47 +26,35 @@ struct is_chrono_duration_type : std::false_type {};
 template <typename T, typename U>
 struct is_chrono_duration_type<std::chrono::duration<T, U>> : std::true_type {};
 
+/**
+ * @brief Measures stages of request processing, stages are indexes known at compile time
+ *
+ * Timestamps are kept in fixed arrays, so timer does not allocate and stays enabled in release builds.
+ * Users define stages as enum values from 0 to STAGES_COUNT - 1.
+ */
+template <size_t STAGES_COUNT>
 class Timer {
-    std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> startTimestamps;
-    std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> stopTimestamps;
+    using clock = std::chrono::steady_clock;
+
+    std::array<clock::time_point, STAGES_COUNT> startTimestamps;
+    std::array<clock::time_point, STAGES_COUNT> stopTimestamps;
 
 public:
-    void start(const std::string& name) {
-#ifdef DEBUG
-        startTimestamps[name] = std::chrono::high_resolution_clock::now();
-#endif
+    void start(size_t stage) {
+        startTimestamps[stage] = clock::now();
     }
 
-    void stop(const std::string& name) {
-#ifdef DEBUG
-        stopTimestamps[name] = std::chrono::high_resolution_clock::now();
-#endif
+    void stop(size_t stage) {
+        stopTimestamps[stage] = clock::now();
     }
 
     template <typename T>
-    double elapsed(const std::string& name) {
+    double elapsed(size_t stage) const {
         static_assert(is_chrono_duration_type<T>::value, "Non supported type.");
-        double duration_us = 0;
-#ifdef DEBUG
-        duration_us = std::chrono::duration_cast<T>(stopTimestamps[name] - startTimestamps[name]).count();
-#endif
-        return duration_us;
+        return std::chrono::duration_cast<std::chrono::duration<double, typename T::period>>(stopTimestamps[stage] - startTimestamps[stage]).count();
     }
 
-    void print() {
-#ifdef DEBUG
-        std::cout << "-----\n";
-        for (const auto& pair : stopTimestamps) {
-            const auto& name = pair.first;
-            auto elapsed = std::to_string(std::chrono::duration<double, std::milli>(stopTimestamps[name] - startTimestamps[name]).count());
-
-            std::cout
-                << name
-                << ": "
-                << elapsed
-                << "ms"
-                << "\n";
-        }
-#endif
+    double elapsedSeconds(size_t stage) const {
+        return elapsed<std::chrono::seconds>(stage);
     }
 };
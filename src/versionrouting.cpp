@@ -0,0 +1,53 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "versionrouting.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace ovms {
+
+WeightedVersionSelector::WeightedVersionSelector(const version_weights_t& weights) {
+    uint64_t total = 0;
+    for (const auto& [version, weight] : weights) {
+        if (weight == 0) {
+            continue;
+        }
+        total += weight;
+        versions.push_back(version);
+        cumulativeWeights.push_back(total);
+    }
+}
+
+model_version_t WeightedVersionSelector::select(uint64_t random) const {
+    if (versions.empty()) {
+        return 0;
+    }
+    const uint64_t point = random % cumulativeWeights.back();
+    const auto it = std::upper_bound(cumulativeWeights.begin(), cumulativeWeights.end(), point);
+    return versions[it - cumulativeWeights.begin()];
+}
+
+uint64_t WeightedVersionSelector::threadRandom() {
+    thread_local std::mt19937_64 generator(std::random_device{}());
+    return generator();
+}
+
+model_version_t WeightedVersionSelector::select() const {
+    return select(threadRandom());
+}
+
+}  // namespace ovms
@@ -0,0 +1,102 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "model_version_policy.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Weights of model versions receiving requests which do not specify version
+ */
+using version_weights_t = std::map<model_version_t, uint32_t>;
+
+/**
+ * @brief Picks model versions in proportion to their weights
+ *
+ * Selector is immutable after construction, so request threads share it without locks.
+ */
+class WeightedVersionSelector {
+public:
+    WeightedVersionSelector() = default;
+
+    /**
+     * @brief Builds selector of versions with positive weights
+     */
+    explicit WeightedVersionSelector(const version_weights_t& weights);
+
+    bool empty() const { return versions.empty(); }
+
+    /**
+     * @brief Picks version for uniformly distributed random value
+     */
+    model_version_t select(uint64_t random) const;
+
+    /**
+     * @brief Picks version using generator of the calling thread
+     */
+    model_version_t select() const;
+
+    /**
+     * @brief Picks version among versions accepted by filter, weights of rejected versions are left out of the total
+     *
+     * @return version or 0 if filter rejects all versions
+     */
+    template <typename Filter>
+    model_version_t selectFiltered(uint64_t random, Filter&& isSelectable) const {
+        std::vector<uint64_t> selectableWeights(versions.size(), 0);
+        uint64_t total = 0;
+        for (size_t i = 0; i < versions.size(); ++i) {
+            if (isSelectable(versions[i])) {
+                selectableWeights[i] = cumulativeWeights[i] - (i > 0 ? cumulativeWeights[i - 1] : 0);
+                total += selectableWeights[i];
+            }
+        }
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t point = random % total;
+        for (size_t i = 0; i < versions.size(); ++i) {
+            if (point < selectableWeights[i]) {
+                return versions[i];
+            }
+            point -= selectableWeights[i];
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Picks version accepted by filter using generator of the calling thread
+     */
+    template <typename Filter>
+    model_version_t selectFiltered(Filter&& isSelectable) const {
+        return selectFiltered(threadRandom(), std::forward<Filter>(isSelectable));
+    }
+
+private:
+    static uint64_t threadRandom();
+
+    std::vector<model_version_t> versions;
+    // running sums of weights, last one is the total
+    std::vector<uint64_t> cumulativeWeights;
+};
+
+}  // namespace ovms
@@ -0,0 +1,282 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.error
+import urllib.request
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_DIR = os.path.abspath(os.path.join(SCRIPT_DIR, '..', '..', '..'))
+MODELS_DIR = os.path.join(REPO_DIR, 'src', 'test')
+# base paths in reference config point to models mounted in docker container
+CONTAINER_MODELS_DIR = '/models'
+
+EXIT_PASSED = 0
+EXIT_REGRESSION = 1
+EXIT_SETUP_FAILED = 2
+
+parser = argparse.ArgumentParser(
+    description='Starts the server with reference configuration, runs fixed gRPC and REST scenarios with ovms_loadgen'
+                ' and compares results with baseline of the hardware.')
+parser.add_argument('--ovms_binary', default=os.path.join(REPO_DIR, 'bazel-bin', 'src', 'ovms'),
+                    help='server binary, used unless --docker_image is set. default: bazel-bin/src/ovms')
+parser.add_argument('--docker_image', help='server docker image, e.g. openvino/model_server:latest')
+parser.add_argument('--loadgen_binary', default=os.path.join(REPO_DIR, 'bazel-bin', 'src', 'ovms_loadgen'),
+                    help='load generator binary. default: bazel-bin/src/ovms_loadgen')
+parser.add_argument('--grpc_port', type=int, default=9178, help='gRPC port of started server. default: 9178')
+parser.add_argument('--rest_port', type=int, default=5000, help='REST port of started server. default: 5000')
+parser.add_argument('--duration', type=int, default=30, help='seconds of every scenario. default: 30')
+parser.add_argument('--warmup', type=int, default=5, help='seconds of load excluded from results before every scenario. default: 5')
+parser.add_argument('--scenarios', help='comma separated names of scenarios to run, all by default')
+parser.add_argument('--hardware', help='name of baseline, derived from CPU model and core count by default')
+parser.add_argument('--results_dir', default=os.path.join(SCRIPT_DIR, 'results'),
+                    help='directory of JSON results of runs. default: results next to this script')
+parser.add_argument('--update_baseline', action='store_true',
+                    help='stores results as baseline of the hardware instead of comparing with it')
+parser.add_argument('--throughput_threshold', type=float,
+                    help='percent of baseline throughput a scenario may lose, overrides scenarios.json')
+parser.add_argument('--latency_threshold', type=float,
+                    help='percent of baseline latency a scenario may gain, overrides scenarios.json')
+
+
+def hardware_name():
+    cpu = platform.processor() or platform.machine()
+    try:
+        with open('/proc/cpuinfo') as cpuinfo:
+            for line in cpuinfo:
+                if line.startswith('model name'):
+                    cpu = line.split(':', 1)[1]
+                    break
+    except OSError:
+        pass
+    name = '{}-{}cores'.format(cpu, os.cpu_count())
+    return re.sub(r'[^a-z0-9]+', '-', name.lower()).strip('-')
+
+
+def git_commit():
+    try:
+        return subprocess.check_output(['git', '-C', REPO_DIR, 'rev-parse', 'HEAD'], universal_newlines=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return ''
+
+
+def start_server(args, config_path):
+    server_args = ['--port', str(args.grpc_port), '--rest_port', str(args.rest_port), '--log_level', 'ERROR']
+    if args.docker_image:
+        command = ['docker', 'run', '--rm', '--network', 'host',
+                   '-v', '{}:{}:ro'.format(MODELS_DIR, CONTAINER_MODELS_DIR),
+                   '-v', '{}:/config/config.json:ro'.format(config_path),
+                   args.docker_image, '--config_path', '/config/config.json'] + server_args
+    else:
+        command = [args.ovms_binary, '--config_path', config_path] + server_args
+    print('[--] Starting server: {}'.format(' '.join(command)))
+    return subprocess.Popen(command)
+
+
+def wait_for_model(args, server, model_name, timeout=120):
+    url = 'http://localhost:{}/v1/models/{}'.format(args.rest_port, model_name)
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        if server.poll() is not None:
+            return False
+        try:
+            with urllib.request.urlopen(url, timeout=1) as response:
+                status = json.loads(response.read().decode())
+                if any(version.get('state') == 'AVAILABLE' for version in status.get('model_version_status', [])):
+                    return True
+        except (urllib.error.URLError, OSError, ValueError):
+            pass
+        time.sleep(0.5)
+    return False
+
+
+def stop_server(server):
+    server.terminate()
+    try:
+        server.wait(timeout=30)
+    except subprocess.TimeoutExpired:
+        server.kill()
+        server.wait()
+
+
+def write_target_config(reference, scenario, directory):
+    # ovms_loadgen requests all models and pipelines of config, so every pipeline scenario gets config with only its pipeline
+    pipelines = [pipeline for pipeline in reference['pipeline_config_list'] if pipeline['name'] == scenario['target']]
+    path = os.path.join(directory, '{}.json'.format(scenario['name']))
+    with open(path, 'w') as config:
+        json.dump({'model_config_list': [], 'pipeline_config_list': pipelines}, config)
+    return path
+
+
+def run_loadgen(args, scenario, target_config, duration, json_output):
+    command = [args.loadgen_binary,
+               '--grpc_address', 'localhost:{}'.format(args.grpc_port),
+               '--rest_address', 'localhost:{}'.format(args.rest_port),
+               '--protocol', scenario['protocol'],
+               '--rate', str(scenario['rate']),
+               '--duration', str(duration),
+               '--arrival', scenario.get('arrival', 'constant'),
+               '--max_outstanding', str(scenario.get('max_outstanding', 10000)),
+               '--json_output', json_output]
+    if target_config:
+        command += ['--config_path', target_config]
+    else:
+        command += ['--model_name', scenario['target']]
+    subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+    with open(json_output) as report:
+        return json.load(report)
+
+
+def run_scenarios(args, scenarios):
+    with open(os.path.join(SCRIPT_DIR, 'config.json')) as config:
+        reference = json.load(config)
+    results = {}
+    with tempfile.TemporaryDirectory() as directory:
+        config_path = os.path.join(directory, 'config.json')
+        if not args.docker_image:
+            # binary reads models from the repository instead of the container mount
+            for model in reference['model_config_list']:
+                model['config']['base_path'] = model['config']['base_path'].replace(CONTAINER_MODELS_DIR, MODELS_DIR, 1)
+        with open(config_path, 'w') as config:
+            json.dump(reference, config)
+        server = start_server(args, config_path)
+        try:
+            for model in reference['model_config_list']:
+                if not wait_for_model(args, server, model['config']['name']):
+                    print('[!!] Model {} did not become available'.format(model['config']['name']))
+                    return None
+            for scenario in scenarios:
+                target_config = write_target_config(reference, scenario, directory) if scenario.get('pipeline') else None
+                json_output = os.path.join(directory, '{}_report.json'.format(scenario['name']))
+                if args.warmup > 0:
+                    run_loadgen(args, scenario, target_config, args.warmup, json_output)
+                print('[--] Running scenario {}'.format(scenario['name']))
+                report = run_loadgen(args, scenario, target_config, args.duration, json_output)
+                results[scenario['name']] = report['total']
+                print('[--] {}: throughput {:.1f} requests/s, p50 {:.3f} ms, p99 {:.3f} ms'.format(
+                    scenario['name'], report['total']['throughput'],
+                    report['total']['latency_ms']['p50'], report['total']['latency_ms']['p99']))
+        except subprocess.CalledProcessError as e:
+            print('[!!] Load generator failed: {}'.format(e))
+            return None
+        finally:
+            stop_server(server)
+    return results
+
+
+def metric_value(result, metric):
+    return result['throughput'] if metric == 'throughput' else result['latency_ms'][metric]
+
+
+def compare(scenarios, results, baseline, thresholds):
+    regressions = []
+    for scenario in scenarios:
+        name = scenario['name']
+        result = results[name]
+        if result['errors']:
+            regressions.append('{}: requests failed {}'.format(name, result['errors']))
+        if name not in baseline['scenarios']:
+            print('[??] {}: no baseline, not compared'.format(name))
+            continue
+        for metric in scenario['metrics']:
+            expected = metric_value(baseline['scenarios'][name], metric)
+            actual = metric_value(result, metric)
+            if expected <= 0:
+                continue
+            change = (actual - expected) / expected * 100
+            if metric == 'throughput':
+                failed = -change > scenario.get('throughput_threshold', thresholds['throughput'])
+            else:
+                failed = change > scenario.get('latency_threshold', thresholds['latency'])
+            line = '{}: {} {:.3f} vs baseline {:.3f} ({:+.1f}%)'.format(name, metric, actual, expected, change)
+            print('[{}] {}'.format('!!' if failed else 'OK', line))
+            if failed:
+                regressions.append(line)
+    return regressions
+
+
+def main():
+    args = parser.parse_args()
+    with open(os.path.join(SCRIPT_DIR, 'scenarios.json')) as scenarios_file:
+        definitions = json.load(scenarios_file)
+    scenarios = definitions['scenarios']
+    if args.scenarios:
+        names = args.scenarios.split(',')
+        scenarios = [scenario for scenario in scenarios if scenario['name'] in names]
+        if len(scenarios) != len(names):
+            print('[!!] Unknown scenario in {}'.format(args.scenarios))
+            return EXIT_SETUP_FAILED
+    thresholds = dict(definitions['thresholds'])
+    if args.throughput_threshold is not None:
+        thresholds['throughput'] = args.throughput_threshold
+    if args.latency_threshold is not None:
+        thresholds['latency'] = args.latency_threshold
+
+    hardware = args.hardware or hardware_name()
+    baseline_path = os.path.join(SCRIPT_DIR, 'baselines', '{}.json'.format(hardware))
+    if not args.update_baseline and not os.path.exists(baseline_path):
+        print('[!!] No baseline for hardware {}, create it with --update_baseline'.format(hardware))
+        return EXIT_SETUP_FAILED
+
+    results = run_scenarios(args, scenarios)
+    if results is None:
+        return EXIT_SETUP_FAILED
+    run = {
+        'hardware': hardware,
+        'commit': git_commit(),
+        'date': datetime.datetime.utcnow().isoformat(timespec='seconds'),
+        'duration_s': args.duration,
+        'scenarios': results,
+    }
+    os.makedirs(args.results_dir, exist_ok=True)
+    results_path = os.path.join(args.results_dir, '{}-{}.json'.format(hardware, run['date'].replace(':', '')))
+    with open(results_path, 'w') as output:
+        json.dump(run, output, indent=4)
+    print('[--] Results written to {}'.format(results_path))
+
+    if args.update_baseline:
+        if os.path.exists(baseline_path):
+            # scenarios not run now keep their previous baseline
+            with open(baseline_path) as previous:
+                run['scenarios'] = dict(json.load(previous)['scenarios'], **results)
+        with open(baseline_path, 'w') as output:
+            json.dump(run, output, indent=4)
+        print('[--] Baseline of {} updated'.format(hardware))
+        return EXIT_PASSED
+
+    with open(baseline_path) as baseline:
+        regressions = compare(scenarios, results, json.load(baseline), thresholds)
+    if regressions:
+        print('[!!] Performance regressed against baseline of {}:'.format(hardware))
+        for regression in regressions:
+            print('    ' + regression)
+        return EXIT_REGRESSION
+    print('[OK] No regression against baseline of {}'.format(hardware))
+    return EXIT_PASSED
+
+
+if __name__ == '__main__':
+    sys.exit(main())